@@ -0,0 +1,382 @@
+#include "Graphics/SceneGraph/AABBTree.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "Foundation/Logger.hpp"
+#include "Core/AppConfig.hpp" // activate needed GLM defines
+#include "glm/gtc/matrix_transform.hpp" // perspective(), lookAt()
+#include "glm/geometric.hpp"
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <random>
+#include <algorithm> // std::sort()
+#include <cmath>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// queries per type
+static const uint32_t QUERY_COUNT = 1000;
+
+// the objects live in a cube of this half size, they move and bounce on its walls
+static const float32_t WORLD_EXTENT = 500.0f;
+static const float32_t MIN_OBJECT_SIZE = 0.5f;
+static const float32_t MAX_OBJECT_SIZE = 4.0f;
+static const float32_t MAX_SPEED = 0.5f; // per frame
+
+// camera of the frustum queries
+static const float32_t Z_NEAR = 0.1f;
+static const float32_t Z_FAR = 300.0f;
+
+// the frustum is tested by the tree against the node bounds, the reference ignores the leaves closer than this to a plane
+static const float32_t PLANE_TOLERANCE = 1e-2f;
+
+struct Object
+{
+	glm::vec3 center;
+	glm::vec3 halfSize;
+	glm::vec3 velocity;
+	uint32_t proxyId;
+};
+
+struct QueryResult
+{
+	std::string type;
+	float64_t time; // ms, all the queries
+	float64_t bruteForceTime; // ms, all the queries
+	uint64_t hitCount;
+	bool_t isValid;
+};
+
+static void CreateObjects(uint32_t objectCount, std::mt19937& generator, std::vector<Object>& objectsOut)
+{
+	std::uniform_real_distribution<float32_t> positionDistribution(-WORLD_EXTENT, WORLD_EXTENT);
+	std::uniform_real_distribution<float32_t> sizeDistribution(MIN_OBJECT_SIZE, MAX_OBJECT_SIZE);
+	std::uniform_real_distribution<float32_t> speedDistribution(-MAX_SPEED, MAX_SPEED);
+
+	objectsOut.resize(objectCount);
+	for (auto& object : objectsOut)
+	{
+		object.center = glm::vec3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+		object.halfSize = 0.5f * glm::vec3(sizeDistribution(generator), sizeDistribution(generator), sizeDistribution(generator));
+		object.velocity = glm::vec3(speedDistribution(generator), speedDistribution(generator), speedDistribution(generator));
+		object.proxyId = AABBTree::NULL_NODE;
+	}
+}
+
+static void MoveObjects(std::vector<Object>& objects)
+{
+	for (auto& object : objects)
+	{
+		object.center += object.velocity;
+
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			if (std::abs(object.center[i]) > WORLD_EXTENT)
+			{
+				object.velocity[i] = -object.velocity[i];
+			}
+		}
+	}
+}
+
+static void BuildTree(AABBTree& tree, std::vector<Object>& objects)
+{
+	for (uint32_t i = 0; i < objects.size(); ++i)
+	{
+		auto& object = objects[i];
+		object.proxyId = tree.CreateProxy(object.center - object.halfSize, object.center + object.halfSize, &object);
+	}
+}
+
+static void PrintTreeStats(const char_t* pName, const AABBTree& tree, float64_t time, uint64_t updatedCount, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, pName)
+		.Add("proxies", tree.GetProxyCount())
+		.Add("time_ms", time)
+		.Add("updated", updatedCount) // proxies whose fat bounds changed
+		.Add("height", tree.GetHeight())
+		.Add("sah_cost", tree.ComputeSAHCost())
+		.Add("valid", tree.Validate())
+		.End();
+}
+
+static void PrintQueryResult(const QueryResult& result, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, "aabb_tree_query")
+		.Add("query", result.type)
+		.Add("queries", QUERY_COUNT)
+		.Add("time_ms", result.time)
+		.Add("queries_per_s", QUERY_COUNT * 1000.0 / result.time)
+		.Add("brute_force_ms", result.bruteForceTime)
+		.Add("speedup", result.bruteForceTime / result.time)
+		.Add("avg_hits", static_cast<float64_t>(result.hitCount) / QUERY_COUNT)
+		.Add("valid", result.isValid)
+		.End();
+}
+
+//// reference tests, against the fat bounds of the leaves ////
+
+static bool_t IsSphereHit(const AABBTree::AABB& aabb, const glm::vec3& center, float32_t radius)
+{
+	const glm::vec3 d = glm::max(glm::max(aabb.min - center, center - aabb.max), glm::vec3(0.0f));
+
+	return (glm::dot(d, d) <= radius * radius);
+}
+
+static bool_t IsAABBHit(const AABBTree::AABB& aabb, const glm::vec3& min, const glm::vec3& max)
+{
+	return (aabb.min.x <= max.x) && (aabb.min.y <= max.y) && (aabb.min.z <= max.z) &&
+		(min.x <= aabb.max.x) && (min.y <= aabb.max.y) && (min.z <= aabb.max.z);
+}
+
+static bool_t IsRayHit(const AABBTree::AABB& aabb, const glm::vec3& origin, const glm::vec3& direction, float32_t maxT)
+{
+	const glm::vec3 invDirection = glm::vec3(1.0f) / direction;
+	const glm::vec3 t1 = (aabb.min - origin) * invDirection;
+	const glm::vec3 t2 = (aabb.max - origin) * invDirection;
+	const glm::vec3 tNear = glm::min(t1, t2);
+	const glm::vec3 tFar = glm::max(t1, t2);
+
+	const float32_t tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+	const float32_t tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+
+	return (tEnter <= tExit);
+}
+
+// -1 outside, 1 inside, 0 too close to a plane to tell
+static int32_t ClassifyFrustum(const AABBTree::AABB& aabb, const Frustum& frustum)
+{
+	const glm::vec3 center = (aabb.min + aabb.max) * 0.5f;
+	const glm::vec3 extent = (aabb.max - aabb.min) * 0.5f;
+
+	int32_t result = 1;
+	for (uint32_t i = 0; i < static_cast<uint32_t>(Frustum::Plane::GE_FP_COUNT); ++i)
+	{
+		const glm::vec4& plane = frustum.GetPlane(static_cast<Frustum::Plane>(i));
+		const float32_t distance = glm::dot(glm::vec3(plane), center) + plane.w;
+		const float32_t radius = glm::dot(glm::abs(glm::vec3(plane)), extent);
+
+		if (distance < -radius - PLANE_TOLERANCE)
+			return -1;
+		if (distance < -radius + PLANE_TOLERANCE)
+		{
+			result = 0;
+		}
+	}
+
+	return result;
+}
+
+// the tree must return the same proxies as the brute force test, in any order
+static bool_t CompareHits(std::vector<uint32_t>& treeHits, std::vector<uint32_t>& bruteForceHits)
+{
+	std::sort(treeHits.begin(), treeHits.end());
+	std::sort(bruteForceHits.begin(), bruteForceHits.end());
+
+	return (treeHits == bruteForceHits);
+}
+
+// usage: AABBTreeBenchmark [object count]
+// builds a tree of moving boxes and measures:
+// - the update of the tree after all the objects moved: batch refit (SetProxyBounds + Refit) and reinsert (MoveProxy)
+// - the throughput of the frustum, sphere, AABB and ray queries, compared to a brute force loop over all the objects
+// the tree is validated after each update and the query results are checked against the brute force results
+int main(int argc, char* argv[])
+{
+	const uint32_t objectCount = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+
+	if (0 == objectCount)
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	std::mt19937 generator(1234);
+
+	std::vector<Object> objects;
+	CreateObjects(objectCount, generator, objects);
+
+	bool_t isValid = true;
+
+	//// build ////
+
+	AABBTree tree;
+	{
+		const float64_t begin = BenchmarkUtils::GetTime();
+		BuildTree(tree, objects);
+		const float64_t time = BenchmarkUtils::GetTime() - begin;
+
+		PrintTreeStats("aabb_tree_build", tree, time, objectCount, std::cout);
+		isValid = isValid && tree.Validate();
+	}
+
+	//// updates ////
+
+	// batch refit: the fat bounds are grown in place, the structure changes only by the rotations
+	{
+		std::vector<float64_t> times;
+		uint64_t updatedCount = 0;
+		for (uint32_t run = 0; run < BenchmarkUtils::RUN_COUNT; ++run)
+		{
+			MoveObjects(objects);
+
+			const float64_t begin = BenchmarkUtils::GetTime();
+			for (const auto& object : objects)
+			{
+				updatedCount += tree.SetProxyBounds(object.proxyId, object.center - object.halfSize, object.center + object.halfSize) ? 1 : 0;
+			}
+			tree.Refit();
+			times.push_back(BenchmarkUtils::GetTime() - begin);
+		}
+
+		PrintTreeStats("aabb_tree_refit", tree, BenchmarkUtils::Median(times), updatedCount / BenchmarkUtils::RUN_COUNT, std::cout);
+		isValid = isValid && tree.Validate();
+	}
+
+	// reinsert: the proxies which left their fat bounds are removed and inserted again with the SAH
+	{
+		std::vector<float64_t> times;
+		uint64_t updatedCount = 0;
+		for (uint32_t run = 0; run < BenchmarkUtils::RUN_COUNT; ++run)
+		{
+			MoveObjects(objects);
+
+			const float64_t begin = BenchmarkUtils::GetTime();
+			for (const auto& object : objects)
+			{
+				updatedCount += tree.MoveProxy(object.proxyId, object.center - object.halfSize, object.center + object.halfSize) ? 1 : 0;
+			}
+			times.push_back(BenchmarkUtils::GetTime() - begin);
+		}
+
+		PrintTreeStats("aabb_tree_reinsert", tree, BenchmarkUtils::Median(times), updatedCount / BenchmarkUtils::RUN_COUNT, std::cout);
+		isValid = isValid && tree.Validate();
+	}
+
+	// reference quality: a tree built from scratch from the current positions
+	{
+		std::vector<Object> rebuiltObjects = objects;
+
+		AABBTree rebuiltTree;
+		const float64_t begin = BenchmarkUtils::GetTime();
+		BuildTree(rebuiltTree, rebuiltObjects);
+		const float64_t time = BenchmarkUtils::GetTime() - begin;
+
+		PrintTreeStats("aabb_tree_rebuild", rebuiltTree, time, objectCount, std::cout);
+	}
+
+	//// queries ////
+
+	// the brute force loops test the same fat bounds as the tree
+	std::vector<AABBTree::AABB> leafBounds(objects.size());
+	for (uint32_t i = 0; i < objects.size(); ++i)
+	{
+		leafBounds[i] = tree.GetFatAABB(objects[i].proxyId);
+	}
+
+	std::uniform_real_distribution<float32_t> positionDistribution(-WORLD_EXTENT, WORLD_EXTENT);
+	std::uniform_real_distribution<float32_t> unitDistribution(-1.0f, 1.0f);
+	std::uniform_real_distribution<float32_t> radiusDistribution(5.0f, 40.0f);
+
+	auto randomDirection = [&generator, &unitDistribution]()
+	{
+		glm::vec3 direction(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator));
+		if (glm::length(direction) < 0.01f)
+		{
+			direction = glm::vec3(0.0f, 0.0f, -1.0f);
+		}
+		return glm::normalize(direction);
+	};
+
+	std::vector<Frustum> frustums(QUERY_COUNT);
+	std::vector<glm::vec3> centers(QUERY_COUNT), directions(QUERY_COUNT);
+	std::vector<float32_t> radiuses(QUERY_COUNT);
+	const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, Z_NEAR, Z_FAR);
+	for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+	{
+		centers[i] = glm::vec3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+		directions[i] = randomDirection();
+		radiuses[i] = radiusDistribution(generator);
+
+		const glm::vec3 up = (std::abs(directions[i].y) < 0.99f) ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+		frustums[i].Update(proj * glm::lookAt(centers[i], centers[i] + directions[i], up));
+	}
+
+	// runs the queries through the tree and the brute force loop, then compares the results
+	auto runQuery = [&](const std::string& type,
+		const std::function<void(uint32_t, std::vector<uint32_t>&)>& treeQuery,
+		const std::function<int32_t(uint32_t, const AABBTree::AABB&)>& bruteForceTest)
+	{
+		QueryResult result;
+		result.type = type;
+		result.hitCount = 0;
+		result.isValid = true;
+
+		std::vector<std::vector<uint32_t>> treeHits(QUERY_COUNT);
+		float64_t begin = BenchmarkUtils::GetTime();
+		for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+		{
+			treeQuery(i, treeHits[i]);
+		}
+		result.time = BenchmarkUtils::GetTime() - begin;
+
+		// 1 hit, 0 unknown, -1 miss
+		std::vector<std::vector<uint32_t>> bruteForceHits(QUERY_COUNT), unknownHits(QUERY_COUNT);
+		begin = BenchmarkUtils::GetTime();
+		for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+		{
+			for (uint32_t j = 0; j < leafBounds.size(); ++j)
+			{
+				const int32_t test = bruteForceTest(i, leafBounds[j]);
+				if (test > 0)
+				{
+					bruteForceHits[i].push_back(objects[j].proxyId);
+				}
+				else if (0 == test)
+				{
+					unknownHits[i].push_back(objects[j].proxyId);
+				}
+			}
+		}
+		result.bruteForceTime = BenchmarkUtils::GetTime() - begin;
+
+		for (uint32_t i = 0; i < QUERY_COUNT; ++i)
+		{
+			result.hitCount += treeHits[i].size();
+
+			// the unknown leaves may be returned or not
+			auto& hits = treeHits[i];
+			std::sort(unknownHits[i].begin(), unknownHits[i].end());
+			hits.erase(std::remove_if(hits.begin(), hits.end(), [&unknownHits, i](uint32_t proxyId)
+				{
+					return std::binary_search(unknownHits[i].begin(), unknownHits[i].end(), proxyId);
+				}), hits.end());
+
+			result.isValid = result.isValid && CompareHits(hits, bruteForceHits[i]);
+		}
+
+		PrintQueryResult(result, std::cout);
+		isValid = isValid && result.isValid;
+	};
+
+	runQuery("frustum",
+		[&](uint32_t i, std::vector<uint32_t>& hits) { tree.QueryFrustum(frustums[i], hits); },
+		[&](uint32_t i, const AABBTree::AABB& aabb) { return ClassifyFrustum(aabb, frustums[i]); });
+
+	runQuery("sphere",
+		[&](uint32_t i, std::vector<uint32_t>& hits) { tree.QuerySphere(centers[i], radiuses[i], hits); },
+		[&](uint32_t i, const AABBTree::AABB& aabb) { return IsSphereHit(aabb, centers[i], radiuses[i]) ? 1 : -1; });
+
+	runQuery("aabb",
+		[&](uint32_t i, std::vector<uint32_t>& hits) { tree.QueryAABB(centers[i] - glm::vec3(radiuses[i]), centers[i] + glm::vec3(radiuses[i]), hits); },
+		[&](uint32_t i, const AABBTree::AABB& aabb) { return IsAABBHit(aabb, centers[i] - glm::vec3(radiuses[i]), centers[i] + glm::vec3(radiuses[i])) ? 1 : -1; });
+
+	runQuery("ray",
+		[&](uint32_t i, std::vector<uint32_t>& hits) { tree.RayCast(centers[i], directions[i], 2.0f * WORLD_EXTENT, hits); },
+		[&](uint32_t i, const AABBTree::AABB& aabb) { return IsRayHit(aabb, centers[i], directions[i], 2.0f * WORLD_EXTENT) ? 1 : -1; });
+
+	return isValid ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "Foundation/MemoryManagement/MemoryBenchmark.hpp"
+#include "Foundation/MemoryManagement/MemoryManager.hpp"
+#include "Foundation/Logger.hpp"
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+
+static void PrintResult(const MemoryBenchmark::Result& result, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine line(out, "allocator");
+	line.Add("allocator", MemoryBenchmark::GetAllocatorName(result.allocatorType))
+		.Add("workload", MemoryBenchmark::GetWorkloadName(result.workload))
+		.Add("operations", result.operationCount)
+		.Add("threads", result.threadCount)
+		.Add("ns_per_op", result.nsPerOperation)
+		.Add("ops_per_sec", result.operationsPerSecond)
+		.Add("peak_bytes", result.peakBytes)
+		.Add("live_peak_bytes", result.livePeakBytes);
+
+	if (result.fragmentation < 0.0)
+	{
+		line.AddNull("fragmentation");
+	}
+	else
+	{
+		line.Add("fragmentation", result.fragmentation);
+	}
+
+	line.End();
+}
+
+// usage: AllocatorBenchmark [operation count] [trace file]
+// the trace file is saved by the engine with ENABLE_MEMORY_TRACE defined
+int main(int argc, char* argv[])
+{
+	uint64_t operationCount = 1000000;
+	if (argc > 1)
+	{
+		operationCount = std::strtoull(argv[1], nullptr, 10);
+		if (operationCount == 0)
+		{
+			LOG_ERROR("Invalid operation count: %s", argv[1]);
+			return 1;
+		}
+	}
+
+	MemoryBenchmark benchmark(operationCount);
+
+	if (argc > 2)
+	{
+		std::vector<MemoryManager::TraceEvent> trace;
+		if (false == MemoryManager::LoadTrace(argv[2], trace))
+		{
+			LOG_ERROR("Failed to load the memory trace: %s", argv[2]);
+			return 1;
+		}
+
+		benchmark.SetTrace(trace);
+	}
+
+	std::vector<MemoryBenchmark::Result> results;
+	benchmark.RunAll(results);
+
+	for (const auto& result : results)
+	{
+		PrintResult(result, std::cout);
+	}
+
+	return 0;
+}
\ No newline at end of file
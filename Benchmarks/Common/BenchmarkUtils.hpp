@@ -0,0 +1,102 @@
+#ifndef BENCHMARKS_COMMON_BENCHMARK_UTILS_HPP
+#define BENCHMARKS_COMMON_BENCHMARK_UTILS_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <chrono>
+#include <algorithm> // std::nth_element()
+#include <cassert>
+
+/*
+	Shared by the benchmark executables.
+	Each measure is run several times and the median time is reported, so a single slow run does not skew it.
+	The results are printed as one JSON object per line, with a "benchmark" key and,
+	if the benchmark checks its results, a "valid" key.
+*/
+
+namespace GraphicsEngine
+{
+	namespace BenchmarkUtils
+	{
+		// default runs per measure
+		static const uint32_t RUN_COUNT = 15;
+
+		// ms
+		inline float64_t GetTime()
+		{
+			return std::chrono::duration<float64_t, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		// NOTE! Reorders the values
+		inline float64_t Median(std::vector<float64_t>& values)
+		{
+			assert(false == values.empty());
+
+			auto middle = values.begin() + values.size() / 2;
+			std::nth_element(values.begin(), middle, values.end());
+
+			return *middle;
+		}
+
+		// one result line: ResultLine(std::cout, "name").Add("key", value).Add("valid", isValid).End();
+		class ResultLine
+		{
+		public:
+			ResultLine(std::ostream& out, const char_t* pBenchmark)
+				: mOut(out)
+			{
+				mOut << "{\"benchmark\":\"" << pBenchmark << "\"";
+			}
+
+			template<typename T>
+			ResultLine& Add(const char_t* pKey, const T& value)
+			{
+				mOut << ",\"" << pKey << "\":" << value;
+
+				return *this;
+			}
+
+			ResultLine& Add(const char_t* pKey, const char_t* pValue)
+			{
+				mOut << ",\"" << pKey << "\":\"" << pValue << "\"";
+
+				return *this;
+			}
+
+			ResultLine& Add(const char_t* pKey, const std::string& value)
+			{
+				return Add(pKey, value.c_str());
+			}
+
+			ResultLine& Add(const char_t* pKey, bool_t value)
+			{
+				mOut << ",\"" << pKey << "\":" << (value ? "true" : "false");
+
+				return *this;
+			}
+
+			// unknown values
+			ResultLine& AddNull(const char_t* pKey)
+			{
+				mOut << ",\"" << pKey << "\":null";
+
+				return *this;
+			}
+
+			void End()
+			{
+				mOut << "}" << std::endl;
+			}
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(ResultLine)
+
+			std::ostream& mOut;
+		};
+	}
+}
+
+#endif // BENCHMARKS_COMMON_BENCHMARK_UTILS_HPP
\ No newline at end of file
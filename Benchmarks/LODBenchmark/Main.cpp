@@ -0,0 +1,455 @@
+#include "Graphics/SceneGraph/LODGeometryNode.hpp"
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "Graphics/GeometricPrimitives/MeshSimplifier.hpp"
+#include "Graphics/Rendering/Resources/VertexFormat.hpp"
+#include "Graphics/Rendering/Resources/VertexBuffer.hpp"
+#include "Graphics/Rendering/Resources/IndexBuffer.hpp"
+#include "Graphics/Cameras/Camera.hpp"
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Logger.hpp"
+#include "Core/AppConfig.hpp" // activate needed GLM defines
+#include "glm/gtc/matrix_transform.hpp" // translate()
+#include "glm/geometric.hpp"
+#include "glm/common.hpp" // glm::min(), glm::max()
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm> // std::min(), std::max()
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// less runs than BenchmarkUtils::RUN_COUNT, the simplification of the whole mesh is slow
+static const uint32_t RUN_COUNT = 5;
+
+// the source mesh: a bumpy sphere with a UV seam, P3 UV2
+static const uint32_t SPHERE_RINGS = 128;
+static const float32_t BUMP_HEIGHT = 0.05f;
+static const uint32_t BUMP_COUNT = 8;
+
+// each level has half the triangles of the previous one
+static const uint32_t LEVEL_COUNT = 5;
+
+// the scene: a grid of instances, the camera flies over it along -z and bobs back and forth
+static const uint32_t GRID_SIZE = 16; // per side
+static const float32_t GRID_SPACING = 4.0f;
+static const uint32_t FRAME_COUNT = 600;
+static const float32_t EYE_HEIGHT = 2.0f;
+static const float32_t BOB_AMPLITUDE = 0.5f;
+static const float32_t BOB_PERIOD = 20.0f; // frames
+
+// camera
+static const float32_t FOV_Y = 60.0f;
+static const uint32_t VIEWPORT_WIDTH = 1920;
+static const uint32_t VIEWPORT_HEIGHT = 1080;
+static const float32_t Z_NEAR = 0.1f;
+static const float32_t Z_FAR = 200.0f;
+
+static const float32_t MAX_SCREEN_ERROR = 1.0f; // pixels
+static const float32_t HYSTERESIS = 0.25f;
+
+// every Nth source vertex is measured against the simplified surface
+static const uint32_t MEASURE_STRIDE = 16;
+
+struct Mesh
+{
+	std::vector<float32_t> vertices;
+	std::vector<uint32_t> indices;
+};
+
+struct LevelResult
+{
+	uint32_t level;
+	uint32_t triangleCount;
+	float32_t error; // reported by the simplifier
+	float32_t measuredError; // max distance of the measured source vertices to the level surface
+	float64_t time; // ms, median
+	bool_t isValid;
+};
+
+struct SelectionResult
+{
+	std::string mode;
+	float32_t hysteresis;
+	float64_t triangleCount; // per frame
+	float64_t fullDetailTriangleCount; // per frame
+	uint32_t switchCount; // all the frames
+	float64_t selectTime; // ms per frame, median
+	bool_t isValid;
+};
+
+static float32_t GetRadius(float32_t theta, float32_t phi)
+{
+	return 1.0f + BUMP_HEIGHT * std::sin(BUMP_COUNT * theta) * std::sin(BUMP_COUNT * phi);
+}
+
+// the first and last columns share the positions (UV seam), so do the vertices of each pole
+static void CreateSphere(Mesh& meshOut)
+{
+	const uint32_t segments = 2 * SPHERE_RINGS;
+	const float32_t pi = 3.14159265f;
+
+	for (uint32_t ring = 0; ring <= SPHERE_RINGS; ++ring)
+	{
+		const float32_t theta = pi * ring / SPHERE_RINGS;
+
+		for (uint32_t segment = 0; segment <= segments; ++segment)
+		{
+			const float32_t phi = 2.0f * pi * (segment % segments) / segments;
+			const float32_t radius = GetRadius(theta, phi);
+
+			meshOut.vertices.push_back(radius * std::sin(theta) * std::cos(phi));
+			meshOut.vertices.push_back(radius * std::cos(theta));
+			meshOut.vertices.push_back(radius * std::sin(theta) * std::sin(phi));
+			meshOut.vertices.push_back(static_cast<float32_t>(segment) / segments);
+			meshOut.vertices.push_back(static_cast<float32_t>(ring) / SPHERE_RINGS);
+		}
+	}
+
+	for (uint32_t ring = 0; ring < SPHERE_RINGS; ++ring)
+	{
+		for (uint32_t segment = 0; segment < segments; ++segment)
+		{
+			const uint32_t i0 = ring * (segments + 1) + segment;
+			const uint32_t i1 = i0 + 1;
+			const uint32_t i2 = i0 + segments + 1;
+			const uint32_t i3 = i2 + 1;
+
+			// the pole triangles are degenerate, skipped
+			if (ring > 0)
+			{
+				meshOut.indices.push_back(i0);
+				meshOut.indices.push_back(i2);
+				meshOut.indices.push_back(i1);
+			}
+			if (ring < SPHERE_RINGS - 1)
+			{
+				meshOut.indices.push_back(i1);
+				meshOut.indices.push_back(i2);
+				meshOut.indices.push_back(i3);
+			}
+		}
+	}
+}
+
+static glm::vec3 GetPosition(const Mesh& mesh, uint32_t vertexIdx)
+{
+	const float32_t* pVertex = mesh.vertices.data() + vertexIdx * 5;
+	return glm::vec3(pVertex[0], pVertex[1], pVertex[2]);
+}
+
+// Ericson - Real-Time Collision Detection, 5.1.5
+static glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	const glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+	const float32_t d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+	if ((d1 <= 0.0f) && (d2 <= 0.0f))
+		return a;
+
+	const glm::vec3 bp = p - b;
+	const float32_t d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+	if ((d3 >= 0.0f) && (d4 <= d3))
+		return b;
+
+	const float32_t vc = d1 * d4 - d3 * d2;
+	if ((vc <= 0.0f) && (d1 >= 0.0f) && (d3 <= 0.0f))
+		return a + ab * (d1 / (d1 - d3));
+
+	const glm::vec3 cp = p - c;
+	const float32_t d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+	if ((d6 >= 0.0f) && (d5 <= d6))
+		return c;
+
+	const float32_t vb = d5 * d2 - d1 * d6;
+	if ((vb <= 0.0f) && (d2 >= 0.0f) && (d6 <= 0.0f))
+		return a + ac * (d2 / (d2 - d6));
+
+	const float32_t va = d3 * d6 - d5 * d4;
+	if ((va <= 0.0f) && ((d4 - d3) >= 0.0f) && ((d5 - d6) >= 0.0f))
+		return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+	const float32_t denom = 1.0f / (va + vb + vc);
+	return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+static float32_t MeasureError(const Mesh& mesh, const std::vector<uint32_t>& indices)
+{
+	float32_t maxDistance = 0.0f;
+	for (uint32_t i = 0; i < mesh.vertices.size() / 5; i += MEASURE_STRIDE)
+	{
+		const glm::vec3 p = GetPosition(mesh, i);
+
+		float32_t minDistance = std::numeric_limits<float32_t>::max();
+		for (uint32_t j = 0; j < indices.size(); j += 3)
+		{
+			const glm::vec3 closest = ClosestPointOnTriangle(p, GetPosition(mesh, indices[j]), GetPosition(mesh, indices[j + 1]), GetPosition(mesh, indices[j + 2]));
+			minDistance = std::min(minDistance, glm::length(p - closest));
+		}
+		maxDistance = std::max(maxDistance, minDistance);
+	}
+	return maxDistance;
+}
+
+static void PrintResult(const LevelResult& result, uint32_t sourceTriangleCount, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, "lod_simplify")
+		.Add("source_triangles", sourceTriangleCount)
+		.Add("level", result.level)
+		.Add("triangles", result.triangleCount)
+		.Add("error", result.error)
+		.Add("measured_error", result.measuredError)
+		.Add("simplify_ms", result.time)
+		.Add("valid", result.isValid)
+		.End();
+}
+
+static void PrintResult(const SelectionResult& result, uint32_t instanceCount, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, "lod_selection")
+		.Add("instances", instanceCount)
+		.Add("frames", FRAME_COUNT)
+		.Add("mode", result.mode)
+		.Add("hysteresis", result.hysteresis)
+		.Add("triangles_per_frame", result.triangleCount)
+		.Add("full_detail_triangles_per_frame", result.fullDetailTriangleCount)
+		.Add("triangles_percent", result.fullDetailTriangleCount > 0.0 ? 100.0 * result.triangleCount / result.fullDetailTriangleCount : 0.0)
+		.Add("switches", result.switchCount)
+		.Add("select_ms", result.selectTime)
+		.Add("valid", result.isValid)
+		.End();
+}
+
+static glm::vec3 GetEyePosition(uint32_t frame)
+{
+	const float32_t begin = 2.0f * GRID_SPACING;
+	const float32_t end = -static_cast<float32_t>(GRID_SIZE) * GRID_SPACING;
+	const float32_t bob = BOB_AMPLITUDE * std::sin(2.0f * 3.14159265f * frame / BOB_PERIOD);
+
+	return glm::vec3(0.0f, EYE_HEIGHT, begin + (end - begin) * frame / (FRAME_COUNT - 1) + bob);
+}
+
+static glm::vec3 GetInstancePosition(uint32_t instanceIdx)
+{
+	const float32_t halfWidth = 0.5f * (GRID_SIZE - 1) * GRID_SPACING;
+
+	return glm::vec3((instanceIdx % GRID_SIZE) * GRID_SPACING - halfWidth, 0.0f, -static_cast<float32_t>(instanceIdx / GRID_SIZE) * GRID_SPACING);
+}
+
+// usage: LODBenchmark [max screen error in pixels]
+// a bumpy sphere of 64k triangles is simplified to 5 levels of detail, each with half the triangles of the previous one
+// measures the simplification time, the reported error and the max distance of the source vertices to each level
+// then a camera flies over a grid of 16x16 instances, the level of each one is selected per frame:
+// - off: the level 0 is always drawn
+// - lod: the coarsest level whose screen error is below the max
+// - lod_hysteresis: the same with hysteresis, a coarser level must be below the max error reduced by 25%
+// measures the triangles submitted per frame and the level switches, the selected levels must be below the max screen error
+int main(int argc, char* argv[])
+{
+	const float32_t maxScreenError = (argc > 1) ? static_cast<float32_t>(std::strtod(argv[1], nullptr)) : MAX_SCREEN_ERROR;
+
+	if (false == (maxScreenError > 0.0f))
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	Mesh mesh;
+	CreateSphere(mesh);
+
+	const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size() / 5);
+	const uint32_t sourceTriangleCount = static_cast<uint32_t>(mesh.indices.size() / 3);
+
+	bool_t isValid = true;
+
+	///////////////////// simplification
+	std::vector<std::vector<uint32_t>> levelIndices(1, mesh.indices);
+	std::vector<float32_t> levelErrors(1, 0.0f);
+
+	for (uint32_t level = 1; level < LEVEL_COUNT; ++level)
+	{
+		const uint32_t targetIndexCount = (static_cast<uint32_t>(mesh.indices.size() >> level) / 3) * 3;
+
+		std::vector<uint32_t> indices(mesh.indices.size());
+		uint32_t indexCount = 0;
+		float32_t error = 0.0f;
+
+		std::vector<float64_t> times;
+		for (uint32_t run = 0; run < RUN_COUNT; ++run)
+		{
+			const float64_t begin = BenchmarkUtils::GetTime();
+			indexCount = MeshSimplifier::Simplify(mesh.indices.data(), static_cast<uint32_t>(mesh.indices.size()), mesh.vertices.data(), vertexCount, 5 * sizeof(float32_t), 0,
+				targetIndexCount, std::numeric_limits<float32_t>::max(), indices.data(), &error);
+			times.push_back(BenchmarkUtils::GetTime() - begin);
+		}
+		indices.resize(indexCount);
+
+		LevelResult result{};
+		result.level = level;
+		result.triangleCount = indexCount / 3;
+		result.error = error;
+		result.measuredError = MeasureError(mesh, indices);
+		result.time = BenchmarkUtils::Median(times);
+
+		// fewer triangles and a bigger error than the previous level, the selection relies on the error not being below the measured one
+		result.isValid = (indexCount > 0) && (indexCount < levelIndices.back().size()) && (error >= levelErrors.back()) && (result.measuredError <= error);
+		for (auto index : indices)
+		{
+			result.isValid = result.isValid && (index < vertexCount);
+		}
+
+		PrintResult(result, sourceTriangleCount, std::cout);
+		isValid = isValid && result.isValid;
+
+		levelIndices.push_back(indices);
+		levelErrors.push_back(error);
+	}
+
+	///////////////////// selection
+	// the instances share the vertex and index buffers, each node has its own primitives (owned by the node)
+	VertexFormat* pVertexFormat = GE_ALLOC(VertexFormat)(3, 0, 0, 0, 2); //P3 UV2
+	VertexBuffer* pVertexBuffer = GE_ALLOC(VertexBuffer)(pVertexFormat, Buffer::BufferUsage::GE_BU_STATIC, mesh.vertices.data(), static_cast<uint32_t>(mesh.vertices.size() * sizeof(float32_t)));
+
+	std::vector<IndexBuffer*> indexBuffers;
+	for (auto& indices : levelIndices)
+	{
+		indexBuffers.push_back(GE_ALLOC(IndexBuffer)(IndexBuffer::BufferUsage::GE_BU_STATIC, IndexBuffer::IndexType::GE_IT_UINT32, indices.data(), static_cast<uint32_t>(indices.size() * sizeof(uint32_t))));
+	}
+
+	// the bounding sphere of an instance, as computed by the nodes: the center of the AABB and the farthest vertex
+	glm::vec3 boundsMin(std::numeric_limits<float32_t>::max()), boundsMax(-std::numeric_limits<float32_t>::max());
+	for (uint32_t i = 0; i < vertexCount; ++i)
+	{
+		boundsMin = glm::min(boundsMin, GetPosition(mesh, i));
+		boundsMax = glm::max(boundsMax, GetPosition(mesh, i));
+	}
+	const glm::vec3 boundsCenter = (boundsMin + boundsMax) * 0.5f;
+	float32_t boundsRadius = 0.0f;
+	for (uint32_t i = 0; i < vertexCount; ++i)
+	{
+		boundsRadius = std::max(boundsRadius, glm::length(GetPosition(mesh, i) - boundsCenter));
+	}
+
+	Camera camera("LODBenchmarkCamera");
+	camera.UpdatePerspectiveProjectionMatrix(FOV_Y, static_cast<float32_t>(VIEWPORT_WIDTH) / VIEWPORT_HEIGHT, Z_NEAR, Z_FAR);
+	camera.SetForward(glm::normalize(glm::vec3(0.0f, -0.1f, -1.0f)));
+
+	const uint32_t instanceCount = GRID_SIZE * GRID_SIZE;
+	const float32_t modes[][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, HYSTERESIS } }; // LOD on, hysteresis
+	const char* modeNames[] = { "off", "lod", "lod_hysteresis" };
+
+	std::vector<std::vector<uint32_t>> plainLevels(FRAME_COUNT, std::vector<uint32_t>(instanceCount, 0));
+	std::vector<SelectionResult> results;
+
+	for (uint32_t mode = 0; mode < 3; ++mode)
+	{
+		const bool_t isLODEnabled = (modes[mode][0] > 0.0f);
+
+		std::vector<LODGeometryNode*> nodes;
+		for (uint32_t i = 0; i < instanceCount; ++i)
+		{
+			LODGeometryNode* pNode = GE_ALLOC(LODGeometryNode)("LODNode");
+			pNode->SetModelMatrix(glm::translate(glm::mat4(1.0f), GetInstancePosition(i)));
+			pNode->SetMaxScreenError(maxScreenError);
+			pNode->SetHysteresis(modes[mode][1]);
+
+			for (uint32_t level = 0; level < levelIndices.size(); ++level)
+			{
+				GeometricPrimitive* pPrimitive = GE_ALLOC(GeometricPrimitive);
+				pPrimitive->SetVertexBuffer(pVertexBuffer);
+				pPrimitive->SetIndexBuffer(indexBuffers[level]);
+
+				if (0 == level)
+				{
+					pNode->SetGeometry(pPrimitive);
+				}
+				else
+				{
+					pNode->AddLevel(pPrimitive, levelErrors[level]);
+				}
+			}
+			nodes.push_back(pNode);
+		}
+
+		SelectionResult result{};
+		result.mode = modeNames[mode];
+		result.hysteresis = modes[mode][1];
+		result.isValid = true;
+
+		std::vector<float64_t> times;
+		uint64_t triangleCount = 0, fullDetailTriangleCount = 0;
+
+		for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame)
+		{
+			camera.SetPosition(GetEyePosition(frame));
+			camera.UpdateViewMatrix();
+
+			const float64_t begin = BenchmarkUtils::GetTime();
+			if (isLODEnabled)
+			{
+				for (auto* pNode : nodes)
+				{
+					if (pNode->SelectLevel(&camera, VIEWPORT_HEIGHT))
+					{
+						result.switchCount++;
+					}
+				}
+			}
+			times.push_back(BenchmarkUtils::GetTime() - begin);
+
+			const float32_t pixelsPerUnit = 0.5f * VIEWPORT_HEIGHT / std::tan(glm::radians(0.5f * FOV_Y));
+			for (uint32_t i = 0; i < instanceCount; ++i)
+			{
+				const uint32_t level = nodes[i]->GetLevel();
+				triangleCount += nodes[i]->GetLevelIndexCount(level) / 3;
+				fullDetailTriangleCount += nodes[i]->GetLevelIndexCount(0) / 3;
+
+				// the error of the selected level, projected at the nearest point of the instance
+				const float32_t distance = std::max(glm::length(GetInstancePosition(i) + boundsCenter - camera.GetPosition()) - boundsRadius, Z_NEAR);
+				result.isValid = result.isValid && (levelErrors[level] * pixelsPerUnit / distance <= maxScreenError * 1.001f);
+
+				// the hysteresis only delays the switches to the coarser levels
+				if (isLODEnabled && (0.0f == modes[mode][1]))
+				{
+					plainLevels[frame][i] = level;
+				}
+				else if (isLODEnabled)
+				{
+					result.isValid = result.isValid && (level <= plainLevels[frame][i]);
+				}
+			}
+		}
+
+		result.triangleCount = static_cast<float64_t>(triangleCount) / FRAME_COUNT;
+		result.fullDetailTriangleCount = static_cast<float64_t>(fullDetailTriangleCount) / FRAME_COUNT;
+		result.selectTime = BenchmarkUtils::Median(times);
+
+		// the hysteresis removes switches
+		if (isLODEnabled && (modes[mode][1] > 0.0f))
+		{
+			result.isValid = result.isValid && (result.switchCount <= results.back().switchCount);
+		}
+
+		PrintResult(result, instanceCount, std::cout);
+		isValid = isValid && result.isValid;
+
+		for (auto* pNode : nodes)
+		{
+			GE_FREE(pNode);
+		}
+		results.push_back(result);
+	}
+
+	// the renderer frees the buffers of the drawn nodes, here they are freed by hand
+	for (auto* pIndexBuffer : indexBuffers)
+	{
+		GE_FREE(pIndexBuffer);
+	}
+	GE_FREE(pVertexBuffer);
+	GE_FREE(pVertexFormat);
+
+	return isValid ? 0 : 1;
+}
\ No newline at end of file
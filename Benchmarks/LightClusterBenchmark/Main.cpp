@@ -0,0 +1,315 @@
+#include "Graphics/Lights/LightClusterGrid.hpp"
+#include "Graphics/Lights/PointLight.hpp"
+#include "Graphics/Lights/SpotLight.hpp"
+#include "Foundation/TaskScheduler.hpp"
+#include "Foundation/Logger.hpp"
+#include "Core/AppConfig.hpp" // activate needed GLM defines
+#include "glm/gtc/matrix_transform.hpp" // perspective(), lookAt()
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <thread>
+#include <algorithm> // std::max()
+#include <cmath>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// camera
+static const float32_t Z_NEAR = 0.1f;
+static const float32_t Z_FAR = 200.0f;
+
+// the reference test is done with the radius scaled by 1 -/+ this, so the float rounding of the borders is ignored
+static const float32_t RADIUS_TOLERANCE = 1e-4f;
+
+struct Result
+{
+	uint32_t threadCount;
+	float64_t time; // ms, median
+	float64_t speedup; // compared to 1 thread
+	uint32_t indexCount;
+	uint32_t maxClusterLightCount;
+	bool_t isValid;
+};
+
+// lights spread in front of the camera and a bit around it, 3 point lights for each spot light
+static void CreateLights(uint32_t lightCount, std::vector<std::unique_ptr<Light>>& lightsOut)
+{
+	std::mt19937 generator(1234);
+	std::uniform_real_distribution<float32_t> xyDistribution(-60.0f, 60.0f);
+	std::uniform_real_distribution<float32_t> zDistribution(-Z_FAR, 10.0f);
+	std::uniform_real_distribution<float32_t> rangeDistribution(1.0f, 8.0f);
+	std::uniform_real_distribution<float32_t> unitDistribution(-1.0f, 1.0f);
+	std::uniform_real_distribution<float32_t> angleDistribution(0.2f, 1.2f);
+
+	for (uint32_t i = 0; i < lightCount; ++i)
+	{
+		const glm::vec3 position(xyDistribution(generator), xyDistribution(generator) * 0.5f, zDistribution(generator));
+		const Color3f color(0.5f + 0.5f * unitDistribution(generator), 1.0f, 0.5f);
+
+		if (i % 4 == 3)
+		{
+			glm::vec3 direction(unitDistribution(generator), unitDistribution(generator), unitDistribution(generator));
+			if (glm::length(direction) < 0.01f)
+			{
+				direction = glm::vec3(0.0f, -1.0f, 0.0f);
+			}
+
+			lightsOut.emplace_back(new SpotLight(position, direction, color, 2.0f * rangeDistribution(generator), angleDistribution(generator)));
+		}
+		else
+		{
+			lightsOut.emplace_back(new PointLight(position, color, rangeDistribution(generator)));
+		}
+	}
+}
+
+// the bounding sphere of a light in view space, depth as a positive distance
+static void ComputeViewSphere(const Light* pLight, const glm::mat4& view, glm::vec3& centerOut, float32_t& radiusOut)
+{
+	glm::vec3 center = pLight->GetPosition();
+	float32_t radius = pLight->GetRange();
+
+	if (Light::LightType::GE_LT_SPOT == pLight->GetLightType())
+	{
+		const glm::vec3& dir = pLight->GetDirection();
+		const float32_t angle = static_cast<const SpotLight*>(pLight)->GetConeAngle();
+
+		if (angle > glm::radians(45.0f))
+		{
+			center += dir * (std::cos(angle) * radius);
+			radius *= std::sin(angle);
+		}
+		else
+		{
+			radius *= 0.5f / std::cos(angle);
+			center += dir * radius;
+		}
+	}
+
+	const glm::vec4 viewCenter = view * glm::vec4(center, 1.0f);
+#if defined(LEFT_HAND_COORDINATES)
+	centerOut = glm::vec3(viewCenter.x, viewCenter.y, viewCenter.z);
+#else
+	centerOut = glm::vec3(viewCenter.x, viewCenter.y, -viewCenter.z);
+#endif // LEFT_HAND_COORDINATES
+	radiusOut = radius;
+}
+
+static bool_t IsSphereInBox(const glm::vec3& center, float32_t radius, const glm::vec3& boxMin, const glm::vec3& boxMax)
+{
+	const glm::vec3 d = glm::max(glm::max(boxMin - center, center - boxMax), glm::vec3(0.0f));
+
+	return (glm::dot(d, d) <= radius * radius);
+}
+
+// true if the point is in the froxel of the cluster, the tile borders are given by the grid info, as for the shaders
+static bool_t IsPointInCluster(const LightClusterGrid& grid, uint32_t tileX, uint32_t tileY, const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::vec3& point)
+{
+	const auto& tileScale = grid.GetGridInfo().tileScale;
+
+	if ((point.z < boxMin.z) || (point.z > boxMax.z))
+		return false;
+
+	const float32_t tileCoordX = point.x / point.z * tileScale.x + tileScale.z;
+	const float32_t tileCoordY = point.y / point.z * tileScale.y + tileScale.w;
+
+	return (tileCoordX >= static_cast<float32_t>(tileX)) && (tileCoordX <= static_cast<float32_t>(tileX + 1))
+		&& (tileCoordY >= static_cast<float32_t>(tileY)) && (tileCoordY <= static_cast<float32_t>(tileY + 1));
+}
+
+// true if the sphere certainly touches the froxel of the cluster: its point closest to the sphere, or one of its corners, is in the sphere
+static bool_t IsSphereInCluster(const LightClusterGrid& grid, uint32_t tileX, uint32_t tileY, const glm::vec3& boxMin, const glm::vec3& boxMax, const glm::vec3& center, float32_t radius)
+{
+	const glm::vec3 closest = glm::clamp(center, boxMin, boxMax);
+	if ((glm::dot(closest - center, closest - center) <= radius * radius) && IsPointInCluster(grid, tileX, tileY, boxMin, boxMax, closest))
+		return true;
+
+	const auto& tileScale = grid.GetGridInfo().tileScale;
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		const float32_t z = (i & 1) ? boxMax.z : boxMin.z;
+		const float32_t slopeX = (static_cast<float32_t>(tileX + ((i >> 1) & 1)) - tileScale.z) / tileScale.x;
+		const float32_t slopeY = (static_cast<float32_t>(tileY + ((i >> 2) & 1)) - tileScale.w) / tileScale.y;
+
+		const glm::vec3 corner(slopeX * z, slopeY * z, z);
+		if (glm::dot(corner - center, corner - center) <= radius * radius)
+			return true;
+	}
+
+	return false;
+}
+
+// brute force check of every cluster against every light
+// a binned light must touch the cluster box, a light which certainly touches the cluster must be binned
+static bool_t Validate(const LightClusterGrid& grid, const std::vector<const Light*>& lights, const glm::mat4& view)
+{
+	std::vector<glm::vec3> centers(lights.size());
+	std::vector<float32_t> radiuses(lights.size());
+	for (uint32_t i = 0; i < lights.size(); ++i)
+	{
+		ComputeViewSphere(lights[i], view, centers[i], radiuses[i]);
+	}
+
+	if (grid.GetLights().size() != lights.size())
+		return false;
+
+	const auto& clusters = grid.GetClusters();
+	const auto& indices = grid.GetLightIndices();
+
+	uint32_t clusterIdx = 0;
+	for (uint32_t slice = 0; slice < grid.GetSliceCount(); ++slice)
+	{
+		for (uint32_t tileY = 0; tileY < grid.GetTileCountY(); ++tileY)
+		{
+			for (uint32_t tileX = 0; tileX < grid.GetTileCountX(); ++tileX, ++clusterIdx)
+			{
+				glm::vec3 boxMin, boxMax;
+				grid.GetClusterBounds(tileX, tileY, slice, boxMin, boxMax);
+
+				const auto& cluster = clusters[clusterIdx];
+				if (cluster.offset + cluster.count > indices.size())
+					return false;
+
+				std::vector<bool_t> isBinned(lights.size(), false);
+				for (uint32_t i = cluster.offset; i < cluster.offset + cluster.count; ++i)
+				{
+					// sorted, no duplicates
+					if ((i > cluster.offset) && (indices[i] <= indices[i - 1]))
+						return false;
+
+					isBinned[indices[i]] = true;
+				}
+
+				for (uint32_t lightIdx = 0; lightIdx < lights.size(); ++lightIdx)
+				{
+					const float32_t radius = radiuses[lightIdx];
+
+					if (isBinned[lightIdx] && (false == IsSphereInBox(centers[lightIdx], radius * (1.0f + RADIUS_TOLERANCE), boxMin, boxMax)))
+						return false;
+					if ((false == isBinned[lightIdx]) && IsSphereInCluster(grid, tileX, tileY, boxMin, boxMax, centers[lightIdx], radius * (1.0f - RADIUS_TOLERANCE)))
+						return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+static void PrintResult(const Result& result, uint32_t lightCount, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, "light_binning")
+		.Add("lights", lightCount)
+		.Add("threads", result.threadCount)
+		.Add("time_ms", result.time)
+		.Add("speedup", result.speedup)
+		.Add("indices", result.indexCount)
+		.Add("max_cluster_lights", result.maxClusterLightCount)
+		.Add("valid", result.isValid)
+		.End();
+}
+
+// usage: LightClusterBenchmark [light count] [max thread count]
+// measures the binning of the lights in the default cluster grid, with 1 thread (inline) up to max thread count
+// the clusters are checked against a brute force test, and the output must be the same for any thread count
+int main(int argc, char* argv[])
+{
+	const uint32_t lightCount = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1000;
+	const uint32_t coreCount = std::max<uint32_t>(1, std::thread::hardware_concurrency());
+	const uint32_t maxThreadCount = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : coreCount;
+
+	if ((0 == lightCount) || (0 == maxThreadCount))
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	std::vector<std::unique_ptr<Light>> ownedLights;
+	CreateLights(lightCount, ownedLights);
+
+	std::vector<const Light*> lights;
+	for (const auto& light : ownedLights)
+	{
+		lights.push_back(light.get());
+	}
+
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f, 0.0f, -50.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, Z_NEAR, Z_FAR);
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+	threadCounts.push_back(maxThreadCount);
+
+	LightClusterGrid grid;
+
+	std::vector<Result> results;
+	std::vector<uint32_t> baseIndices;
+	std::vector<LightClusterGrid::ClusterRange> baseClusters;
+
+	for (auto threadCount : threadCounts)
+	{
+		// 1 thread - no scheduler, everything runs inline
+		if (threadCount > 1)
+		{
+			TaskScheduler::Init(threadCount - 1);
+		}
+
+		std::vector<float64_t> times;
+		for (uint32_t i = 0; i < BenchmarkUtils::RUN_COUNT; ++i)
+		{
+			const float64_t begin = BenchmarkUtils::GetTime();
+			grid.Update(view, proj, Z_NEAR, Z_FAR, lights);
+			times.push_back(BenchmarkUtils::GetTime() - begin);
+		}
+
+		TaskScheduler::Terminate();
+
+		Result result;
+		result.threadCount = threadCount;
+		result.time = BenchmarkUtils::Median(times);
+		result.speedup = results.empty() ? 1.0 : (results.front().time / result.time);
+		result.indexCount = static_cast<uint32_t>(grid.GetLightIndices().size());
+
+		result.maxClusterLightCount = 0;
+		for (const auto& cluster : grid.GetClusters())
+		{
+			result.maxClusterLightCount = std::max(result.maxClusterLightCount, cluster.count);
+		}
+
+		if (results.empty())
+		{
+			result.isValid = Validate(grid, lights, view);
+
+			baseIndices = grid.GetLightIndices();
+			baseClusters = grid.GetClusters();
+		}
+		else
+		{
+			result.isValid = (grid.GetLightIndices() == baseIndices) && (grid.GetClusters().size() == baseClusters.size());
+			for (uint32_t i = 0; result.isValid && (i < baseClusters.size()); ++i)
+			{
+				result.isValid = (grid.GetClusters()[i].offset == baseClusters[i].offset) && (grid.GetClusters()[i].count == baseClusters[i].count);
+			}
+		}
+
+		results.push_back(result);
+	}
+
+	bool_t isValid = true;
+	for (const auto& result : results)
+	{
+		PrintResult(result, lightCount, std::cout);
+
+		isValid = isValid && result.isValid;
+	}
+
+	return isValid ? 0 : 1;
+}
\ No newline at end of file
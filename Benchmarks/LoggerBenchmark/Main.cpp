@@ -0,0 +1,170 @@
+#include "Foundation/Logger.hpp"
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm> // std::sort()
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+
+// messages logged back to back, about one frame worth of messages
+static const uint32_t BURST_SIZE = 64;
+
+struct Result
+{
+	std::string name;
+	uint64_t callCount;
+	float64_t timerOverhead; // ns, included in the call times
+	float64_t meanTime; // ns
+	uint64_t p50Time;
+	uint64_t p99Time;
+	uint64_t maxTime;
+};
+
+// the calls are timed one by one, so in ns instead of the ms of BenchmarkUtils::GetTime()
+static uint64_t GetTimeNs()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static uint64_t MeasureTimerOverhead()
+{
+	std::vector<uint64_t> times(10000);
+	for (auto& time : times)
+	{
+		const uint64_t begin = GetTimeNs();
+		time = GetTimeNs() - begin;
+	}
+
+	std::sort(times.begin(), times.end());
+
+	return times[times.size() / 2];
+}
+
+static void ComputeResult(std::vector<uint64_t>& times, Result& result)
+{
+	std::sort(times.begin(), times.end());
+
+	uint64_t totalTime = 0;
+	for (auto time : times)
+	{
+		totalTime += time;
+	}
+
+	result.callCount = times.size();
+	result.meanTime = static_cast<float64_t>(totalTime) / times.size();
+	result.p50Time = times[times.size() / 2];
+	result.p99Time = times[(times.size() * 99) / 100];
+	result.maxTime = times.back();
+}
+
+static void PrintResult(const Result& result, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, "logger")
+		.Add("logger", result.name)
+		.Add("calls", result.callCount)
+		.Add("timer_overhead_ns", result.timerOverhead)
+		.Add("mean_ns", result.meanTime)
+		.Add("p50_ns", result.p50Time)
+		.Add("p99_ns", result.p99Time)
+		.Add("max_ns", result.maxTime)
+		.End();
+}
+
+// the former synchronous logging: formatted on the calling thread, file/func/line printed, flushed
+static void LogPrintf(std::FILE* pFile, uint32_t frame, float32_t time, const char_t* pName)
+{
+	std::fprintf(pFile, "Frame %u, %s updated in %.3f ms", frame, pName, time);
+	std::fprintf(pFile, "\nFILE: %s, FUNC: %s, LINE: %d \n\n", __FILE__, __FUNCTION__, __LINE__);
+	std::fflush(pFile);
+}
+
+template <typename LogFunction>
+static void Run(uint32_t callCount, LogFunction logFunction, bool_t isAsync, std::vector<uint64_t>& timesOut)
+{
+	timesOut.resize(callCount);
+
+	for (uint32_t i = 0; i < callCount; ++i)
+	{
+		const uint64_t begin = GetTimeNs();
+		logFunction(i);
+		timesOut[i] = GetTimeNs() - begin;
+
+		// lets the writer thread drain the ring between bursts, as between frames, so no message is dropped
+		if (isAsync && ((i % BURST_SIZE) == (BURST_SIZE - 1)))
+		{
+			Log::Flush();
+		}
+	}
+}
+
+// usage: LoggerBenchmark [call count] [log file]
+// measures the time spent by the calling thread per message, the messages are written to the log file
+int main(int argc, char* argv[])
+{
+	uint32_t callCount = 100000;
+	if (argc > 1)
+	{
+		callCount = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+		if (callCount == 0)
+		{
+			LOG_ERROR("Invalid call count: %s", argv[1]);
+			return 1;
+		}
+	}
+
+	const std::string filePath = (argc > 2) ? argv[2] : "logger_benchmark.log";
+
+	std::FILE* pFile = std::fopen(filePath.c_str(), "w");
+	if (nullptr == pFile)
+	{
+		LOG_ERROR("Failed to open the log file: %s", filePath.c_str());
+		return 1;
+	}
+
+	const char_t* names[] = { "Camera", "Light", "Skybox", "Terrain" };
+	const float64_t timerOverhead = static_cast<float64_t>(MeasureTimerOverhead());
+
+	std::vector<Result> results;
+	std::vector<uint64_t> times;
+
+	Run(callCount, [&](uint32_t i) { LogPrintf(pFile, i, i * 0.001f, names[i & 3]); }, false, times);
+	results.push_back(Result());
+	results.back().name = "printf";
+	ComputeResult(times, results.back());
+
+	std::fclose(pFile);
+
+	Log::SetConsoleOutput(false);
+	if (false == Log::AddFileSink(filePath))
+	{
+		LOG_ERROR("Failed to open the log file: %s", filePath.c_str());
+		return 1;
+	}
+
+	// no writer thread yet, formatted and written on the calling thread
+	Run(callCount, [&](uint32_t i) { LOG_WARNING("Frame %u, %s updated in %.3f ms", i, names[i & 3], i * 0.001f); }, false, times);
+	results.push_back(Result());
+	results.back().name = "sync";
+	ComputeResult(times, results.back());
+
+	Log::Init();
+
+	Run(callCount, [&](uint32_t i) { LOG_WARNING("Frame %u, %s updated in %.3f ms", i, names[i & 3], i * 0.001f); }, true, times);
+	results.push_back(Result());
+	results.back().name = "async";
+	ComputeResult(times, results.back());
+
+	Log::Terminate();
+
+	for (auto& result : results)
+	{
+		result.timerOverhead = timerOverhead;
+		PrintResult(result, std::cout);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "Graphics/GeometricPrimitives/MeshletBuilder.hpp"
+#include "Graphics/GeometricPrimitives/MeshOptimizer.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "Foundation/Logger.hpp"
+#include "Core/AppConfig.hpp" // activate needed GLM defines
+#include "glm/gtc/constants.hpp" // pi(), two_pi()
+#include "glm/gtc/matrix_transform.hpp" // perspective(), lookAt()
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// less runs than BenchmarkUtils::RUN_COUNT, each cull run is already CULL_ITERATION_COUNT iterations
+static const uint32_t RUN_COUNT = 5;
+
+static const uint32_t SEGMENT_COUNT = 256;
+
+// the meshlets are culled this many times per run
+static const uint32_t CULL_ITERATION_COUNT = 100;
+
+struct Mesh
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+};
+
+struct Result
+{
+	uint32_t triangleCount;
+	uint32_t meshletCount;
+	uint32_t visibleTriangleCount;
+	float64_t buildTime; // ms, median
+	float64_t cullTime; // ms per iteration, median
+	bool_t isValid;
+};
+
+// unit UV sphere, counter clockwise front faces
+static void CreateSphere(uint32_t segmentCount, Mesh& meshOut)
+{
+	const uint32_t ringCount = segmentCount / 2, columnCount = segmentCount + 1;
+
+	for (uint32_t ring = 0; ring <= ringCount; ++ring)
+	{
+		const float32_t theta = glm::pi<float32_t>() * ring / ringCount;
+		for (uint32_t segment = 0; segment < columnCount; ++segment)
+		{
+			const float32_t phi = glm::two_pi<float32_t>() * segment / segmentCount;
+			meshOut.positions.push_back(glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)));
+		}
+	}
+
+	for (uint32_t ring = 0; ring < ringCount; ++ring)
+	{
+		for (uint32_t segment = 0; segment < segmentCount; ++segment)
+		{
+			const uint32_t i0 = ring * columnCount + segment, i1 = i0 + 1, i2 = i0 + columnCount, i3 = i2 + 1;
+			meshOut.indices.push_back(i0); meshOut.indices.push_back(i1); meshOut.indices.push_back(i2);
+			meshOut.indices.push_back(i1); meshOut.indices.push_back(i3); meshOut.indices.push_back(i2);
+		}
+	}
+}
+
+static void PrintResult(const Result& result, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, "meshlets")
+		.Add("triangles", result.triangleCount)
+		.Add("meshlets", result.meshletCount)
+		.Add("triangles_per_meshlet", result.meshletCount > 0 ? static_cast<float64_t>(result.triangleCount) / result.meshletCount : 0.0)
+		.Add("build_ms", result.buildTime)
+		.Add("cull_ms", result.cullTime)
+		.Add("visible_triangles", result.visibleTriangleCount)
+		.Add("visible_percent", result.triangleCount > 0 ? 100.0 * result.visibleTriangleCount / result.triangleCount : 0.0)
+		.Add("valid", result.isValid)
+		.End();
+}
+
+// usage: MeshletBenchmark [sphere segment count]
+// a UV sphere is split in meshlets (after the vertex cache optimization, as the loader does), measures:
+// - the build time: BuildMeshlets + ComputeMeshletBounds
+// - the cull time: the frustum and cone test of all the meshlets, the camera looks at the sphere from the side
+// the meshlets must re-assemble the source triangles and the cone test must cull some of them
+int main(int argc, char* argv[])
+{
+	const uint32_t segmentCount = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : SEGMENT_COUNT;
+
+	if (segmentCount < 4)
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	Mesh mesh;
+	CreateSphere(segmentCount, mesh);
+
+	const uint32_t indexCount = static_cast<uint32_t>(mesh.indices.size());
+	const uint32_t vertexCount = static_cast<uint32_t>(mesh.positions.size());
+	MeshOptimizer::OptimizeVertexCache(mesh.indices.data(), indexCount);
+
+	Result result{};
+	result.triangleCount = indexCount / 3;
+
+	///////////////////// build
+	MeshletBuilder::ClusterTable table;
+
+	std::vector<float64_t> times;
+	for (uint32_t run = 0; run < RUN_COUNT; ++run)
+	{
+		table = MeshletBuilder::ClusterTable();
+
+		const float64_t begin = BenchmarkUtils::GetTime();
+		result.meshletCount = MeshletBuilder::BuildMeshlets(mesh.indices.data(), indexCount, vertexCount, table);
+		MeshletBuilder::ComputeMeshletBounds(table, 0, mesh.positions.data(), sizeof(glm::vec3), 0);
+		times.push_back(BenchmarkUtils::GetTime() - begin);
+	}
+	result.buildTime = BenchmarkUtils::Median(times);
+
+	result.isValid = (result.meshletCount > 0) && MeshletBuilder::ValidateMeshlets(table, 0, result.meshletCount, mesh.indices.data(), indexCount);
+	if (false == result.isValid)
+	{
+		LOG_ERROR("The meshlets do not re-assemble the source triangles!");
+	}
+
+	///////////////////// cull
+	const glm::vec3 cameraPosition(0.0f, 0.0f, 3.0f);
+	const glm::mat4 projectionView = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+		glm::lookAt(cameraPosition, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const Frustum frustum(projectionView);
+
+	times.clear();
+	for (uint32_t run = 0; run < RUN_COUNT; ++run)
+	{
+		const float64_t begin = BenchmarkUtils::GetTime();
+		for (uint32_t iteration = 0; iteration < CULL_ITERATION_COUNT; ++iteration)
+		{
+			result.visibleTriangleCount = 0;
+			for (uint32_t m = 0; m < result.meshletCount; ++m)
+			{
+				if (MeshletBuilder::IsMeshletVisible(table.bounds[m], frustum, cameraPosition))
+				{
+					result.visibleTriangleCount += table.meshlets[m].triangleCount;
+				}
+			}
+		}
+		times.push_back((BenchmarkUtils::GetTime() - begin) / CULL_ITERATION_COUNT);
+	}
+	result.cullTime = BenchmarkUtils::Median(times);
+
+	// the whole sphere is in the frustum, the cone test culls some of the meshlets facing away from the camera
+	result.isValid = result.isValid && (result.visibleTriangleCount > 0) && (result.visibleTriangleCount < result.triangleCount);
+
+	PrintResult(result, std::cout);
+
+	return result.isValid ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,400 @@
+#include "Graphics/Rendering/OcclusionBuffer.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "Foundation/TaskScheduler.hpp"
+#include "Foundation/Logger.hpp"
+#include "Core/AppConfig.hpp" // activate needed GLM defines
+#include "glm/gtc/matrix_transform.hpp" // perspective(), lookAt()
+#include "glm/geometric.hpp"
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+#include <algorithm> // std::max()
+#include <cmath>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// the camera looks around from the middle room, a frame per view
+static const uint32_t VIEW_COUNT = 8;
+
+// interior: a grid of rooms, the walls have a door in the middle
+static const uint32_t ROOM_COUNT = 8; // per side
+static const float32_t ROOM_SIZE = 10.0f;
+static const float32_t ROOM_HEIGHT = 4.0f;
+static const float32_t WALL_THICKNESS = 0.2f;
+static const float32_t DOOR_WIDTH = 1.5f;
+
+// the small objects in each room
+static const float32_t MIN_OBJECT_SIZE = 0.2f;
+static const float32_t MAX_OBJECT_SIZE = 1.0f;
+
+// camera
+static const float32_t EYE_HEIGHT = 1.7f;
+static const float32_t Z_NEAR = 0.1f;
+static const float32_t Z_FAR = 200.0f;
+
+// the sample points of an occluded object are moved this much to its center, so the rays don't graze the walls it touches
+static const float32_t SAMPLE_SHRINK = 0.95f;
+
+struct Box
+{
+	glm::vec3 min;
+	glm::vec3 max;
+};
+
+// the box occluder meshes share the indices
+struct Occluder
+{
+	std::vector<glm::vec3> positions;
+};
+
+struct Result
+{
+	uint32_t threadCount;
+	// ms per frame, median
+	float64_t setupTime;
+	float64_t rasterTime;
+	float64_t hiZTime;
+	float64_t testTime;
+	float64_t totalTime;
+	float64_t speedup; // of the total time, compared to 1 thread
+	uint32_t triangleCount; // per frame
+	uint32_t binnedTriangleCount; // per frame
+	uint32_t testedCount; // all the views
+	uint32_t occludedCount; // all the views
+	uint32_t falseOcclusionCount;
+	bool_t isValid;
+};
+
+static const uint32_t BOX_INDICES[] =
+{
+	0, 1, 3, 0, 3, 2, // -x
+	4, 6, 7, 4, 7, 5, // +x
+	0, 4, 5, 0, 5, 1, // -y
+	2, 3, 7, 2, 7, 6, // +y
+	0, 2, 6, 0, 6, 4, // -z
+	1, 5, 7, 1, 7, 3  // +z
+};
+static const uint32_t BOX_INDEX_COUNT = sizeof(BOX_INDICES) / sizeof(BOX_INDICES[0]);
+
+static Occluder CreateBoxOccluder(const glm::vec3& min, const glm::vec3& max)
+{
+	Occluder occluder;
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		occluder.positions.push_back(glm::vec3((i & 4) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 1) ? max.z : min.z));
+	}
+	return occluder;
+}
+
+// each wall is split in 2 boxes by its door
+static void CreateWalls(std::vector<Occluder>& occludersOut)
+{
+	const float32_t halfThickness = 0.5f * WALL_THICKNESS;
+
+	for (uint32_t line = 0; line <= ROOM_COUNT; ++line)
+	{
+		const float32_t linePosition = line * ROOM_SIZE;
+
+		for (uint32_t room = 0; room < ROOM_COUNT; ++room)
+		{
+			const float32_t begin = room * ROOM_SIZE;
+			const float32_t doorBegin = begin + 0.5f * (ROOM_SIZE - DOOR_WIDTH);
+			const float32_t doorEnd = doorBegin + DOOR_WIDTH;
+			const float32_t end = begin + ROOM_SIZE;
+
+			// the outer walls have no doors
+			const bool_t hasDoor = (line > 0) && (line < ROOM_COUNT);
+			const float32_t segments[2][2] = { { begin, hasDoor ? doorBegin : end }, { hasDoor ? doorEnd : end, end } };
+
+			for (uint32_t i = 0; i < 2; ++i)
+			{
+				if (segments[i][0] >= segments[i][1])
+					continue;
+
+				// along x and along z
+				occludersOut.push_back(CreateBoxOccluder(glm::vec3(segments[i][0], 0.0f, linePosition - halfThickness), glm::vec3(segments[i][1], ROOM_HEIGHT, linePosition + halfThickness)));
+				occludersOut.push_back(CreateBoxOccluder(glm::vec3(linePosition - halfThickness, 0.0f, segments[i][0]), glm::vec3(linePosition + halfThickness, ROOM_HEIGHT, segments[i][1])));
+			}
+		}
+	}
+}
+
+static void CreateObjects(uint32_t objectsPerRoom, std::vector<Box>& boxesOut)
+{
+	std::mt19937 generator(1234);
+	std::uniform_real_distribution<float32_t> positionDistribution(WALL_THICKNESS + MAX_OBJECT_SIZE, ROOM_SIZE - WALL_THICKNESS - MAX_OBJECT_SIZE);
+	std::uniform_real_distribution<float32_t> heightDistribution(0.0f, ROOM_HEIGHT - MAX_OBJECT_SIZE);
+	std::uniform_real_distribution<float32_t> sizeDistribution(MIN_OBJECT_SIZE, MAX_OBJECT_SIZE);
+
+	for (uint32_t roomZ = 0; roomZ < ROOM_COUNT; ++roomZ)
+	{
+		for (uint32_t roomX = 0; roomX < ROOM_COUNT; ++roomX)
+		{
+			for (uint32_t i = 0; i < objectsPerRoom; ++i)
+			{
+				const glm::vec3 min(roomX * ROOM_SIZE + positionDistribution(generator), heightDistribution(generator), roomZ * ROOM_SIZE + positionDistribution(generator));
+				const glm::vec3 size(sizeDistribution(generator), sizeDistribution(generator), sizeDistribution(generator));
+
+				boxesOut.push_back(Box{ min, min + size });
+			}
+		}
+	}
+}
+
+static bool_t IsBoxInFrustum(const Frustum& frustum, const Box& box)
+{
+	for (uint8_t i = 0; i < static_cast<uint8_t>(Frustum::Plane::GE_FP_COUNT); ++i)
+	{
+		const glm::vec4& plane = frustum.GetPlane(static_cast<Frustum::Plane>(i));
+
+		// the corner the farthest along the normal
+		const glm::vec3 corner(plane.x > 0.0f ? box.max.x : box.min.x, plane.y > 0.0f ? box.max.y : box.min.y, plane.z > 0.0f ? box.max.z : box.min.z);
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+			return false;
+	}
+	return true;
+}
+
+// Moller, Trumbore - Fast, Minimum Storage Ray/Triangle Intersection
+static bool_t IsSegmentHit(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2)
+{
+	const glm::vec3 edge1 = v1 - v0;
+	const glm::vec3 edge2 = v2 - v0;
+	const glm::vec3 p = glm::cross(direction, edge2);
+	const float32_t det = glm::dot(edge1, p);
+	if (std::abs(det) < 1e-12f)
+		return false;
+
+	const float32_t invDet = 1.0f / det;
+	const glm::vec3 s = origin - v0;
+	const float32_t u = glm::dot(s, p) * invDet;
+	if ((u < 0.0f) || (u > 1.0f))
+		return false;
+
+	const glm::vec3 q = glm::cross(s, edge1);
+	const float32_t v = glm::dot(direction, q) * invDet;
+	if ((v < 0.0f) || (u + v > 1.0f))
+		return false;
+
+	const float32_t t = glm::dot(edge2, q) * invDet;
+	return (t > 0.0f) && (t < 1.0f);
+}
+
+// an occluded box must be hidden: the segments from the eye to its center and its corners on the screen hit a wall
+static bool_t IsBoxHidden(const glm::vec3& eye, const glm::mat4& projectionView, const Box& box, const std::vector<Occluder>& occluders)
+{
+	const glm::vec3 center = 0.5f * (box.min + box.max);
+
+	for (uint32_t i = 0; i < 9; ++i)
+	{
+		const glm::vec3 corner((i & 4) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y, (i & 1) ? box.max.z : box.min.z);
+		const glm::vec3 sample = (8 == i) ? center : (center + (corner - center) * SAMPLE_SHRINK);
+
+		// the parts outside the screen are not seen
+		const glm::vec4 clipPos = projectionView * glm::vec4(sample, 1.0f);
+		if ((std::abs(clipPos.x) > clipPos.w) || (std::abs(clipPos.y) > clipPos.w))
+			continue;
+
+		bool_t isHit = false;
+		for (uint32_t j = 0; (false == isHit) && (j < occluders.size()); ++j)
+		{
+			const auto& positions = occluders[j].positions;
+			for (uint32_t k = 0; (false == isHit) && (k < BOX_INDEX_COUNT); k += 3)
+			{
+				isHit = IsSegmentHit(eye, sample - eye, positions[BOX_INDICES[k]], positions[BOX_INDICES[k + 1]], positions[BOX_INDICES[k + 2]]);
+			}
+		}
+
+		if (false == isHit)
+			return false;
+	}
+
+	return true;
+}
+
+static void PrintResult(const Result& result, uint32_t objectCount, uint32_t occluderCount, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, "occlusion_culling")
+		.Add("objects", objectCount)
+		.Add("occluders", occluderCount)
+		.Add("threads", result.threadCount)
+		.Add("setup_ms", result.setupTime)
+		.Add("raster_ms", result.rasterTime)
+		.Add("hiz_ms", result.hiZTime)
+		.Add("test_ms", result.testTime)
+		.Add("total_ms", result.totalTime)
+		.Add("speedup", result.speedup)
+		.Add("triangles", result.triangleCount)
+		.Add("binned_triangles", result.binnedTriangleCount)
+		.Add("tested", result.testedCount)
+		.Add("occluded", result.occludedCount)
+		.Add("occluded_percent", result.testedCount > 0 ? 100.0 * result.occludedCount / result.testedCount : 0.0)
+		.Add("false_occlusions", result.falseOcclusionCount)
+		.Add("valid", result.isValid)
+		.End();
+}
+
+// usage: OcclusionCullingBenchmark [objects per room] [max thread count]
+// an interior of 8x8 rooms seen from the middle one, the walls are the occluders, the objects in the frustum are tested
+// measures the time per stage (setup, raster, hierarchical depth, test) per frame, with 1 thread (inline) up to max thread count
+// the occluded objects are checked with rays against the walls, and the output must be the same for any thread count
+int main(int argc, char* argv[])
+{
+	const uint32_t objectsPerRoom = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 200;
+	const uint32_t coreCount = std::max<uint32_t>(1, std::thread::hardware_concurrency());
+	const uint32_t maxThreadCount = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : coreCount;
+
+	if ((0 == objectsPerRoom) || (0 == maxThreadCount))
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	std::vector<Occluder> occluders;
+	CreateWalls(occluders);
+
+	std::vector<Box> objects;
+	CreateObjects(objectsPerRoom, objects);
+
+	std::vector<uint32_t> boxIndices(BOX_INDICES, BOX_INDICES + BOX_INDEX_COUNT);
+
+	// looking around from a corner of the middle room, through the doors
+	const float32_t middle = 0.5f * ROOM_COUNT * ROOM_SIZE;
+	const glm::vec3 eye(middle - 0.3f * ROOM_SIZE, EYE_HEIGHT, middle - 0.3f * ROOM_SIZE);
+	const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 2.0f, Z_NEAR, Z_FAR);
+
+	std::vector<glm::mat4> projectionViews;
+	std::vector<std::vector<OcclusionBuffer::AABB>> viewBoxes(VIEW_COUNT);
+	std::vector<std::vector<uint32_t>> viewObjects(VIEW_COUNT);
+	for (uint32_t i = 0; i < VIEW_COUNT; ++i)
+	{
+		const float32_t angle = glm::radians(360.0f) * i / VIEW_COUNT;
+		const glm::mat4 view = glm::lookAt(eye, eye + glm::vec3(std::cos(angle), -0.1f, std::sin(angle)), glm::vec3(0.0f, 1.0f, 0.0f));
+		projectionViews.push_back(proj * view);
+
+		// the frustum culling is done before, only the objects in the frustum are tested
+		const Frustum frustum(projectionViews.back());
+		for (uint32_t j = 0; j < objects.size(); ++j)
+		{
+			if (IsBoxInFrustum(frustum, objects[j]))
+			{
+				viewBoxes[i].push_back(OcclusionBuffer::AABB{ objects[j].min, objects[j].max });
+				viewObjects[i].push_back(j);
+			}
+		}
+	}
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+	threadCounts.push_back(maxThreadCount);
+
+	OcclusionBuffer buffer;
+
+	std::vector<Result> results;
+	std::vector<std::vector<uint8_t>> baseVisibles;
+
+	for (auto threadCount : threadCounts)
+	{
+		// 1 thread - no scheduler, everything runs inline
+		if (threadCount > 1)
+		{
+			TaskScheduler::Init(threadCount - 1);
+		}
+
+		std::vector<float64_t> setupTimes, rasterTimes, hiZTimes, testTimes, totalTimes;
+		std::vector<std::vector<uint8_t>> visibles(VIEW_COUNT);
+
+		Result result{};
+		result.threadCount = threadCount;
+
+		for (uint32_t run = 0; run < BenchmarkUtils::RUN_COUNT; ++run)
+		{
+			OcclusionBuffer::Stats runStats;
+
+			const float64_t begin = BenchmarkUtils::GetTime();
+			for (uint32_t i = 0; i < VIEW_COUNT; ++i)
+			{
+				buffer.Begin(projectionViews[i]);
+				for (const auto& occluder : occluders)
+				{
+					buffer.AddOccluder(occluder.positions.data(), static_cast<uint32_t>(occluder.positions.size()), boxIndices.data(), BOX_INDEX_COUNT, glm::mat4(1.0f));
+				}
+				buffer.Rasterize();
+				visibles[i].resize(viewBoxes[i].size());
+				buffer.TestAABBs(viewBoxes[i].data(), static_cast<uint32_t>(viewBoxes[i].size()), visibles[i].data());
+
+				const auto& stats = buffer.GetStats();
+				runStats.setupTime += stats.setupTime;
+				runStats.rasterTime += stats.rasterTime;
+				runStats.hiZTime += stats.hiZTime;
+				runStats.testTime += stats.testTime;
+				runStats.triangleCount += stats.triangleCount;
+				runStats.binnedTriangleCount += stats.binnedTriangleCount;
+				runStats.testedCount += stats.testedCount;
+				runStats.occludedCount += stats.occludedCount;
+			}
+			totalTimes.push_back((BenchmarkUtils::GetTime() - begin) / VIEW_COUNT);
+
+			setupTimes.push_back(runStats.setupTime / VIEW_COUNT);
+			rasterTimes.push_back(runStats.rasterTime / VIEW_COUNT);
+			hiZTimes.push_back(runStats.hiZTime / VIEW_COUNT);
+			testTimes.push_back(runStats.testTime / VIEW_COUNT);
+
+			result.triangleCount = runStats.triangleCount / VIEW_COUNT;
+			result.binnedTriangleCount = runStats.binnedTriangleCount / VIEW_COUNT;
+			result.testedCount = runStats.testedCount;
+			result.occludedCount = runStats.occludedCount;
+		}
+
+		TaskScheduler::Terminate();
+
+		result.setupTime = BenchmarkUtils::Median(setupTimes);
+		result.rasterTime = BenchmarkUtils::Median(rasterTimes);
+		result.hiZTime = BenchmarkUtils::Median(hiZTimes);
+		result.testTime = BenchmarkUtils::Median(testTimes);
+		result.totalTime = BenchmarkUtils::Median(totalTimes);
+		result.speedup = results.empty() ? 1.0 : (results.front().totalTime / result.totalTime);
+
+		if (results.empty())
+		{
+			for (uint32_t i = 0; i < VIEW_COUNT; ++i)
+			{
+				for (uint32_t j = 0; j < visibles[i].size(); ++j)
+				{
+					if ((0 == visibles[i][j]) && (false == IsBoxHidden(eye, projectionViews[i], objects[viewObjects[i][j]], occluders)))
+					{
+						result.falseOcclusionCount++;
+					}
+				}
+			}
+			result.isValid = (0 == result.falseOcclusionCount);
+
+			baseVisibles = visibles;
+		}
+		else
+		{
+			result.falseOcclusionCount = results.front().falseOcclusionCount;
+			result.isValid = (visibles == baseVisibles);
+		}
+
+		results.push_back(result);
+	}
+
+	bool_t isValid = true;
+	for (const auto& result : results)
+	{
+		PrintResult(result, static_cast<uint32_t>(objects.size()), static_cast<uint32_t>(occluders.size()), std::cout);
+
+		isValid = isValid && result.isValid;
+	}
+
+	return isValid ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "Foundation/TaskScheduler.hpp"
+#include "Foundation/Logger.hpp"
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <algorithm> // std::max()
+#include <cmath>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+
+// less runs than BenchmarkUtils::RUN_COUNT, each run already has thousands of tasks
+static const uint32_t RUN_COUNT = 5;
+
+// tiny tasks of the fork join and of the dependency chain
+static const uint32_t TASK_COUNT = 20000;
+static const uint32_t STAGE_COUNT = 64;
+
+struct Result
+{
+	std::string name;
+	uint32_t threadCount;
+	float64_t time; // ms, median
+	float64_t speedup; // compared to 1 thread
+	bool_t isValid;
+};
+
+// about 1 us of work per element, computed the same on any thread
+static float32_t ComputeElement(uint32_t i)
+{
+	float32_t value = static_cast<float32_t>(i & 0xFFFF) * 0.001f;
+	for (uint32_t k = 0; k < 64; ++k)
+	{
+		value = std::sin(value) * 0.5f + std::cos(value + static_cast<float32_t>(k)) * 0.5f;
+	}
+
+	return value;
+}
+
+template <typename BenchmarkFunction>
+static float64_t Measure(BenchmarkFunction benchmarkFunction, bool_t& isValidOut)
+{
+	std::vector<float64_t> times;
+
+	isValidOut = true;
+	for (uint32_t i = 0; i < RUN_COUNT; ++i)
+	{
+		const float64_t begin = BenchmarkUtils::GetTime();
+		isValidOut = benchmarkFunction() && isValidOut;
+		times.push_back(BenchmarkUtils::GetTime() - begin);
+	}
+
+	return BenchmarkUtils::Median(times);
+}
+
+// ParallelFor over elements of even cost
+static bool_t RunParallelFor(const std::vector<float32_t>& expected, uint32_t grainSize, std::vector<float32_t>& output)
+{
+	const uint32_t count = static_cast<uint32_t>(output.size());
+
+	TaskScheduler::ParallelFor(0, count, grainSize, [&output](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				output[i] = ComputeElement(i);
+			}
+		});
+
+	return (output == expected);
+}
+
+// ParallelFor over elements of uneven cost, the first elements are the most expensive
+static bool_t RunUnevenParallelFor(uint32_t count, uint32_t grainSize)
+{
+	std::atomic<uint64_t> total(0);
+
+	TaskScheduler::ParallelFor(0, count, grainSize, [&total, count](uint32_t begin, uint32_t end)
+		{
+			uint64_t sum = 0;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				const uint32_t repeatCount = (i < count / 8) ? 8 : 1;
+				for (uint32_t r = 0; r < repeatCount; ++r)
+				{
+					sum += static_cast<uint64_t>(ComputeElement(i + r) > 0.0f);
+				}
+				sum += 1;
+			}
+
+			total.fetch_add(sum, std::memory_order_relaxed);
+		});
+
+	return (total.load() >= count);
+}
+
+// many tiny tasks, measures the scheduling overhead
+static bool_t RunForkJoin()
+{
+	std::atomic<uint32_t> executedCount(0);
+
+	TaskScheduler::Counter counter;
+	for (uint32_t i = 0; i < TASK_COUNT; ++i)
+	{
+		TaskScheduler::Run([&executedCount]() { executedCount.fetch_add(1, std::memory_order_relaxed); }, &counter);
+	}
+
+	TaskScheduler::Wait(counter);
+
+	return (executedCount.load() == TASK_COUNT);
+}
+
+// stages of tasks, each stage starts when the previous one is complete and checks it
+static bool_t RunDependencyChain()
+{
+	const uint32_t tasksPerStage = TASK_COUNT / STAGE_COUNT;
+
+	std::vector<std::atomic<uint32_t>> stageCounts(STAGE_COUNT);
+	for (auto& stageCount : stageCounts)
+	{
+		stageCount.store(0);
+	}
+
+	std::atomic<bool_t> isValid(true);
+
+	std::vector<std::unique_ptr<TaskScheduler::Counter>> counters;
+	for (uint32_t stage = 0; stage < STAGE_COUNT; ++stage)
+	{
+		counters.emplace_back(new TaskScheduler::Counter);
+
+		TaskScheduler::Counter* pDependency = (stage > 0) ? counters[stage - 1].get() : nullptr;
+		for (uint32_t i = 0; i < tasksPerStage; ++i)
+		{
+			TaskScheduler::Run([&stageCounts, &isValid, stage, tasksPerStage]()
+				{
+					if ((stage > 0) && (stageCounts[stage - 1].load() != tasksPerStage))
+					{
+						isValid.store(false);
+					}
+
+					stageCounts[stage].fetch_add(1);
+				}, counters[stage].get(), pDependency);
+		}
+	}
+
+	for (auto& counter : counters)
+	{
+		TaskScheduler::Wait(*counter);
+	}
+
+	return isValid.load() && (stageCounts.back().load() == tasksPerStage);
+}
+
+static void PrintResult(const Result& result, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, result.name.c_str())
+		.Add("threads", result.threadCount)
+		.Add("time_ms", result.time)
+		.Add("speedup", result.speedup)
+		.Add("valid", result.isValid)
+		.End();
+}
+
+// usage: TaskSchedulerBenchmark [element count] [grain size] [max thread count]
+// measures the ParallelFor scaling, the fork join and the dependency overhead with 1 thread (inline) up to max thread count
+int main(int argc, char* argv[])
+{
+	const uint32_t elementCount = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : (1 << 18);
+	const uint32_t grainSize = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 0;
+	const uint32_t coreCount = std::max<uint32_t>(1, std::thread::hardware_concurrency());
+	const uint32_t maxThreadCount = (argc > 3) ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : coreCount;
+
+	if ((0 == elementCount) || (0 == maxThreadCount))
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	std::vector<float32_t> expected(elementCount), output(elementCount);
+	for (uint32_t i = 0; i < elementCount; ++i)
+	{
+		expected[i] = ComputeElement(i);
+	}
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+	threadCounts.push_back(maxThreadCount);
+
+	std::vector<Result> results;
+	std::vector<float64_t> baseTimes;
+
+	for (auto threadCount : threadCounts)
+	{
+		// 1 thread - no scheduler, everything runs inline
+		if (threadCount > 1)
+		{
+			TaskScheduler::Init(threadCount - 1);
+		}
+
+		const char_t* names[] = { "parallel_for", "parallel_for_uneven", "fork_join", "dependency_chain" };
+		for (uint32_t benchmarkIdx = 0; benchmarkIdx < 4; ++benchmarkIdx)
+		{
+			Result result;
+			result.name = names[benchmarkIdx];
+			result.threadCount = threadCount;
+
+			switch (benchmarkIdx)
+			{
+			case 0:
+				result.time = Measure([&]() { return RunParallelFor(expected, grainSize, output); }, result.isValid);
+				break;
+			case 1:
+				result.time = Measure([&]() { return RunUnevenParallelFor(elementCount, grainSize); }, result.isValid);
+				break;
+			case 2:
+				result.time = Measure([&]() { return RunForkJoin(); }, result.isValid);
+				break;
+			default:
+				result.time = Measure([&]() { return RunDependencyChain(); }, result.isValid);
+				break;
+			}
+
+			if (1 == threadCount)
+			{
+				baseTimes.push_back(result.time);
+			}
+			result.speedup = baseTimes[benchmarkIdx] / result.time;
+
+			results.push_back(result);
+		}
+
+		TaskScheduler::Terminate();
+	}
+
+	bool_t isValid = true;
+	for (const auto& result : results)
+	{
+		PrintResult(result, std::cout);
+
+		isValid = isValid && result.isValid;
+	}
+
+	return isValid ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "Foundation/TaskScheduler.hpp"
+#include "Foundation/Logger.hpp"
+#include "BenchmarkUtils.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <algorithm> // std::max()
+#include <cstdlib>
+
+/*
+	Stress checks of the TaskScheduler races, meant to be run built with -fsanitize=thread:
+	- pop and steal of the last task of a deque
+	- the inline execution of the tasks run while all the task slots are used
+	- a task run after a dependency which is already done
+	- a helping wait inside a task
+	Each check reports if all the tasks ran exactly once.
+*/
+
+using namespace GraphicsEngine;
+
+// tasks of the nested wait check, per level
+static const uint32_t FAN_OUT = 8;
+static const uint32_t NESTING_LEVEL_COUNT = 4;
+
+struct Result
+{
+	std::string name;
+	uint32_t threadCount;
+	float64_t time; // ms
+	bool_t isValid;
+};
+
+// the thread 0 pushes a single task and pops it in Wait() while the idle workers try to steal it
+// the workers do the same with a child task
+static bool_t RunLastTaskRace(uint32_t iterationCount)
+{
+	std::unique_ptr<std::atomic<uint32_t>[]> runCounts(new std::atomic<uint32_t>[iterationCount]);
+	std::unique_ptr<std::atomic<uint32_t>[]> childRunCounts(new std::atomic<uint32_t>[iterationCount]);
+	for (uint32_t i = 0; i < iterationCount; ++i)
+	{
+		runCounts[i].store(0);
+		childRunCounts[i].store(0);
+	}
+
+	for (uint32_t i = 0; i < iterationCount; ++i)
+	{
+		TaskScheduler::Counter counter;
+		TaskScheduler::Run([&runCounts, &childRunCounts, i]()
+			{
+				runCounts[i].fetch_add(1);
+
+				TaskScheduler::Counter childCounter;
+				TaskScheduler::Run([&childRunCounts, i]() { childRunCounts[i].fetch_add(1); }, &childCounter);
+				TaskScheduler::Wait(childCounter);
+			}, &counter);
+		TaskScheduler::Wait(counter);
+	}
+
+	for (uint32_t i = 0; i < iterationCount; ++i)
+	{
+		if ((runCounts[i].load() != 1) || (childRunCounts[i].load() != 1))
+			return false;
+	}
+
+	return true;
+}
+
+// the workers are blocked, the thread 0 runs more tasks than it has slots for, the last ones are executed inline
+static bool_t RunFullQueue()
+{
+	const uint32_t workerCount = TaskScheduler::GetWorkerCount();
+	const uint32_t taskCount = 2 * TaskScheduler::QUEUE_CAPACITY;
+
+	std::atomic<bool_t> isReleased(false);
+	std::atomic<uint32_t> blockedCount(0);
+	std::atomic<uint32_t> runCount(0);
+	std::atomic<uint32_t> inlineCount(0);
+
+	TaskScheduler::Counter blockCounter;
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		TaskScheduler::Run([&isReleased, &blockedCount]()
+			{
+				blockedCount.fetch_add(1);
+				while (false == isReleased.load())
+				{
+					std::this_thread::yield();
+				}
+			}, &blockCounter);
+	}
+	// the thread 0 doesn't run tasks unless it waits, the workers take all the blocking tasks
+	while (blockedCount.load() != workerCount)
+	{
+		std::this_thread::yield();
+	}
+
+	TaskScheduler::Counter counter;
+	for (uint32_t i = 0; i < taskCount; ++i)
+	{
+		TaskScheduler::Run([&runCount, &inlineCount, &isReleased]()
+			{
+				runCount.fetch_add(1);
+
+				// only the inline tasks can run before the workers are released
+				if (false == isReleased.load())
+				{
+					inlineCount.fetch_add(1);
+				}
+			}, &counter);
+	}
+
+	isReleased.store(true);
+	TaskScheduler::Wait(counter);
+	TaskScheduler::Wait(blockCounter);
+
+	return (runCount.load() == taskCount) && (inlineCount.load() > 0) && counter.IsDone();
+}
+
+// the dependency is done before the tasks depending on it are run, they must still run
+static bool_t RunDoneDependency(uint32_t iterationCount)
+{
+	std::atomic<uint32_t> runCount(0);
+
+	for (uint32_t i = 0; i < iterationCount; ++i)
+	{
+		TaskScheduler::Counter dependency;
+		TaskScheduler::Run([]() {}, &dependency);
+		TaskScheduler::Wait(dependency);
+
+		TaskScheduler::Counter counter;
+		TaskScheduler::Run([&runCount]() { runCount.fetch_add(1); }, &counter, &dependency);
+		TaskScheduler::Run([&runCount]() { runCount.fetch_add(1); }, &counter, &dependency);
+		TaskScheduler::Wait(counter);
+	}
+
+	return (runCount.load() == 2 * iterationCount);
+}
+
+// each task runs FAN_OUT tasks and waits for them, down to NESTING_LEVEL_COUNT levels
+static void RunNested(uint32_t level, std::atomic<uint32_t>& leafCount)
+{
+	if (NESTING_LEVEL_COUNT == level)
+	{
+		leafCount.fetch_add(1);
+		return;
+	}
+
+	TaskScheduler::Counter counter;
+	for (uint32_t i = 0; i < FAN_OUT; ++i)
+	{
+		TaskScheduler::Run([level, &leafCount]() { RunNested(level + 1, leafCount); }, &counter);
+	}
+	TaskScheduler::Wait(counter);
+}
+
+static bool_t RunNestedWait(uint32_t iterationCount)
+{
+	uint32_t expectedLeafCount = 1;
+	for (uint32_t level = 0; level < NESTING_LEVEL_COUNT; ++level)
+	{
+		expectedLeafCount *= FAN_OUT;
+	}
+
+	for (uint32_t i = 0; i < iterationCount; ++i)
+	{
+		std::atomic<uint32_t> leafCount(0);
+
+		RunNested(0, leafCount);
+
+		if (leafCount.load() != expectedLeafCount)
+			return false;
+	}
+
+	return true;
+}
+
+static void PrintResult(const Result& result, std::ostream& out)
+{
+	BenchmarkUtils::ResultLine(out, result.name.c_str())
+		.Add("threads", result.threadCount)
+		.Add("time_ms", result.time)
+		.Add("valid", result.isValid)
+		.End();
+}
+
+// usage: TaskSchedulerStress [iteration count] [max thread count]
+// runs the checks with 2 threads up to max thread count, returns 1 if a check fails
+int main(int argc, char* argv[])
+{
+	const uint32_t iterationCount = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 2000;
+	const uint32_t coreCount = std::max<uint32_t>(2, std::thread::hardware_concurrency());
+	const uint32_t maxThreadCount = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : coreCount;
+
+	if ((0 == iterationCount) || (maxThreadCount < 2))
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threadCount = 2; threadCount < maxThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+	threadCounts.push_back(maxThreadCount);
+
+	std::vector<Result> results;
+
+	for (auto threadCount : threadCounts)
+	{
+		TaskScheduler::Init(threadCount - 1);
+
+		const char_t* names[] = { "last_task_race", "full_queue", "done_dependency", "nested_wait" };
+		for (uint32_t checkIdx = 0; checkIdx < 4; ++checkIdx)
+		{
+			Result result;
+			result.name = names[checkIdx];
+			result.threadCount = threadCount;
+
+			const float64_t begin = BenchmarkUtils::GetTime();
+			switch (checkIdx)
+			{
+			case 0:
+				result.isValid = RunLastTaskRace(iterationCount);
+				break;
+			case 1:
+				result.isValid = RunFullQueue();
+				break;
+			case 2:
+				result.isValid = RunDoneDependency(iterationCount);
+				break;
+			default:
+				result.isValid = RunNestedWait(std::max<uint32_t>(1, iterationCount / 100));
+				break;
+			}
+			result.time = BenchmarkUtils::GetTime() - begin;
+
+			results.push_back(result);
+		}
+
+		TaskScheduler::Terminate();
+	}
+
+	bool_t isValid = true;
+	for (const auto& result : results)
+	{
+		PrintResult(result, std::cout);
+
+		isValid = isValid && result.isValid;
+	}
+
+	return isValid ? 0 : 1;
+}
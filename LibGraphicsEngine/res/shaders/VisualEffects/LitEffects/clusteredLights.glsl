@@ -0,0 +1,88 @@
+// the point and spot lights of the fragment cluster, see LightClusterGrid
+// included by the forward lit fragment shaders, after their own bindings
+//NOTE! The first layout must stay the first statement, the shader parser reads the UBO of the including shader up to it
+
+// set by the pipeline when the lights are clustered (CLUSTERED_LIGHTING), the OpenGL pipelines keep the default
+layout (constant_id = 1) const bool CLUSTERED_LIGHTING = false;
+
+// LightClusterGrid::GPULight
+struct ClusterLight
+{
+	vec4 positionRange; // world space position, range
+	vec4 colorType; // color, Light::LightType
+	vec4 directionCosAngle; // world space direction, cos of the cone angle - spot lights only
+};
+
+// LightClusterGrid::GridInfo, then the lights
+layout (std430, set = 0, binding = 8) readonly buffer ClusterLights
+{
+	mat4 view; // z is the distance along the view direction
+	vec4 cameraPosition;
+	uvec4 counts; // tile count x, tile count y, slice count, light count
+	vec4 tileScale;
+	vec4 sliceScaleBias; // scale, bias, zNear, zFar
+	ClusterLight lights[];
+} uClusterLights;
+
+// offset and count in the light indices, per cluster
+layout (std430, set = 0, binding = 9) readonly buffer Clusters
+{
+	uvec2 clusters[];
+} uClusters;
+
+layout (std430, set = 0, binding = 10) readonly buffer ClusterLightIndices
+{
+	uint lightIndices[];
+} uClusterLightIndices;
+
+const float SPOT_LIGHT_TYPE = 2.0; // Light::LightType::GE_LT_SPOT
+
+// adds the diffuse and specular terms of the cluster lights, in world space
+// viewPosWS - from the fragment to the camera, N, V - normalized
+void AddClusteredLights(vec3 viewPosWS, vec3 N, vec3 V, float shininess, inout vec3 diffuseInOut, inout vec3 specularInOut)
+{
+	if (false == CLUSTERED_LIGHTING)
+		return;
+
+	vec3 posWS = uClusterLights.cameraPosition.xyz - viewPosWS;
+	vec4 viewPos = uClusterLights.view * vec4(posWS, 1.0);
+
+	float depth = viewPos.z;
+	if (depth <= uClusterLights.sliceScaleBias.z)
+		return;
+
+	uvec3 counts = uClusterLights.counts.xyz;
+
+	ivec2 tile = ivec2(viewPos.xy / depth * uClusterLights.tileScale.xy + uClusterLights.tileScale.zw);
+	tile = clamp(tile, ivec2(0), ivec2(counts.xy) - 1);
+
+	int slice = int(log(depth) * uClusterLights.sliceScaleBias.x + uClusterLights.sliceScaleBias.y);
+	slice = clamp(slice, 0, int(counts.z) - 1);
+
+	uint cluster = (uint(slice) * counts.y + uint(tile.y)) * counts.x + uint(tile.x);
+	uvec2 range = uClusters.clusters[cluster];
+
+	for (uint i = 0; i < range.y; ++i)
+	{
+		ClusterLight light = uClusterLights.lights[uClusterLightIndices.lightIndices[range.x + i]];
+
+		vec3 toLight = light.positionRange.xyz - posWS;
+		float dist2 = dot(toLight, toLight);
+		float range2 = light.positionRange.w * light.positionRange.w;
+		if (dist2 >= range2)
+			continue;
+
+		vec3 L = toLight * inversesqrt(max(dist2, 1e-8));
+
+		if ((light.colorType.w > SPOT_LIGHT_TYPE - 0.5) && (dot(-L, light.directionCosAngle.xyz) < light.directionCosAngle.w))
+			continue;
+
+		float falloff = 1.0 - dist2 / range2;
+		falloff *= falloff;
+
+		vec3 R = reflect(-L, N);
+
+		diffuseInOut += max(dot(N, L), 0.0) * falloff * light.colorType.rgb;
+		specularInOut += pow(max(dot(R, V), 0.0), shininess) * falloff * light.colorType.rgb;
+	}
+}
@@ -0,0 +1,64 @@
+#version 450
+
+layout (location = 0) out vec4 outFragColor;
+
+//NOTE! The UBO members are in the order of GLSLShaderTypes::UniformType
+// lightPos.w = 1 for point lights, 0 for directional lights, -1 without a light (ambient only)
+// lightColor.w = 1 in the first lighting pass, the ambient is added once, 0 in the additive passes
+layout (std140, set = 0, binding = 0) uniform UniformBuffer 
+{
+	mat4 InvPV;
+	vec4 cameraPos;
+	vec4 lightDir;
+	vec4 lightPos;
+	vec4 lightColor;
+	int isGLNDK;
+} uUBOLight;
+
+// G-buffer, see GBuffer.hpp
+layout (set = 0, binding = 1) uniform sampler2D u2DAlbedoTexture;
+layout (set = 0, binding = 2) uniform sampler2D u2DNormalTexture;
+layout (set = 0, binding = 3) uniform sampler2D u2DMaterialTexture;
+layout (set = 0, binding = 4) uniform sampler2D u2DDepthTexture;
+
+void main() 
+{
+	ivec2 texel = ivec2(gl_FragCoord.xy);
+
+	float depth = texelFetch(u2DDepthTexture, texel, 0).r;
+	if (depth >= 1.0)
+	{
+		discard; // background
+	}
+
+	vec3 albedo = texelFetch(u2DAlbedoTexture, texel, 0).rgb;
+	vec3 normalWS = texelFetch(u2DNormalTexture, texel, 0).xyz;
+	vec2 material = texelFetch(u2DMaterialTexture, texel, 0).rg;
+
+	// world space position from the depth
+	vec2 ndcXY = (vec2(texel) + 0.5) / vec2(textureSize(u2DDepthTexture, 0)) * 2.0 - 1.0;
+	float ndcZ = (uUBOLight.isGLNDK == 1) ? (depth * 2.0 - 1.0) : depth;
+	vec4 posWS = uUBOLight.InvPV * vec4(ndcXY, ndcZ, 1.0);
+	posWS /= posWS.w;
+
+	float ambient = 0.2 * uUBOLight.lightColor.w;
+	vec3 finalColor = ambient * uUBOLight.lightColor.rgb * albedo;
+
+	// Lighting calculation in WorldSpace (WS), as in the forward lit effects
+	if (uUBOLight.lightPos.w >= 0.0)
+	{
+		vec3 N = normalize(normalWS);
+		vec3 V = normalize(uUBOLight.cameraPos.xyz - posWS.xyz);
+		vec3 L = (uUBOLight.lightPos.w > 0.0) ? normalize(uUBOLight.lightPos.xyz - posWS.xyz) : normalize(uUBOLight.lightDir.xyz);
+		vec3 R = reflect(-L, N);
+
+		float diffuse = max(dot(N, L), 0.0);
+		float specular = pow(max(dot(R, V), 0.0), material.g * 255.0);
+		finalColor += diffuse * uUBOLight.lightColor.rgb * albedo + specular * uUBOLight.lightColor.rgb * material.r;
+	}
+
+	outFragColor = vec4(finalColor, 1.0);
+
+	// the forward passes which follow test against the scene depth
+	gl_FragDepth = depth;
+}
\ No newline at end of file
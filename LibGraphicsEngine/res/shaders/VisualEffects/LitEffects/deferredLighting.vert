@@ -0,0 +1,10 @@
+#version 450
+
+// full screen triangle, no vertex buffer
+
+void main()
+{
+	vec2 uv = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+
+	gl_Position = vec4(uv * 2.0f - 1.0f, 0.0f, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#version 450
+layout (location = 0) in vec3 v_normalWS;
+layout (location = 1) in vec3 v_viewPosWS;
+
+// G-buffer, see GBuffer.hpp
+layout (location = 0) out vec4 outAlbedo;
+layout (location = 1) out vec4 outNormal;
+layout (location = 2) out vec4 outMaterial;
+
+//NOTE! binding = 0 is used by the UBO in vertex shader
+layout (std140, set = 0, binding = 1) uniform UniformBuffer 
+{
+	vec4 color;
+} uUBOMaterial;
+
+void main() 
+{
+	outAlbedo = vec4(uUBOMaterial.color.rgb, 1.0);
+	outNormal = vec4(normalize(v_normalWS), 0.0);
+	outMaterial = vec4(uUBOMaterial.color.a, 16.0 / 255.0, 0.0, 0.0); // specular intensity, shininess / 255
+}
\ No newline at end of file
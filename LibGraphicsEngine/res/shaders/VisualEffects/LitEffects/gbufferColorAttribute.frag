@@ -0,0 +1,16 @@
+#version 450
+layout (location = 0) in vec3 v_normalWS;
+layout (location = 1) in vec3 v_viewPosWS;
+layout (location = 2) in vec3 v_color;
+
+// G-buffer, see GBuffer.hpp
+layout (location = 0) out vec4 outAlbedo;
+layout (location = 1) out vec4 outNormal;
+layout (location = 2) out vec4 outMaterial;
+
+void main() 
+{
+	outAlbedo = vec4(v_color, 1.0);
+	outNormal = vec4(normalize(v_normalWS), 0.0);
+	outMaterial = vec4(1.0, 16.0 / 255.0, 0.0, 0.0); // specular intensity, shininess / 255
+}
\ No newline at end of file
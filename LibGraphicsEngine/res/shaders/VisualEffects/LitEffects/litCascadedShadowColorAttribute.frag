@@ -0,0 +1,98 @@
+#version 450
+layout (location = 0) in vec3 v_posWS;
+layout (location = 1) in vec3 v_normalWS;
+layout (location = 2) in vec3 v_viewPosWS;
+layout (location = 3) in vec4 v_shadowCoord0;
+layout (location = 4) in vec4 v_shadowCoord1;
+layout (location = 5) in vec4 v_shadowCoord2;
+layout (location = 6) in vec4 v_shadowCoord3;
+layout (location = 7) in vec3 v_color;
+layout (location = 8) in float v_viewDepth;
+layout (location = 9) flat in int v_isGLNDK;
+
+layout (location = 0) out vec4 outFragColor;
+
+//NOTE! binding = 0 is used by the UBO in vertex shader
+layout (std140, set = 0, binding = 1) uniform UniformBuffer 
+{
+	vec4 lightDir;
+	vec4 lightColor;
+	vec4 cascadeSplits; // far depth of each cascade
+} uUBOLight;
+// a diferent name for this UBO compared to vertes shader 
+// as OpenGL doesn't allow the same UBO name across shader stages even if Vulkan does !!!
+
+// the cascades are the 2 x 2 tiles of the depth atlas, see ShadowCascades
+layout (set = 0, binding = 2) uniform sampler2D u2DShadowTexture;
+
+
+#define AMBIENT 0.2
+#define PCF_SCALE 1.0
+#define DEPTH_BIAS 0.0005
+
+float computeShadow(vec4 shadowCoords, int cascade)
+{
+	// perspective division does nothing for the orthographic cascades
+	shadowCoords = shadowCoords / shadowCoords.w;
+
+	// Vulkan NDK is in [0, 1], OpenGL NDK is in [-1, 1]
+	if (v_isGLNDK == 1)
+	{
+		shadowCoords.z = shadowCoords.z * 0.5 + 0.5;
+	}
+
+	// outside the cascade light volume - lit
+	if (shadowCoords.z > 1.0)
+		return 1.0;
+
+	vec2 texelSize = 1.0 / vec2(textureSize(u2DShadowTexture, 0));
+	vec2 tileMin = vec2(float(cascade % 2), float(cascade / 2)) * 0.5;
+
+	// [-1, 1] to the atlas tile, the PCF taps stay in the tile
+	vec2 uv = tileMin + (shadowCoords.xy * 0.5 + 0.5) * 0.5;
+	uv = clamp(uv, tileMin + PCF_SCALE * texelSize, tileMin + 0.5 - PCF_SCALE * texelSize);
+
+	float shadowFactor = 0.0;
+	int count = 0;
+	const int range = 1;
+	for (int x = -range; x <= range; x++)
+	{
+		for (int y = -range; y <= range; y++)
+		{
+			float pcfDepth = texture(u2DShadowTexture, uv + PCF_SCALE * texelSize * vec2(x, y)).r;
+			shadowFactor += (shadowCoords.z - DEPTH_BIAS > pcfDepth ? 0.0 : 1.0);
+			count++;
+		}
+	}
+
+	return shadowFactor / count;
+}
+
+void main() 
+{
+	// Lighting calculation in WorldSpace (WS)
+
+	// computing directions for: normal, light, view, reflection vectors
+	vec3 N = normalize(v_normalWS);
+	vec3 V = normalize(v_viewPosWS);
+	vec3 L = normalize(uUBOLight.lightDir.xyz);
+	vec3 R = reflect(-L, N);
+
+	float diffuse = max(dot(N, L), 0.0);
+	float specular = pow(max(dot(R, V), 0.0), 16.0);
+
+	// the first cascade which contains the fragment, no shadows past the last one
+	float shadow = 1.0;
+	if (v_viewDepth <= uUBOLight.cascadeSplits.x)
+		shadow = computeShadow(v_shadowCoord0, 0);
+	else if (v_viewDepth <= uUBOLight.cascadeSplits.y)
+		shadow = computeShadow(v_shadowCoord1, 1);
+	else if (v_viewDepth <= uUBOLight.cascadeSplits.z)
+		shadow = computeShadow(v_shadowCoord2, 2);
+	else if (v_viewDepth <= uUBOLight.cascadeSplits.w)
+		shadow = computeShadow(v_shadowCoord3, 3);
+
+	vec3 finalColor = (AMBIENT + diffuse * shadow) * uUBOLight.lightColor.rgb * v_color + shadow * specular * uUBOLight.lightColor.rgb;
+
+	outFragColor = vec4(finalColor, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+layout (location = 0) in vec3 a_position;
+layout (location = 1) in vec3 a_normal;
+layout (location = 2) in vec3 a_color;
+
+layout (location = 0) out vec3 v_posWS;
+layout (location = 1) out vec3 v_normalWS;
+layout (location = 2) out vec3 v_viewPosWS;
+layout (location = 3) out vec4 v_shadowCoord0;
+layout (location = 4) out vec4 v_shadowCoord1;
+layout (location = 5) out vec4 v_shadowCoord2;
+layout (location = 6) out vec4 v_shadowCoord3;
+layout (location = 7) out vec3 v_color;
+layout (location = 8) out float v_viewDepth;
+layout (location = 9) flat out int v_isGLNDK;
+
+//NOTE! First binding
+layout (std140, set = 0, binding = 0) uniform UniformBuffer 
+{
+	mat4 PVM;
+	mat4 CascadePV0;
+	mat4 CascadePV1;
+	mat4 CascadePV2;
+	mat4 CascadePV3;
+	mat4 Model;
+	mat4 Normal;
+	vec4 cameraPos;
+	int isGLNDK; // check the source code for details
+} uUBO;
+
+// DecodeNormal(), see MeshQuantizer::DecodeOctahedral()
+#include "octahedralNormals.glsl"
+
+void main() 
+{
+	v_color = a_color;
+
+	// Lighting calculation in WorldSpace (WS)
+	vec4 posWS = uUBO.Model * vec4(a_position, 1.0);
+	v_posWS = posWS.xyz;
+
+	v_normalWS = vec3(uUBO.Normal * vec4(DecodeNormal(a_normal), 0.0));
+	v_viewPosWS = uUBO.cameraPos.xyz - posWS.xyz; // camera pos is in world space
+
+	// clip space of each cascade, the fragment shader selects one by depth
+	v_shadowCoord0 = uUBO.CascadePV0 * posWS;
+	v_shadowCoord1 = uUBO.CascadePV1 * posWS;
+	v_shadowCoord2 = uUBO.CascadePV2 * posWS;
+	v_shadowCoord3 = uUBO.CascadePV3 * posWS;
+
+	v_isGLNDK = uUBO.isGLNDK;
+
+	gl_Position = uUBO.PVM * vec4(a_position, 1.0);
+
+	// perspective projection - w is the depth along the camera view direction
+	v_viewDepth = gl_Position.w;
+}
\ No newline at end of file
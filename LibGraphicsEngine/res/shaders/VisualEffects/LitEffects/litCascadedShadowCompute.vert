@@ -0,0 +1,40 @@
+#version 450
+layout (location = 0) in vec3 a_position;
+
+//NOTE! First binding
+layout (std140, set = 0, binding = 0) uniform UniformBuffer 
+{
+	mat4 CascadePV0;
+	mat4 CascadePV1;
+	mat4 CascadePV2;
+	mat4 CascadePV3;
+	mat4 Model;
+} uUBO;
+
+// one instance per cascade, the draw starts at the first cascade of the node (firstInstance)
+// the cascades are the 2 x 2 tiles of the depth atlas, cascade i in the tile (i % 2, i / 2), see ShadowCascades
+void main() 
+{
+	int cascade = gl_InstanceIndex;
+
+	mat4 cascadePV = uUBO.CascadePV0;
+	if (cascade == 1)
+		cascadePV = uUBO.CascadePV1;
+	else if (cascade == 2)
+		cascadePV = uUBO.CascadePV2;
+	else if (cascade == 3)
+		cascadePV = uUBO.CascadePV3;
+
+	vec4 posCS = cascadePV * uUBO.Model * vec4(a_position, 1.0);
+
+	// clip to the cascade, the neighbour tiles are not written
+	gl_ClipDistance[0] = posCS.w + posCS.x;
+	gl_ClipDistance[1] = posCS.w - posCS.x;
+	gl_ClipDistance[2] = posCS.w + posCS.y;
+	gl_ClipDistance[3] = posCS.w - posCS.y;
+
+	// [-1, 1] to the quarter of the tile
+	vec2 tileOffset = vec2(float(cascade % 2), float(cascade / 2)) - 0.5;
+
+	gl_Position = vec4(posCS.xy * 0.5 + tileOffset * posCS.w, posCS.zw);
+}
\ No newline at end of file
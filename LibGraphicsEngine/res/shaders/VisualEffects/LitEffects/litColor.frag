@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 layout (location = 0) in vec3 v_normalWS;
 layout (location = 1) in vec3 v_viewPosWS;
 
@@ -14,6 +15,9 @@ layout (std140, set = 0, binding = 1) uniform UniformBuffer
 // a diferent name for this UBO compared to vertes shader 
 // as OpenGL doesn't allow the same UBO name across shader stages even if Vulkan does !!!
 
+// the point and spot lights, see LightClusterGrid
+#include "clusteredLights.glsl"
+
 void main() 
 {
 	// Lighting calculation in WorldSpace (WS)
@@ -29,6 +33,10 @@ void main()
 	float specular = pow(max(dot(R, V), 0.0), 16.0);
 	vec3 finalColor = (ambient + diffuse) * uUBOLight.lightColor.rgb * uUBOLight.color.rgb + specular * uUBOLight.lightColor.rgb * uUBOLight.color.a;
 
+	vec3 clusterDiffuse = vec3(0.0), clusterSpecular = vec3(0.0);
+	AddClusteredLights(v_viewPosWS, N, V, 16.0, clusterDiffuse, clusterSpecular);
+	finalColor += clusterDiffuse * uUBOLight.color.rgb + clusterSpecular * uUBOLight.color.a;
+
 	outFragColor = vec4(finalColor, 1.0);
 
 }
\ No newline at end of file
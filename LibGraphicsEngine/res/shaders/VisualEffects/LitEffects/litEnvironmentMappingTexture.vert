@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 layout (location = 0) in vec3 a_position;
 layout (location = 1) in vec3 a_normal;
 layout (location = 2) in vec2 a_uv;
@@ -16,6 +17,9 @@ layout (std140, set = 0, binding = 0) uniform UniformBuffer
 	vec4 cameraPos;
 } uUBO;
 
+// DecodeNormal(), see MeshQuantizer::DecodeOctahedral()
+#include "octahedralNormals.glsl"
+
 void main() 
 {
 	v_uv = a_uv;
@@ -23,7 +27,7 @@ void main()
 	// Lighting calculation in WorldSpace (WS)
 	vec3 posWS = vec3(uUBO.Model * vec4(a_position, 1.0));
 
-	v_normalWS = vec3(uUBO.Normal * vec4(a_normal, 0.0));
+	v_normalWS = vec3(uUBO.Normal * vec4(DecodeNormal(a_normal), 0.0));
 	v_viewPosWS = uUBO.cameraPos.xyz - posWS; // camera pos is in world space
 
 	gl_Position = uUBO.PVM * vec4(a_position, 1.0);
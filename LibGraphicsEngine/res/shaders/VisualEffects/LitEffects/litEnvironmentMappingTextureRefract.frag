@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 layout (location = 0) in vec2 v_uv;
 layout (location = 1) in vec3 v_normalWS;
 layout (location = 2) in vec3 v_viewPosWS;
@@ -17,6 +18,9 @@ layout (std140, set = 0, binding = 1) uniform UniformBuffer
 //NOTE! binding = 1 is used by the uUBOLight here
 layout (set = 0, binding = 2) uniform samplerCube uCubemapTexture;
 
+// the point and spot lights, see LightClusterGrid
+#include "clusteredLights.glsl"
+
 void main() 
 {
 	// Environment reflection in WorldSpace (WS)
@@ -42,6 +46,10 @@ void main()
 	float specular = pow(max(dot(R, V), 0.0), 16.0);
 	vec3 finalColor = (ambient + diffuse + specular) * uUBOLight.lightColor.rgb * color.rgb;
 
+	vec3 clusterDiffuse = vec3(0.0), clusterSpecular = vec3(0.0);
+	AddClusteredLights(v_viewPosWS, N, V, 16.0, clusterDiffuse, clusterSpecular);
+	finalColor += (clusterDiffuse * 0.3 + clusterSpecular) * color.rgb;
+
 	outFragColor = vec4(finalColor, 1.0);
 
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_GOOGLE_include_directive : require
 layout (location = 0) in vec3 a_position;
 layout (location = 1) in vec3 a_normal;
 layout (location = 2) in vec3 a_color;
@@ -21,6 +22,9 @@ layout (std140, set = 0, binding = 0) uniform UniformBuffer
 	int isGLNDK; // check the source code for details
 } uUBO;
 
+// DecodeNormal(), see MeshQuantizer::DecodeOctahedral()
+#include "octahedralNormals.glsl"
+
 void main() 
 {
 	v_color = a_color;
@@ -29,7 +33,7 @@ void main()
 	vec4 posWS = uUBO.Model * vec4(a_position, 1.0);
 	v_posWS = posWS.xyz;
 
-	v_normalWS = vec3(uUBO.Normal * vec4(a_normal, 0.0));
+	v_normalWS = vec3(uUBO.Normal * vec4(DecodeNormal(a_normal), 0.0));
 	v_viewPosWS = uUBO.cameraPos.xyz - posWS.xyz; // camera pos is in world space
 
 	v_shadowCoordWS = uUBO.LightPVM * posWS;
@@ -0,0 +1,22 @@
+// the normal decoding, included by the lit vertex shaders after their own bindings
+//NOTE! The first layout must stay the first statement, the shader parser reads the UBO of the including shader up to it
+
+// set by the pipeline for the octahedral snorm16 normals (VertexFormat::AttributeType::GE_AT_OCTAHEDRAL_SNORM16)
+layout (constant_id = 0) const bool OCTAHEDRAL_NORMALS = false;
+
+// the octahedral normals are 2 components, see MeshQuantizer::DecodeOctahedral()
+vec3 DecodeNormal(vec3 normal)
+{
+	if (OCTAHEDRAL_NORMALS)
+	{
+		vec3 n = vec3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+		if (n.z < 0.0)
+		{
+			n.xy = (1.0 - abs(n.yx)) * vec2((n.x >= 0.0) ? 1.0 : -1.0, (n.y >= 0.0) ? 1.0 : -1.0);
+		}
+
+		return normalize(n);
+	}
+
+	return normal;
+}
@@ -2,8 +2,14 @@
 #define CORE_APP_CONFIG_HPP
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__WINDOWS__)
-//#define ENABLE_ALLOCATOR
+//#define ENABLE_MEMORY_TRACKING // routes GE_ALLOC/GE_FREE through MemoryManager - per subsystem statistics
+//#define ENABLE_MEMORY_TRACE // needs ENABLE_MEMORY_TRACKING, saves the allocation trace for the allocator benchmark
+//#define ENABLE_PROFILER // records the GE_PROFILE_* zones, the trace is exported at shutdown
 #define ENABLE_LOG
+//#define LOG_LEVEL LOG_LEVEL_WARNING // compile time filter of the LOG_* calls, see Foundation/Logger.hpp
+//#define LOG_FILE "GraphicsEngine.log" // the log is also written to this file
+//#define USE_HEADLESS // no OS window, the frames are rendered offscreen and can be read back, see Foundation/Platform/Headless
+//#define HEADLESS_FRAME_LIMIT 300 // with USE_HEADLESS - the app exits after this many frames, e.g. for the CI perf runs, see WindowHeadless::SetFrameLimit()
 
 #define RIGHT_HAND_COORDINATES //default
 //#define LEFT_HAND_COORDINATES
@@ -14,17 +20,24 @@
 #elif defined(linux) || defined(__linux) || defined(__linux__) || defined(__LINUX__)
 #define ENABLE_LOG
 #define USE_GUI
+#define USE_HEADLESS // only the headless platform is available, e.g. for servers without a display
+//#define HEADLESS_FRAME_LIMIT 300 // with USE_HEADLESS - the app exits after this many frames, e.g. for the CI perf runs, see WindowHeadless::SetFrameLimit()
+
+#define RIGHT_HAND_COORDINATES //default
+//#define LEFT_HAND_COORDINATES
 #endif
 
 // Vulkan Config //
 #if defined(VULKAN_RENDERER)
-#ifdef _WIN32
+#if defined(USE_HEADLESS)
+// no surface and no swapchain, we render into offscreen images
+#elif defined(_WIN32)
 #ifndef VK_USE_PLATFORM_WIN32_KHR
 #define VK_USE_PLATFORM_WIN32_KHR
 #endif // VK_USE_PLATFORM_WIN32_KHR
 #else
 // other platforms
-#endif // _WIN32
+#endif // USE_HEADLESS
 
 #define VULKAN_POOL_ALLOCATOR
 #define VULKAN_DEBUG true
@@ -58,6 +71,22 @@
 
 #endif // OPENGL_RENDERER
 
+// Rendering Config //
+//#define CLUSTERED_LIGHTING // the point and spot lights are binned each frame in a froxel grid, uploaded as storage buffers and read by the forward lit shaders (Vulkan only), see Graphics/Lights/LightClusterGrid
+//#define DEFERRED_RENDERING // the lit color effects write a G-buffer lit by a full screen pass per light, the other effects stay forward, see Graphics/Rendering/GBuffer
+//#define SCENE_CULLING // the geometry nodes outside the camera frustum are not drawn, found with a dynamic AABB tree of the scene, see Graphics/SceneGraph/AABBTree
+//#define OCCLUSION_CULLING // the geometry nodes hidden by the occluder nodes are not drawn, found with a CPU rasterized depth buffer, needs SCENE_CULLING, see Graphics/Rendering/OcclusionBuffer
+//#define LEVEL_OF_DETAIL // the LOD geometry nodes draw the coarsest level whose screen space error is small enough, selected each frame, see Graphics/SceneGraph/LODGeometryNode
+//#define GPU_CULLING // Vulkan only, the opaque indexed nodes and their meshlets (GE_LF_MESHLETS) are culled by a compute pass writing compacted indirect draws, see Graphics/Rendering/GPUCulling
+//#define GPU_CULLING_VALIDATION // the draw counts of the compute pass are read back and compared with the CPU culling of the same frame, needs GPU_CULLING
+//#define CASCADED_SHADOWS // the directional light shadows of LitCascadedShadowColorAttributeVisualEffect are split in cascades fitted to the camera each frame, each caster is drawn only to its cascades, see Graphics/Lights/ShadowCascades
+//#define SHADOW_CACHING // the static nodes (GeometryNode::SetIsStatic()) are drawn to a cached shadow map, only its dirty faces are drawn again, the dynamic nodes are drawn on top of it each frame, see Graphics/Rendering/ShadowCache
+
+// Null Config //
+#if defined(NULL_RENDERER)
+//#define NULL_RENDERER_STREAM_FILE "GraphicsEngine.gecs" // the recorded frames are written to this file, see Tools/FrameStreamDiff
+#endif // NULL_RENDERER
+
 // GLM config //
 #define GLM_FORCE_MESSAGES // see GLM message output
 #define GLM_FORCE_RADIANS // we use radians instead of degrees for angles
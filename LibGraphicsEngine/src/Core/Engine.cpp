@@ -7,6 +7,7 @@
 #include "Input/InputSystem.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
 #include "Foundation/Logger.hpp"
+#include "Foundation/Profiler.hpp"
 #include <chrono>
 #include <sstream> // fps
 #include <cassert>
@@ -22,7 +23,16 @@ Engine::Engine()
 
 void Engine::Init(const std::string& name, uint32_t width, uint32_t height)
 {
-#if defined(_WIN32)
+	GE_PROFILE_THREAD("Main");
+
+#if defined(USE_HEADLESS)
+	auto* pHeadlessWindow = GE_ALLOC(Platform::WindowHeadless)(name, width, height);
+	assert(pHeadlessWindow != nullptr);
+#if defined(HEADLESS_FRAME_LIMIT)
+	pHeadlessWindow->SetFrameLimit(HEADLESS_FRAME_LIMIT);
+#endif // HEADLESS_FRAME_LIMIT
+	mpWindow = pHeadlessWindow;
+#elif defined(_WIN32)
 	mpWindow = GE_ALLOC(Platform::WindowWin32)(name, width, height);
 #else
 	// other platforms
@@ -76,6 +86,8 @@ void Engine::Run()
 	static float32_t crrTime = 0.0f; // timer crr time for animations
 	while (mpWindow->IsWindowVisible() && (false == mpWindow->ShouldWindowClose()))
 	{
+		GE_PROFILE_SCOPE("Frame");
+
 		static float32_t deltaTime = 0.0f;
 		auto startFrameTime = std::chrono::system_clock::now();
 
@@ -147,8 +159,10 @@ void Engine::FPSCount(float32_t deltaTime)
 		std::string rendererName;
 #if defined(VULKAN_RENDERER)
 		rendererName = "Vulkan";
-#else define(OPENGL_RENDERER)
+#elif defined(OPENGL_RENDERER)
 		rendererName = "OpenGL";
+#elif defined(NULL_RENDERER)
+		rendererName = "Null";
 #endif
 
 		// update window title with FPS count
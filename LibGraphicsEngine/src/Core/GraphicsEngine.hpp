@@ -38,11 +38,15 @@
 #include "Graphics/Rendering/VisualEffects/LitEffects/LitEnvironmentMappingTextureVisualEffect.hpp"
 #include "Graphics/Rendering/VisualEffects/LitEffects/LitMirrorTextureVisualEffect.hpp"
 #include "Graphics/Rendering/VisualEffects/LitEffects/LitShadowColorAttributeVisualEffect.hpp"
+#include "Graphics/Rendering/VisualEffects/LitEffects/LitCascadedShadowColorAttributeVisualEffect.hpp"
 
 #include "Graphics/Loaders/KTX2Loader.hpp"
 #include "Graphics/Loaders/glTF2Loader.hpp"
 
 #include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "Graphics/GeometricPrimitives/MeshOptimizer.hpp"
+#include "Graphics/GeometricPrimitives/MeshQuantizer.hpp"
+#include "Graphics/GeometricPrimitives/MeshletBuilder.hpp"
 #include "Graphics/Lights/DirectionalLight.hpp"
 #include "Graphics/Lights/PointLight.hpp"
 
@@ -56,6 +60,7 @@
 #include "Graphics/SceneGraph/CameraNode.hpp"
 
 #include "Graphics/Cameras/Camera.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
 #include "Foundation/Logger.hpp"
 
 //TODO - to be replaced when I add my own Math lib
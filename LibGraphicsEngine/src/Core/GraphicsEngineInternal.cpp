@@ -1,22 +1,69 @@
 #include "Core/GraphicsEngineInternal.hpp"
 #include "Core/AppConfig.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Profiler.hpp"
+#include "Foundation/TaskScheduler.hpp"
 #include "Foundation/Logger.hpp"
 
 using namespace GraphicsEngine;
 
+#if defined(ENABLE_MEMORY_TRACKING) && defined(ENABLE_MEMORY_TRACE)
+#define MEMORY_TRACE_FILE "memory_trace.txt"
+#endif // ENABLE_MEMORY_TRACKING && ENABLE_MEMORY_TRACE
+
+#ifdef ENABLE_PROFILER
+#define PROFILER_TRACE_FILE "profiler_trace.json"
+#endif // ENABLE_PROFILER
+
 void GraphicsEngine::Init()
 {
-#ifdef ENABLE_ALLOCATOR
-	LOG_INFO("Global Allocator uses 1e9 bytes as memory buffer!");
+	Log::Init();
+
+#ifdef LOG_FILE
+	if (false == Log::AddFileSink(LOG_FILE))
+	{
+		LOG_ERROR("Failed to open the log file %s!", LOG_FILE);
+	}
+#endif // LOG_FILE
+
+	TaskScheduler::Init();
+
+#ifdef ENABLE_MEMORY_TRACKING
+	LOG_INFO("Memory tracking enabled!");
 
-	gAllocator.Init(1e9); //TODO - make configurable
-#endif // ENABLE_ALLOCATOR
+#ifdef ENABLE_MEMORY_TRACE
+	MemoryManager::BeginTraceCapture();
+#endif // ENABLE_MEMORY_TRACE
+#endif // ENABLE_MEMORY_TRACKING
 }
 
 void GraphicsEngine::Terminate()
 {
-#ifdef ENABLE_ALLOCATOR
-	gAllocator.Terminate();
-#endif // ENABLE_ALLOCATOR
+	// the workers finish their tasks before the traces are saved
+	TaskScheduler::Terminate();
+
+#ifdef ENABLE_PROFILER
+	if (Profiler::ExportChromeTrace(PROFILER_TRACE_FILE))
+	{
+		LOG_INFO("Profiler trace saved to %s", PROFILER_TRACE_FILE);
+	}
+#endif // ENABLE_PROFILER
+
+#ifdef ENABLE_MEMORY_TRACKING
+#ifdef ENABLE_MEMORY_TRACE
+	std::vector<MemoryManager::TraceEvent> trace;
+	MemoryManager::EndTraceCapture(trace);
+
+	if (MemoryManager::SaveTrace(MEMORY_TRACE_FILE, trace))
+	{
+		LOG_INFO("Memory trace with %zu events saved to %s", trace.size(), MEMORY_TRACE_FILE);
+	}
+#endif // ENABLE_MEMORY_TRACE
+
+	// whatever is still alive at this point leaked
+	MemoryManager::LogReport();
+#endif // ENABLE_MEMORY_TRACKING
+
+	// writes the pending messages, the later ones are written synchronously
+	Log::Terminate();
 }
\ No newline at end of file
@@ -5,6 +5,15 @@
 #include <sstream>
 #include <cassert>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN32
+
 namespace GraphicsEngine
 {
 	namespace FileUtils
@@ -55,5 +64,106 @@ namespace GraphicsEngine
 				LOG_ERROR("Could not open shader file \"%s\"\n", filePath.c_str());
 			}
 		}
+
+		bool_t WriteBinaryFile(const std::string& filePath, const void* pData, size_t size)
+		{
+			assert(filePath.empty() == false);
+			assert(pData != nullptr);
+
+			std::ofstream stream(filePath.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+
+			if (stream.is_open() && stream.good())
+			{
+				stream.write(reinterpret_cast<const char_t*>(pData), size);
+				stream.close();
+
+				return (false == stream.fail());
+			}
+			else
+			{
+				LOG_ERROR("Could not open file for writing \"%s\"\n", filePath.c_str());
+			}
+
+			return false;
+		}
+
+		bool_t MapFile(const std::string& filePath, MappedFile& mappedFileOut)
+		{
+			assert(filePath.empty() == false);
+
+			mappedFileOut = MappedFile();
+
+#if defined(_WIN32)
+			HANDLE hFile = ::CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (hFile == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER fileSize;
+			if ((FALSE == ::GetFileSizeEx(hFile, &fileSize)) || (fileSize.QuadPart == 0))
+			{
+				::CloseHandle(hFile);
+				return false;
+			}
+
+			HANDLE hMapping = ::CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (hMapping == nullptr)
+			{
+				::CloseHandle(hFile);
+				return false;
+			}
+
+			void* pView = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+			if (pView == nullptr)
+			{
+				::CloseHandle(hMapping);
+				::CloseHandle(hFile);
+				return false;
+			}
+
+			mappedFileOut.pData = reinterpret_cast<const uint8_t*>(pView);
+			mappedFileOut.size = static_cast<size_t>(fileSize.QuadPart);
+			mappedFileOut.pNativeFile = hFile;
+			mappedFileOut.pNativeMapping = hMapping;
+#else
+			int32_t fd = ::open(filePath.c_str(), O_RDONLY);
+			if (fd < 0)
+				return false;
+
+			struct stat fileStat;
+			if ((::fstat(fd, &fileStat) != 0) || (fileStat.st_size == 0))
+			{
+				::close(fd);
+				return false;
+			}
+
+			void* pView = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			// the mapping stays valid after the descriptor is closed
+			::close(fd);
+
+			if (pView == MAP_FAILED)
+				return false;
+
+			mappedFileOut.pData = reinterpret_cast<const uint8_t*>(pView);
+			mappedFileOut.size = static_cast<size_t>(fileStat.st_size);
+#endif // _WIN32
+
+			return true;
+		}
+
+		void UnmapFile(MappedFile& mappedFile)
+		{
+			if (mappedFile.pData == nullptr)
+				return;
+
+#if defined(_WIN32)
+			::UnmapViewOfFile(mappedFile.pData);
+			::CloseHandle(reinterpret_cast<HANDLE>(mappedFile.pNativeMapping));
+			::CloseHandle(reinterpret_cast<HANDLE>(mappedFile.pNativeFile));
+#else
+			::munmap(const_cast<uint8_t*>(mappedFile.pData), mappedFile.size);
+#endif // _WIN32
+
+			mappedFile = MappedFile();
+		}
 	}
 }
\ No newline at end of file
@@ -9,8 +9,28 @@ namespace GraphicsEngine
 {
 	namespace FileUtils
 	{
+		// read only memory mapped view of a whole file
+		struct MappedFile
+		{
+			MappedFile()
+				: pData(nullptr), size(0), pNativeFile(nullptr), pNativeMapping(nullptr)
+			{}
+
+			const uint8_t* pData;
+			size_t size;
+
+			// platform specific handles
+			void* pNativeFile;
+			void* pNativeMapping;
+		};
+
 		void ReadTextFile(const std::string& filePath, std::string& fileContentOut);
 		void ReadBinaryFile(const std::string& filePath, std::vector<char_t>& dataOut);
+
+		bool_t WriteBinaryFile(const std::string& filePath, const void* pData, size_t size);
+
+		bool_t MapFile(const std::string& filePath, MappedFile& mappedFileOut);
+		void UnmapFile(MappedFile& mappedFile);
 	}
 }
 
@@ -32,6 +32,22 @@ namespace GraphicsEngine
 			return typeid(T).hash_code();
 		}
 
+		// 64 bit FNV-1a hash of a memory block
+		// the result of a previous call can be passed as seed to hash several blocks together
+		inline uint64_t HashBytes(const void* pData, size_t size, uint64_t seed = 14695981039346656037ULL)
+		{
+			const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pData);
+
+			uint64_t hash = seed;
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash ^= pBytes[i];
+				hash *= 1099511628211ULL;
+			}
+
+			return hash;
+		}
+
 	}
 }
 
@@ -0,0 +1,982 @@
+#include "Foundation/Logger.hpp"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+#include <algorithm> // std::stable_sort()
+#include <cstring>
+#include <cassert>
+
+namespace GraphicsEngine
+{
+	namespace Log
+	{
+		using namespace Internal;
+
+		// writer thread wake up period when no error/flush is signaled
+		static const uint32_t WRITER_PERIOD_MS = 2;
+
+		// tracked distinct messages before the expired ones are removed
+		static const size_t MAX_REPETITION_COUNT = 4096;
+
+		static const char_t* const MISSING_ARG = "<missing>";
+		static const char_t* const INVALID_ARG = "<invalid>";
+
+		struct RecordHeader
+		{
+			uint32_t size; // in bytes, header included, multiple of RECORD_ALIGNMENT
+			uint16_t argCount;
+			uint8_t isPadding; // fills the ring end when a record does not fit before it
+			uint8_t reserved;
+			const Site* pSite;
+			uint64_t time;
+		};
+
+		struct StoredArg
+		{
+			ArgType type;
+			uint32_t length; // strings only
+			union
+			{
+				int64_t i;
+				uint64_t u;
+				float64_t f;
+				uint64_t offset; // strings only, from the record begin
+				const void* p;
+			};
+		};
+
+		static const uint32_t RECORD_ALIGNMENT = 8;
+		static_assert((sizeof(RecordHeader) % RECORD_ALIGNMENT) == 0, "Invalid RecordHeader size!");
+		static_assert((sizeof(StoredArg) % RECORD_ALIGNMENT) == 0, "Invalid StoredArg size!");
+		static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0, "RING_CAPACITY must be a power of 2!");
+		// worst case record must fit in half of the ring
+		static_assert(sizeof(RecordHeader) + MAX_ARG_COUNT * (sizeof(StoredArg) + MAX_STRING_LENGTH + RECORD_ALIGNMENT) <= RING_CAPACITY / 2, "RING_CAPACITY too small!");
+
+		// written by its thread, read by the writer thread
+		struct ThreadRing
+		{
+			ThreadRing()
+				: buffer(new uint64_t[RING_CAPACITY / sizeof(uint64_t)])
+				, head(0), tail(0), droppedCount(0)
+			{}
+
+			std::unique_ptr<uint64_t[]> buffer; // uint64_t for the record alignment
+
+			// separate cache lines, the producer owns head, the consumer owns tail
+			uint8_t padding0[64];
+			std::atomic<uint64_t> head;
+			uint8_t padding1[64];
+			std::atomic<uint64_t> tail;
+			uint8_t padding2[64];
+			std::atomic<uint64_t> droppedCount; // messages lost because the ring was full
+		};
+
+		// a formatted message waiting to be written
+		struct Message
+		{
+			uint64_t time;
+			Severity severity;
+			std::string text;
+		};
+
+		// identical message tracking, see RATE_LIMIT_COUNT
+		struct Repetition
+		{
+			const Site* pSite;
+			uint64_t periodBegin;
+			uint32_t count;
+			uint32_t suppressedCount;
+		};
+
+		struct State
+		{
+			State()
+				: startTime(std::chrono::steady_clock::now())
+				, isRunning(false), isStopRequested(false)
+				, flushRequestIndex(0), flushDoneIndex(0)
+				, isConsoleEnabled(true)
+				, lastPurgeTime(0)
+			{}
+
+			std::chrono::steady_clock::time_point startTime;
+
+			std::mutex ringMutex;
+			std::vector<std::unique_ptr<ThreadRing>> rings;
+
+			std::atomic<bool_t> isRunning;
+			std::thread writerThread;
+
+			// guards the writer wake up and the flush indices
+			std::mutex writerMutex;
+			std::condition_variable writerCondition;
+			std::condition_variable flushCondition;
+			bool_t isStopRequested;
+			uint64_t flushRequestIndex;
+			uint64_t flushDoneIndex;
+
+			// guards the sinks, the repetitions and the message batch
+			std::mutex sinkMutex;
+			bool_t isConsoleEnabled;
+			std::vector<std::FILE*> files;
+			std::unordered_map<uint64_t, Repetition> repetitions;
+			uint64_t lastPurgeTime;
+			std::vector<Message> messages;
+		};
+
+		// never destroyed, threads may still log during static destruction, see GetState() in MemoryManager.cpp
+		static State& GetState()
+		{
+			static State* pState = ::new State;
+
+			return *pState;
+		}
+
+		static uint64_t GetTime(const State& state)
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - state.startTime).count());
+		}
+
+		// the rings outlive their threads, the last messages of finished threads are still written
+		static ThreadRing& GetThreadRing(State& state)
+		{
+			static thread_local ThreadRing* pRing = nullptr;
+
+			if (nullptr == pRing)
+			{
+				std::lock_guard<std::mutex> lock(state.ringMutex);
+
+				state.rings.emplace_back(new ThreadRing);
+				pRing = state.rings.back().get();
+			}
+
+			return *pRing;
+		}
+
+		static uint32_t AlignSize(size_t size)
+		{
+			return static_cast<uint32_t>((size + RECORD_ALIGNMENT - 1) & ~static_cast<size_t>(RECORD_ALIGNMENT - 1));
+		}
+
+		static uint32_t GetStringLength(const char_t* pString)
+		{
+			if (nullptr == pString)
+				return 0;
+
+			uint32_t length = 0;
+			while ((length < MAX_STRING_LENGTH) && (pString[length] != '\0'))
+			{
+				++length;
+			}
+
+			return length;
+		}
+
+		static uint32_t ComputeRecordSize(const Arg* pArgs, uint32_t argCount, uint32_t* pStringLengths)
+		{
+			size_t size = sizeof(RecordHeader) + argCount * sizeof(StoredArg);
+
+			for (uint32_t i = 0; i < argCount; ++i)
+			{
+				if (pArgs[i].type == ArgType::GE_AT_STRING)
+				{
+					pStringLengths[i] = GetStringLength(pArgs[i].s);
+					size += pStringLengths[i] + 1;
+				}
+			}
+
+			return AlignSize(size);
+		}
+
+		static void EncodeRecord(uint8_t* pRecord, uint32_t size, const Site& site, uint64_t time, const Arg* pArgs, uint32_t argCount, const uint32_t* pStringLengths)
+		{
+			RecordHeader* pHeader = reinterpret_cast<RecordHeader*>(pRecord);
+			pHeader->size = size;
+			pHeader->argCount = static_cast<uint16_t>(argCount);
+			pHeader->isPadding = 0;
+			pHeader->reserved = 0;
+			pHeader->pSite = &site;
+			pHeader->time = time;
+
+			StoredArg* pStoredArgs = reinterpret_cast<StoredArg*>(pRecord + sizeof(RecordHeader));
+			uint64_t stringOffset = sizeof(RecordHeader) + argCount * sizeof(StoredArg);
+
+			for (uint32_t i = 0; i < argCount; ++i)
+			{
+				StoredArg& storedArg = pStoredArgs[i];
+				storedArg.type = pArgs[i].type;
+				storedArg.length = 0;
+
+				switch (pArgs[i].type)
+				{
+				case ArgType::GE_AT_INT:
+					storedArg.i = pArgs[i].i;
+					break;
+				case ArgType::GE_AT_UINT:
+					storedArg.u = pArgs[i].u;
+					break;
+				case ArgType::GE_AT_FLOAT:
+					storedArg.f = pArgs[i].f;
+					break;
+				case ArgType::GE_AT_STRING:
+					if (pArgs[i].s)
+					{
+						storedArg.length = pStringLengths[i];
+						storedArg.offset = stringOffset;
+
+						std::memcpy(pRecord + stringOffset, pArgs[i].s, storedArg.length);
+						pRecord[stringOffset + storedArg.length] = '\0';
+						stringOffset += storedArg.length + 1;
+					}
+					else
+					{
+						// printed as a null pointer
+						storedArg.type = ArgType::GE_AT_POINTER;
+						storedArg.p = nullptr;
+					}
+					break;
+				case ArgType::GE_AT_POINTER:
+					storedArg.p = pArgs[i].p;
+					break;
+				default:
+					assert(false);
+				}
+			}
+		}
+
+		// printf compatible formatting, the length modifiers of the format are replaced by the ones of the stored types
+		static void FormatRecord(const uint8_t* pRecord, std::string& textOut)
+		{
+			const RecordHeader* pHeader = reinterpret_cast<const RecordHeader*>(pRecord);
+			const StoredArg* pStoredArgs = reinterpret_cast<const StoredArg*>(pRecord + sizeof(RecordHeader));
+			const uint32_t argCount = pHeader->argCount;
+			uint32_t argIndex = 0;
+
+			textOut.clear();
+
+			char_t buffer[64];
+			char_t spec[32];
+
+			for (const char_t* pChar = pHeader->pSite->pFormat; *pChar != '\0'; ++pChar)
+			{
+				if (*pChar != '%')
+				{
+					textOut.push_back(*pChar);
+					continue;
+				}
+
+				++pChar;
+				if (*pChar == '%')
+				{
+					textOut.push_back('%');
+					continue;
+				}
+
+				// flags, width and precision are kept as they are
+				size_t specLength = 0;
+				spec[specLength++] = '%';
+
+				while ((*pChar != '\0') && (std::strchr("-+ #0'", *pChar) != nullptr))
+				{
+					if (specLength < sizeof(spec) - 8) spec[specLength++] = *pChar;
+					++pChar;
+				}
+
+				// width, then precision
+				auto parseNumber = [&]()
+				{
+					if (*pChar == '*')
+					{
+						const int32_t value = (argIndex < argCount) ? static_cast<int32_t>(pStoredArgs[argIndex].i) : 0;
+						++argIndex;
+						++pChar;
+
+						char_t number[16];
+						const int32_t length = std::snprintf(number, sizeof(number), "%d", value);
+						for (int32_t i = 0; (i < length) && (specLength < sizeof(spec) - 8); ++i)
+						{
+							spec[specLength++] = number[i];
+						}
+					}
+
+					while ((*pChar >= '0') && (*pChar <= '9'))
+					{
+						if (specLength < sizeof(spec) - 8) spec[specLength++] = *pChar;
+						++pChar;
+					}
+				};
+
+				parseNumber();
+				if (*pChar == '.')
+				{
+					if (specLength < sizeof(spec) - 8) spec[specLength++] = '.';
+					++pChar;
+					parseNumber();
+				}
+
+				// length modifier, only needed to truncate the integers as printf would
+				char_t lengthModifier = '\0';
+				while ((*pChar != '\0') && (std::strchr("hljztLqI", *pChar) != nullptr))
+				{
+					if ((*pChar == 'I') && (pChar[1] == '6') && (pChar[2] == '4')) // MSVC I64
+					{
+						lengthModifier = 'j';
+						pChar += 2;
+					}
+					else if ((*pChar == 'h') && (lengthModifier == 'h'))
+					{
+						lengthModifier = 'H'; // hh
+					}
+					else if ((*pChar == 'l') && (lengthModifier == 'l'))
+					{
+						lengthModifier = 'j'; // ll
+					}
+					else if (*pChar != 'I')
+					{
+						lengthModifier = *pChar;
+					}
+					++pChar;
+				}
+
+				const char_t conversion = *pChar;
+				if (conversion == '\0')
+					break;
+
+				if (conversion == 'n')
+				{
+					++argIndex;
+					continue;
+				}
+
+				if (argIndex >= argCount)
+				{
+					textOut += MISSING_ARG;
+					continue;
+				}
+
+				const StoredArg& arg = pStoredArgs[argIndex++];
+				int32_t written = 0;
+
+				switch (conversion)
+				{
+				case 'd':
+				case 'i':
+				case 'u':
+				case 'o':
+				case 'x':
+				case 'X':
+				case 'c':
+				{
+					uint64_t value = 0;
+					if (arg.type == ArgType::GE_AT_FLOAT)
+					{
+						value = static_cast<uint64_t>(static_cast<int64_t>(arg.f));
+					}
+					else if (arg.type == ArgType::GE_AT_STRING)
+					{
+						textOut += INVALID_ARG;
+						break;
+					}
+					else
+					{
+						value = arg.u;
+					}
+
+					if (conversion == 'c')
+					{
+						textOut.push_back(static_cast<char_t>(value));
+						break;
+					}
+
+					spec[specLength++] = 'l';
+					spec[specLength++] = 'l';
+					spec[specLength++] = conversion;
+					spec[specLength] = '\0';
+
+					if ((conversion == 'd') || (conversion == 'i'))
+					{
+						long long signedValue = 0;
+						switch (lengthModifier)
+						{
+						case 'H': signedValue = static_cast<signed char>(value); break;
+						case 'h': signedValue = static_cast<short>(value); break;
+						case 'l': signedValue = static_cast<long>(value); break;
+						case 'j':
+						case 'z':
+						case 't':
+						case 'q':
+						case 'L': signedValue = static_cast<long long>(value); break;
+						default: signedValue = static_cast<int>(value); break;
+						}
+						written = std::snprintf(buffer, sizeof(buffer), spec, signedValue);
+					}
+					else
+					{
+						unsigned long long unsignedValue = 0;
+						switch (lengthModifier)
+						{
+						case 'H': unsignedValue = static_cast<unsigned char>(value); break;
+						case 'h': unsignedValue = static_cast<unsigned short>(value); break;
+						case 'l': unsignedValue = static_cast<unsigned long>(value); break;
+						case 'z': unsignedValue = static_cast<size_t>(value); break;
+						case 'j':
+						case 't':
+						case 'q':
+						case 'L': unsignedValue = static_cast<unsigned long long>(value); break;
+						default: unsignedValue = static_cast<unsigned int>(value); break;
+						}
+						written = std::snprintf(buffer, sizeof(buffer), spec, unsignedValue);
+					}
+				} break;
+				case 'f':
+				case 'F':
+				case 'e':
+				case 'E':
+				case 'g':
+				case 'G':
+				case 'a':
+				case 'A':
+				{
+					float64_t value = 0.0;
+					if (arg.type == ArgType::GE_AT_FLOAT)
+					{
+						value = arg.f;
+					}
+					else if (arg.type == ArgType::GE_AT_INT)
+					{
+						value = static_cast<float64_t>(arg.i);
+					}
+					else if (arg.type == ArgType::GE_AT_UINT)
+					{
+						value = static_cast<float64_t>(arg.u);
+					}
+					else
+					{
+						textOut += INVALID_ARG;
+						break;
+					}
+
+					spec[specLength++] = conversion;
+					spec[specLength] = '\0';
+
+					written = std::snprintf(buffer, sizeof(buffer), spec, value);
+				} break;
+				case 's':
+				{
+					spec[specLength++] = 's';
+					spec[specLength] = '\0';
+
+					const char_t* pString = nullptr;
+					if (arg.type == ArgType::GE_AT_STRING)
+					{
+						pString = reinterpret_cast<const char_t*>(pRecord + arg.offset);
+					}
+					else if ((arg.type == ArgType::GE_AT_POINTER) && (nullptr == arg.p))
+					{
+						pString = "(null)";
+					}
+					else
+					{
+						pString = INVALID_ARG;
+					}
+
+					// the strings can be longer than the local buffer
+					if (2 == specLength)
+					{
+						textOut += pString;
+					}
+					else
+					{
+						const int32_t length = std::snprintf(nullptr, 0, spec, pString);
+						if (length > 0)
+						{
+							const size_t offset = textOut.size();
+							textOut.resize(offset + length + 1);
+							std::snprintf(&textOut[offset], length + 1, spec, pString);
+							textOut.resize(offset + length);
+						}
+					}
+				} break;
+				case 'p':
+				{
+					spec[specLength++] = 'p';
+					spec[specLength] = '\0';
+
+					const void* pValue = (arg.type == ArgType::GE_AT_STRING) ? (pRecord + arg.offset) : arg.p;
+					written = std::snprintf(buffer, sizeof(buffer), spec, pValue);
+				} break;
+				default:
+					// unknown conversion, print it as it is
+					textOut.push_back('%');
+					textOut.push_back(conversion);
+					break;
+				}
+
+				if (written > 0)
+				{
+					textOut.append(buffer, std::min<size_t>(written, sizeof(buffer) - 1));
+				}
+			}
+
+			// same layout as the former synchronous printf logging
+			if (pHeader->pSite->severity != Severity::GE_LS_INFO)
+			{
+				std::snprintf(buffer, sizeof(buffer), "\nFILE: ");
+				textOut += buffer;
+				textOut += pHeader->pSite->pFile;
+				textOut += ", FUNC: ";
+				textOut += pHeader->pSite->pFunction;
+				std::snprintf(buffer, sizeof(buffer), ", LINE: %d \n\n", pHeader->pSite->line);
+				textOut += buffer;
+			}
+			else
+			{
+				textOut += "\n\n";
+			}
+		}
+
+		static uint64_t HashMessage(const Site* pSite, const std::string& text)
+		{
+			// FNV-1a
+			uint64_t hash = 14695981039346656037ULL ^ reinterpret_cast<uintptr_t>(pSite);
+			for (char_t c : text)
+			{
+				hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+			}
+
+			return hash;
+		}
+
+		// NOTE! state.sinkMutex must be locked
+		static bool_t AdmitMessage(State& state, const Site* pSite, uint64_t time, std::string& text)
+		{
+			// the map only keeps the recent messages
+			if ((state.repetitions.size() > MAX_REPETITION_COUNT) && (time - state.lastPurgeTime >= RATE_LIMIT_PERIOD))
+			{
+				state.lastPurgeTime = time;
+
+				for (auto it = state.repetitions.begin(); it != state.repetitions.end();)
+				{
+					if ((time - it->second.periodBegin >= RATE_LIMIT_PERIOD) && (0 == it->second.suppressedCount))
+					{
+						it = state.repetitions.erase(it);
+					}
+					else
+					{
+						++it;
+					}
+				}
+			}
+
+			auto& repetition = state.repetitions[HashMessage(pSite, text)];
+
+			if ((0 == repetition.count) || (time - repetition.periodBegin >= RATE_LIMIT_PERIOD))
+			{
+				repetition.pSite = pSite;
+				repetition.periodBegin = time;
+				repetition.count = 0;
+			}
+
+			if (repetition.count >= RATE_LIMIT_COUNT)
+			{
+				++repetition.suppressedCount;
+				return false;
+			}
+
+			++repetition.count;
+
+			if (repetition.suppressedCount > 0)
+			{
+				char_t buffer[64];
+				std::snprintf(buffer, sizeof(buffer), "(%u identical messages suppressed)\n\n", repetition.suppressedCount);
+				text += buffer;
+
+				repetition.suppressedCount = 0;
+			}
+
+			return true;
+		}
+
+		// NOTE! state.sinkMutex must be locked
+		static void WriteMessages(State& state)
+		{
+			// the rings are merged by time
+			std::stable_sort(state.messages.begin(), state.messages.end(),
+				[](const Message& a, const Message& b) { return (a.time < b.time); });
+
+			bool_t hasError = false;
+
+			for (const auto& message : state.messages)
+			{
+				if (state.isConsoleEnabled)
+				{
+					std::fwrite(message.text.data(), 1, message.text.size(), stdout);
+				}
+
+				for (auto* pFile : state.files)
+				{
+					std::fwrite(message.text.data(), 1, message.text.size(), pFile);
+				}
+
+				hasError |= (message.severity == Severity::GE_LS_ERROR);
+			}
+
+			state.messages.clear();
+
+			// errors are written right away, the app may crash right after
+			if (hasError)
+			{
+				std::fflush(stdout);
+
+				for (auto* pFile : state.files)
+				{
+					std::fflush(pFile);
+				}
+			}
+		}
+
+		// NOTE! state.sinkMutex must be locked
+		static void AddMessage(State& state, const uint8_t* pRecord)
+		{
+			const RecordHeader* pHeader = reinterpret_cast<const RecordHeader*>(pRecord);
+
+			Message message;
+			message.time = pHeader->time;
+			message.severity = pHeader->pSite->severity;
+			FormatRecord(pRecord, message.text);
+
+			if (AdmitMessage(state, pHeader->pSite, pHeader->time, message.text))
+			{
+				state.messages.emplace_back(std::move(message));
+			}
+		}
+
+		// consumes every record available in the rings
+		// NOTE! state.sinkMutex must be locked
+		static void DrainRings(State& state)
+		{
+			std::vector<ThreadRing*> rings;
+			{
+				std::lock_guard<std::mutex> lock(state.ringMutex);
+
+				rings.reserve(state.rings.size());
+				for (auto& ring : state.rings)
+				{
+					rings.push_back(ring.get());
+				}
+			}
+
+			for (auto* pRing : rings)
+			{
+				const uint8_t* pBuffer = reinterpret_cast<const uint8_t*>(pRing->buffer.get());
+				const uint64_t head = pRing->head.load(std::memory_order_acquire);
+				uint64_t tail = pRing->tail.load(std::memory_order_relaxed);
+
+				while (tail < head)
+				{
+					const uint8_t* pRecord = pBuffer + (tail & (RING_CAPACITY - 1));
+					const RecordHeader* pHeader = reinterpret_cast<const RecordHeader*>(pRecord);
+
+					if (0 == pHeader->isPadding)
+					{
+						AddMessage(state, pRecord);
+					}
+
+					tail += pHeader->size;
+				}
+
+				pRing->tail.store(tail, std::memory_order_release);
+
+				const uint64_t droppedCount = pRing->droppedCount.exchange(0, std::memory_order_relaxed);
+				if (droppedCount > 0)
+				{
+					char_t buffer[96];
+					std::snprintf(buffer, sizeof(buffer), "Log ring full, %llu messages dropped!\n\n", static_cast<unsigned long long>(droppedCount));
+
+					Message message;
+					message.time = GetTime(state);
+					message.severity = Severity::GE_LS_WARNING;
+					message.text = buffer;
+					state.messages.emplace_back(std::move(message));
+				}
+			}
+
+			WriteMessages(state);
+		}
+
+		// returns false if the ring is full
+		static bool_t TryPush(ThreadRing& ring, const Site& site, uint64_t time, const Arg* pArgs, uint32_t argCount, uint32_t size, const uint32_t* pStringLengths)
+		{
+			uint8_t* pBuffer = reinterpret_cast<uint8_t*>(ring.buffer.get());
+			uint64_t head = ring.head.load(std::memory_order_relaxed);
+			const uint64_t tail = ring.tail.load(std::memory_order_acquire);
+
+			const uint32_t offset = static_cast<uint32_t>(head & (RING_CAPACITY - 1));
+			const uint32_t sizeToEnd = RING_CAPACITY - offset;
+			// records are never split, the end of the ring is skipped if needed
+			const uint32_t paddingSize = (size > sizeToEnd) ? sizeToEnd : 0;
+
+			if (RING_CAPACITY - (head - tail) < paddingSize + size)
+				return false;
+
+			if (paddingSize > 0)
+			{
+				RecordHeader* pPadding = reinterpret_cast<RecordHeader*>(pBuffer + offset);
+				pPadding->size = paddingSize;
+				pPadding->isPadding = 1;
+				head += paddingSize;
+			}
+
+			EncodeRecord(pBuffer + (head & (RING_CAPACITY - 1)), size, site, time, pArgs, argCount, pStringLengths);
+
+			ring.head.store(head + size, std::memory_order_release);
+
+			return true;
+		}
+
+		static void WriteSync(State& state, const Site& site, uint64_t time, const Arg* pArgs, uint32_t argCount, uint32_t size, const uint32_t* pStringLengths)
+		{
+			std::vector<uint64_t> record(size / sizeof(uint64_t));
+			EncodeRecord(reinterpret_cast<uint8_t*>(record.data()), size, site, time, pArgs, argCount, pStringLengths);
+
+			std::lock_guard<std::mutex> lock(state.sinkMutex);
+
+			AddMessage(state, reinterpret_cast<const uint8_t*>(record.data()));
+			WriteMessages(state);
+		}
+
+		static void WakeWriter(State& state)
+		{
+			state.writerCondition.notify_one();
+		}
+
+		static void WriterThread()
+		{
+			auto& state = GetState();
+
+			while (true)
+			{
+				uint64_t flushRequestIndex = 0;
+				bool_t isFlushRequested = false;
+				bool_t isStopRequested = false;
+				{
+					std::unique_lock<std::mutex> lock(state.writerMutex);
+
+					if ((false == state.isStopRequested) && (state.flushRequestIndex == state.flushDoneIndex))
+					{
+						state.writerCondition.wait_for(lock, std::chrono::milliseconds(WRITER_PERIOD_MS));
+					}
+
+					flushRequestIndex = state.flushRequestIndex;
+					isFlushRequested = (state.flushRequestIndex != state.flushDoneIndex);
+					isStopRequested = state.isStopRequested;
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(state.sinkMutex);
+
+					DrainRings(state);
+
+					if (isFlushRequested)
+					{
+						std::fflush(stdout);
+
+						for (auto* pFile : state.files)
+						{
+							std::fflush(pFile);
+						}
+					}
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(state.writerMutex);
+
+					if (isFlushRequested)
+					{
+						state.flushDoneIndex = flushRequestIndex;
+						state.flushCondition.notify_all();
+					}
+				}
+
+				if (isStopRequested)
+					break;
+			}
+		}
+
+		void Internal::Write(const Site& site, const Arg* pArgs, uint32_t argCount)
+		{
+			assert(argCount <= MAX_ARG_COUNT);
+
+			auto& state = GetState();
+
+			const uint64_t time = GetTime(state);
+
+			uint32_t stringLengths[MAX_ARG_COUNT];
+			const uint32_t size = ComputeRecordSize(pArgs, argCount, stringLengths);
+
+			if (false == state.isRunning.load(std::memory_order_acquire))
+			{
+				WriteSync(state, site, time, pArgs, argCount, size, stringLengths);
+				return;
+			}
+
+			auto& ring = GetThreadRing(state);
+
+			if (TryPush(ring, site, time, pArgs, argCount, size, stringLengths))
+			{
+				if (site.severity == Severity::GE_LS_ERROR)
+				{
+					WakeWriter(state);
+				}
+				return;
+			}
+
+			// ring full, the errors are never dropped
+			if (site.severity != Severity::GE_LS_ERROR)
+			{
+				ring.droppedCount.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			while (state.isRunning.load(std::memory_order_acquire))
+			{
+				WakeWriter(state);
+				std::this_thread::yield();
+
+				if (TryPush(ring, site, time, pArgs, argCount, size, stringLengths))
+					return;
+			}
+
+			WriteSync(state, site, time, pArgs, argCount, size, stringLengths);
+		}
+
+		void Init()
+		{
+			auto& state = GetState();
+
+			if (state.isRunning.load())
+				return;
+
+			{
+				std::lock_guard<std::mutex> lock(state.writerMutex);
+
+				state.isStopRequested = false;
+			}
+
+			state.writerThread = std::thread(WriterThread);
+			state.isRunning.store(true, std::memory_order_release);
+		}
+
+		void Terminate()
+		{
+			auto& state = GetState();
+
+			if (state.isRunning.load())
+			{
+				// the messages logged from now on are written synchronously
+				state.isRunning.store(false, std::memory_order_release);
+
+				{
+					std::lock_guard<std::mutex> lock(state.writerMutex);
+
+					state.isStopRequested = true;
+					++state.flushRequestIndex;
+				}
+				WakeWriter(state);
+
+				state.writerThread.join();
+			}
+
+			std::lock_guard<std::mutex> lock(state.sinkMutex);
+
+			// records pushed while the writer was stopping
+			DrainRings(state);
+
+			// the suppressed messages not followed by an identical one
+			for (auto& it : state.repetitions)
+			{
+				auto& repetition = it.second;
+				if (repetition.suppressedCount > 0)
+				{
+					char_t buffer[64];
+					std::snprintf(buffer, sizeof(buffer), "%u identical messages suppressed", repetition.suppressedCount);
+
+					Message message;
+					message.time = repetition.periodBegin;
+					message.severity = Severity::GE_LS_INFO;
+					message.text = buffer;
+					message.text += "\nFILE: ";
+					message.text += repetition.pSite->pFile;
+					std::snprintf(buffer, sizeof(buffer), ", LINE: %d \n\n", repetition.pSite->line);
+					message.text += buffer;
+					state.messages.emplace_back(std::move(message));
+
+					repetition.suppressedCount = 0;
+				}
+			}
+			WriteMessages(state);
+
+			for (auto* pFile : state.files)
+			{
+				std::fclose(pFile);
+			}
+			state.files.clear();
+
+			std::fflush(stdout);
+		}
+
+		void Flush()
+		{
+			auto& state = GetState();
+
+			if (state.isRunning.load(std::memory_order_acquire))
+			{
+				std::unique_lock<std::mutex> lock(state.writerMutex);
+
+				const uint64_t flushIndex = ++state.flushRequestIndex;
+				state.writerCondition.notify_one();
+
+				state.flushCondition.wait(lock, [&state, flushIndex]() { return ((state.flushDoneIndex >= flushIndex) || state.isStopRequested); });
+			}
+			else
+			{
+				std::lock_guard<std::mutex> lock(state.sinkMutex);
+
+				std::fflush(stdout);
+
+				for (auto* pFile : state.files)
+				{
+					std::fflush(pFile);
+				}
+			}
+		}
+
+		void SetConsoleOutput(bool_t isEnabled)
+		{
+			auto& state = GetState();
+
+			std::lock_guard<std::mutex> lock(state.sinkMutex);
+
+			state.isConsoleEnabled = isEnabled;
+		}
+
+		bool_t AddFileSink(const std::string& filePath)
+		{
+			std::FILE* pFile = std::fopen(filePath.c_str(), "a");
+			if (nullptr == pFile)
+				return false;
+
+			auto& state = GetState();
+
+			std::lock_guard<std::mutex> lock(state.sinkMutex);
+
+			state.files.push_back(pFile);
+
+			return true;
+		}
+	}
+}
\ No newline at end of file
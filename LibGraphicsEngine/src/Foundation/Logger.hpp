@@ -3,29 +3,185 @@
 
 #include "Core/AppConfig.hpp"
 #include "Foundation/RTTI.hpp"
-//#include <cstdarg>
+#include "Foundation/TypeDefines.hpp"
+#include <string>
+#include <type_traits>
 #include <cstdio>
 
-//int _print(const char* format, ...)
-//{
-//	va_list arg;
-//	int done;
-//	va_start(arg, format);
-//	done = __vfprintf_internal(stdout, format, arg, 0);
-//	va_end(arg);
-//	return done;
-//}
+// compile time severity filter, the LOG_* calls below LOG_LEVEL are compiled out
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif // LOG_LEVEL
+
+namespace GraphicsEngine
+{
+	/*
+		Asynchronous logging backend.
+		The LOG_* calls only capture their arguments in binary into a per thread ring buffer (single producer, single consumer),
+		the formatting and the writes to the sinks are done by a background writer thread.
+		Before Init() and after Terminate() the messages are formatted and written on the calling thread.
+		NOTE! The format must be a string literal, it is stored once per call site.
+	*/
+	namespace Log
+	{
+		// bytes per thread, must be a power of 2
+		static const uint32_t RING_CAPACITY = 1 << 16;
+		static const uint32_t MAX_ARG_COUNT = 16;
+		// longer string arguments are truncated
+		static const uint32_t MAX_STRING_LENGTH = 1024;
+
+		// identical messages (same call site and same text) written per RATE_LIMIT_PERIOD,
+		// the rest are counted and reported with the next written one
+		static const uint32_t RATE_LIMIT_COUNT = 10;
+		static const uint64_t RATE_LIMIT_PERIOD = 1000000000; // ns
+
+		enum class Severity : uint8_t
+		{
+			GE_LS_DEBUG = 0,
+			GE_LS_INFO,
+			GE_LS_WARNING,
+			GE_LS_ERROR,
+			GE_LS_COUNT
+		};
+
+		// one static instance per LOG_* call
+		struct Site
+		{
+			constexpr Site(Severity severity, const char_t* pFormat, const char_t* pFile, const char_t* pFunction, int32_t line)
+				: severity(severity), pFormat(pFormat), pFile(pFile), pFunction(pFunction), line(line)
+			{}
+
+			const Severity severity;
+			const char_t* const pFormat;
+			const char_t* const pFile;
+			const char_t* const pFunction;
+			const int32_t line;
+		};
+
+		namespace Internal
+		{
+			enum class ArgType : uint8_t
+			{
+				GE_AT_INT = 0,
+				GE_AT_UINT,
+				GE_AT_FLOAT,
+				GE_AT_STRING,
+				GE_AT_POINTER,
+				GE_AT_COUNT
+			};
+
+			struct Arg
+			{
+				ArgType type;
+				union
+				{
+					int64_t i;
+					uint64_t u;
+					float64_t f;
+					const char_t* s;
+					const void* p;
+				};
+			};
+
+			inline Arg MakeIntArg(int64_t value) { Arg arg; arg.type = ArgType::GE_AT_INT; arg.i = value; return arg; }
+			inline Arg MakeUIntArg(uint64_t value) { Arg arg; arg.type = ArgType::GE_AT_UINT; arg.u = value; return arg; }
+			inline Arg MakeFloatArg(float64_t value) { Arg arg; arg.type = ArgType::GE_AT_FLOAT; arg.f = value; return arg; }
+
+			inline Arg MakeArg(bool_t value) { return MakeIntArg(value ? 1 : 0); }
+			inline Arg MakeArg(char value) { return MakeIntArg(value); }
+			inline Arg MakeArg(signed char value) { return MakeIntArg(value); }
+			inline Arg MakeArg(unsigned char value) { return MakeUIntArg(value); }
+			inline Arg MakeArg(short value) { return MakeIntArg(value); }
+			inline Arg MakeArg(unsigned short value) { return MakeUIntArg(value); }
+			inline Arg MakeArg(int value) { return MakeIntArg(value); }
+			inline Arg MakeArg(unsigned int value) { return MakeUIntArg(value); }
+			inline Arg MakeArg(long value) { return MakeIntArg(value); }
+			inline Arg MakeArg(unsigned long value) { return MakeUIntArg(value); }
+			inline Arg MakeArg(long long value) { return MakeIntArg(value); }
+			inline Arg MakeArg(unsigned long long value) { return MakeUIntArg(value); }
+			inline Arg MakeArg(float value) { return MakeFloatArg(value); }
+			inline Arg MakeArg(double value) { return MakeFloatArg(value); }
+			inline Arg MakeArg(long double value) { return MakeFloatArg(static_cast<float64_t>(value)); }
+			inline Arg MakeArg(std::nullptr_t) { Arg arg; arg.type = ArgType::GE_AT_POINTER; arg.p = nullptr; return arg; }
+
+			// the string is copied into the record, so temporaries are safe
+			inline Arg MakeArg(const char_t* value) { Arg arg; arg.type = ArgType::GE_AT_STRING; arg.s = value; return arg; }
+			inline Arg MakeArg(char_t* value) { return MakeArg(static_cast<const char_t*>(value)); }
+
+			template <typename T>
+			inline Arg MakeArg(T* value) { Arg arg; arg.type = ArgType::GE_AT_POINTER; arg.p = value; return arg; }
+
+			template <typename T>
+			inline typename std::enable_if<std::is_enum<T>::value, Arg>::type MakeArg(T value)
+			{
+				return MakeIntArg(static_cast<int64_t>(value));
+			}
+
+			void Write(const Site& site, const Arg* pArgs, uint32_t argCount);
+		}
+
+		void Init();
+		void Terminate();
+
+		// blocks until every message logged so far is written to the sinks
+		void Flush();
+
+		// stdout sink, enabled by default
+		void SetConsoleOutput(bool_t isEnabled);
+
+		// appends the messages to filePath, the file is closed by Terminate()
+		bool_t AddFileSink(const std::string& filePath);
+
+		inline void Write(const Site& site)
+		{
+			Internal::Write(site, nullptr, 0);
+		}
+
+		template <typename... Args>
+		inline void Write(const Site& site, const Args&... args)
+		{
+			static_assert(sizeof...(Args) <= MAX_ARG_COUNT, "Too many log arguments!");
+
+			const Internal::Arg argArray[] = { Internal::MakeArg(args)... };
+			Internal::Write(site, argArray, static_cast<uint32_t>(sizeof...(Args)));
+		}
+	}
+}
 
 #ifdef ENABLE_LOG
-	#define LOG_ERROR(args, ...) do { printf(args, ##__VA_ARGS__); printf("\nFILE: %s, FUNC: %s, LINE: %ld \n\n", __FILE__, __FUNCTION__, __LINE__); fflush(stdout); } while (0);
-	#define LOG_WARNING(args, ...) do { printf(args, ##__VA_ARGS__); printf("\nFILE: %s, FUNC: %s, LINE: %ld \n\n", __FILE__, __FUNCTION__, __LINE__); } while (0);
-	#define LOG_DEBUG(args, ...) do { printf(args, ##__VA_ARGS__); printf("\nFILE: %s, FUNC: %s, LINE: %ld \n\n", __FILE__, __FUNCTION__, __LINE__); } while (0);
-	#define LOG_INFO(args, ...) do { printf(args, ##__VA_ARGS__); printf("\n\n"); } while (0);
+	#define GE_LOG(severity, format, ...) do { static const GraphicsEngine::Log::Site geLogSite(severity, format, __FILE__, __FUNCTION__, __LINE__); GraphicsEngine::Log::Write(geLogSite, ##__VA_ARGS__); } while (0);
+#else
+	#define GE_LOG(...) do{}while(0);
+#endif // ENABLE_LOG
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+	#define LOG_ERROR(args, ...) GE_LOG(GraphicsEngine::Log::Severity::GE_LS_ERROR, args, ##__VA_ARGS__)
 #else
 	#define	LOG_ERROR(...) do{}while(0);
+#endif // LOG_LEVEL_ERROR
+
+#if LOG_LEVEL <= LOG_LEVEL_WARNING
+	#define LOG_WARNING(args, ...) GE_LOG(GraphicsEngine::Log::Severity::GE_LS_WARNING, args, ##__VA_ARGS__)
+#else
 	#define	LOG_WARNING(...) do{}while(0);
-	#define	LOG_DEBUG(...) do{}while(0);
+#endif // LOG_LEVEL_WARNING
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+	#define LOG_INFO(args, ...) GE_LOG(GraphicsEngine::Log::Severity::GE_LS_INFO, args, ##__VA_ARGS__)
+#else
 	#define LOG_INFO(...) do{}while(0);
-#endif // ENABLE_LOG
+#endif // LOG_LEVEL_INFO
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+	#define LOG_DEBUG(args, ...) GE_LOG(GraphicsEngine::Log::Severity::GE_LS_DEBUG, args, ##__VA_ARGS__)
+#else
+	#define	LOG_DEBUG(...) do{}while(0);
+#endif // LOG_LEVEL_DEBUG
 
 #endif /* FOUNDATION_LOGGER_HPP */
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "Foundation/MemoryManagement/FrameAllocator.hpp"
+#include "Foundation/Logger.hpp"
+#include <algorithm> // std::max
+#include <cassert>
+
+using namespace GraphicsEngine;
+
+FrameAllocator::FrameAllocator()
+	: FrameAllocator(2)
+{}
+
+FrameAllocator::FrameAllocator(uint32_t frameCount)
+	: Allocator()
+	, mFrameCount(frameCount)
+	, mCurrentArenaIdx(0)
+	, mFrameIndex(0)
+	, mCurrentOverflow(0)
+	, mLastFrameHighWaterMark(0)
+	, mLastFrameOverflow(0)
+{
+	assert((frameCount > 0) && (frameCount <= MAX_FRAME_COUNT));
+}
+
+FrameAllocator::~FrameAllocator()
+{
+	Terminate();
+}
+
+void FrameAllocator::Init(uint64_t totalSize)
+{
+	Terminate();
+
+	for (uint32_t i = 0; i < mFrameCount; ++i)
+	{
+		mArenas[i].Init(totalSize);
+	}
+
+	mTotalSize = totalSize * mFrameCount;
+}
+
+void FrameAllocator::Reset()
+{
+	ReleaseOverflow(mCurrentArenaIdx);
+
+	mArenas[mCurrentArenaIdx].Reset();
+
+	mCurrentOverflow = 0;
+	mUsed = 0;
+}
+
+void FrameAllocator::Terminate()
+{
+	for (uint32_t i = 0; i < mFrameCount; ++i)
+	{
+		ReleaseOverflow(i);
+
+		mArenas[i].Terminate();
+	}
+
+	mCurrentArenaIdx = 0;
+	mFrameIndex = 0;
+	mCurrentOverflow = 0;
+	mLastFrameHighWaterMark = 0;
+	mLastFrameOverflow = 0;
+
+	mTotalSize = 0;
+	mUsed = 0;
+	mPeak = 0;
+}
+
+void* FrameAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	void* ptr = mArenas[mCurrentArenaIdx].Allocate(size, alignment);
+	if (nullptr == ptr)
+	{
+		// arena is full, the frame goes on with heap memory
+		ptr = mOverflowAllocator.Allocate(size, alignment);
+		if (nullptr == ptr)
+			return nullptr;
+
+		mOverflowAllocations[mCurrentArenaIdx].push_back(ptr);
+		mCurrentOverflow += size;
+	}
+
+	mUsed = mArenas[mCurrentArenaIdx].Used() + mCurrentOverflow;
+	mPeak = std::max(mPeak, mUsed);
+
+	return ptr;
+}
+
+void FrameAllocator::Free(void*)
+{
+	// This allocator does not support this operation!
+	// Do nothing
+}
+
+void FrameAllocator::BeginFrame()
+{
+	mLastFrameHighWaterMark = mUsed;
+	mLastFrameOverflow = mCurrentOverflow;
+
+	if (mLastFrameOverflow > 0)
+	{
+		LOG_WARNING("Frame arena overflow: %llu bytes allocated from the heap!", static_cast<unsigned long long>(mLastFrameOverflow));
+	}
+
+	mFrameIndex++;
+	mCurrentArenaIdx = static_cast<uint32_t>(mFrameIndex % mFrameCount);
+
+	Reset();
+}
+
+uint32_t FrameAllocator::GetFrameCount() const
+{
+	return mFrameCount;
+}
+
+uint64_t FrameAllocator::GetFrameIndex() const
+{
+	return mFrameIndex;
+}
+
+uint64_t FrameAllocator::GetLastFrameHighWaterMark() const
+{
+	return mLastFrameHighWaterMark;
+}
+
+uint64_t FrameAllocator::GetLastFrameOverflow() const
+{
+	return mLastFrameOverflow;
+}
+
+void FrameAllocator::ReleaseOverflow(uint32_t arenaIdx)
+{
+	assert(arenaIdx < mFrameCount);
+
+	for (auto* ptr : mOverflowAllocations[arenaIdx])
+	{
+		mOverflowAllocator.Free(ptr);
+	}
+	mOverflowAllocations[arenaIdx].clear();
+}
\ No newline at end of file
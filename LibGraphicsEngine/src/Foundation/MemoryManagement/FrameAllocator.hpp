@@ -0,0 +1,68 @@
+#ifndef FOUNDATION_MEMORYMANAGEMENT_FRAME_ALLOCATOR_HPP
+#define FOUNDATION_MEMORYMANAGEMENT_FRAME_ALLOCATOR_HPP
+
+#include "Foundation/MemoryManagement/LiniarAllocator.hpp"
+#include "Foundation/MemoryManagement/SystemAllocator.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	/*
+		Double/triple buffered frame arena for transient per frame data.
+		Each frame allocates linearly from its own LiniarAllocator, which is reset when the frame comes around again,
+		so the data of the previous (frameCount - 1) frames stays valid while the GPU may still use it.
+		When an arena is full the allocations fall back to the heap and are released with the arena.
+		NOTE! Non-multi thread safe!
+	*/
+	class FrameAllocator : public Allocator
+	{
+		GE_RTTI(GraphicsEngine::FrameAllocator)
+
+	public:
+		static const uint32_t MAX_FRAME_COUNT = 3;
+
+		FrameAllocator();
+		explicit FrameAllocator(uint32_t frameCount);
+		virtual ~FrameAllocator();
+
+		// totalSize is the size of every frame arena
+		virtual void Init(uint64_t totalSize) override;
+		// resets the arena of the current frame
+		virtual void Reset() override;
+		virtual void Terminate() override;
+
+		virtual void* Allocate(uint64_t size, uint64_t alignment = 0) override;
+		// Do nothing - the memory is released at frame boundaries
+		virtual void Free(void* ptr) override;
+
+		// moves to the arena of the next frame and resets it
+		void BeginFrame();
+
+		uint32_t GetFrameCount() const;
+		uint64_t GetFrameIndex() const;
+
+		// high-water mark of the last completed frame, Peak() is the one of all frames
+		uint64_t GetLastFrameHighWaterMark() const;
+		// bytes which did not fit the arena during the last completed frame, the arena size should be increased
+		uint64_t GetLastFrameOverflow() const;
+
+	private:
+		NO_COPY_NO_MOVE_CLASS(FrameAllocator)
+
+		void ReleaseOverflow(uint32_t arenaIdx);
+
+		LiniarAllocator mArenas[MAX_FRAME_COUNT];
+		std::vector<void*> mOverflowAllocations[MAX_FRAME_COUNT];
+		SystemAllocator mOverflowAllocator;
+
+		uint32_t mFrameCount;
+		uint32_t mCurrentArenaIdx;
+		uint64_t mFrameIndex;
+
+		uint64_t mCurrentOverflow;
+		uint64_t mLastFrameHighWaterMark;
+		uint64_t mLastFrameOverflow;
+	};
+}
+
+#endif /* FOUNDATION_MEMORYMANAGEMENT_FRAME_ALLOCATOR_HPP */
\ No newline at end of file
@@ -25,9 +25,11 @@ LiniarAllocator::~LiniarAllocator()
 
 void LiniarAllocator::Init(uint64_t totalSize)
 {
-	mTotalSize = totalSize;
+	Terminate();
+
+	mpMemoryBuffer = ::malloc(totalSize);
 
-	mpMemoryBuffer = ::malloc(mTotalSize);
+	mTotalSize = (mpMemoryBuffer ? totalSize : 0);
 }
 
 void LiniarAllocator::Reset()
@@ -52,11 +54,15 @@ void* LiniarAllocator::Allocate(uint64_t size, uint64_t alignment)
 {
 	assert(size > 0);
 
+	if (nullptr == mpMemoryBuffer)
+		return nullptr;
+
 	const uint64_t currentAddress = reinterpret_cast<uint64_t>(mpMemoryBuffer) + mOffset;
 
 	// in case alignment is needed we find the correct padding
+	// NOTE! The padding depends on the actual address, not only on the offset, as the buffer itself may be less aligned
 	uint64_t padding = 0;
-	if ((alignment > 0) && (mOffset % alignment != 0))
+	if (alignment > 0)
 	{
 		padding = MemoryUtility::CalculateMemoryPadding(currentAddress, alignment);
 	}
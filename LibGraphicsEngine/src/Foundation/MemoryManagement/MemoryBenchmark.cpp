@@ -1,75 +1,574 @@
 #include "Foundation/MemoryManagement/MemoryBenchmark.hpp"
-#include "Foundation/MemoryManagement/Allocator.hpp"
+#include "Foundation/MemoryManagement/SystemAllocator.hpp"
+#include "Foundation/MemoryManagement/LiniarAllocator.hpp"
+#include "Foundation/MemoryManagement/PoolAllocator.hpp"
+#include "Foundation/MemoryManagement/FrameAllocator.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
-#include <iostream>
+#include "Foundation/Timer.hpp"
+#include "Foundation/Logger.hpp"
+#include <random>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <algorithm> // std::shuffle(), std::max(), std::min()
 #include <cassert>
 
-
 using namespace GraphicsEngine;
 
+namespace
+{
+	static const uint64_t DEFAULT_ALIGNMENT = 16;
+	static const uint64_t FIXED_SIZE = 64;
+	static const uint64_t MIN_RANDOM_SIZE = 16;
+	static const uint64_t MAX_RANDOM_SIZE = 1024;
+
+	// live blocks window of the interleaved workloads
+	static const uint32_t INTERLEAVED_SLOT_COUNT = 1024;
+
+	static const uint32_t FRAME_COUNT = 2;
+	static const uint32_t FRAME_ALLOCATION_COUNT = 1024;
+
+	static const uint64_t POOL_PAGE_SIZE = 1 << 20;
+	static const uint64_t POOL_MAX_CHUNK_SIZE = 1 << 16;
+
+	static const uint32_t MAX_THREAD_COUNT = 8;
+}
+
 MemoryBenchmark::MemoryBenchmark()
 	: mOperationCount(0)
-	, mTimer()
+	, mSeed(1)
 {}
 
-MemoryBenchmark::MemoryBenchmark(uint64_t operationCount)
+MemoryBenchmark::MemoryBenchmark(uint64_t operationCount, uint32_t seed)
 	: mOperationCount(operationCount)
-	, mTimer(1000)
+	, mSeed(seed)
 {}
 
 MemoryBenchmark::~MemoryBenchmark()
 {}
 
-void MemoryBenchmark::SingleAllocation(Allocator* allocatorPtr, uint64_t size, uint64_t alignment)
+void MemoryBenchmark::SetTrace(const std::vector<MemoryManager::TraceEvent>& trace)
+{
+	mTrace = trace;
+}
+
+bool_t MemoryBenchmark::IsSupported(AllocatorType allocatorType, Workload workload)
+{
+	switch (allocatorType)
+	{
+	case AllocatorType::GE_AT_SYSTEM:
+	case AllocatorType::GE_AT_POOL:
+		return true;
+	case AllocatorType::GE_AT_LINIAR:
+		// not thread safe
+		return (workload != Workload::GE_W_MULTITHREADED);
+	case AllocatorType::GE_AT_FRAME:
+		// the blocks must not outlive their frame
+		return ((workload == Workload::GE_W_FIXED_SIZE) || (workload == Workload::GE_W_RANDOM_SIZE));
+	case AllocatorType::GE_AT_COUNT:
+	default:
+		return false;
+	}
+}
+
+bool_t MemoryBenchmark::Run(AllocatorType allocatorType, Workload workload, Result& resultOut)
 {
-	assert(nullptr != allocatorPtr);
+	if (false == IsSupported(allocatorType, workload))
+		return false;
 
-	mTimer.Start();
+	if (workload == Workload::GE_W_MULTITHREADED)
+		return RunMultithreaded(allocatorType, resultOut);
 
-	allocatorPtr->Init(1e5);
+	OperationList list;
+	BuildOperations(workload, mOperationCount, mSeed, list);
+	if (list.operations.empty())
+		return false;
 
-	for (uint32_t operation = 0; operation < mOperationCount; ++ operation)
+	Allocator* pAllocator = nullptr;
+	FrameAllocator* pFrameAllocator = nullptr;
+
+	switch (allocatorType)
+	{
+	case AllocatorType::GE_AT_SYSTEM:
+	{
+		pAllocator = GE_ALLOC(SystemAllocator);
+	} break;
+	case AllocatorType::GE_AT_LINIAR:
+	{
+		pAllocator = GE_ALLOC(LiniarAllocator);
+		// every allocation may need a full alignment of padding
+		pAllocator->Init(list.totalAllocatedBytes + (list.operations.size() * list.maxAlignment));
+	} break;
+	case AllocatorType::GE_AT_POOL:
 	{
-		allocatorPtr->Allocate(size, alignment);
+		if (list.maxSize > POOL_MAX_CHUNK_SIZE)
+		{
+			LOG_WARNING("%s: blocks up to %llu bytes are too big for a pool!", GetWorkloadName(workload), static_cast<unsigned long long>(list.maxSize));
+			return false;
+		}
+
+		const uint32_t chunksPerPage = static_cast<uint32_t>(std::max<uint64_t>(POOL_PAGE_SIZE / list.maxSize, 1));
+		pAllocator = GE_ALLOC(PoolAllocator)(list.maxSize, list.maxAlignment, chunksPerPage);
+	} break;
+	case AllocatorType::GE_AT_FRAME:
+	{
+		pFrameAllocator = GE_ALLOC(FrameAllocator)(FRAME_COUNT);
+		pFrameAllocator->Init(FRAME_ALLOCATION_COUNT * (list.maxSize + list.maxAlignment));
+		pAllocator = pFrameAllocator;
+	} break;
+	case AllocatorType::GE_AT_COUNT:
+	default:
+		return false;
 	}
+	assert(pAllocator != nullptr);
+
+	const int64_t elapsedTime = Replay(pAllocator, pFrameAllocator, list);
+	const uint64_t peak = pAllocator->Peak();
+
+	GE_FREE(pAllocator);
+
+	if (elapsedTime < 0)
+	{
+		LOG_WARNING("%s allocator ran out of memory in the %s workload!", GetAllocatorName(allocatorType), GetWorkloadName(workload));
+		return false;
+	}
+
+	const uint64_t operationCount = list.operations.size();
+	const float64_t elapsedNs = static_cast<float64_t>(std::max<int64_t>(elapsedTime, 1));
+
+	resultOut.allocatorType = allocatorType;
+	resultOut.workload = workload;
+	resultOut.operationCount = operationCount;
+	resultOut.threadCount = 1;
+	resultOut.nsPerOperation = elapsedNs / operationCount;
+	resultOut.operationsPerSecond = operationCount * 1e9 / elapsedNs;
+	resultOut.livePeakBytes = ComputeLivePeak(list, (pFrameAllocator ? FRAME_ALLOCATION_COUNT : 0));
+	// the system allocator does not track its memory
+	resultOut.peakBytes = (peak > 0 ? peak : resultOut.livePeakBytes);
+	resultOut.fragmentation = (peak > 0 ? 1.0 - static_cast<float64_t>(resultOut.livePeakBytes) / peak : -1.0);
+
+	return true;
+}
 
+void MemoryBenchmark::RunAll(std::vector<Result>& resultsOut)
+{
+	for (uint8_t workload = 0; workload < static_cast<uint8_t>(Workload::GE_W_COUNT); ++workload)
+	{
+		for (uint8_t allocatorType = 0; allocatorType < static_cast<uint8_t>(AllocatorType::GE_AT_COUNT); ++allocatorType)
+		{
+			Result result;
+			if (Run(static_cast<AllocatorType>(allocatorType), static_cast<Workload>(workload), result))
+			{
+				resultsOut.push_back(result);
+			}
+		}
+	}
+}
 
-	mTimer.Stop();
+const char_t* MemoryBenchmark::GetAllocatorName(AllocatorType allocatorType)
+{
+	switch (allocatorType)
+	{
+	case AllocatorType::GE_AT_SYSTEM:
+		return "system";
+	case AllocatorType::GE_AT_LINIAR:
+		return "linear";
+	case AllocatorType::GE_AT_POOL:
+		return "pool";
+	case AllocatorType::GE_AT_FRAME:
+		return "frame";
+	case AllocatorType::GE_AT_COUNT:
+	default:
+		return "unknown";
+	}
+}
 
-	CollectResults(mTimer.ElapsedTimeInMiliseconds(), allocatorPtr->Peak());
+const char_t* MemoryBenchmark::GetWorkloadName(Workload workload)
+{
+	switch (workload)
+	{
+	case Workload::GE_W_FIXED_SIZE:
+		return "fixed_size";
+	case Workload::GE_W_RANDOM_SIZE:
+		return "random_size";
+	case Workload::GE_W_INTERLEAVED:
+		return "interleaved";
+	case Workload::GE_W_MULTITHREADED:
+		return "multithreaded";
+	case Workload::GE_W_TRACE_REPLAY:
+		return "trace_replay";
+	case Workload::GE_W_COUNT:
+	default:
+		return "unknown";
+	}
 }
 
-void MemoryBenchmark::SingleFree(Allocator* allocatorPtr, uint64_t size, uint64_t alignment)
+void MemoryBenchmark::BuildOperations(Workload workload, uint64_t operationCount, uint32_t seed, OperationList& listOut) const
 {
-	assert(nullptr != allocatorPtr);
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<uint64_t> sizeDistribution(MIN_RANDOM_SIZE, MAX_RANDOM_SIZE);
+
+	auto& operations = listOut.operations;
+	operations.clear();
 
-	void** allocatedMemory = GE_ALLOC_ARRAY(void*, mOperationCount);
-	assert(allocatedMemory != nullptr);
+	switch (workload)
+	{
+	case Workload::GE_W_FIXED_SIZE:
+	case Workload::GE_W_RANDOM_SIZE:
+	{
+		const uint32_t blockCount = static_cast<uint32_t>(operationCount / 2);
+		listOut.slotCount = blockCount;
+		operations.reserve(2 * blockCount);
 
-	allocatorPtr->Init(1e5);
+		const bool_t isFixedSize = (workload == Workload::GE_W_FIXED_SIZE);
+		for (uint32_t i = 0; i < blockCount; ++i)
+		{
+			operations.push_back({ i, DEFAULT_ALIGNMENT, (isFixedSize ? FIXED_SIZE : sizeDistribution(generator)) });
+		}
 
-	for (uint32_t operation = 0; operation < mOperationCount; ++operation)
+		std::vector<uint32_t> freeOrder(blockCount);
+		for (uint32_t i = 0; i < blockCount; ++i)
+		{
+			freeOrder[i] = i;
+		}
+		if (false == isFixedSize)
+		{
+			std::shuffle(freeOrder.begin(), freeOrder.end(), generator);
+		}
+
+		for (auto slot : freeOrder)
+		{
+			operations.push_back({ slot, 0, 0 });
+		}
+	} break;
+	case Workload::GE_W_INTERLEAVED:
+	case Workload::GE_W_MULTITHREADED:
 	{
-		allocatedMemory[operation] = allocatorPtr->Allocate(size, alignment);
+		listOut.slotCount = INTERLEAVED_SLOT_COUNT;
+		operations.reserve(operationCount + INTERLEAVED_SLOT_COUNT);
+
+		const bool_t isFixedSize = (workload == Workload::GE_W_MULTITHREADED);
+		std::uniform_int_distribution<uint32_t> slotDistribution(0, INTERLEAVED_SLOT_COUNT - 1);
+		std::vector<bool_t> isLive(INTERLEAVED_SLOT_COUNT, false);
+
+		for (uint64_t i = 0; i < operationCount; ++i)
+		{
+			const uint32_t slot = slotDistribution(generator);
+			if (isLive[slot])
+			{
+				operations.push_back({ slot, 0, 0 });
+			}
+			else
+			{
+				operations.push_back({ slot, DEFAULT_ALIGNMENT, (isFixedSize ? FIXED_SIZE : sizeDistribution(generator)) });
+			}
+			isLive[slot] = !isLive[slot];
+		}
+
+		// leave the allocator empty
+		for (uint32_t slot = 0; slot < INTERLEAVED_SLOT_COUNT; ++slot)
+		{
+			if (isLive[slot])
+			{
+				operations.push_back({ slot, 0, 0 });
+			}
+		}
+	} break;
+	case Workload::GE_W_TRACE_REPLAY:
+	{
+		std::vector<MemoryManager::TraceEvent> syntheticTrace;
+		if (mTrace.empty())
+		{
+			BuildSyntheticTrace(syntheticTrace);
+		}
+		const auto& trace = (mTrace.empty() ? syntheticTrace : mTrace);
+
+		// the trace ids are mapped to reusable slots
+		std::unordered_map<uint32_t, uint32_t> idToSlot;
+		std::vector<uint32_t> freeSlots;
+
+		operations.reserve(trace.size());
+		for (const auto& event : trace)
+		{
+			if (event.isFree)
+			{
+				auto it = idToSlot.find(event.id);
+				if (it == idToSlot.end())
+					continue;
+
+				operations.push_back({ it->second, 0, 0 });
+				freeSlots.push_back(it->second);
+				idToSlot.erase(it);
+			}
+			else
+			{
+				uint32_t slot = listOut.slotCount;
+				if (freeSlots.empty())
+				{
+					listOut.slotCount++;
+				}
+				else
+				{
+					slot = freeSlots.back();
+					freeSlots.pop_back();
+				}
+
+				idToSlot[event.id] = slot;
+				operations.push_back({ slot, std::max<uint32_t>(event.alignment, 1), std::max<uint64_t>(event.size, 1) });
+			}
+		}
+	} break;
+	case Workload::GE_W_COUNT:
+	default:
+		break;
 	}
 
-	for (uint32_t operation = 0; operation < mOperationCount; ++operation)
+	for (const auto& operation : operations)
 	{
-		allocatorPtr->Free(allocatedMemory[operation]);
+		if (operation.size > 0)
+		{
+			listOut.maxSize = std::max(listOut.maxSize, operation.size);
+			listOut.maxAlignment = std::max<uint64_t>(listOut.maxAlignment, operation.alignment);
+			listOut.totalAllocatedBytes += operation.size;
+		}
 	}
+}
+
+void MemoryBenchmark::BuildSyntheticTrace(std::vector<MemoryManager::TraceEvent>& traceOut) const
+{
+	// a scene load followed by frames of transient allocations, sizes similar to the engine ones
+	static const uint32_t NODE_COUNT = 2000;
+	static const uint32_t MESH_COUNT = 200;
+	static const uint32_t FRAME_COUNT = 300;
+	static const uint32_t TRANSIENT_ALLOCATION_COUNT = 100;
+
+	std::mt19937 generator(mSeed);
+	std::uniform_int_distribution<uint64_t> meshSizeDistribution(1 << 10, 16 << 10);
+	std::uniform_int_distribution<uint64_t> transientSizeDistribution(16, 512);
+
+	uint32_t nextId = 0;
+	std::vector<uint32_t> liveIds;
+
+	auto allocate = [&traceOut, &nextId](uint64_t size, MemoryTag tag) -> uint32_t
+	{
+		MemoryManager::TraceEvent event;
+		event.id = nextId++;
+		event.alignment = static_cast<uint32_t>(DEFAULT_ALIGNMENT);
+		event.size = size;
+		event.tag = tag;
+		traceOut.push_back(event);
+
+		return event.id;
+	};
 
-	GE_FREE_ARRAY(allocatedMemory);
+	auto release = [&traceOut](uint32_t id)
+	{
+		MemoryManager::TraceEvent event;
+		event.id = id;
+		event.isFree = true;
+		traceOut.push_back(event);
+	};
+
+	traceOut.clear();
+
+	// scene load: nodes, components, names and mesh data
+	for (uint32_t i = 0; i < NODE_COUNT; ++i)
+	{
+		liveIds.push_back(allocate(320, MemoryTag::GE_MT_SCENE_GRAPH));
+		liveIds.push_back(allocate(96, MemoryTag::GE_MT_SCENE_GRAPH));
+		liveIds.push_back(allocate(32, MemoryTag::GE_MT_GENERAL));
+	}
+	for (uint32_t i = 0; i < MESH_COUNT; ++i)
+	{
+		// loader scratch memory is released once the mesh is built
+		const uint32_t scratchId = allocate(meshSizeDistribution(generator), MemoryTag::GE_MT_LOADERS);
+		liveIds.push_back(allocate(meshSizeDistribution(generator), MemoryTag::GE_MT_RESOURCES));
+		release(scratchId);
+	}
+
+	// frames
+	std::vector<uint32_t> transientIds;
+	for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame)
+	{
+		for (uint32_t i = 0; i < TRANSIENT_ALLOCATION_COUNT; ++i)
+		{
+			transientIds.push_back(allocate(transientSizeDistribution(generator), MemoryTag::GE_MT_RENDERER));
+		}
+		for (auto it = transientIds.rbegin(); it != transientIds.rend(); ++it)
+		{
+			release(*it);
+		}
+		transientIds.clear();
+
+		// some nodes come and go
+		if (frame % 10 == 0)
+		{
+			const size_t idx = generator() % liveIds.size();
+			release(liveIds[idx]);
+			liveIds[idx] = allocate(320, MemoryTag::GE_MT_SCENE_GRAPH);
+		}
+	}
+
+	// shutdown
+	for (auto it = liveIds.rbegin(); it != liveIds.rend(); ++it)
+	{
+		release(*it);
+	}
 }
 
-void MemoryBenchmark::CollectResults(int64_t elapsedTime, uint64_t memoryPeak)
+uint64_t MemoryBenchmark::ComputeLivePeak(const OperationList& list, uint32_t frameAllocationCount)
 {
-	float32_t operationsPerSecond = static_cast<float32_t>(mOperationCount) / elapsedTime;
-	float32_t timePerOperation = static_cast<float32_t>(elapsedTime) / mOperationCount;
-
-	// Print results
-	std::cout << "---------- BENCHMARK --------- " << std::endl;
-	std::cout << "Operations per sec: " << operationsPerSecond << std::endl;
-	std::cout << "Time per Operation: " << timePerOperation << std::endl;
-	std::cout << "Memory peak: " << memoryPeak << std::endl;
-	std::cout << "---------- BENCHMARK --------- " << std::endl;
+	std::vector<uint64_t> slotSizes(list.slotCount, 0);
+
+	uint64_t liveBytes = 0;
+	uint64_t livePeak = 0;
+	uint64_t allocationCount = 0;
+
+	for (const auto& operation : list.operations)
+	{
+		if (operation.size == 0)
+		{
+			// the frame allocator releases memory only at frame boundaries
+			if (0 == frameAllocationCount)
+			{
+				liveBytes -= slotSizes[operation.slot];
+			}
+			slotSizes[operation.slot] = 0;
+			continue;
+		}
+
+		slotSizes[operation.slot] = operation.size;
+		liveBytes += operation.size;
+		livePeak = std::max(livePeak, liveBytes);
+
+		if ((frameAllocationCount > 0) && (++allocationCount % frameAllocationCount == 0))
+		{
+			liveBytes = 0;
+		}
+	}
+
+	return livePeak;
+}
+
+int64_t MemoryBenchmark::Replay(Allocator* pAllocator, FrameAllocator* pFrameAllocator, const OperationList& list)
+{
+	assert(pAllocator != nullptr);
+
+	std::vector<void*> slots(list.slotCount, nullptr);
+	uint64_t allocationCount = 0;
+
+	Timer timer;
+	timer.Start();
+
+	for (const auto& operation : list.operations)
+	{
+		if (operation.size == 0)
+		{
+			pAllocator->Free(slots[operation.slot]);
+			slots[operation.slot] = nullptr;
+			continue;
+		}
+
+		void* ptr = pAllocator->Allocate(operation.size, operation.alignment);
+		if (nullptr == ptr)
+			return -1;
+
+		// touch the block, as a real user would
+		*static_cast<volatile uint8_t*>(ptr) = 1;
+		slots[operation.slot] = ptr;
+
+		if (pFrameAllocator && (++allocationCount % FRAME_ALLOCATION_COUNT == 0))
+		{
+			pFrameAllocator->BeginFrame();
+		}
+	}
+
+	timer.Stop();
+
+	return timer.ElapsedTimeInNanoseconds();
+}
+
+bool_t MemoryBenchmark::RunMultithreaded(AllocatorType allocatorType, Result& resultOut)
+{
+	const uint32_t threadCount = std::min(std::max(std::thread::hardware_concurrency(), 2u), MAX_THREAD_COUNT);
+
+	std::vector<OperationList> lists(threadCount);
+	uint64_t operationCount = 0;
+	uint64_t livePeak = 0;
+	for (uint32_t i = 0; i < threadCount; ++i)
+	{
+		BuildOperations(Workload::GE_W_MULTITHREADED, mOperationCount / threadCount, mSeed + i, lists[i]);
+
+		operationCount += lists[i].operations.size();
+		// upper bound, the threads don't peak at the same time
+		livePeak += ComputeLivePeak(lists[i], 0);
+	}
+
+	Allocator* pAllocator = nullptr;
+	switch (allocatorType)
+	{
+	case AllocatorType::GE_AT_SYSTEM:
+		pAllocator = GE_ALLOC(SystemAllocator);
+		break;
+	case AllocatorType::GE_AT_POOL:
+		pAllocator = GE_ALLOC(PoolAllocator)(FIXED_SIZE, DEFAULT_ALIGNMENT);
+		break;
+	default:
+		return false;
+	}
+	assert(pAllocator != nullptr);
+
+	std::atomic<bool_t> isStarted(false);
+	std::atomic<bool_t> isFailed(false);
+
+	std::vector<std::thread> threads;
+	for (uint32_t i = 0; i < threadCount; ++i)
+	{
+		threads.push_back(std::thread([&, i]()
+			{
+				while (false == isStarted.load())
+				{
+					std::this_thread::yield();
+				}
+
+				if (Replay(pAllocator, nullptr, lists[i]) < 0)
+				{
+					isFailed = true;
+				}
+			}));
+	}
+
+	Timer timer;
+	timer.Start();
+
+	isStarted = true;
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	timer.Stop();
+
+	const uint64_t peak = pAllocator->Peak();
+	GE_FREE(pAllocator);
+
+	if (isFailed)
+	{
+		LOG_WARNING("%s allocator ran out of memory in the multithreaded workload!", GetAllocatorName(allocatorType));
+		return false;
+	}
+
+	const float64_t elapsedNs = static_cast<float64_t>(std::max<int64_t>(timer.ElapsedTimeInNanoseconds(), 1));
+
+	resultOut.allocatorType = allocatorType;
+	resultOut.workload = Workload::GE_W_MULTITHREADED;
+	resultOut.operationCount = operationCount;
+	resultOut.threadCount = threadCount;
+	resultOut.nsPerOperation = elapsedNs / operationCount;
+	resultOut.operationsPerSecond = operationCount * 1e9 / elapsedNs;
+	resultOut.livePeakBytes = livePeak;
+	resultOut.peakBytes = (peak > 0 ? peak : livePeak);
+	resultOut.fragmentation = (peak > 0 ? std::max(0.0, 1.0 - static_cast<float64_t>(livePeak) / peak) : -1.0);
+
+	return true;
 }
\ No newline at end of file
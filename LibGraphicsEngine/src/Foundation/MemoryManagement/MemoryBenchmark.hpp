@@ -3,29 +3,109 @@
 
 #include "Foundation/TypeDefines.hpp"
 #include "Foundation/NoCopyNoMoveClass.hpp"
-#include "Foundation/Timer.hpp"
+#include "Foundation/MemoryManagement/MemoryManager.hpp"
+#include <vector>
 
 namespace GraphicsEngine
 {
 	class Allocator;
+	class FrameAllocator;
 
+	/*
+		Allocator benchmark suite, runs the standard workloads on our allocators.
+		The workloads are generated upfront from a fixed seed, so the runs are reproducible and only the allocator calls are timed.
+		An operation is one Allocate() or one Free() call.
+	*/
 	class MemoryBenchmark
 	{
 	public:
+		enum class AllocatorType : uint8_t
+		{
+			GE_AT_SYSTEM = 0,
+			GE_AT_LINIAR,
+			GE_AT_POOL,
+			GE_AT_FRAME,
+			GE_AT_COUNT
+		};
+
+		enum class Workload : uint8_t
+		{
+			GE_W_FIXED_SIZE = 0, // allocates blocks of the same size, frees them in order
+			GE_W_RANDOM_SIZE, // allocates blocks of random sizes, frees them in random order
+			GE_W_INTERLEAVED, // random mix of allocations and frees over a window of live blocks
+			GE_W_MULTITHREADED, // interleaved fixed size blocks from several threads on the same allocator
+			GE_W_TRACE_REPLAY, // replay of a captured engine trace (see ENABLE_MEMORY_TRACE), a synthetic one if not set
+			GE_W_COUNT
+		};
+
+		struct Result
+		{
+			Result()
+				: allocatorType(AllocatorType::GE_AT_COUNT), workload(Workload::GE_W_COUNT), operationCount(0), threadCount(0)
+				, nsPerOperation(0.0), operationsPerSecond(0.0), peakBytes(0), livePeakBytes(0), fragmentation(-1.0)
+			{}
+
+			AllocatorType allocatorType;
+			Workload workload;
+			uint64_t operationCount;
+			uint32_t threadCount;
+			float64_t nsPerOperation;
+			float64_t operationsPerSecond;
+			uint64_t peakBytes; // memory used by the allocator, the requested live bytes if the allocator does not track it
+			uint64_t livePeakBytes; // requested bytes alive at the same time
+			float64_t fragmentation; // 1 - livePeakBytes / peakBytes, negative if unknown
+		};
+
 		MemoryBenchmark();
-		explicit MemoryBenchmark(uint64_t operationCount);
+		explicit MemoryBenchmark(uint64_t operationCount, uint32_t seed = 1);
 		virtual ~MemoryBenchmark();
 
-		void SingleAllocation(Allocator* allocatorPtr, uint64_t size, uint64_t alignment);
-		void SingleFree(Allocator* allocatorPtr, uint64_t size, uint64_t alignment);
+		void SetTrace(const std::vector<MemoryManager::TraceEvent>& trace);
+
+		static bool_t IsSupported(AllocatorType allocatorType, Workload workload);
+
+		// returns false if the workload is not supported by the allocator or the allocator ran out of memory
+		bool_t Run(AllocatorType allocatorType, Workload workload, Result& resultOut);
+		void RunAll(std::vector<Result>& resultsOut);
 
-		void CollectResults(int64_t elapsedTime, uint64_t memoryPeak);
+		static const char_t* GetAllocatorName(AllocatorType allocatorType);
+		static const char_t* GetWorkloadName(Workload workload);
 
 	private:
 		NO_COPY_NO_MOVE_CLASS(MemoryBenchmark)
 
+		struct Operation
+		{
+			uint32_t slot;
+			uint32_t alignment;
+			uint64_t size; // 0 for frees
+		};
+
+		struct OperationList
+		{
+			OperationList()
+				: slotCount(0), maxSize(0), maxAlignment(0), totalAllocatedBytes(0)
+			{}
+
+			std::vector<Operation> operations;
+			uint32_t slotCount;
+			uint64_t maxSize;
+			uint64_t maxAlignment;
+			uint64_t totalAllocatedBytes;
+		};
+
+		void BuildOperations(Workload workload, uint64_t operationCount, uint32_t seed, OperationList& listOut) const;
+		void BuildSyntheticTrace(std::vector<MemoryManager::TraceEvent>& traceOut) const;
+
+		static uint64_t ComputeLivePeak(const OperationList& list, uint32_t frameAllocationCount);
+		// returns the elapsed nanoseconds, negative if the allocator ran out of memory
+		static int64_t Replay(Allocator* pAllocator, FrameAllocator* pFrameAllocator, const OperationList& list);
+
+		bool_t RunMultithreaded(AllocatorType allocatorType, Result& resultOut);
+
 		uint64_t mOperationCount;
-		Timer mTimer;
+		uint32_t mSeed;
+		std::vector<MemoryManager::TraceEvent> mTrace;
 	};
 }
-#endif /* FOUNDATION_MEMORYMANAGEMENT_ */
\ No newline at end of file
+#endif /* FOUNDATION_MEMORYMANAGEMENT_MEMORY_BENCHMARK_HPP */
\ No newline at end of file
@@ -0,0 +1,436 @@
+#include "Foundation/MemoryManagement/MemoryManager.hpp"
+#include "Foundation/MemoryManagement/SystemAllocator.hpp"
+#include "Foundation/Logger.hpp"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm> // std::sort()
+#include <fstream>
+#include <cassert>
+
+namespace GraphicsEngine
+{
+	namespace MemoryManager
+	{
+		static const uint64_t MIN_ALIGNMENT = 16;
+		static const char_t* TRACE_FILE_HEADER = "GE_MEMORY_TRACE";
+		static const uint32_t TRACE_FILE_VERSION = 1;
+
+		struct AllocationHeader
+		{
+			Allocator* pAllocator;
+			const char_t* pFile;
+			uint64_t size;
+			uint64_t arrayCount;
+			uint32_t line;
+			uint32_t offset; // from the start of the allocator block to the user pointer
+			MemoryTag tag;
+		};
+
+		struct TagCounters
+		{
+			TagCounters()
+				: currentBytes(0), peakBytes(0), liveAllocationCount(0), totalAllocationCount(0)
+			{}
+
+			std::atomic<uint64_t> currentBytes;
+			std::atomic<uint64_t> peakBytes;
+			std::atomic<uint64_t> liveAllocationCount;
+			std::atomic<uint64_t> totalAllocationCount;
+		};
+
+		struct CallSiteKey
+		{
+			const char_t* pFile;
+			uint32_t line;
+
+			bool operator ==(const CallSiteKey& other) const
+			{
+				return (pFile == other.pFile) && (line == other.line);
+			}
+		};
+
+		struct CallSiteKeyHash
+		{
+			size_t operator()(const CallSiteKey& key) const
+			{
+				return std::hash<const void*>()(key.pFile) ^ (static_cast<size_t>(key.line) * 0x9E3779B9u);
+			}
+		};
+
+		struct State
+		{
+			State()
+				: isCapturingTrace(false), nextTraceId(0)
+			{
+				for (auto& pAllocator : allocators)
+				{
+					pAllocator = nullptr;
+				}
+			}
+
+			std::atomic<Allocator*> allocators[static_cast<uint8_t>(MemoryTag::GE_MT_COUNT)];
+			TagCounters tags[static_cast<uint8_t>(MemoryTag::GE_MT_COUNT)];
+			TagCounters total;
+
+			// guards the call sites and the trace capture
+			std::mutex callSiteMutex;
+			std::unordered_map<CallSiteKey, CallSiteStatistics, CallSiteKeyHash> callSites;
+
+			bool_t isCapturingTrace;
+			uint32_t nextTraceId;
+			std::vector<TraceEvent> trace;
+			std::unordered_map<const void*, uint32_t> traceIds;
+
+			SystemAllocator defaultAllocator;
+		};
+
+		// NOTE! Never destroyed on purpose: the static destructors run at exit in no defined order across the
+		// translation units and can still free objects, so the state is leaked instead of being a static object.
+		// The other engine singletons used at exit do the same (ObjectPool::GetShared(), the Profiler and the Logger states).
+		static State& GetState()
+		{
+			static State* pState = ::new State;
+
+			return *pState;
+		}
+
+		static AllocationHeader* GetHeader(const void* ptr)
+		{
+			return const_cast<AllocationHeader*>(reinterpret_cast<const AllocationHeader*>(ptr) - 1);
+		}
+
+		static void UpdatePeak(std::atomic<uint64_t>& peak, uint64_t value)
+		{
+			uint64_t previous = peak.load(std::memory_order_relaxed);
+			while ((previous < value) && (false == peak.compare_exchange_weak(previous, value, std::memory_order_relaxed)))
+			{}
+		}
+
+		static void AddAllocation(TagCounters& counters, uint64_t size)
+		{
+			const uint64_t current = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+			UpdatePeak(counters.peakBytes, current);
+			counters.liveAllocationCount.fetch_add(1, std::memory_order_relaxed);
+			counters.totalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		static void RemoveAllocation(TagCounters& counters, uint64_t size)
+		{
+			counters.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+			counters.liveAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		static void CopyStatistics(const TagCounters& counters, TagStatistics& statisticsOut)
+		{
+			statisticsOut.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+			statisticsOut.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+			statisticsOut.liveAllocationCount = counters.liveAllocationCount.load(std::memory_order_relaxed);
+			statisticsOut.totalAllocationCount = counters.totalAllocationCount.load(std::memory_order_relaxed);
+		}
+
+		void SetAllocator(MemoryTag tag, Allocator* pAllocator)
+		{
+			assert(tag < MemoryTag::GE_MT_COUNT);
+
+			GetState().allocators[static_cast<uint8_t>(tag)].store(pAllocator);
+		}
+
+		Allocator* GetAllocator(MemoryTag tag)
+		{
+			assert(tag < MemoryTag::GE_MT_COUNT);
+
+			State& state = GetState();
+			Allocator* pAllocator = state.allocators[static_cast<uint8_t>(tag)].load();
+
+			return (pAllocator ? pAllocator : &state.defaultAllocator);
+		}
+
+		void* Allocate(uint64_t size, uint64_t alignment, MemoryTag tag, const char_t* pFile, uint32_t line)
+		{
+			assert(tag < MemoryTag::GE_MT_COUNT);
+			assert((alignment & (alignment - 1)) == 0);
+
+			alignment = std::max(alignment, MIN_ALIGNMENT);
+			const uint64_t offset = (sizeof(AllocationHeader) + alignment - 1) & ~(alignment - 1);
+
+			Allocator* pAllocator = GetAllocator(tag);
+			uint8_t* pBlock = static_cast<uint8_t*>(pAllocator->Allocate(offset + size, alignment));
+			if (nullptr == pBlock)
+			{
+				LOG_ERROR("Out of memory! Failed to allocate %llu bytes for %s at %s:%u", static_cast<unsigned long long>(size), GetTagName(tag), pFile, line);
+				throw std::bad_alloc();
+			}
+
+			uint8_t* pUser = pBlock + offset;
+
+			AllocationHeader* pHeader = GetHeader(pUser);
+			pHeader->pAllocator = pAllocator;
+			pHeader->pFile = pFile;
+			pHeader->size = size;
+			pHeader->arrayCount = 0;
+			pHeader->line = line;
+			pHeader->offset = static_cast<uint32_t>(offset);
+			pHeader->tag = tag;
+
+			State& state = GetState();
+			AddAllocation(state.tags[static_cast<uint8_t>(tag)], size);
+			AddAllocation(state.total, size);
+
+			{
+				std::lock_guard<std::mutex> lock(state.callSiteMutex);
+
+				CallSiteKey key = { pFile, line };
+				CallSiteStatistics& callSite = state.callSites[key];
+				callSite.pFile = pFile;
+				callSite.line = line;
+				callSite.tag = tag;
+				callSite.currentBytes += size;
+				callSite.liveAllocationCount++;
+				callSite.totalAllocationCount++;
+
+				if (state.isCapturingTrace)
+				{
+					TraceEvent event;
+					event.id = state.nextTraceId++;
+					event.alignment = static_cast<uint32_t>(alignment);
+					event.size = size;
+					event.tag = tag;
+					event.isFree = false;
+
+					state.trace.push_back(event);
+					state.traceIds[pUser] = event.id;
+				}
+			}
+
+			return pUser;
+		}
+
+		void Free(void* ptr)
+		{
+			if (nullptr == ptr)
+				return;
+
+			const AllocationHeader* pHeader = GetHeader(ptr);
+			assert(pHeader->pAllocator != nullptr);
+			assert(pHeader->tag < MemoryTag::GE_MT_COUNT);
+
+			State& state = GetState();
+			RemoveAllocation(state.tags[static_cast<uint8_t>(pHeader->tag)], pHeader->size);
+			RemoveAllocation(state.total, pHeader->size);
+
+			{
+				std::lock_guard<std::mutex> lock(state.callSiteMutex);
+
+				CallSiteKey key = { pHeader->pFile, pHeader->line };
+				auto it = state.callSites.find(key);
+				if (it != state.callSites.end())
+				{
+					it->second.currentBytes -= pHeader->size;
+					it->second.liveAllocationCount--;
+				}
+
+				if (state.isCapturingTrace)
+				{
+					auto idIt = state.traceIds.find(ptr);
+					if (idIt != state.traceIds.end())
+					{
+						TraceEvent event;
+						event.id = idIt->second;
+						event.tag = pHeader->tag;
+						event.isFree = true;
+
+						state.trace.push_back(event);
+						state.traceIds.erase(idIt);
+					}
+				}
+			}
+
+			pHeader->pAllocator->Free(static_cast<uint8_t*>(ptr) - pHeader->offset);
+		}
+
+		void SetArrayCount(void* ptr, uint64_t count)
+		{
+			assert(ptr != nullptr);
+
+			GetHeader(ptr)->arrayCount = count;
+		}
+
+		uint64_t GetArrayCount(const void* ptr)
+		{
+			assert(ptr != nullptr);
+
+			return GetHeader(ptr)->arrayCount;
+		}
+
+		void GetReport(MemoryReport& reportOut)
+		{
+			State& state = GetState();
+
+			for (uint8_t i = 0; i < static_cast<uint8_t>(MemoryTag::GE_MT_COUNT); ++i)
+			{
+				CopyStatistics(state.tags[i], reportOut.tags[i]);
+			}
+			CopyStatistics(state.total, reportOut.total);
+
+			reportOut.callSites.clear();
+			{
+				std::lock_guard<std::mutex> lock(state.callSiteMutex);
+
+				reportOut.callSites.reserve(state.callSites.size());
+				for (const auto& it : state.callSites)
+				{
+					reportOut.callSites.push_back(it.second);
+				}
+			}
+
+			std::sort(reportOut.callSites.begin(), reportOut.callSites.end(),
+				[](const CallSiteStatistics& a, const CallSiteStatistics& b) { return a.currentBytes > b.currentBytes; });
+		}
+
+		void LogReport(uint32_t maxCallSiteCount)
+		{
+			MemoryReport report;
+			GetReport(report);
+
+			LOG_INFO("---------- MEMORY REPORT ---------");
+			for (uint8_t i = 0; i < static_cast<uint8_t>(MemoryTag::GE_MT_COUNT); ++i)
+			{
+				const TagStatistics& tag = report.tags[i];
+				LOG_INFO("%-12s current: %llu bytes, peak: %llu bytes, live allocations: %llu, total allocations: %llu", GetTagName(static_cast<MemoryTag>(i)),
+					static_cast<unsigned long long>(tag.currentBytes), static_cast<unsigned long long>(tag.peakBytes),
+					static_cast<unsigned long long>(tag.liveAllocationCount), static_cast<unsigned long long>(tag.totalAllocationCount));
+			}
+			LOG_INFO("%-12s current: %llu bytes, peak: %llu bytes, live allocations: %llu, total allocations: %llu", "Total",
+				static_cast<unsigned long long>(report.total.currentBytes), static_cast<unsigned long long>(report.total.peakBytes),
+				static_cast<unsigned long long>(report.total.liveAllocationCount), static_cast<unsigned long long>(report.total.totalAllocationCount));
+
+			const size_t callSiteCount = std::min(report.callSites.size(), static_cast<size_t>(maxCallSiteCount));
+			for (size_t i = 0; (i < callSiteCount) && (report.callSites[i].currentBytes > 0); ++i)
+			{
+				const CallSiteStatistics& callSite = report.callSites[i];
+				LOG_INFO("%s:%u (%s) - %llu bytes in %llu allocations", callSite.pFile, callSite.line, GetTagName(callSite.tag),
+					static_cast<unsigned long long>(callSite.currentBytes), static_cast<unsigned long long>(callSite.liveAllocationCount));
+			}
+			LOG_INFO("---------- MEMORY REPORT ---------");
+		}
+
+		void BeginTraceCapture()
+		{
+			State& state = GetState();
+			std::lock_guard<std::mutex> lock(state.callSiteMutex);
+
+			state.isCapturingTrace = true;
+			state.nextTraceId = 0;
+			state.trace.clear();
+			state.traceIds.clear();
+		}
+
+		void EndTraceCapture(std::vector<TraceEvent>& traceOut)
+		{
+			State& state = GetState();
+			std::lock_guard<std::mutex> lock(state.callSiteMutex);
+
+			state.isCapturingTrace = false;
+			traceOut.swap(state.trace);
+
+			state.trace.clear();
+			state.traceIds.clear();
+		}
+
+		bool_t SaveTrace(const std::string& filePath, const std::vector<TraceEvent>& trace)
+		{
+			std::ofstream file(filePath);
+			if (false == file.is_open())
+			{
+				LOG_ERROR("Failed to open trace file %s!", filePath.c_str());
+				return false;
+			}
+
+			// one event per line: a <id> <size> <alignment> <tag> or f <id>
+			file << TRACE_FILE_HEADER << " " << TRACE_FILE_VERSION << "\n";
+			for (const auto& event : trace)
+			{
+				if (event.isFree)
+				{
+					file << "f " << event.id << "\n";
+				}
+				else
+				{
+					file << "a " << event.id << " " << event.size << " " << event.alignment << " " << static_cast<uint32_t>(event.tag) << "\n";
+				}
+			}
+
+			return file.good();
+		}
+
+		bool_t LoadTrace(const std::string& filePath, std::vector<TraceEvent>& traceOut)
+		{
+			std::ifstream file(filePath);
+			if (false == file.is_open())
+			{
+				LOG_ERROR("Failed to open trace file %s!", filePath.c_str());
+				return false;
+			}
+
+			std::string header;
+			uint32_t version = 0;
+			file >> header >> version;
+			if ((header != TRACE_FILE_HEADER) || (version != TRACE_FILE_VERSION))
+			{
+				LOG_ERROR("Invalid trace file %s!", filePath.c_str());
+				return false;
+			}
+
+			traceOut.clear();
+
+			char_t type = 0;
+			while (file >> type)
+			{
+				TraceEvent event;
+				event.isFree = (type == 'f');
+
+				if (event.isFree)
+				{
+					file >> event.id;
+				}
+				else
+				{
+					uint32_t tag = 0;
+					file >> event.id >> event.size >> event.alignment >> tag;
+					event.tag = (tag < static_cast<uint32_t>(MemoryTag::GE_MT_COUNT) ? static_cast<MemoryTag>(tag) : MemoryTag::GE_MT_GENERAL);
+				}
+
+				if (file.fail())
+				{
+					LOG_ERROR("Corrupted trace file %s!", filePath.c_str());
+					return false;
+				}
+
+				traceOut.push_back(event);
+			}
+
+			return true;
+		}
+
+		const char_t* GetTagName(MemoryTag tag)
+		{
+			switch (tag)
+			{
+			case MemoryTag::GE_MT_GENERAL:
+				return "General";
+			case MemoryTag::GE_MT_SCENE_GRAPH:
+				return "SceneGraph";
+			case MemoryTag::GE_MT_RESOURCES:
+				return "Resources";
+			case MemoryTag::GE_MT_LOADERS:
+				return "Loaders";
+			case MemoryTag::GE_MT_RENDERER:
+				return "Renderer";
+			case MemoryTag::GE_MT_COUNT:
+			default:
+				return "Unknown";
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#ifndef FOUNDATION_MEMORYMANAGEMENT_MEMORY_MANAGER_HPP
+#define FOUNDATION_MEMORYMANAGEMENT_MEMORY_MANAGER_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include <vector>
+#include <string>
+#include <new> // placement new
+#include <type_traits>
+
+namespace GraphicsEngine
+{
+	class Allocator;
+
+	// subsystems owning GE_ALLOC'ed memory
+	enum class MemoryTag : uint8_t
+	{
+		GE_MT_GENERAL = 0,
+		GE_MT_SCENE_GRAPH,
+		GE_MT_RESOURCES,
+		GE_MT_LOADERS,
+		GE_MT_RENDERER,
+		GE_MT_COUNT
+	};
+
+	/*
+		Tracked allocations behind GE_ALLOC/GE_FREE, used when ENABLE_MEMORY_TRACKING is defined.
+		Each allocation carries a small header (size, tag, call site, owning allocator),
+		so it is freed through the right backend and accounted per subsystem and per call site.
+		NOTE! Memory allocated with GE_ALLOC must be freed with GE_FREE and vice versa.
+	*/
+	namespace MemoryManager
+	{
+		struct TagStatistics
+		{
+			TagStatistics()
+				: currentBytes(0), peakBytes(0), liveAllocationCount(0), totalAllocationCount(0)
+			{}
+
+			uint64_t currentBytes;
+			uint64_t peakBytes;
+			uint64_t liveAllocationCount;
+			uint64_t totalAllocationCount;
+		};
+
+		struct CallSiteStatistics
+		{
+			CallSiteStatistics()
+				: pFile(nullptr), line(0), tag(MemoryTag::GE_MT_GENERAL), currentBytes(0), liveAllocationCount(0), totalAllocationCount(0)
+			{}
+
+			const char_t* pFile;
+			uint32_t line;
+			MemoryTag tag;
+			uint64_t currentBytes;
+			uint64_t liveAllocationCount;
+			uint64_t totalAllocationCount;
+		};
+
+		// one GE_ALLOC/GE_FREE of a captured allocation trace
+		struct TraceEvent
+		{
+			TraceEvent()
+				: id(0), alignment(0), size(0), tag(MemoryTag::GE_MT_GENERAL), isFree(false)
+			{}
+
+			uint32_t id; // the free of an allocation has the same id
+			uint32_t alignment;
+			uint64_t size;
+			MemoryTag tag;
+			bool_t isFree;
+		};
+
+		struct MemoryReport
+		{
+			TagStatistics tags[static_cast<uint8_t>(MemoryTag::GE_MT_COUNT)];
+			TagStatistics total;
+			std::vector<CallSiteStatistics> callSites; // sorted by current bytes, biggest owner first
+		};
+
+		// selects the backend of a subsystem, nullptr restores the default SystemAllocator
+		// NOTE! The allocator must outlive its allocations and be thread safe if the subsystem allocates from several threads
+		void SetAllocator(MemoryTag tag, Allocator* pAllocator);
+		Allocator* GetAllocator(MemoryTag tag);
+
+		// alignment must be a power of 2 (or 0)
+		void* Allocate(uint64_t size, uint64_t alignment, MemoryTag tag, const char_t* pFile, uint32_t line);
+		void Free(void* ptr);
+
+		void GetReport(MemoryReport& reportOut);
+		void LogReport(uint32_t maxCallSiteCount = 10);
+
+		const char_t* GetTagName(MemoryTag tag);
+
+		// allocation trace capture, replayed by the allocator benchmark
+		// NOTE! Frees of allocations done before the capture started are not recorded
+		void BeginTraceCapture();
+		void EndTraceCapture(std::vector<TraceEvent>& traceOut);
+
+		bool_t SaveTrace(const std::string& filePath, const std::vector<TraceEvent>& trace);
+		bool_t LoadTrace(const std::string& filePath, std::vector<TraceEvent>& traceOut);
+
+		// compile time subsystem of a source file, based on its path
+		constexpr bool_t StartsWith(const char_t* pString, const char_t* pPrefix)
+		{
+			return (*pPrefix == '\0') ? true : ((*pString == *pPrefix) ? StartsWith(pString + 1, pPrefix + 1) : false);
+		}
+
+		constexpr bool_t Contains(const char_t* pString, const char_t* pPattern)
+		{
+			return (*pString == '\0') ? (*pPattern == '\0') : (StartsWith(pString, pPattern) ? true : Contains(pString + 1, pPattern));
+		}
+
+		constexpr MemoryTag TagFromFile(const char_t* pFile)
+		{
+			return Contains(pFile, "Resources") ? MemoryTag::GE_MT_RESOURCES :
+				(Contains(pFile, "SceneGraph") || Contains(pFile, "Components")) ? MemoryTag::GE_MT_SCENE_GRAPH :
+				Contains(pFile, "Loaders") ? MemoryTag::GE_MT_LOADERS :
+				Contains(pFile, "Rendering") ? MemoryTag::GE_MT_RENDERER :
+				MemoryTag::GE_MT_GENERAL;
+		}
+
+		// array element count, stored in the allocation header
+		void SetArrayCount(void* ptr, uint64_t count);
+		uint64_t GetArrayCount(const void* ptr);
+
+		namespace Internal
+		{
+			// start of the allocated block, for polymorphic types the pointer may point to a base class subobject
+			template <typename T>
+			void* GetBlockStart(T* ptr, std::true_type)
+			{
+				return const_cast<void*>(dynamic_cast<const volatile void*>(ptr));
+			}
+
+			template <typename T>
+			void* GetBlockStart(T* ptr, std::false_type)
+			{
+				return const_cast<void*>(static_cast<const volatile void*>(ptr));
+			}
+		}
+
+		template <typename T>
+		T* NewArray(uint64_t count, MemoryTag tag, const char_t* pFile, uint32_t line)
+		{
+			T* pElements = static_cast<T*>(Allocate(count * sizeof(T), alignof(T), tag, pFile, line));
+			SetArrayCount(pElements, count);
+
+			for (uint64_t i = 0; i < count; ++i)
+			{
+				::new (static_cast<void*>(pElements + i)) T;
+			}
+
+			return pElements;
+		}
+
+		template <typename T>
+		void Delete(T* ptr)
+		{
+			if (nullptr == ptr)
+				return;
+
+			void* pBlock = Internal::GetBlockStart(ptr, std::is_polymorphic<T>());
+			ptr->~T();
+
+			Free(pBlock);
+		}
+
+		inline void Delete(void* ptr)
+		{
+			Free(ptr);
+		}
+
+		template <typename T>
+		void DeleteArray(T* ptr)
+		{
+			if (nullptr == ptr)
+				return;
+
+			for (uint64_t i = GetArrayCount(ptr); i > 0; --i)
+			{
+				ptr[i - 1].~T();
+			}
+
+			Free(ptr);
+		}
+	}
+}
+
+#endif /* FOUNDATION_MEMORYMANAGEMENT_MEMORY_MANAGER_HPP */
\ No newline at end of file
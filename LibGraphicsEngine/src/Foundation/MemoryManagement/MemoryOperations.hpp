@@ -2,36 +2,27 @@
 #define FOUNDATION_MEMORYMANAGEMENT_MEMORY_OPERATIONS_HPP
 
 #include "Core/AppConfig.hpp"
-#include "Foundation/MemoryManagement/LiniarAllocator.hpp"
 #include <memory> // std smart pointers
-#ifndef ENABLE_ALLOCATOR
 #include <new>
-#endif // ENABLE_ALLOCATOR
 #include <cassert>
 
-#define GE_ALLOC(T) ::new (T)
-#define GE_ALLOC_ARRAY(T, size) ::new T[size]
-#define GE_FREE(T) if (T) { ::delete (T); T = nullptr; }
-#define GE_FREE_ARRAY(T) if (T) { ::delete[] (T); T = nullptr; }
-
-
-#ifdef ENABLE_ALLOCATOR
-using namespace GraphicsEngine;
+#ifdef ENABLE_MEMORY_TRACKING
+#include "Foundation/MemoryManagement/MemoryManager.hpp"
 
-extern LiniarAllocator gAllocator;
+// NOTE! Objects are tracked one by one, so the GE_POOLED_OBJECT pools are bypassed
+// subsystem of the current source file, resolved at compile time
+#define GE_MEMORY_TAG (std::integral_constant<GraphicsEngine::MemoryTag, GraphicsEngine::MemoryManager::TagFromFile(__FILE__)>::value)
 
-// we override the global new/delete operators
-//
-//void* operator new (std::size_t count);
-//void* operator new (std::size_t count, const std::nothrow_t & tag);
-//void* operator new[](std::size_t count);
-//void* operator new[](std::size_t count, const std::nothrow_t& tag);
-//
-//void operator delete (void* ptr);
-//void operator delete (void* ptr, const std::nothrow_t & tag);
-//void operator delete[](void* ptr);
-//void operator delete[](void* ptr, const std::nothrow_t& tag);
-
-#endif // ENABLE_ALLOCATOR
+#define GE_ALLOC(T) ::new (GraphicsEngine::MemoryManager::Allocate(sizeof(T), alignof(T), GE_MEMORY_TAG, __FILE__, __LINE__)) (T)
+#define GE_ALLOC_ARRAY(T, size) GraphicsEngine::MemoryManager::NewArray<T>(size, GE_MEMORY_TAG, __FILE__, __LINE__)
+#define GE_FREE(T) if (T) { GraphicsEngine::MemoryManager::Delete(T); T = nullptr; }
+#define GE_FREE_ARRAY(T) if (T) { GraphicsEngine::MemoryManager::DeleteArray(T); T = nullptr; }
+#else
+// class specific new/delete (GE_POOLED_OBJECT) are used if present
+#define GE_ALLOC(T) new (T)
+#define GE_ALLOC_ARRAY(T, size) ::new T[size]
+#define GE_FREE(T) if (T) { delete (T); T = nullptr; }
+#define GE_FREE_ARRAY(T) if (T) { ::delete[] (T); T = nullptr; }
+#endif // ENABLE_MEMORY_TRACKING
 
 #endif // FOUNDATION_MEMORYMANAGEMENT_MEMORY_OPERATIONS_HPP
\ No newline at end of file
@@ -6,11 +6,8 @@ namespace GraphicsEngine
 	{
 		uint64_t CalculateMemoryPadding(uint64_t baseAddress, uint64_t alignment)
 		{
-			const uint64_t multiplier = (baseAddress / alignment) + 1;
-			const uint64_t alignedAddress = multiplier * alignment;
-			const uint64_t padding = alignedAddress - baseAddress;
-
-			return padding;
+			// no padding when the address is already aligned
+			return (alignment - (baseAddress % alignment)) % alignment;
 		}
 	}
 }
\ No newline at end of file
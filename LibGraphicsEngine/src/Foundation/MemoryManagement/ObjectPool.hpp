@@ -0,0 +1,197 @@
+#ifndef FOUNDATION_MEMORYMANAGEMENT_OBJECT_POOL_HPP
+#define FOUNDATION_MEMORYMANAGEMENT_OBJECT_POOL_HPP
+
+#include "Foundation/MemoryManagement/PoolAllocator.hpp"
+#include <new> // placement new, std::bad_alloc
+#include <utility> // std::forward
+#include <cstddef> // std::size_t
+
+namespace GraphicsEngine
+{
+	/*
+		Typed pool of T objects on top of the PoolAllocator.
+		The shared pool (GetShared()) also keeps per-thread caches of free objects,
+		so most allocations and frees don't touch the pool mutex.
+		NOTE! Create()/Destroy() are for objects of exactly T, derived classes need their own pool.
+	*/
+	template <typename T>
+	class ObjectPool
+	{
+	public:
+		static const uint32_t THREAD_CACHE_BATCH_SIZE = 32;
+
+		explicit ObjectPool(uint32_t objectsPerPage = PoolAllocator::DEFAULT_CHUNKS_PER_PAGE)
+			: mAllocator(sizeof(T), alignof(T), objectsPerPage)
+			, mUseThreadCache(false)
+		{}
+
+		~ObjectPool()
+		{}
+
+		template <typename... Args>
+		T* Create(Args&&... args)
+		{
+			void* ptr = Allocate();
+			if (nullptr == ptr)
+				return nullptr;
+
+			return ::new (ptr) T(std::forward<Args>(args)...);
+		}
+
+		void Destroy(T* ptr)
+		{
+			if (nullptr == ptr)
+				return;
+
+			ptr->~T();
+			Free(ptr);
+		}
+
+		void* Allocate()
+		{
+			if (false == mUseThreadCache)
+				return mAllocator.Allocate(sizeof(T), alignof(T));
+
+			ThreadCache& cache = GetThreadCache();
+			if (nullptr == cache.pFirst)
+			{
+				cache.count = mAllocator.AllocateChunks(THREAD_CACHE_BATCH_SIZE, cache.pFirst);
+				if (nullptr == cache.pFirst)
+					return nullptr;
+			}
+
+			void* ptr = cache.pFirst;
+			cache.pFirst = PoolAllocator::GetNextChunk(ptr);
+			cache.count--;
+
+			return ptr;
+		}
+
+		void Free(void* ptr)
+		{
+			if (nullptr == ptr)
+				return;
+
+			if (false == mUseThreadCache)
+			{
+				mAllocator.Free(ptr);
+				return;
+			}
+
+			ThreadCache& cache = GetThreadCache();
+			PoolAllocator::SetNextChunk(ptr, cache.pFirst);
+			cache.pFirst = ptr;
+			cache.count++;
+
+			// give back the surplus, objects freed by other threads than the creator must not pile up here
+			if (cache.count >= 2 * THREAD_CACHE_BATCH_SIZE)
+			{
+				cache.Release(mAllocator, THREAD_CACHE_BATCH_SIZE);
+			}
+		}
+
+		PoolAllocator& GetAllocator()
+		{
+			return mAllocator;
+		}
+
+		// pool used by the GE_POOLED_OBJECT classes
+		// never destroyed, see GetState() in MemoryManager.cpp
+		static ObjectPool& GetShared()
+		{
+			static ObjectPool* pPool = CreateShared();
+
+			return *pPool;
+		}
+
+		// operator new/delete of the GE_POOLED_OBJECT classes
+		// derived classes without their own pool have a different size and fall back to the heap
+		static void* AllocateObject(std::size_t size)
+		{
+			if (size != sizeof(T))
+				return ::operator new(size);
+
+			void* ptr = GetShared().Allocate();
+			if (nullptr == ptr)
+				throw std::bad_alloc();
+
+			return ptr;
+		}
+
+		static void FreeObject(void* ptr, std::size_t size)
+		{
+			if (size != sizeof(T))
+			{
+				::operator delete(ptr);
+				return;
+			}
+
+			GetShared().Free(ptr);
+		}
+
+	private:
+		NO_COPY_NO_MOVE_CLASS(ObjectPool)
+
+		struct ThreadCache
+		{
+			ThreadCache()
+				: pFirst(nullptr), count(0)
+			{}
+
+			// only the shared pool uses thread caches
+			~ThreadCache()
+			{
+				if (pFirst)
+				{
+					Release(GetShared().mAllocator, count);
+				}
+			}
+
+			void Release(PoolAllocator& allocator, uint32_t releaseCount)
+			{
+				void* pLast = pFirst;
+				for (uint32_t i = 1; i < releaseCount; ++i)
+				{
+					pLast = PoolAllocator::GetNextChunk(pLast);
+				}
+
+				void* pRemaining = PoolAllocator::GetNextChunk(pLast);
+				allocator.FreeChunks(pFirst, pLast, releaseCount);
+
+				pFirst = pRemaining;
+				count -= releaseCount;
+			}
+
+			void* pFirst;
+			uint32_t count;
+		};
+
+		static ThreadCache& GetThreadCache()
+		{
+			static thread_local ThreadCache sCache;
+
+			return sCache;
+		}
+
+		static ObjectPool* CreateShared()
+		{
+			ObjectPool* pPool = ::new ObjectPool();
+			pPool->mUseThreadCache = true;
+
+			return pPool;
+		}
+
+		PoolAllocator mAllocator;
+		bool_t mUseThreadCache;
+	};
+}
+
+// routes new/delete of the class through ObjectPool<T>::GetShared(), use it next to GE_RTTI
+#define GE_POOLED_OBJECT( T ) \
+    public: \
+		static void* operator new(std::size_t size) { return GraphicsEngine::ObjectPool<T>::AllocateObject(size); } \
+		static void operator delete(void* ptr, std::size_t size) { GraphicsEngine::ObjectPool<T>::FreeObject(ptr, size); } \
+		static void* operator new(std::size_t, void* ptr) { return ptr; } \
+		static void operator delete(void*, void*) {}
+
+#endif /* FOUNDATION_MEMORYMANAGEMENT_OBJECT_POOL_HPP */
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "Foundation/MemoryManagement/PoolAllocator.hpp"
+#include <algorithm> // std::max
+#include <cassert>
+
+using namespace GraphicsEngine;
+
+PoolAllocator::PoolAllocator(uint64_t chunkSize, uint64_t chunkAlignment, uint32_t chunksPerPage)
+	: Allocator()
+	, mChunkSize(0)
+	, mChunkAlignment(std::max<uint64_t>(chunkAlignment, sizeof(void*)))
+	, mChunksPerPage(chunksPerPage)
+	, mpFreeList(nullptr)
+{
+	assert(chunkSize > 0);
+	assert((mChunkAlignment & (mChunkAlignment - 1)) == 0);
+	assert(chunksPerPage > 0);
+
+	// every chunk must hold the free-list link and keep the next chunk aligned
+	mChunkSize = std::max<uint64_t>(chunkSize, sizeof(void*));
+	mChunkSize = (mChunkSize + mChunkAlignment - 1) & ~(mChunkAlignment - 1);
+}
+
+PoolAllocator::~PoolAllocator()
+{
+	Terminate();
+}
+
+void PoolAllocator::Init(uint64_t totalSize)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	while (mTotalSize < totalSize)
+	{
+		if (false == AllocatePage())
+			break;
+	}
+}
+
+void PoolAllocator::Reset()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// rebuild the free-list in address order of every page
+	mpFreeList = nullptr;
+	for (auto it = mPages.rbegin(); it != mPages.rend(); ++it)
+	{
+		uint8_t* pPage = static_cast<uint8_t*>(*it);
+		for (uint32_t i = mChunksPerPage; i > 0; --i)
+		{
+			void* pChunk = pPage + (i - 1) * mChunkSize;
+			SetNextChunk(pChunk, mpFreeList);
+			mpFreeList = pChunk;
+		}
+	}
+
+	mUsed = 0;
+	mPeak = 0;
+}
+
+void PoolAllocator::Terminate()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	for (auto* pPage : mPages)
+	{
+		mPageAllocator.Free(pPage);
+	}
+	mPages.clear();
+
+	mpFreeList = nullptr;
+	mTotalSize = 0;
+	mUsed = 0;
+	mPeak = 0;
+}
+
+void* PoolAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	assert(size <= mChunkSize);
+	assert(alignment <= mChunkAlignment);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	void* pChunk = PopChunk();
+	if (pChunk)
+	{
+		mUsed += mChunkSize;
+		mPeak = std::max(mPeak, mUsed);
+	}
+
+	return pChunk;
+}
+
+void PoolAllocator::Free(void* ptr)
+{
+	if (nullptr == ptr)
+		return;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	SetNextChunk(ptr, mpFreeList);
+	mpFreeList = ptr;
+
+	mUsed -= mChunkSize;
+}
+
+uint32_t PoolAllocator::AllocateChunks(uint32_t count, void*& pFirstOut)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	pFirstOut = nullptr;
+	void* pLast = nullptr;
+
+	uint32_t allocatedCount = 0;
+	for (; allocatedCount < count; ++allocatedCount)
+	{
+		void* pChunk = PopChunk();
+		if (nullptr == pChunk)
+			break;
+
+		// keep the address order, so the objects of a thread stay contiguous
+		SetNextChunk(pChunk, nullptr);
+		if (pLast)
+		{
+			SetNextChunk(pLast, pChunk);
+		}
+		else
+		{
+			pFirstOut = pChunk;
+		}
+		pLast = pChunk;
+	}
+
+	mUsed += allocatedCount * mChunkSize;
+	mPeak = std::max(mPeak, mUsed);
+
+	return allocatedCount;
+}
+
+void PoolAllocator::FreeChunks(void* pFirst, void* pLast, uint32_t count)
+{
+	assert(pFirst != nullptr);
+	assert(pLast != nullptr);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	SetNextChunk(pLast, mpFreeList);
+	mpFreeList = pFirst;
+
+	mUsed -= count * mChunkSize;
+}
+
+uint64_t PoolAllocator::GetChunkSize() const
+{
+	return mChunkSize;
+}
+
+uint64_t PoolAllocator::GetChunkAlignment() const
+{
+	return mChunkAlignment;
+}
+
+uint32_t PoolAllocator::GetPageCount()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	return static_cast<uint32_t>(mPages.size());
+}
+
+bool_t PoolAllocator::AllocatePage()
+{
+	const uint64_t pageSize = mChunkSize * mChunksPerPage;
+
+	uint8_t* pPage = static_cast<uint8_t*>(mPageAllocator.Allocate(pageSize, mChunkAlignment));
+	if (nullptr == pPage)
+		return false;
+
+	// link the new chunks in address order in front of the free-list
+	for (uint32_t i = mChunksPerPage; i > 0; --i)
+	{
+		void* pChunk = pPage + (i - 1) * mChunkSize;
+		SetNextChunk(pChunk, mpFreeList);
+		mpFreeList = pChunk;
+	}
+
+	mPages.push_back(pPage);
+	mTotalSize += pageSize;
+
+	return true;
+}
+
+void* PoolAllocator::PopChunk()
+{
+	if ((nullptr == mpFreeList) && (false == AllocatePage()))
+		return nullptr;
+
+	void* pChunk = mpFreeList;
+	mpFreeList = GetNextChunk(pChunk);
+
+	return pChunk;
+}
\ No newline at end of file
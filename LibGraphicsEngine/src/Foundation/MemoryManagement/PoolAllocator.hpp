@@ -0,0 +1,74 @@
+#ifndef FOUNDATION_MEMORYMANAGEMENT_POOL_ALLOCATOR_HPP
+#define FOUNDATION_MEMORYMANAGEMENT_POOL_ALLOCATOR_HPP
+
+#include "Foundation/MemoryManagement/Allocator.hpp"
+#include "Foundation/MemoryManagement/SystemAllocator.hpp"
+#include <vector>
+#include <mutex>
+
+namespace GraphicsEngine
+{
+	/*
+		Thread safe pool of fixed size chunks.
+		The chunks are carved out of slab pages allocated on demand, the free chunks are kept
+		in an intrusive free-list (linked through their first pointer), so consecutive allocations are contiguous in memory.
+	*/
+	class PoolAllocator : public Allocator
+	{
+		GE_RTTI(GraphicsEngine::PoolAllocator)
+
+	public:
+		static const uint32_t DEFAULT_CHUNKS_PER_PAGE = 256;
+
+		explicit PoolAllocator(uint64_t chunkSize, uint64_t chunkAlignment = 0, uint32_t chunksPerPage = DEFAULT_CHUNKS_PER_PAGE);
+		virtual ~PoolAllocator();
+
+		// preallocates the pages needed for totalSize bytes, the pool grows on demand afterwards
+		virtual void Init(uint64_t totalSize) override;
+		// NOTE! Invalidates all the chunks handed out
+		virtual void Reset() override;
+		virtual void Terminate() override;
+
+		// size and alignment must fit the chunk
+		virtual void* Allocate(uint64_t size, uint64_t alignment = 0) override;
+		virtual void Free(void* ptr) override;
+
+		// batch operations for the per-thread caches, the chunks are returned/passed as a linked list
+		// returns the number of chunks allocated
+		uint32_t AllocateChunks(uint32_t count, void*& pFirstOut);
+		void FreeChunks(void* pFirst, void* pLast, uint32_t count);
+
+		uint64_t GetChunkSize() const;
+		uint64_t GetChunkAlignment() const;
+		uint32_t GetPageCount();
+
+		static void* GetNextChunk(void* pChunk)
+		{
+			return *static_cast<void**>(pChunk);
+		}
+
+		static void SetNextChunk(void* pChunk, void* pNext)
+		{
+			*static_cast<void**>(pChunk) = pNext;
+		}
+
+	private:
+		NO_COPY_NO_MOVE_CLASS(PoolAllocator)
+
+		// NOTE! mMutex must be locked
+		bool_t AllocatePage();
+		void* PopChunk();
+
+		uint64_t mChunkSize;
+		uint64_t mChunkAlignment;
+		uint32_t mChunksPerPage;
+
+		void* mpFreeList;
+		std::vector<void*> mPages;
+		std::mutex mMutex;
+
+		SystemAllocator mPageAllocator;
+	};
+}
+
+#endif /* FOUNDATION_MEMORYMANAGEMENT_POOL_ALLOCATOR_HPP */
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef FOUNDATION_MEMORYMANAGEMENT_STL_ALLOCATOR_HPP
+#define FOUNDATION_MEMORYMANAGEMENT_STL_ALLOCATOR_HPP
+
+#include "Foundation/MemoryManagement/Allocator.hpp"
+#include <new> // std::bad_alloc
+#include <cstddef> // std::size_t
+#include <vector>
+#include <cassert>
+
+namespace GraphicsEngine
+{
+	/* Adaptor to use our allocators with the STL containers */
+	template <typename T>
+	class StlAllocator
+	{
+	public:
+		typedef T value_type;
+
+		// NOTE! Implicit on purpose, so containers can be built directly from an allocator
+		StlAllocator(Allocator* pAllocator)
+			: mpAllocator(pAllocator)
+		{
+			assert(mpAllocator != nullptr);
+		}
+
+		template <typename U>
+		StlAllocator(const StlAllocator<U>& other)
+			: mpAllocator(other.GetAllocator())
+		{}
+
+		T* allocate(std::size_t count)
+		{
+			void* ptr = mpAllocator->Allocate(count * sizeof(T), alignof(T));
+			if (nullptr == ptr)
+				throw std::bad_alloc();
+
+			return static_cast<T*>(ptr);
+		}
+
+		void deallocate(T* ptr, std::size_t)
+		{
+			mpAllocator->Free(ptr);
+		}
+
+		Allocator* GetAllocator() const
+		{
+			return mpAllocator;
+		}
+
+	private:
+		Allocator* mpAllocator;
+	};
+
+	template <typename T, typename U>
+	bool operator ==(const StlAllocator<T>& a, const StlAllocator<U>& b)
+	{
+		return a.GetAllocator() == b.GetAllocator();
+	}
+
+	template <typename T, typename U>
+	bool operator !=(const StlAllocator<T>& a, const StlAllocator<U>& b)
+	{
+		return a.GetAllocator() != b.GetAllocator();
+	}
+
+	template <typename T>
+	using StlVector = std::vector<T, StlAllocator<T>>;
+}
+
+#endif /* FOUNDATION_MEMORYMANAGEMENT_STL_ALLOCATOR_HPP */
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "Foundation/MemoryManagement/SystemAllocator.hpp"
+#include <cstdlib> // posix_memalign(), free()
+#if defined(_WIN32)
+#include <malloc.h> // _aligned_malloc(), _aligned_free()
+#endif // _WIN32
+#include <cassert>
+
+using namespace GraphicsEngine;
+
+SystemAllocator::SystemAllocator()
+	: Allocator()
+{}
+
+SystemAllocator::~SystemAllocator()
+{
+	Terminate();
+}
+
+void SystemAllocator::Init(uint64_t totalSize)
+{
+	// the heap grows on demand
+	mTotalSize = totalSize;
+}
+
+void SystemAllocator::Reset()
+{
+	// This allocator does not support this operation!
+	// Do nothing
+}
+
+void SystemAllocator::Terminate()
+{
+	mTotalSize = 0;
+}
+
+void* SystemAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	assert(size > 0);
+
+	// the aligned allocation functions need a power of 2, multiple of sizeof(void*)
+	uint64_t effectiveAlignment = sizeof(void*);
+	while (effectiveAlignment < alignment)
+	{
+		effectiveAlignment <<= 1;
+	}
+
+	void* ptr = nullptr;
+#if defined(_WIN32)
+	ptr = ::_aligned_malloc(static_cast<size_t>(size), static_cast<size_t>(effectiveAlignment));
+#else
+	if (::posix_memalign(&ptr, static_cast<size_t>(effectiveAlignment), static_cast<size_t>(size)) != 0)
+	{
+		ptr = nullptr;
+	}
+#endif // _WIN32
+
+	return ptr;
+}
+
+void SystemAllocator::Free(void* ptr)
+{
+#if defined(_WIN32)
+	::_aligned_free(ptr);
+#else
+	::free(ptr);
+#endif // _WIN32
+}
\ No newline at end of file
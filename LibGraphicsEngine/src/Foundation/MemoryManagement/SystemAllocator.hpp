@@ -0,0 +1,32 @@
+#ifndef FOUNDATION_MEMORYMANAGEMENT_SYSTEM_ALLOCATOR_HPP
+#define FOUNDATION_MEMORYMANAGEMENT_SYSTEM_ALLOCATOR_HPP
+
+#include "Foundation/MemoryManagement/Allocator.hpp"
+
+namespace GraphicsEngine
+{
+	/* General purpose allocator on top of the OS heap, thread safe
+	   NOTE! The heap does not report block sizes back, so Used()/Peak() are not tracked here,
+	   see MemoryManager for byte counts.
+	*/
+	class SystemAllocator : public Allocator
+	{
+		GE_RTTI(GraphicsEngine::SystemAllocator)
+
+	public:
+		SystemAllocator();
+		virtual ~SystemAllocator();
+
+		virtual void Init(uint64_t totalSize) override;
+		virtual void Reset() override;
+		virtual void Terminate() override;
+
+		virtual void* Allocate(uint64_t size, uint64_t alignment = 0) override;
+		virtual void Free(void* ptr) override;
+
+	private:
+		NO_COPY_NO_MOVE_CLASS(SystemAllocator)
+	};
+}
+
+#endif /* FOUNDATION_MEMORYMANAGEMENT_SYSTEM_ALLOCATOR_HPP */
\ No newline at end of file
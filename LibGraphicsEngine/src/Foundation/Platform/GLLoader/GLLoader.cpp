@@ -111,12 +111,15 @@ PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays = NULL;
 
 // OpenGL 3.1
 // OpenGL 3.2
+PFNGLDRAWELEMENTSBASEVERTEXPROC glDrawElementsBaseVertex = NULL;
 
 // OpenGL 3.3
 PFNGLDELETESAMPLERSPROC glDeleteSamplers = NULL;
 PFNGLBINDSAMPLERPROC glBindSampler = NULL;
 PFNGLSAMPLERPARAMETERIPROC glSamplerParameteri = NULL;
 PFNGLSAMPLERPARAMETERFPROC glSamplerParameterf = NULL;
+PFNGLQUERYCOUNTERPROC glQueryCounter = NULL;
+PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v = NULL;
 
 // OpenGL 4.0
 
@@ -140,6 +143,7 @@ PFNGLMAPNAMEDBUFFERRANGEPROC glMapNamedBufferRange = NULL;
 PFNGLUNMAPNAMEDBUFFERPROC glUnmapNamedBuffer = NULL;
 PFNGLCREATEFRAMEBUFFERSPROC glCreateFramebuffers = NULL;
 PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC glNamedFramebufferRenderbuffer = NULL;
+PFNGLNAMEDFRAMEBUFFERDRAWBUFFERSPROC glNamedFramebufferDrawBuffers = NULL;
 PFNGLNAMEDFRAMEBUFFERTEXTUREPROC glNamedFramebufferTexture = NULL;
 PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC glCheckNamedFramebufferStatus = NULL;
 PFNGLCREATERENDERBUFFERSPROC glCreateRenderbuffers = NULL;
@@ -362,7 +366,7 @@ static void load_GL_VERSION_3_1(loadProc load)
 
 static void load_GL_VERSION_3_2(loadProc load)
 {
-    //
+    glDrawElementsBaseVertex = (PFNGLDRAWELEMENTSBASEVERTEXPROC)load("glDrawElementsBaseVertex");
 }
 
 static void load_GL_VERSION_3_3(loadProc load)
@@ -371,6 +375,8 @@ static void load_GL_VERSION_3_3(loadProc load)
     glBindSampler = (PFNGLBINDSAMPLERPROC)load("glBindSampler");
     glSamplerParameteri = (PFNGLSAMPLERPARAMETERIPROC)load("glSamplerParameteri");
     glSamplerParameterf = (PFNGLSAMPLERPARAMETERFPROC)load("glSamplerParameterf");
+    glQueryCounter = (PFNGLQUERYCOUNTERPROC)load("glQueryCounter");
+    glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load("glGetQueryObjectui64v");
 }
 
 static void load_GL_VERSION_4_0(loadProc load)
@@ -409,6 +415,7 @@ static void load_GL_VERSION_4_5(loadProc load)
     glUnmapNamedBuffer = (PFNGLUNMAPNAMEDBUFFERPROC)load("glUnmapNamedBuffer");
     glCreateFramebuffers = (PFNGLCREATEFRAMEBUFFERSPROC)load("glCreateFramebuffers");
     glNamedFramebufferRenderbuffer = (PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC)load("glNamedFramebufferRenderbuffer");
+    glNamedFramebufferDrawBuffers = (PFNGLNAMEDFRAMEBUFFERDRAWBUFFERSPROC)load("glNamedFramebufferDrawBuffers");
     glNamedFramebufferTexture = (PFNGLNAMEDFRAMEBUFFERTEXTUREPROC)load("glNamedFramebufferTexture");
     glCheckNamedFramebufferStatus = (PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC)load("glCheckNamedFramebufferStatus");
     glCreateRenderbuffers = (PFNGLCREATERENDERBUFFERSPROC)load("glCreateRenderbuffers");
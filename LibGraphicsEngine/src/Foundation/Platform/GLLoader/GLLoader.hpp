@@ -91,12 +91,15 @@ GLAPI PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays;
 
 // OpenGL 3.1
 // OpenGL 3.2
+GLAPI PFNGLDRAWELEMENTSBASEVERTEXPROC glDrawElementsBaseVertex;
 
 // OpenGL 3.3
 GLAPI PFNGLDELETESAMPLERSPROC glDeleteSamplers;
 GLAPI PFNGLBINDSAMPLERPROC glBindSampler;
 GLAPI PFNGLSAMPLERPARAMETERIPROC glSamplerParameteri;
 GLAPI PFNGLSAMPLERPARAMETERFPROC glSamplerParameterf;
+GLAPI PFNGLQUERYCOUNTERPROC glQueryCounter;
+GLAPI PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
 
 // OpenGL 4.0
 
@@ -120,6 +123,7 @@ GLAPI PFNGLMAPNAMEDBUFFERRANGEPROC glMapNamedBufferRange;
 GLAPI PFNGLUNMAPNAMEDBUFFERPROC glUnmapNamedBuffer;
 GLAPI PFNGLCREATEFRAMEBUFFERSPROC glCreateFramebuffers;
 GLAPI PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC glNamedFramebufferRenderbuffer;
+GLAPI PFNGLNAMEDFRAMEBUFFERDRAWBUFFERSPROC glNamedFramebufferDrawBuffers;
 GLAPI PFNGLNAMEDFRAMEBUFFERTEXTUREPROC glNamedFramebufferTexture;
 GLAPI PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC glCheckNamedFramebufferStatus;
 GLAPI PFNGLCREATERENDERBUFFERSPROC glCreateRenderbuffers;
@@ -0,0 +1,158 @@
+#include "Foundation/Platform/Headless/HeadlessPlatform.hpp"
+#include "Foundation/Logger.hpp"
+#include <csignal>
+#include <chrono>
+#include <thread>
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace Platform;
+
+// set by the signal handler, a headless process can only be stopped this way
+static volatile std::sig_atomic_t gsIsTerminateRequested = 0;
+
+static void OnTerminateSignal(int32_t)
+{
+	gsIsTerminateRequested = 1;
+}
+
+WindowHeadless::WindowHeadless()
+	: Window()
+	, mIsVisible(false)
+	, mFrameLimit(0)
+	, mFrameCount(0)
+{}
+
+WindowHeadless::WindowHeadless(const std::string& title, uint32_t width, uint32_t height, uint32_t flags)
+	: WindowHeadless()
+{
+	ResetWindowData();
+
+	mState.title = title;
+	mState.flags = flags;
+	mState.width = width;
+	mState.height = height;
+
+	std::signal(SIGINT, OnTerminateSignal);
+	std::signal(SIGTERM, OnTerminateSignal);
+
+	LOG_INFO("Headless window: %s %ux%u", title.c_str(), width, height);
+
+	UpdateWindowFlags(flags);
+}
+
+WindowHeadless::~WindowHeadless()
+{
+	std::signal(SIGINT, SIG_DFL);
+	std::signal(SIGTERM, SIG_DFL);
+
+	ResetWindowData();
+}
+
+//////////////// WINDOW API //////////////////////
+
+void WindowHeadless::GetWindowSize(uint32_t* pWidth, uint32_t* pHeight)
+{
+	assert(pWidth != nullptr);
+	assert(pHeight != nullptr);
+
+	*pWidth = mState.width;
+	*pHeight = mState.height;
+}
+
+void WindowHeadless::SetWindowSize(uint32_t width, uint32_t height)
+{
+	if ((mState.width == width) && (mState.height == height))
+		return;
+
+	mState.width = width;
+	mState.height = height;
+
+	InputWindowSize(width, height);
+}
+
+void WindowHeadless::GetWindowPos(int32_t* pXPos, int32_t* pYPos)
+{
+	assert(pXPos != nullptr);
+	assert(pYPos != nullptr);
+
+	*pXPos = 0;
+	*pYPos = 0;
+}
+
+void WindowHeadless::SetWindowTitle(const std::string& title)
+{
+	mState.title = title;
+
+	LOG_INFO("%s", title.c_str());
+}
+
+void WindowHeadless::ShowWindow()
+{
+	mIsVisible = true;
+}
+
+void WindowHeadless::HideWindow()
+{
+	mIsVisible = false;
+}
+
+bool_t WindowHeadless::IsWindowVisible()
+{
+	return mIsVisible;
+}
+
+bool_t WindowHeadless::IsWindowMinimized()
+{
+	return false;
+}
+
+bool_t WindowHeadless::IsWindowMaximized()
+{
+	return false;
+}
+
+bool_t WindowHeadless::IsWindowFocused()
+{
+	return mIsVisible;
+}
+
+///////////// EVENTS API ////////////////
+
+void WindowHeadless::PollEvents()
+{
+	++mFrameCount;
+
+	if (gsIsTerminateRequested || ((mFrameLimit > 0) && (mFrameCount >= mFrameLimit)))
+	{
+		if (false == mState.shouldClose)
+		{
+			InputWindowCloseRequest();
+		}
+	}
+}
+
+void WindowHeadless::WaitEvents()
+{
+	// no events to wait for, just don't spin
+	WaitEventsTimeout(0.001);
+}
+
+void WindowHeadless::WaitEventsTimeout(float64_t timeout)
+{
+	std::this_thread::sleep_for(std::chrono::duration<float64_t>(timeout));
+
+	PollEvents();
+}
+
+////////////////////////////////
+
+void WindowHeadless::SetFrameLimit(uint32_t frameLimit)
+{
+	mFrameLimit = frameLimit;
+}
+
+uint32_t WindowHeadless::GetFrameCount() const
+{
+	return mFrameCount;
+}
\ No newline at end of file
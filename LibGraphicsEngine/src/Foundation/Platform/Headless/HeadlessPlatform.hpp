@@ -0,0 +1,67 @@
+#ifndef FOUNDATION_PLATFORM_HEADLESS_PLATFORM_HPP
+#define FOUNDATION_PLATFORM_HEADLESS_PLATFORM_HPP
+
+#include "Foundation/Platform/PlatformInternal.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Platform
+	{
+		/*
+			Null window for the machines without a display, e.g. batch rendering and CI perf tests on servers.
+			There is no OS window: the size is only stored, the renderer draws into offscreen images
+			and the frames can be read back with Renderer::ReadFrame().
+			The event loop ends on SIGINT/SIGTERM, on SetShouldWindowClose() or after the frame limit.
+			NOTE! There is no GL context, only the Vulkan renderer is supported.
+		*/
+		class WindowHeadless : public Window
+		{
+			GE_RTTI(GraphicsEngine::Platform::WindowHeadless)
+
+		public:
+			WindowHeadless();
+			// NOTE! By default the window is visible and focused, so the engine loop runs
+			explicit WindowHeadless(const std::string& title, uint32_t width, uint32_t height,
+				uint32_t flags = Window::GE_WindowFlags::GE_WF_VISIBLE | Window::GE_WindowFlags::GE_WF_INPUT_GRABBED);
+			virtual ~WindowHeadless();
+
+			////////////////// WINDOW API //////////////////
+			virtual void GetWindowSize(uint32_t* pWidth, uint32_t* pHeight) override;
+			// notifies the size callback, the renderer recreates its offscreen images
+			virtual void SetWindowSize(uint32_t width, uint32_t height) override;
+			virtual void GetWindowPos(int32_t* pXPos, int32_t* pYPos) override;
+			// the title is logged instead, e.g. the FPS count
+			virtual void SetWindowTitle(const std::string& title) override;
+
+			virtual void ShowWindow() override;
+			virtual void HideWindow() override;
+
+			virtual bool_t IsWindowVisible() override;
+			virtual bool_t IsWindowMinimized() override;
+			virtual bool_t IsWindowMaximized() override;
+			virtual bool_t IsWindowFocused() override;
+
+			/////////////// EVENTS API /////////////////
+			// one call per frame
+			virtual void PollEvents() override;
+			virtual void WaitEvents() override;
+			virtual void WaitEventsTimeout(float64_t timeout) override;
+
+			////////////////////////////////
+
+			// the window requests to close after frameLimit frames, 0 - no limit
+			void SetFrameLimit(uint32_t frameLimit);
+			uint32_t GetFrameCount() const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(WindowHeadless)
+
+			bool_t mIsVisible;
+
+			uint32_t mFrameLimit;
+			uint32_t mFrameCount;
+		};
+	}
+}
+
+#endif // FOUNDATION_PLATFORM_HEADLESS_PLATFORM_HPP
\ No newline at end of file
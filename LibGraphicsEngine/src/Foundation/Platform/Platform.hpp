@@ -1,10 +1,16 @@
 #ifndef FOUNDATION_PLATFORM_PLATFORM_HPP
 #define FOUNDATION_PLATFORM_PLATFORM_HPP
 
+#include "Core/AppConfig.hpp"
+
 #if defined(_WIN32)
 #include "Foundation/Platform/Win32/Win32Platform.hpp"
 #else
 // other platforms
 #endif // 
 
+#if defined(USE_HEADLESS)
+#include "Foundation/Platform/Headless/HeadlessPlatform.hpp"
+#endif // USE_HEADLESS
+
 #endif // FOUNDATION_PLATFORM_PLATFORM_HPP
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Foundation/Platform/PlatformInternal.hpp"
+#include <cstring> // memset()
 #include <cassert>
 
 using namespace GraphicsEngine;
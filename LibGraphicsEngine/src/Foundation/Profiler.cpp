@@ -0,0 +1,270 @@
+#include "Foundation/Profiler.hpp"
+#include "Foundation/Logger.hpp"
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <algorithm> // std::min()
+#include <cassert>
+
+namespace GraphicsEngine
+{
+	namespace Profiler
+	{
+		struct ZoneRecord
+		{
+			// atomics only so that Collect() can read a ring while its thread writes it, relaxed stores are plain stores
+			std::atomic<const char_t*> pName;
+			std::atomic<uint64_t> beginTime;
+			std::atomic<uint64_t> endTime;
+			std::atomic<uint32_t> depth;
+		};
+
+		struct ThreadRing
+		{
+			explicit ThreadRing(uint32_t id)
+				: records(new ZoneRecord[RING_CAPACITY])
+				, writeIndex(0), endIndex(0), threadId(id), depth(0)
+			{}
+
+			std::unique_ptr<ZoneRecord[]> records;
+			std::atomic<uint64_t> writeIndex; // index of the zone being written
+			std::atomic<uint64_t> endIndex; // number of complete zones
+			uint32_t threadId;
+			uint32_t depth; // owner thread only
+		};
+
+		struct State
+		{
+			State()
+				: startTime(std::chrono::steady_clock::now())
+				, pGPURing(nullptr)
+			{}
+
+			std::chrono::steady_clock::time_point startTime;
+
+			// guards the ring list and the thread names
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadRing>> rings;
+			std::vector<std::string> threadNames;
+
+			ThreadRing* pGPURing;
+		};
+
+		// never destroyed, threads may still record during static destruction, see GetState() in MemoryManager.cpp
+		static State& GetState()
+		{
+			static State* pState = ::new State;
+
+			return *pState;
+		}
+
+		static ThreadRing* AddRing(State& state, const std::string& name)
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+
+			const uint32_t threadId = static_cast<uint32_t>(state.rings.size());
+			state.rings.emplace_back(new ThreadRing(threadId));
+			state.threadNames.emplace_back(name);
+
+			return state.rings.back().get();
+		}
+
+		// the rings outlive their threads, so the zones of finished threads can still be exported
+		static ThreadRing& GetThreadRing()
+		{
+			static thread_local ThreadRing* pRing = nullptr;
+
+			if (nullptr == pRing)
+			{
+				pRing = AddRing(GetState(), std::string());
+			}
+
+			return *pRing;
+		}
+
+		// only the owner thread writes the ring
+		static void WriteZone(ThreadRing& ring, const char_t* pName, uint64_t beginTime, uint64_t endTime, uint32_t depth)
+		{
+			const uint64_t index = ring.endIndex.load(std::memory_order_relaxed);
+
+			// announce the slot before touching it, see Collect()
+			ring.writeIndex.store(index, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			auto& record = ring.records[index & (RING_CAPACITY - 1)];
+			record.pName.store(pName, std::memory_order_relaxed);
+			record.beginTime.store(beginTime, std::memory_order_relaxed);
+			record.endTime.store(endTime, std::memory_order_relaxed);
+			record.depth.store(depth, std::memory_order_relaxed);
+
+			ring.endIndex.store(index + 1, std::memory_order_release);
+		}
+
+		uint64_t GetTime()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - GetState().startTime).count());
+		}
+
+		void SetThreadName(const std::string& name)
+		{
+			const uint32_t threadId = GetThreadRing().threadId;
+
+			auto& state = GetState();
+
+			std::lock_guard<std::mutex> lock(state.mutex);
+			state.threadNames[threadId] = name;
+		}
+
+		uint64_t BeginZone()
+		{
+			GetThreadRing().depth++;
+
+			return GetTime();
+		}
+
+		void EndZone(const char_t* pName, uint64_t beginTime)
+		{
+			const uint64_t endTime = GetTime();
+
+			auto& ring = GetThreadRing();
+			assert(ring.depth > 0);
+			ring.depth--;
+
+			WriteZone(ring, pName, beginTime, endTime, ring.depth);
+		}
+
+		void AddGPUZone(const char_t* pName, uint64_t beginTime, uint64_t endTime, uint32_t depth)
+		{
+			auto& state = GetState();
+
+			if (nullptr == state.pGPURing)
+			{
+				state.pGPURing = AddRing(state, "GPU");
+			}
+
+			WriteZone(*state.pGPURing, pName, beginTime, endTime, depth);
+		}
+
+		void Collect(std::vector<Zone>& zonesOut)
+		{
+			auto& state = GetState();
+
+			std::lock_guard<std::mutex> lock(state.mutex);
+
+			for (const auto& pRing : state.rings)
+			{
+				const auto& ring = *pRing;
+
+				const uint64_t endIndex = ring.endIndex.load(std::memory_order_acquire);
+				const uint64_t beginIndex = (endIndex > RING_CAPACITY) ? (endIndex - RING_CAPACITY) : 0;
+
+				const size_t firstZone = zonesOut.size();
+				for (uint64_t index = beginIndex; index < endIndex; ++index)
+				{
+					const auto& record = ring.records[index & (RING_CAPACITY - 1)];
+
+					Zone zone;
+					zone.pName = record.pName.load(std::memory_order_relaxed);
+					zone.beginTime = record.beginTime.load(std::memory_order_relaxed);
+					zone.endTime = record.endTime.load(std::memory_order_relaxed);
+					zone.depth = record.depth.load(std::memory_order_relaxed);
+					zone.threadId = ring.threadId;
+					zonesOut.push_back(zone);
+				}
+
+				// drop the zones the owner thread overwrote while they were copied
+				std::atomic_thread_fence(std::memory_order_acquire);
+				const uint64_t writeIndex = ring.writeIndex.load(std::memory_order_relaxed);
+				if (writeIndex >= RING_CAPACITY + beginIndex)
+				{
+					const uint64_t overwrittenCount = std::min<uint64_t>(writeIndex - RING_CAPACITY - beginIndex + 1, endIndex - beginIndex);
+					zonesOut.erase(zonesOut.begin() + firstZone, zonesOut.begin() + firstZone + static_cast<size_t>(overwrittenCount));
+				}
+			}
+		}
+
+		void Reset()
+		{
+			auto& state = GetState();
+
+			std::lock_guard<std::mutex> lock(state.mutex);
+
+			// NOTE! Only safe when no other thread is recording
+			for (const auto& pRing : state.rings)
+			{
+				pRing->writeIndex.store(0, std::memory_order_relaxed);
+				pRing->endIndex.store(0, std::memory_order_release);
+			}
+		}
+
+		static void WriteJsonString(std::ofstream& file, const char_t* pString)
+		{
+			file << '"';
+			for (const char_t* pChar = pString; pChar && *pChar; ++pChar)
+			{
+				if ((*pChar == '"') || (*pChar == '\\'))
+				{
+					file << '\\';
+				}
+				file << *pChar;
+			}
+			file << '"';
+		}
+
+		bool_t ExportChromeTrace(const std::string& filePath)
+		{
+			std::vector<Zone> zones;
+			Collect(zones);
+
+			std::vector<std::string> threadNames;
+			{
+				auto& state = GetState();
+
+				std::lock_guard<std::mutex> lock(state.mutex);
+				threadNames = state.threadNames;
+			}
+
+			std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+			if (false == file.is_open())
+			{
+				LOG_ERROR("Failed to open file: %s", filePath.c_str());
+				return false;
+			}
+
+			file.setf(std::ios::fixed);
+			file.precision(3);
+
+			file << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+
+			bool_t isFirst = true;
+			for (uint32_t threadId = 0; threadId < threadNames.size(); ++threadId)
+			{
+				if (threadNames[threadId].empty())
+					continue;
+
+				file << (isFirst ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << threadId << ", \"args\": {\"name\": ";
+				WriteJsonString(file, threadNames[threadId].c_str());
+				file << "}}";
+				isFirst = false;
+			}
+
+			// complete events, the viewers rebuild the hierarchy from the nested time ranges
+			// timestamps are in us
+			for (const auto& zone : zones)
+			{
+				file << (isFirst ? "" : ",\n") << "{\"name\": ";
+				WriteJsonString(file, zone.pName);
+				file << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << zone.threadId
+					<< ", \"ts\": " << zone.beginTime / 1000.0
+					<< ", \"dur\": " << (zone.endTime - zone.beginTime) / 1000.0 << "}";
+				isFirst = false;
+			}
+
+			file << "\n]}\n";
+
+			return file.good();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef FOUNDATION_PROFILER_HPP
+#define FOUNDATION_PROFILER_HPP
+
+#include "Core/AppConfig.hpp"
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include <vector>
+#include <string>
+
+namespace GraphicsEngine
+{
+	/*
+		Hierarchical CPU profiler.
+		Each thread records its zones in its own ring buffer, no locks on the recording path.
+		When the ring is full the oldest zones are overwritten, so a capture always holds the latest frames.
+		Use the GE_PROFILE_* macros, they compile to nothing if ENABLE_PROFILER is not defined.
+	*/
+	namespace Profiler
+	{
+		// zones per thread, must be a power of 2
+		static const uint32_t RING_CAPACITY = 1 << 15;
+
+		struct Zone
+		{
+			Zone()
+				: pName(nullptr), beginTime(0), endTime(0), threadId(0), depth(0)
+			{}
+
+			const char_t* pName; // static string
+			uint64_t beginTime; // ns since the profiler start
+			uint64_t endTime;
+			uint32_t threadId;
+			uint32_t depth; // nesting level, 0 for the outermost zones
+		};
+
+		// ns since the profiler start
+		uint64_t GetTime();
+
+		// name of the calling thread in the exported trace
+		void SetThreadName(const std::string& name);
+
+		// returns the begin time of the zone
+		uint64_t BeginZone();
+		void EndZone(const char_t* pName, uint64_t beginTime);
+
+		// zones of the GPU track, the times must already be converted to the profiler time
+		// NOTE! To be called from the render thread only
+		void AddGPUZone(const char_t* pName, uint64_t beginTime, uint64_t endTime, uint32_t depth);
+
+		// copies the zones still in the rings, ordered by thread then by end time
+		// NOTE! Can be called while the other threads are recording
+		void Collect(std::vector<Zone>& zonesOut);
+		void Reset();
+
+		// Chrome trace event format, to be opened with chrome://tracing or ui.perfetto.dev
+		bool_t ExportChromeTrace(const std::string& filePath);
+
+		class ScopedZone
+		{
+		public:
+			explicit ScopedZone(const char_t* pName)
+				: mpName(pName)
+				, mBeginTime(BeginZone())
+			{}
+
+			~ScopedZone()
+			{
+				EndZone(mpName, mBeginTime);
+			}
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(ScopedZone)
+
+			const char_t* mpName;
+			uint64_t mBeginTime;
+		};
+	}
+}
+
+#ifdef ENABLE_PROFILER
+#define GE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define GE_PROFILE_CONCAT(a, b) GE_PROFILE_CONCAT_IMPL(a, b)
+
+// NOTE! The name must be a string literal, only its pointer is recorded
+#define GE_PROFILE_SCOPE(name) GraphicsEngine::Profiler::ScopedZone GE_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define GE_PROFILE_FUNCTION() GE_PROFILE_SCOPE(__FUNCTION__)
+#define GE_PROFILE_THREAD(name) GraphicsEngine::Profiler::SetThreadName(name)
+#else
+#define GE_PROFILE_SCOPE(name)
+#define GE_PROFILE_FUNCTION()
+#define GE_PROFILE_THREAD(name)
+#endif // ENABLE_PROFILER
+
+#endif /* FOUNDATION_PROFILER_HPP */
\ No newline at end of file
@@ -0,0 +1,678 @@
+#include "Foundation/TaskScheduler.hpp"
+#include "Foundation/Profiler.hpp"
+#include "Foundation/Logger.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <algorithm> // std::min()
+#include <cassert>
+
+namespace GraphicsEngine
+{
+	namespace TaskScheduler
+	{
+		static const uint32_t QUEUE_MASK = QUEUE_CAPACITY - 1;
+		static_assert((QUEUE_CAPACITY & QUEUE_MASK) == 0, "QUEUE_CAPACITY must be a power of 2!");
+
+		// failed attempts to find a task before an idle worker goes to sleep
+		static const uint32_t IDLE_SPIN_COUNT = 64;
+		// spins on a locked counter before yielding
+		static const uint32_t LOCK_SPIN_COUNT = 16;
+
+		// chunks per thread of a ParallelFor without grain size, more chunks balance better uneven iterations
+		static const uint32_t CHUNKS_PER_THREAD = 4;
+
+		struct Task
+		{
+			Task()
+				: pCounter(nullptr)
+				, isFree(true)
+			{}
+
+			TaskFunc func;
+			Counter* pCounter;
+
+			// set by the thread which executed the task, the slot can then be reused by the thread which owns it
+			std::atomic<bool_t> isFree;
+		};
+
+		/*
+			Chase-Lev deque with a fixed capacity.
+			The owner thread pushes and pops at the bottom, the other threads steal from the top.
+			More info: "Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. 2013
+			NOTE! The fences of the paper are replaced with seq_cst operations, the thread sanitizer doesn't support fences
+		*/
+		class TaskDeque
+		{
+		public:
+			TaskDeque()
+				: mTop(0)
+				, mBottom(0)
+			{
+				for (auto& task : mBuffer)
+				{
+					task.store(nullptr, std::memory_order_relaxed);
+				}
+			}
+
+			// owner thread only, returns false if the deque is full
+			bool_t Push(Task* pTask)
+			{
+				const int64_t bottom = mBottom.load(std::memory_order_relaxed);
+				const int64_t top = mTop.load(std::memory_order_acquire);
+
+				if (bottom - top >= static_cast<int64_t>(QUEUE_CAPACITY))
+					return false;
+
+				mBuffer[bottom & QUEUE_MASK].store(pTask, std::memory_order_relaxed);
+				mBottom.store(bottom + 1, std::memory_order_release);
+
+				return true;
+			}
+
+			// owner thread only, the last pushed task
+			Task* Pop()
+			{
+				const int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+				mBottom.store(bottom, std::memory_order_seq_cst);
+
+				int64_t top = mTop.load(std::memory_order_seq_cst);
+				if (top > bottom)
+				{
+					// empty
+					mBottom.store(bottom + 1, std::memory_order_release);
+					return nullptr;
+				}
+
+				Task* pTask = mBuffer[bottom & QUEUE_MASK].load(std::memory_order_relaxed);
+				if (top == bottom)
+				{
+					// the last task, the thieves may take it first
+					if (false == mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					{
+						pTask = nullptr;
+					}
+
+					mBottom.store(bottom + 1, std::memory_order_release);
+				}
+
+				return pTask;
+			}
+
+			// any thread, the first pushed task
+			// returns nullptr if the deque is empty or if another thread took the task first
+			Task* Steal()
+			{
+				int64_t top = mTop.load(std::memory_order_seq_cst);
+				const int64_t bottom = mBottom.load(std::memory_order_seq_cst);
+
+				if (top >= bottom)
+					return nullptr;
+
+				Task* pTask = mBuffer[top & QUEUE_MASK].load(std::memory_order_relaxed);
+				if (false == mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+
+				return pTask;
+			}
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(TaskDeque)
+
+			// separate cache lines, the thieves write top, the owner writes bottom
+			std::atomic<int64_t> mTop;
+			uint8_t mPadding0[64];
+			std::atomic<int64_t> mBottom;
+			uint8_t mPadding1[64];
+			std::atomic<Task*> mBuffer[QUEUE_CAPACITY];
+		};
+
+		// per thread which runs tasks
+		struct ThreadData
+		{
+			ThreadData()
+				: tasks(new Task[QUEUE_CAPACITY])
+				, nextTaskIdx(0)
+			{}
+
+			TaskDeque deque;
+
+			// the task slots, only allocated by the owner thread
+			std::unique_ptr<Task[]> tasks;
+			uint32_t nextTaskIdx;
+		};
+
+		struct State
+		{
+			State()
+				: isRunning(false), isStopRequested(false)
+				, workEpoch(0), sleepingCount(0)
+			{}
+
+			std::atomic<bool_t> isRunning;
+			std::atomic<bool_t> isStopRequested;
+
+			// index 0 - the Init() thread
+			std::vector<std::unique_ptr<ThreadData>> threads;
+			std::vector<std::thread> workers;
+
+			// incremented for each submitted task, the workers don't sleep if it changed since they last looked for a task
+			std::atomic<uint64_t> workEpoch;
+			std::atomic<uint32_t> sleepingCount;
+			std::mutex sleepMutex;
+			std::condition_variable sleepCondition;
+		};
+
+		static State& GetState()
+		{
+			static State state;
+
+			return state;
+		}
+
+		static thread_local int32_t sThreadIndex = -1;
+		static thread_local uint32_t sRandomState = 0;
+
+		// xorshift, picks the first victim of a steal
+		static uint32_t NextRandom()
+		{
+			if (0 == sRandomState)
+			{
+				sRandomState = 0x9E3779B9u * static_cast<uint32_t>(sThreadIndex + 2);
+			}
+
+			sRandomState ^= sRandomState << 13;
+			sRandomState ^= sRandomState >> 17;
+			sRandomState ^= sRandomState << 5;
+
+			return sRandomState;
+		}
+
+		struct CounterAccess
+		{
+			static void Increment(Counter* pCounter) { pCounter->Increment(); }
+			static void Decrement(Counter* pCounter) { pCounter->Decrement(); }
+			static bool_t AddDependent(Counter* pCounter, Task* pTask) { return pCounter->AddDependent(pTask); }
+			static void Lock(const Counter& counter) { counter.Lock(); }
+			static void Unlock(const Counter& counter) { counter.Unlock(); }
+		};
+
+		static void Execute(Task* pTask)
+		{
+			assert(pTask != nullptr);
+
+			pTask->func();
+
+			// releases the captures before the slot is reused
+			pTask->func = nullptr;
+
+			Counter* pCounter = pTask->pCounter;
+			pTask->pCounter = nullptr;
+
+			pTask->isFree.store(true, std::memory_order_release);
+
+			if (pCounter)
+			{
+				CounterAccess::Decrement(pCounter);
+			}
+		}
+
+		static void WakeWorkers(State& state)
+		{
+			state.workEpoch.fetch_add(1);
+
+			// a worker increments sleepingCount before checking workEpoch, so it either sees the new epoch or gets notified
+			if (state.sleepingCount.load() > 0)
+			{
+				{
+					std::lock_guard<std::mutex> lock(state.sleepMutex);
+				}
+
+				state.sleepCondition.notify_one();
+			}
+		}
+
+		static void Submit(Task* pTask)
+		{
+			assert(pTask != nullptr);
+
+			State& state = GetState();
+
+			if ((sThreadIndex < 0) || (false == state.threads[sThreadIndex]->deque.Push(pTask)))
+			{
+				// not a scheduler thread or too many pending tasks
+				Execute(pTask);
+				return;
+			}
+
+			WakeWorkers(state);
+		}
+
+		// returns nullptr if all the slots are used, by the tasks still pending
+		static Task* AllocateTask(ThreadData& threadData)
+		{
+			for (uint32_t i = 0; i < QUEUE_CAPACITY; ++i)
+			{
+				const uint32_t taskIdx = (threadData.nextTaskIdx + i) & QUEUE_MASK;
+
+				Task& task = threadData.tasks[taskIdx];
+				if (task.isFree.load(std::memory_order_acquire))
+				{
+					task.isFree.store(false, std::memory_order_relaxed);
+					threadData.nextTaskIdx = taskIdx + 1;
+
+					return &task;
+				}
+			}
+
+			return nullptr;
+		}
+
+		static Task* Steal(State& state)
+		{
+			const uint32_t threadCount = static_cast<uint32_t>(state.threads.size());
+			const uint32_t firstIdx = NextRandom() % threadCount;
+
+			for (uint32_t i = 0; i < threadCount; ++i)
+			{
+				const uint32_t threadIdx = (firstIdx + i) % threadCount;
+				if (static_cast<int32_t>(threadIdx) == sThreadIndex)
+					continue;
+
+				Task* pTask = state.threads[threadIdx]->deque.Steal();
+				if (pTask)
+					return pTask;
+			}
+
+			return nullptr;
+		}
+
+		// own tasks first, newest first, then the oldest tasks of the others
+		static bool_t ExecuteOne(State& state)
+		{
+			if (false == state.isRunning.load(std::memory_order_acquire))
+				return false;
+
+			Task* pTask = nullptr;
+			if (sThreadIndex >= 0)
+			{
+				pTask = state.threads[sThreadIndex]->deque.Pop();
+			}
+
+			if (nullptr == pTask)
+			{
+				pTask = Steal(state);
+			}
+
+			if (nullptr == pTask)
+				return false;
+
+			Execute(pTask);
+
+			return true;
+		}
+
+		static void WorkerMain(int32_t threadIndex)
+		{
+			sThreadIndex = threadIndex;
+
+			GE_PROFILE_THREAD("Worker " + std::to_string(threadIndex));
+
+			State& state = GetState();
+
+			uint32_t idleCount = 0;
+			while (true)
+			{
+				// before looking for a task, see WakeWorkers()
+				const uint64_t epoch = state.workEpoch.load();
+
+				if (ExecuteOne(state))
+				{
+					idleCount = 0;
+					continue;
+				}
+
+				// stops only when there is nothing left to execute
+				if (state.isStopRequested.load())
+					break;
+
+				if (++idleCount < IDLE_SPIN_COUNT)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(state.sleepMutex);
+
+				state.sleepingCount.fetch_add(1);
+				state.sleepCondition.wait(lock, [&state, epoch]()
+					{
+						return (state.workEpoch.load() != epoch) || state.isStopRequested.load();
+					});
+				state.sleepingCount.fetch_sub(1);
+
+				idleCount = 0;
+			}
+
+			sThreadIndex = -1;
+		}
+
+		///////////////////////////////////////////////////
+
+		Counter::Counter()
+			: mCount(0)
+			, mIsLocked(false)
+		{}
+
+		Counter::~Counter()
+		{
+			assert(IsDone());
+			assert(mDependents.empty());
+		}
+
+		bool_t Counter::IsDone() const
+		{
+			return (mCount.load(std::memory_order_acquire) == 0);
+		}
+
+		void Counter::Increment()
+		{
+			mCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void Counter::Decrement()
+		{
+			std::vector<Task*> dependents;
+
+			uint32_t count = mCount.load(std::memory_order_relaxed);
+			while (true)
+			{
+				assert(count > 0);
+
+				if (count > 1)
+				{
+					// the counter is not touched after this
+					if (mCount.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+						return;
+
+					continue;
+				}
+
+				// the last task, reaches 0 under the lock so no dependent is missed
+				Lock();
+
+				const bool_t isLast = mCount.compare_exchange_strong(count, 0, std::memory_order_acq_rel, std::memory_order_relaxed);
+				if (isLast)
+				{
+					dependents.swap(mDependents);
+				}
+
+				Unlock();
+
+				if (isLast)
+					break;
+			}
+
+			// the counter may be destroyed at this point
+			for (auto* pTask : dependents)
+			{
+				Submit(pTask);
+			}
+		}
+
+		bool_t Counter::AddDependent(Task* pTask)
+		{
+			assert(pTask != nullptr);
+
+			Lock();
+
+			const bool_t isPending = (false == IsDone());
+			if (isPending)
+			{
+				mDependents.push_back(pTask);
+			}
+
+			Unlock();
+
+			return isPending;
+		}
+
+		void Counter::Lock() const
+		{
+			uint32_t spinCount = 0;
+			while (mIsLocked.exchange(true, std::memory_order_acquire))
+			{
+				if (++spinCount >= LOCK_SPIN_COUNT)
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		void Counter::Unlock() const
+		{
+			mIsLocked.store(false, std::memory_order_release);
+		}
+
+		///////////////////////////////////////////////////
+
+		void Init(uint32_t workerCount)
+		{
+			State& state = GetState();
+
+			if (state.isRunning.load())
+			{
+				LOG_WARNING("Task scheduler already running!");
+				return;
+			}
+
+			if (0 == workerCount)
+			{
+				const uint32_t coreCount = std::thread::hardware_concurrency();
+				workerCount = (coreCount > 1) ? (coreCount - 1) : 1;
+			}
+
+			state.isStopRequested.store(false);
+
+			for (uint32_t i = 0; i <= workerCount; ++i)
+			{
+				state.threads.emplace_back(new ThreadData);
+			}
+
+			sThreadIndex = 0;
+
+			state.isRunning.store(true, std::memory_order_release);
+
+			for (uint32_t i = 1; i <= workerCount; ++i)
+			{
+				state.workers.emplace_back(WorkerMain, static_cast<int32_t>(i));
+			}
+
+			LOG_INFO("Task scheduler started with %u workers", workerCount);
+		}
+
+		void Terminate()
+		{
+			State& state = GetState();
+
+			if (false == state.isRunning.load())
+				return;
+
+			assert(0 == sThreadIndex);
+
+			state.isStopRequested.store(true);
+			{
+				std::lock_guard<std::mutex> lock(state.sleepMutex);
+			}
+			state.sleepCondition.notify_all();
+
+			for (auto& worker : state.workers)
+			{
+				worker.join();
+			}
+			state.workers.clear();
+
+			// what the workers left in our deque
+			while (ExecuteOne(state))
+			{}
+
+			state.isRunning.store(false, std::memory_order_release);
+			state.threads.clear();
+
+			sThreadIndex = -1;
+
+			LOG_INFO("Task scheduler stopped");
+		}
+
+		bool_t IsRunning()
+		{
+			return GetState().isRunning.load(std::memory_order_acquire);
+		}
+
+		uint32_t GetWorkerCount()
+		{
+			return static_cast<uint32_t>(GetState().workers.size());
+		}
+
+		uint32_t GetThreadCount()
+		{
+			return GetWorkerCount() + 1;
+		}
+
+		int32_t GetThreadIndex()
+		{
+			return sThreadIndex;
+		}
+
+		void Run(const TaskFunc& func, Counter* pCounter, Counter* pDependency)
+		{
+			assert(func);
+
+			if (pCounter)
+			{
+				CounterAccess::Increment(pCounter);
+			}
+
+			Task* pTask = nullptr;
+			if (sThreadIndex >= 0)
+			{
+				pTask = AllocateTask(*GetState().threads[sThreadIndex]);
+			}
+
+			if (nullptr == pTask)
+			{
+				// not a scheduler thread or too many pending tasks, executed inline
+				if (pDependency)
+				{
+					Wait(*pDependency);
+				}
+
+				func();
+
+				if (pCounter)
+				{
+					CounterAccess::Decrement(pCounter);
+				}
+
+				return;
+			}
+
+			pTask->func = func;
+			pTask->pCounter = pCounter;
+
+			// submitted by the last task of the dependency
+			if (pDependency && CounterAccess::AddDependent(pDependency, pTask))
+				return;
+
+			Submit(pTask);
+		}
+
+		void Wait(Counter& counter)
+		{
+			State& state = GetState();
+
+			while (false == counter.IsDone())
+			{
+				if (false == ExecuteOne(state))
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			// the last decrement may still hold the lock, the counter can be destroyed after it releases it
+			CounterAccess::Lock(counter);
+			CounterAccess::Unlock(counter);
+		}
+
+		struct ParallelForData
+		{
+			uint32_t begin;
+			uint32_t end;
+			uint32_t grainSize;
+			uint32_t chunkCount;
+			std::atomic<uint32_t> nextChunkIdx;
+			const RangeFunc* pFunc;
+		};
+
+		static void ExecuteChunks(ParallelForData& data)
+		{
+			uint32_t chunkIdx = 0;
+			while ((chunkIdx = data.nextChunkIdx.fetch_add(1, std::memory_order_relaxed)) < data.chunkCount)
+			{
+				const uint32_t chunkBegin = data.begin + chunkIdx * data.grainSize;
+				const uint32_t chunkEnd = (data.end - chunkBegin > data.grainSize) ? (chunkBegin + data.grainSize) : data.end;
+
+				(*data.pFunc)(chunkBegin, chunkEnd);
+			}
+		}
+
+		void ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const RangeFunc& func)
+		{
+			assert(func);
+
+			if (begin >= end)
+				return;
+
+			const uint32_t count = end - begin;
+			const uint32_t threadCount = IsRunning() ? GetThreadCount() : 1;
+
+			if (0 == grainSize)
+			{
+				grainSize = std::max<uint32_t>(1, count / (threadCount * CHUNKS_PER_THREAD));
+			}
+
+			const uint32_t chunkCount = (count / grainSize) + ((count % grainSize) ? 1 : 0);
+
+			// nothing to split or nobody to share with
+			if ((1 == chunkCount) || (1 == threadCount) || (sThreadIndex < 0))
+			{
+				func(begin, end);
+				return;
+			}
+
+			ParallelForData data;
+			data.begin = begin;
+			data.end = end;
+			data.grainSize = grainSize;
+			data.chunkCount = chunkCount;
+			data.nextChunkIdx.store(0, std::memory_order_relaxed);
+			data.pFunc = &func;
+
+			ParallelForData* pData = &data;
+
+			// the late tasks find no chunk left and return
+			Counter counter;
+			const uint32_t taskCount = std::min(chunkCount, threadCount) - 1;
+			for (uint32_t i = 0; i < taskCount; ++i)
+			{
+				Run([pData]() { ExecuteChunks(*pData); }, &counter);
+			}
+
+			ExecuteChunks(data);
+
+			Wait(counter);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef FOUNDATION_TASK_SCHEDULER_HPP
+#define FOUNDATION_TASK_SCHEDULER_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include <atomic>
+#include <vector>
+#include <functional>
+
+namespace GraphicsEngine
+{
+	/*
+		Work stealing task scheduler.
+		A fixed pool of worker threads, each thread pushes and pops its tasks at the bottom of its own deque (Chase-Lev),
+		the idle threads steal from the top of the others. The thread which called Init() is thread 0 and runs tasks
+		only while it waits, see Wait().
+		The tasks run from other threads, or before Init() and after Terminate(), are executed inline.
+	*/
+	namespace TaskScheduler
+	{
+		// tasks per thread, must be a power of 2
+		// when a thread has this many tasks pending, the next ones are executed inline
+		static const uint32_t QUEUE_CAPACITY = 1 << 12;
+
+		typedef std::function<void()> TaskFunc;
+		// [begin, end) range of a ParallelFor
+		typedef std::function<void(uint32_t, uint32_t)> RangeFunc;
+
+		struct Task;
+		struct CounterAccess;
+
+		/*
+			Counts the pending tasks run with it. The tasks run after it (see Run()) are started when it reaches 0.
+			NOTE! Wait() for it before destroying it. The dependent tasks must be run after the tasks they depend on.
+		*/
+		class Counter
+		{
+		public:
+			Counter();
+			~Counter();
+
+			bool_t IsDone() const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(Counter)
+
+			friend struct CounterAccess;
+
+			void Increment();
+			void Decrement();
+
+			// returns false if the counter is already done, the task must be started by the caller
+			bool_t AddDependent(Task* pTask);
+
+			void Lock() const;
+			void Unlock() const;
+
+			std::atomic<uint32_t> mCount;
+
+			// guards the dependent tasks, also held for the last decrement so Wait() can't return before it is complete
+			mutable std::atomic<bool_t> mIsLocked;
+			std::vector<Task*> mDependents;
+		};
+
+		// workerCount - 0 to use one worker per core, besides the calling thread
+		void Init(uint32_t workerCount = 0);
+		// waits for the running tasks, the queued tasks are executed before the workers stop
+		void Terminate();
+
+		bool_t IsRunning();
+
+		uint32_t GetWorkerCount();
+		// threads which run tasks, the workers and the Init() thread
+		uint32_t GetThreadCount();
+		// 0 for the Init() thread, 1..GetWorkerCount() for the workers, -1 for the others
+		int32_t GetThreadIndex();
+
+		// pCounter - incremented now, decremented when the task is complete
+		// pDependency - the task starts when it is done
+		void Run(const TaskFunc& func, Counter* pCounter = nullptr, Counter* pDependency = nullptr);
+
+		// helping wait - the calling thread executes tasks, any of them, until the counter is done
+		void Wait(Counter& counter);
+
+		// calls func for the [begin, end) range split in chunks of grainSize, returns when all are complete
+		// the chunks are claimed in order by the calling thread and by at most one task per worker
+		// grainSize - 0 to split the range in a few chunks per thread
+		void ParallelFor(uint32_t begin, uint32_t end, uint32_t grainSize, const RangeFunc& func);
+	}
+}
+#endif /* FOUNDATION_TASK_SCHEDULER_HPP */
\ No newline at end of file
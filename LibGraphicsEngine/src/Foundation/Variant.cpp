@@ -1,5 +1,6 @@
 #include "Foundation/Variant.hpp"
 #include <utility> //std::move(), std::swap()
+#include <cstring> // memset()
 
 using namespace GraphicsEngine;
 
@@ -0,0 +1,86 @@
+#include "Graphics/Cameras/Frustum.hpp"
+#include "glm/geometric.hpp"
+#include "glm/matrix.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+
+Frustum::Frustum()
+{
+	// everything is inside by default
+	for (auto& plane : mPlanes)
+	{
+		plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+Frustum::Frustum(const glm::mat4& projectionView)
+	: Frustum()
+{
+	Update(projectionView);
+}
+
+Frustum::~Frustum()
+{}
+
+void Frustum::Update(const glm::mat4& projectionView)
+{
+	// glm is column major - the rows of the matrix are the rows of the transposed one
+	const glm::mat4 m = glm::transpose(projectionView);
+
+	mPlanes[static_cast<uint8_t>(Plane::GE_FP_LEFT)] = m[3] + m[0];
+	mPlanes[static_cast<uint8_t>(Plane::GE_FP_RIGHT)] = m[3] - m[0];
+	mPlanes[static_cast<uint8_t>(Plane::GE_FP_BOTTOM)] = m[3] + m[1];
+	mPlanes[static_cast<uint8_t>(Plane::GE_FP_TOP)] = m[3] - m[1];
+#if defined(GLM_FORCE_DEPTH_ZERO_TO_ONE)
+	// clip space depth in [0, w]
+	mPlanes[static_cast<uint8_t>(Plane::GE_FP_NEAR)] = m[2];
+#else
+	// clip space depth in [-w, w]
+	mPlanes[static_cast<uint8_t>(Plane::GE_FP_NEAR)] = m[3] + m[2];
+#endif // GLM_FORCE_DEPTH_ZERO_TO_ONE
+	mPlanes[static_cast<uint8_t>(Plane::GE_FP_FAR)] = m[3] - m[2];
+
+	for (auto& plane : mPlanes)
+	{
+		const float32_t length = glm::length(glm::vec3(plane));
+		if (length > 0.0f)
+		{
+			plane /= length;
+		}
+	}
+}
+
+bool_t Frustum::IntersectsSphere(const glm::vec3& center, float32_t radius) const
+{
+	for (const auto& plane : mPlanes)
+	{
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+			return false;
+	}
+
+	return true;
+}
+
+bool_t Frustum::IntersectsAABB(const glm::vec3& min, const glm::vec3& max) const
+{
+	for (const auto& plane : mPlanes)
+	{
+		// the box corner furthest along the plane normal
+		const glm::vec3 positiveVertex((plane.x >= 0.0f) ? max.x : min.x, (plane.y >= 0.0f) ? max.y : min.y, (plane.z >= 0.0f) ? max.z : min.z);
+
+		if (glm::dot(glm::vec3(plane), positiveVertex) + plane.w < 0.0f)
+			return false;
+	}
+
+	return true;
+}
+
+const glm::vec4& Frustum::GetPlane(Frustum::Plane plane) const
+{
+	assert(plane < Plane::GE_FP_COUNT);
+
+	return mPlanes[static_cast<uint8_t>(plane)];
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef GRAPHICS_CAMERAS_FRUSTUM_HPP
+#define GRAPHICS_CAMERAS_FRUSTUM_HPP
+
+#include "Core/AppConfig.hpp"
+#include "Foundation/TypeDefines.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/*
+			View frustum as 6 planes extracted from a projection * view (* model) matrix.
+			The planes live in the space the matrix transforms from, e.g. projection * view * model -> model space planes.
+			Plane equation: dot(plane.xyz, p) + plane.w >= 0 for points inside, the normals point inwards.
+			based on: Gribb & Hartmann - Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix
+		*/
+		class Frustum
+		{
+		public:
+			enum class Plane : uint8_t
+			{
+				GE_FP_LEFT = 0,
+				GE_FP_RIGHT,
+				GE_FP_BOTTOM,
+				GE_FP_TOP,
+				GE_FP_NEAR,
+				GE_FP_FAR,
+				GE_FP_COUNT
+			};
+
+			Frustum();
+			explicit Frustum(const glm::mat4& projectionView);
+			~Frustum();
+
+			void Update(const glm::mat4& projectionView);
+
+			// conservative tests - may return true for volumes just outside the frustum corners
+			bool_t IntersectsSphere(const glm::vec3& center, float32_t radius) const;
+			bool_t IntersectsAABB(const glm::vec3& min, const glm::vec3& max) const;
+
+			const glm::vec4& GetPlane(Frustum::Plane plane) const;
+
+		private:
+			glm::vec4 mPlanes[static_cast<uint8_t>(Plane::GE_FP_COUNT)];
+		};
+	}
+}
+
+#endif // GRAPHICS_CAMERAS_FRUSTUM_HPP
\ No newline at end of file
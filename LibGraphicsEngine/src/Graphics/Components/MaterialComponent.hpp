@@ -13,6 +13,7 @@ namespace GraphicsEngine
 		class MaterialComponent : public VisualComponent
 		{
 			GE_RTTI(GraphicsEngine::Graphics::MaterialComponent)
+			GE_POOLED_OBJECT(MaterialComponent)
 
 		public:
 			MaterialComponent();
@@ -2,6 +2,7 @@
 #define GRAPHICS_COMPONENTS_NODE_COMPONENT_HPP
 
 #include "Foundation/Object.hpp"
+#include "Foundation/MemoryManagement/ObjectPool.hpp"
 #include <string>
 
 namespace GraphicsEngine
@@ -14,6 +15,7 @@ namespace GraphicsEngine
 		class NodeComponent : public Object
 		{
 			GE_RTTI(GraphicsEngine::Graphics::NodeComponent)
+			GE_POOLED_OBJECT(NodeComponent)
 
 		public:
 			NodeComponent();
@@ -16,6 +16,7 @@ namespace GraphicsEngine
 		class VisualComponent : public NodeComponent
 		{
 			GE_RTTI(GraphicsEngine::Graphics::VisualComponent)
+			GE_POOLED_OBJECT(VisualComponent)
 
 		public:
 			VisualComponent();
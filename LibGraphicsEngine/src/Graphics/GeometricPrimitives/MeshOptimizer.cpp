@@ -0,0 +1,608 @@
+#include "Graphics/GeometricPrimitives/MeshOptimizer.hpp"
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "Graphics/Rendering/Resources/VertexFormat.hpp"
+#include "Graphics/Rendering/Resources/VertexBuffer.hpp"
+#include "Graphics/Rendering/Resources/IndexBuffer.hpp"
+#include "Foundation/HashUtils.hpp"
+#include "Foundation/Logger.hpp"
+#include "glm/vec3.hpp"
+#include "glm/geometric.hpp"
+#include <vector>
+#include <algorithm> // std::stable_sort()
+#include <cmath> // std::pow()
+#include <cstring> // ::memcpy(), ::memcmp()
+#include <cassert>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		namespace MeshOptimizer
+		{
+			// Forsyth scoring constants, see: https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+			static const uint32_t FORSYTH_CACHE_SIZE = 32;
+			static const float32_t FORSYTH_CACHE_DECAY_POWER = 1.5f;
+			static const float32_t FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+			static const float32_t FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+			static const float32_t FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+			static const uint32_t INVALID_INDEX = ~0u;
+
+			static float32_t VertexScore(int32_t cachePosition, uint32_t remainingTriangles)
+			{
+				if (remainingTriangles == 0)
+				{
+					// no triangle needs this vertex anymore
+					return -1.0f;
+				}
+
+				float32_t score = 0.0f;
+				if (cachePosition >= 0)
+				{
+					if (cachePosition < 3)
+					{
+						// the vertex was used in the last triangle, fixed score so that
+						// the next triangle does not prefer a specific strip direction
+						score = FORSYTH_LAST_TRIANGLE_SCORE;
+					}
+					else
+					{
+						const float32_t scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+						score = std::pow(1.0f - (cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+					}
+				}
+
+				// boost vertices with few triangles left, so that lone triangles are not left behind
+				score += FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float32_t>(remainingTriangles), -FORSYTH_VALENCE_BOOST_POWER);
+
+				return score;
+			}
+
+			static glm::vec3 GetPosition(const void* pVertices, uint32_t vertexStride, uint32_t positionOffset, uint32_t index)
+			{
+				glm::vec3 position;
+				::memcpy(&position.x, static_cast<const uint8_t*>(pVertices) + static_cast<size_t>(index) * vertexStride + positionOffset, sizeof(glm::vec3));
+
+				return position;
+			}
+
+			// FIFO cache simulation, returns number of misses of the given triangle range
+			// NOTE! timestamps based, so the cache can be flushed by just advancing the timestamp
+			static uint32_t SimulateCache(const uint32_t* pIndices, uint32_t firstTriangle, uint32_t lastTriangle, uint32_t cacheSize,
+				std::vector<uint32_t>& timestamps, uint32_t& timestamp)
+			{
+				uint32_t misses = 0;
+				for (uint32_t i = firstTriangle * 3; i < lastTriangle * 3; ++i)
+				{
+					const uint32_t index = pIndices[i];
+					if (timestamp - timestamps[index] > cacheSize)
+					{
+						timestamps[index] = timestamp++;
+						++misses;
+					}
+				}
+
+				return misses;
+			}
+
+			static uint32_t GetMaxIndex(const uint32_t* pIndices, uint32_t indexCount)
+			{
+				uint32_t maxIndex = 0;
+				for (uint32_t i = 0; i < indexCount; ++i)
+				{
+					maxIndex = std::max(maxIndex, pIndices[i]);
+				}
+
+				return maxIndex;
+			}
+
+			CacheStatistics AnalyzeVertexCache(const uint32_t* pIndices, uint32_t indexCount, uint32_t cacheSize)
+			{
+				assert(pIndices != nullptr);
+				assert(indexCount % 3 == 0);
+				assert(cacheSize > 0);
+
+				CacheStatistics stats;
+				if (indexCount == 0)
+				{
+					return stats;
+				}
+
+				const uint32_t maxIndex = GetMaxIndex(pIndices, indexCount);
+
+				std::vector<uint32_t> timestamps(maxIndex + 1, 0);
+				uint32_t timestamp = cacheSize + 1;
+
+				stats.vertexTransformCount = SimulateCache(pIndices, 0, indexCount / 3, cacheSize, timestamps, timestamp);
+
+				uint32_t uniqueVertexCount = 0;
+				for (auto stamp : timestamps)
+				{
+					uniqueVertexCount += (stamp > 0) ? 1 : 0;
+				}
+
+				stats.acmr = static_cast<float32_t>(stats.vertexTransformCount) / (indexCount / 3);
+				stats.atvr = static_cast<float32_t>(stats.vertexTransformCount) / uniqueVertexCount;
+
+				return stats;
+			}
+
+			uint32_t DeduplicateVertices(const void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t* pIndices, uint32_t indexCount)
+			{
+				assert(pVertices != nullptr);
+				assert(pIndices != nullptr);
+				assert(vertexStride > 0);
+
+				const uint8_t* pData = static_cast<const uint8_t*>(pVertices);
+
+				// open addressing hash table, power of 2 size, at most 50% load
+				uint32_t tableSize = 1;
+				while (tableSize < vertexCount * 2)
+				{
+					tableSize <<= 1;
+				}
+				std::vector<uint32_t> table(tableSize, INVALID_INDEX);
+				std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+
+				uint32_t uniqueVertexCount = 0;
+				for (uint32_t v = 0; v < vertexCount; ++v)
+				{
+					const uint8_t* pVertex = pData + static_cast<size_t>(v) * vertexStride;
+
+					uint32_t slot = static_cast<uint32_t>(HashUtils::HashBytes(pVertex, vertexStride)) & (tableSize - 1);
+					while (table[slot] != INVALID_INDEX)
+					{
+						if (::memcmp(pData + static_cast<size_t>(table[slot]) * vertexStride, pVertex, vertexStride) == 0)
+						{
+							break;
+						}
+						slot = (slot + 1) & (tableSize - 1); // linear probing
+					}
+
+					if (table[slot] == INVALID_INDEX)
+					{
+						table[slot] = v;
+						++uniqueVertexCount;
+					}
+					remap[v] = table[slot];
+				}
+
+				for (uint32_t i = 0; i < indexCount; ++i)
+				{
+					assert(pIndices[i] < vertexCount);
+
+					pIndices[i] = remap[pIndices[i]];
+				}
+
+				return uniqueVertexCount;
+			}
+
+			void OptimizeVertexCache(uint32_t* pIndices, uint32_t indexCount)
+			{
+				assert(pIndices != nullptr);
+				assert(indexCount % 3 == 0);
+
+				const uint32_t triangleCount = indexCount / 3;
+				if (triangleCount == 0)
+				{
+					return;
+				}
+
+				// work on the referenced vertex range only, so sub ranges of a big buffer stay cheap
+				uint32_t minIndex = pIndices[0], maxIndex = pIndices[0];
+				for (uint32_t i = 0; i < indexCount; ++i)
+				{
+					minIndex = std::min(minIndex, pIndices[i]);
+					maxIndex = std::max(maxIndex, pIndices[i]);
+				}
+				const uint32_t vertexCount = maxIndex - minIndex + 1;
+
+				// vertex -> triangles adjacency
+				std::vector<uint32_t> remainingTriangles(vertexCount, 0);
+				for (uint32_t i = 0; i < indexCount; ++i)
+				{
+					remainingTriangles[pIndices[i] - minIndex]++;
+				}
+
+				std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+				for (uint32_t v = 0; v < vertexCount; ++v)
+				{
+					adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remainingTriangles[v];
+				}
+
+				std::vector<uint32_t> adjacency(indexCount);
+				{
+					std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+					for (uint32_t t = 0; t < triangleCount; ++t)
+					{
+						for (uint32_t k = 0; k < 3; ++k)
+						{
+							adjacency[fill[pIndices[t * 3 + k] - minIndex]++] = t;
+						}
+					}
+				}
+
+				std::vector<int32_t> cachePositions(vertexCount, -1);
+				std::vector<float32_t> vertexScores(vertexCount);
+				for (uint32_t v = 0; v < vertexCount; ++v)
+				{
+					vertexScores[v] = VertexScore(-1, remainingTriangles[v]);
+				}
+
+				std::vector<float32_t> triangleScores(triangleCount);
+				std::vector<bool_t> isEmitted(triangleCount, false);
+
+				uint32_t bestTriangle = 0;
+				for (uint32_t t = 0; t < triangleCount; ++t)
+				{
+					const uint32_t* pTriangle = &pIndices[t * 3];
+					triangleScores[t] = vertexScores[pTriangle[0] - minIndex] + vertexScores[pTriangle[1] - minIndex] + vertexScores[pTriangle[2] - minIndex];
+
+					if (triangleScores[t] > triangleScores[bestTriangle])
+					{
+						bestTriangle = t;
+					}
+				}
+
+				// +3 as the new triangle is pushed before the old entries are evicted
+				uint32_t cache[FORSYTH_CACHE_SIZE + 3];
+				uint32_t cacheCount = 0;
+
+				std::vector<uint32_t> result(indexCount);
+				uint32_t inputCursor = 0;
+
+				for (uint32_t emitCount = 0; emitCount < triangleCount; ++emitCount)
+				{
+					if (bestTriangle == INVALID_INDEX)
+					{
+						// dead end, continue with the next triangle left in input order
+						while (isEmitted[inputCursor])
+						{
+							++inputCursor;
+						}
+						bestTriangle = inputCursor;
+					}
+
+					const uint32_t triangle[3] = { pIndices[bestTriangle * 3 + 0] - minIndex, pIndices[bestTriangle * 3 + 1] - minIndex, pIndices[bestTriangle * 3 + 2] - minIndex };
+
+					result[emitCount * 3 + 0] = triangle[0] + minIndex;
+					result[emitCount * 3 + 1] = triangle[1] + minIndex;
+					result[emitCount * 3 + 2] = triangle[2] + minIndex;
+					isEmitted[bestTriangle] = true;
+
+					// remove the triangle from the adjacency of its vertices
+					for (uint32_t k = 0; k < 3; ++k)
+					{
+						const uint32_t v = triangle[k];
+						uint32_t* pAdjacency = &adjacency[adjacencyOffsets[v]];
+						const uint32_t count = remainingTriangles[v];
+
+						for (uint32_t a = 0; a < count; ++a)
+						{
+							if (pAdjacency[a] == bestTriangle)
+							{
+								pAdjacency[a] = pAdjacency[count - 1];
+								break;
+							}
+						}
+						remainingTriangles[v]--;
+					}
+
+					// LRU update - triangle vertices first, followed by the old entries
+					uint32_t newCache[FORSYTH_CACHE_SIZE + 3];
+					uint32_t newCacheCount = 0;
+					for (uint32_t k = 0; k < 3; ++k)
+					{
+						// degenerate triangles may reference the same vertex twice
+						if ((k == 0) || ((k == 1) && (triangle[1] != triangle[0])) || ((k == 2) && (triangle[2] != triangle[0]) && (triangle[2] != triangle[1])))
+						{
+							newCache[newCacheCount++] = triangle[k];
+						}
+					}
+					for (uint32_t c = 0; c < cacheCount; ++c)
+					{
+						const uint32_t v = cache[c];
+						if ((v != triangle[0]) && (v != triangle[1]) && (v != triangle[2]))
+						{
+							newCache[newCacheCount++] = v;
+						}
+					}
+
+					// update vertex scores, evicted vertices are updated too
+					for (uint32_t c = 0; c < newCacheCount; ++c)
+					{
+						const uint32_t v = newCache[c];
+						cachePositions[v] = (c < FORSYTH_CACHE_SIZE) ? static_cast<int32_t>(c) : -1;
+						vertexScores[v] = VertexScore(cachePositions[v], remainingTriangles[v]);
+					}
+
+					// update the adjacent triangles scores and pick the next best one
+					bestTriangle = INVALID_INDEX;
+					float32_t bestScore = -1.0f;
+					for (uint32_t c = 0; c < newCacheCount; ++c)
+					{
+						const uint32_t v = newCache[c];
+						const uint32_t* pAdjacency = &adjacency[adjacencyOffsets[v]];
+
+						for (uint32_t a = 0; a < remainingTriangles[v]; ++a)
+						{
+							const uint32_t t = pAdjacency[a];
+							const uint32_t* pTriangle = &pIndices[t * 3];
+
+							triangleScores[t] = vertexScores[pTriangle[0] - minIndex] + vertexScores[pTriangle[1] - minIndex] + vertexScores[pTriangle[2] - minIndex];
+
+							// ties are broken by the input order to keep the output deterministic
+							if ((triangleScores[t] > bestScore) || ((triangleScores[t] == bestScore) && (t < bestTriangle)))
+							{
+								bestScore = triangleScores[t];
+								bestTriangle = t;
+							}
+						}
+					}
+
+					cacheCount = std::min(newCacheCount, FORSYTH_CACHE_SIZE);
+					::memcpy(cache, newCache, cacheCount * sizeof(uint32_t));
+				}
+
+				::memcpy(pIndices, result.data(), indexCount * sizeof(uint32_t));
+			}
+
+			void OptimizeOverdraw(uint32_t* pIndices, uint32_t indexCount, const void* pVertices, uint32_t vertexStride, uint32_t positionOffset, float32_t threshold)
+			{
+				assert(pIndices != nullptr);
+				assert(pVertices != nullptr);
+				assert(indexCount % 3 == 0);
+
+				const uint32_t triangleCount = indexCount / 3;
+				if (triangleCount == 0)
+				{
+					return;
+				}
+
+				const uint32_t maxIndex = GetMaxIndex(pIndices, indexCount);
+				std::vector<uint32_t> timestamps(maxIndex + 1, 0);
+				uint32_t timestamp = DEFAULT_CACHE_SIZE + 1;
+
+				// hard boundaries - the cache is fully missed by a triangle, so cutting here costs nothing
+				std::vector<uint32_t> hardClusters(1, 0);
+				SimulateCache(pIndices, 0, 1, DEFAULT_CACHE_SIZE, timestamps, timestamp);
+				for (uint32_t t = 1; t < triangleCount; ++t)
+				{
+					if (SimulateCache(pIndices, t, t + 1, DEFAULT_CACHE_SIZE, timestamps, timestamp) == 3)
+					{
+						hardClusters.push_back(t);
+					}
+				}
+				hardClusters.push_back(triangleCount);
+
+				// soft boundaries - split the hard clusters further while the cache efficiency is kept within the threshold
+				std::vector<uint32_t> clusters;
+				for (size_t c = 0; c + 1 < hardClusters.size(); ++c)
+				{
+					const uint32_t start = hardClusters[c];
+					const uint32_t end = hardClusters[c + 1];
+
+					timestamp += DEFAULT_CACHE_SIZE + 1; // flush
+					const uint32_t clusterMisses = SimulateCache(pIndices, start, end, DEFAULT_CACHE_SIZE, timestamps, timestamp);
+					const float32_t clusterThreshold = threshold * (static_cast<float32_t>(clusterMisses) / (end - start));
+
+					clusters.push_back(start);
+
+					timestamp += DEFAULT_CACHE_SIZE + 1; // flush
+					uint32_t runningMisses = 0, runningStart = start;
+					for (uint32_t t = start; t < end; ++t)
+					{
+						runningMisses += SimulateCache(pIndices, t, t + 1, DEFAULT_CACHE_SIZE, timestamps, timestamp);
+
+						if ((t + 1 < end) && (static_cast<float32_t>(runningMisses) / (t + 1 - runningStart) <= clusterThreshold))
+						{
+							clusters.push_back(t + 1);
+
+							timestamp += DEFAULT_CACHE_SIZE + 1; // flush
+							runningMisses = 0;
+							runningStart = t + 1;
+						}
+					}
+				}
+				clusters.push_back(triangleCount);
+
+				const uint32_t clusterCount = static_cast<uint32_t>(clusters.size() - 1);
+
+				// mesh centroid
+				glm::vec3 meshCentroid(0.0f);
+				for (uint32_t i = 0; i < indexCount; ++i)
+				{
+					meshCentroid += GetPosition(pVertices, vertexStride, positionOffset, pIndices[i]);
+				}
+				meshCentroid /= static_cast<float32_t>(indexCount);
+
+				// sort key - how much the cluster faces away from the center, such clusters are likely occluders
+				std::vector<float32_t> sortKeys(clusterCount);
+				for (uint32_t c = 0; c < clusterCount; ++c)
+				{
+					glm::vec3 centroid(0.0f), normal(0.0f);
+					float32_t area = 0.0f;
+
+					for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t)
+					{
+						const glm::vec3 p0 = GetPosition(pVertices, vertexStride, positionOffset, pIndices[t * 3 + 0]);
+						const glm::vec3 p1 = GetPosition(pVertices, vertexStride, positionOffset, pIndices[t * 3 + 1]);
+						const glm::vec3 p2 = GetPosition(pVertices, vertexStride, positionOffset, pIndices[t * 3 + 2]);
+
+						const glm::vec3 triangleNormal = glm::cross(p1 - p0, p2 - p0);
+						const float32_t triangleArea = glm::length(triangleNormal);
+
+						centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+						normal += triangleNormal;
+						area += triangleArea;
+					}
+
+					centroid = (area > 0.0f) ? (centroid / area) : meshCentroid;
+					const float32_t normalLength = glm::length(normal);
+					normal = (normalLength > 0.0f) ? (normal / normalLength) : glm::vec3(0.0f);
+
+					sortKeys[c] = glm::dot(centroid - meshCentroid, normal);
+				}
+
+				std::vector<uint32_t> order(clusterCount);
+				for (uint32_t c = 0; c < clusterCount; ++c)
+				{
+					order[c] = c;
+				}
+				std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+				std::vector<uint32_t> result;
+				result.reserve(indexCount);
+				for (auto c : order)
+				{
+					result.insert(result.end(), pIndices + clusters[c] * 3, pIndices + clusters[c + 1] * 3);
+				}
+
+				::memcpy(pIndices, result.data(), indexCount * sizeof(uint32_t));
+			}
+
+			uint32_t OptimizeVertexFetch(void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t* pIndices, uint32_t indexCount)
+			{
+				assert(pVertices != nullptr);
+				assert(pIndices != nullptr);
+				assert(vertexStride > 0);
+
+				std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+
+				uint32_t nextVertex = 0;
+				for (uint32_t i = 0; i < indexCount; ++i)
+				{
+					const uint32_t index = pIndices[i];
+					assert(index < vertexCount);
+
+					if (remap[index] == INVALID_INDEX)
+					{
+						remap[index] = nextVertex++;
+					}
+					pIndices[i] = remap[index];
+				}
+
+				const uint32_t referencedVertexCount = nextVertex;
+
+				// keep the unreferenced vertices after the used ones, in their original order
+				for (uint32_t v = 0; v < vertexCount; ++v)
+				{
+					if (remap[v] == INVALID_INDEX)
+					{
+						remap[v] = nextVertex++;
+					}
+				}
+
+				uint8_t* pData = static_cast<uint8_t*>(pVertices);
+				std::vector<uint8_t> reordered(static_cast<size_t>(vertexCount) * vertexStride);
+				for (uint32_t v = 0; v < vertexCount; ++v)
+				{
+					::memcpy(&reordered[static_cast<size_t>(remap[v]) * vertexStride], pData + static_cast<size_t>(v) * vertexStride, vertexStride);
+				}
+				::memcpy(pData, reordered.data(), reordered.size());
+
+				return referencedVertexCount;
+			}
+
+			bool_t OptimizeGeometricPrimitive(GeometricPrimitive* pGeometry, Report* pReportOut)
+			{
+				assert(pGeometry != nullptr);
+
+				if (false == pGeometry->IsIndexed())
+				{
+					LOG_WARNING("Mesh optimization needs indexed geometry!");
+					return false;
+				}
+
+				auto* pVertexBuffer = pGeometry->GetVertexBuffer();
+				assert(pVertexBuffer != nullptr);
+				auto* pIndexBuffer = pGeometry->GetIndexBuffer();
+				assert(pIndexBuffer != nullptr);
+
+				auto* pVertexFormat = pVertexBuffer->GetFormat();
+				assert(pVertexFormat != nullptr);
+
+				if ((pVertexBuffer->GetData() == nullptr) || (pIndexBuffer->GetData() == nullptr) || (pIndexBuffer->GetIndexCount() % 3 != 0))
+				{
+					LOG_WARNING("Mesh optimization supports only triangle lists!");
+					return false;
+				}
+
+				const uint32_t vertexCount = pVertexBuffer->GetVertexCount();
+				const uint32_t vertexStride = pVertexFormat->GetVertexTotalStride();
+				const uint32_t positionOffset = pVertexFormat->GetVertexAttributeOffset(VertexFormat::VertexAttribute::GE_VA_POSITION);
+				const uint32_t indexCount = pIndexBuffer->GetIndexCount();
+
+				// widen to 32 bit indices for processing
+				std::vector<uint32_t> indices(indexCount);
+				switch (pIndexBuffer->GetIndexType())
+				{
+				case IndexBuffer::IndexType::GE_IT_UINT32:
+					::memcpy(indices.data(), pIndexBuffer->GetData(), indexCount * sizeof(uint32_t));
+					break;
+				case IndexBuffer::IndexType::GE_IT_UINT16:
+					for (uint32_t i = 0; i < indexCount; ++i)
+					{
+						indices[i] = static_cast<const uint16_t*>(pIndexBuffer->GetData())[i];
+					}
+					break;
+				case IndexBuffer::IndexType::GE_IT_UINT8:
+					for (uint32_t i = 0; i < indexCount; ++i)
+					{
+						indices[i] = static_cast<const uint8_t*>(pIndexBuffer->GetData())[i];
+					}
+					break;
+				default:
+					LOG_ERROR("Invalid index type!");
+					return false;
+				}
+
+				Report report;
+				report.before = AnalyzeVertexCache(indices.data(), indexCount);
+				report.vertexCountBefore = vertexCount;
+
+				DeduplicateVertices(pVertexBuffer->GetData(), vertexCount, vertexStride, indices.data(), indexCount);
+				OptimizeVertexCache(indices.data(), indexCount);
+				OptimizeOverdraw(indices.data(), indexCount, pVertexBuffer->GetData(), vertexStride, positionOffset);
+				report.vertexCountAfter = OptimizeVertexFetch(pVertexBuffer->GetData(), vertexCount, vertexStride, indices.data(), indexCount);
+
+				report.after = AnalyzeVertexCache(indices.data(), indexCount);
+
+				// narrow back, the vertex count did not change so the indices still fit
+				switch (pIndexBuffer->GetIndexType())
+				{
+				case IndexBuffer::IndexType::GE_IT_UINT32:
+					::memcpy(pIndexBuffer->GetData(), indices.data(), indexCount * sizeof(uint32_t));
+					break;
+				case IndexBuffer::IndexType::GE_IT_UINT16:
+					for (uint32_t i = 0; i < indexCount; ++i)
+					{
+						static_cast<uint16_t*>(pIndexBuffer->GetData())[i] = static_cast<uint16_t>(indices[i]);
+					}
+					break;
+				case IndexBuffer::IndexType::GE_IT_UINT8:
+					for (uint32_t i = 0; i < indexCount; ++i)
+					{
+						static_cast<uint8_t*>(pIndexBuffer->GetData())[i] = static_cast<uint8_t>(indices[i]);
+					}
+					break;
+				case IndexBuffer::IndexType::GE_IT_COUNT:
+				default:
+					// rejected by the widening above
+					assert(false);
+					break;
+				}
+
+				LOG_INFO("Mesh optimization - ACMR: %.3f -> %.3f, ATVR: %.3f -> %.3f, vertices: %u -> %u",
+					report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr, report.vertexCountBefore, report.vertexCountAfter);
+
+				if (pReportOut)
+				{
+					*pReportOut = report;
+				}
+
+				return true;
+			}
+		}
+	}
+}
\ No newline at end of file
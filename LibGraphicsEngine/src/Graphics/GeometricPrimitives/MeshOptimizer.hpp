@@ -0,0 +1,74 @@
+#ifndef GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_OPTIMIZER_HPP
+#define GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_OPTIMIZER_HPP
+
+#include "Foundation/TypeDefines.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class GeometricPrimitive;
+
+		/*
+			Mesh optimization stage for indexed triangle lists.
+			Recommended order: DeduplicateVertices -> OptimizeVertexCache -> OptimizeOverdraw -> OptimizeVertexFetch
+			All functions are deterministic, so the results are the same on every run/platform.
+		*/
+		namespace MeshOptimizer
+		{
+			// post transform cache size used for scoring and reporting
+			static const uint32_t DEFAULT_CACHE_SIZE = 16;
+			static const float32_t DEFAULT_OVERDRAW_THRESHOLD = 1.05f;
+
+			struct CacheStatistics
+			{
+				CacheStatistics()
+					: vertexTransformCount(0), acmr(0.0f), atvr(0.0f)
+				{}
+
+				uint32_t vertexTransformCount; // number of cache misses
+				float32_t acmr; // average cache miss ratio - transformed vertices / triangle count, 0.5 is ideal, 3.0 is worst
+				float32_t atvr; // average transformed vertex ratio - transformed vertices / referenced vertex count, 1.0 is ideal
+			};
+
+			struct Report
+			{
+				Report()
+					: vertexCountBefore(0), vertexCountAfter(0)
+				{}
+
+				CacheStatistics before;
+				CacheStatistics after;
+				uint32_t vertexCountBefore;
+				uint32_t vertexCountAfter; // referenced unique vertices
+			};
+
+			// FIFO cache simulation
+			CacheStatistics AnalyzeVertexCache(const uint32_t* pIndices, uint32_t indexCount, uint32_t cacheSize = DEFAULT_CACHE_SIZE);
+
+			// remaps the indices of binary identical vertices to their first occurrence, the vertex data is not touched
+			// returns the number of unique vertices
+			uint32_t DeduplicateVertices(const void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t* pIndices, uint32_t indexCount);
+
+			// Tom Forsyth's linear-speed vertex cache optimization, reorders triangles in place
+			void OptimizeVertexCache(uint32_t* pIndices, uint32_t indexCount);
+
+			// reorders clusters of triangles (as produced by OptimizeVertexCache) front to back in respect to the mesh center,
+			// a cluster is split only while its cache miss ratio stays below threshold * the cache miss ratio of the input
+			void OptimizeOverdraw(uint32_t* pIndices, uint32_t indexCount, const void* pVertices, uint32_t vertexStride, uint32_t positionOffset,
+				float32_t threshold = DEFAULT_OVERDRAW_THRESHOLD);
+
+			// reorders the vertices in the order of first use and remaps the indices,
+			// unreferenced vertices are moved after the referenced ones
+			// returns the number of referenced vertices
+			uint32_t OptimizeVertexFetch(void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t* pIndices, uint32_t indexCount);
+
+			// runs the whole stage in place on the vertex/index buffers of the geometry
+			// NOTE! Must be called before the geometry is bound by the renderer.
+			// Only triangle lists are supported, the vertex buffer keeps its size (unreferenced vertices are moved to the end)
+			bool_t OptimizeGeometricPrimitive(GeometricPrimitive* pGeometry, Report* pReportOut = nullptr);
+		}
+	}
+}
+
+#endif // GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_OPTIMIZER_HPP
\ No newline at end of file
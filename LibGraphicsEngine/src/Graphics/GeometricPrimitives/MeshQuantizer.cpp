@@ -0,0 +1,333 @@
+#include "Graphics/GeometricPrimitives/MeshQuantizer.hpp"
+#include "Graphics/Rendering/Resources/VertexFormat.hpp"
+#include "Foundation/Logger.hpp"
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+#include <vector>
+#include <cmath> // std::nearbyint()
+#include <cstring> // ::memcpy()
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define GE_MESH_QUANTIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		namespace MeshQuantizer
+		{
+			// NOTE! Both the SSE2 and scalar paths round to nearest even, so they give the same results
+			template <typename T>
+			static T QuantizeNorm(float32_t value, float32_t minValue, float32_t scale)
+			{
+				return static_cast<T>(std::nearbyint(glm::clamp(value, minValue, 1.0f) * scale));
+			}
+
+			// float32 -> float16, round to nearest even
+			// based on: https://gist.github.com/rygorous/2156668
+			static uint16_t FloatToHalf(float32_t value)
+			{
+				uint32_t bits = 0;
+				::memcpy(&bits, &value, sizeof(bits));
+
+				const uint32_t sign = bits & 0x80000000u;
+				bits ^= sign;
+
+				uint32_t result = 0;
+				if (bits >= ((127 + 16) << 23))
+				{
+					// overflow to infinity, NaN stays NaN
+					result = (bits > (255u << 23)) ? 0x7E00 : 0x7C00;
+				}
+				else if (bits < (113 << 23))
+				{
+					// denormals - let the float adder do the rounding
+					const uint32_t denormMagicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+					float32_t denormMagic = 0.0f, absValue = 0.0f;
+					::memcpy(&denormMagic, &denormMagicBits, sizeof(denormMagic));
+					::memcpy(&absValue, &bits, sizeof(absValue));
+
+					absValue += denormMagic;
+					::memcpy(&result, &absValue, sizeof(result));
+					result -= denormMagicBits;
+				}
+				else
+				{
+					const uint32_t mantissaOdd = (bits >> 13) & 1;
+					result = (bits + 0xC8000FFFu + mantissaOdd) >> 13; // rebias the exponent: (15 - 127) << 23
+				}
+
+				return static_cast<uint16_t>(result | (sign >> 16));
+			}
+
+#if defined(GE_MESH_QUANTIZER_SSE2)
+			// 4 x float32 -> 4 x float16 (in the low 16 bits of each lane), same as FloatToHalf()
+			static __m128i FloatToHalf4(__m128 value)
+			{
+				const __m128i maskSign = _mm_set1_epi32(static_cast<int32_t>(0x80000000u));
+				const __m128i f32Infinity = _mm_set1_epi32(255 << 23);
+				const __m128i f16MaxAsF32 = _mm_set1_epi32((127 + 16) << 23); // first value that overflows to infinity
+				const __m128i denormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+				const __m128i roundBias = _mm_set1_epi32(static_cast<int32_t>(0xC8000FFFu)); // (15 - 127) << 23 + 0xfff
+				const __m128i nanBits = _mm_set1_epi32(0x7E00);
+				const __m128i infBits = _mm_set1_epi32(0x7C00);
+				const __m128i normalMin = _mm_set1_epi32(113 << 23);
+
+				const __m128i bits = _mm_castps_si128(value);
+				const __m128i sign = _mm_and_si128(bits, maskSign);
+				const __m128i absBits = _mm_xor_si128(bits, sign);
+
+				// denormals - let the float adder do the rounding
+				const __m128 denorm = _mm_add_ps(_mm_castsi128_ps(absBits), _mm_castsi128_ps(denormMagic));
+				const __m128i denormResult = _mm_sub_epi32(_mm_castps_si128(denorm), denormMagic);
+
+				// normals - rebias the exponent and round to nearest even
+				const __m128i mantissaOdd = _mm_and_si128(_mm_srli_epi32(absBits, 13), _mm_set1_epi32(1));
+				const __m128i normalResult = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(absBits, roundBias), mantissaOdd), 13);
+
+				const __m128i isNormal = _mm_cmpgt_epi32(absBits, _mm_sub_epi32(normalMin, _mm_set1_epi32(1)));
+				const __m128i isOverflow = _mm_cmpgt_epi32(absBits, _mm_sub_epi32(f16MaxAsF32, _mm_set1_epi32(1)));
+				const __m128i isNaN = _mm_cmpgt_epi32(absBits, f32Infinity);
+
+				__m128i result = _mm_or_si128(_mm_and_si128(isNormal, normalResult), _mm_andnot_si128(isNormal, denormResult));
+				const __m128i special = _mm_or_si128(_mm_and_si128(isNaN, nanBits), _mm_andnot_si128(isNaN, infBits));
+				result = _mm_or_si128(_mm_and_si128(isOverflow, special), _mm_andnot_si128(isOverflow, result));
+
+				return _mm_or_si128(result, _mm_srli_epi32(sign, 16));
+			}
+
+			// 2 x (4 x int32) -> 8 x int16, values must already fit in 16 bits (signed or not)
+			static __m128i Pack32To16(__m128i low, __m128i high)
+			{
+				// sign extend the low 16 bits first, so the saturating pack does not clamp unsigned values
+				low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+				high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+
+				return _mm_packs_epi32(low, high);
+			}
+#endif // GE_MESH_QUANTIZER_SSE2
+
+			void QuantizeFloat16(const float32_t* pIn, uint16_t* pOut, size_t count)
+			{
+				assert(pIn != nullptr);
+				assert(pOut != nullptr);
+
+				size_t i = 0;
+#if defined(GE_MESH_QUANTIZER_SSE2)
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m128i low = FloatToHalf4(_mm_loadu_ps(pIn + i));
+					const __m128i high = FloatToHalf4(_mm_loadu_ps(pIn + i + 4));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), Pack32To16(low, high));
+				}
+#endif // GE_MESH_QUANTIZER_SSE2
+				for (; i < count; ++i)
+				{
+					pOut[i] = FloatToHalf(pIn[i]);
+				}
+			}
+
+			void QuantizeSnorm16(const float32_t* pIn, int16_t* pOut, size_t count)
+			{
+				assert(pIn != nullptr);
+				assert(pOut != nullptr);
+
+				size_t i = 0;
+#if defined(GE_MESH_QUANTIZER_SSE2)
+				const __m128 minValue = _mm_set1_ps(-1.0f), maxValue = _mm_set1_ps(1.0f), scale = _mm_set1_ps(32767.0f);
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m128i low = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pIn + i), minValue), maxValue), scale));
+					const __m128i high = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pIn + i + 4), minValue), maxValue), scale));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), _mm_packs_epi32(low, high));
+				}
+#endif // GE_MESH_QUANTIZER_SSE2
+				for (; i < count; ++i)
+				{
+					pOut[i] = QuantizeNorm<int16_t>(pIn[i], -1.0f, 32767.0f);
+				}
+			}
+
+			void QuantizeSnorm8(const float32_t* pIn, int8_t* pOut, size_t count)
+			{
+				assert(pIn != nullptr);
+				assert(pOut != nullptr);
+
+				size_t i = 0;
+#if defined(GE_MESH_QUANTIZER_SSE2)
+				const __m128 minValue = _mm_set1_ps(-1.0f), maxValue = _mm_set1_ps(1.0f), scale = _mm_set1_ps(127.0f);
+				for (; i + 16 <= count; i += 16)
+				{
+					__m128i values[4];
+					for (uint32_t k = 0; k < 4; ++k)
+					{
+						values[k] = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pIn + i + k * 4), minValue), maxValue), scale));
+					}
+					const __m128i packed = _mm_packs_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), packed);
+				}
+#endif // GE_MESH_QUANTIZER_SSE2
+				for (; i < count; ++i)
+				{
+					pOut[i] = QuantizeNorm<int8_t>(pIn[i], -1.0f, 127.0f);
+				}
+			}
+
+			void QuantizeUnorm8(const float32_t* pIn, uint8_t* pOut, size_t count)
+			{
+				assert(pIn != nullptr);
+				assert(pOut != nullptr);
+
+				size_t i = 0;
+#if defined(GE_MESH_QUANTIZER_SSE2)
+				const __m128 minValue = _mm_set1_ps(0.0f), maxValue = _mm_set1_ps(1.0f), scale = _mm_set1_ps(255.0f);
+				for (; i + 16 <= count; i += 16)
+				{
+					__m128i values[4];
+					for (uint32_t k = 0; k < 4; ++k)
+					{
+						values[k] = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(pIn + i + k * 4), minValue), maxValue), scale));
+					}
+					const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + i), packed);
+				}
+#endif // GE_MESH_QUANTIZER_SSE2
+				for (; i < count; ++i)
+				{
+					pOut[i] = static_cast<uint8_t>(std::nearbyint(glm::clamp(pIn[i], 0.0f, 1.0f) * 255.0f));
+				}
+			}
+
+			glm::vec2 EncodeOctahedral(const glm::vec3& normal)
+			{
+				const glm::vec3 n = normal / (glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z));
+
+				glm::vec2 encoded(n.x, n.y);
+				if (n.z < 0.0f)
+				{
+					// fold the lower hemisphere over the diagonals
+					encoded.x = (1.0f - glm::abs(n.y)) * ((n.x >= 0.0f) ? 1.0f : -1.0f);
+					encoded.y = (1.0f - glm::abs(n.x)) * ((n.y >= 0.0f) ? 1.0f : -1.0f);
+				}
+
+				return encoded;
+			}
+
+			glm::vec3 DecodeOctahedral(const glm::vec2& encoded)
+			{
+				glm::vec3 n(encoded.x, encoded.y, 1.0f - glm::abs(encoded.x) - glm::abs(encoded.y));
+				if (n.z < 0.0f)
+				{
+					const float32_t x = n.x;
+					n.x = (1.0f - glm::abs(n.y)) * ((x >= 0.0f) ? 1.0f : -1.0f);
+					n.y = (1.0f - glm::abs(x)) * ((n.y >= 0.0f) ? 1.0f : -1.0f);
+				}
+
+				return glm::normalize(n);
+			}
+
+			bool_t QuantizeVertices(const void* pSrcVertices, const VertexFormat& srcFormat, uint32_t vertexCount, const VertexFormat& dstFormat, void* pDstVertices)
+			{
+				assert(pSrcVertices != nullptr);
+				assert(pDstVertices != nullptr);
+
+				const uint32_t srcStride = srcFormat.GetVertexTotalStride();
+				const uint32_t dstStride = dstFormat.GetVertexTotalStride();
+
+				const uint8_t* pSrc = static_cast<const uint8_t*>(pSrcVertices);
+				uint8_t* pDst = static_cast<uint8_t*>(pDstVertices);
+
+				// stride padding stays deterministic
+				::memset(pDst, 0, static_cast<size_t>(vertexCount) * dstStride);
+
+				// attribute by attribute, so the conversions work on big contiguous arrays
+				std::vector<float32_t> gathered;
+				std::vector<uint8_t> converted;
+				for (auto& attribute : srcFormat.GetVertexAttributes())
+				{
+					const auto att = attribute.first;
+					const uint32_t srcComponents = attribute.second;
+
+					if ((srcFormat.GetVertexAttributeType(att) != VertexFormat::AttributeType::GE_AT_FLOAT32) ||
+						(false == dstFormat.HasVertexAttribute(att)) ||
+						(dstFormat.GetVertexAttributes().at(att) != srcComponents))
+					{
+						LOG_ERROR("Incompatible vertex formats for quantization!");
+						return false;
+					}
+
+					const auto dstType = dstFormat.GetVertexAttributeType(att);
+					const uint32_t dstComponents = dstFormat.GetVertexAttributeStoredComponentCount(att);
+					const uint32_t srcOffset = srcFormat.GetVertexAttributeOffset(att);
+					const uint32_t dstOffset = dstFormat.GetVertexAttributeOffset(att);
+					const uint32_t dstAttributeStride = dstFormat.GetVertexAttributeStride(att);
+
+					// gather
+					gathered.assign(static_cast<size_t>(vertexCount) * dstComponents, 0.0f);
+					for (uint32_t v = 0; v < vertexCount; ++v)
+					{
+						float32_t value[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+						::memcpy(value, pSrc + static_cast<size_t>(v) * srcStride + srcOffset, srcComponents * sizeof(float32_t));
+
+						float32_t* pGathered = &gathered[static_cast<size_t>(v) * dstComponents];
+						if (dstType == VertexFormat::AttributeType::GE_AT_OCTAHEDRAL_SNORM16)
+						{
+							const glm::vec2 encoded = EncodeOctahedral(glm::vec3(value[0], value[1], value[2]));
+							pGathered[0] = encoded.x;
+							pGathered[1] = encoded.y;
+						}
+						else
+						{
+							// padded alpha of colors is opaque
+							if ((srcComponents == 3) && (dstComponents == 4) && (att == VertexFormat::VertexAttribute::GE_VA_COLOR))
+							{
+								value[3] = 1.0f;
+							}
+							::memcpy(pGathered, value, dstComponents * sizeof(float32_t));
+						}
+					}
+
+					// convert
+					converted.resize(gathered.size() * sizeof(float32_t));
+					switch (dstType)
+					{
+					case VertexFormat::AttributeType::GE_AT_FLOAT32:
+						::memcpy(converted.data(), gathered.data(), gathered.size() * sizeof(float32_t));
+						break;
+					case VertexFormat::AttributeType::GE_AT_FLOAT16:
+						QuantizeFloat16(gathered.data(), reinterpret_cast<uint16_t*>(converted.data()), gathered.size());
+						break;
+					case VertexFormat::AttributeType::GE_AT_SNORM16:
+					case VertexFormat::AttributeType::GE_AT_OCTAHEDRAL_SNORM16:
+						QuantizeSnorm16(gathered.data(), reinterpret_cast<int16_t*>(converted.data()), gathered.size());
+						break;
+					case VertexFormat::AttributeType::GE_AT_SNORM8:
+						QuantizeSnorm8(gathered.data(), reinterpret_cast<int8_t*>(converted.data()), gathered.size());
+						break;
+					case VertexFormat::AttributeType::GE_AT_UNORM8:
+						QuantizeUnorm8(gathered.data(), converted.data(), gathered.size());
+						break;
+					default:
+						LOG_ERROR("Invalid vertex attribute type!");
+						return false;
+					}
+
+					// scatter
+					for (uint32_t v = 0; v < vertexCount; ++v)
+					{
+						::memcpy(pDst + static_cast<size_t>(v) * dstStride + dstOffset, &converted[static_cast<size_t>(v) * dstAttributeStride], dstAttributeStride);
+					}
+				}
+
+				return true;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_QUANTIZER_HPP
+#define GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_QUANTIZER_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class VertexFormat;
+
+		/*
+			Vertex attribute quantization.
+			The bulk conversions use SSE2 when available, with a scalar fallback producing the same results.
+		*/
+		namespace MeshQuantizer
+		{
+			void QuantizeFloat16(const float32_t* pIn, uint16_t* pOut, size_t count);
+			void QuantizeSnorm16(const float32_t* pIn, int16_t* pOut, size_t count);
+			void QuantizeSnorm8(const float32_t* pIn, int8_t* pOut, size_t count);
+			void QuantizeUnorm8(const float32_t* pIn, uint8_t* pOut, size_t count);
+
+			// octahedral mapping of unit vectors, result in [-1, 1]
+			glm::vec2 EncodeOctahedral(const glm::vec3& normal);
+			glm::vec3 DecodeOctahedral(const glm::vec2& encoded);
+
+			// converts interleaved float32 vertices from srcFormat to dstFormat
+			// NOTE! Both formats must have the same attributes and component counts, only the types may differ
+			bool_t QuantizeVertices(const void* pSrcVertices, const VertexFormat& srcFormat, uint32_t vertexCount, const VertexFormat& dstFormat, void* pDstVertices);
+		}
+	}
+}
+
+#endif // GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_QUANTIZER_HPP
\ No newline at end of file
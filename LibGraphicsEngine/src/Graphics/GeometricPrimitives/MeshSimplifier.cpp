@@ -0,0 +1,638 @@
+#include "Graphics/GeometricPrimitives/MeshSimplifier.hpp"
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "Graphics/Rendering/Resources/VertexFormat.hpp"
+#include "Graphics/Rendering/Resources/VertexBuffer.hpp"
+#include "Graphics/Rendering/Resources/IndexBuffer.hpp"
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Logger.hpp"
+#include "glm/vec3.hpp"
+#include "glm/geometric.hpp"
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <algorithm> // std::sort(), std::nth_element(), std::max()
+#include <cmath> // std::sqrt()
+#include <cstring> // ::memcpy()
+#include <cassert>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		namespace MeshSimplifier
+		{
+			static const uint32_t INVALID_INDEX = ~0u;
+
+			// symmetric 4x4 matrix, the sum of the squared distances to a set of planes
+			struct Quadric
+			{
+				Quadric()
+					: a00(0.0), a01(0.0), a02(0.0), a03(0.0), a11(0.0), a12(0.0), a13(0.0), a22(0.0), a23(0.0), a33(0.0)
+				{}
+
+				// plane: dot(normal, p) + d = 0, the normal is normalized
+				Quadric(const glm::dvec3& normal, float64_t d)
+					: a00(normal.x * normal.x), a01(normal.x * normal.y), a02(normal.x * normal.z), a03(normal.x * d)
+					, a11(normal.y * normal.y), a12(normal.y * normal.z), a13(normal.y * d)
+					, a22(normal.z * normal.z), a23(normal.z * d)
+					, a33(d * d)
+				{}
+
+				Quadric& operator+=(const Quadric& other)
+				{
+					a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+					a11 += other.a11; a12 += other.a12; a13 += other.a13;
+					a22 += other.a22; a23 += other.a23;
+					a33 += other.a33;
+					return *this;
+				}
+
+				float64_t Evaluate(const glm::dvec3& p) const
+				{
+					// p^T * Q * p, with p = (x, y, z, 1)
+					return a00 * p.x * p.x + 2.0 * a01 * p.x * p.y + 2.0 * a02 * p.x * p.z + 2.0 * a03 * p.x
+						+ a11 * p.y * p.y + 2.0 * a12 * p.y * p.z + 2.0 * a13 * p.y
+						+ a22 * p.z * p.z + 2.0 * a23 * p.z
+						+ a33;
+				}
+
+				float64_t a00, a01, a02, a03;
+				float64_t a11, a12, a13;
+				float64_t a22, a23;
+				float64_t a33;
+			};
+
+			// collapse of the vertex 'from' onto the vertex 'to', both position ids
+			struct Collapse
+			{
+				float64_t cost;
+				uint32_t from;
+				uint32_t to;
+				uint32_t version; // of 'from'
+				uint32_t rank; // in the collapses of 'from' sorted by cost
+			};
+
+			// min heap, the ties are broken by the vertex ids
+			struct CollapseGreater
+			{
+				bool operator()(const Collapse& a, const Collapse& b) const
+				{
+					if (a.cost != b.cost)
+						return a.cost > b.cost;
+					if (a.from != b.from)
+						return a.from > b.from;
+					return a.to > b.to;
+				}
+			};
+
+			class Simplifier
+			{
+			public:
+				Simplifier(const uint32_t* pIndices, uint32_t indexCount, const void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t positionOffset)
+					: mIndices(pIndices, pIndices + indexCount)
+					, mTriangleCount(indexCount / 3)
+					, mLiveTriangleCount(0)
+				{
+					ReadPositions(pVertices, vertexCount, vertexStride, positionOffset);
+					BuildTopology();
+					BuildQuadrics();
+				}
+
+				uint32_t Run(uint32_t targetIndexCount, float32_t maxError, uint32_t* pIndicesOut, float32_t* pErrorOut)
+				{
+					const uint32_t targetTriangleCount = targetIndexCount / 3;
+					const float64_t maxCost = static_cast<float64_t>(maxError) * static_cast<float64_t>(maxError);
+
+					for (uint32_t v = 0; v < mPositionIds.size(); ++v)
+					{
+						if ((mPositionIds[v] == v) && (false == mIsLocked[v]))
+						{
+							PushCollapse(v);
+						}
+					}
+
+					float64_t error = 0.0;
+					while ((mLiveTriangleCount > targetTriangleCount) && (false == mHeap.empty()))
+					{
+						const Collapse collapse = mHeap.top();
+						mHeap.pop();
+
+						// the neighbourhood changed since it was pushed
+						if (mIsRemoved[collapse.from] || (collapse.version != mVersions[collapse.from]))
+							continue;
+
+						// the cheapest valid collapse is already too far from the source
+						if (collapse.cost > maxCost)
+							break;
+
+						// the next best collapse of the vertex is tried
+						uint32_t toWedge = INVALID_INDEX;
+						if (false == CanCollapse(collapse.from, collapse.to, toWedge))
+						{
+							PushCollapse(collapse.from, collapse.rank + 1);
+							continue;
+						}
+
+						DoCollapse(collapse.from, collapse.to, toWedge);
+						error = std::max(error, collapse.cost);
+					}
+
+					uint32_t indexCount = 0;
+					for (uint32_t t = 0; t < mTriangleCount; ++t)
+					{
+						if (mIsTriangleRemoved[t])
+							continue;
+
+						pIndicesOut[indexCount++] = mIndices[3 * t];
+						pIndicesOut[indexCount++] = mIndices[3 * t + 1];
+						pIndicesOut[indexCount++] = mIndices[3 * t + 2];
+					}
+
+					if (pErrorOut)
+					{
+						*pErrorOut = static_cast<float32_t>(std::sqrt(error));
+					}
+
+					return indexCount;
+				}
+
+			private:
+				void ReadPositions(const void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t positionOffset)
+				{
+					const uint8_t* pData = static_cast<const uint8_t*>(pVertices);
+
+					mPositions.resize(vertexCount);
+					for (uint32_t i = 0; i < vertexCount; ++i)
+					{
+						const float32_t* pPosition = reinterpret_cast<const float32_t*>(pData + i * vertexStride + positionOffset);
+						mPositions[i] = glm::dvec3(pPosition[0], pPosition[1], pPosition[2]);
+					}
+
+					// the vertices with the same position get the id of the first one
+					std::vector<uint32_t> order(vertexCount);
+					for (uint32_t i = 0; i < vertexCount; ++i)
+					{
+						order[i] = i;
+					}
+					std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+						{
+							const auto& pa = mPositions[a];
+							const auto& pb = mPositions[b];
+							if (pa.x != pb.x) return pa.x < pb.x;
+							if (pa.y != pb.y) return pa.y < pb.y;
+							if (pa.z != pb.z) return pa.z < pb.z;
+							return a < b;
+						});
+
+					mPositionIds.resize(vertexCount);
+					for (uint32_t i = 0; i < vertexCount; ++i)
+					{
+						const bool_t isSame = (i > 0) && (mPositions[order[i]] == mPositions[order[i - 1]]);
+						mPositionIds[order[i]] = isSame ? mPositionIds[order[i - 1]] : order[i];
+					}
+				}
+
+				void BuildTopology()
+				{
+					const uint32_t vertexCount = static_cast<uint32_t>(mPositions.size());
+
+					mIsTriangleRemoved.assign(mTriangleCount, false);
+					mVertexTriangles.resize(vertexCount);
+					mIsLocked.assign(vertexCount, false);
+					mIsRemoved.assign(vertexCount, false);
+					mVersions.assign(vertexCount, 0);
+
+					// the positions with more than one referenced vertex are seams
+					std::vector<uint32_t> wedges(vertexCount, INVALID_INDEX);
+					for (auto index : mIndices)
+					{
+						assert(index < vertexCount);
+
+						const uint32_t id = mPositionIds[index];
+						if (wedges[id] == INVALID_INDEX)
+						{
+							wedges[id] = index;
+						}
+						else if (wedges[id] != index)
+						{
+							mIsLocked[id] = true;
+						}
+					}
+
+					// edge -> triangle count, the border and non manifold edges are locked
+					std::unordered_map<uint64_t, uint32_t> edgeCounts;
+					for (uint32_t t = 0; t < mTriangleCount; ++t)
+					{
+						const uint32_t ids[3] = { mPositionIds[mIndices[3 * t]], mPositionIds[mIndices[3 * t + 1]], mPositionIds[mIndices[3 * t + 2]] };
+
+						// degenerated triangles are dropped
+						if ((ids[0] == ids[1]) || (ids[1] == ids[2]) || (ids[0] == ids[2]))
+						{
+							mIsTriangleRemoved[t] = true;
+							continue;
+						}
+
+						mLiveTriangleCount++;
+
+						for (uint32_t i = 0; i < 3; ++i)
+						{
+							mVertexTriangles[ids[i]].push_back(t);
+							edgeCounts[EdgeKey(ids[i], ids[(i + 1) % 3])]++;
+						}
+					}
+
+					for (const auto& it : edgeCounts)
+					{
+						if (it.second != 2)
+						{
+							mIsLocked[static_cast<uint32_t>(it.first >> 32)] = true;
+							mIsLocked[static_cast<uint32_t>(it.first & 0xFFFFFFFF)] = true;
+						}
+					}
+				}
+
+				void BuildQuadrics()
+				{
+					mQuadrics.resize(mPositions.size());
+
+					for (uint32_t t = 0; t < mTriangleCount; ++t)
+					{
+						if (mIsTriangleRemoved[t])
+							continue;
+
+						const glm::dvec3& p0 = mPositions[mIndices[3 * t]];
+						const glm::dvec3& p1 = mPositions[mIndices[3 * t + 1]];
+						const glm::dvec3& p2 = mPositions[mIndices[3 * t + 2]];
+
+						const glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+						const float64_t length = glm::length(normal);
+						if (length <= 0.0)
+							continue;
+
+						const glm::dvec3 unitNormal = normal / length;
+						const Quadric quadric(unitNormal, -glm::dot(unitNormal, p0));
+
+						for (uint32_t i = 0; i < 3; ++i)
+						{
+							mQuadrics[mPositionIds[mIndices[3 * t + i]]] += quadric;
+						}
+					}
+				}
+
+				static uint64_t EdgeKey(uint32_t a, uint32_t b)
+				{
+					return (a < b) ? ((static_cast<uint64_t>(a) << 32) | b) : ((static_cast<uint64_t>(b) << 32) | a);
+				}
+
+				// the position ids around the vertex, sorted
+				void GetNeighbours(uint32_t id, std::vector<uint32_t>& neighboursOut) const
+				{
+					neighboursOut.clear();
+					for (auto t : mVertexTriangles[id])
+					{
+						if (mIsTriangleRemoved[t])
+							continue;
+
+						for (uint32_t i = 0; i < 3; ++i)
+						{
+							const uint32_t neighbour = mPositionIds[mIndices[3 * t + i]];
+							if (neighbour != id)
+							{
+								neighboursOut.push_back(neighbour);
+							}
+						}
+					}
+					std::sort(neighboursOut.begin(), neighboursOut.end());
+					neighboursOut.erase(std::unique(neighboursOut.begin(), neighboursOut.end()), neighboursOut.end());
+				}
+
+				// one collapse per vertex in the heap, the one with the given rank in the collapses onto its neighbours
+				// the collapses are checked when popped, a rejected one pushes the next rank
+				void PushCollapse(uint32_t from, uint32_t rank = 0)
+				{
+					GetNeighbours(from, mCandidateNeighbours);
+
+					mCandidates.clear();
+					for (auto to : mCandidateNeighbours)
+					{
+						Quadric quadric = mQuadrics[from];
+						quadric += mQuadrics[to];
+
+						Collapse collapse;
+						collapse.cost = std::max(0.0, quadric.Evaluate(mPositions[to]));
+						collapse.from = from;
+						collapse.to = to;
+						collapse.version = mVersions[from];
+						collapse.rank = rank;
+
+						mCandidates.push_back(collapse);
+					}
+
+					if (rank >= mCandidates.size())
+						return;
+
+					std::nth_element(mCandidates.begin(), mCandidates.begin() + rank, mCandidates.end(), [](const Collapse& a, const Collapse& b) { return CollapseGreater()(b, a); });
+
+					mHeap.push(mCandidates[rank]);
+				}
+
+				bool_t CanCollapse(uint32_t from, uint32_t to, uint32_t& toWedgeOut)
+				{
+					assert(false == mIsLocked[from]);
+
+					// the triangles on the edge are removed, they give the vertex used for 'to' in the triangles left
+					uint32_t sharedCount = 0;
+					toWedgeOut = INVALID_INDEX;
+					for (auto t : mVertexTriangles[from])
+					{
+						if (mIsTriangleRemoved[t])
+							continue;
+
+						for (uint32_t i = 0; i < 3; ++i)
+						{
+							const uint32_t index = mIndices[3 * t + i];
+							if (mPositionIds[index] != to)
+								continue;
+
+							// 'to' is on a seam crossing the triangles around 'from'
+							if ((toWedgeOut != INVALID_INDEX) && (toWedgeOut != index))
+								return false;
+
+							toWedgeOut = index;
+							sharedCount++;
+						}
+					}
+
+					if (0 == sharedCount)
+						return false;
+
+					// link condition: the common neighbours are only the opposite vertices of the edge triangles
+					GetNeighbours(from, mNeighbours);
+					GetNeighbours(to, mOtherNeighbours);
+
+					uint32_t commonCount = 0;
+					for (uint32_t i = 0, j = 0; (i < mNeighbours.size()) && (j < mOtherNeighbours.size());)
+					{
+						if (mNeighbours[i] < mOtherNeighbours[j])
+						{
+							i++;
+						}
+						else if (mNeighbours[i] > mOtherNeighbours[j])
+						{
+							j++;
+						}
+						else
+						{
+							commonCount++;
+							i++;
+							j++;
+						}
+					}
+					if (commonCount != sharedCount)
+						return false;
+
+					// the triangles left must not flip or become degenerated
+					for (auto t : mVertexTriangles[from])
+					{
+						if (mIsTriangleRemoved[t])
+							continue;
+
+						glm::dvec3 positions[3];
+						glm::dvec3 movedPositions[3];
+						bool_t hasTo = false;
+						for (uint32_t i = 0; i < 3; ++i)
+						{
+							const uint32_t index = mIndices[3 * t + i];
+
+							positions[i] = mPositions[index];
+							movedPositions[i] = (mPositionIds[index] == from) ? mPositions[to] : positions[i];
+							hasTo = hasTo || (mPositionIds[index] == to);
+						}
+						if (hasTo)
+							continue;
+
+						const glm::dvec3 normal = glm::cross(positions[1] - positions[0], positions[2] - positions[0]);
+						const glm::dvec3 movedNormal = glm::cross(movedPositions[1] - movedPositions[0], movedPositions[2] - movedPositions[0]);
+
+						if (glm::dot(normal, movedNormal) <= 0.0)
+							return false;
+					}
+
+					return true;
+				}
+
+				void DoCollapse(uint32_t from, uint32_t to, uint32_t toWedge)
+				{
+					for (auto t : mVertexTriangles[from])
+					{
+						if (mIsTriangleRemoved[t])
+							continue;
+
+						bool_t hasTo = false;
+						for (uint32_t i = 0; i < 3; ++i)
+						{
+							hasTo = hasTo || (mPositionIds[mIndices[3 * t + i]] == to);
+						}
+
+						if (hasTo)
+						{
+							mIsTriangleRemoved[t] = true;
+							mLiveTriangleCount--;
+							continue;
+						}
+
+						// 'from' is not on a seam, it has only one vertex
+						for (uint32_t i = 0; i < 3; ++i)
+						{
+							if (mPositionIds[mIndices[3 * t + i]] == from)
+							{
+								mIndices[3 * t + i] = toWedge;
+							}
+						}
+						mVertexTriangles[to].push_back(t);
+					}
+
+					mIsRemoved[from] = true;
+					std::vector<uint32_t>().swap(mVertexTriangles[from]);
+
+					// the removed triangles are dropped from the list of 'to'
+					auto& triangles = mVertexTriangles[to];
+					triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [this](uint32_t t) { return mIsTriangleRemoved[t]; }), triangles.end());
+
+					mQuadrics[to] += mQuadrics[from];
+
+					// the collapses of 'to' and of its neighbours changed, the version makes the old ones stale
+					mVersions[to]++;
+					if (false == mIsLocked[to])
+					{
+						PushCollapse(to);
+					}
+
+					GetNeighbours(to, mChangedNeighbours);
+					for (auto neighbour : mChangedNeighbours)
+					{
+						mVersions[neighbour]++;
+						if (false == mIsLocked[neighbour])
+						{
+							PushCollapse(neighbour);
+						}
+					}
+				}
+
+				std::vector<uint32_t> mIndices;
+				uint32_t mTriangleCount;
+				uint32_t mLiveTriangleCount;
+
+				std::vector<glm::dvec3> mPositions; // per vertex
+				std::vector<uint32_t> mPositionIds; // per vertex, the first vertex with the same position
+
+				// per position id
+				std::vector<std::vector<uint32_t>> mVertexTriangles;
+				std::vector<Quadric> mQuadrics;
+				std::vector<bool_t> mIsLocked;
+				std::vector<bool_t> mIsRemoved;
+				std::vector<uint32_t> mVersions;
+
+				std::vector<bool_t> mIsTriangleRemoved;
+
+				std::priority_queue<Collapse, std::vector<Collapse>, CollapseGreater> mHeap;
+
+				// scratch
+				std::vector<uint32_t> mNeighbours;
+				std::vector<uint32_t> mOtherNeighbours;
+				std::vector<uint32_t> mChangedNeighbours;
+				std::vector<uint32_t> mCandidateNeighbours;
+				std::vector<Collapse> mCandidates;
+			};
+
+			uint32_t Simplify(const uint32_t* pIndices, uint32_t indexCount, const void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t positionOffset,
+				uint32_t targetIndexCount, float32_t maxError, uint32_t* pIndicesOut, float32_t* pErrorOut)
+			{
+				assert(pIndices != nullptr);
+				assert(pVertices != nullptr);
+				assert(pIndicesOut != nullptr);
+				assert(indexCount % 3 == 0);
+
+				Simplifier simplifier(pIndices, indexCount, pVertices, vertexCount, vertexStride, positionOffset);
+
+				return simplifier.Run(targetIndexCount, maxError, pIndicesOut, pErrorOut);
+			}
+
+			GeometricPrimitive* SimplifyGeometricPrimitive(const GeometricPrimitive* pGeometry, float32_t ratio, float32_t maxError, float32_t* pErrorOut)
+			{
+				assert(pGeometry != nullptr);
+				assert((ratio > 0.0f) && (ratio <= 1.0f));
+
+				auto* pVertexBuffer = pGeometry->GetVertexBuffer();
+				auto* pIndexBuffer = pGeometry->GetIndexBuffer();
+				if ((false == pGeometry->IsIndexed()) || (nullptr == pVertexBuffer) || (nullptr == pIndexBuffer))
+				{
+					LOG_WARNING("Mesh simplification needs indexed geometry!");
+					return nullptr;
+				}
+
+				auto* pVertexFormat = pVertexBuffer->GetFormat();
+				assert(pVertexFormat != nullptr);
+
+				if ((pVertexBuffer->GetData() == nullptr) || (pIndexBuffer->GetData() == nullptr) || (pIndexBuffer->GetIndexCount() % 3 != 0))
+				{
+					LOG_WARNING("Mesh simplification supports only triangle lists!");
+					return nullptr;
+				}
+
+				if ((false == pVertexFormat->HasVertexAttribute(VertexFormat::VertexAttribute::GE_VA_POSITION)) ||
+					(pVertexFormat->GetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_POSITION) != VertexFormat::AttributeType::GE_AT_FLOAT32))
+				{
+					LOG_WARNING("Mesh simplification needs float positions!");
+					return nullptr;
+				}
+
+				const uint32_t vertexCount = pVertexBuffer->GetVertexCount();
+				const uint32_t vertexStride = pVertexFormat->GetVertexTotalStride();
+				const uint32_t positionOffset = pVertexFormat->GetVertexAttributeOffset(VertexFormat::VertexAttribute::GE_VA_POSITION);
+				const uint32_t indexCount = pIndexBuffer->GetIndexCount();
+
+				// widen to 32 bit indices for processing
+				std::vector<uint32_t> indices(indexCount);
+				switch (pIndexBuffer->GetIndexType())
+				{
+				case IndexBuffer::IndexType::GE_IT_UINT32:
+					::memcpy(indices.data(), pIndexBuffer->GetData(), indexCount * sizeof(uint32_t));
+					break;
+				case IndexBuffer::IndexType::GE_IT_UINT16:
+					for (uint32_t i = 0; i < indexCount; ++i)
+					{
+						indices[i] = static_cast<const uint16_t*>(pIndexBuffer->GetData())[i];
+					}
+					break;
+				case IndexBuffer::IndexType::GE_IT_UINT8:
+					for (uint32_t i = 0; i < indexCount; ++i)
+					{
+						indices[i] = static_cast<const uint8_t*>(pIndexBuffer->GetData())[i];
+					}
+					break;
+				default:
+					LOG_ERROR("Invalid index type!");
+					return nullptr;
+				}
+
+				const uint32_t targetIndexCount = static_cast<uint32_t>(indexCount * ratio) / 3 * 3;
+
+				std::vector<uint32_t> simplifiedIndices(indexCount);
+				float32_t error = 0.0f;
+				const uint32_t simplifiedIndexCount = Simplify(indices.data(), indexCount, pVertexBuffer->GetData(), vertexCount, vertexStride, positionOffset,
+					targetIndexCount, maxError, simplifiedIndices.data(), &error);
+
+				if (0 == simplifiedIndexCount)
+				{
+					LOG_WARNING("Mesh simplification removed all the triangles!");
+					return nullptr;
+				}
+
+				// same index type as the source, the vertices are the same
+				std::vector<uint8_t> data;
+				switch (pIndexBuffer->GetIndexType())
+				{
+				case IndexBuffer::IndexType::GE_IT_UINT32:
+					data.resize(simplifiedIndexCount * sizeof(uint32_t));
+					::memcpy(data.data(), simplifiedIndices.data(), data.size());
+					break;
+				case IndexBuffer::IndexType::GE_IT_UINT16:
+					data.resize(simplifiedIndexCount * sizeof(uint16_t));
+					for (uint32_t i = 0; i < simplifiedIndexCount; ++i)
+					{
+						reinterpret_cast<uint16_t*>(data.data())[i] = static_cast<uint16_t>(simplifiedIndices[i]);
+					}
+					break;
+				case IndexBuffer::IndexType::GE_IT_UINT8:
+					data.resize(simplifiedIndexCount);
+					for (uint32_t i = 0; i < simplifiedIndexCount; ++i)
+					{
+						data[i] = static_cast<uint8_t>(simplifiedIndices[i]);
+					}
+					break;
+				default:
+					break;
+				}
+
+				auto* pSimplifiedIndexBuffer = GE_ALLOC(IndexBuffer)(pIndexBuffer->GetBufferUsage(), pIndexBuffer->GetIndexType(), data.data(), static_cast<uint32_t>(data.size()));
+				assert(pSimplifiedIndexBuffer != nullptr);
+
+				auto* pSimplified = GE_ALLOC(GeometricPrimitive);
+				assert(pSimplified != nullptr);
+
+				pSimplified->SetVertexBuffer(pVertexBuffer);
+				pSimplified->SetIndexBuffer(pSimplifiedIndexBuffer);
+
+				LOG_INFO("Mesh simplification - triangles: %u -> %u, error: %f", indexCount / 3, simplifiedIndexCount / 3, error);
+
+				if (pErrorOut)
+				{
+					*pErrorOut = error;
+				}
+
+				return pSimplified;
+			}
+		}
+	}
+}
\ No newline at end of file
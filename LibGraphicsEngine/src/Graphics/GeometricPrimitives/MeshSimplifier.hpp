@@ -0,0 +1,38 @@
+#ifndef GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_SIMPLIFIER_HPP
+#define GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_SIMPLIFIER_HPP
+
+#include "Foundation/TypeDefines.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class GeometricPrimitive;
+
+		/*
+			Mesh simplification of indexed triangle lists, used to build the levels of detail, see LODGeometryNode.
+			Quadric error metric edge collapses, each vertex is collapsed onto one of its neighbours (half edge collapse),
+			so the simplified indices use the same vertex buffer as the source.
+			- the vertices with the same position (UV/normal seams) and the border vertices are never removed
+			- a collapse is rejected if it flips a triangle or makes the mesh non manifold
+			The error is the square root of the quadric error of the worst collapse, close to the distance (model units)
+			between the simplified and the source surfaces.
+			All functions are deterministic, so the results are the same on every run/platform.
+			based on: Garland, Heckbert - Surface Simplification Using Quadric Error Metrics (SIGGRAPH 1997)
+		*/
+		namespace MeshSimplifier
+		{
+			// simplifies until the target index count is reached or the next collapse error is above maxError
+			// pIndicesOut must hold indexCount indices, returns the simplified index count
+			uint32_t Simplify(const uint32_t* pIndices, uint32_t indexCount, const void* pVertices, uint32_t vertexCount, uint32_t vertexStride, uint32_t positionOffset,
+				uint32_t targetIndexCount, float32_t maxError, uint32_t* pIndicesOut, float32_t* pErrorOut = nullptr);
+
+			// a new primitive with the same vertex buffer and a simplified index buffer with ratio * the source indices
+			// returns nullptr if the geometry is not supported (float positions, indexed triangle list)
+			// NOTE! The caller owns the new primitive, the index buffer is not freed by it (as for the other primitives)
+			GeometricPrimitive* SimplifyGeometricPrimitive(const GeometricPrimitive* pGeometry, float32_t ratio, float32_t maxError, float32_t* pErrorOut = nullptr);
+		}
+	}
+}
+
+#endif // GRAPHICS_GEOMETRIC_PRIMITIVES_MESH_SIMPLIFIER_HPP
\ No newline at end of file
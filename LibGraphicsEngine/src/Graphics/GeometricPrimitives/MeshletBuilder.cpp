@@ -0,0 +1,326 @@
+#include "Graphics/GeometricPrimitives/MeshletBuilder.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "Foundation/Logger.hpp"
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+#include <algorithm>
+#include <cmath> // std::sqrt()
+#include <cstring> // ::memcpy()
+#include <cassert>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		namespace MeshletBuilder
+		{
+			static const uint8_t INVALID_LOCAL_INDEX = 0xFF;
+			// below this the normal cone is too wide (> ~84 degrees half angle) to cull anything
+			static const float32_t MIN_CONE_DOT = 0.1f;
+
+			struct Triangle
+			{
+				uint32_t v[3];
+
+				bool operator <(const Triangle& other) const
+				{
+					return std::lexicographical_compare(v, v + 3, other.v, other.v + 3);
+				}
+
+				bool operator ==(const Triangle& other) const
+				{
+					return (v[0] == other.v[0]) && (v[1] == other.v[1]) && (v[2] == other.v[2]);
+				}
+			};
+
+			// rotates the triangle so the smallest index comes first, the winding is kept
+			static Triangle MakeTriangle(uint32_t a, uint32_t b, uint32_t c)
+			{
+				Triangle triangle;
+				if ((b < a) && (b < c))
+				{
+					triangle.v[0] = b; triangle.v[1] = c; triangle.v[2] = a;
+				}
+				else if ((c < a) && (c < b))
+				{
+					triangle.v[0] = c; triangle.v[1] = a; triangle.v[2] = b;
+				}
+				else
+				{
+					triangle.v[0] = a; triangle.v[1] = b; triangle.v[2] = c;
+				}
+				return triangle;
+			}
+
+			static glm::vec3 GetPosition(const uint8_t* pVertices, uint32_t vertexStride, uint32_t positionOffset, uint32_t index)
+			{
+				glm::vec3 position;
+				::memcpy(&position.x, pVertices + static_cast<size_t>(index) * vertexStride + positionOffset, sizeof(glm::vec3));
+
+				return position;
+			}
+
+			uint32_t BuildMeshlets(const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, ClusterTable& tableInOut,
+				uint32_t maxVertices, uint32_t maxTriangles)
+			{
+				assert(pIndices != nullptr);
+				assert((indexCount % 3) == 0);
+				assert((maxVertices >= 3) && (maxVertices < INVALID_LOCAL_INDEX));
+				assert(maxTriangles > 0);
+
+				const size_t firstMeshlet = tableInOut.meshlets.size();
+
+				std::vector<uint8_t> localIndices(vertexCount, INVALID_LOCAL_INDEX);
+
+				Meshlet meshlet{};
+				meshlet.vertexOffset = static_cast<uint32_t>(tableInOut.vertices.size());
+				meshlet.triangleOffset = static_cast<uint32_t>(tableInOut.triangles.size() / 3);
+
+				for (uint32_t i = 0; i < indexCount; i += 3)
+				{
+					const uint32_t a = pIndices[i], b = pIndices[i + 1], c = pIndices[i + 2];
+					assert((a < vertexCount) && (b < vertexCount) && (c < vertexCount));
+
+					const uint32_t newVertexCount = (localIndices[a] == INVALID_LOCAL_INDEX) +
+						((localIndices[b] == INVALID_LOCAL_INDEX) && (b != a)) +
+						((localIndices[c] == INVALID_LOCAL_INDEX) && (c != a) && (c != b));
+
+					if ((meshlet.vertexCount + newVertexCount > maxVertices) || (meshlet.triangleCount + 1 > maxTriangles))
+					{
+						tableInOut.meshlets.push_back(meshlet);
+
+						for (uint32_t v = meshlet.vertexOffset; v < meshlet.vertexOffset + meshlet.vertexCount; ++v)
+						{
+							localIndices[tableInOut.vertices[v]] = INVALID_LOCAL_INDEX;
+						}
+
+						meshlet = Meshlet{};
+						meshlet.vertexOffset = static_cast<uint32_t>(tableInOut.vertices.size());
+						meshlet.triangleOffset = static_cast<uint32_t>(tableInOut.triangles.size() / 3);
+						meshlet.firstIndex = i;
+					}
+
+					for (uint32_t k = 0; k < 3; ++k)
+					{
+						const uint32_t vertex = pIndices[i + k];
+						if (localIndices[vertex] == INVALID_LOCAL_INDEX)
+						{
+							localIndices[vertex] = static_cast<uint8_t>(meshlet.vertexCount++);
+							tableInOut.vertices.push_back(vertex);
+						}
+						tableInOut.triangles.push_back(localIndices[vertex]);
+					}
+					meshlet.triangleCount++;
+				}
+
+				if (meshlet.triangleCount > 0)
+				{
+					tableInOut.meshlets.push_back(meshlet);
+				}
+
+				return static_cast<uint32_t>(tableInOut.meshlets.size() - firstMeshlet);
+			}
+
+			void ComputeMeshletBounds(ClusterTable& tableInOut, uint32_t firstMeshlet, const void* pVertices, uint32_t vertexStride, uint32_t positionOffset)
+			{
+				assert(pVertices != nullptr);
+				assert(firstMeshlet <= tableInOut.meshlets.size());
+
+				const uint8_t* pVertexData = reinterpret_cast<const uint8_t*>(pVertices);
+
+				tableInOut.bounds.resize(tableInOut.meshlets.size());
+
+				std::vector<glm::vec3> normals;
+				std::vector<glm::vec3> corners; // first vertex of each triangle with a valid normal
+
+				for (size_t m = firstMeshlet; m < tableInOut.meshlets.size(); ++m)
+				{
+					const Meshlet& meshlet = tableInOut.meshlets[m];
+					MeshletBounds& bounds = tableInOut.bounds[m];
+					assert(meshlet.vertexCount > 0);
+
+					const uint32_t* pMeshletVertices = &tableInOut.vertices[meshlet.vertexOffset];
+					const uint8_t* pMeshletTriangles = &tableInOut.triangles[meshlet.triangleOffset * 3];
+
+					// bounding sphere - Ritter
+					const glm::vec3 first = GetPosition(pVertexData, vertexStride, positionOffset, pMeshletVertices[0]);
+					glm::vec3 pointX = first, pointY = first;
+					float32_t maxDistance = 0.0f;
+					for (uint32_t v = 0; v < meshlet.vertexCount; ++v)
+					{
+						const glm::vec3 position = GetPosition(pVertexData, vertexStride, positionOffset, pMeshletVertices[v]);
+						const float32_t distance = glm::distance(position, first);
+						if (distance > maxDistance)
+						{
+							maxDistance = distance;
+							pointX = position;
+						}
+					}
+					maxDistance = 0.0f;
+					for (uint32_t v = 0; v < meshlet.vertexCount; ++v)
+					{
+						const glm::vec3 position = GetPosition(pVertexData, vertexStride, positionOffset, pMeshletVertices[v]);
+						const float32_t distance = glm::distance(position, pointX);
+						if (distance > maxDistance)
+						{
+							maxDistance = distance;
+							pointY = position;
+						}
+					}
+
+					bounds.center = (pointX + pointY) * 0.5f;
+					bounds.radius = maxDistance * 0.5f;
+					for (uint32_t v = 0; v < meshlet.vertexCount; ++v)
+					{
+						const glm::vec3 position = GetPosition(pVertexData, vertexStride, positionOffset, pMeshletVertices[v]);
+						const float32_t distance = glm::distance(position, bounds.center);
+						if (distance > bounds.radius)
+						{
+							const float32_t newRadius = (bounds.radius + distance) * 0.5f;
+							bounds.center += (position - bounds.center) * ((newRadius - bounds.radius) / distance);
+							bounds.radius = newRadius;
+						}
+					}
+
+					// normal cone
+					normals.clear();
+					corners.clear();
+					glm::vec3 normalSum(0.0f);
+					for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+					{
+						const glm::vec3 p0 = GetPosition(pVertexData, vertexStride, positionOffset, pMeshletVertices[pMeshletTriangles[t * 3 + 0]]);
+						const glm::vec3 p1 = GetPosition(pVertexData, vertexStride, positionOffset, pMeshletVertices[pMeshletTriangles[t * 3 + 1]]);
+						const glm::vec3 p2 = GetPosition(pVertexData, vertexStride, positionOffset, pMeshletVertices[pMeshletTriangles[t * 3 + 2]]);
+
+						const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+						const float32_t area = glm::length(normal);
+						if (area > 0.0f) // degenerate triangles are never visible
+						{
+							normals.push_back(normal / area);
+							corners.push_back(p0);
+							normalSum += normals.back();
+						}
+					}
+
+					bounds.coneApex = bounds.center;
+					bounds.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+					bounds.coneCutoff = 1.0f;
+
+					const float32_t sumLength = glm::length(normalSum);
+					if (sumLength <= 0.0f)
+						continue;
+
+					const glm::vec3 axis = normalSum / sumLength;
+
+					float32_t minDot = 1.0f;
+					for (const auto& normal : normals)
+					{
+						minDot = glm::min(minDot, glm::dot(axis, normal));
+					}
+
+					if (minDot <= MIN_CONE_DOT)
+						continue;
+
+					// move the apex back along the axis until all triangle planes are in front of it
+					float32_t maxT = 0.0f;
+					for (size_t t = 0; t < normals.size(); ++t)
+					{
+						const float32_t distanceToPlane = glm::dot(bounds.center - corners[t], normals[t]);
+						maxT = glm::max(maxT, distanceToPlane / glm::dot(axis, normals[t]));
+					}
+
+					bounds.coneApex = bounds.center - axis * maxT;
+					bounds.coneAxis = axis;
+					bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+				}
+			}
+
+			bool_t ValidateMeshlets(const ClusterTable& table, uint32_t firstMeshlet, uint32_t meshletCount, const uint32_t* pIndices, uint32_t indexCount,
+				uint32_t maxVertices, uint32_t maxTriangles)
+			{
+				assert(pIndices != nullptr);
+
+				if (firstMeshlet + meshletCount > table.meshlets.size())
+				{
+					LOG_ERROR("Invalid meshlet range!");
+					return false;
+				}
+
+				std::vector<Triangle> meshletTriangles;
+				meshletTriangles.reserve(indexCount / 3);
+
+				for (uint32_t m = firstMeshlet; m < firstMeshlet + meshletCount; ++m)
+				{
+					const Meshlet& meshlet = table.meshlets[m];
+
+					if ((meshlet.vertexCount > maxVertices) || (meshlet.triangleCount > maxTriangles) || (meshlet.triangleCount == 0) ||
+						(meshlet.vertexOffset + meshlet.vertexCount > table.vertices.size()) ||
+						((meshlet.triangleOffset + meshlet.triangleCount) * 3 > table.triangles.size()) ||
+						(meshlet.firstIndex + meshlet.triangleCount * 3 > indexCount))
+					{
+						LOG_ERROR("Meshlet %u is out of limits!", m);
+						return false;
+					}
+
+					for (uint32_t t = 0; t < meshlet.triangleCount; ++t)
+					{
+						uint32_t v[3] = {};
+						for (uint32_t k = 0; k < 3; ++k)
+						{
+							const uint8_t localIndex = table.triangles[(meshlet.triangleOffset + t) * 3 + k];
+							if (localIndex >= meshlet.vertexCount)
+							{
+								LOG_ERROR("Meshlet %u has an invalid local index!", m);
+								return false;
+							}
+							v[k] = table.vertices[meshlet.vertexOffset + localIndex];
+
+							// the meshlet must be drawable as a range of the source index buffer
+							if (v[k] != pIndices[meshlet.firstIndex + t * 3 + k])
+							{
+								LOG_ERROR("Meshlet %u does not match its source index range!", m);
+								return false;
+							}
+						}
+						meshletTriangles.push_back(MakeTriangle(v[0], v[1], v[2]));
+					}
+				}
+
+				std::vector<Triangle> sourceTriangles;
+				sourceTriangles.reserve(indexCount / 3);
+				for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+				{
+					sourceTriangles.push_back(MakeTriangle(pIndices[i], pIndices[i + 1], pIndices[i + 2]));
+				}
+
+				std::sort(meshletTriangles.begin(), meshletTriangles.end());
+				std::sort(sourceTriangles.begin(), sourceTriangles.end());
+
+				if (meshletTriangles != sourceTriangles)
+				{
+					LOG_ERROR("Meshlet triangles do not match the source triangles - %u vs %u triangles", static_cast<uint32_t>(meshletTriangles.size()), static_cast<uint32_t>(sourceTriangles.size()));
+					return false;
+				}
+
+				return true;
+			}
+
+			bool_t IsMeshletVisible(const MeshletBounds& bounds, const Frustum& frustum, const glm::vec3& cameraPosition)
+			{
+				if (false == frustum.IntersectsSphere(bounds.center, bounds.radius))
+					return false;
+
+				if (bounds.coneCutoff < 1.0f)
+				{
+					const glm::vec3 toApex = bounds.coneApex - cameraPosition;
+					const float32_t distance = glm::length(toApex);
+
+					if ((distance > 0.0f) && (glm::dot(toApex, bounds.coneAxis) >= bounds.coneCutoff * distance))
+						return false;
+				}
+
+				return true;
+			}
+		}
+	}
+}
\ No newline at end of file
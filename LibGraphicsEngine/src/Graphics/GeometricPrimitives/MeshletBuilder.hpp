@@ -0,0 +1,73 @@
+#ifndef GRAPHICS_GEOMETRIC_PRIMITIVES_MESHLET_BUILDER_HPP
+#define GRAPHICS_GEOMETRIC_PRIMITIVES_MESHLET_BUILDER_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "glm/vec3.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Frustum;
+
+		/*
+			Splits indexed triangle lists into small clusters (meshlets) with culling data.
+			The builder keeps the triangle order, so each meshlet is also a contiguous range of the source index buffer
+			and can be drawn with a plain indexed draw. Best results after MeshOptimizer::OptimizeVertexCache().
+			based on: https://github.com/zeux/meshoptimizer - clusterizer
+		*/
+		namespace MeshletBuilder
+		{
+			static const uint32_t MAX_VERTICES = 64;
+			static const uint32_t MAX_TRIANGLES = 124; // 124 * 3 local indices + 64 vertices fit nicely in mesh shader limits
+
+			struct Meshlet
+			{
+				uint32_t vertexOffset; // in ClusterTable::vertices
+				uint32_t triangleOffset; // in ClusterTable::triangles, 3 local indices per triangle
+				uint32_t vertexCount;
+				uint32_t triangleCount;
+				uint32_t firstIndex; // first index of the meshlet triangles in the source index buffer
+			};
+
+			struct MeshletBounds
+			{
+				// bounding sphere
+				glm::vec3 center;
+				float32_t radius;
+
+				// normal cone, the meshlet is backfacing if: dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff
+				glm::vec3 coneApex;
+				glm::vec3 coneAxis;
+				float32_t coneCutoff; // 1 if the cone is too wide to be used
+			};
+
+			struct ClusterTable
+			{
+				std::vector<MeshletBuilder::Meshlet> meshlets;
+				std::vector<MeshletBuilder::MeshletBounds> bounds; // one per meshlet
+				std::vector<uint32_t> vertices; // meshlet vertex -> source vertex index
+				std::vector<uint8_t> triangles; // meshlet local vertex indices
+			};
+
+			// appends the meshlets of the triangle list to the table, all indices must be < vertexCount
+			// returns the number of meshlets added
+			uint32_t BuildMeshlets(const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, ClusterTable& tableInOut,
+				uint32_t maxVertices = MAX_VERTICES, uint32_t maxTriangles = MAX_TRIANGLES);
+
+			// computes the bounds of meshlets [firstMeshlet, meshlets.size()), positions are float32 x 3
+			// NOTE! Front faces are counter clockwise (glTF convention)
+			void ComputeMeshletBounds(ClusterTable& tableInOut, uint32_t firstMeshlet, const void* pVertices, uint32_t vertexStride, uint32_t positionOffset);
+
+			// re-assembles the triangles of meshlets [firstMeshlet, firstMeshlet + meshletCount) and checks them against the source triangles
+			bool_t ValidateMeshlets(const ClusterTable& table, uint32_t firstMeshlet, uint32_t meshletCount, const uint32_t* pIndices, uint32_t indexCount,
+				uint32_t maxVertices = MAX_VERTICES, uint32_t maxTriangles = MAX_TRIANGLES);
+
+			// frustum + backface cone test, frustum and camera position in the same space as the vertex positions
+			bool_t IsMeshletVisible(const MeshletBounds& bounds, const Frustum& frustum, const glm::vec3& cameraPosition);
+		}
+	}
+}
+
+#endif // GRAPHICS_GEOMETRIC_PRIMITIVES_MESHLET_BUILDER_HPP
\ No newline at end of file
@@ -4,12 +4,15 @@
 #include "Graphics/Rendering/Backends/Vulkan/VulkanRenderer.hpp"
 #elif defined(OPENGL_RENDERER)
 #include "Graphics/Rendering/Backends/OpenGL/OpenGLRenderer.hpp"
+#elif defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/NullRenderer.hpp"
 #endif // 
 #include "Graphics/Rendering/RenderQueue.hpp"
 #include "Graphics/SceneGraph/Node.hpp"
 #include "Graphics/SceneGraph/Visitors/ComputeRenderQueueVisitor.hpp"
 #include "Graphics/Cameras/FPSCamera.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Profiler.hpp"
 #include <cassert>
 
 using namespace GraphicsEngine;
@@ -42,10 +45,17 @@ void GraphicsSystem::Init(Platform::Window* pWindow)
 
 	//TODO - for now the vulkan renderer supports only one view - viewport
 	// use Vulkan renderer
+#if defined(DEFERRED_RENDERING)
+	const auto rendererType = Renderer::RendererType::GE_RT_DEFERRED;
+#else
+	const auto rendererType = Renderer::RendererType::GE_RT_FORWARD;
+#endif // DEFERRED_RENDERING
 #if defined(VULKAN_RENDERER)
-	mpRenderer = GE_ALLOC(VulkanRenderer)(pWindow);
+	mpRenderer = GE_ALLOC(VulkanRenderer)(pWindow, rendererType);
 #elif defined(OPENGL_RENDERER)
-	mpRenderer = GE_ALLOC(OpenGLRenderer)(pWindow);
+	mpRenderer = GE_ALLOC(OpenGLRenderer)(pWindow, rendererType);
+#elif defined(NULL_RENDERER)
+	mpRenderer = GE_ALLOC(NullRenderer)(pWindow, rendererType);
 #else
 	// other
 #endif // 
@@ -84,6 +94,8 @@ void GraphicsSystem::Terminate()
 
 void GraphicsSystem::Run(float32_t crrTime)
 {
+	GE_PROFILE_FUNCTION();
+
 	UpdateFrame(crrTime);
 	RenderFrame();
 	SubmitFrame();
@@ -95,7 +107,7 @@ void GraphicsSystem::RenderFrame()
 #if defined(VULKAN_RENDERER)
 	// The scene has already been rendered !!!
 	// Nothing to do here for the Vulkan API
-#elif defined(OPENGL_RENDERER)
+#elif defined(OPENGL_RENDERER) || defined(NULL_RENDERER)
 	mpRenderer->RenderFrame(mpRenderQueue);
 #endif // 
 }
@@ -106,7 +118,7 @@ void GraphicsSystem::UpdateFrame(float32_t crrTime)
 
 #if defined(VULKAN_RENDERER)
 	mpRenderer->UpdateFrame(mpMainCamera, crrTime);
-#elif defined(OPENGL_RENDERER)
+#elif defined(OPENGL_RENDERER) || defined(NULL_RENDERER)
 	mpRenderer->UpdateFrame(mpMainCamera, crrTime);
 #endif // 
 }
@@ -118,13 +130,15 @@ void GraphicsSystem::SubmitFrame()
 #if defined(VULKAN_RENDERER)
 	// here we just submit & present the frame to GPU
 	mpRenderer->SubmitFrame();
-#elif defined(OPENGL_RENDERER)
+#elif defined(OPENGL_RENDERER) || defined(NULL_RENDERER)
 	mpRenderer->SubmitFrame();
 #endif //
 }
 
 void GraphicsSystem::ComputeRenderQueue()
 {
+	GE_PROFILE_FUNCTION();
+
 	assert(mpScene != nullptr);
 	assert(mpRenderQueue != nullptr);
 
@@ -135,6 +149,8 @@ void GraphicsSystem::ComputeRenderQueue()
 
 void GraphicsSystem::ComputeGraphicsResources()
 {
+	GE_PROFILE_FUNCTION();
+
 	//NOTE! To be called after the renderqueue has been populated
 
 	assert(mpRenderer != nullptr);
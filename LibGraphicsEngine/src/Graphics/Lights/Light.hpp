@@ -35,6 +35,10 @@ namespace GraphicsEngine
 			virtual const glm::vec3& GetPosition() const { return glm::vec3(0.0f); };
 			virtual void SetPosition(const glm::vec3& pos) {};
 
+			// distance at which the light has no effect, 0 for the lights without a position
+			virtual float32_t GetRange() const { return 0.0f; };
+			virtual void SetRange(float32_t range) {};
+
 			virtual const Color3f& GetColor() const;
 			virtual void SetColor(const Color3f& color);
 
@@ -0,0 +1,458 @@
+#include "Graphics/Lights/LightClusterGrid.hpp"
+#include "Graphics/Lights/Light.hpp"
+#include "Graphics/Lights/SpotLight.hpp"
+#include "Foundation/TaskScheduler.hpp"
+#include "Foundation/Profiler.hpp"
+#include "Core/AppConfig.hpp" // RIGHT_HAND_COORDINATES, LEFT_HAND_COORDINATES
+#include "glm/trigonometric.hpp" // radians()
+#include "glm/matrix.hpp" // inverse()
+#include <algorithm> // std::min(), std::max()
+#include <cstring> // ::memcpy()
+#include <cmath> // std::log(), std::floor()
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define GE_LIGHT_CLUSTER_GRID_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// smallest depth of the slices, avoids log(0)
+static const float32_t MIN_Z_NEAR = 0.001f;
+
+static uint32_t AlignTo4(uint32_t count)
+{
+	return (count + 3) & ~3u;
+}
+
+// squared distances from c to the [begin, end) tile columns (or rows) of a slice, the tile borders are given as slopes
+// NOTE! Both the SSE2 and scalar paths do the same float operations, so they give the same results
+static void ComputeDistances2(const float32_t* pSlopes, uint32_t begin, uint32_t end, float32_t zMin, float32_t zMax, float32_t c, float32_t* pOut)
+{
+#if defined(GE_LIGHT_CLUSTER_GRID_SSE2)
+	const __m128 zMin4 = _mm_set1_ps(zMin);
+	const __m128 zMax4 = _mm_set1_ps(zMax);
+	const __m128 c4 = _mm_set1_ps(c);
+	const __m128 zero = _mm_setzero_ps();
+
+	// the arrays are padded to 4
+	for (uint32_t i = begin & ~3u; i < end; i += 4)
+	{
+		const __m128 s0 = _mm_loadu_ps(pSlopes + i);
+		const __m128 s1 = _mm_loadu_ps(pSlopes + i + 1);
+
+		const __m128 tileMin = _mm_min_ps(_mm_mul_ps(s0, zMin4), _mm_mul_ps(s0, zMax4));
+		const __m128 tileMax = _mm_max_ps(_mm_mul_ps(s1, zMin4), _mm_mul_ps(s1, zMax4));
+
+		const __m128 d = _mm_max_ps(_mm_max_ps(_mm_sub_ps(tileMin, c4), _mm_sub_ps(c4, tileMax)), zero);
+
+		_mm_storeu_ps(pOut + i, _mm_mul_ps(d, d));
+	}
+#else
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const float32_t tileMin = std::min(pSlopes[i] * zMin, pSlopes[i] * zMax);
+		const float32_t tileMax = std::max(pSlopes[i + 1] * zMin, pSlopes[i + 1] * zMax);
+
+		const float32_t d = std::max(std::max(tileMin - c, c - tileMax), 0.0f);
+
+		pOut[i] = d * d;
+	}
+#endif // GE_LIGHT_CLUSTER_GRID_SSE2
+}
+
+// tile range covered by the [minSlope, maxSlope] range, returns false if it's outside of the grid
+static bool_t ComputeTileRange(float32_t minSlope, float32_t maxSlope, float32_t scale, float32_t bias, uint32_t tileCount, uint32_t& beginOut, uint32_t& endOut)
+{
+	const float32_t minTile = std::floor(minSlope * scale + bias);
+	const float32_t maxTile = std::floor(maxSlope * scale + bias);
+
+	if ((maxTile < 0.0f) || (minTile >= static_cast<float32_t>(tileCount)))
+		return false;
+
+	beginOut = static_cast<uint32_t>(std::max(minTile, 0.0f));
+	endOut = static_cast<uint32_t>(std::min(maxTile, static_cast<float32_t>(tileCount - 1))) + 1;
+
+	return true;
+}
+
+const uint32_t LightClusterGrid::MAX_LIGHT_COUNT;
+const uint32_t LightClusterGrid::MAX_LIGHT_INDEX_COUNT;
+
+LightClusterGrid::LightClusterGrid()
+	: LightClusterGrid(DEFAULT_TILE_COUNT_X, DEFAULT_TILE_COUNT_Y, DEFAULT_SLICE_COUNT)
+{}
+
+LightClusterGrid::LightClusterGrid(uint32_t tileCountX, uint32_t tileCountY, uint32_t sliceCount)
+	: mTileCountX(0)
+	, mTileCountY(0)
+	, mSliceCount(0)
+	, mSlopeScaleX(0.0f)
+	, mSlopeScaleY(0.0f)
+	, mGridInfo()
+{
+	Init(tileCountX, tileCountY, sliceCount);
+}
+
+LightClusterGrid::~LightClusterGrid()
+{}
+
+void LightClusterGrid::Init(uint32_t tileCountX, uint32_t tileCountY, uint32_t sliceCount)
+{
+	assert(tileCountX > 0);
+	assert(tileCountY > 0);
+	assert(sliceCount > 0);
+
+	mTileCountX = tileCountX;
+	mTileCountY = tileCountY;
+	mSliceCount = sliceCount;
+
+	// the border slopes, padded for the last 4 tiles
+	mTileSlopeX.resize(AlignTo4(mTileCountX) + 1, 0.0f);
+	mTileSlopeY.resize(AlignTo4(mTileCountY) + 1, 0.0f);
+
+	mSlices.resize(mSliceCount);
+	for (auto& slice : mSlices)
+	{
+		slice.zMin = 0.0f;
+		slice.zMax = 0.0f;
+		slice.distX2.resize(AlignTo4(mTileCountX), 0.0f);
+		slice.distY2.resize(AlignTo4(mTileCountY), 0.0f);
+	}
+
+	mClusters.resize(mTileCountX * mTileCountY * mSliceCount);
+
+	mGridInfo.view = glm::mat4(1.0f);
+	mGridInfo.cameraPosition = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	mGridInfo.counts = glm::uvec4(mTileCountX, mTileCountY, mSliceCount, 0);
+}
+
+void LightClusterGrid::Update(const glm::mat4& view, const glm::mat4& proj, float32_t zNear, float32_t zFar, const std::vector<const Light*>& lights)
+{
+	GE_PROFILE_FUNCTION();
+
+	assert(zFar > zNear);
+
+	zNear = std::max(zNear, MIN_Z_NEAR);
+
+	// tiles - view space slope to tile coordinates
+	// the slopes visible by a symmetric perspective projection are in [-1 / proj[0][0], 1 / proj[0][0]]
+	mSlopeScaleX = 0.5f * static_cast<float32_t>(mTileCountX) * std::abs(proj[0][0]);
+	mSlopeScaleY = 0.5f * static_cast<float32_t>(mTileCountY) * std::abs(proj[1][1]);
+	const float32_t biasX = 0.5f * static_cast<float32_t>(mTileCountX);
+	const float32_t biasY = 0.5f * static_cast<float32_t>(mTileCountY);
+
+	for (uint32_t i = 0; i < mTileSlopeX.size(); ++i)
+	{
+		mTileSlopeX[i] = (static_cast<float32_t>(std::min(i, mTileCountX)) - biasX) / mSlopeScaleX;
+	}
+	for (uint32_t i = 0; i < mTileSlopeY.size(); ++i)
+	{
+		mTileSlopeY[i] = (static_cast<float32_t>(std::min(i, mTileCountY)) - biasY) / mSlopeScaleY;
+	}
+
+	// slices - exponential in depth, slice = log(depth / zNear) / log(zFar / zNear) * sliceCount
+	const float32_t sliceScale = static_cast<float32_t>(mSliceCount) / std::log(zFar / zNear);
+	const float32_t sliceBias = -std::log(zNear) * sliceScale;
+
+	for (uint32_t i = 0; i < mSliceCount; ++i)
+	{
+		mSlices[i].zMin = zNear * std::pow(zFar / zNear, static_cast<float32_t>(i) / static_cast<float32_t>(mSliceCount));
+		mSlices[i].zMax = zNear * std::pow(zFar / zNear, static_cast<float32_t>(i + 1) / static_cast<float32_t>(mSliceCount));
+	}
+
+	ComputeLightBounds(view, lights);
+
+	mGridInfo.view = view;
+#if !defined(LEFT_HAND_COORDINATES)
+	// the camera looks along -z
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		mGridInfo.view[i][2] = -view[i][2];
+	}
+#endif // LEFT_HAND_COORDINATES
+	mGridInfo.cameraPosition = glm::inverse(view)[3];
+	mGridInfo.counts = glm::uvec4(mTileCountX, mTileCountY, mSliceCount, static_cast<uint32_t>(mLights.size()));
+	mGridInfo.tileScale = glm::vec4(mSlopeScaleX, mSlopeScaleY, biasX, biasY);
+	mGridInfo.sliceScaleBias = glm::vec4(sliceScale, sliceBias, zNear, zFar);
+
+	// each slice writes only its clusters and its own lists
+	TaskScheduler::ParallelFor(0, mSliceCount, 1, [this](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t sliceIdx = begin; sliceIdx < end; ++sliceIdx)
+			{
+				BinSlice(sliceIdx);
+			}
+		});
+
+	// the slice lists, one after another
+	std::vector<uint32_t> sliceOffsets(mSliceCount, 0);
+	uint32_t indexCount = 0;
+	for (uint32_t i = 0; i < mSliceCount; ++i)
+	{
+		sliceOffsets[i] = indexCount;
+		indexCount += static_cast<uint32_t>(mSlices[i].indices.size());
+	}
+
+	mLightIndices.resize(indexCount);
+
+	const uint32_t clustersPerSlice = mTileCountX * mTileCountY;
+	TaskScheduler::ParallelFor(0, mSliceCount, 1, [this, &sliceOffsets, clustersPerSlice](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t sliceIdx = begin; sliceIdx < end; ++sliceIdx)
+			{
+				const auto& indices = mSlices[sliceIdx].indices;
+				if (false == indices.empty())
+				{
+					::memcpy(mLightIndices.data() + sliceOffsets[sliceIdx], indices.data(), indices.size() * sizeof(uint32_t));
+				}
+
+				ClusterRange* pClusters = mClusters.data() + sliceIdx * clustersPerSlice;
+				for (uint32_t i = 0; i < clustersPerSlice; ++i)
+				{
+					pClusters[i].offset += sliceOffsets[sliceIdx];
+				}
+			}
+		});
+}
+
+void LightClusterGrid::ComputeLightBounds(const glm::mat4& view, const std::vector<const Light*>& lights)
+{
+	mLights.clear();
+	mBoundX.clear();
+	mBoundY.clear();
+	mBoundZ.clear();
+	mBoundRadius.clear();
+
+	for (auto* pLight : lights)
+	{
+		assert(pLight != nullptr);
+
+		const auto lightType = pLight->GetLightType();
+		if ((lightType != Light::LightType::GE_LT_POINT) && (lightType != Light::LightType::GE_LT_SPOT))
+			continue;
+
+		GPULight gpuLight;
+		gpuLight.positionRange = glm::vec4(pLight->GetPosition(), pLight->GetRange());
+		gpuLight.colorType = glm::vec4(pLight->GetColor(), static_cast<float32_t>(lightType));
+		gpuLight.directionCosAngle = glm::vec4(0.0f);
+
+		// world space bounding sphere
+		glm::vec3 center = pLight->GetPosition();
+		float32_t radius = pLight->GetRange();
+
+		if (Light::LightType::GE_LT_SPOT == lightType)
+		{
+			auto* pSpotLight = static_cast<const SpotLight*>(pLight);
+
+			const glm::vec3& dir = pSpotLight->GetDirection();
+			const float32_t angle = pSpotLight->GetConeAngle();
+			const float32_t cosAngle = std::cos(angle);
+
+			gpuLight.directionCosAngle = glm::vec4(dir, cosAngle);
+
+			// the smallest sphere containing the cone
+			// based on: https://bartwronski.com/2017/04/13/cull-that-cone/
+			if (angle > glm::radians(45.0f))
+			{
+				center += dir * (cosAngle * radius);
+				radius *= std::sin(angle);
+			}
+			else
+			{
+				radius *= 0.5f / cosAngle;
+				center += dir * radius;
+			}
+		}
+
+		const glm::vec4 viewCenter = view * glm::vec4(center, 1.0f);
+
+		mBoundX.push_back(viewCenter.x);
+		mBoundY.push_back(viewCenter.y);
+#if defined(LEFT_HAND_COORDINATES)
+		mBoundZ.push_back(viewCenter.z);
+#else
+		// the camera looks along -z
+		mBoundZ.push_back(-viewCenter.z);
+#endif // LEFT_HAND_COORDINATES
+		mBoundRadius.push_back(radius);
+
+		mLights.push_back(gpuLight);
+	}
+}
+
+void LightClusterGrid::BinSlice(uint32_t sliceIdx)
+{
+	assert(sliceIdx < mSliceCount);
+
+	auto& slice = mSlices[sliceIdx];
+	slice.pairs.clear();
+
+	const float32_t zMin = slice.zMin;
+	const float32_t zMax = slice.zMax;
+
+	const float32_t biasX = 0.5f * static_cast<float32_t>(mTileCountX);
+	const float32_t biasY = 0.5f * static_cast<float32_t>(mTileCountY);
+
+	const uint32_t lightCount = static_cast<uint32_t>(mLights.size());
+	for (uint32_t lightIdx = 0; lightIdx < lightCount; ++lightIdx)
+	{
+		const float32_t x = mBoundX[lightIdx];
+		const float32_t y = mBoundY[lightIdx];
+		const float32_t z = mBoundZ[lightIdx];
+		const float32_t r = mBoundRadius[lightIdx];
+
+		if ((z + r < zMin) || (z - r > zMax))
+			continue;
+
+		const float32_t dz = std::max(std::max(zMin - z, z - zMax), 0.0f);
+		const float32_t r2 = r * r - dz * dz;
+
+		// conservative tile ranges - the slopes of the sphere box, clipped to the slice
+		const float32_t zLo = std::max(zMin, z - r);
+		const float32_t zHi = std::min(zMax, z + r);
+
+		uint32_t beginX = 0, endX = 0, beginY = 0, endY = 0;
+		if (false == ComputeTileRange(std::min((x - r) / zLo, (x - r) / zHi), std::max((x + r) / zLo, (x + r) / zHi), mSlopeScaleX, biasX, mTileCountX, beginX, endX))
+			continue;
+		if (false == ComputeTileRange(std::min((y - r) / zLo, (y - r) / zHi), std::max((y + r) / zLo, (y + r) / zHi), mSlopeScaleY, biasY, mTileCountY, beginY, endY))
+			continue;
+
+		// exact sphere - cluster AABB test, the AABB is separable in x, y and z
+		ComputeDistances2(mTileSlopeX.data(), beginX, endX, zMin, zMax, x, slice.distX2.data());
+		ComputeDistances2(mTileSlopeY.data(), beginY, endY, zMin, zMax, y, slice.distY2.data());
+
+		for (uint32_t tileY = beginY; tileY < endY; ++tileY)
+		{
+			const float32_t remaining = r2 - slice.distY2[tileY];
+			if (remaining < 0.0f)
+				continue;
+
+			const uint32_t rowCluster = tileY * mTileCountX;
+
+#if defined(GE_LIGHT_CLUSTER_GRID_SSE2)
+			const __m128 remaining4 = _mm_set1_ps(remaining);
+			for (uint32_t tileX = beginX & ~3u; tileX < endX; tileX += 4)
+			{
+				const int32_t mask = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(slice.distX2.data() + tileX), remaining4));
+				if (0 == mask)
+					continue;
+
+				for (uint32_t bit = 0; bit < 4; ++bit)
+				{
+					const uint32_t tile = tileX + bit;
+					if ((mask & (1 << bit)) && (tile >= beginX) && (tile < endX))
+					{
+						slice.pairs.push_back(rowCluster + tile);
+						slice.pairs.push_back(lightIdx);
+					}
+				}
+			}
+#else
+			for (uint32_t tileX = beginX; tileX < endX; ++tileX)
+			{
+				if (slice.distX2[tileX] <= remaining)
+				{
+					slice.pairs.push_back(rowCluster + tileX);
+					slice.pairs.push_back(lightIdx);
+				}
+			}
+#endif // GE_LIGHT_CLUSTER_GRID_SSE2
+		}
+	}
+
+	// counting sort by cluster, stable, so the lights of a cluster stay sorted
+	const uint32_t clustersPerSlice = mTileCountX * mTileCountY;
+	ClusterRange* pClusters = mClusters.data() + sliceIdx * clustersPerSlice;
+
+	for (uint32_t i = 0; i < clustersPerSlice; ++i)
+	{
+		pClusters[i].offset = 0;
+		pClusters[i].count = 0;
+	}
+
+	const uint32_t pairCount = static_cast<uint32_t>(slice.pairs.size() / 2);
+	for (uint32_t i = 0; i < pairCount; ++i)
+	{
+		pClusters[slice.pairs[2 * i]].count++;
+	}
+
+	uint32_t offset = 0;
+	for (uint32_t i = 0; i < clustersPerSlice; ++i)
+	{
+		pClusters[i].offset = offset;
+		offset += pClusters[i].count;
+	}
+
+	slice.indices.resize(pairCount);
+	for (uint32_t i = 0; i < pairCount; ++i)
+	{
+		auto& cluster = pClusters[slice.pairs[2 * i]];
+		slice.indices[cluster.offset++] = slice.pairs[2 * i + 1];
+	}
+
+	// back to the first index of each cluster
+	for (uint32_t i = 0; i < clustersPerSlice; ++i)
+	{
+		pClusters[i].offset -= pClusters[i].count;
+	}
+}
+
+const std::vector<LightClusterGrid::GPULight>& LightClusterGrid::GetLights() const
+{
+	return mLights;
+}
+
+const std::vector<LightClusterGrid::ClusterRange>& LightClusterGrid::GetClusters() const
+{
+	return mClusters;
+}
+
+const std::vector<uint32_t>& LightClusterGrid::GetLightIndices() const
+{
+	return mLightIndices;
+}
+
+const LightClusterGrid::GridInfo& LightClusterGrid::GetGridInfo() const
+{
+	return mGridInfo;
+}
+
+uint32_t LightClusterGrid::GetClusterCount() const
+{
+	return static_cast<uint32_t>(mClusters.size());
+}
+
+uint32_t LightClusterGrid::GetTileCountX() const
+{
+	return mTileCountX;
+}
+
+uint32_t LightClusterGrid::GetTileCountY() const
+{
+	return mTileCountY;
+}
+
+uint32_t LightClusterGrid::GetSliceCount() const
+{
+	return mSliceCount;
+}
+
+void LightClusterGrid::GetClusterBounds(uint32_t tileX, uint32_t tileY, uint32_t slice, glm::vec3& minOut, glm::vec3& maxOut) const
+{
+	assert(tileX < mTileCountX);
+	assert(tileY < mTileCountY);
+	assert(slice < mSliceCount);
+
+	const float32_t zMin = mSlices[slice].zMin;
+	const float32_t zMax = mSlices[slice].zMax;
+
+	minOut.x = std::min(mTileSlopeX[tileX] * zMin, mTileSlopeX[tileX] * zMax);
+	maxOut.x = std::max(mTileSlopeX[tileX + 1] * zMin, mTileSlopeX[tileX + 1] * zMax);
+	minOut.y = std::min(mTileSlopeY[tileY] * zMin, mTileSlopeY[tileY] * zMax);
+	maxOut.y = std::max(mTileSlopeY[tileY + 1] * zMin, mTileSlopeY[tileY + 1] * zMax);
+	minOut.z = zMin;
+	maxOut.z = zMax;
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef GRAPHICS_LIGHTS_LIGHT_CLUSTER_GRID_HPP
+#define GRAPHICS_LIGHTS_LIGHT_CLUSTER_GRID_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Light;
+
+		/*
+			Clustered forward light culling.
+			The view frustum is split in a grid of clusters (froxels): tiles in x and y, exponential slices in depth.
+			The bounding spheres of the point and spot lights are binned into the clusters they touch, on the CPU,
+			one task per depth slice (see TaskScheduler::ParallelFor), 4 tiles per SSE2 test.
+			The directional lights affect every pixel and are not binned.
+
+			The output is laid out to be uploaded as is, in std430 storage buffers:
+				buffer ClusterLights { GridInfo grid; GPULight lights[]; };
+				buffer Clusters { uvec2 clusters[]; }; // offset and count in the light indices
+				buffer ClusterLightIndices { uint lightIndices[]; };
+			and the shader finds its cluster with the GridInfo:
+				viewPos = view * posWS, depth = viewPos.z
+				tile = uvec2(viewPos.xy / depth * tileScale.xy + tileScale.zw)
+				slice = uint(log(depth) * sliceScaleBias.x + sliceScaleBias.y)
+				cluster = (slice * tileCountY + tile.y) * tileCountX + tile.x
+			The tile (0, 0) is the bottom left one of the view, +y up in view space.
+			The light indices of a cluster are sorted, the output is the same for any number of threads.
+			The Vulkan renderer uploads the grid each frame, the lit shaders read it in res/shaders/VisualEffects/LitEffects/clusteredLights.glsl
+
+			NOTE! Assumes a symmetric perspective projection.
+		*/
+		class LightClusterGrid
+		{
+		public:
+			static const uint32_t DEFAULT_TILE_COUNT_X = 16;
+			static const uint32_t DEFAULT_TILE_COUNT_Y = 9;
+			static const uint32_t DEFAULT_SLICE_COUNT = 24;
+
+			// capacity of the uploaded buffers
+			static const uint32_t MAX_LIGHT_COUNT = 1024;
+			static const uint32_t MAX_LIGHT_INDEX_COUNT = 256 * 1024;
+
+			// std430
+			struct GPULight
+			{
+				glm::vec4 positionRange; // world space position, range
+				glm::vec4 colorType; // color, Light::LightType
+				glm::vec4 directionCosAngle; // world space direction, cos of the cone angle - spot lights only
+			};
+
+			// std430, the header of the light buffer
+			struct GridInfo
+			{
+				glm::mat4 view; // world to view space, z is the distance along the view direction
+				glm::vec4 cameraPosition; // world space, w = 1
+				glm::uvec4 counts; // tile count x, tile count y, slice count, light count
+				glm::vec4 tileScale; // view space slope to tile coordinates: x scale, y scale, x bias, y bias
+				glm::vec4 sliceScaleBias; // log(depth) to slice: scale, bias, zNear, zFar
+			};
+
+			// std430 uvec2
+			struct ClusterRange
+			{
+				uint32_t offset;
+				uint32_t count;
+			};
+
+			LightClusterGrid();
+			explicit LightClusterGrid(uint32_t tileCountX, uint32_t tileCountY, uint32_t sliceCount);
+			~LightClusterGrid();
+
+			// bins the point and spot lights, the other lights are skipped
+			// view, proj - of the camera, zNear, zFar - the depth range of the slices
+			void Update(const glm::mat4& view, const glm::mat4& proj, float32_t zNear, float32_t zFar, const std::vector<const Light*>& lights);
+
+			const std::vector<LightClusterGrid::GPULight>& GetLights() const;
+			const std::vector<LightClusterGrid::ClusterRange>& GetClusters() const;
+			const std::vector<uint32_t>& GetLightIndices() const;
+			const LightClusterGrid::GridInfo& GetGridInfo() const;
+
+			uint32_t GetClusterCount() const;
+			uint32_t GetTileCountX() const;
+			uint32_t GetTileCountY() const;
+			uint32_t GetSliceCount() const;
+
+			// view space AABB of a cluster, depth as a positive distance along the view direction
+			void GetClusterBounds(uint32_t tileX, uint32_t tileY, uint32_t slice, glm::vec3& minOut, glm::vec3& maxOut) const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(LightClusterGrid)
+
+			// binning data of a depth slice, each slice is binned by a single task
+			struct Slice
+			{
+				float32_t zMin, zMax;
+
+				// [cluster of the slice, light] pairs, in light order
+				std::vector<uint32_t> pairs;
+				std::vector<uint32_t> indices;
+
+				// squared distances from a light to the tile columns and rows, padded to 4
+				std::vector<float32_t> distX2;
+				std::vector<float32_t> distY2;
+			};
+
+			void Init(uint32_t tileCountX, uint32_t tileCountY, uint32_t sliceCount);
+
+			// bounding spheres of the lights, in view space
+			void ComputeLightBounds(const glm::mat4& view, const std::vector<const Light*>& lights);
+
+			void BinSlice(uint32_t sliceIdx);
+
+			uint32_t mTileCountX, mTileCountY, mSliceCount;
+
+			// view space slopes (x / depth, y / depth) of the tile borders, padded to 4
+			std::vector<float32_t> mTileSlopeX, mTileSlopeY;
+			float32_t mSlopeScaleX, mSlopeScaleY;
+
+			// light bounds, SoA
+			std::vector<float32_t> mBoundX, mBoundY, mBoundZ, mBoundRadius;
+
+			std::vector<Slice> mSlices;
+
+			std::vector<GPULight> mLights;
+			std::vector<ClusterRange> mClusters;
+			std::vector<uint32_t> mLightIndices;
+			GridInfo mGridInfo;
+		};
+	}
+}
+#endif // GRAPHICS_LIGHTS_LIGHT_CLUSTER_GRID_HPP
\ No newline at end of file
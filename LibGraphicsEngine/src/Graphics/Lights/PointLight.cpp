@@ -1,6 +1,7 @@
 #include "Graphics/Lights/PointLight.hpp"
 #include "Core/AppConfig.hpp" // activate needed GLM defines
 #include "glm/gtc/matrix_transform.hpp" // perspective(), ortho(), lookAt(), transpose(), inverse()
+#include <cassert>
 
 using namespace GraphicsEngine;
 using namespace GraphicsEngine::Graphics;
@@ -8,11 +9,13 @@ using namespace GraphicsEngine::Graphics;
 PointLight::PointLight()
 	: Light(Light::LightType::GE_LT_POINT)
 	, mPosition(0.0f)
+	, mRange(100.0f)
 {}
 
-PointLight::PointLight(const glm::vec3& pos, const Color3f& color)
+PointLight::PointLight(const glm::vec3& pos, const Color3f& color, float32_t range)
 	: Light(Light::LightType::GE_LT_POINT)
 	, mPosition(pos)
+	, mRange(range)
 {
 	mColor = color;
 
@@ -32,6 +35,18 @@ void PointLight::SetPosition(const glm::vec3& pos)
 	mPosition = pos;
 }
 
+float32_t PointLight::GetRange() const
+{
+	return mRange;
+}
+
+void PointLight::SetRange(float32_t range)
+{
+	assert(range > 0.0f);
+
+	mRange = range;
+}
+
 void PointLight::ComputeLightPVM()
 {
 	// Matrix from light's point of view
@@ -15,18 +15,22 @@ namespace GraphicsEngine
 
 		public:
 			PointLight();
-			explicit PointLight(const glm::vec3& pos, const Color3f& color);
+			explicit PointLight(const glm::vec3& pos, const Color3f& color, float32_t range = 100.0f);
 			virtual ~PointLight();
 
 			virtual const glm::vec3& GetPosition() const override;
 			virtual void SetPosition(const glm::vec3& pos) override;
 
+			virtual float32_t GetRange() const override;
+			virtual void SetRange(float32_t range) override;
+
 		private:
 			NO_COPY_NO_MOVE_CLASS(PointLight)
 
 			virtual void ComputeLightPVM() override;
 
 			glm::vec3 mPosition;
+			float32_t mRange;
 		};
 	}
 }
@@ -0,0 +1,132 @@
+#include "Graphics/Lights/ShadowCascades.hpp"
+#include "glm/geometric.hpp" // glm::normalize()
+#include "glm/common.hpp" // glm::min(), glm::max(), glm::floor(), glm::ceil()
+#include "glm/exponential.hpp" // glm::pow(), glm::sqrt()
+#include "glm/gtc/matrix_transform.hpp" // glm::lookAt(), glm::ortho()
+#include <cmath>
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+ShadowCascades::ShadowCascades()
+	: ShadowCascades(MAX_CASCADE_COUNT, 100.0f, 0.75f, 50.0f)
+{}
+
+ShadowCascades::ShadowCascades(uint32_t cascadeCount, float32_t maxDistance, float32_t splitLambda, float32_t casterDistance)
+	: mCascadeCount(cascadeCount)
+	, mMaxDistance(maxDistance)
+	, mSplitLambda(splitLambda)
+	, mCasterDistance(casterDistance)
+	, mCascades{}
+{
+	assert((cascadeCount > 0) && (cascadeCount <= MAX_CASCADE_COUNT));
+	assert(maxDistance > 0.0f);
+	assert((splitLambda >= 0.0f) && (splitLambda <= 1.0f));
+	assert(casterDistance >= 0.0f);
+}
+
+ShadowCascades::~ShadowCascades()
+{}
+
+void ShadowCascades::Update(const glm::vec3& cameraPosition, const glm::vec3& cameraForward, float32_t fovY, float32_t aspectRatio,
+	float32_t zNear, float32_t zFar, const glm::vec3& lightDirection)
+{
+	assert((zNear > 0.0f) && (zNear < zFar));
+
+	const float32_t farDistance = glm::max(glm::min(mMaxDistance, zFar), zNear * 2.0f);
+
+	// squared half diagonal of the frustum slices per unit of depth
+	const float32_t tanY = std::tan(fovY * 0.5f);
+	const float32_t tanX = tanY * aspectRatio;
+	const float32_t diagonalSq = tanX * tanX + tanY * tanY;
+
+	const glm::vec3 toLight = glm::normalize(lightDirection);
+	const glm::vec3 up = (std::abs(toLight.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f));
+
+	// the same rotation as the cascade views, the snapping is done in it
+	const glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), -toLight, up);
+	const glm::mat4 inverseLightRotation = glm::inverse(lightRotation);
+
+	float32_t splitNear = zNear;
+	for (uint32_t i = 0; i < mCascadeCount; ++i)
+	{
+		auto& cascade = mCascades[i];
+
+		const float32_t t = static_cast<float32_t>(i + 1) / static_cast<float32_t>(mCascadeCount);
+		const float32_t logSplit = zNear * glm::pow(farDistance / zNear, t);
+		const float32_t uniformSplit = zNear + (farDistance - zNear) * t;
+		const float32_t splitFar = mSplitLambda * logSplit + (1.0f - mSplitLambda) * uniformSplit;
+
+		// the sphere through the near and far corners of the slice, its center on the view axis (not past the far plane)
+		const float32_t nearDiagonalSq = splitNear * splitNear * diagonalSq;
+		const float32_t farDiagonalSq = splitFar * splitFar * diagonalSq;
+		const float32_t centerDepth = glm::min((1.0f + diagonalSq) * (splitNear + splitFar) * 0.5f, splitFar);
+
+		float32_t radius = glm::max(glm::sqrt((centerDepth - splitNear) * (centerDepth - splitNear) + nearDiagonalSq),
+			glm::sqrt((splitFar - centerDepth) * (splitFar - centerDepth) + farDiagonalSq));
+		// rounded up, the float noise of the radius would change the texel size from frame to frame
+		radius = glm::ceil(radius * 16.0f) / 16.0f;
+
+		// the center is moved by whole texels in light space
+		const float32_t texelSize = 2.0f * radius / static_cast<float32_t>(TILE_SIZE);
+
+		glm::vec3 lightCenter(lightRotation * glm::vec4(cameraPosition + cameraForward * centerDepth, 1.0f));
+		lightCenter.x = glm::floor(lightCenter.x / texelSize) * texelSize;
+		lightCenter.y = glm::floor(lightCenter.y / texelSize) * texelSize;
+
+		const glm::vec3 center(inverseLightRotation * glm::vec4(lightCenter, 1.0f));
+
+		// the near plane is moved towards the light by the caster distance
+		const float32_t lightDistance = radius + mCasterDistance;
+		const glm::mat4 view = glm::lookAt(center + toLight * lightDistance, center, up);
+		const glm::mat4 proj = glm::ortho(-radius, radius, -radius, radius, 0.0f, lightDistance + radius);
+
+		cascade.projectionView = proj * view;
+		cascade.center = center;
+		cascade.radius = radius;
+		cascade.splitNear = splitNear;
+		cascade.splitFar = splitFar;
+
+		mCasterFrustums[i].Update(cascade.projectionView);
+
+		splitNear = splitFar;
+	}
+}
+
+uint32_t ShadowCascades::GetCasterMask(const glm::vec3& min, const glm::vec3& max) const
+{
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < mCascadeCount; ++i)
+	{
+		if (mCasterFrustums[i].IntersectsAABB(min, max))
+		{
+			mask |= (1 << i);
+		}
+	}
+
+	return mask;
+}
+
+uint32_t ShadowCascades::GetCascadeCount() const
+{
+	return mCascadeCount;
+}
+
+const ShadowCascades::Cascade& ShadowCascades::GetCascade(uint32_t cascadeIdx) const
+{
+	assert(cascadeIdx < mCascadeCount);
+
+	return mCascades[cascadeIdx];
+}
+
+glm::vec4 ShadowCascades::GetSplits() const
+{
+	glm::vec4 splits(mCascades[mCascadeCount - 1].splitFar);
+	for (uint32_t i = 0; i < mCascadeCount; ++i)
+	{
+		splits[i] = mCascades[i].splitFar;
+	}
+
+	return splits;
+}
\ No newline at end of file
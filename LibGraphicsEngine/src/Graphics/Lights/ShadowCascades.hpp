@@ -0,0 +1,85 @@
+#ifndef GRAPHICS_LIGHTS_SHADOW_CASCADES_HPP
+#define GRAPHICS_LIGHTS_SHADOW_CASCADES_HPP
+
+#include "Core/AppConfig.hpp"
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/*
+			Cascaded shadow maps of a directional light.
+			The camera frustum is split in depth slices (practical split scheme: a blend of the logarithmic and uniform splits),
+			each slice gets an orthographic light projection fitted to its bounding sphere:
+			- the sphere only depends on the slice depths and the camera lens, so the projection size doesn't change when the camera rotates
+			- the sphere center is snapped to the shadow map texels in light space, so the texels don't swim when the camera moves
+			The light volume of a cascade is extended towards the light by the caster distance, the casters between the light
+			and the slice are in it too. A caster is drawn only to the cascades whose light volume it intersects, see GetCasterMask().
+
+			The cascades are the tiles of one depth atlas (2 x 2 tiles, tile i at (i % 2, i / 2)), rendered in one pass:
+			a caster is drawn once, instanced over the range of its cascades, the vertex shader moves each instance to its tile
+			and clips it to the tile (see litCascadedShadowCompute.vert).
+
+			NOTE! Assumes a symmetric perspective projection.
+			based on: Zhang et al. - Parallel-Split Shadow Maps for Large-scale Virtual Environments (VRCIA 2006)
+			and: Valient - Stable Rendering of Cascaded Shadow Maps (ShaderX6)
+		*/
+		class ShadowCascades
+		{
+		public:
+			static const uint32_t MAX_CASCADE_COUNT = 4;
+			// depth atlas size, in texels, for the MAX_CASCADE_COUNT tiles
+			static const uint32_t ATLAS_SIZE = 4096;
+			static const uint32_t TILE_SIZE = ATLAS_SIZE / 2;
+
+			struct Cascade
+			{
+				glm::mat4 projectionView; // world space to the cascade clip space, before moving it to its atlas tile
+				glm::vec3 center; // world space bounding sphere of the camera frustum slice
+				float32_t radius;
+				float32_t splitNear; // camera view space depths of the slice
+				float32_t splitFar;
+			};
+
+			ShadowCascades();
+			// cascadeCount - up to MAX_CASCADE_COUNT, maxDistance - the shadows end at min(maxDistance, camera zFar)
+			// splitLambda - 0 uniform splits, 1 logarithmic splits, casterDistance - light volume extension towards the light
+			ShadowCascades(uint32_t cascadeCount, float32_t maxDistance, float32_t splitLambda, float32_t casterDistance);
+			~ShadowCascades();
+
+			// fits the cascades to the camera, fovY in radians
+			// lightDirection - world space direction towards the light, see Light::GetDirection()
+			void Update(const glm::vec3& cameraPosition, const glm::vec3& cameraForward, float32_t fovY, float32_t aspectRatio,
+				float32_t zNear, float32_t zFar, const glm::vec3& lightDirection);
+
+			// bit i is set if the world space AABB intersects the light volume of the cascade i
+			uint32_t GetCasterMask(const glm::vec3& min, const glm::vec3& max) const;
+
+			uint32_t GetCascadeCount() const;
+			const ShadowCascades::Cascade& GetCascade(uint32_t cascadeIdx) const;
+
+			// the far depths of the cascades, for the cascade selection of the shaders
+			// the unused cascades get the last far depth
+			glm::vec4 GetSplits() const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(ShadowCascades)
+
+			uint32_t mCascadeCount;
+			float32_t mMaxDistance;
+			float32_t mSplitLambda;
+			float32_t mCasterDistance;
+
+			Cascade mCascades[MAX_CASCADE_COUNT];
+			Frustum mCasterFrustums[MAX_CASCADE_COUNT];
+		};
+	}
+}
+
+#endif // GRAPHICS_LIGHTS_SHADOW_CASCADES_HPP
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "Graphics/Lights/SpotLight.hpp"
+#include "Core/AppConfig.hpp" // activate needed GLM defines
+#include "glm/gtc/matrix_transform.hpp" // perspective(), lookAt()
+#include "glm/geometric.hpp" // normalize()
+#include <cassert>
+#include <cmath>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+SpotLight::SpotLight()
+	: Light(Light::LightType::GE_LT_SPOT)
+	, mPosition(0.0f)
+	, mDirection(0.0f, 0.0f, -1.0f)
+	, mRange(100.0f)
+	, mConeAngle(0.5f)
+{}
+
+SpotLight::SpotLight(const glm::vec3& pos, const glm::vec3& dir, const Color3f& color, float32_t range, float32_t coneAngle)
+	: Light(Light::LightType::GE_LT_SPOT)
+	, mPosition(pos)
+	, mDirection(glm::normalize(dir))
+	, mRange(range)
+	, mConeAngle(coneAngle)
+{
+	assert(range > 0.0f);
+	assert((coneAngle > 0.0f) && (coneAngle < glm::radians(90.0f)));
+
+	mColor = color;
+
+	ComputeLightPVM();
+}
+
+SpotLight::~SpotLight()
+{}
+
+const glm::vec3& SpotLight::GetPosition() const
+{
+	return mPosition;
+}
+
+void SpotLight::SetPosition(const glm::vec3& pos)
+{
+	mPosition = pos;
+}
+
+const glm::vec3& SpotLight::GetDirection() const
+{
+	return mDirection;
+}
+
+void SpotLight::SetDirection(const glm::vec3& dir)
+{
+	mDirection = glm::normalize(dir);
+}
+
+float32_t SpotLight::GetRange() const
+{
+	return mRange;
+}
+
+void SpotLight::SetRange(float32_t range)
+{
+	assert(range > 0.0f);
+
+	mRange = range;
+}
+
+float32_t SpotLight::GetConeAngle() const
+{
+	return mConeAngle;
+}
+
+void SpotLight::SetConeAngle(float32_t coneAngle)
+{
+	assert((coneAngle > 0.0f) && (coneAngle < glm::radians(90.0f)));
+
+	mConeAngle = coneAngle;
+}
+
+void SpotLight::ComputeLightPVM()
+{
+	// Matrix from light's point of view, the frustum contains the cone
+
+	float32_t FOV = 2.0f * mConeAngle;
+	float32_t aspectRatio = 1.0f;
+
+	// Keep depth range as small as possible
+	// for better shadow map precision
+	float32_t zNear = 0.1f;
+	float32_t zFar = mRange;
+
+	// the up vector must not be parallel to the direction
+	glm::vec3 up = (std::abs(mDirection.y) < 0.99f) ? glm::vec3(0.0f, +1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+
+	glm::mat4 proj = glm::perspective(FOV, aspectRatio, zNear, zFar);
+	glm::mat4 view = glm::lookAt(mPosition, mPosition + mDirection, up);
+	// no model matrix
+
+	mLightPVM = proj * view;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef GRAPHICS_LIGHTS_SPOT_LIGHT_HPP
+#define GRAPHICS_LIGHTS_SPOT_LIGHT_HPP
+
+#include "Graphics/Lights/Light.hpp"
+#include "glm/vec3.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/* Spot Light class - a cone of light from its position, along its direction */
+		class SpotLight : public Light
+		{
+			GE_RTTI(GraphicsEngine::Graphics::SpotLight)
+
+		public:
+			SpotLight();
+			// coneAngle - half angle of the cone, in radians
+			explicit SpotLight(const glm::vec3& pos, const glm::vec3& dir, const Color3f& color, float32_t range = 100.0f, float32_t coneAngle = 0.5f);
+			virtual ~SpotLight();
+
+			virtual const glm::vec3& GetPosition() const override;
+			virtual void SetPosition(const glm::vec3& pos) override;
+
+			virtual const glm::vec3& GetDirection() const override;
+			virtual void SetDirection(const glm::vec3& dir) override;
+
+			virtual float32_t GetRange() const override;
+			virtual void SetRange(float32_t range) override;
+
+			float32_t GetConeAngle() const;
+			void SetConeAngle(float32_t coneAngle);
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(SpotLight)
+
+			virtual void ComputeLightPVM() override;
+
+			glm::vec3 mPosition;
+			glm::vec3 mDirection;
+			float32_t mRange;
+			float32_t mConeAngle;
+		};
+	}
+}
+#endif // GRAPHICS_LIGHTS_SPOT_LIGHT_HPP
\ No newline at end of file
@@ -6,11 +6,13 @@
 
 #include "Graphics/Loaders/KTX2Loader.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Profiler.hpp"
 #include "Foundation/Logger.hpp"
 #include "glm/common.hpp" //glm::max(), glm::ceil()
 #include "KHR/khr_df.h"
 #include <vector>
 #include <cstdio>
+#include <cstring> // memcmp()
 #include <cassert>
 
 using namespace GraphicsEngine;
@@ -109,6 +111,8 @@ KTX2Loader::Impl::~Impl()
 
 bool_t KTX2Loader::Impl::LoadFromFile(const std::string& filePath)
 {
+	GE_PROFILE_FUNCTION();
+
 	if (filePath.empty() == true)
 	{
 		LOG_ERROR("Invalid file path!");
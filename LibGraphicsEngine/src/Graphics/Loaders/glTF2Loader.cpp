@@ -6,6 +6,14 @@
 
 #include "Graphics/Loaders/glTF2Loader.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Graphics/GeometricPrimitives/MeshOptimizer.hpp"
+#include "Graphics/GeometricPrimitives/MeshQuantizer.hpp"
+#include "Graphics/GeometricPrimitives/MeshletBuilder.hpp"
+#include "Graphics/GeometricPrimitives/MeshSimplifier.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "Foundation/FileUtils.hpp"
+#include "Foundation/HashUtils.hpp"
+#include "Foundation/Profiler.hpp"
 #include "Foundation/Logger.hpp"
 #include "glm/common.hpp" //glm::max(), glm::ceil()
 #include "glm/mat4x4.hpp"
@@ -14,6 +22,7 @@
 #include "glm/gtc/type_ptr.hpp"
 #include <vector>
 #include <cstdio>
+#include <cstring> // ::memcpy()
 #include <cassert>
 
 ///// tinygltf setup ////////
@@ -26,6 +35,163 @@
 using namespace GraphicsEngine;
 using namespace GraphicsEngine::Graphics;
 
+/*
+	Engine native baked model format
+
+	Layout (all sections start at 16 byte aligned offsets, little endian):
+	BakedHeader
+	vertex buffer - final interleaved float data (loading flags already applied)
+	index buffer - uint16 or uint32 indices
+	primitive table - BakedPrimitive[]
+	material table - BakedMaterial[]
+	node table - BakedNode[], pre-order, a parent is always stored before its children
+	meshlet tables - with GE_LF_MESHLETS
+	level of detail table - BakedLOD[], with GE_LF_LODS, index ranges after the ones of the primitives
+	dependency table - BakedDependency[], the external buffers (.bin) referenced by the source file
+	string table - the dependency uris, not null terminated
+
+	The header stores a hash of the raw source file content + the loading flags, the dependency table a hash
+	of each external buffer content, so any change to them invalidates the baked file.
+	The source file is not parsed to validate the baked file, the embedded buffers (data uris) are part of its content.
+*/
+namespace BakedFormat
+{
+	static const char_t* FILE_EXTENSION = ".gebake";
+	static const uint32_t MAGIC = 0x424D4547; // "GEMB"
+	static const uint32_t VERSION = 6;
+	static const uint64_t ALIGNMENT = 16;
+
+	enum Section : uint32_t
+	{
+		SECTION_VERTICES = 0,
+		SECTION_INDICES,
+		SECTION_PRIMITIVES,
+		SECTION_MATERIALS,
+		SECTION_NODES,
+		SECTION_MESHLETS,
+		SECTION_MESHLET_BOUNDS,
+		SECTION_MESHLET_VERTICES,
+		SECTION_MESHLET_TRIANGLES,
+		SECTION_LODS,
+		SECTION_DEPENDENCIES,
+		SECTION_STRINGS,
+		SECTION_COUNT
+	};
+
+	struct SectionRange
+	{
+		uint64_t offset; // in bytes, from the start of the file
+		uint64_t size; // in bytes
+	};
+
+	struct BakedHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceHash;
+		uint32_t loadingFlags;
+		uint32_t vertexAttributes[5]; // pos, normal, tangent, color, uv - component counts
+		uint32_t vertexAttributeTypes[5]; // VertexFormat::AttributeType, same order
+		uint32_t indexType; // IndexBuffer::IndexType, indices are relative to the primitive first vertex
+		SectionRange sections[SECTION_COUNT];
+	};
+
+	struct BakedPrimitive
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+		uint32_t materialIndex;
+		uint32_t firstMeshlet;
+		uint32_t meshletCount;
+		uint32_t firstLOD;
+		uint32_t lodCount;
+		uint32_t padding;
+		float32_t min[3];
+		float32_t max[3];
+	};
+
+	struct BakedMaterial
+	{
+		float32_t baseColorFactor[4];
+		float32_t alphaCutoff;
+		float32_t metallicFactor;
+		float32_t roughnessFactor;
+		uint32_t alphaMode;
+	};
+
+	struct BakedLOD
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float32_t error;
+		uint32_t padding;
+	};
+
+	struct BakedNode
+	{
+		int32_t parent; // -1 for root nodes
+		uint32_t index;
+		uint32_t firstPrimitive;
+		uint32_t primitiveCount; // 0 if the node has no mesh
+		float32_t localMatrix[16];
+	};
+
+	struct BakedDependency
+	{
+		uint64_t contentHash;
+		uint32_t uriOffset; // in the string table
+		uint32_t uriSize;
+	};
+
+	static_assert(sizeof(BakedPrimitive) % ALIGNMENT == 0, "BakedPrimitive must be 16 byte aligned!");
+	static_assert(sizeof(BakedMaterial) % ALIGNMENT == 0, "BakedMaterial must be 16 byte aligned!");
+	static_assert(sizeof(BakedLOD) % ALIGNMENT == 0, "BakedLOD must be 16 byte aligned!");
+	static_assert(sizeof(BakedNode) % ALIGNMENT == 0, "BakedNode must be 16 byte aligned!");
+	static_assert(sizeof(BakedDependency) % ALIGNMENT == 0, "BakedDependency must be 16 byte aligned!");
+
+	static uint64_t AlignUp(uint64_t value)
+	{
+		return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+
+	// [first, first + count) inside [0, size), without overflowing
+	static bool_t IsRangeValid(uint64_t first, uint64_t count, uint64_t size)
+	{
+		return (first <= size) && (count <= size - first);
+	}
+
+	// the index values of [first, first + count) inside [0, vertexCount), the range itself must be valid
+	static bool_t AreIndicesValid(const uint8_t* pIndexData, uint32_t indexSize, uint64_t first, uint64_t count, uint64_t vertexCount)
+	{
+		for (uint64_t i = first; i < first + count; ++i)
+		{
+			const uint32_t index = ((sizeof(uint16_t) == indexSize) ?
+				reinterpret_cast<const uint16_t*>(pIndexData)[i] : reinterpret_cast<const uint32_t*>(pIndexData)[i]);
+			if (index >= vertexCount)
+				return false;
+		}
+
+		return true;
+	}
+
+	static bool_t HashFileContent(const std::string& filePath, uint64_t& hashOut)
+	{
+		FileUtils::MappedFile file;
+		if (false == FileUtils::MapFile(filePath, file))
+		{
+			return false;
+		}
+
+		hashOut = HashUtils::HashBytes(file.pData, file.size);
+
+		FileUtils::UnmapFile(file);
+
+		return true;
+	}
+}
+
 
 struct glTF2Loader::Impl
 {
@@ -98,6 +264,10 @@ struct glTF2Loader::Impl
 		uint32_t indexCount;
 		uint32_t firstVertex;
 		uint32_t vertexCount;
+		uint32_t firstMeshlet; // in mClusterTable
+		uint32_t meshletCount;
+		uint32_t firstLOD; // in mLODs, level 1
+		uint32_t lodCount; // without level 0
 		glTF2Loader::Impl::Material& material;
 
 		Dimensions dimensions;
@@ -105,12 +275,24 @@ struct glTF2Loader::Impl
 		Primitive(uint32_t firstIndex, uint32_t indexCount, glTF2Loader::Impl::Material& material) 
 			: firstIndex(firstIndex), indexCount(indexCount)
 			, firstVertex(0), vertexCount(0)
+			, firstMeshlet(0), meshletCount(0)
+			, firstLOD(0), lodCount(0)
 			, material(material)
 		{};
 
 		void setDimensions(glm::vec3 min, glm::vec3 max);
 	};
 
+	/*
+		simplified level of a primitive, the indices are relative to the primitive first vertex
+	*/
+	struct LOD
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		float32_t error; // in model units, see MeshSimplifier
+	};
+
 	/*
 		glTF mesh
 	*/
@@ -156,6 +338,14 @@ struct glTF2Loader::Impl
 	virtual ~Impl();
 
 	bool_t LoadFromFile(const std::string& filePath, uint32_t loadingFlags);
+	bool_t LoadFromglTFFile(const std::string& filePath, uint32_t loadingFlags);
+
+	// baked file support
+	bool_t ComputeSourceHash(const std::string& filePath, uint32_t loadingFlags, uint64_t& hashOut);
+	bool_t LoadFromBakedFile(const std::string& filePath, uint64_t sourceHash);
+	bool_t IsBakedFileValid(const std::string& filePath, uint64_t sourceHash) const;
+	bool_t WriteBakedFile(const std::string& filePath, uint64_t sourceHash, uint32_t loadingFlags);
+	void BakeNode(glTF2Loader::Impl::Node* pNode, int32_t parent, std::vector<BakedFormat::BakedNode>& nodesOut, std::vector<BakedFormat::BakedPrimitive>& primitivesOut);
 
 	bool_t LoadImages(tinygltf::Model& gltfModel);
 	bool_t LoadMaterials(tinygltf::Model& gltfModel);
@@ -163,10 +353,24 @@ struct glTF2Loader::Impl
 
 	void ApplyFlagsOnNode(glTF2Loader::Impl::Node* pNode, uint32_t loadingFlags);
 
+	void CollectPrimitives(glTF2Loader::Impl::Node* pNode, std::vector<glTF2Loader::Impl::Primitive*>& primitivesOut);
+	void OptimizeMesh(const std::vector<glTF2Loader::Impl::Primitive*>& primitives);
+	void CompactIndices(const std::string& filePath, const std::vector<glTF2Loader::Impl::Primitive*>& primitives);
+	void QuantizeMesh(uint32_t loadingFlags);
+	void BuildMeshlets(const std::vector<glTF2Loader::Impl::Primitive*>& primitives);
+	void GenerateLODs(const std::vector<glTF2Loader::Impl::Primitive*>& primitives);
+
+	// nullptr at level 0
+	const glTF2Loader::Impl::LOD* GetLOD(const glTF2Loader::Impl::Primitive* pPrimitive) const;
+
 	glTF2Loader::Impl::Texture* GetTexture(uint32_t index);
 
-	void Draw(std::function<void(uint32_t indexCount, uint32_t firstVertex)> onDrawCB);
-	void DrawNode(glTF2Loader::Impl::Node* pNode, std::function<void(uint32_t indexCount, uint32_t firstVertex)> onDrawCB);
+	void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+	void DrawNode(glTF2Loader::Impl::Node* pNode, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+	void DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+	void DrawNodeVisible(glTF2Loader::Impl::Node* pNode, const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+	void DrawMeshlets(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB);
+	void DrawNodeMeshlets(glTF2Loader::Impl::Node* pNode, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB);
 
 	std::vector<glTF2Loader::Impl::Node*> mNodes;
 
@@ -175,15 +379,43 @@ struct glTF2Loader::Impl
 
 	std::vector<float32_t> mVertexBuffer;
 	std::vector<uint32_t> mIndexBuffer;
+	std::vector<uint16_t> mIndexBuffer16; // compacted mIndexBuffer, if all primitives fit
+	std::vector<uint8_t> mQuantizedVertexBuffer; // quantized mVertexBuffer, with GE_LF_QUANTIZE
+
+	MeshletBuilder::ClusterTable mClusterTable; // with GE_LF_MESHLETS, meshlet vertices are absolute vertex indices
+
+	std::vector<glTF2Loader::Impl::LOD> mLODs; // with GE_LF_LODS
+	uint32_t mLODLevel;
+
+	// final data ranges - point either to the buffers above or inside the mapped baked file
+	const void* mpVertexData;
+	uint32_t mVertexDataSize;
+	const void* mpIndexData;
+	uint32_t mIndexDataSize;
+	IndexBuffer::IndexType mIndexType;
+
+	FileUtils::MappedFile mBakedFile;
+	std::vector<std::string> mExternalBufferUris; // the external buffers of the source file, relative to it
 
 	glTF2Loader::VertexAttributes mVertexAttributes;
 };
 
 glTF2Loader::Impl::Impl()
+	: mLODLevel(0)
+	, mpVertexData(nullptr), mVertexDataSize(0)
+	, mpIndexData(nullptr), mIndexDataSize(0), mIndexType(IndexBuffer::IndexType::GE_IT_UINT32)
 {}
 
 glTF2Loader::Impl::~Impl()
-{}
+{
+	for (auto* pNode : mNodes)
+	{
+		GE_FREE(pNode);
+	}
+	mNodes.clear();
+
+	FileUtils::UnmapFile(mBakedFile);
+}
 
 static bool_t LoadImageDataFunc(tinygltf::Image* pImage, const int32_t imageIndex, std::string* pError, std::string* pWarning, int32_t req_width, int32_t req_height, const unsigned char* pBytes, int32_t size, void* pUserData)
 {
@@ -201,12 +433,51 @@ static bool_t LoadImageDataFunc(tinygltf::Image* pImage, const int32_t imageInde
 
 bool_t glTF2Loader::Impl::LoadFromFile(const std::string& filePath, uint32_t loadingFlags)
 {
+	GE_PROFILE_FUNCTION();
+
 	if (filePath.empty())
 	{
 		LOG_ERROR("Empty file path!");
 		return false;
 	}
 
+	if ((loadingFlags & LoadingFlags::GE_LF_BAKED) == 0)
+	{
+		return LoadFromglTFFile(filePath, loadingFlags);
+	}
+
+	uint64_t sourceHash = 0;
+	if (false == ComputeSourceHash(filePath, loadingFlags, sourceHash))
+	{
+		// not fatal, the regular import reports the actual error
+		LOG_WARNING("Failed to hash file, the baked file is not used: %s", filePath.c_str());
+		return LoadFromglTFFile(filePath, loadingFlags);
+	}
+
+	if (LoadFromBakedFile(filePath, sourceHash))
+	{
+		return true;
+	}
+
+	// first run, stale or invalid baked file - parse the source and (re)bake it
+	if (false == LoadFromglTFFile(filePath, loadingFlags))
+	{
+		return false;
+	}
+
+	if (false == WriteBakedFile(filePath, sourceHash, loadingFlags))
+	{
+		// not fatal, the data is already loaded
+		LOG_WARNING("Failed to write baked file: %s", (filePath + BakedFormat::FILE_EXTENSION).c_str());
+	}
+
+	return true;
+}
+
+bool_t glTF2Loader::Impl::LoadFromglTFFile(const std::string& filePath, uint32_t loadingFlags)
+{
+	GE_PROFILE_FUNCTION();
+
 	tinygltf::TinyGLTF gltfContext;
 	tinygltf::Model gltfModel;
 	std::string error, warning;
@@ -220,6 +491,15 @@ bool_t glTF2Loader::Impl::LoadFromFile(const std::string& filePath, uint32_t loa
 		return false;
 	}
 
+	// the baked file dependencies, the embedded buffers (data uris) are part of the source file content
+	for (const auto& buffer : gltfModel.buffers)
+	{
+		if ((false == buffer.uri.empty()) && (false == tinygltf::IsDataURI(buffer.uri)))
+		{
+			mExternalBufferUris.push_back(buffer.uri);
+		}
+	}
+
 	result = LoadImages(gltfModel);
 	if (result == false)
 	{
@@ -263,141 +543,637 @@ bool_t glTF2Loader::Impl::LoadFromFile(const std::string& filePath, uint32_t loa
 		}
 	}
 
-	return true;
-}
+	std::vector<glTF2Loader::Impl::Primitive*> primitives;
+	for (auto* pNode : mNodes)
+	{
+		CollectPrimitives(pNode, primitives);
+	}
 
-bool_t glTF2Loader::Impl::LoadImages(tinygltf::Model& gltfModel)
-{
-	//TODO
+	if (loadingFlags & LoadingFlags::GE_LF_OPTIMIZE)
+	{
+		OptimizeMesh(primitives);
+	}
+
+	// needs the float positions and the absolute indices
+	if (loadingFlags & LoadingFlags::GE_LF_MESHLETS)
+	{
+		BuildMeshlets(primitives);
+	}
+
+	// the levels are appended to the index buffer, after the meshlets of the level 0
+	if (loadingFlags & LoadingFlags::GE_LF_LODS)
+	{
+		GenerateLODs(primitives);
+	}
+
+	CompactIndices(filePath, primitives);
+
+	mpVertexData = mVertexBuffer.data();
+	mVertexDataSize = static_cast<uint32_t>(mVertexBuffer.size() * sizeof(float32_t));
+
+	if (loadingFlags & LoadingFlags::GE_LF_QUANTIZE)
+	{
+		QuantizeMesh(loadingFlags);
+	}
 
 	return true;
 }
 
-bool_t glTF2Loader::Impl::LoadMaterials(tinygltf::Model& gltfModel)
+bool_t glTF2Loader::Impl::ComputeSourceHash(const std::string& filePath, uint32_t loadingFlags, uint64_t& hashOut)
 {
-	for (tinygltf::Material& mat : gltfModel.materials)
+	// the raw file content, no parsing - the external buffers are validated by the baked file dependency table
+	if (false == BakedFormat::HashFileContent(filePath, hashOut))
 	{
-		glTF2Loader::Impl::Material material;
-		if (mat.values.find("baseColorTexture") != mat.values.end()) {
-			material.pBaseColorTexture = GetTexture(gltfModel.textures[mat.values["baseColorTexture"].TextureIndex()].source);
-		}
-		// Metallic roughness workflow
-		if (mat.values.find("metallicRoughnessTexture") != mat.values.end()) {
-			material.pMetallicRoughnessTexture = GetTexture(gltfModel.textures[mat.values["metallicRoughnessTexture"].TextureIndex()].source);
-		}
-		if (mat.values.find("roughnessFactor") != mat.values.end()) {
-			material.roughnessFactor = static_cast<float32_t>(mat.values["roughnessFactor"].Factor());
-		}
-		if (mat.values.find("metallicFactor") != mat.values.end()) {
-			material.metallicFactor = static_cast<float32_t>(mat.values["metallicFactor"].Factor());
-		}
-		if (mat.values.find("baseColorFactor") != mat.values.end()) {
-			material.baseColorFactor = glm::make_vec4(mat.values["baseColorFactor"].ColorFactor().data());
-		}
-		if (mat.additionalValues.find("normalTexture") != mat.additionalValues.end()) {
-			material.pNormalTexture = GetTexture(gltfModel.textures[mat.additionalValues["normalTexture"].TextureIndex()].source);
-		}
-		else {
-		//	material.normalTexture = &emptyTexture; //TODO
-		}
-		if (mat.additionalValues.find("emissiveTexture") != mat.additionalValues.end()) {
-			material.pEmissiveTexture = GetTexture(gltfModel.textures[mat.additionalValues["emissiveTexture"].TextureIndex()].source);
-		}
-		if (mat.additionalValues.find("occlusionTexture") != mat.additionalValues.end()) {
-			material.pOcclusionTexture = GetTexture(gltfModel.textures[mat.additionalValues["occlusionTexture"].TextureIndex()].source);
-		}
-		if (mat.additionalValues.find("alphaMode") != mat.additionalValues.end()) {
-			tinygltf::Parameter param = mat.additionalValues["alphaMode"];
-			if (param.string_value == "BLEND") {
-				material.alphaMode = Material::ALPHAMODE_BLEND;
-			}
-			if (param.string_value == "MASK") {
-				material.alphaMode = Material::ALPHAMODE_MASK;
-			}
-		}
-		if (mat.additionalValues.find("alphaCutoff") != mat.additionalValues.end()) {
-			material.alphaCutoff = static_cast<float32_t>(mat.additionalValues["alphaCutoff"].Factor());
-		}
-
-		mMaterials.push_back(material);
+		return false;
 	}
-	// Push a default material at the end of the list for meshes with no material assigned
-	mMaterials.push_back(Material());
+
+	// the baked flag itself does not change the loaded data
+	const uint32_t dataFlags = (loadingFlags & ~LoadingFlags::GE_LF_BAKED);
+	hashOut = HashUtils::HashBytes(&dataFlags, sizeof(dataFlags), hashOut);
 
 	return true;
 }
 
-bool_t glTF2Loader::Impl::LoadNode(glTF2Loader::Impl::Node* pParent, const tinygltf::Node& node, uint32_t nodeIndex, const tinygltf::Model& model, uint32_t loadingFlags)
+bool_t glTF2Loader::Impl::LoadFromBakedFile(const std::string& filePath, uint64_t sourceHash)
 {
-	glTF2Loader::Impl::Node* pNewNode = GE_ALLOC(glTF2Loader::Impl::Node);
-	pNewNode->index = nodeIndex;
-	pNewNode->pParent = pParent;
-	pNewNode->name = node.name;
+	GE_PROFILE_FUNCTION();
 
-	// Generate local node matrix
-	if (node.translation.size() == 3) {
-		glm::vec3 translation = glm::make_vec3(node.translation.data());
-		pNewNode->translation = translation;
-	}
-	if (node.rotation.size() == 4) {
-		glm::quat q = glm::make_quat(node.rotation.data());
-		pNewNode->rotation = glm::mat4(q);
+	using namespace BakedFormat;
+
+	const std::string bakedFilePath = filePath + FILE_EXTENSION;
+
+	if (false == FileUtils::MapFile(bakedFilePath, mBakedFile))
+	{
+		return false;
 	}
-	if (node.scale.size() == 3) {
-		glm::vec3 scale = glm::make_vec3(node.scale.data());
-		pNewNode->scale = scale;
+
+	if (false == IsBakedFileValid(filePath, sourceHash))
+	{
+		LOG_INFO("Baked file is stale or invalid: %s", bakedFilePath.c_str());
+		FileUtils::UnmapFile(mBakedFile);
+		return false;
 	}
-	if (node.matrix.size() == 16) {
-		pNewNode->matrix = glm::make_mat4x4(node.matrix.data());
+
+	const BakedHeader* pHeader = reinterpret_cast<const BakedHeader*>(mBakedFile.pData);
+
+	mVertexAttributes.pos = pHeader->vertexAttributes[0];
+	mVertexAttributes.normal = pHeader->vertexAttributes[1];
+	mVertexAttributes.tangent = pHeader->vertexAttributes[2];
+	mVertexAttributes.color = pHeader->vertexAttributes[3];
+	mVertexAttributes.uv = pHeader->vertexAttributes[4];
+	mVertexAttributes.posType = static_cast<VertexFormat::AttributeType>(pHeader->vertexAttributeTypes[0]);
+	mVertexAttributes.normalType = static_cast<VertexFormat::AttributeType>(pHeader->vertexAttributeTypes[1]);
+	mVertexAttributes.tangentType = static_cast<VertexFormat::AttributeType>(pHeader->vertexAttributeTypes[2]);
+	mVertexAttributes.colorType = static_cast<VertexFormat::AttributeType>(pHeader->vertexAttributeTypes[3]);
+	mVertexAttributes.uvType = static_cast<VertexFormat::AttributeType>(pHeader->vertexAttributeTypes[4]);
+
+	// vertex and index data are used straight from the mapped file - no parsing
+	mpVertexData = mBakedFile.pData + pHeader->sections[SECTION_VERTICES].offset;
+	mVertexDataSize = static_cast<uint32_t>(pHeader->sections[SECTION_VERTICES].size);
+	mpIndexData = mBakedFile.pData + pHeader->sections[SECTION_INDICES].offset;
+	mIndexDataSize = static_cast<uint32_t>(pHeader->sections[SECTION_INDICES].size);
+	mIndexType = static_cast<IndexBuffer::IndexType>(pHeader->indexType);
+
+	// meshlets - small, so they are copied
+	const MeshletBuilder::Meshlet* pMeshlets = reinterpret_cast<const MeshletBuilder::Meshlet*>(mBakedFile.pData + pHeader->sections[SECTION_MESHLETS].offset);
+	mClusterTable.meshlets.assign(pMeshlets, pMeshlets + pHeader->sections[SECTION_MESHLETS].size / sizeof(MeshletBuilder::Meshlet));
+	const MeshletBuilder::MeshletBounds* pMeshletBounds = reinterpret_cast<const MeshletBuilder::MeshletBounds*>(mBakedFile.pData + pHeader->sections[SECTION_MESHLET_BOUNDS].offset);
+	mClusterTable.bounds.assign(pMeshletBounds, pMeshletBounds + pHeader->sections[SECTION_MESHLET_BOUNDS].size / sizeof(MeshletBuilder::MeshletBounds));
+	const uint32_t* pMeshletVertices = reinterpret_cast<const uint32_t*>(mBakedFile.pData + pHeader->sections[SECTION_MESHLET_VERTICES].offset);
+	mClusterTable.vertices.assign(pMeshletVertices, pMeshletVertices + pHeader->sections[SECTION_MESHLET_VERTICES].size / sizeof(uint32_t));
+	const uint8_t* pMeshletTriangles = mBakedFile.pData + pHeader->sections[SECTION_MESHLET_TRIANGLES].offset;
+	mClusterTable.triangles.assign(pMeshletTriangles, pMeshletTriangles + pHeader->sections[SECTION_MESHLET_TRIANGLES].size);
+
+	// levels of detail
+	const BakedLOD* pLODs = reinterpret_cast<const BakedLOD*>(mBakedFile.pData + pHeader->sections[SECTION_LODS].offset);
+	const size_t lodCount = pHeader->sections[SECTION_LODS].size / sizeof(BakedLOD);
+	mLODs.resize(lodCount);
+	for (size_t i = 0; i < lodCount; ++i)
+	{
+		mLODs[i].firstIndex = pLODs[i].firstIndex;
+		mLODs[i].indexCount = pLODs[i].indexCount;
+		mLODs[i].error = pLODs[i].error;
 	}
 
-	// Node with children
-	if (node.children.size() > 0) {
-		for (auto i = 0; i < node.children.size(); i++) {
-			LoadNode(pNewNode, model.nodes[node.children[i]], node.children[i], model, loadingFlags);
-		}
+	// materials
+	const BakedMaterial* pMaterials = reinterpret_cast<const BakedMaterial*>(mBakedFile.pData + pHeader->sections[SECTION_MATERIALS].offset);
+	const size_t materialCount = pHeader->sections[SECTION_MATERIALS].size / sizeof(BakedMaterial);
+
+	// NOTE! Primitives keep references to the materials, so the vector must not reallocate afterwards
+	mMaterials.resize(materialCount);
+	for (size_t i = 0; i < materialCount; ++i)
+	{
+		auto& material = mMaterials[i];
+		material.baseColorFactor = glm::make_vec4(pMaterials[i].baseColorFactor);
+		material.alphaCutoff = pMaterials[i].alphaCutoff;
+		material.metallicFactor = pMaterials[i].metallicFactor;
+		material.roughnessFactor = pMaterials[i].roughnessFactor;
+		material.alphaMode = static_cast<Material::AlphaMode>(pMaterials[i].alphaMode);
 	}
 
-	// Node contains mesh data
-	if (node.mesh > -1)
+	// node hierarchy + primitives
+	const BakedPrimitive* pPrimitives = reinterpret_cast<const BakedPrimitive*>(mBakedFile.pData + pHeader->sections[SECTION_PRIMITIVES].offset);
+	const BakedNode* pBakedNodes = reinterpret_cast<const BakedNode*>(mBakedFile.pData + pHeader->sections[SECTION_NODES].offset);
+	const size_t nodeCount = pHeader->sections[SECTION_NODES].size / sizeof(BakedNode);
+
+	std::vector<glTF2Loader::Impl::Node*> nodes(nodeCount, nullptr);
+	for (size_t i = 0; i < nodeCount; ++i)
 	{
-		const tinygltf::Mesh& mesh = model.meshes[node.mesh];
-		glTF2Loader::Impl::Mesh* pNewMesh = GE_ALLOC(glTF2Loader::Impl::Mesh);
-		pNewMesh->name = mesh.name;
-		for (size_t j = 0; j < mesh.primitives.size(); j++)
+		const BakedNode& bakedNode = pBakedNodes[i];
+
+		glTF2Loader::Impl::Node* pNewNode = GE_ALLOC(glTF2Loader::Impl::Node);
+		assert(pNewNode != nullptr);
+		pNewNode->index = bakedNode.index;
+		pNewNode->matrix = glm::make_mat4x4(bakedNode.localMatrix);
+
+		if (bakedNode.primitiveCount > 0)
 		{
-			const tinygltf::Primitive& primitive = mesh.primitives[j];
-			if (primitive.indices < 0)
+			glTF2Loader::Impl::Mesh* pNewMesh = GE_ALLOC(glTF2Loader::Impl::Mesh);
+			assert(pNewMesh != nullptr);
+
+			for (uint32_t p = bakedNode.firstPrimitive; p < bakedNode.firstPrimitive + bakedNode.primitiveCount; ++p)
 			{
-				continue;
+				const BakedPrimitive& bakedPrimitive = pPrimitives[p];
+
+				glTF2Loader::Impl::Primitive* pNewPrimitive = GE_ALLOC(glTF2Loader::Impl::Primitive)(bakedPrimitive.firstIndex, bakedPrimitive.indexCount, mMaterials[bakedPrimitive.materialIndex]);
+				pNewPrimitive->firstVertex = bakedPrimitive.firstVertex;
+				pNewPrimitive->vertexCount = bakedPrimitive.vertexCount;
+				pNewPrimitive->firstMeshlet = bakedPrimitive.firstMeshlet;
+				pNewPrimitive->meshletCount = bakedPrimitive.meshletCount;
+				pNewPrimitive->firstLOD = bakedPrimitive.firstLOD;
+				pNewPrimitive->lodCount = bakedPrimitive.lodCount;
+				pNewPrimitive->setDimensions(glm::make_vec3(bakedPrimitive.min), glm::make_vec3(bakedPrimitive.max));
+				pNewMesh->primitives.push_back(pNewPrimitive);
 			}
-			uint32_t vertexStart = 0;
-			uint32_t indexStart = 0;
-			uint32_t vertexCount = 0;
-			uint32_t indexCount = 0;
-			glm::vec3 posMin{};
-			glm::vec3 posMax{};
+			pNewNode->pMesh = pNewMesh;
+		}
 
+		nodes[i] = pNewNode;
 
-			// Vertices
-			{
-				const float32_t* bufferPos = nullptr;
-				const float32_t* bufferNormals = nullptr;
-				const float32_t* bufferTexCoords = nullptr;
-				const float32_t* bufferColors = nullptr;
-				const float32_t* bufferTangents = nullptr;
-				uint32_t numColorComponents;
+		if (bakedNode.parent >= 0)
+		{
+			pNewNode->pParent = nodes[bakedNode.parent];
+			pNewNode->pParent->children.push_back(pNewNode);
+		}
+		else
+		{
+			mNodes.push_back(pNewNode);
+		}
+	}
 
-				const float32_t defaultColor[3] = { 1.0f, 1.0f, 1.0f }; // white
+	return true;
+}
 
-				// Position attribute is required
-				assert(primitive.attributes.find("POSITION") != primitive.attributes.end());
+bool_t glTF2Loader::Impl::IsBakedFileValid(const std::string& filePath, uint64_t sourceHash) const
+{
+	using namespace BakedFormat;
 
-				const tinygltf::Accessor& posAccessor = model.accessors[primitive.attributes.find("POSITION")->second];
-				const tinygltf::BufferView& posView = model.bufferViews[posAccessor.bufferView];
-				bufferPos = reinterpret_cast<const float32_t*>(&(model.buffers[posView.buffer].data[posAccessor.byteOffset + posView.byteOffset])); // no copy, just reference to
-				posMin = glm::vec3(posAccessor.minValues[0], posAccessor.minValues[1], posAccessor.minValues[2]);
-				posMax = glm::vec3(posAccessor.maxValues[0], posAccessor.maxValues[1], posAccessor.maxValues[2]);
+	// NOTE! Everything read from the mapped file is checked here, a truncated or corrupted file is rejected and the source is imported instead:
+	// the section ranges and sizes, the vertex attribute table (component counts and types), the vertex ranges of the primitives,
+	// the index values and the meshlet vertices against the vertex count, and the index, meshlet, LOD, material and node ranges
+
+	if (mBakedFile.size < sizeof(BakedHeader))
+		return false;
+
+	const BakedHeader* pHeader = reinterpret_cast<const BakedHeader*>(mBakedFile.pData);
+	if ((pHeader->magic != MAGIC) || (pHeader->version != VERSION) || (pHeader->sourceHash != sourceHash))
+		return false;
+
+	uint32_t indexSize = 0;
+	if (pHeader->indexType == static_cast<uint32_t>(IndexBuffer::IndexType::GE_IT_UINT32))
+		indexSize = sizeof(uint32_t);
+	else if (pHeader->indexType == static_cast<uint32_t>(IndexBuffer::IndexType::GE_IT_UINT16))
+		indexSize = sizeof(uint16_t);
+	else
+		return false;
+
+	// the component counts written by the import: pos 3, normal 0/3, tangent 0/4, color 0/3/4, uv 0/2 - one bit per count
+	const uint32_t validComponentCounts[5] = { (1u << 3), (1u << 0) | (1u << 3), (1u << 0) | (1u << 4), (1u << 0) | (1u << 3) | (1u << 4), (1u << 0) | (1u << 2) };
+	for (uint32_t i = 0; i < 5; ++i)
+	{
+		if ((pHeader->vertexAttributes[i] > 4) || (0 == (validComponentCounts[i] & (1u << pHeader->vertexAttributes[i]))) ||
+			(pHeader->vertexAttributeTypes[i] >= static_cast<uint32_t>(VertexFormat::AttributeType::GE_AT_COUNT)))
+			return false;
+	}
+
+	// same layout as the vertex format of the loaded model
+	VertexFormat vertexFormat(pHeader->vertexAttributes[0], pHeader->vertexAttributes[1], pHeader->vertexAttributes[2], pHeader->vertexAttributes[3], pHeader->vertexAttributes[4]);
+	const VertexFormat::VertexAttribute attributes[5] =
+	{
+		VertexFormat::VertexAttribute::GE_VA_POSITION, VertexFormat::VertexAttribute::GE_VA_NORMAL, VertexFormat::VertexAttribute::GE_VA_TANGENT,
+		VertexFormat::VertexAttribute::GE_VA_COLOR, VertexFormat::VertexAttribute::GE_VA_TEXTURE_COORD
+	};
+	for (uint32_t i = 0; i < 5; ++i)
+	{
+		vertexFormat.SetVertexAttributeType(attributes[i], static_cast<VertexFormat::AttributeType>(pHeader->vertexAttributeTypes[i]));
+	}
+
+	const uint64_t vertexStride = vertexFormat.GetVertexTotalStride();
+	if (0 == vertexStride)
+		return false;
+
+	for (uint32_t i = 0; i < SECTION_COUNT; ++i)
+	{
+		const SectionRange& range = pHeader->sections[i];
+		if (((range.offset % ALIGNMENT) != 0) || (false == IsRangeValid(range.offset, range.size, mBakedFile.size)))
+			return false;
+	}
+
+	const auto& sections = pHeader->sections;
+	if ((sections[SECTION_VERTICES].size > UINT32_MAX) || (sections[SECTION_INDICES].size > UINT32_MAX) ||
+		((sections[SECTION_INDICES].size % indexSize) != 0) ||
+		((sections[SECTION_PRIMITIVES].size % sizeof(BakedPrimitive)) != 0) ||
+		((sections[SECTION_MATERIALS].size % sizeof(BakedMaterial)) != 0) ||
+		((sections[SECTION_NODES].size % sizeof(BakedNode)) != 0) ||
+		((sections[SECTION_MESHLETS].size % sizeof(MeshletBuilder::Meshlet)) != 0) ||
+		((sections[SECTION_MESHLET_BOUNDS].size % sizeof(MeshletBuilder::MeshletBounds)) != 0) ||
+		((sections[SECTION_MESHLET_VERTICES].size % sizeof(uint32_t)) != 0) ||
+		((sections[SECTION_MESHLET_TRIANGLES].size % 3) != 0) ||
+		((sections[SECTION_LODS].size % sizeof(BakedLOD)) != 0) ||
+		((sections[SECTION_DEPENDENCIES].size % sizeof(BakedDependency)) != 0) ||
+		(sections[SECTION_MESHLETS].size / sizeof(MeshletBuilder::Meshlet) != sections[SECTION_MESHLET_BOUNDS].size / sizeof(MeshletBuilder::MeshletBounds)) ||
+		((sections[SECTION_VERTICES].size % vertexStride) != 0))
+		return false;
+
+	const uint64_t vertexCount = sections[SECTION_VERTICES].size / vertexStride;
+	const uint64_t indexCount = sections[SECTION_INDICES].size / indexSize;
+	const uint64_t primitiveCount = sections[SECTION_PRIMITIVES].size / sizeof(BakedPrimitive);
+	const uint64_t materialCount = sections[SECTION_MATERIALS].size / sizeof(BakedMaterial);
+	const uint64_t nodeCount = sections[SECTION_NODES].size / sizeof(BakedNode);
+	const uint64_t meshletCount = sections[SECTION_MESHLETS].size / sizeof(MeshletBuilder::Meshlet);
+	const uint64_t meshletVertexCount = sections[SECTION_MESHLET_VERTICES].size / sizeof(uint32_t);
+	const uint64_t meshletTriangleCount = sections[SECTION_MESHLET_TRIANGLES].size / 3;
+	const uint64_t lodCount = sections[SECTION_LODS].size / sizeof(BakedLOD);
+
+	// the ranges used to draw and to cull
+	const BakedLOD* pLODs = reinterpret_cast<const BakedLOD*>(mBakedFile.pData + sections[SECTION_LODS].offset);
+	for (uint64_t i = 0; i < lodCount; ++i)
+	{
+		if (false == IsRangeValid(pLODs[i].firstIndex, pLODs[i].indexCount, indexCount))
+			return false;
+	}
+
+	// the meshlet vertices are model vertices, the meshlet triangles (3 bytes each) index the meshlet vertices
+	const MeshletBuilder::Meshlet* pMeshlets = reinterpret_cast<const MeshletBuilder::Meshlet*>(mBakedFile.pData + sections[SECTION_MESHLETS].offset);
+	const uint32_t* pMeshletVertices = reinterpret_cast<const uint32_t*>(mBakedFile.pData + sections[SECTION_MESHLET_VERTICES].offset);
+	const uint8_t* pMeshletTriangles = mBakedFile.pData + sections[SECTION_MESHLET_TRIANGLES].offset;
+	for (uint64_t i = 0; i < meshletCount; ++i)
+	{
+		const MeshletBuilder::Meshlet& meshlet = pMeshlets[i];
+		if ((false == IsRangeValid(meshlet.vertexOffset, meshlet.vertexCount, meshletVertexCount)) ||
+			(false == IsRangeValid(meshlet.triangleOffset, meshlet.triangleCount, meshletTriangleCount)))
+			return false;
+
+		for (uint32_t v = meshlet.vertexOffset; v < meshlet.vertexOffset + meshlet.vertexCount; ++v)
+		{
+			if (pMeshletVertices[v] >= vertexCount)
+				return false;
+		}
+
+		for (uint64_t t = meshlet.triangleOffset * 3ull; t < (meshlet.triangleOffset + static_cast<uint64_t>(meshlet.triangleCount)) * 3; ++t)
+		{
+			if (pMeshletTriangles[t] >= meshlet.vertexCount)
+				return false;
+		}
+	}
+
+	const BakedPrimitive* pPrimitives = reinterpret_cast<const BakedPrimitive*>(mBakedFile.pData + sections[SECTION_PRIMITIVES].offset);
+	for (uint64_t i = 0; i < primitiveCount; ++i)
+	{
+		const BakedPrimitive& primitive = pPrimitives[i];
+		if ((primitive.materialIndex >= materialCount) ||
+			(false == IsRangeValid(primitive.firstVertex, primitive.vertexCount, vertexCount)) ||
+			(false == IsRangeValid(primitive.firstIndex, primitive.indexCount, indexCount)) ||
+			(false == IsRangeValid(primitive.firstMeshlet, primitive.meshletCount, meshletCount)) ||
+			(false == IsRangeValid(primitive.firstLOD, primitive.lodCount, lodCount)))
+			return false;
+
+		// the indices of the primitive and of its levels are relative to its first vertex
+		const uint8_t* pIndexData = mBakedFile.pData + sections[SECTION_INDICES].offset;
+		if (false == AreIndicesValid(pIndexData, indexSize, primitive.firstIndex, primitive.indexCount, primitive.vertexCount))
+			return false;
+
+		for (uint32_t l = primitive.firstLOD; l < primitive.firstLOD + primitive.lodCount; ++l)
+		{
+			if (false == AreIndicesValid(pIndexData, indexSize, pLODs[l].firstIndex, pLODs[l].indexCount, primitive.vertexCount))
+				return false;
+		}
+
+		// the meshlet index ranges are relative to the primitive
+		for (uint32_t m = primitive.firstMeshlet; m < primitive.firstMeshlet + primitive.meshletCount; ++m)
+		{
+			if (false == IsRangeValid(pMeshlets[m].firstIndex, static_cast<uint64_t>(pMeshlets[m].triangleCount) * 3, primitive.indexCount))
+				return false;
+		}
+	}
+
+	const BakedNode* pNodes = reinterpret_cast<const BakedNode*>(mBakedFile.pData + sections[SECTION_NODES].offset);
+	for (uint64_t i = 0; i < nodeCount; ++i)
+	{
+		if ((pNodes[i].parent >= 0 && static_cast<uint64_t>(pNodes[i].parent) >= i) ||
+			(false == IsRangeValid(pNodes[i].firstPrimitive, pNodes[i].primitiveCount, primitiveCount)))
+			return false;
+	}
+
+	// last, as it reads the external buffers
+	const BakedDependency* pDependencies = reinterpret_cast<const BakedDependency*>(mBakedFile.pData + sections[SECTION_DEPENDENCIES].offset);
+	const char_t* pStrings = reinterpret_cast<const char_t*>(mBakedFile.pData + sections[SECTION_STRINGS].offset);
+	const std::string baseDir = tinygltf::GetBaseDir(filePath);
+	for (uint64_t i = 0; i < sections[SECTION_DEPENDENCIES].size / sizeof(BakedDependency); ++i)
+	{
+		if (false == IsRangeValid(pDependencies[i].uriOffset, pDependencies[i].uriSize, sections[SECTION_STRINGS].size))
+			return false;
+
+		const std::string uri(pStrings + pDependencies[i].uriOffset, pDependencies[i].uriSize);
+
+		uint64_t contentHash = 0;
+		if ((false == HashFileContent(tinygltf::JoinPath(baseDir, uri), contentHash)) || (contentHash != pDependencies[i].contentHash))
+			return false;
+	}
+
+	return true;
+}
+
+void glTF2Loader::Impl::BakeNode(glTF2Loader::Impl::Node* pNode, int32_t parent, std::vector<BakedFormat::BakedNode>& nodesOut, std::vector<BakedFormat::BakedPrimitive>& primitivesOut)
+{
+	assert(pNode != nullptr);
+
+	BakedFormat::BakedNode bakedNode{};
+	bakedNode.parent = parent;
+	bakedNode.index = pNode->index;
+	bakedNode.firstPrimitive = static_cast<uint32_t>(primitivesOut.size());
+
+	const glm::mat4 localMatrix = pNode->localMatrix();
+	::memcpy(bakedNode.localMatrix, glm::value_ptr(localMatrix), sizeof(bakedNode.localMatrix));
+
+	if (pNode->pMesh)
+	{
+		for (auto* pPrimitive : pNode->pMesh->primitives)
+		{
+			if (pPrimitive)
+			{
+				BakedFormat::BakedPrimitive bakedPrimitive{};
+				bakedPrimitive.firstIndex = pPrimitive->firstIndex;
+				bakedPrimitive.indexCount = pPrimitive->indexCount;
+				bakedPrimitive.firstVertex = pPrimitive->firstVertex;
+				bakedPrimitive.vertexCount = pPrimitive->vertexCount;
+				bakedPrimitive.firstMeshlet = pPrimitive->firstMeshlet;
+				bakedPrimitive.meshletCount = pPrimitive->meshletCount;
+				bakedPrimitive.firstLOD = pPrimitive->firstLOD;
+				bakedPrimitive.lodCount = pPrimitive->lodCount;
+				bakedPrimitive.materialIndex = static_cast<uint32_t>(&pPrimitive->material - mMaterials.data());
+				::memcpy(bakedPrimitive.min, glm::value_ptr(pPrimitive->dimensions.min), sizeof(bakedPrimitive.min));
+				::memcpy(bakedPrimitive.max, glm::value_ptr(pPrimitive->dimensions.max), sizeof(bakedPrimitive.max));
+
+				primitivesOut.push_back(bakedPrimitive);
+			}
+		}
+	}
+	bakedNode.primitiveCount = static_cast<uint32_t>(primitivesOut.size()) - bakedNode.firstPrimitive;
+
+	const int32_t nodeIndex = static_cast<int32_t>(nodesOut.size());
+	nodesOut.push_back(bakedNode);
+
+	for (auto* pChild : pNode->children)
+	{
+		BakeNode(pChild, nodeIndex, nodesOut, primitivesOut);
+	}
+}
+
+bool_t glTF2Loader::Impl::WriteBakedFile(const std::string& filePath, uint64_t sourceHash, uint32_t loadingFlags)
+{
+	GE_PROFILE_FUNCTION();
+
+	using namespace BakedFormat;
+
+	const std::string baseDir = tinygltf::GetBaseDir(filePath);
+
+	std::vector<BakedDependency> bakedDependencies(mExternalBufferUris.size());
+	std::string strings;
+	for (size_t i = 0; i < mExternalBufferUris.size(); ++i)
+	{
+		const std::string& uri = mExternalBufferUris[i];
+		if (false == HashFileContent(tinygltf::JoinPath(baseDir, uri), bakedDependencies[i].contentHash))
+		{
+			LOG_ERROR("Failed to read buffer: %s", uri.c_str());
+			return false;
+		}
+		bakedDependencies[i].uriOffset = static_cast<uint32_t>(strings.size());
+		bakedDependencies[i].uriSize = static_cast<uint32_t>(uri.size());
+		strings += uri;
+	}
+
+	std::vector<BakedNode> bakedNodes;
+	std::vector<BakedPrimitive> bakedPrimitives;
+	for (auto* pNode : mNodes)
+	{
+		BakeNode(pNode, -1, bakedNodes, bakedPrimitives);
+	}
+
+	std::vector<BakedLOD> bakedLODs(mLODs.size());
+	for (size_t i = 0; i < mLODs.size(); ++i)
+	{
+		bakedLODs[i].firstIndex = mLODs[i].firstIndex;
+		bakedLODs[i].indexCount = mLODs[i].indexCount;
+		bakedLODs[i].error = mLODs[i].error;
+	}
+
+	std::vector<BakedMaterial> bakedMaterials(mMaterials.size());
+	for (size_t i = 0; i < mMaterials.size(); ++i)
+	{
+		::memcpy(bakedMaterials[i].baseColorFactor, glm::value_ptr(mMaterials[i].baseColorFactor), sizeof(bakedMaterials[i].baseColorFactor));
+		bakedMaterials[i].alphaCutoff = mMaterials[i].alphaCutoff;
+		bakedMaterials[i].metallicFactor = mMaterials[i].metallicFactor;
+		bakedMaterials[i].roughnessFactor = mMaterials[i].roughnessFactor;
+		bakedMaterials[i].alphaMode = static_cast<uint32_t>(mMaterials[i].alphaMode);
+	}
+
+	BakedHeader header{};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.sourceHash = sourceHash;
+	header.loadingFlags = loadingFlags;
+	header.vertexAttributes[0] = mVertexAttributes.pos;
+	header.vertexAttributes[1] = mVertexAttributes.normal;
+	header.vertexAttributes[2] = mVertexAttributes.tangent;
+	header.vertexAttributes[3] = mVertexAttributes.color;
+	header.vertexAttributes[4] = mVertexAttributes.uv;
+	header.vertexAttributeTypes[0] = static_cast<uint32_t>(mVertexAttributes.posType);
+	header.vertexAttributeTypes[1] = static_cast<uint32_t>(mVertexAttributes.normalType);
+	header.vertexAttributeTypes[2] = static_cast<uint32_t>(mVertexAttributes.tangentType);
+	header.vertexAttributeTypes[3] = static_cast<uint32_t>(mVertexAttributes.colorType);
+	header.vertexAttributeTypes[4] = static_cast<uint32_t>(mVertexAttributes.uvType);
+	header.indexType = static_cast<uint32_t>(mIndexType);
+
+	const void* sectionData[SECTION_COUNT] = { mpVertexData, mpIndexData, bakedPrimitives.data(), bakedMaterials.data(), bakedNodes.data(),
+		mClusterTable.meshlets.data(), mClusterTable.bounds.data(), mClusterTable.vertices.data(), mClusterTable.triangles.data(), bakedLODs.data(),
+		bakedDependencies.data(), strings.data() };
+	header.sections[SECTION_VERTICES].size = mVertexDataSize;
+	header.sections[SECTION_INDICES].size = mIndexDataSize;
+	header.sections[SECTION_PRIMITIVES].size = bakedPrimitives.size() * sizeof(BakedPrimitive);
+	header.sections[SECTION_MATERIALS].size = bakedMaterials.size() * sizeof(BakedMaterial);
+	header.sections[SECTION_NODES].size = bakedNodes.size() * sizeof(BakedNode);
+	header.sections[SECTION_MESHLETS].size = mClusterTable.meshlets.size() * sizeof(MeshletBuilder::Meshlet);
+	header.sections[SECTION_MESHLET_BOUNDS].size = mClusterTable.bounds.size() * sizeof(MeshletBuilder::MeshletBounds);
+	header.sections[SECTION_MESHLET_VERTICES].size = mClusterTable.vertices.size() * sizeof(uint32_t);
+	header.sections[SECTION_MESHLET_TRIANGLES].size = mClusterTable.triangles.size() * sizeof(uint8_t);
+	header.sections[SECTION_LODS].size = bakedLODs.size() * sizeof(BakedLOD);
+	header.sections[SECTION_DEPENDENCIES].size = bakedDependencies.size() * sizeof(BakedDependency);
+	header.sections[SECTION_STRINGS].size = strings.size();
+
+	uint64_t offset = sizeof(BakedHeader);
+	for (uint32_t i = 0; i < SECTION_COUNT; ++i)
+	{
+		header.sections[i].offset = AlignUp(offset);
+		offset = header.sections[i].offset + header.sections[i].size;
+	}
+
+	// zero filled, so the alignment padding is deterministic
+	std::vector<uint8_t> fileData(static_cast<size_t>(AlignUp(offset)), 0);
+	::memcpy(fileData.data(), &header, sizeof(header));
+	for (uint32_t i = 0; i < SECTION_COUNT; ++i)
+	{
+		if (header.sections[i].size > 0)
+		{
+			::memcpy(fileData.data() + header.sections[i].offset, sectionData[i], static_cast<size_t>(header.sections[i].size));
+		}
+	}
+
+	return FileUtils::WriteBinaryFile(filePath + FILE_EXTENSION, fileData.data(), fileData.size());
+}
+
+bool_t glTF2Loader::Impl::LoadImages(tinygltf::Model& gltfModel)
+{
+	//TODO
+
+	return true;
+}
+
+bool_t glTF2Loader::Impl::LoadMaterials(tinygltf::Model& gltfModel)
+{
+	for (tinygltf::Material& mat : gltfModel.materials)
+	{
+		glTF2Loader::Impl::Material material;
+		if (mat.values.find("baseColorTexture") != mat.values.end()) {
+			material.pBaseColorTexture = GetTexture(gltfModel.textures[mat.values["baseColorTexture"].TextureIndex()].source);
+		}
+		// Metallic roughness workflow
+		if (mat.values.find("metallicRoughnessTexture") != mat.values.end()) {
+			material.pMetallicRoughnessTexture = GetTexture(gltfModel.textures[mat.values["metallicRoughnessTexture"].TextureIndex()].source);
+		}
+		if (mat.values.find("roughnessFactor") != mat.values.end()) {
+			material.roughnessFactor = static_cast<float32_t>(mat.values["roughnessFactor"].Factor());
+		}
+		if (mat.values.find("metallicFactor") != mat.values.end()) {
+			material.metallicFactor = static_cast<float32_t>(mat.values["metallicFactor"].Factor());
+		}
+		if (mat.values.find("baseColorFactor") != mat.values.end()) {
+			material.baseColorFactor = glm::make_vec4(mat.values["baseColorFactor"].ColorFactor().data());
+		}
+		if (mat.additionalValues.find("normalTexture") != mat.additionalValues.end()) {
+			material.pNormalTexture = GetTexture(gltfModel.textures[mat.additionalValues["normalTexture"].TextureIndex()].source);
+		}
+		else {
+		//	material.normalTexture = &emptyTexture; //TODO
+		}
+		if (mat.additionalValues.find("emissiveTexture") != mat.additionalValues.end()) {
+			material.pEmissiveTexture = GetTexture(gltfModel.textures[mat.additionalValues["emissiveTexture"].TextureIndex()].source);
+		}
+		if (mat.additionalValues.find("occlusionTexture") != mat.additionalValues.end()) {
+			material.pOcclusionTexture = GetTexture(gltfModel.textures[mat.additionalValues["occlusionTexture"].TextureIndex()].source);
+		}
+		if (mat.additionalValues.find("alphaMode") != mat.additionalValues.end()) {
+			tinygltf::Parameter param = mat.additionalValues["alphaMode"];
+			if (param.string_value == "BLEND") {
+				material.alphaMode = Material::ALPHAMODE_BLEND;
+			}
+			if (param.string_value == "MASK") {
+				material.alphaMode = Material::ALPHAMODE_MASK;
+			}
+		}
+		if (mat.additionalValues.find("alphaCutoff") != mat.additionalValues.end()) {
+			material.alphaCutoff = static_cast<float32_t>(mat.additionalValues["alphaCutoff"].Factor());
+		}
+
+		mMaterials.push_back(material);
+	}
+	// Push a default material at the end of the list for meshes with no material assigned
+	mMaterials.push_back(Material());
+
+	return true;
+}
+
+bool_t glTF2Loader::Impl::LoadNode(glTF2Loader::Impl::Node* pParent, const tinygltf::Node& node, uint32_t nodeIndex, const tinygltf::Model& model, uint32_t loadingFlags)
+{
+	glTF2Loader::Impl::Node* pNewNode = GE_ALLOC(glTF2Loader::Impl::Node);
+	pNewNode->index = nodeIndex;
+	pNewNode->pParent = pParent;
+	pNewNode->name = node.name;
+
+	// Generate local node matrix
+	if (node.translation.size() == 3) {
+		glm::vec3 translation = glm::make_vec3(node.translation.data());
+		pNewNode->translation = translation;
+	}
+	if (node.rotation.size() == 4) {
+		glm::quat q = glm::make_quat(node.rotation.data());
+		pNewNode->rotation = glm::mat4(q);
+	}
+	if (node.scale.size() == 3) {
+		glm::vec3 scale = glm::make_vec3(node.scale.data());
+		pNewNode->scale = scale;
+	}
+	if (node.matrix.size() == 16) {
+		pNewNode->matrix = glm::make_mat4x4(node.matrix.data());
+	}
+
+	// Node with children
+	if (node.children.size() > 0) {
+		for (auto i = 0; i < node.children.size(); i++) {
+			LoadNode(pNewNode, model.nodes[node.children[i]], node.children[i], model, loadingFlags);
+		}
+	}
+
+	// Node contains mesh data
+	if (node.mesh > -1)
+	{
+		const tinygltf::Mesh& mesh = model.meshes[node.mesh];
+		glTF2Loader::Impl::Mesh* pNewMesh = GE_ALLOC(glTF2Loader::Impl::Mesh);
+		pNewMesh->name = mesh.name;
+		for (size_t j = 0; j < mesh.primitives.size(); j++)
+		{
+			const tinygltf::Primitive& primitive = mesh.primitives[j];
+			if (primitive.indices < 0)
+			{
+				continue;
+			}
+			uint32_t vertexStart = 0;
+			uint32_t indexStart = 0;
+			uint32_t vertexCount = 0;
+			uint32_t indexCount = 0;
+			glm::vec3 posMin{};
+			glm::vec3 posMax{};
+
+
+			// Vertices
+			{
+				const float32_t* bufferPos = nullptr;
+				const float32_t* bufferNormals = nullptr;
+				const float32_t* bufferTexCoords = nullptr;
+				const float32_t* bufferColors = nullptr;
+				const float32_t* bufferTangents = nullptr;
+				uint32_t numColorComponents;
+
+				const float32_t defaultColor[3] = { 1.0f, 1.0f, 1.0f }; // white
+
+				// Position attribute is required
+				assert(primitive.attributes.find("POSITION") != primitive.attributes.end());
+
+				const tinygltf::Accessor& posAccessor = model.accessors[primitive.attributes.find("POSITION")->second];
+				const tinygltf::BufferView& posView = model.bufferViews[posAccessor.bufferView];
+				bufferPos = reinterpret_cast<const float32_t*>(&(model.buffers[posView.buffer].data[posAccessor.byteOffset + posView.byteOffset])); // no copy, just reference to
+				posMin = glm::vec3(posAccessor.minValues[0], posAccessor.minValues[1], posAccessor.minValues[2]);
+				posMax = glm::vec3(posAccessor.maxValues[0], posAccessor.maxValues[1], posAccessor.maxValues[2]);
 				mVertexAttributes.pos = 3;
 
 				if (loadingFlags & LoadingFlags::GE_LF_LIT
@@ -646,17 +1422,286 @@ void glTF2Loader::Impl::ApplyFlagsOnNode(glTF2Loader::Impl::Node* pNode, uint32_
 	}
 }
 
-void glTF2Loader::Impl::Primitive::setDimensions(glm::vec3 min, glm::vec3 max)
+void glTF2Loader::Impl::CollectPrimitives(glTF2Loader::Impl::Node* pNode, std::vector<glTF2Loader::Impl::Primitive*>& primitivesOut)
 {
-	dimensions.min = min;
-	dimensions.max = max;
-	dimensions.size = max - min;
-	dimensions.center = (min + max) / 2.0f;
-	dimensions.radius = glm::distance(min, max) / 2.0f;
-}
+	assert(pNode != nullptr);
 
-glTF2Loader::Impl::Mesh::~Mesh()
-{
+	if (pNode->pMesh)
+	{
+		for (auto* pPrimitive : pNode->pMesh->primitives)
+		{
+			if (pPrimitive && (pPrimitive->indexCount > 0))
+			{
+				primitivesOut.push_back(pPrimitive);
+			}
+		}
+	}
+
+	for (auto* pChild : pNode->children)
+	{
+		CollectPrimitives(pChild, primitivesOut);
+	}
+}
+
+void glTF2Loader::Impl::OptimizeMesh(const std::vector<glTF2Loader::Impl::Primitive*>& primitives)
+{
+	GE_PROFILE_FUNCTION();
+
+	if (mIndexBuffer.empty() || (mVertexAttributes.pos == 0))
+	{
+		return;
+	}
+
+	const uint32_t vertexStride = mVertexAttributes.size() * sizeof(float32_t);
+	const uint32_t vertexCount = static_cast<uint32_t>(mVertexBuffer.size() * sizeof(float32_t) / vertexStride);
+	const uint32_t indexCount = static_cast<uint32_t>(mIndexBuffer.size());
+
+	const auto statsBefore = MeshOptimizer::AnalyzeVertexCache(mIndexBuffer.data(), indexCount);
+
+	MeshOptimizer::DeduplicateVertices(mVertexBuffer.data(), vertexCount, vertexStride, mIndexBuffer.data(), indexCount);
+
+	// triangles are reordered only inside their own primitive, so the draw ranges stay valid
+	for (auto* pPrimitive : primitives)
+	{
+		assert(pPrimitive->firstIndex + pPrimitive->indexCount <= indexCount);
+
+		uint32_t* pIndices = mIndexBuffer.data() + pPrimitive->firstIndex;
+		MeshOptimizer::OptimizeVertexCache(pIndices, pPrimitive->indexCount);
+		MeshOptimizer::OptimizeOverdraw(pIndices, pPrimitive->indexCount, mVertexBuffer.data(), vertexStride, mVertexAttributes.posOffset() * sizeof(float32_t));
+	}
+
+	const uint32_t usedVertexCount = MeshOptimizer::OptimizeVertexFetch(mVertexBuffer.data(), vertexCount, vertexStride, mIndexBuffer.data(), indexCount);
+	mVertexBuffer.resize(usedVertexCount * mVertexAttributes.size());
+	// NOTE! The primitives vertex ranges are updated by CompactIndices()
+
+	const auto statsAfter = MeshOptimizer::AnalyzeVertexCache(mIndexBuffer.data(), indexCount);
+
+	LOG_INFO("Mesh optimization - ACMR: %.3f -> %.3f, ATVR: %.3f -> %.3f, vertices: %u -> %u",
+		statsBefore.acmr, statsAfter.acmr, statsBefore.atvr, statsAfter.atvr, vertexCount, usedVertexCount);
+}
+
+void glTF2Loader::Impl::CompactIndices(const std::string& filePath, const std::vector<glTF2Loader::Impl::Primitive*>& primitives)
+{
+	// rebase the indices to the first vertex of their primitive, the base vertex is applied at draw time
+	uint32_t maxRelativeIndex = 0;
+	for (auto* pPrimitive : primitives)
+	{
+		assert(pPrimitive->firstIndex + pPrimitive->indexCount <= mIndexBuffer.size());
+
+		uint32_t minIndex = mIndexBuffer[pPrimitive->firstIndex], maxIndex = minIndex;
+		for (uint32_t i = pPrimitive->firstIndex; i < pPrimitive->firstIndex + pPrimitive->indexCount; ++i)
+		{
+			minIndex = glm::min(minIndex, mIndexBuffer[i]);
+			maxIndex = glm::max(maxIndex, mIndexBuffer[i]);
+		}
+		pPrimitive->firstVertex = minIndex;
+		pPrimitive->vertexCount = maxIndex - minIndex + 1;
+
+		for (uint32_t i = pPrimitive->firstIndex; i < pPrimitive->firstIndex + pPrimitive->indexCount; ++i)
+		{
+			mIndexBuffer[i] -= minIndex;
+		}
+
+		// the levels use a subset of the primitive vertices
+		for (uint32_t l = pPrimitive->firstLOD; l < pPrimitive->firstLOD + pPrimitive->lodCount; ++l)
+		{
+			for (uint32_t i = mLODs[l].firstIndex; i < mLODs[l].firstIndex + mLODs[l].indexCount; ++i)
+			{
+				assert(mIndexBuffer[i] >= minIndex);
+				mIndexBuffer[i] -= minIndex;
+			}
+		}
+		maxRelativeIndex = glm::max(maxRelativeIndex, maxIndex - minIndex);
+	}
+
+	const uint32_t size32 = static_cast<uint32_t>(mIndexBuffer.size() * sizeof(uint32_t));
+
+	// 0xFFFF is kept free as it is the primitive restart index
+	if ((false == mIndexBuffer.empty()) && (maxRelativeIndex < 0xFFFF))
+	{
+		mIndexBuffer16.assign(mIndexBuffer.begin(), mIndexBuffer.end());
+		std::vector<uint32_t>().swap(mIndexBuffer);
+
+		mIndexType = IndexBuffer::IndexType::GE_IT_UINT16;
+		mpIndexData = mIndexBuffer16.data();
+		mIndexDataSize = static_cast<uint32_t>(mIndexBuffer16.size() * sizeof(uint16_t));
+
+		LOG_INFO("Index buffer compacted to 16 bit - %s: %u bytes -> %u bytes, saved %u bytes", filePath.c_str(), size32, mIndexDataSize, size32 - mIndexDataSize);
+	}
+	else
+	{
+		mIndexType = IndexBuffer::IndexType::GE_IT_UINT32;
+		mpIndexData = mIndexBuffer.data();
+		mIndexDataSize = size32;
+
+		LOG_INFO("Index buffer kept 32 bit - %s: %u bytes, max primitive index: %u, saved 0 bytes", filePath.c_str(), size32, maxRelativeIndex);
+	}
+}
+
+void glTF2Loader::Impl::BuildMeshlets(const std::vector<glTF2Loader::Impl::Primitive*>& primitives)
+{
+	GE_PROFILE_FUNCTION();
+
+	if (mIndexBuffer.empty() || (mVertexAttributes.pos == 0))
+		return;
+
+	const uint32_t vertexStride = mVertexAttributes.size() * sizeof(float32_t);
+	const uint32_t vertexCount = static_cast<uint32_t>(mVertexBuffer.size() / mVertexAttributes.size());
+
+	for (auto* pPrimitive : primitives)
+	{
+		const uint32_t* pIndices = &mIndexBuffer[pPrimitive->firstIndex];
+
+		pPrimitive->firstMeshlet = static_cast<uint32_t>(mClusterTable.meshlets.size());
+		pPrimitive->meshletCount = MeshletBuilder::BuildMeshlets(pIndices, pPrimitive->indexCount, vertexCount, mClusterTable);
+
+		MeshletBuilder::ComputeMeshletBounds(mClusterTable, pPrimitive->firstMeshlet, mVertexBuffer.data(), vertexStride, mVertexAttributes.posOffset() * sizeof(float32_t));
+
+		assert(MeshletBuilder::ValidateMeshlets(mClusterTable, pPrimitive->firstMeshlet, pPrimitive->meshletCount, pIndices, pPrimitive->indexCount));
+	}
+
+	LOG_INFO("Meshlets built - %u meshlets for %u triangles", static_cast<uint32_t>(mClusterTable.meshlets.size()), static_cast<uint32_t>(mIndexBuffer.size() / 3));
+}
+
+void glTF2Loader::Impl::GenerateLODs(const std::vector<glTF2Loader::Impl::Primitive*>& primitives)
+{
+	GE_PROFILE_FUNCTION();
+
+	if (mIndexBuffer.empty() || (mVertexAttributes.pos == 0))
+		return;
+
+	const uint32_t vertexStride = mVertexAttributes.size() * sizeof(float32_t);
+	const uint32_t positionOffset = mVertexAttributes.posOffset() * sizeof(float32_t);
+	const uint32_t sourceIndexCount = static_cast<uint32_t>(mIndexBuffer.size());
+
+	std::vector<uint32_t> sourceIndices, lodIndices;
+	for (auto* pPrimitive : primitives)
+	{
+		pPrimitive->firstLOD = static_cast<uint32_t>(mLODs.size());
+		pPrimitive->lodCount = 0;
+
+		// only the vertex range of the primitive is given to the simplifier
+		sourceIndices.assign(mIndexBuffer.begin() + pPrimitive->firstIndex, mIndexBuffer.begin() + pPrimitive->firstIndex + pPrimitive->indexCount);
+
+		uint32_t minIndex = sourceIndices[0], maxIndex = minIndex;
+		for (auto index : sourceIndices)
+		{
+			minIndex = glm::min(minIndex, index);
+			maxIndex = glm::max(maxIndex, index);
+		}
+		for (auto& index : sourceIndices)
+		{
+			index -= minIndex;
+		}
+
+		const float32_t* pVertices = mVertexBuffer.data() + minIndex * mVertexAttributes.size();
+		lodIndices.resize(pPrimitive->indexCount);
+
+		// each level is simplified from the source, so its error is the distance to the source
+		uint32_t previousIndexCount = pPrimitive->indexCount;
+		for (uint32_t level = 1; level < MAX_LOD_LEVELS; ++level)
+		{
+			const uint32_t targetIndexCount = (pPrimitive->indexCount >> level) / 3 * 3;
+
+			float32_t error = 0.0f;
+			const uint32_t indexCount = MeshSimplifier::Simplify(sourceIndices.data(), pPrimitive->indexCount, pVertices, maxIndex - minIndex + 1, vertexStride, positionOffset,
+				targetIndexCount, FLT_MAX, lodIndices.data(), &error);
+
+			// the seams and the borders are kept, so the simplification can stop early, the level must be worth it
+			if ((0 == indexCount) || (indexCount > previousIndexCount * 3 / 4))
+				break;
+
+			LOD lod;
+			lod.firstIndex = static_cast<uint32_t>(mIndexBuffer.size());
+			lod.indexCount = indexCount;
+			lod.error = error;
+
+			for (uint32_t i = 0; i < indexCount; ++i)
+			{
+				mIndexBuffer.push_back(lodIndices[i] + minIndex);
+			}
+
+			mLODs.push_back(lod);
+			pPrimitive->lodCount++;
+
+			previousIndexCount = indexCount;
+		}
+	}
+
+	LOG_INFO("Levels of detail generated - %u levels for %u primitives, triangles: %u + %u", static_cast<uint32_t>(mLODs.size()), static_cast<uint32_t>(primitives.size()),
+		sourceIndexCount / 3, static_cast<uint32_t>(mIndexBuffer.size() - sourceIndexCount) / 3);
+}
+
+const glTF2Loader::Impl::LOD* glTF2Loader::Impl::GetLOD(const glTF2Loader::Impl::Primitive* pPrimitive) const
+{
+	assert(pPrimitive != nullptr);
+
+	if ((0 == mLODLevel) || (0 == pPrimitive->lodCount))
+		return nullptr;
+
+	return &mLODs[pPrimitive->firstLOD + glm::min(mLODLevel, pPrimitive->lodCount) - 1];
+}
+
+void glTF2Loader::Impl::QuantizeMesh(uint32_t loadingFlags)
+{
+	GE_PROFILE_FUNCTION();
+
+	if (mVertexBuffer.empty() || (mVertexAttributes.size() == 0))
+		return;
+
+	typedef VertexFormat::VertexAttribute VA;
+	typedef VertexFormat::AttributeType AT;
+
+	const VertexFormat srcFormat(mVertexAttributes.pos, mVertexAttributes.normal, mVertexAttributes.tangent, mVertexAttributes.color, mVertexAttributes.uv);
+
+	// NOTE! Positions go to half floats, so the model should be authored/pre-transformed in a reasonable range around the origin
+	VertexFormat dstFormat(srcFormat);
+	dstFormat.SetVertexAttributeType(VA::GE_VA_POSITION, AT::GE_AT_FLOAT16);
+	dstFormat.SetVertexAttributeType(VA::GE_VA_NORMAL,
+		((loadingFlags & LoadingFlags::GE_LF_OCTAHEDRAL_NORMALS) && (mVertexAttributes.normal == 3)) ? AT::GE_AT_OCTAHEDRAL_SNORM16 : AT::GE_AT_SNORM8);
+	dstFormat.SetVertexAttributeType(VA::GE_VA_TANGENT, AT::GE_AT_SNORM8);
+	dstFormat.SetVertexAttributeType(VA::GE_VA_COLOR, AT::GE_AT_UNORM8);
+	dstFormat.SetVertexAttributeType(VA::GE_VA_TEXTURE_COORD, AT::GE_AT_FLOAT16);
+
+	const uint32_t vertexCount = static_cast<uint32_t>(mVertexBuffer.size() / mVertexAttributes.size());
+	mQuantizedVertexBuffer.resize(vertexCount * dstFormat.GetVertexTotalStride());
+
+	if (false == MeshQuantizer::QuantizeVertices(mVertexBuffer.data(), srcFormat, vertexCount, dstFormat, mQuantizedVertexBuffer.data()))
+	{
+		LOG_WARNING("Failed to quantize the vertices, keeping the float data");
+		std::vector<uint8_t>().swap(mQuantizedVertexBuffer);
+		return;
+	}
+
+	mVertexAttributes.posType = dstFormat.GetVertexAttributeType(VA::GE_VA_POSITION);
+	mVertexAttributes.normalType = dstFormat.GetVertexAttributeType(VA::GE_VA_NORMAL);
+	mVertexAttributes.tangentType = dstFormat.GetVertexAttributeType(VA::GE_VA_TANGENT);
+	mVertexAttributes.colorType = dstFormat.GetVertexAttributeType(VA::GE_VA_COLOR);
+	mVertexAttributes.uvType = dstFormat.GetVertexAttributeType(VA::GE_VA_TEXTURE_COORD);
+
+	std::vector<float32_t>().swap(mVertexBuffer);
+
+	mpVertexData = mQuantizedVertexBuffer.data();
+	mVertexDataSize = static_cast<uint32_t>(mQuantizedVertexBuffer.size());
+
+	// vertex fetch bandwidth scales with the stride
+	LOG_INFO("Vertex data quantized - stride: %u bytes -> %u bytes, vertex buffer: %u bytes -> %u bytes (%.1f%%)",
+		srcFormat.GetVertexTotalStride(), dstFormat.GetVertexTotalStride(),
+		vertexCount * srcFormat.GetVertexTotalStride(), mVertexDataSize,
+		100.0f * mVertexDataSize / (vertexCount * srcFormat.GetVertexTotalStride()));
+}
+
+void glTF2Loader::Impl::Primitive::setDimensions(glm::vec3 min, glm::vec3 max)
+{
+	dimensions.min = min;
+	dimensions.max = max;
+	dimensions.size = max - min;
+	dimensions.center = (min + max) / 2.0f;
+	dimensions.radius = glm::distance(min, max) / 2.0f;
+}
+
+glTF2Loader::Impl::Mesh::~Mesh()
+{
 	for (auto& primitive : primitives)
 	{
 		GE_FREE(primitive);
@@ -704,7 +1749,7 @@ glTF2Loader::Impl::Texture* glTF2Loader::Impl::GetTexture(uint32_t index)
 	return nullptr;
 }
 
-void glTF2Loader::Impl::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB)
+void glTF2Loader::Impl::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
 {
 	for (auto& node : mNodes)
 	{
@@ -712,15 +1757,133 @@ void glTF2Loader::Impl::Draw(std::function<void(uint32_t indexCount, uint32_t fi
 	}
 }
 
-void glTF2Loader::Impl::DrawNode(glTF2Loader::Impl::Node* pNode, std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB)
+void glTF2Loader::Impl::DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
+{
+	for (auto& node : mNodes)
+	{
+		DrawNodeVisible(node, frustum, cameraPosition, onDrawCB);
+	}
+}
+
+void glTF2Loader::Impl::DrawMeshlets(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB)
+{
+	for (auto& node : mNodes)
+	{
+		DrawNodeMeshlets(node, onDrawCB);
+	}
+}
+
+void glTF2Loader::Impl::DrawNodeMeshlets(glTF2Loader::Impl::Node* pNode, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB)
 {
 	if (pNode && pNode->pMesh)
 	{
 		for (auto* pPrimitive : pNode->pMesh->primitives)
 		{
-			if (pPrimitive)
+			if (nullptr == pPrimitive)
+				continue;
+
+			// the meshlets are the ones of the level 0
+			const auto* pLOD = GetLOD(pPrimitive);
+			if (pLOD)
 			{
-				onDrawCB(pPrimitive->indexCount, pPrimitive->firstIndex);
+				onDrawCB(pLOD->indexCount, pLOD->firstIndex, static_cast<int32_t>(pPrimitive->firstVertex), nullptr);
+				continue;
+			}
+
+			if (pPrimitive->meshletCount == 0)
+			{
+				onDrawCB(pPrimitive->indexCount, pPrimitive->firstIndex, static_cast<int32_t>(pPrimitive->firstVertex), nullptr);
+				continue;
+			}
+
+			for (uint32_t m = pPrimitive->firstMeshlet; m < pPrimitive->firstMeshlet + pPrimitive->meshletCount; ++m)
+			{
+				const auto& meshlet = mClusterTable.meshlets[m];
+
+				onDrawCB(meshlet.triangleCount * 3, pPrimitive->firstIndex + meshlet.firstIndex, static_cast<int32_t>(pPrimitive->firstVertex), &mClusterTable.bounds[m]);
+			}
+		}
+
+		for (auto& child : pNode->children)
+		{
+			DrawNodeMeshlets(child, onDrawCB);
+		}
+	}
+}
+
+void glTF2Loader::Impl::DrawNodeVisible(glTF2Loader::Impl::Node* pNode, const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
+{
+	if (pNode && pNode->pMesh)
+	{
+		for (auto* pPrimitive : pNode->pMesh->primitives)
+		{
+			if (nullptr == pPrimitive)
+				continue;
+
+			// the meshlets are the ones of the level 0
+			const auto* pLOD = GetLOD(pPrimitive);
+			if (pLOD)
+			{
+				onDrawCB(pLOD->indexCount, pLOD->firstIndex, static_cast<int32_t>(pPrimitive->firstVertex));
+				continue;
+			}
+
+			if (pPrimitive->meshletCount == 0)
+			{
+				onDrawCB(pPrimitive->indexCount, pPrimitive->firstIndex, static_cast<int32_t>(pPrimitive->firstVertex));
+				continue;
+			}
+
+			// the meshlets are contiguous index ranges, so neighbouring visible meshlets are merged in a single draw
+			uint32_t rangeStart = 0, rangeCount = 0;
+			for (uint32_t m = pPrimitive->firstMeshlet; m < pPrimitive->firstMeshlet + pPrimitive->meshletCount; ++m)
+			{
+				const auto& meshlet = mClusterTable.meshlets[m];
+				if (MeshletBuilder::IsMeshletVisible(mClusterTable.bounds[m], frustum, cameraPosition))
+				{
+					if (rangeCount == 0)
+					{
+						rangeStart = meshlet.firstIndex;
+					}
+					rangeCount += meshlet.triangleCount * 3;
+				}
+				else if (rangeCount > 0)
+				{
+					onDrawCB(rangeCount, pPrimitive->firstIndex + rangeStart, static_cast<int32_t>(pPrimitive->firstVertex));
+					rangeCount = 0;
+				}
+			}
+
+			if (rangeCount > 0)
+			{
+				onDrawCB(rangeCount, pPrimitive->firstIndex + rangeStart, static_cast<int32_t>(pPrimitive->firstVertex));
+			}
+		}
+
+		for (auto& child : pNode->children)
+		{
+			DrawNodeVisible(child, frustum, cameraPosition, onDrawCB);
+		}
+	}
+}
+
+void glTF2Loader::Impl::DrawNode(glTF2Loader::Impl::Node* pNode, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
+{
+	if (pNode && pNode->pMesh)
+	{
+		for (auto* pPrimitive : pNode->pMesh->primitives)
+		{
+			if (nullptr == pPrimitive)
+				continue;
+
+			const auto* pLOD = GetLOD(pPrimitive);
+			if (pLOD)
+			{
+				onDrawCB(pLOD->indexCount, pLOD->firstIndex, static_cast<int32_t>(pPrimitive->firstVertex));
+			}
+			else
+			{
+				onDrawCB(pPrimitive->indexCount, pPrimitive->firstIndex, static_cast<int32_t>(pPrimitive->firstVertex));
 			}
 		}
 
@@ -749,13 +1912,138 @@ glTF2Loader::~glTF2Loader()
 	GE_FREE(mpImpl);
 }
 
-void glTF2Loader::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB)
+bool_t glTF2Loader::Bake(const std::string& filePath, uint32_t loadingFlags)
+{
+	glTF2Loader::Impl impl;
+
+	uint64_t sourceHash = 0;
+	if (false == impl.ComputeSourceHash(filePath, loadingFlags, sourceHash))
+	{
+		LOG_ERROR("Failed to read file: %s", filePath.c_str());
+		return false;
+	}
+
+	if (false == impl.LoadFromglTFFile(filePath, loadingFlags))
+	{
+		return false;
+	}
+
+	return impl.WriteBakedFile(filePath, sourceHash, loadingFlags);
+}
+
+void glTF2Loader::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
 {
 	assert(mpImpl != nullptr);
 
 	mpImpl->Draw(onDrawCB);
 }
 
+void glTF2Loader::DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
+{
+	assert(mpImpl != nullptr);
+
+	mpImpl->DrawVisible(frustum, cameraPosition, onDrawCB);
+}
+
+void glTF2Loader::DrawMeshlets(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB)
+{
+	assert(mpImpl != nullptr);
+
+	mpImpl->DrawMeshlets(onDrawCB);
+}
+
+uint32_t glTF2Loader::GetMeshletCount() const
+{
+	assert(mpImpl != nullptr);
+
+	return static_cast<uint32_t>(mpImpl->mClusterTable.meshlets.size());
+}
+
+void glTF2Loader::SetLODLevel(uint32_t level)
+{
+	assert(mpImpl != nullptr);
+	assert(level < MAX_LOD_LEVELS);
+
+	mpImpl->mLODLevel = level;
+}
+
+uint32_t glTF2Loader::GetLODLevel() const
+{
+	assert(mpImpl != nullptr);
+
+	return mpImpl->mLODLevel;
+}
+
+uint32_t glTF2Loader::GetLODLevelCount() const
+{
+	assert(mpImpl != nullptr);
+
+	std::vector<glTF2Loader::Impl::Primitive*> primitives;
+	for (auto* pNode : mpImpl->mNodes)
+	{
+		mpImpl->CollectPrimitives(pNode, primitives);
+	}
+
+	uint32_t levelCount = 1;
+	for (auto* pPrimitive : primitives)
+	{
+		levelCount = glm::max(levelCount, pPrimitive->lodCount + 1);
+	}
+
+	return levelCount;
+}
+
+float32_t glTF2Loader::GetLODError(uint32_t level) const
+{
+	assert(mpImpl != nullptr);
+
+	if (0 == level)
+		return 0.0f;
+
+	std::vector<glTF2Loader::Impl::Primitive*> primitives;
+	for (auto* pNode : mpImpl->mNodes)
+	{
+		mpImpl->CollectPrimitives(pNode, primitives);
+	}
+
+	float32_t error = 0.0f;
+	for (auto* pPrimitive : primitives)
+	{
+		if (pPrimitive->lodCount > 0)
+		{
+			error = glm::max(error, mpImpl->mLODs[pPrimitive->firstLOD + glm::min(level, pPrimitive->lodCount) - 1].error);
+		}
+	}
+
+	return error;
+}
+
+uint32_t glTF2Loader::GetLODIndexCount(uint32_t level) const
+{
+	assert(mpImpl != nullptr);
+
+	std::vector<glTF2Loader::Impl::Primitive*> primitives;
+	for (auto* pNode : mpImpl->mNodes)
+	{
+		mpImpl->CollectPrimitives(pNode, primitives);
+	}
+
+	uint32_t indexCount = 0;
+	for (auto* pPrimitive : primitives)
+	{
+		if ((level > 0) && (pPrimitive->lodCount > 0))
+		{
+			indexCount += mpImpl->mLODs[pPrimitive->firstLOD + glm::min(level, pPrimitive->lodCount) - 1].indexCount;
+		}
+		else
+		{
+			indexCount += pPrimitive->indexCount;
+		}
+	}
+
+	return indexCount;
+}
+
 const glTF2Loader::VertexAttributes& glTF2Loader::GetVertexAttributes() const
 {
 	assert(mpImpl != nullptr);
@@ -763,16 +2051,37 @@ const glTF2Loader::VertexAttributes& glTF2Loader::GetVertexAttributes() const
 	return mpImpl->mVertexAttributes;
 }
 
-const std::vector<float32_t>& glTF2Loader::GetVertexBuffer() const
+const void* glTF2Loader::GetVertexData() const
+{
+	assert(mpImpl != nullptr);
+
+	return mpImpl->mpVertexData;
+}
+
+uint32_t glTF2Loader::GetVertexDataSize() const
+{
+	assert(mpImpl != nullptr);
+
+	return mpImpl->mVertexDataSize;
+}
+
+const void* glTF2Loader::GetIndexData() const
+{
+	assert(mpImpl != nullptr);
+
+	return mpImpl->mpIndexData;
+}
+
+uint32_t glTF2Loader::GetIndexDataSize() const
 {
 	assert(mpImpl != nullptr);
 
-	return mpImpl->mVertexBuffer;
+	return mpImpl->mIndexDataSize;
 }
 
-const std::vector<uint32_t>& glTF2Loader::GetIndexBuffer() const
+IndexBuffer::IndexType glTF2Loader::GetIndexType() const
 {
 	assert(mpImpl != nullptr);
 
-	return mpImpl->mIndexBuffer;
+	return mpImpl->mIndexType;
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #define GRAPHICS_LOADERS_GLTF2_LOADER_HPP
 
 #include "Foundation/Object.hpp"
+#include "Graphics/Rendering/Resources/IndexBuffer.hpp"
+#include "Graphics/Rendering/Resources/VertexFormat.hpp"
+#include "Graphics/GeometricPrimitives/MeshletBuilder.hpp"
 #include "glm/vec2.hpp"
 #include "glm/vec3.hpp"
 #include "glm/vec4.hpp"
@@ -13,6 +16,8 @@ namespace GraphicsEngine
 {
 	namespace Graphics
 	{
+		class Frustum;
+
 		/*
 			A simple glTF 2.0 model/scene loader.
 			No support yet for: skins, animations
@@ -30,6 +35,12 @@ namespace GraphicsEngine
 				GE_LF_COLORED = 2,
 				GE_LF_TEXTURED = 4,
 				GE_LF_LIT = 8,
+				GE_LF_BAKED = 16, // load from/write to an engine native baked file next to the source file
+				GE_LF_OPTIMIZE = 32, // vertex dedup + vertex cache/overdraw/vertex fetch reordering, see MeshOptimizer
+				GE_LF_QUANTIZE = 64, // half positions/uvs, snorm8 normals/tangents, unorm8 colors, see MeshQuantizer
+				GE_LF_OCTAHEDRAL_NORMALS = 128, // with GE_LF_QUANTIZE - octahedral snorm16 normals, decoded by the lit vertex shaders
+				GE_LF_MESHLETS = 256, // per primitive meshlets with culling data, see MeshletBuilder, DrawVisible() and DrawMeshlets() (Vulkan, with GPU_CULLING)
+				GE_LF_LODS = 512, // per primitive simplified levels of detail, see MeshSimplifier and SetLODLevel()
 				GE_LF_DEFAULT = GE_LF_NONE
 				// Others
 			};
@@ -43,12 +54,17 @@ namespace GraphicsEngine
 			COLOR
 			UV
 			...
+			NOTE! The component counts (and so the offsets below) are the ones of the float source data,
+			the types tell how each attribute is actually stored in the vertex data.
 			*/
 
 			struct VertexAttributes
 			{
 				VertexAttributes()
 					: pos(0), normal(0), tangent(0), color(0), uv(0)
+					, posType(VertexFormat::AttributeType::GE_AT_FLOAT32), normalType(VertexFormat::AttributeType::GE_AT_FLOAT32)
+					, tangentType(VertexFormat::AttributeType::GE_AT_FLOAT32), colorType(VertexFormat::AttributeType::GE_AT_FLOAT32)
+					, uvType(VertexFormat::AttributeType::GE_AT_FLOAT32)
 				{}
 
 				uint32_t size()
@@ -87,17 +103,54 @@ namespace GraphicsEngine
 				uint32_t tangent;
 				uint32_t color;
 				uint32_t uv;
+
+				VertexFormat::AttributeType posType;
+				VertexFormat::AttributeType normalType;
+				VertexFormat::AttributeType tangentType;
+				VertexFormat::AttributeType colorType;
+				VertexFormat::AttributeType uvType;
 			};
 
+			// with GE_LF_LODS - level 0 is the source mesh, each level has about half the triangles of the previous one
+			static const uint32_t MAX_LOD_LEVELS = 4;
+
 			glTF2Loader();
 			explicit glTF2Loader(const std::string& filePath, uint32_t loadingFlags = glTF2Loader::LoadingFlags::GE_LF_DEFAULT);
 			virtual ~glTF2Loader();
 
-			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB);
+			// offline bake step - parses the source file and writes the baked file used by GE_LF_BAKED loads
+			static bool_t Bake(const std::string& filePath, uint32_t loadingFlags = glTF2Loader::LoadingFlags::GE_LF_DEFAULT);
+
+			// NOTE! Indices are relative to the first vertex of each primitive, so vertexOffset must be used as base vertex
+			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+			// same as Draw(), but skips the meshlets outside the frustum or facing away from the camera
+			// NOTE! The frustum and the camera position must be in model space. Without GE_LF_MESHLETS everything is drawn.
+			void DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+			// same as Draw(), but one draw per meshlet with its model space bounds, for the culling done by the caller (e.g. on the GPU)
+			// NOTE! The primitives without meshlets and the simplified levels are drawn whole, with no bounds.
+			void DrawMeshlets(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB);
+
+			uint32_t GetMeshletCount() const;
+
+			// the level drawn by Draw() and DrawVisible(), the simplified levels are drawn without meshlet culling
+			// NOTE! The primitives with less levels draw their last level
+			void SetLODLevel(uint32_t level);
+			uint32_t GetLODLevel() const;
+			uint32_t GetLODLevelCount() const; // 1 without GE_LF_LODS
+			// the max simplification error of the primitives at the level, in model units
+			float32_t GetLODError(uint32_t level) const;
+			// the indices drawn by Draw() at the level
+			uint32_t GetLODIndexCount(uint32_t level) const;
 
 			const glTF2Loader::VertexAttributes& GetVertexAttributes() const;
-			const std::vector<float32_t>& GetVertexBuffer() const;
-			const std::vector<uint32_t>& GetIndexBuffer() const;
+
+			// NOTE! The data either lives in the loader or in the mapped baked file,
+			// so it is valid as long as the loader is alive
+			const void* GetVertexData() const; // layout given by GetVertexAttributes()
+			uint32_t GetVertexDataSize() const; // in bytes
+			const void* GetIndexData() const;
+			uint32_t GetIndexDataSize() const; // in bytes
+			IndexBuffer::IndexType GetIndexType() const; // 16 bit if all primitives fit, otherwise 32 bit
 
 		private:
 			NO_COPY_NO_MOVE_CLASS(glTF2Loader)
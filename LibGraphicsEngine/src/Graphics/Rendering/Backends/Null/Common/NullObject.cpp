@@ -0,0 +1,4 @@
+#include "Graphics/Rendering/Backends/Null/Common/NullObject.hpp"
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_COMMON_NULL_OBJECT_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_COMMON_NULL_OBJECT_HPP
+
+#include "Foundation/Object.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class NullObject : public Object
+		{
+		public:
+			DEFAULT_CLASS(NullObject)
+		};
+
+	}
+}
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_COMMON_NULL_OBJECT_HPP
\ No newline at end of file
@@ -0,0 +1,700 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/NullRenderer.hpp"
+
+#include "Foundation/Platform/Platform.hpp"
+
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Logger.hpp"
+#include "Foundation/Profiler.hpp"
+
+#include "Graphics/Rendering/RenderQueue.hpp"
+
+#include "Graphics/SceneGraph/GeometryNode.hpp"
+#include "Graphics/SceneGraph/LightNode.hpp"
+#include "Graphics/Lights/Light.hpp"
+#include "Graphics/Cameras/Camera.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+
+#include "Graphics/Components/VisualComponent.hpp"
+
+#include "Graphics/Rendering/VisualEffects/VisualEffect.hpp"
+
+#include "Graphics/Rendering/Resources/Model.hpp"
+#include "Graphics/Rendering/Resources/VertexBuffer.hpp"
+#include "Graphics/Rendering/Resources/IndexBuffer.hpp"
+#include "Graphics/Rendering/Resources/UniformBuffer.hpp"
+
+#include "glm/matrix.hpp" // glm::inverse()
+
+// Resources
+#include "Graphics/Rendering/Backends/Null/Resources/NullModel.hpp"
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+NullRenderer::NullRenderer()
+	: Renderer()
+	, mpWindow(nullptr)
+	, mpStreamFile(nullptr)
+	, mFrameIndex(0)
+	, mResourceCount(0)
+{}
+
+NullRenderer::NullRenderer(Platform::Window* pWindow, Renderer::RendererType type)
+	: Renderer(pWindow, type)
+	, mpWindow(pWindow)
+	, mpStreamFile(nullptr)
+	, mFrameIndex(0)
+	, mResourceCount(0)
+{
+	Init(pWindow);
+}
+
+NullRenderer::~NullRenderer()
+{
+	Terminate();
+}
+
+void NullRenderer::Init(Platform::Window*)
+{
+	assert(mpWindow != nullptr);
+
+	// the window size is already read by the Renderer base class
+
+#if defined(NULL_RENDERER_STREAM_FILE)
+	OpenStreamFile(NULL_RENDERER_STREAM_FILE);
+#endif // NULL_RENDERER_STREAM_FILE
+
+	Prepare();
+}
+
+void NullRenderer::Terminate()
+{
+	Renderer::Terminate();
+
+	if (mpStreamFile)
+	{
+		std::fclose(mpStreamFile);
+		mpStreamFile = nullptr;
+
+		LOG_INFO("Command stream file closed, %u frames recorded", mFrameIndex);
+	}
+
+	mPassMap.clear();
+	mCommandStream.Clear();
+}
+
+void NullRenderer::Prepare()
+{
+	LOG_INFO("Null renderer, nothing is rendered - the frames are only recorded");
+
+	mIsPrepared = true;
+}
+
+void NullRenderer::OnWindowResize(uint32_t width, uint32_t height)
+{
+	if (false == mIsPrepared)
+		return;
+
+	if (width > 0)
+		mWindowWidth = width;
+
+	if (height > 0)
+		mWindowHeight = height;
+}
+
+void NullRenderer::RenderFrame(RenderQueue* pRenderQueue)
+{
+	GE_PROFILE_FUNCTION();
+
+	if (false == mIsPrepared)
+		return;
+
+	assert(pRenderQueue != nullptr);
+
+	BeginFrame();
+
+	DrawNodes(0);
+
+	EndFrame();
+}
+
+void NullRenderer::UpdateFrame(Camera* pCamera, float32_t crrTime)
+{
+	GE_PROFILE_FUNCTION();
+
+	if (false == mIsPrepared)
+		return;
+
+	assert(mpRenderQueue != nullptr);
+
+	assert(pCamera != nullptr);
+	mpCamera = pCamera;
+
+	// the transient data of the previous frames is released here
+	mFrameAllocator.BeginFrame();
+
+	// a frame starts with its uniform updates
+	mCommandStream.Clear();
+	mCommandStream.Record(CommandStream::CommandType::GE_CT_BEGIN_FRAME, mFrameIndex);
+
+#if defined(CLUSTERED_LIGHTING)
+	// binned as by the Vulkan renderer, nothing is uploaded
+	UpdateLightClusters(pCamera);
+#endif // CLUSTERED_LIGHTING
+
+#if defined(SCENE_CULLING)
+	UpdateSceneCulling(pCamera);
+#endif // SCENE_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+	UpdateLODs(pCamera);
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+	UpdateShadowCascades(pCamera);
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+	// after the cascades, the faces of the cache are their projections
+	UpdateShadowCache();
+#endif // SHADOW_CACHING
+
+	UpdateNodes(pCamera, crrTime);
+}
+
+void NullRenderer::BeginFrame()
+{
+	//
+}
+
+void NullRenderer::EndFrame()
+{
+	//
+}
+
+void NullRenderer::SubmitFrame()
+{
+	GE_PROFILE_FUNCTION();
+
+	if (false == mIsPrepared)
+		return;
+
+	mCommandStream.Record(CommandStream::CommandType::GE_CT_END_FRAME, mFrameIndex);
+
+	if (mpStreamFile && (false == mCommandStream.Write(mpStreamFile)))
+	{
+		LOG_ERROR("Failed to write frame %u to the command stream file! The file is closed.", mFrameIndex);
+
+		std::fclose(mpStreamFile);
+		mpStreamFile = nullptr;
+	}
+
+	mFrameIndex++;
+}
+
+void NullRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
+{
+	GE_PROFILE_FUNCTION();
+
+	if (false == mIsPrepared)
+		return;
+
+	assert(pRenderQueue != nullptr);
+
+	mpRenderQueue = pRenderQueue;
+
+#if defined(DEFERRED_RENDERING)
+	// the lighting passes come first in the standard pass, they write the depth the forward nodes are tested against
+	if (GetRendererType() == RendererType::GE_RT_DEFERRED)
+	{
+		CreateLightingEffects();
+
+		for (auto* pEffect : mLightingEffects)
+		{
+			for (auto& it : pEffect->GetPasses())
+			{
+				for (auto* pPass : it.second)
+				{
+					AddVisualPass(pPass);
+				}
+			}
+
+			pEffect->InitPasses(this);
+		}
+	}
+#endif // DEFERRED_RENDERING
+
+	auto& renderableList = mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OPAQUE);
+
+	mpRenderQueue->ForEach(renderableList,
+		[&, this](const RenderQueue::Renderable* pRenderable)
+		{
+			assert(pRenderable != nullptr);
+
+			auto* pGeoNode = pRenderable->pGeometryNode;
+			assert(pGeoNode != nullptr);
+
+			auto* pVisComp = pGeoNode->GetComponent<VisualComponent>();
+			assert(pVisComp != nullptr);
+			auto* pVisEffect = pVisComp->GetVisualEffect();
+			assert(pVisEffect != nullptr);
+
+			// we didn't call this earlier as we needed to have
+			// the node info first
+			pVisEffect->Init(this);
+
+			const auto& passMap = pVisEffect->GetPasses();
+			for (auto& it : passMap)
+			{
+				auto& passVector = it.second;
+				for (auto* pPass : passVector)
+				{
+					AddVisualPass(pPass);
+				}
+			}
+
+			pVisEffect->InitPasses(this);
+		}
+	);
+
+#if defined(SCENE_CULLING)
+	BuildSceneTree();
+#endif // SCENE_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+	CollectLODNodes();
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+	BuildShadowCasters();
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+	BuildShadowCache();
+#endif // SHADOW_CACHING
+}
+
+void NullRenderer::UpdateUniformBuffers(VisualPass* pVisualPass, GeometryNode* pGeoNode, Camera* pCamera, float32_t)
+{
+	// same uniform values as the GPU backends, the buffer content is recorded by Bind()
+
+	assert(pVisualPass != nullptr);
+	assert(pGeoNode != nullptr);
+	assert(pCamera != nullptr);
+
+	// shader stages in a fixed order, the maps are unordered
+	for (uint8_t stage = 0; stage < static_cast<uint8_t>(Shader::ShaderStage::GE_SS_COUNT); ++stage)
+	{
+		auto* pUniformBuffer = pVisualPass->GetUniformBuffer(static_cast<Shader::ShaderStage>(stage));
+
+		if (pUniformBuffer)
+		{
+			const auto& uniforms = pUniformBuffer->GetUniforms();
+
+			for (const auto& uni : uniforms)
+			{
+				const auto& uniformType = uni.first;
+
+				switch (uniformType)
+				{
+				case GLSLShaderTypes::UniformType::GE_UT_PVM_MATRIX4:
+				{
+					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_PVM_MATRIX4,
+						pCamera->GetProjectionViewMatrix() * pVisualPass->GetTransform() * pGeoNode->GetModelMatrix());
+				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_PV_CUBEMAP_MATRIX4:
+				{
+					glm::mat4 PV = pCamera->GetProjectionViewMatrix();
+
+					// we remove the translation transform to allow the cubemap to never change position in world space
+					PV[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_PVM_MATRIX4, PV * pGeoNode->GetModelMatrix());
+				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_MODEL_MATRIX4:
+				{
+					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_MODEL_MATRIX4, pVisualPass->GetTransform() * pGeoNode->GetModelMatrix());
+				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_NORMAL_MATRIX4:
+				{
+					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_NORMAL_MATRIX4, pVisualPass->GetTransform() * pGeoNode->GetNormalMatrix());
+				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4:
+				{
+					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4, glm::inverse(pCamera->GetProjectionViewMatrix()));
+				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_CAMERA_POS:
+				{
+					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_CAMERA_POS, glm::vec4(pCamera->GetPosition(), 0.0f));
+				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV0_MATRIX4:
+				case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV1_MATRIX4:
+				case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV2_MATRIX4:
+				case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV3_MATRIX4:
+				{
+#if defined(CASCADED_SHADOWS)
+					// the cascades are fitted to the camera each frame, see UpdateShadowCascades()
+					// NOTE! No bias matrix, the shaders move the cascades to their atlas tiles
+					const uint32_t cascadeIdx = static_cast<uint32_t>(uniformType) - static_cast<uint32_t>(GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV0_MATRIX4);
+					if (cascadeIdx < mShadowCascades.GetCascadeCount())
+					{
+						pUniformBuffer->SetUniform(uniformType, mShadowCascades.GetCascade(cascadeIdx).projectionView);
+					}
+#endif // CASCADED_SHADOWS
+				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_CASCADE_SPLITS:
+				{
+#if defined(CASCADED_SHADOWS)
+					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_CASCADE_SPLITS, mShadowCascades.GetSplits());
+#endif // CASCADED_SHADOWS
+				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_PROJECTION_MATRIX4:
+				case GLSLShaderTypes::UniformType::GE_UT_VIEW_MATRIX4:
+				case GLSLShaderTypes::UniformType::GE_UT_COLOR_VEC4:
+				case GLSLShaderTypes::UniformType::GE_UT_LIGHT_DIR:
+				case GLSLShaderTypes::UniformType::GE_UT_LIGHT_COLOR:
+				case GLSLShaderTypes::UniformType::GE_UT_CRR_TIME:
+					// the light uniforms are set by BindLight(), the others are not used by the shaders
+					break;
+				case GLSLShaderTypes::UniformType::GE_UT_COUNT:
+				default:
+					//LOG_ERROR("Invalid uniform type! Failed to update the uniform!");
+					break;
+				}
+			}
+
+			Bind(pUniformBuffer);
+		}
+	}
+}
+
+void NullRenderer::BindLight(VisualPass* pVisualPass, const LightNode* pLightNode, GeometryNode* pGeoNode)
+{
+	assert(pVisualPass != nullptr);
+	assert(pLightNode != nullptr);
+	assert(pGeoNode != nullptr);
+
+	if (false == pGeoNode->IsLit())
+	{
+		LOG_INFO("No light to bind for this node as it is unlit!");
+		return;
+	}
+
+	auto* pLight = pLightNode->GetLight();
+	assert(pLight != nullptr);
+
+	switch (pVisualPass->GetPassType())
+	{
+	case VisualPass::PassType::GE_PT_STANDARD:
+	case VisualPass::PassType::GE_PT_OFFSCREEN:
+	{
+		auto* pVertUBO = pVisualPass->GetUniformBuffer(Shader::ShaderStage::GE_SS_VERTEX);
+		auto* pFragUBO = pVisualPass->GetUniformBuffer(Shader::ShaderStage::GE_SS_FRAGMENT);
+
+		switch (pLight->GetLightType())
+		{
+		case Light::LightType::GE_LT_DIRECTIONAL:
+		{
+			if (pFragUBO)
+			{
+				pFragUBO->SetUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_DIR, glm::vec4(pLight->GetDirection(), 0.0f));
+				pFragUBO->SetUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_COLOR, glm::vec4(pLight->GetColor(), 1.0f));
+			}
+		}
+		break;
+		case Light::LightType::GE_LT_POINT:
+		{
+			if (pGeoNode->IsPassAllowed(VisualPass::PassType::GE_PT_SHADOWS))
+			{
+				if (pVertUBO)
+					pVertUBO->SetUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_PVM_MATRIX4, pLight->GetLightPVM());
+			}
+
+			if (pFragUBO)
+			{
+				pFragUBO->SetUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_POS, glm::vec4(pLight->GetPosition(), 1.0f));
+				pFragUBO->SetUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_COLOR, glm::vec4(pLight->GetColor(), 1.0f));
+			}
+		} break;
+		case Light::LightType::GE_LT_SPOT:
+			// the shaders have no spot lights
+			break;
+		case Light::LightType::GE_PT_COUNT:
+		default:
+			LOG_ERROR("Invalid light type!");
+		}
+	} break;
+	case VisualPass::PassType::GE_PT_SHADOWS:
+	{
+		auto* pUBO = pVisualPass->GetUniformBuffer(Shader::ShaderStage::GE_SS_VERTEX);
+
+		switch (pLight->GetLightType())
+		{
+		case Light::LightType::GE_LT_POINT:
+		{
+			if (pUBO)
+				pUBO->SetUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_PVM_MATRIX4, pLight->GetLightPVM());
+		} break;
+		case Light::LightType::GE_LT_DIRECTIONAL:
+#if defined(CASCADED_SHADOWS)
+			// the cascade matrices are updated each frame, see UpdateUniformBuffers()
+			break;
+#endif // CASCADED_SHADOWS
+		case Light::LightType::GE_LT_SPOT:
+			// the shaders have no spot lights
+			break;
+		case Light::LightType::GE_PT_COUNT:
+		default:
+			LOG_ERROR("Invalid light type!");
+		}
+	} break;
+	case VisualPass::PassType::GE_PT_GBUFFER:
+		// the G-buffer pass only writes the surface attributes, the lights are applied by DeferredLightingVisualEffect
+		break;
+	case VisualPass::PassType::GE_PT_COUNT:
+	default:
+		LOG_ERROR("Invalid visual pass type!");
+	}
+}
+
+void NullRenderer::DrawNodes(uint32_t currentBufferIdx)
+{
+	GE_PROFILE_FUNCTION();
+
+	for (auto& it : mPassMap)
+	{
+		auto& passType = it.first;
+		auto& passes = it.second;
+
+		mCommandStream.Record(CommandStream::CommandType::GE_CT_BEGIN_PASS, static_cast<uint32_t>(passType), static_cast<uint32_t>(passes.size()));
+
+		for (auto* pPass : passes)
+		{
+			if (pPass)
+			{
+				pPass->RenderNode(currentBufferIdx);
+			}
+		}
+
+		mCommandStream.Record(CommandStream::CommandType::GE_CT_END_PASS, static_cast<uint32_t>(passType));
+	}
+}
+
+void NullRenderer::UpdateNodes(Camera* pCamera, float32_t crrTime)
+{
+	GE_PROFILE_FUNCTION();
+
+	assert(pCamera != nullptr);
+
+	for (auto& it : mPassMap)
+	{
+		auto& passes = it.second;
+
+		for (auto* pPass : passes)
+		{
+			if (pPass)
+			{
+				pPass->UpdateNode(pCamera, crrTime);
+			}
+		}
+	}
+}
+
+void NullRenderer::DrawNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, uint32_t)
+{
+	assert(pVisualPass != nullptr);
+	assert(pGeoNode != nullptr);
+
+#if defined(SCENE_CULLING)
+	if (IsNodeCulled(pVisualPass, pGeoNode))
+		return;
+#endif // SCENE_CULLING
+
+#if defined(CASCADED_SHADOWS)
+	// the caster is out of all the cascades
+	//NOTE! The draws are recorded without their instances, the cascades of a caster are not recorded
+	uint32_t firstCascade = 0, cascadeCount = 0;
+	if (GetShadowCascadeRange(pVisualPass, pGeoNode, firstCascade, cascadeCount) && (0 == cascadeCount))
+		return;
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+	// the static caster is in the cache, none of its faces is dirty
+	//NOTE! The draw of a static caster stands for the draws to its dirty faces, the faces are not recorded
+	uint32_t faceMask = 0;
+	if (GetShadowCacheFaces(pVisualPass, pGeoNode, faceMask) && (0 == faceMask))
+		return;
+#endif // SHADOW_CACHING
+
+	//	UpdateDynamicStates(pVisualPass, currentBufferIdx);
+
+	// debug and full screen cases - the triangle is generated in the vertex shader
+	if (pVisualPass->GetIsDebug() || pVisualPass->GetIsFullScreen())
+	{
+		DrawDirect(3, 0);
+		return;
+	}
+
+	// draw geometric primitives
+	auto* pGeometry = pGeoNode->GetGeometry();
+	assert(pGeometry != nullptr);
+
+	// bind vertex buffer
+	auto* pVertexBuffer = pGeometry->GetVertexBuffer();
+	assert(pVertexBuffer != nullptr);
+
+	//// bind index buffer (if available)
+	bool isIndexedDrawing = pGeometry->IsIndexed();
+	auto* pIndexBuffer = pGeometry->GetIndexBuffer();
+	if (nullptr == pIndexBuffer)
+	{
+		isIndexedDrawing = false; // failsafe
+	}
+
+	uint32_t count = 0;
+	if (isIndexedDrawing)
+	{
+		if (pIndexBuffer)
+			count = pIndexBuffer->GetIndexCount();
+	}
+	else
+	{
+		count = pVertexBuffer->GetVertexCount();
+	}
+
+	if (isIndexedDrawing)
+	{
+		// in case of model loading
+		if (pGeometry->IsModel())
+		{
+			Model* pModel = dynamic_cast<Model*>(pGeometry);
+			if (pModel)
+			{
+				auto* gadrModel = Get(pModel);
+				assert(gadrModel != nullptr);
+
+				auto drawCB = [this, &pIndexBuffer](uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)
+					{
+						DrawDirect(indexCount, firstIndex, pIndexBuffer, vertexOffset);
+					};
+
+				// meshlet culling against the main camera, done in model space
+				// the other passes (shadows, mirrors) use other views, all their meshlets are drawn
+				if (mpCamera && pModel->HasMeshlets() && (pVisualPass->GetPassType() == VisualPass::PassType::GE_PT_STANDARD))
+				{
+					const glm::mat4 modelMatrix = pVisualPass->GetTransform() * pGeoNode->GetModelMatrix();
+					const Frustum frustum(mpCamera->GetProjectionViewMatrix() * modelMatrix);
+					const glm::vec3 cameraPosition(glm::inverse(modelMatrix) * glm::vec4(mpCamera->GetPosition(), 1.0f));
+
+					gadrModel->DrawVisible(frustum, cameraPosition, drawCB);
+				}
+				else
+				{
+					gadrModel->Draw(drawCB);
+				}
+			}
+		}
+		else
+		{
+			DrawDirect(count, 0, pIndexBuffer);
+		}
+	}
+	else
+	{
+		DrawDirect(count, 0);
+	}
+}
+
+void NullRenderer::UpdateNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, Camera* pCamera, float32_t crrTime)
+{
+	assert(pVisualPass != nullptr);
+	assert(pGeoNode != nullptr);
+	assert(pCamera != nullptr);
+
+	UpdateUniformBuffers(pVisualPass, pGeoNode, pCamera, crrTime);
+}
+
+void NullRenderer::DrawDirect(uint32_t count, uint32_t first, IndexBuffer* pIndexBuffer, int32_t vertexOffset)
+{
+	if (pIndexBuffer)
+	{
+		mCommandStream.Record(CommandStream::CommandType::GE_CT_DRAW_INDEXED, count, first, static_cast<uint32_t>(vertexOffset));
+	}
+	else
+	{
+		mCommandStream.Record(CommandStream::CommandType::GE_CT_DRAW, count, first);
+	}
+}
+
+void NullRenderer::AddVisualPass(VisualPass* pVisualPass)
+{
+	assert(pVisualPass != nullptr);
+
+	auto* pGeoNode = pVisualPass->GetNode();
+	assert(pGeoNode != nullptr);
+
+	if (pGeoNode->IsPassAllowed(pVisualPass->GetPassType()))
+	{
+		auto& passes = mPassMap[pVisualPass->GetPassType()];
+
+		bool_t foundNode = false;
+		for (auto* pPass : passes)
+		{
+			if (pPass && pPass->GetNode() == pGeoNode)
+			{
+				foundNode = true;
+				break;
+			}
+		}
+
+		if (false == foundNode)
+		{
+			passes.push_back(pVisualPass);
+		}
+	}
+}
+
+CommandStream& NullRenderer::GetCommandStream()
+{
+	return mCommandStream;
+}
+
+bool_t NullRenderer::OpenStreamFile(const std::string& filePath)
+{
+	if (mpStreamFile)
+	{
+		std::fclose(mpStreamFile);
+		mpStreamFile = nullptr;
+	}
+
+	mpStreamFile = std::fopen(filePath.c_str(), "wb");
+	if (nullptr == mpStreamFile)
+	{
+		LOG_ERROR("Failed to open the command stream file: %s", filePath.c_str());
+		return false;
+	}
+
+	if (false == CommandStream::WriteHeader(mpStreamFile))
+	{
+		LOG_ERROR("Failed to write the command stream file: %s", filePath.c_str());
+
+		std::fclose(mpStreamFile);
+		mpStreamFile = nullptr;
+
+		return false;
+	}
+
+	return true;
+}
+
+uint32_t NullRenderer::GetFrameIndex() const
+{
+	return mFrameIndex;
+}
+
+uint32_t NullRenderer::GenerateResourceId()
+{
+	return mResourceCount++;
+}
+#endif // NULL_RENDERER
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_NULL_RENDERER_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_NULL_RENDERER_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Common/NullObject.hpp"
+#include "Graphics/Rendering/Renderer.hpp"
+#include "Graphics/Rendering/CommandStream.hpp"
+#include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+
+namespace GraphicsEngine
+{
+	namespace Platform
+	{
+		class Window;
+	}
+
+	namespace Graphics
+	{
+		class Camera;
+
+		class IndexBuffer;
+
+		/*
+			Renderer without a graphics API. The resources are no-ops, the frame loop only records
+			what a GPU backend would do (binds, uniform updates and draws) into a command stream.
+			Used to test and benchmark the CPU side of the frame (culling, sorting, batching, uniform packing)
+			deterministically and without a GPU. The recorded frames can be written to a file and compared
+			with the FrameStreamDiff tool.
+		*/
+		class NullRenderer : public NullObject, public Renderer
+		{
+			GE_RTTI(GraphicsEngine::Graphics::NullRenderer)
+
+		public:
+			NullRenderer();
+			explicit NullRenderer(Platform::Window* pWindow, Renderer::RendererType type = Renderer::RendererType::GE_RT_FORWARD);
+			virtual ~NullRenderer();
+
+			virtual void RenderFrame(RenderQueue* pRenderQueue) override;
+			virtual void UpdateFrame(Camera* pCamera, float32_t crrTime) override;
+			virtual void SubmitFrame() override;
+
+			virtual void OnWindowResize(uint32_t width = 0, uint32_t height = 0) override;
+
+			/////////////////////////////////
+
+			virtual void ComputeGraphicsResources(RenderQueue* pRenderQueue) override;
+
+			virtual void BindLight(VisualPass* pVisualPass, const LightNode* pLightNode, GeometryNode* pGeoNode) override;
+
+			virtual void DrawNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, uint32_t currentBufferIdx) override;
+			virtual void UpdateNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, Camera* pCamera, float32_t crrTime) override;
+
+			// the commands of the current frame, complete after SubmitFrame()
+			CommandStream& GetCommandStream();
+
+			// each submitted frame is appended to filePath, the file is closed by Terminate()
+			bool_t OpenStreamFile(const std::string& filePath);
+
+			uint32_t GetFrameIndex() const;
+
+			// ids of the GAD resources, in creation order
+			uint32_t GenerateResourceId();
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(NullRenderer)
+
+			virtual void Init(Platform::Window* pWindow) override;
+			virtual void Terminate() override;
+
+			void Prepare();
+
+			void DrawNodes(uint32_t currentBufferIdx);
+			void UpdateNodes(Camera* pCamera, float32_t crrTime);
+
+			virtual void BeginFrame() override;
+			virtual void EndFrame() override;
+
+			void UpdateUniformBuffers(VisualPass* pVisualPass, GeometryNode* pGeoNode, Camera* pCamera, float32_t crrTime);
+
+			void DrawDirect(uint32_t count, uint32_t first, IndexBuffer* pIndexBuffer = nullptr, int32_t vertexOffset = 0);
+
+			void AddVisualPass(VisualPass* pVisualPass);
+
+			Platform::Window* mpWindow;
+
+			// map must be ordered as the passes must be processed in the pass type order
+			std::map<VisualPass::PassType, std::vector<VisualPass*>> mPassMap;
+
+			CommandStream mCommandStream;
+			std::FILE* mpStreamFile;
+
+			uint32_t mFrameIndex;
+			uint32_t mResourceCount;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif /* GRAPHICS_RENDERING_BACKENDS_NULL_NULL_RENDERER_HPP */
\ No newline at end of file
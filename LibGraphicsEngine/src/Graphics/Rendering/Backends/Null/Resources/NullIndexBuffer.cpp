@@ -0,0 +1,53 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullIndexBuffer.hpp"
+#include "Graphics/Rendering/Backends/Null/NullRenderer.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRIndexBuffer::GADRIndexBuffer()
+	: mpIndexBuffer(nullptr)
+{}
+
+GADRIndexBuffer::GADRIndexBuffer(Renderer* pRenderer, IndexBuffer* pIndexBuffer)
+	: GADRResource(pRenderer)
+	, mpIndexBuffer(pIndexBuffer)
+{
+	assert(mpIndexBuffer != nullptr);
+}
+
+GADRIndexBuffer::~GADRIndexBuffer()
+{
+	Destroy();
+}
+
+void GADRIndexBuffer::Destroy()
+{
+	if (mpIndexBuffer)
+	{
+		mpIndexBuffer = nullptr;
+	}
+}
+
+void GADRIndexBuffer::OnBind(uint32_t)
+{
+	assert(mpNullRenderer != nullptr);
+
+	mpNullRenderer->GetCommandStream().Record(CommandStream::CommandType::GE_CT_BIND_INDEX_BUFFER, mId);
+}
+
+const Buffer::BufferUsage& GADRIndexBuffer::GetBufferUsage() const
+{
+	assert(mpIndexBuffer != nullptr);
+
+	return mpIndexBuffer->GetBufferUsage();
+}
+
+const IndexBuffer::IndexType& GADRIndexBuffer::GetIndexType() const
+{
+	assert(mpIndexBuffer != nullptr);
+
+	return mpIndexBuffer->GetIndexType();
+}
+#endif // NULL_RENDERER
\ No newline at end of file
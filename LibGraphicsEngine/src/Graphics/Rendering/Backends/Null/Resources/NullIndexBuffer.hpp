@@ -0,0 +1,38 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_INDEX_BUFFER_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_INDEX_BUFFER_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+#include "Graphics/Rendering/Resources/IndexBuffer.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+
+		// Null implementation of the Graphics API Dependent Resource
+		class GADRIndexBuffer : public GADRResource
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRIndexBuffer)
+
+		public:
+			GADRIndexBuffer();
+			explicit GADRIndexBuffer(Renderer* pRenderer, IndexBuffer* pIndexBuffer);
+			virtual ~GADRIndexBuffer();
+
+			virtual void OnBind(uint32_t currentBufferIdx = 0) override;
+
+			const Buffer::BufferUsage& GetBufferUsage() const;
+			const IndexBuffer::IndexType& GetIndexType() const;
+
+		private:
+			void Destroy();
+
+			IndexBuffer* mpIndexBuffer;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_INDEX_BUFFER_HPP
\ No newline at end of file
@@ -0,0 +1,37 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullMaterial.hpp"
+#include "Graphics/Rendering/Resources/Material.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRMaterial::GADRMaterial()
+	: mpMaterial(nullptr)
+{}
+
+GADRMaterial::GADRMaterial(Renderer* pRenderer, Material* pMaterial)
+	: GADRResource(pRenderer)
+	, mpMaterial(pMaterial)
+{
+	assert(mpMaterial != nullptr);
+}
+
+GADRMaterial::~GADRMaterial()
+{
+	Destroy();
+}
+
+void GADRMaterial::Destroy()
+{
+	if (mpMaterial)
+	{
+		mpMaterial = nullptr;
+	}
+}
+
+void GADRMaterial::Bind(uint32_t)
+{
+	//
+}
+#endif // NULL_RENDERER
\ No newline at end of file
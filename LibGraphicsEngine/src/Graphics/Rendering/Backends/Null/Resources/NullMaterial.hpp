@@ -0,0 +1,36 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_MATERIAL_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_MATERIAL_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+		class Material;
+
+		// Null implementation of the Graphics API Dependent Resource
+		// INFO : basic default material
+		class GADRMaterial : public GADRResource
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRMaterial)
+
+		public:
+			GADRMaterial();
+			explicit GADRMaterial(Renderer* pRenderer, Material* pMaterial);
+			virtual ~GADRMaterial();
+
+			void Bind(uint32_t currentBufferIdx);
+
+		private:
+			void Destroy();
+
+			Material* mpMaterial;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_MATERIAL_HPP
\ No newline at end of file
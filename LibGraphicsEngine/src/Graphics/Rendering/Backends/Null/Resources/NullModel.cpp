@@ -0,0 +1,52 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullModel.hpp"
+#include "Graphics/Rendering/Resources/Model.hpp"
+#include <functional>
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRModel::GADRModel()
+	: mpModel(nullptr)
+{}
+
+GADRModel::GADRModel(Renderer* pRenderer, Model* pModel)
+	: GADRResource(pRenderer)
+	, mpModel(pModel)
+{
+	Create();
+}
+
+GADRModel::~GADRModel()
+{
+	Destroy();
+}
+
+void GADRModel::Create()
+{
+	assert(mpModel != nullptr);
+}
+
+void GADRModel::Destroy()
+{
+	if (mpModel)
+	{
+		mpModel = nullptr;
+	}
+}
+
+void GADRModel::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
+{
+	assert(mpModel != nullptr);
+
+	mpModel->Draw(onDrawCB);
+}
+
+void GADRModel::DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
+{
+	assert(mpModel != nullptr);
+
+	mpModel->DrawVisible(frustum, cameraPosition, onDrawCB);
+}
+#endif // NULL_RENDERER
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_MODEL_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_MODEL_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+#include "glm/vec3.hpp"
+#include <functional>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+		class Model;
+		class Frustum;
+
+		// Null implementation of the Graphics API Dependent Resource
+		// INFO : basic model
+		class GADRModel : public GADRResource
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRModel)
+
+		public:
+			GADRModel();
+			explicit GADRModel(Renderer* pRenderer, Model* pModel);
+			virtual ~GADRModel();
+
+			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+			void DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+
+
+		private:
+			void Create();
+			void Destroy();
+
+			Model* mpModel;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_MODEL_HPP
\ No newline at end of file
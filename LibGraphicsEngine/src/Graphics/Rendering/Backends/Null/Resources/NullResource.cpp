@@ -0,0 +1,34 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+#include "Graphics/Rendering/Backends/Null/NullRenderer.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRResource::GADRResource()
+	: mpNullRenderer(nullptr)
+	, mId(0)
+{}
+
+GADRResource::GADRResource(Renderer* pRenderer)
+	: GADRResource()
+{
+	assert(pRenderer != nullptr);
+
+	mpNullRenderer = dynamic_cast<NullRenderer*>(pRenderer);
+	assert(mpNullRenderer != nullptr);
+
+	mId = mpNullRenderer->GenerateResourceId();
+}
+
+GADRResource::~GADRResource()
+{
+	mpNullRenderer = nullptr;
+}
+
+uint32_t GADRResource::GetId() const
+{
+	return mId;
+}
+#endif // NULL_RENDERER
\ No newline at end of file
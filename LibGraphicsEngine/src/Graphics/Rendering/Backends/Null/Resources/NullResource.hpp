@@ -0,0 +1,41 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_RESOURCE_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_RESOURCE_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Common/NullObject.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+		class NullRenderer;
+
+		// Null implementation of the GADR Resource base class
+		// no GPU object, the resource only has an id used by the recorded command stream
+		class GADRResource : public NullObject
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRResource)
+
+		public:
+			GADRResource();
+			explicit GADRResource(Renderer* pRenderer);
+			virtual ~GADRResource();
+
+			virtual void OnBind(uint32_t = 0) {};
+			virtual void OnUnBind(uint32_t = 0) {};
+
+			uint32_t GetId() const;
+
+		protected:
+			NullRenderer* mpNullRenderer;
+
+			// given in creation order, stable between runs of the same scene
+			uint32_t mId;
+		};
+	}
+
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_RESOURCE_HPP
\ No newline at end of file
@@ -0,0 +1,36 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullShader.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRShader::GADRShader()
+	: mpShader(nullptr)
+{}
+
+GADRShader::GADRShader(Renderer* pRenderer, Shader* pShader)
+	: GADRResource(pRenderer)
+	, mpShader(pShader)
+{
+	assert(mpShader != nullptr);
+}
+
+GADRShader::~GADRShader()
+{
+	Destroy();
+}
+
+void GADRShader::Destroy()
+{
+	if (mpShader)
+	{
+		mpShader = nullptr;
+	}
+}
+
+Shader* GADRShader::GetShader() const
+{
+	return mpShader;
+}
+#endif // NULL_RENDERER
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_SHADER_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_SHADER_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+#include "Graphics/Rendering/Resources/Shader.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+
+		// Null implementation of the Graphics API Dependent Resource
+		class GADRShader : public GADRResource
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRShader)
+
+		public:
+			GADRShader();
+			explicit GADRShader(Renderer* pRenderer, Shader* pShader);
+			virtual ~GADRShader();
+
+			Shader* GetShader() const;
+
+		private:
+			void Destroy();
+
+			Shader* mpShader;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_SHADER_HPP
\ No newline at end of file
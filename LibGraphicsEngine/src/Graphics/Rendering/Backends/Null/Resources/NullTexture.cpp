@@ -0,0 +1,44 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullTexture.hpp"
+#include "Graphics/Rendering/Backends/Null/NullRenderer.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRTexture::GADRTexture()
+	: mpTexture(nullptr)
+{}
+
+GADRTexture::GADRTexture(Renderer* pRenderer, Texture* pTexture)
+	: GADRResource(pRenderer)
+	, mpTexture(pTexture)
+{
+	assert(mpTexture != nullptr);
+}
+
+GADRTexture::~GADRTexture()
+{
+	Destroy();
+}
+
+void GADRTexture::Destroy()
+{
+	if (mpTexture)
+	{
+		mpTexture = nullptr;
+	}
+}
+
+void GADRTexture::Bind(Shader::ShaderStage shaderStage, uint32_t slot)
+{
+	assert(mpNullRenderer != nullptr);
+
+	mpNullRenderer->GetCommandStream().Record(CommandStream::CommandType::GE_CT_BIND_TEXTURE, mId, static_cast<uint32_t>(shaderStage), slot);
+}
+
+Texture* GADRTexture::GetTexture()
+{
+	return mpTexture;
+}
+#endif // NULL_RENDERER
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_TEXTURE_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_TEXTURE_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+#include "Graphics/Rendering/Resources/Texture.hpp"
+#include "Graphics/Rendering/Resources/Shader.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+
+		// Null implementation of the Graphics API Dependent Resource
+		class GADRTexture : public GADRResource
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRTexture)
+
+		public:
+			GADRTexture();
+			explicit GADRTexture(Renderer* pRenderer, Texture* pTexture);
+			virtual ~GADRTexture();
+
+			void Bind(Shader::ShaderStage shaderStage, uint32_t slot);
+
+			Texture* GetTexture();
+
+		private:
+			void Destroy();
+
+			Texture* mpTexture;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_TEXTURE_HPP
\ No newline at end of file
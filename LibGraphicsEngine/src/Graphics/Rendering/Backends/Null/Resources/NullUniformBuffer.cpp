@@ -0,0 +1,53 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullUniformBuffer.hpp"
+#include "Graphics/Rendering/Backends/Null/NullRenderer.hpp"
+#include "Graphics/Rendering/Resources/UniformBuffer.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRUniformBuffer::GADRUniformBuffer()
+	: mpUniformBuffer(nullptr)
+{}
+
+GADRUniformBuffer::GADRUniformBuffer(Renderer* pRenderer, UniformBuffer* pUniformBuffer)
+	: GADRResource(pRenderer)
+	, mpUniformBuffer(pUniformBuffer)
+{
+	assert(mpUniformBuffer != nullptr);
+}
+
+GADRUniformBuffer::~GADRUniformBuffer()
+{
+	Destroy();
+}
+
+void GADRUniformBuffer::Destroy()
+{
+	if (mpUniformBuffer)
+	{
+		mpUniformBuffer = nullptr;
+	}
+}
+
+void GADRUniformBuffer::UpdateData()
+{
+	assert(mpNullRenderer != nullptr);
+	assert(mpUniformBuffer != nullptr);
+
+	mpNullRenderer->GetCommandStream().RecordData(CommandStream::CommandType::GE_CT_UPDATE_UNIFORM_BUFFER, mId, mpUniformBuffer->GetData(), mpUniformBuffer->GetSize());
+}
+
+void GADRUniformBuffer::Bind(uint32_t binding)
+{
+	assert(mpNullRenderer != nullptr);
+
+	mpNullRenderer->GetCommandStream().Record(CommandStream::CommandType::GE_CT_BIND_UNIFORM_BUFFER, mId, binding);
+}
+
+void GADRUniformBuffer::OnBind(uint32_t)
+{
+	UpdateData();
+}
+#endif // NULL_RENDERER
\ No newline at end of file
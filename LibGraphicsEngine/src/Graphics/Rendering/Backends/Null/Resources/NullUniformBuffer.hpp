@@ -0,0 +1,40 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_UNIFORM_BUFFER_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_UNIFORM_BUFFER_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+		class UniformBuffer;
+
+		// Null implementation of the Graphics API Dependent Resource
+		class GADRUniformBuffer : public GADRResource
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRUniformBuffer)
+
+		public:
+			GADRUniformBuffer();
+			explicit GADRUniformBuffer(Renderer* pRenderer, UniformBuffer* pUniformBuffer);
+			virtual ~GADRUniformBuffer();
+
+			// records the current content of the uniform buffer
+			void UpdateData();
+
+			void Bind(uint32_t binding);
+
+			virtual void OnBind(uint32_t currentBufferIdx = 0) override;
+
+		private:
+			void Destroy();
+
+			UniformBuffer* mpUniformBuffer;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_UNIFORM_BUFFER_HPP
\ No newline at end of file
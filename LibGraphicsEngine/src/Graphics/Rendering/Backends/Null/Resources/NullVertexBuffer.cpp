@@ -0,0 +1,46 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullVertexBuffer.hpp"
+#include "Graphics/Rendering/Backends/Null/NullRenderer.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRVertexBuffer::GADRVertexBuffer()
+	: mpVertexBuffer(nullptr)
+{}
+
+GADRVertexBuffer::GADRVertexBuffer(Renderer* pRenderer, VertexBuffer* pVertexBuffer)
+	: GADRResource(pRenderer)
+	, mpVertexBuffer(pVertexBuffer)
+{
+	assert(mpVertexBuffer != nullptr);
+}
+
+GADRVertexBuffer::~GADRVertexBuffer()
+{
+	Destroy();
+}
+
+void GADRVertexBuffer::Destroy()
+{
+	if (mpVertexBuffer)
+	{
+		mpVertexBuffer = nullptr;
+	}
+}
+
+void GADRVertexBuffer::OnBind(uint32_t)
+{
+	assert(mpNullRenderer != nullptr);
+
+	mpNullRenderer->GetCommandStream().Record(CommandStream::CommandType::GE_CT_BIND_VERTEX_BUFFER, mId);
+}
+
+const Buffer::BufferUsage& GADRVertexBuffer::GetBufferUsage() const
+{
+	assert(mpVertexBuffer != nullptr);
+
+	return mpVertexBuffer->GetBufferUsage();
+}
+#endif // NULL_RENDERER
\ No newline at end of file
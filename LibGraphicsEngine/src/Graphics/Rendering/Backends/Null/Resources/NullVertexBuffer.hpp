@@ -0,0 +1,37 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_VERTEX_BUFFER_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_VERTEX_BUFFER_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+#include "Graphics/Rendering/Resources/VertexBuffer.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+
+		// Null implementation of the Graphics API Dependent Resource
+		class GADRVertexBuffer : public GADRResource
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRVertexBuffer)
+
+		public:
+			GADRVertexBuffer();
+			explicit GADRVertexBuffer(Renderer* pRenderer, VertexBuffer* pVertexBuffer);
+			virtual ~GADRVertexBuffer();
+
+			virtual void OnBind(uint32_t currentBufferIdx = 0) override;
+
+			const Buffer::BufferUsage& GetBufferUsage() const;
+
+		private:
+			void Destroy();
+
+			VertexBuffer* mpVertexBuffer;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_VERTEX_BUFFER_HPP
\ No newline at end of file
@@ -0,0 +1,38 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullVertexFormat.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADRVertexFormat::GADRVertexFormat()
+	: mpVertexFormat(nullptr)
+{}
+
+GADRVertexFormat::GADRVertexFormat(Renderer* pRenderer, VertexFormat* pVertexFormat)
+	: GADRResource(pRenderer)
+	, mpVertexFormat(pVertexFormat)
+{
+	assert(mpVertexFormat != nullptr);
+}
+
+GADRVertexFormat::~GADRVertexFormat()
+{
+	Destroy();
+}
+
+void GADRVertexFormat::Destroy()
+{
+	if (mpVertexFormat)
+	{
+		mpVertexFormat = nullptr;
+	}
+}
+
+const VertexFormat::VertexInputRate& GADRVertexFormat::GetVertexInputRate() const
+{
+	assert(mpVertexFormat != nullptr);
+
+	return mpVertexFormat->GetVertexInputRate();
+}
+#endif // NULL_RENDERER
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_VERTEX_FORMAT_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_VERTEX_FORMAT_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Resources/NullResource.hpp"
+#include "Graphics/Rendering/Resources/VertexFormat.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+
+		// Null implementation of the Graphics API Dependent Resource
+		class GADRVertexFormat : public GADRResource
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADRVertexFormat)
+
+		public:
+			GADRVertexFormat();
+			explicit GADRVertexFormat(Renderer* pRenderer, VertexFormat* pVertexFormat);
+			virtual ~GADRVertexFormat();
+
+			const VertexFormat::VertexInputRate& GetVertexInputRate() const;
+
+		private:
+			void Destroy();
+
+			VertexFormat* mpVertexFormat;
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_RESOURCES_NULL_VERTEX_FORMAT_HPP
\ No newline at end of file
@@ -0,0 +1,198 @@
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/VisualPasses/NullVisualPass.hpp"
+#include "Graphics/Rendering/Backends/Null/NullRenderer.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullVertexFormat.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullVertexBuffer.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullIndexBuffer.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullShader.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullTexture.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullUniformBuffer.hpp"
+#include "Graphics/Rendering/Resources/UniformBuffer.hpp"
+#include "Graphics/SceneGraph/GeometryNode.hpp"
+#include "Graphics/ShaderTools/GLSL/GLSLShaderParser.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GADVisualPass::GADVisualPass()
+	: mpNullRenderer(nullptr)
+	, mpVisualPass(nullptr)
+	, mId(0)
+{}
+
+GADVisualPass::GADVisualPass(Renderer* pRenderer, VisualPass* pVisualPass)
+	: GADVisualPass()
+{
+	Init(pRenderer, pVisualPass);
+}
+
+GADVisualPass::~GADVisualPass()
+{
+	mpNullRenderer = nullptr;
+	mpVisualPass = nullptr;
+}
+
+void GADVisualPass::Init(Renderer* pRenderer, VisualPass* pVisualPass)
+{
+	assert(pRenderer != nullptr);
+	assert(pVisualPass != nullptr);
+
+	mpNullRenderer = dynamic_cast<NullRenderer*>(pRenderer);
+	assert(mpNullRenderer != nullptr);
+
+	mpVisualPass = pVisualPass;
+
+	mId = mpNullRenderer->GenerateResourceId();
+
+	SetupPipeline();
+}
+
+void GADVisualPass::SetupPipeline()
+{
+	assert(mpNullRenderer != nullptr);
+	assert(mpVisualPass != nullptr);
+
+	// creates the resources used by the pass upfront, as the other backends do,
+	// so their ids don't depend on the order the nodes are rendered in
+
+	// shader stages in a fixed order
+	for (uint8_t stage = 0; stage < static_cast<uint8_t>(Shader::ShaderStage::GE_SS_COUNT); ++stage)
+	{
+		auto* pShader = mpVisualPass->GetShader(static_cast<Shader::ShaderStage>(stage));
+		if (pShader)
+		{
+			mpNullRenderer->Get(pShader);
+		}
+	}
+
+	if ((false == mpVisualPass->GetIsDebug()) && (false == mpVisualPass->GetIsFullScreen()))
+	{
+		auto* pGeoNode = mpVisualPass->GetNode();
+		assert(pGeoNode != nullptr);
+
+		auto* pGeometry = pGeoNode->GetGeometry();
+		assert(pGeometry != nullptr);
+
+		auto* pVertexFormat = pGeometry->GetVertexFormat();
+		assert(pVertexFormat != nullptr);
+
+		mpNullRenderer->Get(pVertexFormat);
+
+		auto* pVertexBuffer = pGeometry->GetVertexBuffer();
+		assert(pVertexBuffer != nullptr);
+
+		mpNullRenderer->Get(pVertexBuffer);
+
+		auto* pIndexBuffer = pGeometry->GetIndexBuffer();
+		if (pGeometry->IsIndexed() && pIndexBuffer)
+		{
+			mpNullRenderer->Get(pIndexBuffer);
+		}
+	}
+}
+
+void GADVisualPass::BindUniforms()
+{
+	assert(mpNullRenderer != nullptr);
+	assert(mpVisualPass != nullptr);
+
+	uint32_t textureSlot = 0;
+
+	// shader stages in a fixed order, the maps are unordered
+	for (uint8_t stage = 0; stage < static_cast<uint8_t>(Shader::ShaderStage::GE_SS_COUNT); ++stage)
+	{
+		const auto shaderStage = static_cast<Shader::ShaderStage>(stage);
+
+		auto* pShader = mpVisualPass->GetShader(shaderStage);
+		if (nullptr == pShader)
+			continue;
+
+		auto* pGlslParser = pShader->GetGLSLParser();
+		assert(pGlslParser != nullptr);
+
+		auto* pUniformBuffer = mpVisualPass->GetUniformBuffer(shaderStage);
+		if (pUniformBuffer && pGlslParser->GetUniformBlock().IsValid())
+		{
+			auto* pGADRUniformBuffer = mpNullRenderer->Get(pUniformBuffer);
+			assert(pGADRUniformBuffer != nullptr);
+
+			pGADRUniformBuffer->Bind(static_cast<uint32_t>(pGlslParser->GetUniformBlock().binding));
+		}
+
+		if (mpVisualPass->HasTextures())
+		{
+			auto& textureMap = mpVisualPass->GetTextures();
+			auto it = textureMap.find(shaderStage);
+			if (it != textureMap.end())
+			{
+				// NOTE! The render target textures are bound as the other textures
+				for (auto* pTexture : it->second)
+				{
+					assert(pTexture != nullptr);
+
+					auto* pGADRTexture = mpNullRenderer->Get(pTexture);
+					assert(pGADRTexture != nullptr);
+
+					pGADRTexture->Bind(shaderStage, textureSlot++);
+				}
+			}
+		}
+	}
+}
+
+void GADVisualPass::BindGeometry(uint32_t currentBufferIdx)
+{
+	assert(mpNullRenderer != nullptr);
+	assert(mpVisualPass != nullptr);
+
+	// debug and full screen cases - the vertices are generated in the shader
+	if (mpVisualPass->GetIsDebug() || mpVisualPass->GetIsFullScreen())
+		return;
+
+	auto* pGeoNode = mpVisualPass->GetNode();
+	assert(pGeoNode != nullptr);
+
+	auto* pGeometry = pGeoNode->GetGeometry();
+	assert(pGeometry != nullptr);
+
+	auto* pVertexBuffer = pGeometry->GetVertexBuffer();
+	assert(pVertexBuffer != nullptr);
+
+	mpNullRenderer->Bind(pVertexBuffer, currentBufferIdx);
+
+	auto* pIndexBuffer = pGeometry->GetIndexBuffer();
+	if (pGeometry->IsIndexed() && pIndexBuffer)
+	{
+		mpNullRenderer->Bind(pIndexBuffer, currentBufferIdx);
+	}
+}
+
+void GADVisualPass::RenderNode(uint32_t currentBufferIdx)
+{
+	assert(mpVisualPass != nullptr);
+	assert(mpNullRenderer != nullptr);
+
+	auto* pGeoNode = mpVisualPass->GetNode();
+	assert(pGeoNode != nullptr);
+
+	mpNullRenderer->GetCommandStream().Record(CommandStream::CommandType::GE_CT_BIND_PIPELINE, mId, static_cast<uint32_t>(mpVisualPass->GetPassType()));
+
+	BindUniforms();
+
+	BindGeometry(currentBufferIdx);
+
+	mpNullRenderer->DrawNode(mpVisualPass, pGeoNode, currentBufferIdx);
+}
+
+void GADVisualPass::UpdateNode(Camera* pCamera, float32_t crrTime)
+{
+	assert(mpVisualPass != nullptr);
+	assert(mpNullRenderer != nullptr);
+
+	auto* pGeoNode = mpVisualPass->GetNode();
+	assert(pGeoNode != nullptr);
+
+	mpNullRenderer->UpdateNode(mpVisualPass, pGeoNode, pCamera, crrTime);
+}
+#endif // NULL_RENDERER
\ No newline at end of file
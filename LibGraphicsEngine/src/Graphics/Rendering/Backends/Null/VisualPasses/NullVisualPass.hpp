@@ -0,0 +1,54 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_NULL_VISUAL_PASSES_NULL_VISUAL_PASS_HPP
+#define GRAPHICS_RENDERING_BACKENDS_NULL_VISUAL_PASSES_NULL_VISUAL_PASS_HPP
+
+#if defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/Common/NullObject.hpp"
+#include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Renderer;
+		class Camera;
+
+		class NullRenderer;
+
+		/* Base class for Graphics API Dependent Visual Pass
+			The pipeline is only an id, rendering a node records its binds and draws
+		*/
+		class GADVisualPass : public VisualPass, public NullObject
+		{
+			GE_RTTI(GraphicsEngine::Graphics::GADVisualPass)
+
+		public:
+			GADVisualPass();
+			GADVisualPass(Renderer* pRenderer, VisualPass* pVisualPass);
+			~GADVisualPass();
+
+			virtual void RenderNode(uint32_t currentBufferIdx) override;
+			virtual void UpdateNode(Camera* pCamera, float32_t crrTime) override;
+
+		protected:
+			void Init(Renderer* pRenderer, VisualPass* pVisualPass);
+
+			void SetupPipeline();
+
+			void BindUniforms();
+			void BindGeometry(uint32_t currentBufferIdx);
+
+			NullRenderer* mpNullRenderer;
+
+			VisualPass* mpVisualPass;
+
+			uint32_t mId;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(GADVisualPass)
+
+		};
+	}
+}
+#endif // NULL_RENDERER
+
+#endif // GRAPHICS_RENDERING_BACKENDS_NULL_VISUAL_PASSES_NULL_VISUAL_PASS_HPP
\ No newline at end of file
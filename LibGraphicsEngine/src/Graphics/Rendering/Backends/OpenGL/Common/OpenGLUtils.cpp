@@ -7,6 +7,41 @@ namespace GraphicsEngine
 	{
 		namespace OpenGLUtils
 		{
+			GLenum VertexAttributeTypeToOpenGLType(const VertexFormat::AttributeType& type)
+			{
+				GLenum glType = 0;
+
+				switch (type)
+				{
+				case VertexFormat::AttributeType::GE_AT_FLOAT32:
+					glType = GL_FLOAT;
+					break;
+				case VertexFormat::AttributeType::GE_AT_FLOAT16:
+					glType = GL_HALF_FLOAT;
+					break;
+				case VertexFormat::AttributeType::GE_AT_SNORM16:
+				case VertexFormat::AttributeType::GE_AT_OCTAHEDRAL_SNORM16:
+					glType = GL_SHORT;
+					break;
+				case VertexFormat::AttributeType::GE_AT_SNORM8:
+					glType = GL_BYTE;
+					break;
+				case VertexFormat::AttributeType::GE_AT_UNORM8:
+					glType = GL_UNSIGNED_BYTE;
+					break;
+				case VertexFormat::AttributeType::GE_AT_COUNT:
+				default:
+					LOG_ERROR("Invalid vertex attribute type!");
+				}
+
+				return glType;
+			}
+
+			GLboolean IsVertexAttributeTypeNormalized(const VertexFormat::AttributeType& type)
+			{
+				return ((type == VertexFormat::AttributeType::GE_AT_FLOAT32) || (type == VertexFormat::AttributeType::GE_AT_FLOAT16)) ? GL_FALSE : GL_TRUE;
+			}
+
 			GLenum IndexTypeToOpenGLIndexType(const IndexBuffer::IndexType& indexType)
 			{
 				GLenum glIndexType = 0;
@@ -231,6 +266,7 @@ namespace GraphicsEngine
 					glTexFormat = GL_RGB;
 					break;
 				case Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM:
+				case Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT:
 					glTexFormat = GL_RGBA;
 					break;
 				case Texture::TextureFormat::GE_TF_D32_S8:
@@ -261,6 +297,9 @@ namespace GraphicsEngine
 				case Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM:
 					glTexSizedFormat = GL_RGBA8;
 					break;
+				case Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT:
+					glTexSizedFormat = GL_RGBA16F;
+					break;
 				case Texture::TextureFormat::GE_TF_D32_S8:
 					glTexSizedFormat = GL_DEPTH32F_STENCIL8;
 					break;
@@ -289,6 +328,9 @@ namespace GraphicsEngine
 				case Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM:
 					glTexDataType = GL_UNSIGNED_BYTE;
 					break;
+				case Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT:
+					glTexDataType = GL_FLOAT;
+					break;
 				case Texture::TextureFormat::GE_TF_D32_S8:
 					glTexDataType = GL_FLOAT;
 					break;
@@ -24,6 +24,10 @@ namespace GraphicsEngine
 	{
 		namespace OpenGLUtils
 		{
+			// vertex format
+			GLenum VertexAttributeTypeToOpenGLType(const VertexFormat::AttributeType& type);
+			GLboolean IsVertexAttributeTypeNormalized(const VertexFormat::AttributeType& type);
+
 			// index type
 			GLenum IndexTypeToOpenGLIndexType(const IndexBuffer::IndexType& indexType);
 			uint32_t IndexTypeToSizeofBytes(const IndexBuffer::IndexType& indexType);
@@ -38,6 +38,13 @@ void OpenGLFrameBuffer::Add2DTextureAttachment(GLenum attachment, GLuint texture
 	glNamedFramebufferTexture(mHandle, attachment, textureHandle, 0);
 }
 
+void OpenGLFrameBuffer::SetDrawBuffers(const std::vector<GLenum>& attachments)
+{
+	assert(attachments.empty() == false);
+
+	glNamedFramebufferDrawBuffers(mHandle, static_cast<GLsizei>(attachments.size()), attachments.data());
+}
+
 void OpenGLFrameBuffer::AddRenderBufferAttachment(GLenum attachment, GLuint renderBufferHandle)
 {
 	glNamedFramebufferRenderbuffer(mHandle, attachment, GL_RENDERBUFFER, renderBufferHandle);
@@ -28,6 +28,9 @@ namespace GraphicsEngine
 			void Add2DTextureAttachment(GLenum attachment, GLuint textureHandle);
 			void AddRenderBufferAttachment(GLenum attachment, GLuint renderBufferHandle);
 
+			// color attachments written by the fragment shader outputs, in output location order
+			void SetDrawBuffers(const std::vector<GLenum>& attachments);
+
 			void CheckCompleteness();
 
 			void Bind();
@@ -65,7 +65,7 @@ namespace GraphicsEngine
 				for (short i = 0; i < numExtensions; ++i)
 				{
 					const char_t* extension = (const char_t*)glGetStringi(GL_EXTENSIONS, i);
-					LOG_INFO(extension);
+					LOG_INFO("%s", extension);
 				}
 				LOG_INFO("");
 			}
@@ -81,9 +81,13 @@ void OpenGLShaderObject::Destroy()
 	}
 }
 
-bool_t OpenGLShaderObject::Compile()
+bool_t OpenGLShaderObject::Compile(uint32_t constantCount, const GLuint* pConstantIds, const GLuint* pConstantValues)
 {
 #ifdef LOAD_SHADER_SOURCE
+	(void)constantCount;
+	(void)pConstantIds;
+	(void)pConstantValues;
+
 	glCompileShader(mHandle);
 #else
 	// NOTE! In case of useing OpenGL binary SPIR-V specialized shaders
@@ -94,7 +98,7 @@ bool_t OpenGLShaderObject::Compile()
 		return true;
 
 	// Specialization is equivalent to compilation.
-	glSpecializeShader(mHandle, SHADER_ENTRY_POINT, 0, nullptr, nullptr);
+	glSpecializeShader(mHandle, SHADER_ENTRY_POINT, constantCount, pConstantIds, pConstantValues);
 #endif // LOAD_SHADER_SOURCE
 
 	GLint isCompiled = 0;
@@ -25,7 +25,8 @@ namespace GraphicsEngine
 			explicit OpenGLShaderObject(GLenum type, const std::string& sourcePath);
 			virtual ~OpenGLShaderObject();
 
-			bool_t Compile();
+			// the specialization constants are only used by the SPIR-V binaries
+			bool_t Compile(uint32_t constantCount = 0, const GLuint* pConstantIds = nullptr, const GLuint* pConstantValues = nullptr);
 
 			const GLuint& GetHandle() const;
 			const GLenum& GetType() const;
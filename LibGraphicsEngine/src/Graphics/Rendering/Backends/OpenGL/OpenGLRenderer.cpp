@@ -5,6 +5,7 @@
 
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
 #include "Foundation/Logger.hpp"
+#include "Foundation/Profiler.hpp"
 
 #include "Graphics/Rendering/RenderQueue.hpp"
 
@@ -13,6 +14,7 @@
 #include "Graphics/SceneGraph/LightNode.hpp"
 #include "Graphics/Lights/DirectionalLight.hpp"
 #include "Graphics/Cameras/Camera.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
 
 #include "Graphics/Components/VisualComponent.hpp"
 #include "Graphics/Components/MaterialComponent.hpp"
@@ -37,6 +39,7 @@
 // Common
 #include "Graphics/Rendering/Backends/OpenGL/Common/OpenGLCommon.hpp"
 #include "Graphics/Rendering/Backends/OpenGL/Common/OpenGLUtils.hpp"
+#include "glm/matrix.hpp" // glm::inverse()
 
 // Resources
 #include "Graphics/Rendering/Backends/OpenGL/Resources/OpenGLVertexFormat.hpp"
@@ -59,12 +62,14 @@ OpenGLRenderer::OpenGLRenderer()
 	: Renderer()
 	, mpWindow(nullptr)
 	, mCurrentBufferIdx(0)
+	, mTimestampFrameIdx(0)
 {}
 
-OpenGLRenderer::OpenGLRenderer(Platform::Window* pWindow)
-	: Renderer(pWindow)
+OpenGLRenderer::OpenGLRenderer(Platform::Window* pWindow, Renderer::RendererType type)
+	: Renderer(pWindow, type)
 	, mpWindow(pWindow)
 	, mCurrentBufferIdx(0)
+	, mTimestampFrameIdx(0)
 
 {
 	Init(pWindow);
@@ -108,6 +113,15 @@ void OpenGLRenderer::Terminate()
 	mPipelineStatsMap.clear();
 #endif
 
+	for (auto& frame : mTimestampFrames)
+	{
+		if (false == frame.queryIds.empty())
+		{
+			glDeleteQueries(static_cast<GLsizei>(frame.queryIds.size()), frame.queryIds.data());
+			frame.queryIds.clear();
+		}
+	}
+
 	for (auto& it : mVisualPassMap)
 	{
 		auto& rpBuff = it.second;
@@ -162,6 +176,8 @@ void OpenGLRenderer::OnWindowResize(uint32_t width, uint32_t height)
 
 void OpenGLRenderer::RenderFrame(RenderQueue* pRenderQueue)
 {
+	GE_PROFILE_FUNCTION();
+
 	if (false == mIsPrepared)
 		return;
 
@@ -176,6 +192,8 @@ void OpenGLRenderer::RenderFrame(RenderQueue* pRenderQueue)
 
 void OpenGLRenderer::UpdateFrame(Camera* pCamera, float32_t crrTime)
 {
+	GE_PROFILE_FUNCTION();
+
 	if (false == mIsPrepared)
 		return;
 
@@ -184,6 +202,17 @@ void OpenGLRenderer::UpdateFrame(Camera* pCamera, float32_t crrTime)
 	assert(pCamera != nullptr);
 	mpCamera = pCamera;
 
+	// the transient data of the previous frames is released here
+	mFrameAllocator.BeginFrame();
+
+#if defined(SCENE_CULLING)
+	UpdateSceneCulling(pCamera);
+#endif // SCENE_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+	UpdateLODs(pCamera);
+#endif // LEVEL_OF_DETAIL
+
 	UpdateNodes(pCamera, crrTime);
 }
 
@@ -199,6 +228,8 @@ void OpenGLRenderer::EndFrame()
 
 void OpenGLRenderer::SubmitFrame()
 {
+	GE_PROFILE_FUNCTION();
+
 	if (false == mIsPrepared)
 		return;
 
@@ -211,6 +242,8 @@ void OpenGLRenderer::SubmitFrame()
 
 void OpenGLRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
 {
+	GE_PROFILE_FUNCTION();
+
 	if (false == mIsPrepared)
 		return;
 
@@ -218,6 +251,27 @@ void OpenGLRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
 
 	mpRenderQueue = pRenderQueue;
 
+#if defined(DEFERRED_RENDERING)
+	// the lighting passes come first in the standard pass, they write the depth the forward nodes are tested against
+	if (GetRendererType() == RendererType::GE_RT_DEFERRED)
+	{
+		CreateLightingEffects();
+
+		for (auto* pEffect : mLightingEffects)
+		{
+			for (auto& it : pEffect->GetPasses())
+			{
+				for (auto* pPass : it.second)
+				{
+					AddVisualPass(pPass);
+				}
+			}
+
+			pEffect->InitPasses(this);
+		}
+	}
+#endif // DEFERRED_RENDERING
+
 	// TODO - compute resources for all renderable types
 	auto& renderableList = mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OPAQUE);
 
@@ -236,7 +290,7 @@ void OpenGLRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
 
 			// we didn't call this earlier as we needed to have
 			// the node info first
-			pVisEffect->Init();
+			pVisEffect->Init(this);
 
 			// TODO - Compute mVisualPasses list of passes in their proper order
 			const auto& passMap = pVisEffect->GetPasses();
@@ -253,6 +307,14 @@ void OpenGLRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
 		}
 	);
 
+#if defined(SCENE_CULLING)
+	BuildSceneTree();
+#endif // SCENE_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+	CollectLODNodes();
+#endif // LEVEL_OF_DETAIL
+
 	SetupPipelineStats();
 }
 
@@ -267,7 +329,7 @@ void OpenGLRenderer::UpdateUniformBuffers(VisualPass* pVisualPass, GeometryNode*
 	assert(pGeoNode != nullptr);
 	assert(pCamera != nullptr);
 
-	auto shaders = pVisualPass->GetShaders();
+	const auto& shaders = pVisualPass->GetShaders();
 	for (auto iter = shaders.begin(); iter != shaders.end(); ++iter)
 	{
 		auto shaderStage = iter->first;
@@ -305,6 +367,10 @@ void OpenGLRenderer::UpdateUniformBuffers(VisualPass* pVisualPass, GeometryNode*
 				{
 					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_NORMAL_MATRIX4, pVisualPass->GetTransform() * pGeoNode->GetNormalMatrix());
 				} break;
+				case GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4:
+				{
+					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4, glm::inverse(pCamera->GetProjectionViewMatrix()));
+				} break;
 				case GLSLShaderTypes::UniformType::GE_UT_CAMERA_POS:
 				{
 					pUniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_CAMERA_POS, glm::vec4(pCamera->GetPosition(), 0.0f));
@@ -405,6 +471,12 @@ void OpenGLRenderer::BindLight(VisualPass* pVisualPass, const LightNode* pLightN
 			LOG_ERROR("Invalid light type!");
 		}
 	} break;
+	case VisualPass::PassType::GE_PT_GBUFFER:
+		// the G-buffer pass only writes the surface attributes, the lights are applied by DeferredLightingVisualEffect
+		break;
+	case VisualPass::PassType::GE_PT_COUNT:
+	default:
+		LOG_ERROR("Invalid visual pass type!");
 	}
 }
 
@@ -414,11 +486,25 @@ void OpenGLRenderer::DrawSceneToBackBuffer()
 
 	// THE ACTUAL RENDERING IS DONE HERE !!!!
 
+	// results of the frame that used the same queries
+	ReadTimestampQueries();
+	SetupTimestampQueries();
+
+	mTimestampFrames[mTimestampFrameIdx].submitTime = Profiler::GetTime();
+	WriteTimestamp(GPUTimings::FRAME_BEGIN_QUERY);
+
 	DrawNodes(0);
+
+	WriteTimestamp(GPUTimings::FRAME_END_QUERY);
+
+	mTimestampFrameIdx = (mTimestampFrameIdx + 1) % TIMESTAMP_FRAME_COUNT;
 }
 
 void OpenGLRenderer::DrawNodes(uint32_t currentBufferIdx)
 {
+	GE_PROFILE_FUNCTION();
+
+	uint32_t passIndex = 0;
 	for (auto& it : mVisualPassMap)
 	{
 		auto& passType = it.first;
@@ -428,6 +514,8 @@ void OpenGLRenderer::DrawNodes(uint32_t currentBufferIdx)
 		BeginQuery(passType, currentBufferIdx);
 		//
 
+		WriteTimestamp(GPUTimings::GetPassBeginQuery(passIndex));
+
 		BeginRenderPass(passData, currentBufferIdx);
 
 		for (auto* pPass : passData.passes)
@@ -440,6 +528,9 @@ void OpenGLRenderer::DrawNodes(uint32_t currentBufferIdx)
 
 		EndRenderPass(passData, currentBufferIdx);
 
+		WriteTimestamp(GPUTimings::GetPassEndQuery(passIndex));
+		passIndex++;
+
 		//
 		EndQuery(passType, currentBufferIdx);
 		//
@@ -449,6 +540,8 @@ void OpenGLRenderer::DrawNodes(uint32_t currentBufferIdx)
 
 void OpenGLRenderer::UpdateNodes(Camera* pCamera, float32_t crrTime)
 {
+	GE_PROFILE_FUNCTION();
+
 	assert(pCamera != nullptr);
 
 	for (auto& it : mVisualPassMap)
@@ -473,10 +566,15 @@ void OpenGLRenderer::DrawNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, u
 	assert(pVisualPass != nullptr);
 	assert(pGeoNode != nullptr);
 
+#if defined(SCENE_CULLING)
+	if (IsNodeCulled(pVisualPass, pGeoNode))
+		return;
+#endif // SCENE_CULLING
+
 	//	UpdateDynamicStates(pVisualPass, currentBufferIdx);
 
-		// debug case
-	if (pVisualPass->GetIsDebug())
+	// debug and full screen cases - the triangle is generated in the vertex shader
+	if (pVisualPass->GetIsDebug() || pVisualPass->GetIsFullScreen())
 	{
 		DrawDirect(3, 0);
 		return;
@@ -525,14 +623,34 @@ void OpenGLRenderer::DrawNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, u
 				auto* gadrModel = Get(pModel);
 				assert(gadrModel != nullptr);
 
-				gadrModel->Draw([this, &pIndexBuffer](uint32_t indexCount, uint32_t firstIndex)
+				auto drawCB = [this, &pIndexBuffer](uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)
 					{
-						DrawDirect(indexCount, firstIndex, pIndexBuffer);
-					});
+						DrawDirect(indexCount, firstIndex, pIndexBuffer, vertexOffset);
+					};
+
+				// meshlet culling against the main camera, done in model space
+				// the other passes (shadows, mirrors) use other views, all their meshlets are drawn
+				if (mpCamera && pModel->HasMeshlets() && (pVisualPass->GetPassType() == VisualPass::PassType::GE_PT_STANDARD))
+				{
+					const glm::mat4 modelMatrix = pVisualPass->GetTransform() * pGeoNode->GetModelMatrix();
+					const Frustum frustum(mpCamera->GetProjectionViewMatrix() * modelMatrix);
+					const glm::vec3 cameraPosition(glm::inverse(modelMatrix) * glm::vec4(mpCamera->GetPosition(), 1.0f));
+
+					gadrModel->DrawVisible(frustum, cameraPosition, drawCB);
+				}
+				else
+				{
+					gadrModel->Draw(drawCB);
+				}
 			}
 		}
 		else
 		{
+#if defined(LEVEL_OF_DETAIL)
+			// the VAO keeps the index buffer bound at setup, the LOD nodes switch it between frames
+			Bind(pIndexBuffer, currentBufferIdx);
+#endif // LEVEL_OF_DETAIL
+
 			DrawDirect(count, 0, pIndexBuffer);
 		}
 	}
@@ -553,14 +671,21 @@ void OpenGLRenderer::UpdateNode(VisualPass* pVisualPass, GeometryNode* pGeoNode,
 	//TODO - other stuff to update
 }
 
-void OpenGLRenderer::DrawDirect(uint32_t count, uint32_t first, IndexBuffer* pIndexBuffer)
+void OpenGLRenderer::DrawDirect(uint32_t count, uint32_t first, IndexBuffer* pIndexBuffer, int32_t vertexOffset)
 {
 	if (pIndexBuffer)
 	{
 		GLenum glIndexType = OpenGLUtils::IndexTypeToOpenGLIndexType(pIndexBuffer->GetIndexType());
 		uint32_t sizeofBytes = OpenGLUtils::IndexTypeToSizeofBytes(pIndexBuffer->GetIndexType());
 
-		glDrawElements(GL_TRIANGLES, count, glIndexType, (void*)(first * sizeofBytes));
+		if (vertexOffset != 0)
+		{
+			glDrawElementsBaseVertex(GL_TRIANGLES, count, glIndexType, (void*)(first * sizeofBytes), vertexOffset);
+		}
+		else
+		{
+			glDrawElements(GL_TRIANGLES, count, glIndexType, (void*)(first * sizeofBytes));
+		}
 	}
 	else
 	{
@@ -576,7 +701,8 @@ void OpenGLRenderer::DrawDirect(uint32_t count, uint32_t first, IndexBuffer* pIn
 void OpenGLRenderer::BeginRenderPass(const VisualPassData& visualPassData, uint32_t currentBufferIdx)
 {
 	auto passType = visualPassData.passes[0]->GetPassType();
-	if ((passType == VisualPass::PassType::GE_PT_OFFSCREEN || passType == VisualPass::PassType::GE_PT_SHADOWS) &&
+	if ((passType == VisualPass::PassType::GE_PT_OFFSCREEN || passType == VisualPass::PassType::GE_PT_SHADOWS ||
+		passType == VisualPass::PassType::GE_PT_GBUFFER) &&
 		visualPassData.pFrameBuffer)
 	{
 		visualPassData.pFrameBuffer->Bind();
@@ -621,7 +747,8 @@ void OpenGLRenderer::BeginRenderPass(const VisualPassData& visualPassData, uint3
 void OpenGLRenderer::EndRenderPass(const VisualPassData& visualPassData, uint32_t currentBufferIdx)
 {
 	auto passType = visualPassData.passes[0]->GetPassType();
-	if ((passType == VisualPass::PassType::GE_PT_OFFSCREEN || passType == VisualPass::PassType::GE_PT_SHADOWS) &&
+	if ((passType == VisualPass::PassType::GE_PT_OFFSCREEN || passType == VisualPass::PassType::GE_PT_SHADOWS ||
+		passType == VisualPass::PassType::GE_PT_GBUFFER) &&
 		visualPassData.pFrameBuffer)
 	{
 		visualPassData.pFrameBuffer->UnBind();
@@ -726,6 +853,45 @@ void OpenGLRenderer::SetupFrameBuffers(VisualPass* pVisualPass, OpenGLFrameBuffe
 
 		pFrameBufferOut->CheckCompleteness();
 	} break;
+	case VisualPass::PassType::GE_PT_GBUFFER:
+	{
+		auto& renderTargets = pVisualPass->GetRenderTargets();
+
+		assert(renderTargets.size() == 4);
+
+		auto* pAlbedoRT = Get(pVisualPass->GetRenderTarget(RenderTarget::TargetType::GE_TT_COLOR));
+		assert(pAlbedoRT != nullptr);
+		auto* pNormalRT = Get(pVisualPass->GetRenderTarget(RenderTarget::TargetType::GE_TT_COLOR_1));
+		assert(pNormalRT != nullptr);
+		auto* pMaterialRT = Get(pVisualPass->GetRenderTarget(RenderTarget::TargetType::GE_TT_COLOR_2));
+		assert(pMaterialRT != nullptr);
+		auto* pDepthRT = Get(pVisualPass->GetRenderTarget(RenderTarget::TargetType::GE_TT_DEPTH));
+		assert(pDepthRT != nullptr);
+
+		// get RT width and height for the framebuffer size
+		const auto& extent3D = pAlbedoRT->GetGLTextureObject()->GetData().extent;
+
+		assert(extent3D.width > 0);
+		assert(extent3D.height > 0);
+
+		visualPassBeginDataOut.width = extent3D.width;
+		visualPassBeginDataOut.height = extent3D.height;
+		visualPassBeginDataOut.depth = 1.0f;
+		visualPassBeginDataOut.stencil = 0;
+
+		pFrameBufferOut = GE_ALLOC(OpenGLFrameBuffer);
+		assert(pFrameBufferOut != nullptr);
+
+		pFrameBufferOut->Add2DTextureAttachment(GL_COLOR_ATTACHMENT0, pAlbedoRT->GetGLTextureObject()->GetHandle());
+		pFrameBufferOut->Add2DTextureAttachment(GL_COLOR_ATTACHMENT1, pNormalRT->GetGLTextureObject()->GetHandle());
+		pFrameBufferOut->Add2DTextureAttachment(GL_COLOR_ATTACHMENT2, pMaterialRT->GetGLTextureObject()->GetHandle());
+		pFrameBufferOut->Add2DTextureAttachment(GL_DEPTH_ATTACHMENT, pDepthRT->GetGLTextureObject()->GetHandle());
+
+		// the fragment shader outputs 0, 1, 2
+		pFrameBufferOut->SetDrawBuffers({ GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 });
+
+		pFrameBufferOut->CheckCompleteness();
+	} break;
 	case VisualPass::PassType::GE_PT_COUNT:
 	default:
 		LOG_ERROR("Invalid visual pass type!");
@@ -852,7 +1018,8 @@ void OpenGLRenderer::GetQueryResults()
 		auto& passType = it.first;
 		auto& queryData = it.second;
 
-		std::string passTypeStr = (passType == VisualPass::PassType::GE_PT_SHADOWS ? "SHADOW" : (passType == VisualPass::PassType::GE_PT_OFFSCREEN ? "OFFSCREEN" : "STANDARD"));
+		std::string passTypeStr = (passType == VisualPass::PassType::GE_PT_SHADOWS ? "SHADOW" : (passType == VisualPass::PassType::GE_PT_OFFSCREEN ? "OFFSCREEN" :
+			(passType == VisualPass::PassType::GE_PT_GBUFFER ? "GBUFFER" : "STANDARD")));
 		LOG_INFO("//////////////// Render pass: %s ///////////////////////", passTypeStr.c_str());
 
 		for (size_t idx = 0; idx < queryData.queryIds.size(); ++ idx)
@@ -883,6 +1050,68 @@ void OpenGLRenderer::GetQueryResults()
 #endif
 }
 
+void OpenGLRenderer::SetupTimestampQueries()
+{
+	mTimestampPassTypes.clear();
+	for (auto& it : mVisualPassMap)
+	{
+		mTimestampPassTypes.push_back(it.first);
+	}
+
+	const uint32_t queryCount = GPUTimings::GetQueryCount(static_cast<uint32_t>(mTimestampPassTypes.size()));
+
+	auto& frame = mTimestampFrames[mTimestampFrameIdx];
+	if (frame.queryIds.size() != queryCount)
+	{
+		if (false == frame.queryIds.empty())
+		{
+			glDeleteQueries(static_cast<GLsizei>(frame.queryIds.size()), frame.queryIds.data());
+		}
+
+		frame.queryIds.resize(queryCount);
+		glCreateQueries(GL_TIMESTAMP, static_cast<GLsizei>(queryCount), frame.queryIds.data());
+
+		frame.submitTime = 0;
+	}
+}
+
+void OpenGLRenderer::WriteTimestamp(uint32_t query)
+{
+	auto& frame = mTimestampFrames[mTimestampFrameIdx];
+	assert(query < frame.queryIds.size());
+
+	glQueryCounter(frame.queryIds[query], GL_TIMESTAMP);
+}
+
+void OpenGLRenderer::ReadTimestampQueries()
+{
+	auto& frame = mTimestampFrames[mTimestampFrameIdx];
+	if ((0 == frame.submitTime) || (frame.queryIds.size() != GPUTimings::GetQueryCount(static_cast<uint32_t>(mTimestampPassTypes.size()))))
+		return;
+
+	const uint64_t submitTime = frame.submitTime;
+	frame.submitTime = 0;
+
+	// the last query of the frame is written last, so if it is available all the others are as well
+	// NOTE! Never wait, if the GPU is that far behind the frame is simply not measured
+	GLint isAvailable = 0;
+	glGetQueryObjectiv(frame.queryIds[GPUTimings::FRAME_END_QUERY], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+	if (isAvailable == 0)
+		return;
+
+	// GL timestamps are already in ns
+	mTimestamps.resize(frame.queryIds.size());
+	for (size_t i = 0; i < frame.queryIds.size(); ++i)
+	{
+		GLuint64 timestamp = 0;
+		glGetQueryObjectui64v(frame.queryIds[i], GL_QUERY_RESULT, &timestamp);
+
+		mTimestamps[i] = timestamp;
+	}
+
+	mGPUTimings.Update(mTimestamps, mTimestampPassTypes, submitTime);
+}
+
 void OpenGLRenderer::ResetQuery(VisualPass::PassType passType, uint32_t currentBufferIdx)
 {
 #ifdef PIPELINE_STATS
@@ -31,7 +31,7 @@ namespace GraphicsEngine
 
 		public:
 			OpenGLRenderer();
-			explicit OpenGLRenderer(Platform::Window* pWindow);
+			explicit OpenGLRenderer(Platform::Window* pWindow, Renderer::RendererType type = Renderer::RendererType::GE_RT_FORWARD);
 			virtual ~OpenGLRenderer();
 
 			virtual void RenderFrame(RenderQueue* pRenderQueue) override;
@@ -90,6 +90,10 @@ namespace GraphicsEngine
 			void BeginQuery(VisualPass::PassType passType, uint32_t currentBufferIdx);
 			void EndQuery(VisualPass::PassType passType, uint32_t currentBufferIdx);
 
+			void SetupTimestampQueries();
+			void WriteTimestamp(uint32_t query);
+			void ReadTimestampQueries();
+
 			void DrawSceneToBackBuffer();
 			void DrawNodes(uint32_t currentBufferIdx);
 
@@ -103,7 +107,7 @@ namespace GraphicsEngine
 
 			void UpdateUniformBuffers(VisualPass* pVisualPass, GeometryNode* pGeoNode, Camera* pCamera, float32_t crrTime);
 
-			void DrawDirect(uint32_t count, uint32_t first, IndexBuffer* pIndexBuffer = nullptr);
+			void DrawDirect(uint32_t count, uint32_t first, IndexBuffer* pIndexBuffer = nullptr, int32_t vertexOffset = 0);
 		//	void DrawIndirect(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t currentBufferIdx, bool_t isIndexedDrawing = false);
 
 
@@ -134,6 +138,24 @@ namespace GraphicsEngine
 
 			std::map<VisualPass::PassType, PipelineStatsData> mPipelineStatsMap;
 
+			// GPU timestamps, the queries of a frame are read back TIMESTAMP_FRAME_COUNT frames later
+			static const uint32_t TIMESTAMP_FRAME_COUNT = 3;
+
+			struct TimestampFrameData
+			{
+				TimestampFrameData()
+					: submitTime(0)
+				{}
+
+				std::vector<GLuint> queryIds;
+				uint64_t submitTime; // 0 if no results are pending
+			};
+
+			TimestampFrameData mTimestampFrames[TIMESTAMP_FRAME_COUNT];
+			uint32_t mTimestampFrameIdx;
+			std::vector<VisualPass::PassType> mTimestampPassTypes;
+			std::vector<uint64_t> mTimestamps;
+
 			//////////////////////////////////////////
 		};
 	}
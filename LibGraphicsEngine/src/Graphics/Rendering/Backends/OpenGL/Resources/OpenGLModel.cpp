@@ -35,10 +35,17 @@ void GADRModel::Destroy()
 	}
 }
 
-void GADRModel::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB)
+void GADRModel::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
 {
 	assert(mpModel != nullptr);
 
 	mpModel->Draw(onDrawCB);
 }
+
+void GADRModel::DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
+{
+	assert(mpModel != nullptr);
+
+	mpModel->DrawVisible(frustum, cameraPosition, onDrawCB);
+}
 #endif // OPENGL_RENDERER
\ No newline at end of file
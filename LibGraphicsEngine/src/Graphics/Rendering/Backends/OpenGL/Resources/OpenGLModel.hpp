@@ -3,6 +3,7 @@
 
 #if defined(OPENGL_RENDERER)
 #include "Graphics/Rendering/Backends/OpenGL/Resources/OpenGLResource.hpp"
+#include "glm/vec3.hpp"
 #include <functional>
 
 namespace GraphicsEngine
@@ -11,6 +12,7 @@ namespace GraphicsEngine
 	{
 		class Renderer;
 		class Model;
+		class Frustum;
 
 		// OpenGL implementation of the Graphics API Dependent Resource
 		// INFO : basic model
@@ -23,7 +25,8 @@ namespace GraphicsEngine
 			explicit GADRModel(Renderer* pRenderer, Model* pModel);
 			virtual ~GADRModel();
 
-			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB);
+			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+			void DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
 
 
 		private:
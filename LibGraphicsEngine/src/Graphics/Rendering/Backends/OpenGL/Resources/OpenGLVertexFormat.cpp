@@ -1,5 +1,6 @@
 #if defined(OPENGL_RENDERER)
 #include "Graphics/Rendering/Backends/OpenGL/Resources/OpenGLVertexFormat.hpp"
+#include "Graphics/Rendering/Backends/OpenGL/Common/OpenGLUtils.hpp"
 #include <cassert>
 
 
@@ -35,10 +36,11 @@ void GADRVertexFormat::Create()
 	{
 		GADRVertexFormat::VertexAttributeDescription attributeDesc{};
 		attributeDesc.location = 0; // NOTE! Has to be updated later based on vertex shader input data~
-		attributeDesc.type = GL_FLOAT;
+		attributeDesc.type = OpenGLUtils::VertexAttributeTypeToOpenGLType(mpVertexFormat->GetVertexAttributeType(iter->first));
+		attributeDesc.normalized = OpenGLUtils::IsVertexAttributeTypeNormalized(mpVertexFormat->GetVertexAttributeType(iter->first));
 		attributeDesc.stride = mpVertexFormat->GetVertexTotalStride();
 		attributeDesc.offset = mpVertexFormat->GetVertexAttributeOffset(iter->first);
-		attributeDesc.size = iter->second;
+		attributeDesc.size = mpVertexFormat->GetVertexAttributeStoredComponentCount(iter->first);
 
 		mInputAttributeMap[iter->first] = attributeDesc;
 	}
@@ -23,6 +23,7 @@ namespace GraphicsEngine
 				GLuint location;
 				GLint size; // 1, 2, 3, 4
 				GLenum type;
+				GLboolean normalized;
 				GLsizei stride;
 				GLsizei offset;
 			} VertexAttributeDescription;
@@ -130,50 +130,85 @@ void GADVisualPass::SetupShaderStage()
 	assert(mpVisualPass != nullptr);
 	assert(mpOpenGLShaderProgram != nullptr);
 
+	// the octahedral normals are decoded by the vertex shader, see GLSLShaderTypes::Constants::CONSTANT_ID_OCTAHEDRAL_NORMALS
+	bool_t hasOctahedralNormals = false;
+	auto* pGeoNode = mpVisualPass->GetNode();
+	if (pGeoNode && (false == mpVisualPass->GetIsDebug()) && (false == mpVisualPass->GetIsFullScreen()))
+	{
+		auto* pGeometry = pGeoNode->GetGeometry();
+		assert(pGeometry != nullptr);
+
+		auto* pVertexFormat = pGeometry->GetVertexFormat();
+		assert(pVertexFormat != nullptr);
+
+		hasOctahedralNormals = (pVertexFormat->GetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_NORMAL) ==
+			VertexFormat::AttributeType::GE_AT_OCTAHEDRAL_SNORM16);
+	}
+
+	// NOTE! A shader object is specialized once and is shared by the passes,
+	// so the specialized vertex shader is a pass owned shader object, freed after linking
+	OpenGLShaderObject* pSpecializedShader = nullptr;
+
 	// setup Shaders
 	const auto& shaders = mpVisualPass->GetShaders();
 
-	size_t i = 0;
+	std::vector<GLuint> attachedShaderHandles;
+	bool_t isCompiled = true;
 	for (auto iter = shaders.begin(); iter != shaders.end(); ++iter)
 	{
 		auto shaderStage = iter->first;
 		auto* pShader = iter->second;
 		assert(pShader != nullptr);
 
-		auto GADRShader = mpOpenGLRenderer->Get(pShader);
-		assert(GADRShader != nullptr);
+		OpenGLShaderObject* pGLShader = nullptr;
+		bool_t res = false;
+		if (hasOctahedralNormals && (shaderStage == Shader::ShaderStage::GE_SS_VERTEX))
+		{
+			pSpecializedShader = GE_ALLOC(OpenGLShaderObject)(GL_VERTEX_SHADER, pShader->GetSourcePath());
+			assert(pSpecializedShader != nullptr);
 
-		auto refGLShader = GADRShader->GetGLShaderObject();
-		assert(refGLShader != nullptr);
+			const GLuint constantId = GLSLShaderTypes::Constants::CONSTANT_ID_OCTAHEDRAL_NORMALS;
+			const GLuint constantValue = GL_TRUE;
 
-		if (refGLShader->Compile())
-		{
-			mpOpenGLShaderProgram->AttachShader(refGLShader->GetHandle());
+			pGLShader = pSpecializedShader;
+			res = pGLShader->Compile(1, &constantId, &constantValue);
 		}
 		else
+		{
+			auto GADRShader = mpOpenGLRenderer->Get(pShader);
+			assert(GADRShader != nullptr);
+
+			pGLShader = GADRShader->GetGLShaderObject();
+			assert(pGLShader != nullptr);
+
+			res = pGLShader->Compile();
+		}
+
+		if (false == res)
 		{
 			LOG_ERROR("Shader %s failed compilation! Abort!", pShader->GetSourcePath().c_str());
-			return;
+			isCompiled = false;
+			break;
 		}
+
+		mpOpenGLShaderProgram->AttachShader(pGLShader->GetHandle());
+		attachedShaderHandles.push_back(pGLShader->GetHandle());
 	}
 
-	if (mpOpenGLShaderProgram->Link())
+	if (isCompiled && mpOpenGLShaderProgram->Link())
 	{
 		// cleanup
-		for (auto iter = shaders.begin(); iter != shaders.end(); ++iter)
+		for (auto handle : attachedShaderHandles)
 		{
-			auto* pShader = iter->second;
-			assert(pShader != nullptr);
-
-			auto GADRShader = mpOpenGLRenderer->Get(pShader);
-			assert(GADRShader != nullptr);
-
-			auto refGLShader = GADRShader->GetGLShaderObject();
-			assert(refGLShader != nullptr);
-
-			mpOpenGLShaderProgram->DetachShader(refGLShader->GetHandle());
+			mpOpenGLShaderProgram->DetachShader(handle);
 		}
 	}
+
+	// the linked program keeps the code, the detached shader object is deleted
+	if (pSpecializedShader)
+	{
+		GE_FREE(pSpecializedShader);
+	}
 }
 
 void GADVisualPass::SetupVertexInputState()
@@ -190,6 +225,10 @@ void GADVisualPass::SetupVertexInputState()
 	//	//
 	//}
 
+	// the vertices are generated in the vertex shader, the VAO stays empty
+	if (mpVisualPass->GetIsFullScreen())
+		return;
+
 	auto* pGeoNode = mpVisualPass->GetNode();
 	assert(pGeoNode != nullptr);
 
@@ -234,7 +273,7 @@ void GADVisualPass::SetupVertexInputState()
 		auto refInput = shaderAttIter->second.pInput;
 
 		//TODO - see if to use VertexData struct with all attributes packed or separately
-		glVertexAttribPointer(refInput->location, refAtt.size, refAtt.type, GL_FALSE, refAtt.stride, (void*)refAtt.offset);
+		glVertexAttribPointer(refInput->location, refAtt.size, refAtt.type, refAtt.normalized, refAtt.stride, (void*)refAtt.offset);
 		glEnableVertexAttribArray(refInput->location);
 	}
 
@@ -293,7 +332,7 @@ void GADVisualPass::SetupRasterizationState()
 
 	GLenum glCullMode = OpenGLUtils::FaceCullModeToOpenGLFaceCullMode(mpVisualPass->GetCullFaceState().GetCullMode());
 
-	if (mpVisualPass->GetIsDebug())
+	if (mpVisualPass->GetIsDebug() || mpVisualPass->GetIsFullScreen())
 	{
 		glCullMode = GL_NONE;
 	}
@@ -473,7 +512,8 @@ void GADVisualPass::BindUniforms()
 		// texture sampler(s) are present
 		if (pGlslParser->GetUniforms().empty() == false && mpVisualPass->HasTextures())
 		{
-			auto& uniforms = pGlslParser->GetUniforms();
+			// NOTE! The textures are added to the pass in the binding order of the samplers
+			auto uniforms = pGlslParser->GetUniformsByBinding();
 
 			auto& textureMap = mpVisualPass->GetTextures();
 			auto it = textureMap.find(pShader->GetShaderStage());
@@ -497,7 +537,7 @@ void GADVisualPass::BindUniforms()
 
 						gadrTexture->Bind(texUnit);
 
-						GLint loc = glGetUniformLocation(mpOpenGLShaderProgram->GetHandle(), unifIter->first.c_str());
+						GLint loc = glGetUniformLocation(mpOpenGLShaderProgram->GetHandle(), (*unifIter)->first.c_str());
 						glUniform1i(loc, texUnit);
 					}
 					else if (pTexture->GetUsageType() == Texture::UsageType::GE_UT_RENDER_TARGET)
@@ -505,47 +545,15 @@ void GADVisualPass::BindUniforms()
 						auto* pVisualEffect = mpVisualPass->GetVisualEffect();
 						assert(pVisualEffect != nullptr);
 
-						const auto& passMap = pVisualEffect->GetPasses();
-
-						bool_t foundRT = false;
-						VisualEffect::PassMap::const_iterator cPassIt;
-						VisualPass::RenderTargetMap::const_iterator cRTIt;
-						for (cPassIt = passMap.begin(); cPassIt != passMap.end(); ++cPassIt)
+						auto* pRT = pVisualEffect->FindRenderTarget(pTexture);
+						if (pRT)
 						{
-							auto& passVector = cPassIt->second;
-							for (auto* pPass : passVector)
-							{
-								if (pPass)
-								{
-									const auto& renderTargets = pPass->GetRenderTargets();
-									for (cRTIt = renderTargets.begin(); cRTIt != renderTargets.end(); ++cRTIt)
-									{
-										auto* pRT = cRTIt->second;
-										assert(pRT != nullptr);
-
-										if (pRT->GetTexture() == pTexture)
-										{
-											foundRT = true;
-											break;
-										}
-									}
-								}
-							}
-
-							if (foundRT)
-								break;
-						}
-
-						if (foundRT)
-						{
-							auto* pRT = cRTIt->second;
-
 							auto* gadrTexture = mpOpenGLRenderer->Get(pRT);
 							assert(gadrTexture != nullptr);
 
 							gadrTexture->Bind(texUnit);
 
-							GLint loc = glGetUniformLocation(mpOpenGLShaderProgram->GetHandle(), unifIter->first.c_str());
+							GLint loc = glGetUniformLocation(mpOpenGLShaderProgram->GetHandle(), (*unifIter)->first.c_str());
 							glUniform1i(loc, texUnit);
 						}
 					}
@@ -13,24 +13,46 @@ namespace GraphicsEngine
 			constexpr const uint8_t FORMAT_THREE_DIM = 3;
 			constexpr const uint8_t FORMAT_FOUR_DIM = 4;
 
-			VkFormat VertexFormatToVulkanVertexFormat(const VertexFormat::VertexAttribute& attribute, uint8_t dimension)
+			VkFormat VertexFormatToVulkanVertexFormat(const VertexFormat::VertexAttribute& attribute, uint8_t dimension, const VertexFormat::AttributeType& type)
 			{
 				VkFormat format = VkFormat::VK_FORMAT_MAX_ENUM;
 
-				//TODO - for now all attributes are of type float 32 !!!
-				switch (dimension)
+				// NOTE! dimension is the stored component count, 3 component quantized attributes are already padded to 4
+				switch (type)
+				{
+				case VertexFormat::AttributeType::GE_AT_FLOAT32:
 				{
-				case FORMAT_TWO_DIM:
-					format = VkFormat::VK_FORMAT_R32G32_SFLOAT;
+					switch (dimension)
+					{
+					case FORMAT_TWO_DIM:
+						format = VkFormat::VK_FORMAT_R32G32_SFLOAT;
+						break;
+					case FORMAT_THREE_DIM:
+						format = VkFormat::VK_FORMAT_R32G32B32_SFLOAT;
+						break;
+					case FORMAT_FOUR_DIM:
+						format = VkFormat::VK_FORMAT_R32G32B32A32_SFLOAT;
+						break;
+					default:
+						LOG_ERROR("Invalid attribute dimension!");
+					}
+				} break;
+				case VertexFormat::AttributeType::GE_AT_FLOAT16:
+					format = ((dimension == FORMAT_TWO_DIM) ? VkFormat::VK_FORMAT_R16G16_SFLOAT : VkFormat::VK_FORMAT_R16G16B16A16_SFLOAT);
 					break;
-				case FORMAT_THREE_DIM:
-					format = VkFormat::VK_FORMAT_R32G32B32_SFLOAT;
+				case VertexFormat::AttributeType::GE_AT_SNORM16:
+				case VertexFormat::AttributeType::GE_AT_OCTAHEDRAL_SNORM16:
+					format = ((dimension == FORMAT_TWO_DIM) ? VkFormat::VK_FORMAT_R16G16_SNORM : VkFormat::VK_FORMAT_R16G16B16A16_SNORM);
 					break;
-				case FORMAT_FOUR_DIM:
-					format = VkFormat::VK_FORMAT_R32G32B32A32_SFLOAT;
+				case VertexFormat::AttributeType::GE_AT_SNORM8:
+					format = ((dimension == FORMAT_TWO_DIM) ? VkFormat::VK_FORMAT_R8G8_SNORM : VkFormat::VK_FORMAT_R8G8B8A8_SNORM);
 					break;
+				case VertexFormat::AttributeType::GE_AT_UNORM8:
+					format = ((dimension == FORMAT_TWO_DIM) ? VkFormat::VK_FORMAT_R8G8_UNORM : VkFormat::VK_FORMAT_R8G8B8A8_UNORM);
+					break;
+				case VertexFormat::AttributeType::GE_AT_COUNT:
 				default:
-					LOG_ERROR("Invalid attribute dimension!");
+					LOG_ERROR("Invalid attribute type!");
 				}
 
 				switch (attribute)
@@ -250,6 +272,9 @@ namespace GraphicsEngine
 				case Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM:
 					vulkanFormat = VkFormat::VK_FORMAT_R8G8B8A8_UNORM;
 					break;
+				case Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT:
+					vulkanFormat = VkFormat::VK_FORMAT_R16G16B16A16_SFLOAT;
+					break;
 				case Texture::TextureFormat::GE_TF_D32_S8:
 					vulkanFormat = VkFormat::VK_FORMAT_D32_SFLOAT_S8_UINT;
 					break;
@@ -278,6 +303,9 @@ namespace GraphicsEngine
 				case VkFormat::VK_FORMAT_R8G8B8A8_UNORM:
 					textureFormat = Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM;
 					break;
+				case VkFormat::VK_FORMAT_R16G16B16A16_SFLOAT:
+					textureFormat = Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT;
+					break;
 				case VkFormat::VK_FORMAT_D32_SFLOAT_S8_UINT:
 					textureFormat = Texture::TextureFormat::GE_TF_D32_S8;
 					break;
@@ -739,6 +767,61 @@ namespace GraphicsEngine
 
 				return vulkanDynamicState;
 			}
+
+			void RenderGraphStateToVulkanState(RenderGraph::ResourceState state, bool_t isDepth,
+				VkImageLayout& layoutOut, VkAccessFlags& accessMaskOut, VkPipelineStageFlags& stageMaskOut)
+			{
+				switch (state)
+				{
+				case RenderGraph::ResourceState::GE_RS_UNDEFINED:
+					layoutOut = VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+					accessMaskOut = 0;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+					break;
+				case RenderGraph::ResourceState::GE_RS_COLOR_ATTACHMENT:
+					layoutOut = VkImageLayout::VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					accessMaskOut = VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+					break;
+				case RenderGraph::ResourceState::GE_RS_DEPTH_ATTACHMENT:
+					layoutOut = VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+					accessMaskOut = VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+					break;
+				case RenderGraph::ResourceState::GE_RS_DEPTH_READ:
+					layoutOut = VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+					accessMaskOut = VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+					break;
+				case RenderGraph::ResourceState::GE_RS_SHADER_READ:
+					// the depth textures are sampled in the read only depth layout
+					layoutOut = (isDepth ? VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VkImageLayout::VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+					accessMaskOut = VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+					break;
+				case RenderGraph::ResourceState::GE_RS_TRANSFER_SRC:
+					layoutOut = VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					accessMaskOut = VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT;
+					break;
+				case RenderGraph::ResourceState::GE_RS_TRANSFER_DST:
+					layoutOut = VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					accessMaskOut = VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT;
+					break;
+				case RenderGraph::ResourceState::GE_RS_PRESENT:
+					layoutOut = VkImageLayout::VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+					accessMaskOut = 0;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+					break;
+				default:
+					LOG_ERROR("Invalid render graph resource state!");
+					layoutOut = VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;
+					accessMaskOut = 0;
+					stageMaskOut = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+					break;
+				}
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include "Graphics/Rendering/PipelineStates/DepthStencilState.hpp"
 #include "Graphics/Rendering/PipelineStates/ColorBlendState.hpp"
 #include "Graphics/Rendering/PipelineStates/DynamicState.hpp"
+#include "Graphics/Rendering/RenderGraph.hpp"
 
 namespace GraphicsEngine
 {
@@ -23,7 +24,7 @@ namespace GraphicsEngine
 		namespace VulkanUtils
 		{
 			// vertex format
-			VkFormat VertexFormatToVulkanVertexFormat(const VertexFormat::VertexAttribute& attribute, uint8_t dimension);
+			VkFormat VertexFormatToVulkanVertexFormat(const VertexFormat::VertexAttribute& attribute, uint8_t dimension, const VertexFormat::AttributeType& type = VertexFormat::AttributeType::GE_AT_FLOAT32);
 
 			// vertex input rate
 			VkVertexInputRate VertexInputRateToVulkanVertexInputRate(const VertexFormat::VertexInputRate& vertexInputRate);
@@ -66,6 +67,10 @@ namespace GraphicsEngine
 			VkBlendOp BlendOpToVulkanBlendOp(ColorBlendState::BlendOp blendOp);
 
 			VkDynamicState DynamicStateToVulkanDynamicState(DynamicState::State state);
+
+			// render graph
+			void RenderGraphStateToVulkanState(RenderGraph::ResourceState state, bool_t isDepth,
+				VkImageLayout& layoutOut, VkAccessFlags& accessMaskOut, VkPipelineStageFlags& stageMaskOut);
 		}
 	}
 }
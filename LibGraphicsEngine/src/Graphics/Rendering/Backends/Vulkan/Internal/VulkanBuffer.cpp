@@ -4,10 +4,13 @@
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanQueue.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanCommandPool.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanCommandBuffer.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanFence.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanSubmission.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanPassThroughAllocator.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanInitializers.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanHelpers.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Common/VulkanUtils.hpp"
+#include <cstring> // memcpy()
 
 using namespace GraphicsEngine;
 using namespace GraphicsEngine::Graphics;
@@ -162,7 +165,53 @@ void VulkanBuffer::CopyTo(VulkanBuffer* pDestBuffer, VulkanQueue* pQueue, VkBuff
 
 	vkCmdCopyBuffer(copyCommandBuffer.GetHandle(), mHandle, pDestBuffer->GetHandle(), 1, &bufferCopy);
 
-	copyCommandBuffer.Flush(pQueue);
+	VulkanQueue* pGraphicsQueue = mpDevice->GetGraphicsQueue();
+	assert(pGraphicsQueue != nullptr);
+
+	if (pQueue->GetFamilyIndex() == pGraphicsQueue->GetFamilyIndex())
+	{
+		copyCommandBuffer.Flush(pQueue);
+		return;
+	}
+
+	// the copies outside the graphics family are uploads on the transfer queue
+	assert(pQueue == mpDevice->GetTransferQueue());
+
+	// the buffer is used by the graphics queue, its ownership is moved from the copy queue family:
+	// released after the copy, acquired by the graphics queue once the copy is done
+	VkBufferMemoryBarrier releaseBarrier = VulkanInitializers::BufferMemoryBarrier
+	(
+		VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT, 0,
+		pQueue->GetFamilyIndex(), pGraphicsQueue->GetFamilyIndex(),
+		pDestBuffer->GetHandle(), bufferCopy.dstOffset, bufferCopy.size
+	);
+	vkCmdPipelineBarrier(copyCommandBuffer.GetHandle(), VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &releaseBarrier, 0, nullptr);
+	VK_CHECK_RESULT(copyCommandBuffer.End());
+
+	VulkanCommandPool acquireCommandPool(mpDevice, pGraphicsQueue->GetFamilyIndex());
+	VulkanCommandBuffer acquireCommandBuffer(mpDevice, acquireCommandPool.GetHandle(), VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+	VkBufferMemoryBarrier acquireBarrier = VulkanInitializers::BufferMemoryBarrier
+	(
+		0, VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT,
+		pQueue->GetFamilyIndex(), pGraphicsQueue->GetFamilyIndex(),
+		pDestBuffer->GetHandle(), bufferCopy.dstOffset, bufferCopy.size
+	);
+	vkCmdPipelineBarrier(acquireCommandBuffer.GetHandle(), VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 1, &acquireBarrier, 0, nullptr);
+	VK_CHECK_RESULT(acquireCommandBuffer.End());
+
+	VulkanSubmission submission(mpDevice);
+	uint32_t copyBatchIdx = submission.AddBatch(VulkanLogicalDevice::QueueType::GE_QT_TRANSFER, { copyCommandBuffer.GetHandle() });
+	uint32_t acquireBatchIdx = submission.AddBatch(VulkanLogicalDevice::QueueType::GE_QT_GRAPHICS, { acquireCommandBuffer.GetHandle() });
+	submission.AddDependency(acquireBatchIdx, copyBatchIdx, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+	VulkanFence fence(mpDevice);
+	submission.SetFence(acquireBatchIdx, fence.GetHandle());
+
+	VK_CHECK_RESULT(submission.Submit());
+	VK_CHECK_RESULT(fence.WaitIdle(VK_TRUE, DEFAULT_FENCE_TIMEOUT));
 }
 
 void VulkanBuffer::CopyTo(VulkanImage* pDestImage, VulkanQueue* pQueue, const std::vector<VkBufferImageCopy>& copyRegions)
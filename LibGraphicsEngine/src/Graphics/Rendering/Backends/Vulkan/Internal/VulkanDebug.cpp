@@ -2,7 +2,6 @@
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanInitializers.hpp"
 #include "Foundation/Logger.hpp"
 #include <iostream>
-#include <sstream>
 #include <cassert>
 
 namespace GraphicsEngine
@@ -65,9 +64,6 @@ namespace GraphicsEngine
 				}
 
 				// Display message to default output (console/logcat)
-				std::stringstream debugMessage;
-				debugMessage << prefix << " [" << pLayerPrefix << "] Code " << msgCode << " : " << pMsg;
-
 				//if (flags & VK_DEBUG_REPORT_ERROR_BIT_EXT) 
 				//{
 				//	std::cerr << debugMessage.str() << std::endl;
@@ -78,9 +74,8 @@ namespace GraphicsEngine
 				//}
 
 				// info level as we do not want to report the file, func and line, only the message
-				LOG_INFO(debugMessage.str().c_str());
-
-				fflush(stdout);
+				// NOTE! The logger copies the strings and formats the message on its own thread, nothing is flushed here
+				LOG_INFO("%s [%s] Code %d : %s", prefix.c_str(), pLayerPrefix, msgCode, pMsg);
 
 				// The return value of this callback controls wether the Vulkan call that caused
 				// the validation message will be aborted or not
@@ -62,8 +62,10 @@ void VulkanDevice::Create()
 	mpInstance = GE_ALLOC(VulkanInstance)(mpWindow->GetWindowTitle(), mEnableValidationLayers);
 	assert(mpInstance != nullptr);
 
+#if !defined(USE_HEADLESS) // no surface, the swap chain images are offscreen images
 	mpSurface = GE_ALLOC(VulkanSurface)(this);
 	assert(mpSurface != nullptr);
+#endif // USE_HEADLESS
 
 	//NOTE! For now we support only one gpu
 	// TODO - multigpu support
@@ -323,6 +325,13 @@ bool VulkanDevice::IsComputeQueueSupported() const
 	return mpLogicalDevice->IsComputeQueueSupported();
 }
 
+bool_t VulkanDevice::IsTransferQueueSupported() const
+{
+	assert(mpLogicalDevice != nullptr);
+
+	return mpLogicalDevice->IsTransferQueueSupported();
+}
+
 bool VulkanDevice::IsPresentQueueSupported() const
 {
 	assert(mpLogicalDevice != nullptr);
@@ -334,21 +343,42 @@ VulkanQueue* VulkanDevice::GetGraphicsQueue() const
 {
 	assert(mpLogicalDevice != nullptr);
 
-	return mpLogicalDevice->GetQueue(VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT);
+	return mpLogicalDevice->GetQueue(VulkanLogicalDevice::QueueType::GE_QT_GRAPHICS);
 }
 
 VulkanQueue* VulkanDevice::GetPresentQueue() const
 {
 	assert(mpLogicalDevice != nullptr);
 
-	return mpLogicalDevice->GetQueue(VkQueueFlagBits::VK_QUEUE_TRANSFER_BIT);
+	return mpLogicalDevice->GetQueue(VulkanLogicalDevice::QueueType::GE_QT_PRESENT);
 }
 
 VulkanQueue* VulkanDevice::GetComputeQueue() const
 {
 	assert(mpLogicalDevice != nullptr);
 
-	return mpLogicalDevice->GetQueue(VkQueueFlagBits::VK_QUEUE_COMPUTE_BIT);
+	return mpLogicalDevice->GetQueue(VulkanLogicalDevice::QueueType::GE_QT_COMPUTE);
+}
+
+VulkanQueue* VulkanDevice::GetTransferQueue() const
+{
+	assert(mpLogicalDevice != nullptr);
+
+	return mpLogicalDevice->GetQueue(VulkanLogicalDevice::QueueType::GE_QT_TRANSFER);
+}
+
+VulkanQueue* VulkanDevice::GetQueue(VulkanLogicalDevice::QueueType queueType) const
+{
+	assert(mpLogicalDevice != nullptr);
+
+	return mpLogicalDevice->GetQueue(queueType);
+}
+
+bool_t VulkanDevice::IsDrawIndirectCountEnabled() const
+{
+	assert(mpLogicalDevice != nullptr);
+
+	return mpLogicalDevice->IsDrawIndirectCountEnabled();
 }
 
 VulkanAllocator* VulkanDevice::GetAllocator() const
@@ -84,14 +84,22 @@ namespace GraphicsEngine
 			// window
 			Platform::Window* GetWindow() const;
 
-			// queues
+			// queues, see VulkanLogicalDevice
 			bool_t IsGraphicsQueueSupported() const;
+			// separate queues, not the graphics one
 			bool_t IsComputeQueueSupported() const;
+			bool_t IsTransferQueueSupported() const;
 			bool_t IsPresentQueueSupported() const;
 
 			VulkanQueue* GetGraphicsQueue() const;
 			VulkanQueue* GetPresentQueue() const;
+			// the graphics queue if there is no separate one
 			VulkanQueue* GetComputeQueue() const;
+			VulkanQueue* GetTransferQueue() const;
+			VulkanQueue* GetQueue(VulkanLogicalDevice::QueueType queueType) const;
+
+			// features enabled on demand
+			bool_t IsDrawIndirectCountEnabled() const;
 
 			// allocator
 			VulkanAllocator* GetAllocator() const;
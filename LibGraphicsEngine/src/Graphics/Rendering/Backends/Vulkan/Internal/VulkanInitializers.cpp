@@ -112,6 +112,14 @@ namespace GraphicsEngine
 
 				return physicalDeviceProperties2;
 			}
+
+			VkPhysicalDeviceFeatures2 PhysicalDeviceFeatures2()
+			{
+				VkPhysicalDeviceFeatures2 physicalDeviceFeatures2 {};
+				physicalDeviceFeatures2.sType = VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+				return physicalDeviceFeatures2;
+			}
 #endif // defined(VK_VERSION_1_1)
 
 #if defined(VK_VERSION_1_2)
@@ -122,6 +130,14 @@ namespace GraphicsEngine
 
 				return physicalDeviceDriverProperties;
 			}
+
+			VkPhysicalDeviceVulkan12Features PhysicalDeviceVulkan12Features()
+			{
+				VkPhysicalDeviceVulkan12Features physicalDeviceVulkan12Features {};
+				physicalDeviceVulkan12Features.sType = VkStructureType::VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+				return physicalDeviceVulkan12Features;
+			}
 #else //extension
 			VkPhysicalDeviceDriverPropertiesKHR PhysicalDeviceDriverPropertiesKHR()
 			{
@@ -673,9 +689,9 @@ namespace GraphicsEngine
 				bufferMemoryBarrier.sType = VkStructureType::VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
 				bufferMemoryBarrier.pNext = nullptr;
 				bufferMemoryBarrier.srcAccessMask = srcAccessMask;
-				bufferMemoryBarrier.dstAccessMask = srcAccessMask;
-				bufferMemoryBarrier.srcQueueFamilyIndex = srcAccessMask;
-				bufferMemoryBarrier.dstQueueFamilyIndex = srcAccessMask;
+				bufferMemoryBarrier.dstAccessMask = dstAccessMask;
+				bufferMemoryBarrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+				bufferMemoryBarrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
 				bufferMemoryBarrier.buffer = buffer;
 				bufferMemoryBarrier.offset = offset;
 				bufferMemoryBarrier.size = size;
@@ -926,7 +942,7 @@ namespace GraphicsEngine
 				return pipelineShaderStageCreateInfo;
 			}
 
-		/*	VkSpecializationInfo SpecializationInfo(uint32_t mapEntryCount, const VkSpecializationMapEntry* pMapEntries, size_t dataSize, const void* pData)
+			VkSpecializationInfo SpecializationInfo(uint32_t mapEntryCount, const VkSpecializationMapEntry* pMapEntries, size_t dataSize, const void* pData)
 			{
 				VkSpecializationInfo specializationInfo {};
 				specializationInfo.mapEntryCount = mapEntryCount;
@@ -945,7 +961,7 @@ namespace GraphicsEngine
 				specializationMapEntry.size = size;
 
 				return specializationMapEntry;
-			}*/
+			}
 
 			// VertexInput State
 			VkPipelineVertexInputStateCreateInfo PipelineVertexInputStateCreateInfo(uint32_t vertexBindingDescriptionCount, const VkVertexInputBindingDescription* pVertexBindingDescriptions, 
@@ -38,10 +38,12 @@ namespace GraphicsEngine
 #if defined(VK_VERSION_1_1)
 			VkPhysicalDeviceGroupProperties PhysicalDeviceGroupProperties();
 			VkPhysicalDeviceProperties2 PhysicalDeviceProperties2();
+			VkPhysicalDeviceFeatures2 PhysicalDeviceFeatures2();
 #endif // defined(VK_VERSION_1_1)
 
 #if defined(VK_VERSION_1_2)
 			VkPhysicalDeviceDriverProperties PhysicalDeviceDriverProperties();
+			VkPhysicalDeviceVulkan12Features PhysicalDeviceVulkan12Features();
 #else //extension
 			VkPhysicalDeviceDriverPropertiesKHR PhysicalDeviceDriverPropertiesKHR();
 #endif // defined(VK_VERSION_1_2)
@@ -225,9 +227,9 @@ namespace GraphicsEngine
 			VkPipelineShaderStageCreateInfo PipelineShaderStageCreateInfo(VkShaderStageFlagBits stage, VkShaderModule module, const char_t* pName, const VkSpecializationInfo* pSpecializationInfo = nullptr,
 				VkPipelineShaderStageCreateFlags flags = 0);
 
-	//		VkSpecializationInfo SpecializationInfo(uint32_t mapEntryCount, const VkSpecializationMapEntry* pMapEntries, size_t dataSize, const void* pData);
+			VkSpecializationInfo SpecializationInfo(uint32_t mapEntryCount, const VkSpecializationMapEntry* pMapEntries, size_t dataSize, const void* pData);
 
-	//		VkSpecializationMapEntry SpecializationMapEntry(uint32_t constantID, uint32_t offset, size_t size);
+			VkSpecializationMapEntry SpecializationMapEntry(uint32_t constantID, uint32_t offset, size_t size);
 
 			// VertexInput State
 			VkPipelineVertexInputStateCreateInfo PipelineVertexInputStateCreateInfo(uint32_t vertexBindingDescriptionCount, const VkVertexInputBindingDescription* pVertexBindingDescriptions,
@@ -131,7 +131,9 @@ void VulkanInstance::Create(const char_t* pTitle)
 	std::vector<const char_t*> neededInstanceExtensions;
 
 	// attempt to add the needed extensions
+#if !defined(USE_HEADLESS)
 	bool_t isAvailableKHRSurface = false;
+#endif // USE_HEADLESS
 #if defined(VK_USE_PLATFORM_WIN32_KHR)
 	bool_t isAvailableKHRWin32Surface = false;
 #endif //VK_USE_PLATFORM_WIN32_KHR
@@ -139,11 +141,13 @@ void VulkanInstance::Create(const char_t* pTitle)
 
 	for (const VkExtensionProperties& extension : supportedInstanceExtensions)
 	{
+#if !defined(USE_HEADLESS)
 		if (std::string(extension.extensionName) == VK_KHR_SURFACE_EXTENSION_NAME)
 		{
 			neededInstanceExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
 			isAvailableKHRSurface = true;
 		}
+#endif // USE_HEADLESS
 
 		// Enable surface extensions depending on os
 #if defined(VK_USE_PLATFORM_WIN32_KHR)
@@ -165,11 +169,13 @@ void VulkanInstance::Create(const char_t* pTitle)
 	}
 
 	// check if the needed extensions are available indeed
+#if !defined(USE_HEADLESS) // no surface, we render offscreen
 	if (false == isAvailableKHRSurface)
 	{
 		LOG_ERROR("%s extension is not supported! Abort!", VK_KHR_SURFACE_EXTENSION_NAME);
 		return;
 	}
+#endif // USE_HEADLESS
 #if defined(VK_USE_PLATFORM_WIN32_KHR)
 	if (false == isAvailableKHRWin32Surface)
 	{
@@ -9,19 +9,39 @@
 using namespace GraphicsEngine;
 using namespace GraphicsEngine::Graphics;
 
+// can the queue family present to the surface
+static VkBool32 IsPresentSupported(VulkanDevice* pDevice, uint32_t queueFamilyIndex)
+{
+	assert(pDevice != nullptr);
+
+	VkBool32 suportsPresent = VK_FALSE;
+#if defined(USE_HEADLESS)
+	// no surface, the frames are "presented" by the graphics queue which also reads them back
+	auto& queueFamiliyPropertiesVector = pDevice->GetQueueFamilyPropertiesVector();
+	suportsPresent = ((queueFamiliyPropertiesVector[queueFamilyIndex].queueFlags & VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT) != 0) ? VK_TRUE : VK_FALSE;
+#else
+	VK_CHECK_RESULT(vkGetPhysicalDeviceSurfaceSupportKHR(pDevice->GetPhysicalDeviceHandle(), queueFamilyIndex, pDevice->GetSurfaceHandle(), &suportsPresent));
+#endif // USE_HEADLESS
+
+	return suportsPresent;
+}
+
 VulkanLogicalDevice::VulkanLogicalDevice()
 	: mpDevice(nullptr)
 	, mHandle(VK_NULL_HANDLE)
 	, mQueueFamilyIndices{}
+	, mIsDrawIndirectCountEnabled(false)
 {}
 
 VulkanLogicalDevice::VulkanLogicalDevice(VulkanDevice* pDevice)
 	: mpDevice(pDevice)
 	, mHandle(VK_NULL_HANDLE)
 	, mQueueFamilyIndices{}
+	, mIsDrawIndirectCountEnabled(false)
 {
 	mQueueFamilyIndices.graphics = UINT32_MAX;
 	mQueueFamilyIndices.compute = UINT32_MAX;
+	mQueueFamilyIndices.transfer = UINT32_MAX;
 	mQueueFamilyIndices.present = UINT32_MAX;
 
 	Create();
@@ -49,35 +69,30 @@ void VulkanLogicalDevice::Create()
 	const float32_t defaultQueuePriority(1.0f); //highest priority
 
 	// TODO - for now we consider to use 1 queue per family !!!
+	// the queue types of the same family share its queue, a family can only be requested once
+	auto& queueFamiliyPropertiesVector = mpDevice->GetQueueFamilyPropertiesVector();
 
-	if (IsGraphicsQueueSupported())
+	const uint32_t familyIndices[] =
 	{
-		auto pQueue = GE_ALLOC(VulkanQueue)(VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT, mQueueFamilyIndices.graphics, defaultQueueIndex, defaultQueuePriority);
-		assert(pQueue != nullptr);
+		mQueueFamilyIndices.graphics, mQueueFamilyIndices.compute, mQueueFamilyIndices.transfer, mQueueFamilyIndices.present
+	};
 
-		mQueueMap[VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT] = pQueue;
-	}
-
-	if (IsComputeQueueSupported())
+	for (auto familyIndex : familyIndices)
 	{
-		auto pQueue = GE_ALLOC(VulkanQueue)(VkQueueFlagBits::VK_QUEUE_COMPUTE_BIT, mQueueFamilyIndices.compute, defaultQueueIndex, defaultQueuePriority);
-		assert(pQueue != nullptr);
+		if ((familyIndex == UINT32_MAX) || (mQueueMap.find(familyIndex) != mQueueMap.end()))
+			continue;
 
-		mQueueMap[VkQueueFlagBits::VK_QUEUE_COMPUTE_BIT] = pQueue;
-	}
-
-	if (IsPresentQueueSupported())
-	{
-		auto pQueue = GE_ALLOC(VulkanQueue)(VkQueueFlagBits::VK_QUEUE_TRANSFER_BIT, mQueueFamilyIndices.present, defaultQueueIndex, defaultQueuePriority);
+		auto pQueue = GE_ALLOC(VulkanQueue)(queueFamiliyPropertiesVector[familyIndex].queueFlags, familyIndex, defaultQueueIndex, defaultQueuePriority);
 		assert(pQueue != nullptr);
 
-		mQueueMap[VkQueueFlagBits::VK_QUEUE_TRANSFER_BIT] = pQueue;
+		mQueueMap[familyIndex] = pQueue;
 	}
 
 
 	// Create the logical device representation
 	std::vector<const char_t*> neededDeviceExtensions(mEnabledDeviceExtensions);
 
+#if !defined(USE_HEADLESS) // no swapchain, we render offscreen
 	// check if the needed extension is supported
 	bool_t isAvailableKHRSwapChain = false;
 	const auto& extensions = mpDevice->GetPhysicalDeviceSupportedExtensions();
@@ -97,6 +112,7 @@ void VulkanLogicalDevice::Create()
 		LOG_ERROR("%s extension is not supported! Abort!", VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 		return;
 	}
+#endif // USE_HEADLESS
 
 	assert(mQueueMap.empty() == false);
 
@@ -124,6 +140,11 @@ void VulkanLogicalDevice::Create()
 	// clip plane
 	enabledDeviceFeatures.shaderClipDistance = VK_TRUE;
 
+#if defined(GPU_CULLING)
+	// the culled draws of a node are a single indirect draw
+	enabledDeviceFeatures.multiDrawIndirect = mpDevice->GetPhysicalDeviceFeatures().multiDrawIndirect;
+#endif // GPU_CULLING
+
 	mpDevice->SetPhysicalDeviceEnabledFeatures(enabledDeviceFeatures);
 
 	//NOTE! If physical device groups are avaialble and there are at least 2 physical devices to create a logical device from
@@ -138,6 +159,27 @@ void VulkanLogicalDevice::Create()
 		deviceCreateInfo.ppEnabledExtensionNames = neededDeviceExtensions.data();
 	}
 
+#if defined(GPU_CULLING) && defined(VK_VERSION_1_2)
+	// the draw count of the culled draws is read from a buffer, core feature since Vulkan 1.2
+	VkPhysicalDeviceVulkan12Features enabledVulkan12Features = VulkanInitializers::PhysicalDeviceVulkan12Features();
+	if (mpDevice->GetPhysicalDeviceProperties().apiVersion >= VK_API_VERSION_1_2)
+	{
+		VkPhysicalDeviceVulkan12Features vulkan12Features = VulkanInitializers::PhysicalDeviceVulkan12Features();
+		VkPhysicalDeviceFeatures2 features2 = VulkanInitializers::PhysicalDeviceFeatures2();
+		features2.pNext = &vulkan12Features;
+
+		vkGetPhysicalDeviceFeatures2(mpDevice->GetPhysicalDeviceHandle(), &features2);
+
+		if (vulkan12Features.drawIndirectCount)
+		{
+			enabledVulkan12Features.drawIndirectCount = VK_TRUE;
+			deviceCreateInfo.pNext = &enabledVulkan12Features;
+
+			mIsDrawIndirectCountEnabled = true;
+		}
+	}
+#endif // defined(GPU_CULLING) && defined(VK_VERSION_1_2)
+
 	// NOTE! The VkQueue(s) are destroyed with the VkDevice logical device
 
 	VK_CHECK_RESULT(vkCreateDevice(mpDevice->GetPhysicalDeviceHandle(), &deviceCreateInfo, nullptr, &mHandle));
@@ -183,7 +225,6 @@ void VulkanLogicalDevice::SelectSupportedQueueFamilies()
 	assert(mpDevice != nullptr);
 
 	assert(mpDevice->GetPhysicalDeviceHandle() != VK_NULL_HANDLE);
-	assert(mpDevice->GetSurfaceHandle() != VK_NULL_HANDLE);
 
 	auto& queueFamiliyPropertiesVector = mpDevice->GetQueueFamilyPropertiesVector();
 	
@@ -200,8 +241,7 @@ void VulkanLogicalDevice::SelectSupportedQueueFamilies()
 			}
 
 			// get info about present for the current queue family
-			VkBool32 suportsPresent = VK_FALSE;
-			VK_CHECK_RESULT(vkGetPhysicalDeviceSurfaceSupportKHR(mpDevice->GetPhysicalDeviceHandle(), i, mpDevice->GetSurfaceHandle(), &suportsPresent));
+			VkBool32 suportsPresent = IsPresentSupported(mpDevice, i);
 
 			if (suportsPresent == VK_TRUE)
 			{
@@ -210,26 +250,6 @@ void VulkanLogicalDevice::SelectSupportedQueueFamilies()
 				break;
 			}
 		}
-
-		// Check compute queue family support
-		if ((queueFamiliyPropertiesVector[i].queueFlags & VkQueueFlagBits::VK_QUEUE_COMPUTE_BIT) != 0)
-		{
-			if (mQueueFamilyIndices.compute == UINT32_MAX)
-			{
-				mQueueFamilyIndices.compute = i;
-			}
-
-			// get info about present for the current queue family
-			VkBool32 suportsPresent = VK_FALSE;
-			VK_CHECK_RESULT(vkGetPhysicalDeviceSurfaceSupportKHR(mpDevice->GetPhysicalDeviceHandle(), i, mpDevice->GetSurfaceHandle(), &suportsPresent));
-
-			if (suportsPresent == VK_TRUE)
-			{
-				mQueueFamilyIndices.compute = i;
-				mQueueFamilyIndices.present = i;
-				break;
-			}
-		}
 	}
 
 	// If there's no queue that supports both present and graphics
@@ -238,17 +258,12 @@ void VulkanLogicalDevice::SelectSupportedQueueFamilies()
 	{
 		for (uint32_t i = 0; i < queueFamiliyPropertiesVector.size(); ++i)
 		{
-			// Check separate present/transfer queue family support
-			if ((queueFamiliyPropertiesVector[i].queueFlags & VkQueueFlagBits::VK_QUEUE_TRANSFER_BIT) != 0)
+			VkBool32 suportsPresent = IsPresentSupported(mpDevice, i);
+
+			if (suportsPresent == VK_TRUE)
 			{
-				VkBool32 suportsPresent = VK_FALSE;
-				VK_CHECK_RESULT(vkGetPhysicalDeviceSurfaceSupportKHR(mpDevice->GetPhysicalDeviceHandle(), i, mpDevice->GetSurfaceHandle(), &suportsPresent));
-
-				if (suportsPresent == VK_TRUE)
-				{
-					mQueueFamilyIndices.present = i;
-					break;
-				}
+				mQueueFamilyIndices.present = i;
+				break;
 			}
 		}
 	}
@@ -260,6 +275,35 @@ void VulkanLogicalDevice::SelectSupportedQueueFamilies()
 		return;
 	}
 
+	// async compute - a compute queue family without graphics, its work can overlap the graphics work
+	// dedicated transfer - a transfer queue family without graphics and compute, usually a DMA engine
+	for (uint32_t i = 0; i < queueFamiliyPropertiesVector.size(); ++i)
+	{
+		const VkQueueFlags queueFlags = queueFamiliyPropertiesVector[i].queueFlags;
+		if (queueFlags & VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT)
+			continue;
+
+		if ((mQueueFamilyIndices.compute == UINT32_MAX) && (queueFlags & VkQueueFlagBits::VK_QUEUE_COMPUTE_BIT))
+		{
+			mQueueFamilyIndices.compute = i;
+		}
+		else if ((mQueueFamilyIndices.transfer == UINT32_MAX) && (queueFlags & VkQueueFlagBits::VK_QUEUE_TRANSFER_BIT) &&
+			(0 == (queueFlags & VkQueueFlagBits::VK_QUEUE_COMPUTE_BIT)))
+		{
+			mQueueFamilyIndices.transfer = i;
+		}
+	}
+
+	// the graphics queue family supports compute and transfer operations as well
+	if (mQueueFamilyIndices.compute == UINT32_MAX)
+	{
+		mQueueFamilyIndices.compute = mQueueFamilyIndices.graphics;
+	}
+	if (mQueueFamilyIndices.transfer == UINT32_MAX)
+	{
+		mQueueFamilyIndices.transfer = mQueueFamilyIndices.graphics;
+	}
+
 	if (IsPresentQueueSupported())
 	{
 		LOG_INFO("The system supports a separate present queues");
@@ -273,6 +317,11 @@ void VulkanLogicalDevice::SelectSupportedQueueFamilies()
 	{
 		LOG_INFO("The system supports a separate compute queue!");
 	}
+
+	if (IsTransferQueueSupported())
+	{
+		LOG_INFO("The system supports a separate transfer queue!");
+	}
 }
 
 VkResult VulkanLogicalDevice::WaitIdle() const
@@ -287,9 +336,30 @@ const VkDevice& VulkanLogicalDevice::GetHandle() const
 	return mHandle;
 }
 
-VulkanQueue* VulkanLogicalDevice::GetQueue(VkQueueFlagBits queueFlag) const
+VulkanQueue* VulkanLogicalDevice::GetQueue(VulkanLogicalDevice::QueueType queueType) const
 {
-	auto it = mQueueMap.find(queueFlag);
+	uint32_t familyIndex = UINT32_MAX;
+	switch (queueType)
+	{
+	case QueueType::GE_QT_GRAPHICS:
+		familyIndex = mQueueFamilyIndices.graphics;
+		break;
+	case QueueType::GE_QT_COMPUTE:
+		familyIndex = mQueueFamilyIndices.compute;
+		break;
+	case QueueType::GE_QT_TRANSFER:
+		familyIndex = mQueueFamilyIndices.transfer;
+		break;
+	case QueueType::GE_QT_PRESENT:
+		familyIndex = mQueueFamilyIndices.present;
+		break;
+	case QueueType::GE_QT_COUNT:
+	default:
+		LOG_ERROR("Invalid queue type!");
+		return nullptr;
+	}
+
+	auto it = mQueueMap.find(familyIndex);
 
 	if (it != mQueueMap.end())
 	{
@@ -315,10 +385,20 @@ bool VulkanLogicalDevice::IsGraphicsQueueSupported() const
 
 bool VulkanLogicalDevice::IsComputeQueueSupported() const
 {
-	return ((mQueueFamilyIndices.compute != UINT32_MAX) && (mQueueFamilyIndices.compute != mQueueFamilyIndices.graphics) && (mQueueFamilyIndices.compute != mQueueFamilyIndices.present));
+	return ((mQueueFamilyIndices.compute != UINT32_MAX) && (mQueueFamilyIndices.compute != mQueueFamilyIndices.graphics));
+}
+
+bool_t VulkanLogicalDevice::IsTransferQueueSupported() const
+{
+	return ((mQueueFamilyIndices.transfer != UINT32_MAX) && (mQueueFamilyIndices.transfer != mQueueFamilyIndices.graphics));
 }
 
 bool VulkanLogicalDevice::IsPresentQueueSupported() const
 {
-	return ((mQueueFamilyIndices.present != UINT32_MAX) && (mQueueFamilyIndices.present != mQueueFamilyIndices.graphics) && (mQueueFamilyIndices.present != mQueueFamilyIndices.compute));
+	return ((mQueueFamilyIndices.present != UINT32_MAX) && (mQueueFamilyIndices.present != mQueueFamilyIndices.graphics));
+}
+
+bool_t VulkanLogicalDevice::IsDrawIndirectCountEnabled() const
+{
+	return mIsDrawIndirectCountEnabled;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Graphics/Rendering/Backends/Vulkan/Common/VulkanObject.hpp"
 #include <unordered_map>
+#include <vector>
 
 namespace GraphicsEngine
 {
@@ -34,6 +35,13 @@ namespace GraphicsEngine
 			For two physical devices to be in the same device group, they must support identical extensions, features, and properties.
 
 			Operations on logical device: wait for work to finish
+
+			Queues: a queue is created per selected queue family, the queue types share the queue of their family:
+			- graphics - the first family with graphics support, preferably with present support too
+			- compute - a family with compute but without graphics support (async compute), else the graphics family
+			- transfer - a family with transfer support only (DMA engine), else the graphics family
+			- present - the graphics family if it can present, else the first family which can
+			With a single queue family (e.g. lavapipe) all the queue types are the graphics queue.
 		*/
 		class VulkanLogicalDevice : public VulkanObject
 		{
@@ -44,10 +52,20 @@ namespace GraphicsEngine
 			{
 				uint32_t graphics;
 				uint32_t compute;
+				uint32_t transfer;
 				uint32_t present;
 				//uint32_t sparseMemory;
 			} QueueFamilyIndices;
 
+			enum class QueueType : uint8_t
+			{
+				GE_QT_GRAPHICS = 0,
+				GE_QT_COMPUTE,
+				GE_QT_TRANSFER,
+				GE_QT_PRESENT,
+				GE_QT_COUNT
+			};
+
 			VulkanLogicalDevice();
 			explicit VulkanLogicalDevice(VulkanDevice* pDevice);
 			virtual ~VulkanLogicalDevice();
@@ -55,13 +73,19 @@ namespace GraphicsEngine
 			VkResult WaitIdle() const;
 
 			const VkDevice& GetHandle() const;
-			VulkanQueue* GetQueue(VkQueueFlagBits queueFlag) const;
+			// the queue of the type, see above
+			VulkanQueue* GetQueue(VulkanLogicalDevice::QueueType queueType) const;
 			const VulkanLogicalDevice::QueueFamilyIndices& GetQueueFamilyIndices() const;
 
 			bool_t IsGraphicsQueueSupported() const;
+			// separate queues, not the graphics one
 			bool_t IsComputeQueueSupported() const;
+			bool_t IsTransferQueueSupported() const;
 			bool_t IsPresentQueueSupported() const;
 
+			// vkCmdDrawIndirectCount(), vkCmdDrawIndexedIndirectCount(), only enabled with GPU_CULLING
+			bool_t IsDrawIndirectCountEnabled() const;
+
 		private:
 			void Create();
 			void Destroy();
@@ -73,8 +97,8 @@ namespace GraphicsEngine
 			// Logical device, application's view of the physical device (GPU)
 			VkDevice mHandle;
 
-			// Queues
-			std::unordered_map<VkQueueFlagBits, VulkanQueue*> mQueueMap;
+			// Queues, one per queue family index
+			std::unordered_map<uint32_t, VulkanQueue*> mQueueMap;
 
 			// Queue family indices
 			QueueFamilyIndices mQueueFamilyIndices;
@@ -82,6 +106,8 @@ namespace GraphicsEngine
 			// enabled extensions
 			std::vector<const char_t*> mEnabledDeviceExtensions;
 
+			bool_t mIsDrawIndirectCountEnabled;
+
 		};
 	}
 }
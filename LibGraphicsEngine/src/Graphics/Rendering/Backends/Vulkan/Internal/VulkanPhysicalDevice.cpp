@@ -2,6 +2,7 @@
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanDevice.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanHelpers.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanInitializers.hpp"
+#include "Foundation/Platform/Platform.hpp"
 #include <array>
 #include <cassert>
 
@@ -124,7 +125,9 @@ void VulkanPhysicalDevice::SelectPhysicalDevice()
 void VulkanPhysicalDevice::Init()
 {
 	assert(mpDevice != nullptr);
+#if !defined(USE_HEADLESS)
 	assert(mpDevice->GetSurfaceHandle() != VK_NULL_HANDLE);
+#endif // USE_HEADLESS
 
 	// NOTE! Vulkan 1.0 supported Device Layers
 // see vkEnumerateDeviceLayerProperties() which is deprecated in Vulkan 1.1 and 1.2
@@ -202,6 +205,25 @@ void VulkanPhysicalDevice::Init()
 	vkGetPhysicalDeviceMemoryProperties(mHandle, &mMemoryProperties);
 	VulkanHelpers::ListPhysicalDeviceMemoryProperties(mMemoryProperties);
 
+#if defined(USE_HEADLESS)
+	// there is no surface to query, so we describe the offscreen images the swap chain creates instead
+	// double buffered, the images can be copied to the host
+	mSurfaceCapabilities.minImageCount = 1;
+	mSurfaceCapabilities.maxImageCount = 2;
+	mSurfaceCapabilities.minImageExtent = { 1, 1 };
+	mSurfaceCapabilities.maxImageExtent = { mProperties.limits.maxImageDimension2D, mProperties.limits.maxImageDimension2D };
+	mSurfaceCapabilities.maxImageArrayLayers = 1;
+	mSurfaceCapabilities.supportedTransforms = VkSurfaceTransformFlagBitsKHR::VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+	mSurfaceCapabilities.currentTransform = VkSurfaceTransformFlagBitsKHR::VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+	mSurfaceCapabilities.supportedCompositeAlpha = VkCompositeAlphaFlagBitsKHR::VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+	mSurfaceCapabilities.supportedUsageFlags = VkImageUsageFlagBits::VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VkImageUsageFlagBits::VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+	UpdateSurfaceCapabilities();
+
+	// every implementation supports B8G8R8A8_UNORM as color attachment and transfer source
+	mSurfaceFormats = { { VkFormat::VK_FORMAT_B8G8R8A8_UNORM, VkColorSpaceKHR::VK_COLOR_SPACE_SRGB_NONLINEAR_KHR } };
+
+	mSurfacePresentModes = { VkPresentModeKHR::VK_PRESENT_MODE_FIFO_KHR };
+#else
 	// Surface Capabilities
 	VK_CHECK_RESULT(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(mHandle, mpDevice->GetSurfaceHandle(), &mSurfaceCapabilities));
 
@@ -220,6 +242,7 @@ void VulkanPhysicalDevice::Init()
 
 	mSurfacePresentModes.resize(presentModeCount);
 	VK_CHECK_RESULT(vkGetPhysicalDeviceSurfacePresentModesKHR(mHandle, mpDevice->GetSurfaceHandle(), &presentModeCount, mSurfacePresentModes.data()));
+#endif // USE_HEADLESS
 
 	// Queue Family Properties
 	uint32_t queueFamilyCount = 0;
@@ -318,7 +341,15 @@ void VulkanPhysicalDevice::UpdateSurfaceCapabilities()
 {
 	assert(mpDevice != nullptr);
 
+#if defined(USE_HEADLESS)
+	auto pWindow = mpDevice->GetWindow();
+	assert(pWindow != nullptr);
+
+	// the offscreen images follow the window size
+	pWindow->GetWindowSize(&mSurfaceCapabilities.currentExtent.width, &mSurfaceCapabilities.currentExtent.height);
+#else
 	VK_CHECK_RESULT(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(mHandle, mpDevice->GetSurfaceHandle(), &mSurfaceCapabilities));
+#endif // USE_HEADLESS
 }
 
 bool VulkanPhysicalDevice::GetMemoryType(uint32_t typeBits, VkMemoryPropertyFlags requirementsMask, uint32_t& typeIndex)
@@ -3,6 +3,7 @@
 
 #include "Graphics/Rendering/Backends/Vulkan/Common/VulkanObject.hpp"
 #include <vector>
+#include <array>
 #include <string>
 
 #define DEPTH_STENCIL_FORMAT_COUNT 5
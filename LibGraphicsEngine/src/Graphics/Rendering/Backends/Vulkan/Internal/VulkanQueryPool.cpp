@@ -82,6 +82,23 @@ void VulkanQueryPool::GetQueryResults(uint32_t queryCount, void* pData, size_t d
 	vkGetQueryPoolResults(mpDevice->GetDeviceHandle(), mHandle, QUERY_ID, queryCount, dataSize, pData, stride, flags);
 }
 
+void VulkanQueryPool::ResetQuery(VkCommandBuffer commandBufferHandle, uint32_t firstQuery, uint32_t queryCount)
+{
+	vkCmdResetQueryPool(commandBufferHandle, mHandle, firstQuery, queryCount);
+}
+
+void VulkanQueryPool::WriteTimestamp(VkCommandBuffer commandBufferHandle, VkPipelineStageFlagBits pipelineStage, uint32_t query)
+{
+	vkCmdWriteTimestamp(commandBufferHandle, pipelineStage, mHandle, query);
+}
+
+VkResult VulkanQueryPool::GetQueryResults(uint32_t firstQuery, uint32_t queryCount, void* pData, size_t dataSize, VkDeviceSize stride, VkQueryResultFlags flags)
+{
+	assert(mpDevice != nullptr);
+
+	return vkGetQueryPoolResults(mpDevice->GetDeviceHandle(), mHandle, firstQuery, queryCount, dataSize, pData, stride, flags);
+}
+
 const VkQueryPool& VulkanQueryPool::GetHandle() const
 {
 	return mHandle;
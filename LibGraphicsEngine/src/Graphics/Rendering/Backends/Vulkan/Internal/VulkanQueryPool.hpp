@@ -42,6 +42,12 @@ namespace GraphicsEngine
 
 			void GetQueryResults(uint32_t queryCount, void* pData, size_t dataSize, VkDeviceSize stride, VkQueryResultFlags flags);
 
+			// query ranges, used by the timestamp queries
+			void ResetQuery(VkCommandBuffer commandBufferHandle, uint32_t firstQuery, uint32_t queryCount);
+			void WriteTimestamp(VkCommandBuffer commandBufferHandle, VkPipelineStageFlagBits pipelineStage, uint32_t query);
+			// returns VK_NOT_READY if some results are not available yet
+			VkResult GetQueryResults(uint32_t firstQuery, uint32_t queryCount, void* pData, size_t dataSize, VkDeviceSize stride, VkQueryResultFlags flags);
+
 			const VkQueryPool& GetHandle() const;
 
 		private:
@@ -55,11 +55,11 @@ void VulkanRenderPass::Destroy()
 	}
 }
 
-void VulkanRenderPass::Begin(VkCommandBuffer commandBufferHandle, VkFramebuffer frameBufferHandle, const VkRect2D& renderArea, 	const std::vector<VkClearValue>& clearValues,
+void VulkanRenderPass::Begin(VkCommandBuffer commandBufferHandle, VkFramebuffer frameBufferHandle, const VkRect2D& renderArea, uint32_t clearValueCount, const VkClearValue* pClearValues,
 							 VkSubpassContents contents)
 {
 	VkRenderPassBeginInfo renderPassBeginInfo =
-		VulkanInitializers::RenderPassBeginInfo(mHandle, frameBufferHandle, renderArea, static_cast<uint32_t>(clearValues.size()), clearValues.data());
+		VulkanInitializers::RenderPassBeginInfo(mHandle, frameBufferHandle, renderArea, clearValueCount, pClearValues);
 
 	vkCmdBeginRenderPass(commandBufferHandle, &renderPassBeginInfo, contents);
 }
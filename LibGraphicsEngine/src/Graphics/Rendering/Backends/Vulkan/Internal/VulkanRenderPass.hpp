@@ -53,7 +53,7 @@ namespace GraphicsEngine
 					const std::vector<VkSubpassDependency>& subPassDependencies);
 			virtual ~VulkanRenderPass();
 
-			void Begin(VkCommandBuffer commandBufferHandle, VkFramebuffer frameBufferHandle, const VkRect2D& renderArea, const std::vector<VkClearValue>& clearValues,
+			void Begin(VkCommandBuffer commandBufferHandle, VkFramebuffer frameBufferHandle, const VkRect2D& renderArea, uint32_t clearValueCount, const VkClearValue* pClearValues,
 				VkSubpassContents contents = VkSubpassContents::VK_SUBPASS_CONTENTS_INLINE);
 			void End(VkCommandBuffer commandBufferHandle);
 
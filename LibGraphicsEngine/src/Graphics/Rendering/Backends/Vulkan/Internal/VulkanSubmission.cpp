@@ -0,0 +1,168 @@
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanSubmission.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanDevice.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanQueue.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanSemaphore.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanInitializers.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanHelpers.hpp"
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+VulkanSubmission::VulkanSubmission()
+	: mpDevice(nullptr)
+	, mUsedSemaphoreCount(0)
+	, mCrossQueueDependencyCount(0)
+	, mQueueSubmitCount(0)
+{}
+
+VulkanSubmission::VulkanSubmission(VulkanDevice* pDevice)
+	: mpDevice(pDevice)
+	, mUsedSemaphoreCount(0)
+	, mCrossQueueDependencyCount(0)
+	, mQueueSubmitCount(0)
+{
+	Create();
+}
+
+VulkanSubmission::~VulkanSubmission()
+{
+	Destroy();
+}
+
+void VulkanSubmission::Create()
+{
+	assert(mpDevice != nullptr);
+}
+
+void VulkanSubmission::Destroy()
+{
+	Reset();
+
+	for (auto* pSemaphore : mSemaphores)
+	{
+		GE_FREE(pSemaphore);
+	}
+	mSemaphores.clear();
+
+	if (mpDevice)
+	{
+		mpDevice = nullptr;
+	}
+}
+
+void VulkanSubmission::Reset()
+{
+	mBatches.clear();
+
+	mUsedSemaphoreCount = 0;
+	mCrossQueueDependencyCount = 0;
+}
+
+uint32_t VulkanSubmission::AddBatch(VulkanLogicalDevice::QueueType queueType, const std::vector<VkCommandBuffer>& commandBufferHandles)
+{
+	assert(mpDevice != nullptr);
+
+	Batch batch;
+	batch.pQueue = mpDevice->GetQueue(queueType);
+	assert(batch.pQueue != nullptr);
+	batch.commandBufferHandles = commandBufferHandles;
+	batch.fenceHandle = VK_NULL_HANDLE;
+
+	mBatches.push_back(batch);
+
+	return static_cast<uint32_t>(mBatches.size() - 1);
+}
+
+void VulkanSubmission::AddDependency(uint32_t batchIdx, uint32_t producerBatchIdx, VkPipelineStageFlags waitStageMask)
+{
+	assert(batchIdx < mBatches.size());
+	assert(producerBatchIdx < batchIdx);
+
+	// a binary semaphore is waited once, one per dependency
+	if (mUsedSemaphoreCount == mSemaphores.size())
+	{
+		auto* pSemaphore = GE_ALLOC(VulkanSemaphore)(mpDevice);
+		assert(pSemaphore != nullptr);
+
+		mSemaphores.push_back(pSemaphore);
+	}
+
+	const VkSemaphore semaphoreHandle = mSemaphores[mUsedSemaphoreCount++]->GetHandle();
+
+	AddSignalSemaphore(producerBatchIdx, semaphoreHandle);
+	AddWaitSemaphore(batchIdx, semaphoreHandle, waitStageMask);
+
+	if (mBatches[batchIdx].pQueue != mBatches[producerBatchIdx].pQueue)
+	{
+		mCrossQueueDependencyCount++;
+	}
+}
+
+void VulkanSubmission::AddWaitSemaphore(uint32_t batchIdx, VkSemaphore semaphoreHandle, VkPipelineStageFlags waitStageMask)
+{
+	assert(batchIdx < mBatches.size());
+	assert(semaphoreHandle != VK_NULL_HANDLE);
+
+	auto& batch = mBatches[batchIdx];
+	batch.waitSemaphoreHandles.push_back(semaphoreHandle);
+	batch.waitStageMasks.push_back(waitStageMask);
+}
+
+void VulkanSubmission::AddSignalSemaphore(uint32_t batchIdx, VkSemaphore semaphoreHandle)
+{
+	assert(batchIdx < mBatches.size());
+	assert(semaphoreHandle != VK_NULL_HANDLE);
+
+	mBatches[batchIdx].signalSemaphoreHandles.push_back(semaphoreHandle);
+}
+
+void VulkanSubmission::SetFence(uint32_t batchIdx, VkFence fenceHandle)
+{
+	assert(batchIdx < mBatches.size());
+
+	mBatches[batchIdx].fenceHandle = fenceHandle;
+}
+
+VkResult VulkanSubmission::Submit()
+{
+	mQueueSubmitCount = 0;
+
+	std::vector<VkSubmitInfo> submitInfos;
+	for (uint32_t i = 0; i < mBatches.size(); ++i)
+	{
+		const auto& batch = mBatches[i];
+
+		submitInfos.push_back(VulkanInitializers::SubmitInfo
+		(
+			static_cast<uint32_t>(batch.commandBufferHandles.size()), batch.commandBufferHandles.data(),
+			static_cast<uint32_t>(batch.waitSemaphoreHandles.size()), batch.waitSemaphoreHandles.data(), batch.waitStageMasks.data(),
+			static_cast<uint32_t>(batch.signalSemaphoreHandles.size()), batch.signalSemaphoreHandles.data()
+		));
+
+		// the next batch goes to another queue or the fence must be signaled by this one
+		const bool_t isLastOfQueue = ((i + 1) == mBatches.size()) || (mBatches[i + 1].pQueue != batch.pQueue) || (batch.fenceHandle != VK_NULL_HANDLE);
+		if (false == isLastOfQueue)
+			continue;
+
+		VkResult res = batch.pQueue->Submit(static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), batch.fenceHandle);
+		if (res != VkResult::VK_SUCCESS)
+			return res;
+
+		submitInfos.clear();
+		mQueueSubmitCount++;
+	}
+
+	return VkResult::VK_SUCCESS;
+}
+
+uint32_t VulkanSubmission::GetQueueSubmitCount() const
+{
+	return mQueueSubmitCount;
+}
+
+uint32_t VulkanSubmission::GetCrossQueueDependencyCount() const
+{
+	return mCrossQueueDependencyCount;
+}
\ No newline at end of file
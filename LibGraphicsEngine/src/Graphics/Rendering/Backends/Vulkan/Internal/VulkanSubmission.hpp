@@ -0,0 +1,93 @@
+#ifndef GRAPHICS_RENDERING_BACKENDS_VULKAN_INTERNAL_VULKAN_SUBMISSION_HPP
+#define GRAPHICS_RENDERING_BACKENDS_VULKAN_INTERNAL_VULKAN_SUBMISSION_HPP
+
+#include "Graphics/Rendering/Backends/Vulkan/Common/VulkanObject.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanLogicalDevice.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class VulkanDevice;
+		class VulkanQueue;
+		class VulkanSemaphore;
+
+		/*
+			Work submitted to several queues (see VulkanLogicalDevice::QueueType), e.g. the buffer uploads on the transfer queue
+			and their ownership transfer on the graphics queue, see VulkanBuffer::CopyTo().
+
+			The work is split in batches, a batch is a list of command buffers submitted to a queue type.
+			A batch can depend on the batches added before it: it waits for them at the given pipeline stages.
+			Each dependency is a semaphore signaled by the producer and waited by the consumer batch, the semaphores are
+			owned by the submission and reused by the next submissions.
+
+			The batches are submitted in the order they were added, so the signals are submitted before their waits.
+			The consecutive batches of the same queue are a single queue submit (a fence ends it).
+			The queue types can share the same queue (e.g. lavapipe has a single queue family), the dependencies are
+			semaphores anyway: the same batches and waits are submitted, the work is only serialized by the single queue.
+
+			NOTE! The semaphores are reused by Reset(), the previous submission must be done (e.g. its fence was waited).
+			See Tools/VulkanSubmissionCheck for the queue submit and cross queue dependency counts.
+		*/
+		class VulkanSubmission : public VulkanObject
+		{
+			GE_RTTI(GraphicsEngine::Graphics::VulkanSubmission)
+
+		public:
+			VulkanSubmission();
+			explicit VulkanSubmission(VulkanDevice* pDevice);
+			virtual ~VulkanSubmission();
+
+			// removes the batches, keeps the semaphores
+			void Reset();
+
+			// returns the batch index
+			uint32_t AddBatch(VulkanLogicalDevice::QueueType queueType, const std::vector<VkCommandBuffer>& commandBufferHandles);
+
+			// the batch waits at waitStageMask for the producer batch, added before it
+			void AddDependency(uint32_t batchIdx, uint32_t producerBatchIdx, VkPipelineStageFlags waitStageMask);
+
+			// semaphores of other operations, e.g. the swap chain image acquire and present
+			void AddWaitSemaphore(uint32_t batchIdx, VkSemaphore semaphoreHandle, VkPipelineStageFlags waitStageMask);
+			void AddSignalSemaphore(uint32_t batchIdx, VkSemaphore semaphoreHandle);
+
+			// signaled when the batch and the batches submitted before it to its queue are done
+			void SetFence(uint32_t batchIdx, VkFence fenceHandle);
+
+			VkResult Submit();
+
+			// the queue submits of the last Submit()
+			uint32_t GetQueueSubmitCount() const;
+			// the dependencies between the batches of different queues
+			uint32_t GetCrossQueueDependencyCount() const;
+
+		private:
+			void Create();
+			void Destroy();
+
+			struct Batch
+			{
+				VulkanQueue* pQueue;
+				std::vector<VkCommandBuffer> commandBufferHandles;
+				std::vector<VkSemaphore> waitSemaphoreHandles;
+				std::vector<VkPipelineStageFlags> waitStageMasks;
+				std::vector<VkSemaphore> signalSemaphoreHandles;
+				VkFence fenceHandle;
+			};
+
+			VulkanDevice* mpDevice;
+
+			std::vector<Batch> mBatches;
+
+			// the first mUsedSemaphoreCount are used by the batches
+			std::vector<VulkanSemaphore*> mSemaphores;
+			uint32_t mUsedSemaphoreCount;
+
+			uint32_t mCrossQueueDependencyCount;
+			uint32_t mQueueSubmitCount;
+		};
+	}
+}
+
+#endif // GRAPHICS_RENDERING_BACKENDS_VULKAN_INTERNAL_VULKAN_SUBMISSION_HPP
\ No newline at end of file
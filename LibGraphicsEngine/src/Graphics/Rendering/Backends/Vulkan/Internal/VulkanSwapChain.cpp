@@ -15,6 +15,7 @@ VulkanSwapChain::VulkanSwapChain()
 	, mHandle(VK_NULL_HANDLE)
 	, mOldHandle(VK_NULL_HANDLE)
 	, mpDepthStencilBuffer(nullptr)
+	, mNextImageIdx(0)
 {}
 
 VulkanSwapChain::VulkanSwapChain(VulkanDevice* pDevice)
@@ -22,7 +23,7 @@ VulkanSwapChain::VulkanSwapChain(VulkanDevice* pDevice)
 	, mHandle(VK_NULL_HANDLE)
 	, mOldHandle(VK_NULL_HANDLE)
 	, mpDepthStencilBuffer(nullptr)
-
+	, mNextImageIdx(0)
 {
 	Create();
 }
@@ -34,9 +35,13 @@ VulkanSwapChain::~VulkanSwapChain()
 
 void VulkanSwapChain::Create()
 {
+#if !defined(USE_HEADLESS) // no surface to present to, only the offscreen buffers are created
 	CreateSwapChain();
+#endif // USE_HEADLESS
 
 	CreateSwapChainBuffers();
+
+	mNextImageIdx = 0;
 }
 
 void VulkanSwapChain::CreateSwapChain()
@@ -163,8 +168,32 @@ void VulkanSwapChain::CreateSwapChainBuffers()
 {
 	assert(mpDevice != nullptr);
 
+	auto& surfaceCapabilities = mpDevice->GetSurfaceCapabilities();
+
 	////// COLOR IMAGE
 
+#if defined(USE_HEADLESS)
+	uint32_t imageCount = surfaceCapabilities.minImageCount + 1;
+	if ((surfaceCapabilities.maxImageCount > 0) && (imageCount > surfaceCapabilities.maxImageCount))
+	{
+		imageCount = surfaceCapabilities.maxImageCount;
+	}
+
+	mSwapChainColorBuffers.resize(imageCount);
+
+	for (uint32_t i = 0; i < mSwapChainColorBuffers.size(); ++i)
+	{
+		mSwapChainColorBuffers[i] = GE_ALLOC(VulkanSwapChainBuffer)
+		(
+			mpDevice,
+			mpDevice->GetSurfaceFormat().format,
+			surfaceCapabilities.supportedUsageFlags,
+			surfaceCapabilities.currentExtent.width, surfaceCapabilities.currentExtent.height,
+			VulkanSwapChainBuffer::BufferType::GE_BT_COLOR
+		);
+		assert(mSwapChainColorBuffers[i] != nullptr);
+	}
+#else
 	// Get swap chain color image count
 	uint32_t imageCount = 0;
 	VK_CHECK_RESULT(vkGetSwapchainImagesKHR(mpDevice->GetDeviceHandle(), mHandle, &imageCount, nullptr));
@@ -185,12 +214,11 @@ void VulkanSwapChain::CreateSwapChainBuffers()
 		);
 		assert(mSwapChainColorBuffers[i] != nullptr);
 	}
+#endif // USE_HEADLESS
 
 	//////// DEPTH IMAGE
 	// TODO - for depth stencil we use only 1 image
 
-	auto& surfaceCapabilities = mpDevice->GetSurfaceCapabilities();
-
 	mpDepthStencilBuffer = GE_ALLOC(VulkanSwapChainBuffer)
 	(
 		mpDevice,
@@ -251,7 +279,18 @@ VkResult VulkanSwapChain::AcquireNextImage(uint32_t* pImageIndex, VkSemaphore pr
 {
 	assert(mpDevice != nullptr);
 
+#if defined(USE_HEADLESS)
+	assert(pImageIndex != nullptr);
+	assert(mSwapChainColorBuffers.empty() == false);
+
+	// nothing to wait for, the renderer waits for the previous use of the image with its fence
+	*pImageIndex = mNextImageIdx;
+	mNextImageIdx = (mNextImageIdx + 1) % static_cast<uint32_t>(mSwapChainColorBuffers.size());
+
+	return VkResult::VK_SUCCESS;
+#else
 	return vkAcquireNextImageKHR(mpDevice->GetDeviceHandle(), mHandle, UINT64_MAX, presentCompleteSemaphoreHandle, VK_NULL_HANDLE, pImageIndex);
+#endif // USE_HEADLESS
 }
 
 void VulkanSwapChain::Reset()
@@ -21,6 +21,9 @@ namespace GraphicsEngine
 			multiview/stereoscopic-3D surfaces) is displayed at a time, but multiple images can be queued for presentation. 
 			An application renders to the image, and then queues the image for presentation to the surface.
 
+			NOTE! With USE_HEADLESS there is no surface, so no VkSwapchainKHR: the color buffers are offscreen images
+			which can be copied to the host and the next image is acquired round robin.
+
 			The swapchain images (color) have an image view corespondent used by the VKFramebuffer object. 
 
 			A native window cannot be associated with more than one non-retired swapchain at a time. Further, swapchains cannot 
@@ -62,6 +65,9 @@ namespace GraphicsEngine
 			// Swapchain buffers = image + image view: color + depth
 			std::vector<VulkanSwapChainBuffer*> mSwapChainColorBuffers;
 			VulkanSwapChainBuffer* mpDepthStencilBuffer;
+
+			// headless only
+			mutable uint32_t mNextImageIdx;
 		};
 	}
 }
@@ -72,15 +72,8 @@ void GADRIndexBuffer::Create(Renderer* pRenderer)
 
 	// Buffer copies have to be submitted to a queue, so we need a command buffer for them
 	// Note: Some devices offer a dedicated transfer queue (with only the transfer bit set) that may be faster when doing lots of copies
-
-	if (pDevice->IsPresentQueueSupported()) // separate present queue
-	{
-		pStagingIndices->CopyTo(mpVulkanBuffer, pDevice->GetPresentQueue());
-	}
-	else // graphics and present queue are the same
-	{
-		pStagingIndices->CopyTo(mpVulkanBuffer, pDevice->GetGraphicsQueue());
-	}
+	// the transfer queue is the graphics queue if there is no separate one, else the buffer is moved to the graphics queue family
+	pStagingIndices->CopyTo(mpVulkanBuffer, pDevice->GetTransferQueue());
 	GE_FREE(pStagingIndices);
 }
 
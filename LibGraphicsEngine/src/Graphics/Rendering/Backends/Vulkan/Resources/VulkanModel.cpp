@@ -40,10 +40,17 @@ void GADRModel::Destroy()
 	}
 }
 
-void GADRModel::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB)
+void GADRModel::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
 {
 	assert(mpModel != nullptr);
 
 	mpModel->Draw(onDrawCB);
 }
+
+void GADRModel::DrawMeshlets(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB)
+{
+	assert(mpModel != nullptr);
+
+	mpModel->DrawMeshlets(onDrawCB);
+}
 #endif // VULKAN_RENDERER
\ No newline at end of file
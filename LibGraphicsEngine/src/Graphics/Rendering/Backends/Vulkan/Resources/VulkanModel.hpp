@@ -3,6 +3,7 @@
 
 #if defined(VULKAN_RENDERER)
 #include "Graphics/Rendering/Backends/Vulkan/Resources/VulkanResource.hpp"
+#include "Graphics/GeometricPrimitives/MeshletBuilder.hpp"
 #include <functional>
 
 namespace GraphicsEngine
@@ -25,7 +26,8 @@ namespace GraphicsEngine
 			explicit GADRModel(Renderer* pRenderer, Model* pModel);
 			virtual ~GADRModel();
 
-			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB);
+			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+			void DrawMeshlets(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB);
 
 
 		private:
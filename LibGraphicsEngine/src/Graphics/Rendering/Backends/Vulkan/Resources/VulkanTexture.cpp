@@ -91,6 +91,10 @@ void GADRTexture::Create(Renderer* pRenderer)
 		else if (mpTexture->IsDepthFormat())
 		{
 			usage |= VkImageUsageFlagBits::VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+#if defined(SHADOW_CACHING)
+			// the shadow cache is copied to the shadow map, see VulkanRenderer::DrawShadowCache()
+			usage |= VkImageUsageFlagBits::VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VkImageUsageFlagBits::VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+#endif // SHADOW_CACHING
 		}
 	}
 
@@ -165,16 +169,9 @@ void GADRTexture::Create(Renderer* pRenderer)
 		}
 
 		// Buffer copies have to be submitted to a queue, so we need a command buffer for them
-		// Note: Some devices offer a dedicated transfer/present queue (with only the transfer bit set) that may be faster when doing lots of copies
-
-		if (pDevice->IsPresentQueueSupported()) // separate present queue
-		{
-			pStagingBuffer->CopyTo(mpVulkanImage, pDevice->GetPresentQueue(), bufferCopyRegions);
-		}
-		else // graphics and present queue are the same
-		{
-			pStagingBuffer->CopyTo(mpVulkanImage, pDevice->GetGraphicsQueue(), bufferCopyRegions);
-		}
+		// NOTE! The graphics queue: the copy ends with the transition to the shader read layout, a graphics queue layout
+		// the image stays owned by the graphics queue family
+		pStagingBuffer->CopyTo(mpVulkanImage, pDevice->GetGraphicsQueue(), bufferCopyRegions);
 		GE_FREE(pStagingBuffer);
 	}
 
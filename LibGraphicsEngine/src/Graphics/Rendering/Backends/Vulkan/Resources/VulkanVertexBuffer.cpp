@@ -74,16 +74,9 @@ void GADRVertexBuffer::Create(Renderer* pRenderer)
 
 
 	// Buffer copies have to be submitted to a queue, so we need a command buffer for them
-	// Note: Some devices offer a dedicated transfer/present queue (with only the transfer bit set) that may be faster when doing lots of copies
-
-	if (pDevice->IsPresentQueueSupported()) // separate present queue
-	{
-		pStagingVertices->CopyTo(mpVulkanBuffer, pDevice->GetPresentQueue());
-	}
-	else // graphics and present queue are the same
-	{
-		pStagingVertices->CopyTo(mpVulkanBuffer, pDevice->GetGraphicsQueue());
-	}
+	// Note: Some devices offer a dedicated transfer queue (with only the transfer bit set) that may be faster when doing lots of copies
+	// the transfer queue is the graphics queue if there is no separate one, else the buffer is moved to the graphics queue family
+	pStagingVertices->CopyTo(mpVulkanBuffer, pDevice->GetTransferQueue());
 	GE_FREE(pStagingVertices);
 }
 
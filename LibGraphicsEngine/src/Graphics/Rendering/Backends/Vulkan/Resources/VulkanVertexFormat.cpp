@@ -40,7 +40,8 @@ void GADRVertexFormat::Create(Renderer* pRenderer)
 	size_t index = 0;
 	for (auto iter = attributes.begin(); iter != attributes.end(); ++ iter)
 	{
-		VkFormat internalFormat = VulkanUtils::VertexFormatToVulkanVertexFormat(iter->first, iter->second);
+		VkFormat internalFormat = VulkanUtils::VertexFormatToVulkanVertexFormat(iter->first,
+			mpVertexFormat->GetVertexAttributeStoredComponentCount(iter->first), mpVertexFormat->GetVertexAttributeType(iter->first));
 
 		VkVertexInputAttributeDescription attributeDesc{};
 		attributeDesc.location = 0; // NOTE! Has to be updated later based on vertex shader input data~
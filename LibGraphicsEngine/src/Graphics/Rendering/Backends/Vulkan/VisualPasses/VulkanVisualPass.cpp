@@ -24,6 +24,7 @@
 #include "Graphics/Rendering/Resources/RenderTarget.hpp"
 #include "Graphics/SceneGraph/GeometryNode.hpp"
 #include "Graphics/ShaderTools/GLSL/GLSLShaderParser.hpp"
+#include "Graphics/ShaderTools/GLSL/GLSLShaderTypes.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
 #include "Foundation/Logger.hpp"
 #include <cassert>
@@ -42,6 +43,12 @@ GADVisualPass::GADVisualPass()
 	, mpGraphicsPipeline(nullptr)
 	, mpVisualPass(nullptr)
 	, mIsPresentPass(false)
+	, mVertexSpecializationMapEntry{}
+	, mVertexSpecializationData(VK_FALSE)
+	, mVertexSpecializationInfo{}
+	, mFragmentSpecializationMapEntry{}
+	, mFragmentSpecializationData(VK_FALSE)
+	, mFragmentSpecializationInfo{}
 {}
 
 GADVisualPass::GADVisualPass(Renderer* pRenderer, VisualPass* pVisualPass)
@@ -132,7 +139,8 @@ void GADVisualPass::SetupDescriptorSets()
 				//TODO - for now we know its only samplers
 				VkDescriptorType descriptorType = VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 
-				auto& uniforms = pParser->GetUniforms();
+				// NOTE! The textures are added to the pass in the binding order of the samplers
+				auto uniforms = pParser->GetUniformsByBinding();
 
 				if (mpVisualPass->HasTextures())
 				{
@@ -152,7 +160,7 @@ void GADVisualPass::SetupDescriptorSets()
 							auto* gadrTexture = mpVulkanRenderer->Get(pTexture);
 							assert(gadrTexture != nullptr);
 
-							AddWriteDescriptorSet(shaderStage, unifIter->second.setId, unifIter->second.binding,
+							AddWriteDescriptorSet(shaderStage, (*unifIter)->second.setId, (*unifIter)->second.binding,
 								descriptorType, &(gadrTexture->GetVkDescriptorInfo()), nullptr);
 						}
 						else if (pTexture->GetUsageType() == Texture::UsageType::GE_UT_RENDER_TARGET)
@@ -160,51 +168,33 @@ void GADVisualPass::SetupDescriptorSets()
 							auto* pVisualEffect = mpVisualPass->GetVisualEffect();
 							assert(pVisualEffect != nullptr);
 
-							const auto& passMap = pVisualEffect->GetPasses();
-
-							bool_t foundRT = false;
-							VisualEffect::PassMap::const_iterator cPassIt;
-							VisualPass::RenderTargetMap::const_iterator cRTIt;
-							for (cPassIt = passMap.begin(); cPassIt != passMap.end(); ++cPassIt)
-							{
-								auto& passVector = cPassIt->second;
-								for (auto* pPass : passVector)
-								{
-									if (pPass)
-									{
-										const auto& renderTargets = pPass->GetRenderTargets();
-										for (cRTIt = renderTargets.begin(); cRTIt != renderTargets.end(); ++cRTIt)
-										{
-											auto* pRT = cRTIt->second;
-											assert(pRT != nullptr);
-
-											if (pRT->GetTexture() == pTexture)
-											{
-												foundRT = true;
-												break;
-											}
-										}
-									}
-								}
-
-								if (foundRT)
-									break;
-							}
-
-							if (foundRT)
+							auto* pRT = pVisualEffect->FindRenderTarget(pTexture);
+							if (pRT)
 							{
-								auto* pRT = cRTIt->second;
-
 								auto* gadrTexture = mpVulkanRenderer->Get(pRT);
 								assert(gadrTexture != nullptr);
 
-								AddWriteDescriptorSet(shaderStage, unifIter->second.setId, unifIter->second.binding,
+								AddWriteDescriptorSet(shaderStage, (*unifIter)->second.setId, (*unifIter)->second.binding,
 									descriptorType, &(gadrTexture->GetVkDescriptorInfo()), nullptr);
 							}
 						}
 					}
 				}
 			}
+
+			// storage buffers, shared by all the passes
+			for (const auto& storageBlock : pParser->GetStorageBlocks())
+			{
+				auto* pStorageBuffer = mpVulkanRenderer->GetStorageBuffer(storageBlock.name);
+				if (nullptr == pStorageBuffer)
+				{
+					LOG_ERROR("No storage buffer for the block %s in shader: %s!", storageBlock.name.c_str(), pShader->GetSourcePath().c_str());
+					continue;
+				}
+
+				AddWriteDescriptorSet(shaderStage, storageBlock.setId, storageBlock.binding,
+					VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &(pStorageBuffer->GetDescriptorInfo()));
+			}
 		}
 	}
 
@@ -303,6 +293,9 @@ void GADVisualPass::SetupPipeline()
 	assert(mpVisualPass != nullptr);
 
 	////  Shaders state
+	SetupVertexSpecialization();
+	SetupFragmentSpecialization();
+
 	std::vector<VkPipelineShaderStageCreateInfo> pipelineShaderStages;
 	SetupShaderStage(pipelineShaderStages);
 
@@ -405,11 +398,51 @@ void GADVisualPass::SetupShaderStage(std::vector<VkPipelineShaderStageCreateInfo
 		(
 			shaderStage,
 			refVkShader->GetHandle(),
-			SHADER_ENTRY_POINT
+			SHADER_ENTRY_POINT,
+			((shaderStage == VkShaderStageFlagBits::VK_SHADER_STAGE_VERTEX_BIT) ? &mVertexSpecializationInfo :
+				((shaderStage == VkShaderStageFlagBits::VK_SHADER_STAGE_FRAGMENT_BIT) ? &mFragmentSpecializationInfo : nullptr))
 		);
 	}
 }
 
+void GADVisualPass::SetupVertexSpecialization()
+{
+	assert(mpVisualPass != nullptr);
+
+	mVertexSpecializationData = VK_FALSE;
+
+	// the vertices are generated in the vertex shader
+	auto* pGeoNode = mpVisualPass->GetNode();
+	if (pGeoNode && (false == mpVisualPass->GetIsDebug()) && (false == mpVisualPass->GetIsFullScreen()))
+	{
+		auto* pGeometry = pGeoNode->GetGeometry();
+		assert(pGeometry != nullptr);
+
+		auto* pVertexFormat = pGeometry->GetVertexFormat();
+		assert(pVertexFormat != nullptr);
+
+		mVertexSpecializationData = ((pVertexFormat->GetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_NORMAL) ==
+			VertexFormat::AttributeType::GE_AT_OCTAHEDRAL_SNORM16) ? VK_TRUE : VK_FALSE);
+	}
+
+	// the shaders without the constant ignore it
+	mVertexSpecializationMapEntry = VulkanInitializers::SpecializationMapEntry(GLSLShaderTypes::Constants::CONSTANT_ID_OCTAHEDRAL_NORMALS, 0, sizeof(VkBool32));
+	mVertexSpecializationInfo = VulkanInitializers::SpecializationInfo(1, &mVertexSpecializationMapEntry, sizeof(VkBool32), &mVertexSpecializationData);
+}
+
+void GADVisualPass::SetupFragmentSpecialization()
+{
+#if defined(CLUSTERED_LIGHTING)
+	mFragmentSpecializationData = VK_TRUE;
+#else
+	mFragmentSpecializationData = VK_FALSE;
+#endif // CLUSTERED_LIGHTING
+
+	// the shaders without the constant ignore it
+	mFragmentSpecializationMapEntry = VulkanInitializers::SpecializationMapEntry(GLSLShaderTypes::Constants::CONSTANT_ID_CLUSTERED_LIGHTING, 0, sizeof(VkBool32));
+	mFragmentSpecializationInfo = VulkanInitializers::SpecializationInfo(1, &mFragmentSpecializationMapEntry, sizeof(VkBool32), &mFragmentSpecializationData);
+}
+
 void GADVisualPass::SetupVertexInputState(VkPipelineVertexInputStateCreateInfo& pipelineVertexInputStateCreateInfoOut)
 {
 	// NOTE! We need a geometry independent vertex format !!!
@@ -418,10 +451,13 @@ void GADVisualPass::SetupVertexInputState(VkPipelineVertexInputStateCreateInfo&
 	assert(mpVulkanRenderer != nullptr);
 	assert(mpVisualPass != nullptr);
 
-	if (mpVisualPass->GetIsDebug())
+	// the vertices are generated in the vertex shader
+	if (mpVisualPass->GetIsDebug() || mpVisualPass->GetIsFullScreen())
 	{
 		pipelineVertexInputStateCreateInfoOut =
 			VulkanInitializers::PipelineVertexInputStateCreateInfo(0, nullptr, 0, nullptr);
+
+		return;
 	}
 
 	auto* pGeoNode = mpVisualPass->GetNode();
@@ -534,7 +570,7 @@ void GADVisualPass::SetupRasterizationState(VkPipelineRasterizationStateCreateIn
 
 	VkCullModeFlagBits vulkanCullMode = VulkanUtils::FaceCullModeToVulkanFaceCullMode(mpVisualPass->GetCullFaceState().GetCullMode());
 
-	if (mpVisualPass->GetIsDebug())
+	if (mpVisualPass->GetIsDebug() || mpVisualPass->GetIsFullScreen())
 	{
 		vulkanCullMode = VkCullModeFlagBits::VK_CULL_MODE_NONE;
 	}
@@ -626,10 +662,15 @@ void GADVisualPass::SetupColorBlendState(VkPipelineColorBlendStateCreateInfo& pi
 	pipelineColorBlendAttachmentState.alphaBlendOp = alphaBlendOp;
 	pipelineColorBlendAttachmentState.colorWriteMask = colorWriteMask;
 
+	// the G-buffer pass writes the albedo, normal and material attachments
+	const size_t colorAttachmentCount = (mpVisualPass->GetPassType() == VisualPass::PassType::GE_PT_GBUFFER ? 3 : 1);
+	mColorBlendAttachmentStates.assign(colorAttachmentCount, pipelineColorBlendAttachmentState);
+
 	auto constantColor = colorBlendState.GetConstantColor();
 
 	pipelineColorBlendStateCreateInfoOut =
-		VulkanInitializers::PipelineColorBlendStateCreateInfo(VK_FALSE, VkLogicOp::VK_LOGIC_OP_NO_OP, 1, &pipelineColorBlendAttachmentState, &constantColor[0]);
+		VulkanInitializers::PipelineColorBlendStateCreateInfo(VK_FALSE, VkLogicOp::VK_LOGIC_OP_NO_OP, static_cast<uint32_t>(mColorBlendAttachmentStates.size()),
+			mColorBlendAttachmentStates.data(), &constantColor[0]);
 }
 
 void GADVisualPass::SetupDynamicState(VkPipelineDynamicStateCreateInfo& pipelineDynamicStateCreateInfoOut)
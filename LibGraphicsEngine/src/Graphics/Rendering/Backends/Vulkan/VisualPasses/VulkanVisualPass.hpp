@@ -41,6 +41,8 @@ namespace GraphicsEngine
 			void SetupDescriptorSets();
 
 			void SetupPipeline();
+			void SetupVertexSpecialization();
+			void SetupFragmentSpecialization();
 			void SetupShaderStage(std::vector<VkPipelineShaderStageCreateInfo>& shaderStagesOut);
 			void SetupVertexInputState(VkPipelineVertexInputStateCreateInfo& pipelineVertexInputStateCreateInfoOut);
 			void SetupPrimitiveAssemblyState(VkPipelineInputAssemblyStateCreateInfo& pipelineInputAssemblyStateCreateInfoOut);
@@ -79,6 +81,19 @@ namespace GraphicsEngine
 			VisualPass* mpVisualPass;
 			bool_t mIsPresentPass; // default pass - to present to screen
 
+			// one per color attachment, referenced by the pipeline create info
+			std::vector<VkPipelineColorBlendAttachmentState> mColorBlendAttachmentStates;
+
+			// vertex shader specialization constants, referenced by the pipeline create info
+			VkSpecializationMapEntry mVertexSpecializationMapEntry;
+			VkBool32 mVertexSpecializationData; // octahedral normals, see GLSLShaderTypes::Constants::CONSTANT_ID_OCTAHEDRAL_NORMALS
+			VkSpecializationInfo mVertexSpecializationInfo;
+
+			// fragment shader specialization constants, referenced by the pipeline create info
+			VkSpecializationMapEntry mFragmentSpecializationMapEntry;
+			VkBool32 mFragmentSpecializationData; // clustered lights, see GLSLShaderTypes::Constants::CONSTANT_ID_CLUSTERED_LIGHTING
+			VkSpecializationInfo mFragmentSpecializationInfo;
+
 		private:
 			NO_COPY_NO_MOVE_CLASS(GADVisualPass)
 
@@ -4,7 +4,9 @@
 #include "Foundation/Platform/Platform.hpp"
 
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/MemoryManagement/StlAllocator.hpp"
 #include "Foundation/Logger.hpp"
+#include "Foundation/Profiler.hpp"
 
 #include "Graphics/Rendering/RenderQueue.hpp"
 
@@ -12,6 +14,7 @@
 #include "Graphics/SceneGraph/GeometryNode.hpp"
 #include "Graphics/SceneGraph/LightNode.hpp"
 #include "Graphics/Lights/DirectionalLight.hpp"
+#include "Graphics/Lights/LightClusterGrid.hpp"
 #include "Graphics/Cameras/Camera.hpp"
 
 #include "Graphics/Components/VisualComponent.hpp"
@@ -31,6 +34,7 @@
 // Common
 #include "Graphics/Rendering/Backends/Vulkan/Common/VulkanCommon.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Common/VulkanUtils.hpp"
+#include "glm/matrix.hpp" // glm::inverse()
 
 // Resources
 #include "Graphics/Rendering/Backends/Vulkan/Resources/VulkanVertexFormat.hpp"
@@ -56,6 +60,7 @@
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanRenderPass.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanSemaphore.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanFence.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanSubmission.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanShaderModule.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanBuffer.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanBufferView.hpp"
@@ -67,11 +72,16 @@
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanPipelineCache.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanPipelineLayout.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanGraphicsPipeline.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanComputePipeline.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanQueryPool.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanInitializers.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanHelpers.hpp"
 #include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanDebug.hpp"
 
+#include <algorithm> // std::copy(), std::max(), std::min(), std::find()
+#include <cstring> // ::memcpy(), ::memset()
+#include <iterator> // std::begin(), std::end()
+
 //#define PIPELINE_STATS
 
 using namespace GraphicsEngine;
@@ -84,19 +94,73 @@ VulkanRenderer::VulkanRenderer()
 	, mpPresentCompleteSemaphore(nullptr)
 	, mpCommandPool(nullptr)
 	, mCurrentBufferIdx(0) 
-	, mSubmitInfo{}
 	, mpPipelineCache(nullptr)
+	, mpTimestampQueryPool(nullptr)
+	, mTimestampQueryCount(0)
+	, mTimestampMask(0)
+	, mpReadBackBuffer(nullptr)
+	, mpClusterLightBuffer(nullptr)
+	, mpClusterBuffer(nullptr)
+	, mpClusterLightIndexBuffer(nullptr)
+#if defined(GPU_CULLING)
+	, mpGPUCullingShaderModule(nullptr)
+	, mpGPUCullingDescriptorSetLayout(nullptr)
+	, mpGPUCullingDescriptorPool(nullptr)
+	, mpGPUCullingPipelineLayout(nullptr)
+	, mpGPUCullingPipeline(nullptr)
+	, mpGPUCullingDrawBuffer(nullptr)
+	, mpGPUCullingCommandBuffer(nullptr)
+	, mpGPUCullingCountBuffer(nullptr)
+#if defined(GPU_CULLING_VALIDATION)
+	, mGPUCullingValidatedFrameCount(0)
+	, mGPUCullingMismatchFrameCount(0)
+#endif // GPU_CULLING_VALIDATION
+#endif // GPU_CULLING
+#if defined(SHADOW_CACHING)
+	, mpShadowCacheRT(nullptr)
+	, mpShadowCacheClearRenderPass(nullptr)
+	, mpShadowCacheLoadRenderPass(nullptr)
+	, mpShadowCacheFrameBuffer(nullptr)
+	, mIsDrawingShadowCache(false)
+#endif // SHADOW_CACHING
 {}
 
-VulkanRenderer::VulkanRenderer(Platform::Window* pWindow)
-	: Renderer(pWindow)
+VulkanRenderer::VulkanRenderer(Platform::Window* pWindow, Renderer::RendererType type)
+	: Renderer(pWindow, type)
 	, mpDevice(nullptr)
 	, mpRenderCompleteSemaphore(nullptr)
 	, mpPresentCompleteSemaphore(nullptr)
 	, mpCommandPool(nullptr)
 	, mCurrentBufferIdx(0)
-	, mSubmitInfo{}
 	, mpPipelineCache(nullptr)
+	, mpTimestampQueryPool(nullptr)
+	, mTimestampQueryCount(0)
+	, mTimestampMask(0)
+	, mpReadBackBuffer(nullptr)
+	, mpClusterLightBuffer(nullptr)
+	, mpClusterBuffer(nullptr)
+	, mpClusterLightIndexBuffer(nullptr)
+#if defined(GPU_CULLING)
+	, mpGPUCullingShaderModule(nullptr)
+	, mpGPUCullingDescriptorSetLayout(nullptr)
+	, mpGPUCullingDescriptorPool(nullptr)
+	, mpGPUCullingPipelineLayout(nullptr)
+	, mpGPUCullingPipeline(nullptr)
+	, mpGPUCullingDrawBuffer(nullptr)
+	, mpGPUCullingCommandBuffer(nullptr)
+	, mpGPUCullingCountBuffer(nullptr)
+#if defined(GPU_CULLING_VALIDATION)
+	, mGPUCullingValidatedFrameCount(0)
+	, mGPUCullingMismatchFrameCount(0)
+#endif // GPU_CULLING_VALIDATION
+#endif // GPU_CULLING
+#if defined(SHADOW_CACHING)
+	, mpShadowCacheRT(nullptr)
+	, mpShadowCacheClearRenderPass(nullptr)
+	, mpShadowCacheLoadRenderPass(nullptr)
+	, mpShadowCacheFrameBuffer(nullptr)
+	, mIsDrawingShadowCache(false)
+#endif // SHADOW_CACHING
 {
 	Init(pWindow);
 }
@@ -117,6 +181,14 @@ void VulkanRenderer::Init(Platform::Window* pWindow)
 	mWindowWidth = surfCapabilities.currentExtent.width;
 	mWindowHeight = surfCapabilities.currentExtent.height;
 
+#if defined(DEFERRED_RENDERING)
+	// the G-buffer is sampled per pixel of the swapchain
+	if (GetRendererType() == RendererType::GE_RT_DEFERRED)
+	{
+		mGBuffer.Init(mWindowWidth, mWindowHeight);
+	}
+#endif // DEFERRED_RENDERING
+
 	Prepare();
 }
 
@@ -146,6 +218,20 @@ void VulkanRenderer::Terminate()
 	mPipelineStatsMap.clear();
 #endif
 
+	GE_FREE(mpTimestampQueryPool);
+
+	GE_FREE(mpReadBackBuffer);
+
+	TerminateLightClusters();
+
+#if defined(GPU_CULLING)
+	TerminateGPUCulling();
+#endif // GPU_CULLING
+
+#if defined(SHADOW_CACHING)
+	TerminateShadowCache();
+#endif // SHADOW_CACHING
+
 	for (auto& it : mVisualPassMap)
 	{
 		auto& rpBuff = it.second;
@@ -179,6 +265,12 @@ void VulkanRenderer::Terminate()
 	}
 	mWaitFences.clear();
 
+	for (auto& submission : mFrameSubmissions)
+	{
+		GE_FREE(submission);
+	}
+	mFrameSubmissions.clear();
+
 	GE_FREE(mpDevice);
 }
 
@@ -197,7 +289,9 @@ void VulkanRenderer::Prepare()
 
 	SetupPipelineCache();
 
-	SetupSubmitInfo();
+	SetupFrameGraph();
+
+	SetupLightClusters();
 
 	mIsPrepared = true;
 }
@@ -277,6 +371,180 @@ void VulkanRenderer::SetupDrawCommandBuffers()
 	}
 }
 
+void VulkanRenderer::SetupFrameGraph()
+{
+	mFrameGraph.Reset();
+	mFrameGraphPasses.clear();
+
+	typedef RenderGraph::ResourceState State;
+
+	// the textures are owned by the render targets and the swapchain, they are all imported
+	// a texture starts the frame in the state the previous frame left it in, e.g. the shadow map sampled by the previous frame
+	auto importTexture = [this](const std::string& name, Texture::TextureFormat format, State state)
+		{
+			return mFrameGraph.ImportTexture(name, RenderGraph::TextureDesc(mWindowWidth, mWindowHeight, format), state, state);
+		};
+
+#if defined(USE_HEADLESS)
+	// headless the "swapchain" image is copied to the host instead, see ReadFrame()
+	const State presentState = State::GE_RS_TRANSFER_SRC;
+#else
+	const State presentState = State::GE_RS_PRESENT;
+#endif // USE_HEADLESS
+
+	const auto swapchain = importTexture("Swapchain", Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM, presentState);
+	const auto depth = importTexture("Depth", Texture::TextureFormat::GE_TF_D32, State::GE_RS_DEPTH_ATTACHMENT);
+	const auto offscreenColor = importTexture("OffscreenColor", Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM, State::GE_RS_SHADER_READ);
+	const auto offscreenDepth = importTexture("OffscreenDepth", Texture::TextureFormat::GE_TF_D32, State::GE_RS_DEPTH_ATTACHMENT);
+	const auto shadowMap = importTexture("ShadowMap", Texture::TextureFormat::GE_TF_D32, State::GE_RS_SHADER_READ);
+#if defined(DEFERRED_RENDERING)
+	const RenderGraph::ResourceHandle gBuffer[] =
+	{
+		importTexture("GBufferAlbedo", Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM, State::GE_RS_SHADER_READ),
+		importTexture("GBufferNormal", Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT, State::GE_RS_SHADER_READ),
+		importTexture("GBufferMaterial", Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM, State::GE_RS_SHADER_READ),
+		importTexture("GBufferDepth", Texture::TextureFormat::GE_TF_D32, State::GE_RS_SHADER_READ)
+	};
+#endif // DEFERRED_RENDERING
+
+	// in the pass type order, see mVisualPassMap
+	auto& offscreen = mFrameGraphPasses[VisualPass::PassType::GE_PT_OFFSCREEN];
+	offscreen.pass = mFrameGraph.AddPass("Offscreen");
+	offscreen.attachments = { offscreenColor, offscreenDepth };
+	mFrameGraph.Write(offscreen.pass, offscreenColor, State::GE_RS_COLOR_ATTACHMENT);
+	mFrameGraph.Write(offscreen.pass, offscreenDepth, State::GE_RS_DEPTH_ATTACHMENT);
+
+#if defined(SHADOW_CACHING)
+	// the cache is copied to the shadow map before the shadow pass, see DrawShadowCache()
+	const auto shadowCacheCopy = mFrameGraph.AddPass("ShadowCacheCopy");
+	mFrameGraph.Write(shadowCacheCopy, shadowMap, State::GE_RS_TRANSFER_DST);
+#endif // SHADOW_CACHING
+
+	auto& shadows = mFrameGraphPasses[VisualPass::PassType::GE_PT_SHADOWS];
+	shadows.pass = mFrameGraph.AddPass("Shadows");
+	shadows.attachments = { shadowMap };
+#if defined(SHADOW_CACHING)
+	// the dynamic casters are drawn on top of the cache
+	mFrameGraph.Read(shadows.pass, shadowMap, State::GE_RS_DEPTH_ATTACHMENT);
+#endif // SHADOW_CACHING
+	mFrameGraph.Write(shadows.pass, shadowMap, State::GE_RS_DEPTH_ATTACHMENT);
+
+#if defined(DEFERRED_RENDERING)
+	auto& gBufferPass = mFrameGraphPasses[VisualPass::PassType::GE_PT_GBUFFER];
+	gBufferPass.pass = mFrameGraph.AddPass("GBuffer");
+	gBufferPass.attachments.assign(std::begin(gBuffer), std::end(gBuffer));
+	mFrameGraph.Write(gBufferPass.pass, gBuffer[0], State::GE_RS_COLOR_ATTACHMENT);
+	mFrameGraph.Write(gBufferPass.pass, gBuffer[1], State::GE_RS_COLOR_ATTACHMENT);
+	mFrameGraph.Write(gBufferPass.pass, gBuffer[2], State::GE_RS_COLOR_ATTACHMENT);
+	mFrameGraph.Write(gBufferPass.pass, gBuffer[3], State::GE_RS_DEPTH_ATTACHMENT);
+#endif // DEFERRED_RENDERING
+
+	// the forward nodes and the deferred lighting passes
+	auto& standard = mFrameGraphPasses[VisualPass::PassType::GE_PT_STANDARD];
+	standard.pass = mFrameGraph.AddPass("Standard");
+	standard.attachments = { swapchain, depth };
+	mFrameGraph.Read(standard.pass, offscreenColor, State::GE_RS_SHADER_READ);
+	mFrameGraph.Read(standard.pass, shadowMap, State::GE_RS_SHADER_READ);
+#if defined(DEFERRED_RENDERING)
+	for (auto gBufferTexture : gBuffer)
+	{
+		mFrameGraph.Read(standard.pass, gBufferTexture, State::GE_RS_SHADER_READ);
+	}
+#endif // DEFERRED_RENDERING
+	mFrameGraph.Write(standard.pass, swapchain, State::GE_RS_COLOR_ATTACHMENT);
+	mFrameGraph.Write(standard.pass, depth, State::GE_RS_DEPTH_ATTACHMENT);
+
+	if (false == mFrameGraph.Compile())
+	{
+		LOG_ERROR("Invalid frame graph!");
+	}
+}
+
+// the barrier of a texture in the barriers of a pass, nullptr if none
+static const RenderGraph::Barrier* FindFrameGraphBarrier(const std::vector<RenderGraph::Barrier>& barriers, RenderGraph::ResourceHandle texture)
+{
+	for (const auto& barrier : barriers)
+	{
+		if (barrier.resource == texture)
+			return &barrier;
+	}
+
+	return nullptr;
+}
+
+void VulkanRenderer::SetupFrameGraphAttachment(VisualPass::PassType passType, uint32_t attachmentIdx, bool_t isDepth, VkAttachmentDescription& attachmentOut,
+	VkAttachmentReference& referenceOut, VkSubpassDependency& srcDependencyInOut, VkSubpassDependency& dstDependencyInOut) const
+{
+	assert(mFrameGraph.IsCompiled());
+
+	auto it = mFrameGraphPasses.find(passType);
+	assert(it != mFrameGraphPasses.end());
+
+	const auto& frameGraphPass = it->second;
+	assert(attachmentIdx < frameGraphPass.attachments.size());
+
+	const auto texture = frameGraphPass.attachments[attachmentIdx];
+
+	// every write has a barrier, it gives the state before the pass and the one of the attachment
+	const auto* pBarrier = FindFrameGraphBarrier(mFrameGraph.GetBarriers(frameGraphPass.pass), texture);
+	assert(pBarrier != nullptr);
+
+	// the state of the next use, this frame or the final state
+	RenderGraph::ResourceState nextState = pBarrier->newState;
+	const RenderGraph::Barrier* pNextBarrier = nullptr;
+
+	const auto& passOrder = mFrameGraph.GetPassOrder();
+	auto orderIt = std::find(passOrder.begin(), passOrder.end(), frameGraphPass.pass);
+	assert(orderIt != passOrder.end());
+
+	for (++orderIt; (orderIt != passOrder.end()) && (nullptr == pNextBarrier); ++orderIt)
+	{
+		pNextBarrier = FindFrameGraphBarrier(mFrameGraph.GetBarriers(*orderIt), texture);
+	}
+	if (nullptr == pNextBarrier)
+	{
+		pNextBarrier = FindFrameGraphBarrier(mFrameGraph.GetFinalBarriers(), texture);
+	}
+	if (pNextBarrier)
+	{
+		nextState = pNextBarrier->newState;
+	}
+
+	VkImageLayout oldLayout, layout, nextLayout;
+	VkAccessFlags oldAccessMask, accessMask, nextAccessMask;
+	VkPipelineStageFlags oldStageMask, stageMask, nextStageMask;
+	VulkanUtils::RenderGraphStateToVulkanState(pBarrier->oldState, isDepth, oldLayout, oldAccessMask, oldStageMask);
+	VulkanUtils::RenderGraphStateToVulkanState(pBarrier->newState, isDepth, layout, accessMask, stageMask);
+	VulkanUtils::RenderGraphStateToVulkanState(nextState, isDepth, nextLayout, nextAccessMask, nextStageMask);
+
+	// the next render pass transitions its attachments itself, the other uses (sampling, copy, present) are transitioned here
+	const bool_t isNextAttachment = (nextState == RenderGraph::ResourceState::GE_RS_COLOR_ATTACHMENT) ||
+		(nextState == RenderGraph::ResourceState::GE_RS_DEPTH_ATTACHMENT) || (nextState == RenderGraph::ResourceState::GE_RS_DEPTH_READ);
+
+	attachmentOut.samples = MIN_NUM_SAMPLES; // use at least 1 sample
+	// the discarded attachments are cleared, the others keep the contents of the previous pass (e.g. the shadow cache)
+	attachmentOut.loadOp = (pBarrier->isDiscard ? VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_CLEAR : VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_LOAD);
+	attachmentOut.storeOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_STORE;
+	attachmentOut.stencilLoadOp = VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_DONT_CARE; // we don't care about stencil
+	attachmentOut.stencilStoreOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	attachmentOut.initialLayout = (pBarrier->isDiscard ? VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED : oldLayout);
+	attachmentOut.finalLayout = (isNextAttachment ? layout : nextLayout);
+
+	referenceOut.attachment = attachmentIdx;
+	referenceOut.layout = layout;
+
+	// the previous use is done before the attachment is written, the attachment is written before the next use
+	srcDependencyInOut.srcStageMask |= oldStageMask;
+	srcDependencyInOut.srcAccessMask |= oldAccessMask;
+	srcDependencyInOut.dstStageMask |= stageMask;
+	srcDependencyInOut.dstAccessMask |= accessMask;
+
+	dstDependencyInOut.srcStageMask |= stageMask;
+	dstDependencyInOut.srcAccessMask |= accessMask;
+	dstDependencyInOut.dstStageMask |= nextStageMask;
+	dstDependencyInOut.dstAccessMask |= nextAccessMask;
+}
+
 VulkanRenderPass* VulkanRenderer::SetupRenderPass(VisualPass* pVisualPass)
 {
 	assert(pVisualPass != nullptr);
@@ -287,12 +555,15 @@ VulkanRenderPass* VulkanRenderer::SetupRenderPass(VisualPass* pVisualPass)
 		- 1 color attachement
 		- 1 depth + stencil attachment
 		- 1 subpass
+		The layouts, the load ops and the external dependencies come from the frame graph, see SetupFrameGraph()
 	*/
 
 	VulkanRenderPass* pRenderPass = nullptr;
 
+	const auto passType = pVisualPass->GetPassType();
+
 	VkFormat colorFormat, depthFormat;
-	switch (pVisualPass->GetPassType())
+	switch (passType)
 	{
 		case VisualPass::PassType::GE_PT_STANDARD:
 		{
@@ -314,6 +585,7 @@ VulkanRenderPass* VulkanRenderer::SetupRenderPass(VisualPass* pVisualPass)
 			}
 		} break;
 		case VisualPass::PassType::GE_PT_SHADOWS:
+		case VisualPass::PassType::GE_PT_GBUFFER:
 		{
 			auto* pDepthRT = pVisualPass->GetRenderTarget(RenderTarget::TargetType::GE_TT_DEPTH);
 			if (pDepthRT)
@@ -328,38 +600,33 @@ VulkanRenderPass* VulkanRenderer::SetupRenderPass(VisualPass* pVisualPass)
 			return pRenderPass;
 	}
 
-	if (pVisualPass->GetPassType() == VisualPass::PassType::GE_PT_STANDARD ||
-		pVisualPass->GetPassType() == VisualPass::PassType::GE_PT_OFFSCREEN)
+	if (mFrameGraphPasses.find(passType) == mFrameGraphPasses.end())
 	{
-		VkAttachmentDescription colorAttachment{};
-		colorAttachment.format = colorFormat;
-		colorAttachment.samples = MIN_NUM_SAMPLES; // use at least 1 sample
-		colorAttachment.loadOp = VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_CLEAR; //clear color attachment on new frame
-		colorAttachment.storeOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_STORE; //store the color attachment in memory
-		colorAttachment.stencilLoadOp = VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_DONT_CARE; //color att, so we don't care avout the stencil op
-		colorAttachment.stencilStoreOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_DONT_CARE; //color att, so we don't care avout the stencil op
-		colorAttachment.initialLayout = VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED; // we don't care of the previous layout the image was in
-		// the image needs to be presented to the swapchain or read from the shader
-		colorAttachment.finalLayout = (pVisualPass->GetPassType() == VisualPass::PassType::GE_PT_STANDARD ?
-			VkImageLayout::VK_IMAGE_LAYOUT_PRESENT_SRC_KHR : VkImageLayout::VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		LOG_ERROR("The visual pass type is not in the frame graph!");
+		return pRenderPass;
+	}
 
-		VkAttachmentDescription depthStencilAttachment{};
-		depthStencilAttachment.format = depthFormat;
-		depthStencilAttachment.samples = MIN_NUM_SAMPLES; // use at least 1 sample
-		depthStencilAttachment.loadOp = VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_CLEAR; //clear depth attachement on new frame
-		depthStencilAttachment.storeOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_STORE; //store the depth attachment on new frame
-		depthStencilAttachment.stencilLoadOp = VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_DONT_CARE; // we don't care about stencil, only depth
-		depthStencilAttachment.stencilStoreOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_DONT_CARE; // we don't care about stencil, only depth
-		depthStencilAttachment.initialLayout = VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;  // we don't care of the previous layout the image was in
-		depthStencilAttachment.finalLayout = VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL; // we just need depth/stencil buffer without sampling it in shader
+	// the attachments add their stages and accesses
+	VkSubpassDependency srcDependency{};
+	srcDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+	srcDependency.dstSubpass = SUBPASS_ID;
+
+	VkSubpassDependency dstDependency{};
+	dstDependency.srcSubpass = SUBPASS_ID;
+	dstDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
 
+	if (passType == VisualPass::PassType::GE_PT_STANDARD ||
+		passType == VisualPass::PassType::GE_PT_OFFSCREEN)
+	{
+		VkAttachmentDescription colorAttachment{};
 		VkAttachmentReference colorReference;
-		colorReference.attachment = COLOR_ATT;
-		colorReference.layout = VkImageLayout::VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		colorAttachment.format = colorFormat;
+		SetupFrameGraphAttachment(passType, COLOR_ATT, false, colorAttachment, colorReference, srcDependency, dstDependency);
 
+		VkAttachmentDescription depthStencilAttachment{};
 		VkAttachmentReference depthStencilReference;
-		depthStencilReference.attachment = DEPTH_ATT;
-		depthStencilReference.layout = VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		depthStencilAttachment.format = depthFormat;
+		SetupFrameGraphAttachment(passType, DEPTH_ATT, true, depthStencilAttachment, depthStencilReference, srcDependency, dstDependency);
 
 		// subPasses
 		VkSubpassDescription subPass{};
@@ -368,60 +635,14 @@ VulkanRenderPass* VulkanRenderer::SetupRenderPass(VisualPass* pVisualPass)
 		subPass.pColorAttachments = &colorReference;
 		subPass.pDepthStencilAttachment = &depthStencilReference;
 
-		VkSubpassDependency subPassDep_1;
-		subPassDep_1.srcSubpass = VK_SUBPASS_EXTERNAL;
-		subPassDep_1.dstSubpass = SUBPASS_ID;
-
-		VkSubpassDependency subPassDep_2;
-		subPassDep_2.srcSubpass = SUBPASS_ID;
-		subPassDep_2.dstSubpass = VK_SUBPASS_EXTERNAL;
-
-		if (pVisualPass->GetPassType() == VisualPass::PassType::GE_PT_STANDARD)
-		{
-			subPassDep_1.srcStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-			subPassDep_1.dstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-			subPassDep_1.srcAccessMask = VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT;
-			subPassDep_1.dstAccessMask = VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-			subPassDep_1.dependencyFlags = VkDependencyFlagBits::VK_DEPENDENCY_BY_REGION_BIT;
-
-			subPassDep_2.srcStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-			subPassDep_2.dstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-			subPassDep_2.srcAccessMask = VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-			subPassDep_2.dstAccessMask = VkAccessFlagBits::VK_ACCESS_MEMORY_READ_BIT;
-			subPassDep_2.dependencyFlags = VkDependencyFlagBits::VK_DEPENDENCY_BY_REGION_BIT;
-		}
-		else  // offscreen
-		{
-			subPassDep_1.srcStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-			subPassDep_1.dstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-			subPassDep_1.srcAccessMask = VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT;
-			subPassDep_1.dstAccessMask = VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-			subPassDep_1.dependencyFlags = VkDependencyFlagBits::VK_DEPENDENCY_BY_REGION_BIT;
-
-			subPassDep_2.srcStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-			subPassDep_2.dstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-			subPassDep_2.srcAccessMask = VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-			subPassDep_2.dstAccessMask = VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT;
-			subPassDep_2.dependencyFlags = VkDependencyFlagBits::VK_DEPENDENCY_BY_REGION_BIT;
-		}
-
-		pRenderPass = GE_ALLOC(VulkanRenderPass)(mpDevice, { colorAttachment, depthStencilAttachment }, { subPass }, { subPassDep_1, subPassDep_2 });
+		pRenderPass = GE_ALLOC(VulkanRenderPass)(mpDevice, { colorAttachment, depthStencilAttachment }, { subPass }, { srcDependency, dstDependency });
 	}
-	else if (pVisualPass->GetPassType() == VisualPass::PassType::GE_PT_SHADOWS)
+	else if (passType == VisualPass::PassType::GE_PT_SHADOWS)
 	{
 		VkAttachmentDescription depthStencilAttachment{};
-		depthStencilAttachment.format = depthFormat;
-		depthStencilAttachment.samples = MIN_NUM_SAMPLES; // use at least 1 sample
-		depthStencilAttachment.loadOp = VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_CLEAR; //clear depth attachement on new frame
-		depthStencilAttachment.storeOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_STORE; //store the depth attachment on new frame
-		depthStencilAttachment.stencilLoadOp = VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_DONT_CARE; // we don't care about stencil, only depth
-		depthStencilAttachment.stencilStoreOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_DONT_CARE; // we don't care about stencil, only depth
-		depthStencilAttachment.initialLayout = VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED;  // we don't care of the previous layout the image was in
-		depthStencilAttachment.finalLayout = VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL; // Attachment will be transitioned to shader read at render pass end
-
 		VkAttachmentReference depthStencilReference;
-		depthStencilReference.attachment = 0; //TODO
-		depthStencilReference.layout = VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		depthStencilAttachment.format = depthFormat;
+		SetupFrameGraphAttachment(passType, 0, true, depthStencilAttachment, depthStencilReference, srcDependency, dstDependency);
 
 		// subPasses
 		VkSubpassDescription subPass{};
@@ -430,27 +651,47 @@ VulkanRenderPass* VulkanRenderer::SetupRenderPass(VisualPass* pVisualPass)
 		subPass.pColorAttachments = nullptr;
 		subPass.pDepthStencilAttachment = &depthStencilReference;
 
-		VkSubpassDependency subPassDep_1;
-		subPassDep_1.srcSubpass = VK_SUBPASS_EXTERNAL;
-		subPassDep_1.dstSubpass = SUBPASS_ID;
+		pRenderPass = GE_ALLOC(VulkanRenderPass)(mpDevice, { depthStencilAttachment }, { subPass }, { srcDependency, dstDependency });
+	}
+	else if (passType == VisualPass::PassType::GE_PT_GBUFFER)
+	{
+		// albedo, normal, material color attachments + depth, all sampled later by the lighting passes
+		const RenderTarget::TargetType colorTypes[] =
+		{
+			RenderTarget::TargetType::GE_TT_COLOR, RenderTarget::TargetType::GE_TT_COLOR_1, RenderTarget::TargetType::GE_TT_COLOR_2
+		};
+		const uint32_t colorCount = static_cast<uint32_t>(sizeof(colorTypes) / sizeof(colorTypes[0]));
+
+		std::vector<VkAttachmentDescription> attachments;
+		std::vector<VkAttachmentReference> colorReferences;
+		for (uint32_t i = 0; i < colorCount; ++i)
+		{
+			auto* pColorRT = pVisualPass->GetRenderTarget(colorTypes[i]);
+			assert(pColorRT != nullptr);
+
+			VkAttachmentDescription colorAttachment{};
+			VkAttachmentReference colorReference;
+			colorAttachment.format = VulkanUtils::TextureFormatToVulkanFormat(pColorRT->GetTexture()->GetMetaData().format);
+			SetupFrameGraphAttachment(passType, i, false, colorAttachment, colorReference, srcDependency, dstDependency);
 
-		subPassDep_1.srcStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-		subPassDep_1.dstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-		subPassDep_1.srcAccessMask = VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT;
-		subPassDep_1.dstAccessMask = VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-		subPassDep_1.dependencyFlags = VkDependencyFlagBits::VK_DEPENDENCY_BY_REGION_BIT;
+			attachments.push_back(colorAttachment);
+			colorReferences.push_back(colorReference);
+		}
 
-		VkSubpassDependency subPassDep_2;
-		subPassDep_2.srcSubpass = SUBPASS_ID;
-		subPassDep_2.dstSubpass = VK_SUBPASS_EXTERNAL;
+		VkAttachmentDescription depthStencilAttachment{};
+		VkAttachmentReference depthStencilReference;
+		depthStencilAttachment.format = depthFormat;
+		SetupFrameGraphAttachment(passType, colorCount, true, depthStencilAttachment, depthStencilReference, srcDependency, dstDependency);
+		attachments.push_back(depthStencilAttachment);
 
-		subPassDep_2.srcStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-		subPassDep_2.dstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-		subPassDep_2.srcAccessMask = VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-		subPassDep_2.dstAccessMask = VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT;
-		subPassDep_2.dependencyFlags = VkDependencyFlagBits::VK_DEPENDENCY_BY_REGION_BIT;
+		// subPasses
+		VkSubpassDescription subPass{};
+		subPass.pipelineBindPoint = VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subPass.colorAttachmentCount = colorCount;
+		subPass.pColorAttachments = colorReferences.data();
+		subPass.pDepthStencilAttachment = &depthStencilReference;
 
-		pRenderPass = GE_ALLOC(VulkanRenderPass)(mpDevice, { depthStencilAttachment }, { subPass }, { subPassDep_1, subPassDep_2 });
+		pRenderPass = GE_ALLOC(VulkanRenderPass)(mpDevice, attachments, { subPass }, { srcDependency, dstDependency });
 	}
 
 	assert(pRenderPass != nullptr);
@@ -627,6 +868,51 @@ void VulkanRenderer::SetupFrameBuffers(VisualPass* pVisualPass, VulkanRenderPass
 				assert(frameBuffersOut[i] != nullptr);
 			}
 		} break;
+		case VisualPass::PassType::GE_PT_GBUFFER:
+		{
+			// in the attachment order of the render pass: albedo, normal, material, depth
+			const RenderTarget::TargetType targetTypes[] =
+			{
+				RenderTarget::TargetType::GE_TT_COLOR, RenderTarget::TargetType::GE_TT_COLOR_1,
+				RenderTarget::TargetType::GE_TT_COLOR_2, RenderTarget::TargetType::GE_TT_DEPTH
+			};
+
+			assert(pVisualPass->GetRenderTargets().size() == (sizeof(targetTypes) / sizeof(targetTypes[0])));
+
+			for (auto targetType : targetTypes)
+			{
+				auto* pRT = Get(pVisualPass->GetRenderTarget(targetType));
+				assert(pRT != nullptr);
+
+				frameBufferAttachments.push_back(pRT->GetVkImageView()->GetHandle());
+			}
+
+			// get RT width and height for the framebuffer size
+			auto* pAlbedoRT = Get(pVisualPass->GetRenderTarget(RenderTarget::TargetType::GE_TT_COLOR));
+			const auto& extent3D = pAlbedoRT->GetVkImage()->GetData().extent;
+
+			assert(extent3D.width > 0);
+			assert(extent3D.height > 0);
+
+			extent.width = extent3D.width;
+			extent.height = extent3D.height;
+
+			visualPassBeginDataOut.width = extent.width;
+			visualPassBeginDataOut.height = extent.height;
+			visualPassBeginDataOut.depth = 1.0f;
+			visualPassBeginDataOut.stencil = 0;
+
+			frameBuffersOut.resize(1);
+			frameBuffersOut[0] = GE_ALLOC(VulkanFrameBuffer)
+				(
+					mpDevice,
+					pRenderPass,
+					frameBufferAttachments,
+					extent.width,
+					extent.height
+					);
+			assert(frameBuffersOut[0] != nullptr);
+		} break;
 		case VisualPass::PassType::GE_PT_COUNT:
 		default:
 			LOG_ERROR("Invalid visual pass type!");
@@ -654,6 +940,14 @@ void VulkanRenderer::SetupSynchronizationPrimitives()
 		fence = GE_ALLOC(VulkanFence)(mpDevice, VkFenceCreateFlagBits::VK_FENCE_CREATE_SIGNALED_BIT);
 		assert(fence != nullptr);
 	}
+
+	// Submissions (Used to submit the frame work to the queues)
+	mFrameSubmissions.resize(mDrawCommandBuffers.size());
+	for (auto& submission : mFrameSubmissions)
+	{
+		submission = GE_ALLOC(VulkanSubmission)(mpDevice);
+		assert(submission != nullptr);
+	}
 }
 
 void VulkanRenderer::SetupPipelineCache()
@@ -664,29 +958,6 @@ void VulkanRenderer::SetupPipelineCache()
 	assert(mpPipelineCache != nullptr);
 }
 
-void VulkanRenderer::SetupSubmitInfo()
-{
-	assert(mDrawCommandBuffers.size() > 0);
-	assert(mCurrentBufferIdx < mDrawCommandBuffers.size());
-	assert(mpPresentCompleteSemaphore != nullptr);
-	assert(mpRenderCompleteSemaphore != nullptr);
-
-	auto pCrrDrawCommandBuffer = mDrawCommandBuffers[mCurrentBufferIdx];
-	assert(pCrrDrawCommandBuffer != nullptr);
-
-	/** @brief Pipeline stages used to wait at for graphics queue submissions */
-	mSubmitPipelineStages = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-
-	// The submit info structure specifices a command buffer queue submission batch
-	mSubmitInfo = VulkanInitializers::SubmitInfo
-	(
-		1, &pCrrDrawCommandBuffer->GetHandle(),
-		1, &mpPresentCompleteSemaphore->GetHandle(),
-		&mSubmitPipelineStages,
-		1, &mpRenderCompleteSemaphore->GetHandle()
-	);
-}
-
 void VulkanRenderer::SetupPipelineStats()
 {
 #ifdef PIPELINE_STATS
@@ -755,7 +1026,8 @@ void VulkanRenderer::GetQueryResults()
 			queryData.pQueryPool->GetQueryResults(1, queryData.pipelineStats.data(), count * sizeof(uint64_t), sizeof(uint64_t), flags);
 
 			// log query stats
-			std::string passTypeStr = (passType == VisualPass::PassType::GE_PT_SHADOWS ? "SHADOW" : (passType == VisualPass::PassType::GE_PT_OFFSCREEN ? "OFFSCREEN" : "STANDARD"));
+			std::string passTypeStr = (passType == VisualPass::PassType::GE_PT_SHADOWS ? "SHADOW" : (passType == VisualPass::PassType::GE_PT_OFFSCREEN ? "OFFSCREEN" :
+				(passType == VisualPass::PassType::GE_PT_GBUFFER ? "GBUFFER" : "STANDARD")));
 			LOG_INFO("Render pass: %s", passTypeStr.c_str());
 			LOG_INFO("####### Pipeline Stats ########");
 			for (uint32_t i = 0; i < queryData.pipelineStats.size(); ++i)
@@ -831,8 +1103,86 @@ void VulkanRenderer::EndQuery(VisualPass::PassType passType, uint32_t currentBuf
  #endif
 }
 
+void VulkanRenderer::SetupTimestampQueries()
+{
+	assert(mpDevice != nullptr);
+
+	auto pQueue = mpDevice->GetGraphicsQueue();
+	assert(pQueue != nullptr);
+
+	// no timestamp support on this queue
+	const uint32_t validBits = mpDevice->GetQueueFamilyPropertiesVector()[pQueue->GetFamilyIndex()].timestampValidBits;
+	if (validBits == 0)
+		return;
+
+	mTimestampMask = (validBits >= 64) ? UINT64_MAX : ((1ull << validBits) - 1);
+
+	mTimestampPassTypes.clear();
+	for (auto& it : mVisualPassMap)
+	{
+		mTimestampPassTypes.push_back(it.first);
+	}
+
+	const uint32_t queryCount = GPUTimings::GetQueryCount(static_cast<uint32_t>(mTimestampPassTypes.size()));
+	if ((nullptr == mpTimestampQueryPool) || (queryCount != mTimestampQueryCount))
+	{
+		GE_FREE(mpTimestampQueryPool);
+
+		mTimestampQueryCount = queryCount;
+		mpTimestampQueryPool = GE_ALLOC(VulkanQueryPool)
+			(
+				mpDevice,
+				VkQueryType::VK_QUERY_TYPE_TIMESTAMP,
+				mTimestampQueryCount * static_cast<uint32_t>(mDrawCommandBuffers.size()),
+				0
+			);
+		assert(mpTimestampQueryPool != nullptr);
+	}
+
+	// the command buffers are recorded again
+	mTimestampSubmitTimes.assign(mDrawCommandBuffers.size(), 0);
+	mTimestamps.resize(mTimestampQueryCount);
+	mGPUTimings.Reset();
+}
+
+void VulkanRenderer::WriteTimestamp(VkPipelineStageFlagBits pipelineStage, uint32_t query, uint32_t currentBufferIdx)
+{
+	if (nullptr == mpTimestampQueryPool)
+		return;
+
+	assert(currentBufferIdx < mDrawCommandBuffers.size());
+	assert(query < mTimestampQueryCount);
+
+	mpTimestampQueryPool->WriteTimestamp(mDrawCommandBuffers[currentBufferIdx]->GetHandle(), pipelineStage, currentBufferIdx * mTimestampQueryCount + query);
+}
+
+void VulkanRenderer::ReadTimestampQueries(uint32_t currentBufferIdx)
+{
+	if ((nullptr == mpTimestampQueryPool) || (0 == mTimestampSubmitTimes[currentBufferIdx]))
+		return;
+
+	assert(mpDevice != nullptr);
+
+	// NOTE! No VK_QUERY_RESULT_WAIT_BIT, the results of a command buffer are read once its fence is signaled
+	VkResult res = mpTimestampQueryPool->GetQueryResults(currentBufferIdx * mTimestampQueryCount, mTimestampQueryCount,
+		mTimestamps.data(), mTimestamps.size() * sizeof(uint64_t), sizeof(uint64_t), VkQueryResultFlagBits::VK_QUERY_RESULT_64_BIT);
+	if (res != VkResult::VK_SUCCESS)
+		return;
+
+	// ticks to ns
+	const float64_t timestampPeriod = mpDevice->GetPhysicalDeviceProperties().limits.timestampPeriod;
+	for (auto& timestamp : mTimestamps)
+	{
+		timestamp = static_cast<uint64_t>((timestamp & mTimestampMask) * timestampPeriod);
+	}
+
+	mGPUTimings.Update(mTimestamps, mTimestampPassTypes, mTimestampSubmitTimes[currentBufferIdx]);
+}
+
 void VulkanRenderer::RenderFrame(RenderQueue* pRenderQueue)
 {
+	GE_PROFILE_FUNCTION();
+
 	if (false == mIsPrepared)
 		return;
 
@@ -847,6 +1197,8 @@ void VulkanRenderer::RenderFrame(RenderQueue* pRenderQueue)
 
 void VulkanRenderer::UpdateFrame(Camera* pCamera, float32_t crrTime)
 {
+	GE_PROFILE_FUNCTION();
+
 	if (false == mIsPrepared)
 		return;
 
@@ -855,6 +1207,47 @@ void VulkanRenderer::UpdateFrame(Camera* pCamera, float32_t crrTime)
 	assert(pCamera != nullptr);
 	mpCamera = pCamera;
 
+	// the transient data of the previous frames is released here
+	mFrameAllocator.BeginFrame();
+
+#if defined(CLUSTERED_LIGHTING)
+	UpdateLightClusters(pCamera);
+	UploadLightClusters();
+#endif // CLUSTERED_LIGHTING
+
+	// the command buffers are recorded upfront, they are recorded again when a node they don't draw becomes visible or the levels change
+	bool_t isRecordingDirty = false;
+
+#if defined(SCENE_CULLING)
+	isRecordingDirty = UpdateSceneCulling(pCamera) || isRecordingDirty;
+#endif // SCENE_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+	isRecordingDirty = UpdateLODs(pCamera) || isRecordingDirty;
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+	// the instances of a caster are its cascades
+	isRecordingDirty = UpdateShadowCascades(pCamera) || isRecordingDirty;
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+	// the dirty faces of the cache are drawn by the recorded frame only, the next recording draws the clean cache
+	isRecordingDirty = UpdateShadowCache() || isRecordingDirty;
+#endif // SHADOW_CACHING
+
+#if defined(GPU_CULLING)
+	// the culled draws are recorded once, only the frame data changes
+	UpdateGPUCulling(pCamera);
+#endif // GPU_CULLING
+
+	if (isRecordingDirty)
+	{
+		mpDevice->WaitIdle();
+
+		DrawSceneToCommandBuffer();
+	}
+
 	UpdateNodes(pCamera, crrTime);
 }
 
@@ -870,6 +1263,8 @@ void VulkanRenderer::EndFrame()
 
 void VulkanRenderer::SubmitFrame()
 {
+	GE_PROFILE_FUNCTION();
+
 	// HERE THE FRAME IS JUST SUBMITED TO THE GRAPHICS QUEUE
 	// THE IMAGE IS PRESENTED TO THE SWAPCHAIN
 	// THE ACTUAL RENDERING IS DONE WHEN THE COMMAND BUFFER IS BUILT/ALL COMMANDS RECORDED
@@ -890,19 +1285,39 @@ void VulkanRenderer::SubmitFrame()
 	assert(pCrrDrawCommandBuffer != nullptr);
 	auto pCrrWaitFence = mWaitFences[mCurrentBufferIdx];
 	assert(pCrrWaitFence != nullptr);
-
-	auto pQueue = mpDevice->GetGraphicsQueue();
-	assert(pQueue != nullptr);
+	auto pCrrSubmission = mFrameSubmissions[mCurrentBufferIdx];
+	assert(pCrrSubmission != nullptr);
 
 	// Use a fence to wait until the command buffer has finished execution before using it again
 	VK_CHECK_RESULT(pCrrWaitFence->WaitIdle(VK_TRUE, UINT64_MAX));
 	VK_CHECK_RESULT(pCrrWaitFence->Reset());
 
-	// account for the new value of mCurrentBufferIdx
-	mSubmitInfo.pCommandBuffers = &pCrrDrawCommandBuffer->GetHandle();
+	// the previous submission of this command buffer is done, its timestamps are available
+	ReadTimestampQueries(mCurrentBufferIdx);
+
+#if defined(GPU_CULLING)
+	ValidateGPUCulling(mCurrentBufferIdx);
+	UploadGPUCulling(mCurrentBufferIdx);
+#endif // GPU_CULLING
+
+	// the previous submission of this command buffer is done, its semaphores can be reused
+	pCrrSubmission->Reset();
+
+	uint32_t graphicsBatchIdx = pCrrSubmission->AddBatch(VulkanLogicalDevice::QueueType::GE_QT_GRAPHICS, { pCrrDrawCommandBuffer->GetHandle() });
+#if !defined(USE_HEADLESS)
+	// no presentation engine to synchronize with in headless mode
+	pCrrSubmission->AddWaitSemaphore(graphicsBatchIdx, mpPresentCompleteSemaphore->GetHandle(), VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+	pCrrSubmission->AddSignalSemaphore(graphicsBatchIdx, mpRenderCompleteSemaphore->GetHandle());
+#endif // USE_HEADLESS
+	pCrrSubmission->SetFence(graphicsBatchIdx, pCrrWaitFence->GetHandle());
 
-	// Submit to the graphics queue
-	VK_CHECK_RESULT(pQueue->Submit(1, &mSubmitInfo, pCrrWaitFence->GetHandle()));
+	if (mpTimestampQueryPool)
+	{
+		mTimestampSubmitTimes[mCurrentBufferIdx] = Profiler::GetTime();
+	}
+
+	// Submit to the queues
+	VK_CHECK_RESULT(pCrrSubmission->Submit());
 
 	// Present the current buffer to the swap chain
 	// Pass the semaphore signaled by the command buffer submission from the submit info as the wait semaphore for swap chain presentation
@@ -934,6 +1349,14 @@ void VulkanRenderer::PresentFrame()
 	assert(mpDevice != nullptr);
 	assert(mpRenderCompleteSemaphore != nullptr);
 
+#if defined(USE_HEADLESS)
+	// nothing to present, the frame stays in the offscreen image until ReadFrame()
+	auto pGraphicsQueue = mpDevice->GetGraphicsQueue();
+	assert(pGraphicsQueue != nullptr);
+
+	// wait until queue is idle
+	VK_CHECK_RESULT(pGraphicsQueue->WaitIdle());
+#else
 	// Return the image to the swap chain for presentation
 	VkPresentInfoKHR presentInfo = 
 		VulkanInitializers::PresentInfo(1, &mpDevice->GetSwapChainHandle(), 1, &mpRenderCompleteSemaphore->GetHandle(), &mCurrentBufferIdx);
@@ -968,10 +1391,102 @@ void VulkanRenderer::PresentFrame()
 	}
 	// wait until queue is idle
 	VK_CHECK_RESULT(pQueue->WaitIdle());
+#endif // USE_HEADLESS
+}
+
+bool_t VulkanRenderer::ReadFrame(std::vector<uint8_t>& pixelsOut)
+{
+	GE_PROFILE_FUNCTION();
+
+	if (false == mIsPrepared)
+		return false;
+
+	assert(mpDevice != nullptr);
+
+#if defined(USE_HEADLESS)
+	assert(mpCommandPool != nullptr);
+
+	auto& colorBuffers = mpDevice->GetSwapChainColorBuffers();
+	assert(mCurrentBufferIdx < colorBuffers.size());
+
+	auto pColorBuffer = colorBuffers[mCurrentBufferIdx];
+	assert(pColorBuffer != nullptr);
+
+	const VkExtent2D& extent = mpDevice->GetSurfaceCapabilities().currentExtent;
+	const VkFormat format = mpDevice->GetSurfaceFormat().format;
+
+	// NOTE! The surface formats are 4 bytes per pixel
+	const VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+
+	// kept between frames, recreated on resize
+	if ((mpReadBackBuffer == nullptr) || (mpReadBackBuffer->GetSize() != size))
+	{
+		GE_FREE(mpReadBackBuffer);
+
+		mpReadBackBuffer = GE_ALLOC(VulkanBuffer)
+		(
+			mpDevice,
+			VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			size
+		);
+		assert(mpReadBackBuffer != nullptr);
+	}
+
+	auto pQueue = mpDevice->GetGraphicsQueue();
+	assert(pQueue != nullptr);
+
+	{
+		VulkanCommandBuffer copyCommandBuffer(mpDevice, mpCommandPool->GetHandle(), VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+		VkBufferImageCopy copyRegion{};
+		copyRegion.imageSubresource = { VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		copyRegion.imageExtent = { extent.width, extent.height, 1 };
+
+		// the image is in the final layout of the standard render pass
+		vkCmdCopyImageToBuffer(copyCommandBuffer.GetHandle(), pColorBuffer->GetImageHandle(), VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			mpReadBackBuffer->GetHandle(), 1, &copyRegion);
+
+		// waits for the copy
+		copyCommandBuffer.Flush(pQueue);
+	}
+
+	VK_CHECK_RESULT(mpReadBackBuffer->Map());
+
+	const uint8_t* pSrc = static_cast<const uint8_t*>(mpReadBackBuffer->GetData());
+	assert(pSrc != nullptr);
+
+	pixelsOut.resize(static_cast<size_t>(size));
+
+	const bool_t isBGRA = ((format == VkFormat::VK_FORMAT_B8G8R8A8_UNORM) || (format == VkFormat::VK_FORMAT_B8G8R8A8_SRGB));
+	if (isBGRA)
+	{
+		for (size_t i = 0; i < pixelsOut.size(); i += 4)
+		{
+			pixelsOut[i + 0] = pSrc[i + 2];
+			pixelsOut[i + 1] = pSrc[i + 1];
+			pixelsOut[i + 2] = pSrc[i + 0];
+			pixelsOut[i + 3] = pSrc[i + 3];
+		}
+	}
+	else
+	{
+		std::copy(pSrc, pSrc + pixelsOut.size(), pixelsOut.begin());
+	}
+
+	mpReadBackBuffer->UnMap();
+
+	return true;
+#else
+	// the presented swapchain images belong to the presentation engine
+	return false;
+#endif // USE_HEADLESS
 }
 
 void VulkanRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
 {
+	GE_PROFILE_FUNCTION();
+
 	if (false == mIsPrepared)
 		return;
 
@@ -979,6 +1494,27 @@ void VulkanRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
 
 	mpRenderQueue = pRenderQueue;
 
+#if defined(DEFERRED_RENDERING)
+	// the lighting passes come first in the standard pass, they write the depth the forward nodes are tested against
+	if (GetRendererType() == RendererType::GE_RT_DEFERRED)
+	{
+		CreateLightingEffects();
+
+		for (auto* pEffect : mLightingEffects)
+		{
+			for (auto& it : pEffect->GetPasses())
+			{
+				for (auto* pPass : it.second)
+				{
+					AddVisualPass(pPass);
+				}
+			}
+
+			pEffect->InitPasses(this);
+		}
+	}
+#endif // DEFERRED_RENDERING
+
 	// TODO - compute resources for all renderable types
 	auto& renderableList = mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OPAQUE);
 
@@ -997,7 +1533,7 @@ void VulkanRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
 
 			// we didn't call this earlier as we needed to have
 			// the node info first
-			pVisEffect->Init();
+			pVisEffect->Init(this);
 
 			// TODO - Compute mVisualPasses list of passes in their proper order
 			const auto& passMap = pVisEffect->GetPasses();
@@ -1014,11 +1550,32 @@ void VulkanRenderer::ComputeGraphicsResources(RenderQueue* pRenderQueue)
 		}
 	);
 
-	SetupPipelineStats();
-}
+#if defined(SCENE_CULLING)
+	BuildSceneTree();
+#endif // SCENE_CULLING
 
-void VulkanRenderer::UpdateDynamicStates(VisualPass* pVisualPass, uint32_t currentBufferIdx)
-{
+#if defined(LEVEL_OF_DETAIL)
+	CollectLODNodes();
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+	BuildShadowCasters();
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+	BuildShadowCache();
+	SetupShadowCache();
+#endif // SHADOW_CACHING
+
+#if defined(GPU_CULLING)
+	SetupGPUCulling();
+#endif // GPU_CULLING
+
+	SetupPipelineStats();
+}
+
+void VulkanRenderer::UpdateDynamicStates(VisualPass* pVisualPass, uint32_t currentBufferIdx)
+{
 	assert(pVisualPass != nullptr);
 
 	// update dynamic states if any
@@ -1037,8 +1594,8 @@ void VulkanRenderer::UpdateDynamicStates(VisualPass* pVisualPass, uint32_t curre
 	auto pCrrDrawCommandBuffer = mDrawCommandBuffers[currentBufferIdx];
 	assert(pCrrDrawCommandBuffer != nullptr);
 
-	auto dynStates = dynamicState.GetStates();
-	std::vector<VkDynamicState> dynamicStateEnables;
+	const auto& dynStates = dynamicState.GetStates();
+	StlVector<VkDynamicState> dynamicStateEnables(&mFrameAllocator);
 	dynamicStateEnables.resize(dynStates.size());
 
 	for (size_t i = 0; i < dynamicStateEnables.size(); ++i)
@@ -1095,7 +1652,7 @@ void VulkanRenderer::UpdateUniformBuffers(VisualPass* pVisualPass, GeometryNode*
 	assert(pGeoNode != nullptr);
 	assert(pCamera != nullptr);
 
-	auto shaders = pVisualPass->GetShaders();
+	const auto& shaders = pVisualPass->GetShaders();
 	for (auto iter = shaders.begin(); iter != shaders.end(); ++iter)
 	{
 		auto shaderStage = iter->first;
@@ -1133,10 +1690,35 @@ void VulkanRenderer::UpdateUniformBuffers(VisualPass* pVisualPass, GeometryNode*
 					{
 						uniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_NORMAL_MATRIX4, pVisualPass->GetTransform() * pGeoNode->GetNormalMatrix());
 					} break;
+					case GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4:
+					{
+						uniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4, glm::inverse(pCamera->GetProjectionViewMatrix()));
+					} break;
 					case GLSLShaderTypes::UniformType::GE_UT_CAMERA_POS:
 					{
 						uniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_CAMERA_POS, glm::vec4(pCamera->GetPosition(), 0.0f));
 					} break;
+					case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV0_MATRIX4:
+					case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV1_MATRIX4:
+					case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV2_MATRIX4:
+					case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV3_MATRIX4:
+					{
+#if defined(CASCADED_SHADOWS)
+						// the cascades are fitted to the camera each frame, see UpdateShadowCascades()
+						// NOTE! No bias matrix, the shaders move the cascades to their atlas tiles
+						const uint32_t cascadeIdx = static_cast<uint32_t>(uniformType) - static_cast<uint32_t>(GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV0_MATRIX4);
+						if (cascadeIdx < mShadowCascades.GetCascadeCount())
+						{
+							uniformBuffer->SetUniform(uniformType, mShadowCascades.GetCascade(cascadeIdx).projectionView);
+						}
+#endif // CASCADED_SHADOWS
+					} break;
+					case GLSLShaderTypes::UniformType::GE_UT_CASCADE_SPLITS:
+					{
+#if defined(CASCADED_SHADOWS)
+						uniformBuffer->SetUniform(GLSLShaderTypes::UniformType::GE_UT_CASCADE_SPLITS, mShadowCascades.GetSplits());
+#endif // CASCADED_SHADOWS
+					} break;
 					case GLSLShaderTypes::UniformType::GE_UT_PROJECTION_MATRIX4:
 					case GLSLShaderTypes::UniformType::GE_UT_VIEW_MATRIX4:
 					case GLSLShaderTypes::UniformType::GE_UT_COLOR_VEC4:
@@ -1239,6 +1821,10 @@ void VulkanRenderer::BindLight(VisualPass* pVisualPass, const LightNode* pLightN
 					pUBO->SetUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_PVM_MATRIX4, pLight->GetLightPVM());
 			} break;
 			case Light::LightType::GE_LT_DIRECTIONAL:
+#if defined(CASCADED_SHADOWS)
+				// the cascade matrices are updated each frame, see UpdateUniformBuffers()
+				break;
+#endif // CASCADED_SHADOWS
 			case Light::LightType::GE_LT_SPOT:
 				//TODO
 				break;
@@ -1247,6 +1833,12 @@ void VulkanRenderer::BindLight(VisualPass* pVisualPass, const LightNode* pLightN
 				LOG_ERROR("Invalid light type!");
 			}
 		} break;
+		case VisualPass::PassType::GE_PT_GBUFFER:
+			// the G-buffer pass only writes the surface attributes, the lights are applied by DeferredLightingVisualEffect
+			break;
+		case VisualPass::PassType::GE_PT_COUNT:
+		default:
+			LOG_ERROR("Invalid visual pass type!");
 	}
 }
 
@@ -1256,6 +1848,17 @@ void VulkanRenderer::DrawSceneToCommandBuffer()
 
 	// THE ACTUAL RENDERING IS DONE HERE !!!!
 
+	SetupTimestampQueries();
+
+#if defined(SCENE_CULLING)
+	// the recorded nodes are the visible ones, see IsNodeCulled()
+	SetVisibleNodesRecorded();
+#endif // SCENE_CULLING
+
+#if defined(GPU_CULLING)
+	BuildGPUCullingDraws();
+#endif // GPU_CULLING
+
 	for (uint32_t i = 0; i < mDrawCommandBuffers.size(); ++i)
 	{
 		assert(mDrawCommandBuffers[i] != nullptr);
@@ -1263,8 +1866,20 @@ void VulkanRenderer::DrawSceneToCommandBuffer()
 		// Begin command buffer recording
 		VK_CHECK_RESULT(mDrawCommandBuffers[i]->Begin());
 
+		if (mpTimestampQueryPool)
+		{
+			mpTimestampQueryPool->ResetQuery(mDrawCommandBuffers[i]->GetHandle(), i * mTimestampQueryCount, mTimestampQueryCount);
+		}
+		WriteTimestamp(VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, GPUTimings::FRAME_BEGIN_QUERY, i);
+
+#if defined(GPU_CULLING)
+		DispatchGPUCulling(i);
+#endif // GPU_CULLING
+
 		DrawNodes(i);
 
+		WriteTimestamp(VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, GPUTimings::FRAME_END_QUERY, i);
+
 		// End command buffer recording
 		VK_CHECK_RESULT(mDrawCommandBuffers[i]->End());
 	}
@@ -1272,8 +1887,11 @@ void VulkanRenderer::DrawSceneToCommandBuffer()
 
 void VulkanRenderer::DrawNodes(uint32_t currentBufferIdx)
 {
+	GE_PROFILE_FUNCTION();
+
 	assert(currentBufferIdx < mDrawCommandBuffers.size());
 
+	uint32_t passIndex = 0;
 	for (auto& it : mVisualPassMap)
 	{
 		auto& passType = it.first;
@@ -1283,6 +1901,15 @@ void VulkanRenderer::DrawNodes(uint32_t currentBufferIdx)
 		BeginQuery(passType, currentBufferIdx);
 		//
 
+		WriteTimestamp(VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, GPUTimings::GetPassBeginQuery(passIndex), currentBufferIdx);
+
+#if defined(SHADOW_CACHING)
+		if (passType == VisualPass::PassType::GE_PT_SHADOWS)
+		{
+			DrawShadowCache(passData, currentBufferIdx);
+		}
+#endif // SHADOW_CACHING
+
 		BeginRenderPass(passData, currentBufferIdx);
 
 		for (auto* pPass : passData.passes)
@@ -1295,6 +1922,9 @@ void VulkanRenderer::DrawNodes(uint32_t currentBufferIdx)
 
 		EndRenderPass(passData, currentBufferIdx);
 
+		WriteTimestamp(VkPipelineStageFlagBits::VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, GPUTimings::GetPassEndQuery(passIndex), currentBufferIdx);
+		passIndex++;
+
 		//
 		EndQuery(passType, currentBufferIdx);
 		//
@@ -1304,6 +1934,8 @@ void VulkanRenderer::DrawNodes(uint32_t currentBufferIdx)
 
 void VulkanRenderer::UpdateNodes(Camera* pCamera, float32_t crrTime)
 {
+	GE_PROFILE_FUNCTION();
+
 	assert(pCamera != nullptr);
 
 	for (auto& it : mVisualPassMap)
@@ -1329,10 +1961,31 @@ void VulkanRenderer::DrawNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, u
 	assert(pGeoNode != nullptr);
 	assert(currentBufferIdx < mDrawCommandBuffers.size());
 
+#if defined(SCENE_CULLING)
+	if (IsNodeCulled(pVisualPass, pGeoNode))
+		return;
+#endif // SCENE_CULLING
+
+#if defined(CASCADED_SHADOWS)
+	// the caster is out of all the cascades
+	uint32_t firstCascade = 0, cascadeCount = 0;
+	const bool_t isCascadedShadow = GetShadowCascadeRange(pVisualPass, pGeoNode, firstCascade, cascadeCount);
+	if (isCascadedShadow && (0 == cascadeCount))
+		return;
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+	// the static caster is drawn to the dirty faces of the cache only
+	uint32_t faceMask = 0;
+	const bool_t isCachedShadow = GetShadowCacheFaces(pVisualPass, pGeoNode, faceMask);
+	if (isCachedShadow && ((false == mIsDrawingShadowCache) || (0 == faceMask)))
+		return;
+#endif // SHADOW_CACHING
+
 	UpdateDynamicStates(pVisualPass, currentBufferIdx);
 
-	// debug case
-	if (pVisualPass->GetIsDebug())
+	// debug and full screen cases - the triangle is generated in the vertex shader
+	if (pVisualPass->GetIsDebug() || pVisualPass->GetIsFullScreen())
 	{
 		DrawDirect(3, 0, 1, currentBufferIdx);
 		return;
@@ -1376,26 +2029,70 @@ void VulkanRenderer::DrawNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, u
 	assert(pVertexFormat != nullptr);
 
 	uint32_t instanceCount = (pVertexFormat->GetVertexInputRate() == VertexFormat::VertexInputRate::GE_VIR_VERTEX ? 1 : 0); //TODO
+	uint32_t firstInstance = 0;
+
+	auto drawGeometry = [this, &pGeometry, &count, &currentBufferIdx, &isIndexedDrawing](uint32_t drawInstanceCount, uint32_t drawFirstInstance)
+		{
+			// in case of model loading
+			if (pGeometry->IsModel())
+			{
+				Model* pModel = dynamic_cast<Model*>(pGeometry);
+				if (pModel)
+				{
+					auto* gadrModel = Get(pModel);
+					assert(gadrModel != nullptr);
 
-	// in case of model loading
-	if (pGeometry->IsModel())
+					gadrModel->Draw([this, &currentBufferIdx, &drawInstanceCount, &drawFirstInstance, &isIndexedDrawing](uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)
+						{
+							DrawDirect(indexCount, firstIndex, drawInstanceCount, currentBufferIdx, isIndexedDrawing, vertexOffset, drawFirstInstance);
+						});
+				}
+			}
+			else
+			{
+				DrawDirect(count, 0, drawInstanceCount, currentBufferIdx, isIndexedDrawing, 0, drawFirstInstance);
+			}
+		};
+
+#if defined(CASCADED_SHADOWS)
+	// one instance per cascade, the instance index is the cascade index, see litCascadedShadowCompute.vert
+	if (isCascadedShadow)
 	{
-		Model* pModel = dynamic_cast<Model*>(pGeometry);
-		if (pModel)
+		instanceCount = cascadeCount;
+		firstInstance = firstCascade;
+	}
+
+#if defined(SHADOW_CACHING)
+	// only the dirty cascades of the cache, one draw per cascade
+	if (isCachedShadow && isCascadedShadow)
+	{
+		const uint32_t lastCascade = firstCascade + cascadeCount;
+		for (uint32_t i = firstCascade; i < lastCascade; ++i)
 		{
-			auto* gadrModel = Get(pModel);
-			assert(gadrModel != nullptr);
+			if (0 == (faceMask & (1 << i)))
+				continue;
 
-			gadrModel->Draw([this, &currentBufferIdx, &instanceCount, &isIndexedDrawing](uint32_t indexCount, uint32_t firstIndex)
-				{
-					DrawDirect(indexCount, firstIndex, instanceCount, currentBufferIdx, isIndexedDrawing);
-				});
+			drawGeometry(1, i);
 		}
+		return;
 	}
-	else
+#endif // SHADOW_CACHING
+#endif // CASCADED_SHADOWS
+
+#if defined(GPU_CULLING)
+	// the draws of the node are written by the culling pass, see BuildGPUCullingDraws()
+	const uint32_t groupIdx = (isIndexedDrawing ? GetGPUCullingGroup(pVisualPass, pGeoNode) : UINT32_MAX);
+	if (groupIdx != UINT32_MAX)
 	{
-		DrawDirect(count, 0, instanceCount, currentBufferIdx, isIndexedDrawing);
+		const auto& group = mGPUCulling.GetGroups()[groupIdx];
+
+		DrawIndirect(mpGPUCullingCommandBuffer, group.firstCommand, group.commandCount,
+			(mpDevice->IsDrawIndirectCountEnabled() ? mpGPUCullingCountBuffer : nullptr), groupIdx, currentBufferIdx);
+		return;
 	}
+#endif // GPU_CULLING
+
+	drawGeometry(instanceCount, firstInstance);
 }
 
 void VulkanRenderer::UpdateNode(VisualPass* pVisualPass, GeometryNode* pGeoNode, Camera* pCamera, float32_t crrTime)
@@ -1409,7 +2106,7 @@ void VulkanRenderer::UpdateNode(VisualPass* pVisualPass, GeometryNode* pGeoNode,
 	//TODO - other stuff to update
 }
 
-void VulkanRenderer::DrawDirect(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t currentBufferIdx, bool_t isIndexedDrawing)
+void VulkanRenderer::DrawDirect(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t currentBufferIdx, bool_t isIndexedDrawing, int32_t vertexOffset, uint32_t firstInstance)
 {
 	assert(currentBufferIdx < mDrawCommandBuffers.size());
 
@@ -1418,19 +2115,53 @@ void VulkanRenderer::DrawDirect(uint32_t indexCount, uint32_t firstIndex, uint32
 
 	if (isIndexedDrawing)
 	{
-		// TODO - for now firstInstance, vertexOffset are both 0
-		vkCmdDrawIndexed(pCrrDrawCommandBuffer->GetHandle(), indexCount, instanceCount, firstIndex, 0, 0);
+		vkCmdDrawIndexed(pCrrDrawCommandBuffer->GetHandle(), indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 	}
 	else
 	{
-		// TODO - for now firstVertex/Index, firstInstance are both 0
-		vkCmdDraw(pCrrDrawCommandBuffer->GetHandle(), indexCount, instanceCount, 0, 0);
+		// TODO - for now firstVertex is 0
+		vkCmdDraw(pCrrDrawCommandBuffer->GetHandle(), indexCount, instanceCount, 0, firstInstance);
 	}
 }
 
-void VulkanRenderer::DrawIndirect(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t currentBufferIdx, bool_t isIndexedDrawing)
+void VulkanRenderer::DrawIndirect(VulkanBuffer* pCommandBuffer, uint32_t firstCommand, uint32_t commandCount, VulkanBuffer* pCountBuffer, uint32_t countIdx, uint32_t currentBufferIdx)
 {
-	// TODO - indirect draw
+	assert(mpDevice != nullptr);
+	assert(pCommandBuffer != nullptr);
+	assert(currentBufferIdx < mDrawCommandBuffers.size());
+
+	if (0 == commandCount)
+		return;
+
+	auto pCrrDrawCommandBuffer = mDrawCommandBuffers[currentBufferIdx];
+	assert(pCrrDrawCommandBuffer != nullptr);
+
+	const uint32_t stride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+	const VkDeviceSize offset = static_cast<VkDeviceSize>(firstCommand) * stride;
+
+#if defined(VK_VERSION_1_2)
+	if (pCountBuffer && mpDevice->IsDrawIndirectCountEnabled())
+	{
+		assert(commandCount <= mpDevice->GetPhysicalDeviceProperties().limits.maxDrawIndirectCount);
+
+		vkCmdDrawIndexedIndirectCount(pCrrDrawCommandBuffer->GetHandle(), pCommandBuffer->GetHandle(), offset,
+			pCountBuffer->GetHandle(), static_cast<VkDeviceSize>(countIdx) * sizeof(uint32_t), commandCount, stride);
+		return;
+	}
+#endif // defined(VK_VERSION_1_2)
+
+	// no count buffer, all the commands are drawn
+	if (mpDevice->GetPhysicalDeviceEnabledFeatures().multiDrawIndirect)
+	{
+		vkCmdDrawIndexedIndirect(pCrrDrawCommandBuffer->GetHandle(), pCommandBuffer->GetHandle(), offset, commandCount, stride);
+	}
+	else
+	{
+		for (uint32_t i = 0; i < commandCount; ++i)
+		{
+			vkCmdDrawIndexedIndirect(pCrrDrawCommandBuffer->GetHandle(), pCommandBuffer->GetHandle(), offset + static_cast<VkDeviceSize>(i) * stride, 1, stride);
+		}
+	}
 }
 
 
@@ -1446,7 +2177,7 @@ void VulkanRenderer::BeginRenderPass(const VisualPassData& visualPassData, uint3
 
 	auto& dataRef = visualPassData.passBeginData;
 
-	std::vector<VkClearValue> clearValues;
+	StlVector<VkClearValue> clearValues(&mFrameAllocator);
 
 	if (visualPassData.passes[0]->GetPassType() == VisualPass::PassType::GE_PT_SHADOWS)
 	{
@@ -1454,6 +2185,16 @@ void VulkanRenderer::BeginRenderPass(const VisualPassData& visualPassData, uint3
 
 		clearValues[0].depthStencil = { dataRef.depth, dataRef.stencil };
 	}
+	else if (visualPassData.passes[0]->GetPassType() == VisualPass::PassType::GE_PT_GBUFFER)
+	{
+		// albedo, normal, material, depth
+		clearValues.resize(4);
+
+		clearValues[0].color = { 0.0, 0.0, 0.0, 0.0 };
+		clearValues[1].color = { 0.0, 0.0, 0.0, 0.0 };
+		clearValues[2].color = { 0.0, 0.0, 0.0, 0.0 };
+		clearValues[3].depthStencil = { dataRef.depth, dataRef.stencil };
+	}
 	else // standard or offscreen
 	{
 		clearValues.resize(CLEARVALUES_COUNT);
@@ -1479,7 +2220,7 @@ void VulkanRenderer::BeginRenderPass(const VisualPassData& visualPassData, uint3
 	assert(pVulkanCmdBuff != nullptr);
 
 	auto& refFB = (visualPassData.frameBuffers.size() > 1 ? visualPassData.frameBuffers[currentBufferIdx] : visualPassData.frameBuffers[0]);
-	visualPassData.pRenderPass->Begin(pVulkanCmdBuff->GetHandle(), refFB->GetHandle(), renderArea, clearValues);
+	visualPassData.pRenderPass->Begin(pVulkanCmdBuff->GetHandle(), refFB->GetHandle(), renderArea, static_cast<uint32_t>(clearValues.size()), clearValues.data());
 }
 
 void VulkanRenderer::EndRenderPass(const VisualPassData& visualPassData, uint32_t currentBufferIdx)
@@ -1545,6 +2286,806 @@ void VulkanRenderer::AddVisualPass(VisualPass* pVisualPass)
 	}
 };
 
+void VulkanRenderer::SetupLightClusters()
+{
+	assert(mpDevice != nullptr);
+
+	TerminateLightClusters();
+
+	// see res/shaders/VisualEffects/LitEffects/clusteredLights.glsl
+#if defined(CLUSTERED_LIGHTING)
+	const auto& grid = GetLightClusterGrid();
+
+	const VkDeviceSize lightBufferSize = sizeof(LightClusterGrid::GridInfo) + LightClusterGrid::MAX_LIGHT_COUNT * sizeof(LightClusterGrid::GPULight);
+	const VkDeviceSize clusterBufferSize = grid.GetClusterCount() * sizeof(LightClusterGrid::ClusterRange);
+	const VkDeviceSize lightIndexBufferSize = LightClusterGrid::MAX_LIGHT_INDEX_COUNT * sizeof(uint32_t);
+#else
+	// the lit shaders skip the clusters, their buffers are only bound
+	const VkDeviceSize lightBufferSize = sizeof(LightClusterGrid::GridInfo) + sizeof(LightClusterGrid::GPULight);
+	const VkDeviceSize clusterBufferSize = sizeof(LightClusterGrid::ClusterRange);
+	const VkDeviceSize lightIndexBufferSize = sizeof(uint32_t);
+#endif // CLUSTERED_LIGHTING
+
+	const VkMemoryPropertyFlags hostMemoryFlags = VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+	VulkanBuffer** buffers[] = { &mpClusterLightBuffer, &mpClusterBuffer, &mpClusterLightIndexBuffer };
+	const VkDeviceSize bufferSizes[] = { lightBufferSize, clusterBufferSize, lightIndexBufferSize };
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		auto* pBuffer = GE_ALLOC(VulkanBuffer)
+			(
+				mpDevice, hostMemoryFlags, VkBufferUsageFlagBits::VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, bufferSizes[i]
+			);
+		assert(pBuffer != nullptr);
+
+		// no lights until the first frame
+		VK_CHECK_RESULT(pBuffer->Map());
+		::memset(pBuffer->GetData(), 0, static_cast<size_t>(bufferSizes[i]));
+		pBuffer->UnMap();
+
+		*buffers[i] = pBuffer;
+	}
+}
+
+#if defined(CLUSTERED_LIGHTING)
+void VulkanRenderer::UploadLightClusters()
+{
+	GE_PROFILE_FUNCTION();
+
+	if ((nullptr == mpClusterLightBuffer) || (nullptr == mpClusterBuffer) || (nullptr == mpClusterLightIndexBuffer))
+		return;
+
+	const auto& grid = GetLightClusterGrid();
+	const auto& lights = grid.GetLights();
+	const auto& clusters = grid.GetClusters();
+	const auto& lightIndices = grid.GetLightIndices();
+
+	// NOTE! The light count is capped by UpdateLightClusters(), the light indices are clamped here
+	const uint32_t lightIndexCount = std::min(static_cast<uint32_t>(lightIndices.size()), LightClusterGrid::MAX_LIGHT_INDEX_COUNT);
+
+	VK_CHECK_RESULT(mpClusterLightBuffer->Map());
+	{
+		uint8_t* pData = static_cast<uint8_t*>(mpClusterLightBuffer->GetData());
+		assert(pData != nullptr);
+
+		::memcpy(pData, &grid.GetGridInfo(), sizeof(LightClusterGrid::GridInfo));
+		if (false == lights.empty())
+		{
+			::memcpy(pData + sizeof(LightClusterGrid::GridInfo), lights.data(), lights.size() * sizeof(LightClusterGrid::GPULight));
+		}
+	}
+	mpClusterLightBuffer->UnMap();
+
+	VK_CHECK_RESULT(mpClusterBuffer->Map());
+	{
+		auto* pClusters = static_cast<LightClusterGrid::ClusterRange*>(mpClusterBuffer->GetData());
+		assert(pClusters != nullptr);
+
+		::memcpy(pClusters, clusters.data(), clusters.size() * sizeof(LightClusterGrid::ClusterRange));
+
+		if (lightIndexCount < lightIndices.size())
+		{
+			static bool_t isWarned = false;
+			if (false == isWarned)
+			{
+				LOG_WARNING("More than %u light indices in the clusters, the lights of the last clusters are dropped!", LightClusterGrid::MAX_LIGHT_INDEX_COUNT);
+				isWarned = true;
+			}
+
+			for (size_t i = 0; i < clusters.size(); ++i)
+			{
+				const uint32_t end = std::min(pClusters[i].offset + pClusters[i].count, lightIndexCount);
+				pClusters[i].offset = std::min(pClusters[i].offset, lightIndexCount);
+				pClusters[i].count = end - pClusters[i].offset;
+			}
+		}
+	}
+	mpClusterBuffer->UnMap();
+
+	if (lightIndexCount > 0)
+	{
+		VK_CHECK_RESULT(mpClusterLightIndexBuffer->Map());
+		mpClusterLightIndexBuffer->SetData(const_cast<uint32_t*>(lightIndices.data()), lightIndexCount * sizeof(uint32_t));
+		mpClusterLightIndexBuffer->UnMap();
+	}
+}
+#endif // CLUSTERED_LIGHTING
+
+void VulkanRenderer::TerminateLightClusters()
+{
+	GE_FREE(mpClusterLightBuffer);
+	GE_FREE(mpClusterBuffer);
+	GE_FREE(mpClusterLightIndexBuffer);
+}
+
+VulkanBuffer* VulkanRenderer::GetStorageBuffer(const std::string& blockName) const
+{
+	if (blockName == GLSLShaderTypes::Constants::STORAGE_CLUSTER_LIGHTS)
+		return mpClusterLightBuffer;
+
+	if (blockName == GLSLShaderTypes::Constants::STORAGE_CLUSTERS)
+		return mpClusterBuffer;
+
+	if (blockName == GLSLShaderTypes::Constants::STORAGE_CLUSTER_LIGHT_INDICES)
+		return mpClusterLightIndexBuffer;
+
+	return nullptr;
+}
+
+#if defined(GPU_CULLING)
+void VulkanRenderer::SetupGPUCulling()
+{
+	assert(mpDevice != nullptr);
+	assert(mpRenderQueue != nullptr);
+	assert(mpPipelineCache != nullptr);
+
+	TerminateGPUCulling();
+
+	// same renderables as the visual passes, the nodes without an index buffer or float positions are drawn directly
+	for (const auto& renderable : mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OPAQUE))
+	{
+		auto* pGeoNode = renderable.pGeometryNode;
+		assert(pGeoNode != nullptr);
+
+		if (mGPUCullingGroups.find(pGeoNode) != mGPUCullingGroups.end())
+			continue;
+
+		auto* pGeometry = pGeoNode->GetGeometry();
+		if ((nullptr == pGeometry) || (false == pGeometry->IsIndexed()) || (nullptr == pGeometry->GetIndexBuffer()))
+			continue;
+
+		glm::vec3 localMin, localMax;
+		if (false == GetLocalBounds(pGeometry, localMin, localMax))
+			continue;
+
+		mGPUCullingGroups[pGeoNode] = mGPUCulling.AddObject(localMin, localMax);
+		mGPUCullingNodes.push_back(pGeoNode);
+	}
+
+	if (mGPUCullingNodes.empty())
+		return;
+
+	// without the indirect count draws the culled commands are kept with 0 instances
+	mGPUCulling.SetIsCompacted(mpDevice->IsDrawIndirectCountEnabled());
+
+	const uint32_t setCount = static_cast<uint32_t>(mDrawCommandBuffers.size());
+
+	// see res/shaders/Compute/drawCulling.comp
+	std::vector<VkDescriptorSetLayoutBinding> layoutBindings(5);
+	for (uint32_t i = 0; i < layoutBindings.size(); ++i)
+	{
+		layoutBindings[i].binding = i;
+		layoutBindings[i].descriptorType = (0 == i ? VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+		layoutBindings[i].descriptorCount = 1;
+		layoutBindings[i].stageFlags = VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+
+	mpGPUCullingDescriptorSetLayout = GE_ALLOC(VulkanDescriptorSetLayout)(mpDevice, layoutBindings);
+	assert(mpGPUCullingDescriptorSetLayout != nullptr);
+
+	std::vector<VkDescriptorPoolSize> poolSizes(2);
+	poolSizes[0].type = VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	poolSizes[0].descriptorCount = setCount;
+	poolSizes[1].type = VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSizes[1].descriptorCount = 4 * setCount;
+
+	mpGPUCullingDescriptorPool = GE_ALLOC(VulkanDescriptorPool)(mpDevice, setCount, poolSizes);
+	assert(mpGPUCullingDescriptorPool != nullptr);
+
+	mpGPUCullingPipelineLayout = GE_ALLOC(VulkanPipelineLayout)(mpDevice, { mpGPUCullingDescriptorSetLayout }, {});
+	assert(mpGPUCullingPipelineLayout != nullptr);
+
+	mpGPUCullingShaderModule = GE_ALLOC(VulkanShaderModule)
+		(
+			mpDevice,
+			VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT,
+			std::string() + GE_ASSET_PATH + "shaders/Compute/drawCulling.comp"
+		);
+	assert(mpGPUCullingShaderModule != nullptr);
+
+	mpGPUCullingPipeline = GE_ALLOC(VulkanComputePipeline)
+		(
+			mpDevice,
+			mpPipelineCache->GetHandle(),
+			VulkanInitializers::PipelineShaderStageCreateInfo(VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT, mpGPUCullingShaderModule->GetHandle(), "main"),
+			mpGPUCullingPipelineLayout->GetHandle()
+		);
+	assert(mpGPUCullingPipeline != nullptr);
+
+	const VkMemoryPropertyFlags hostMemoryFlags = VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	const VkDeviceSize countSize = static_cast<VkDeviceSize>(mGPUCullingNodes.size()) * sizeof(uint32_t);
+
+	for (uint32_t i = 0; i < setCount; ++i)
+	{
+		auto* pUniformBuffer = GE_ALLOC(VulkanBuffer)
+			(
+				mpDevice, hostMemoryFlags, VkBufferUsageFlagBits::VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(GPUCulling::Uniform)
+			);
+		assert(pUniformBuffer != nullptr);
+		mGPUCullingUniformBuffers.push_back(pUniformBuffer);
+
+		auto* pObjectBuffer = GE_ALLOC(VulkanBuffer)
+			(
+				mpDevice, hostMemoryFlags, VkBufferUsageFlagBits::VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				static_cast<VkDeviceSize>(mGPUCullingNodes.size()) * sizeof(GPUCulling::Object)
+			);
+		assert(pObjectBuffer != nullptr);
+		mGPUCullingObjectBuffers.push_back(pObjectBuffer);
+
+		auto* pDescriptorSet = GE_ALLOC(VulkanDescriptorSet)(mpDevice, mpGPUCullingDescriptorPool, 0, { mpGPUCullingDescriptorSetLayout });
+		assert(pDescriptorSet != nullptr);
+		mGPUCullingDescriptorSets.push_back(pDescriptorSet);
+
+#if defined(GPU_CULLING_VALIDATION)
+		auto* pReadBackBuffer = GE_ALLOC(VulkanBuffer)
+			(
+				mpDevice, hostMemoryFlags, VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_DST_BIT, countSize
+			);
+		assert(pReadBackBuffer != nullptr);
+		mGPUCullingReadBackBuffers.push_back(pReadBackBuffer);
+#endif // GPU_CULLING_VALIDATION
+	}
+
+	mpGPUCullingCountBuffer = GE_ALLOC(VulkanBuffer)
+		(
+			mpDevice,
+			VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			VkBufferUsageFlagBits::VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VkBufferUsageFlagBits::VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+			VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_DST_BIT | VkBufferUsageFlagBits::VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			countSize
+		);
+	assert(mpGPUCullingCountBuffer != nullptr);
+
+	// the draw and command buffers are created with the draws
+}
+
+void VulkanRenderer::BuildGPUCullingDraws()
+{
+	assert(mpDevice != nullptr);
+
+	if (nullptr == mpGPUCullingPipeline)
+		return;
+
+	mGPUCulling.ClearDraws();
+
+	for (uint32_t i = 0; i < mGPUCullingNodes.size(); ++i)
+	{
+		auto* pGeometry = mGPUCullingNodes[i]->GetGeometry();
+		assert(pGeometry != nullptr);
+
+		mGPUCulling.AddGroup();
+
+		auto* pVertexFormat = pGeometry->GetVertexFormat();
+		assert(pVertexFormat != nullptr);
+
+		// same draws as DrawNode()
+		const uint32_t instanceCount = (pVertexFormat->GetVertexInputRate() == VertexFormat::VertexInputRate::GE_VIR_VERTEX ? 1 : 0); //TODO
+
+		Model* pModel = (pGeometry->IsModel() ? dynamic_cast<Model*>(pGeometry) : nullptr);
+		if (pModel)
+		{
+			auto* gadrModel = Get(pModel);
+			assert(gadrModel != nullptr);
+
+			// one draw per meshlet, culled with the meshlet bounds by the compute pass
+			gadrModel->DrawMeshlets([this, i, instanceCount](uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)
+				{
+					mGPUCulling.AddDraw(i, indexCount, instanceCount, firstIndex, vertexOffset, pBounds);
+				});
+		}
+		else if (false == pGeometry->IsModel())
+		{
+			assert(pGeometry->GetIndexBuffer() != nullptr);
+
+			mGPUCulling.AddDraw(i, pGeometry->GetIndexBuffer()->GetIndexCount(), instanceCount, 0, 0);
+		}
+	}
+
+	const auto& draws = mGPUCulling.GetDraws();
+	const VkDeviceSize drawSize = static_cast<VkDeviceSize>(std::max<size_t>(draws.size(), 1)) * sizeof(GPUCulling::Draw);
+
+	// NOTE! The command buffers are not in use, they are recorded again
+	if ((nullptr == mpGPUCullingDrawBuffer) || (mpGPUCullingDrawBuffer->GetSize() < drawSize))
+	{
+		GE_FREE(mpGPUCullingDrawBuffer);
+		GE_FREE(mpGPUCullingCommandBuffer);
+
+		mpGPUCullingDrawBuffer = GE_ALLOC(VulkanBuffer)
+			(
+				mpDevice,
+				VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				VkBufferUsageFlagBits::VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				drawSize
+			);
+		assert(mpGPUCullingDrawBuffer != nullptr);
+
+		mpGPUCullingCommandBuffer = GE_ALLOC(VulkanBuffer)
+			(
+				mpDevice,
+				VkMemoryPropertyFlagBits::VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+				VkBufferUsageFlagBits::VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VkBufferUsageFlagBits::VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+				static_cast<VkDeviceSize>(std::max<size_t>(draws.size(), 1)) * sizeof(GPUCulling::Command)
+			);
+		assert(mpGPUCullingCommandBuffer != nullptr);
+
+		for (uint32_t i = 0; i < mGPUCullingDescriptorSets.size(); ++i)
+		{
+			auto* pDescriptorSet = mGPUCullingDescriptorSets[i];
+			assert(pDescriptorSet != nullptr);
+
+			const VulkanBuffer* buffers[] = { mGPUCullingUniformBuffers[i], mGPUCullingObjectBuffers[i], mpGPUCullingDrawBuffer, mpGPUCullingCommandBuffer, mpGPUCullingCountBuffer };
+
+			std::vector<VkWriteDescriptorSet> writeDescriptorSets;
+			for (uint32_t binding = 0; binding < 5; ++binding)
+			{
+				writeDescriptorSets.push_back(VulkanInitializers::WriteDescriptorSet
+					(
+						pDescriptorSet->GetHandle(), binding, 0, 1,
+						(0 == binding ? VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+						nullptr, &buffers[binding]->GetDescriptorInfo()
+					));
+			}
+
+			pDescriptorSet->Update(writeDescriptorSets, {});
+		}
+	}
+
+	if (false == draws.empty())
+	{
+		VK_CHECK_RESULT(mpGPUCullingDrawBuffer->Map());
+		mpGPUCullingDrawBuffer->SetData(const_cast<GPUCulling::Draw*>(draws.data()), draws.size() * sizeof(GPUCulling::Draw));
+		mpGPUCullingDrawBuffer->UnMap();
+	}
+
+#if defined(GPU_CULLING_VALIDATION)
+	// the counts of the previous recording are not compared
+	mGPUCullingExpectedCounts.assign(mDrawCommandBuffers.size(), std::vector<uint32_t>());
+#endif // GPU_CULLING_VALIDATION
+}
+
+void VulkanRenderer::DispatchGPUCulling(uint32_t currentBufferIdx)
+{
+	if (nullptr == mpGPUCullingPipeline)
+		return;
+
+	assert(currentBufferIdx < mDrawCommandBuffers.size());
+	assert(mDrawCommandBuffers[currentBufferIdx] != nullptr);
+
+	auto commandBufferHandle = mDrawCommandBuffers[currentBufferIdx]->GetHandle();
+
+	const uint32_t drawCount = static_cast<uint32_t>(mGPUCulling.GetDraws().size());
+	const VkDeviceSize countSize = static_cast<VkDeviceSize>(mGPUCulling.GetGroups().size()) * sizeof(uint32_t);
+
+	// the indirect draws and the count copies of the previous submissions are done before the buffers are written again
+	VkMemoryBarrier memoryBarrier = VulkanInitializers::MemoryBarrier
+		(
+			VkAccessFlagBits::VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT,
+			VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT | VkAccessFlagBits::VK_ACCESS_SHADER_WRITE_BIT
+		);
+	vkCmdPipelineBarrier(commandBufferHandle,
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+	vkCmdFillBuffer(commandBufferHandle, mpGPUCullingCountBuffer->GetHandle(), 0, countSize, 0);
+
+	VkBufferMemoryBarrier countBarrier = VulkanInitializers::BufferMemoryBarrier
+		(
+			VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT, VkAccessFlagBits::VK_ACCESS_SHADER_READ_BIT | VkAccessFlagBits::VK_ACCESS_SHADER_WRITE_BIT,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, mpGPUCullingCountBuffer->GetHandle(), 0, countSize
+		);
+	vkCmdPipelineBarrier(commandBufferHandle,
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		0, 0, nullptr, 1, &countBarrier, 0, nullptr);
+
+	if (drawCount > 0)
+	{
+		mpGPUCullingPipeline->Bind(commandBufferHandle, VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_COMPUTE);
+		mGPUCullingDescriptorSets[currentBufferIdx]->Bind(commandBufferHandle, VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_COMPUTE, mpGPUCullingPipelineLayout->GetHandle());
+
+		vkCmdDispatch(commandBufferHandle, (drawCount + GPUCulling::GROUP_SIZE - 1) / GPUCulling::GROUP_SIZE, 1, 1);
+	}
+
+	// the commands and counts are read by the indirect draws of the visual passes
+	VkBufferMemoryBarrier drawBarriers[2] =
+	{
+		VulkanInitializers::BufferMemoryBarrier
+		(
+			VkAccessFlagBits::VK_ACCESS_SHADER_WRITE_BIT, VkAccessFlagBits::VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, mpGPUCullingCommandBuffer->GetHandle(), 0, VK_WHOLE_SIZE
+		),
+		VulkanInitializers::BufferMemoryBarrier
+		(
+			VkAccessFlagBits::VK_ACCESS_SHADER_WRITE_BIT, VkAccessFlagBits::VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, mpGPUCullingCountBuffer->GetHandle(), 0, countSize
+		)
+	};
+	vkCmdPipelineBarrier(commandBufferHandle,
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0, 0, nullptr, 2, drawBarriers, 0, nullptr);
+
+#if defined(GPU_CULLING_VALIDATION)
+	VkBufferCopy copyRegion{};
+	copyRegion.size = countSize;
+	vkCmdCopyBuffer(commandBufferHandle, mpGPUCullingCountBuffer->GetHandle(), mGPUCullingReadBackBuffers[currentBufferIdx]->GetHandle(), 1, &copyRegion);
+
+	VkBufferMemoryBarrier readBackBarrier = VulkanInitializers::BufferMemoryBarrier
+		(
+			VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT, VkAccessFlagBits::VK_ACCESS_HOST_READ_BIT,
+			VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, mGPUCullingReadBackBuffers[currentBufferIdx]->GetHandle(), 0, countSize
+		);
+	vkCmdPipelineBarrier(commandBufferHandle,
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_HOST_BIT,
+		0, 0, nullptr, 1, &readBackBarrier, 0, nullptr);
+#endif // GPU_CULLING_VALIDATION
+}
+
+void VulkanRenderer::UpdateGPUCulling(Camera* pCamera)
+{
+	assert(pCamera != nullptr);
+
+	if (nullptr == mpGPUCullingPipeline)
+		return;
+
+	mGPUCulling.SetFrustum(pCamera->GetProjectionViewMatrix());
+	mGPUCulling.SetCameraPosition(pCamera->GetPosition());
+
+	for (uint32_t i = 0; i < mGPUCullingNodes.size(); ++i)
+	{
+		mGPUCulling.SetModelMatrix(i, mGPUCullingNodes[i]->GetModelMatrix());
+	}
+}
+
+void VulkanRenderer::UploadGPUCulling(uint32_t currentBufferIdx)
+{
+	if (nullptr == mpGPUCullingPipeline)
+		return;
+
+	assert(currentBufferIdx < mGPUCullingUniformBuffers.size());
+
+	auto uniform = mGPUCulling.GetUniform();
+
+	auto* pUniformBuffer = mGPUCullingUniformBuffers[currentBufferIdx];
+	assert(pUniformBuffer != nullptr);
+
+	VK_CHECK_RESULT(pUniformBuffer->Map());
+	pUniformBuffer->SetData(&uniform, sizeof(GPUCulling::Uniform));
+	pUniformBuffer->UnMap();
+
+	const auto& objects = mGPUCulling.GetObjects();
+
+	auto* pObjectBuffer = mGPUCullingObjectBuffers[currentBufferIdx];
+	assert(pObjectBuffer != nullptr);
+
+	VK_CHECK_RESULT(pObjectBuffer->Map());
+	pObjectBuffer->SetData(const_cast<GPUCulling::Object*>(objects.data()), objects.size() * sizeof(GPUCulling::Object));
+	pObjectBuffer->UnMap();
+
+#if defined(GPU_CULLING_VALIDATION)
+	// the counts the GPU must find for this submission
+	mGPUCulling.Cull(mGPUCullingExpectedCounts[currentBufferIdx]);
+#endif // GPU_CULLING_VALIDATION
+}
+
+void VulkanRenderer::ValidateGPUCulling(uint32_t currentBufferIdx)
+{
+#if defined(GPU_CULLING_VALIDATION)
+	if ((nullptr == mpGPUCullingPipeline) || mGPUCullingExpectedCounts[currentBufferIdx].empty())
+		return;
+
+	const auto& expectedCounts = mGPUCullingExpectedCounts[currentBufferIdx];
+
+	auto* pReadBackBuffer = mGPUCullingReadBackBuffers[currentBufferIdx];
+	assert(pReadBackBuffer != nullptr);
+
+	VK_CHECK_RESULT(pReadBackBuffer->Map());
+
+	const uint32_t* pCounts = static_cast<const uint32_t*>(pReadBackBuffer->GetData());
+	assert(pCounts != nullptr);
+
+	uint32_t mismatchCount = 0, gpuDrawCount = 0, cpuDrawCount = 0;
+	for (uint32_t i = 0; i < expectedCounts.size(); ++i)
+	{
+		gpuDrawCount += pCounts[i];
+		cpuDrawCount += expectedCounts[i];
+
+		if (pCounts[i] != expectedCounts[i])
+		{
+			mismatchCount++;
+		}
+	}
+
+	pReadBackBuffer->UnMap();
+
+	mGPUCullingValidatedFrameCount++;
+	if (mismatchCount > 0)
+	{
+		mGPUCullingMismatchFrameCount++;
+
+		// NOTE! The boxes touching a plane may differ by the float precision of the device
+		LOG_ERROR("GPU culling mismatch: %u of %u groups differ, GPU draws: %u, CPU draws: %u",
+			mismatchCount, static_cast<uint32_t>(expectedCounts.size()), gpuDrawCount, cpuDrawCount);
+	}
+#endif // GPU_CULLING_VALIDATION
+}
+
+void VulkanRenderer::TerminateGPUCulling()
+{
+#if defined(GPU_CULLING_VALIDATION)
+	if (mGPUCullingValidatedFrameCount > 0)
+	{
+		LOG_INFO("GPU culling validation: %u of %u frames match the CPU culling",
+			mGPUCullingValidatedFrameCount - mGPUCullingMismatchFrameCount, mGPUCullingValidatedFrameCount);
+	}
+	mGPUCullingValidatedFrameCount = 0;
+	mGPUCullingMismatchFrameCount = 0;
+
+	for (auto* pBuffer : mGPUCullingReadBackBuffers)
+	{
+		GE_FREE(pBuffer);
+	}
+	mGPUCullingReadBackBuffers.clear();
+	mGPUCullingExpectedCounts.clear();
+#endif // GPU_CULLING_VALIDATION
+
+	GE_FREE(mpGPUCullingDrawBuffer);
+	GE_FREE(mpGPUCullingCommandBuffer);
+	GE_FREE(mpGPUCullingCountBuffer);
+
+	for (auto* pBuffer : mGPUCullingUniformBuffers)
+	{
+		GE_FREE(pBuffer);
+	}
+	mGPUCullingUniformBuffers.clear();
+
+	for (auto* pBuffer : mGPUCullingObjectBuffers)
+	{
+		GE_FREE(pBuffer);
+	}
+	mGPUCullingObjectBuffers.clear();
+
+	// the sets before their pool
+	for (auto* pDescriptorSet : mGPUCullingDescriptorSets)
+	{
+		GE_FREE(pDescriptorSet);
+	}
+	mGPUCullingDescriptorSets.clear();
+
+	GE_FREE(mpGPUCullingPipeline);
+	GE_FREE(mpGPUCullingShaderModule);
+	GE_FREE(mpGPUCullingPipelineLayout);
+	GE_FREE(mpGPUCullingDescriptorPool);
+	GE_FREE(mpGPUCullingDescriptorSetLayout);
+
+	mGPUCulling.Clear();
+	mGPUCullingNodes.clear();
+	mGPUCullingGroups.clear();
+}
+
+uint32_t VulkanRenderer::GetGPUCullingGroup(VisualPass* pVisualPass, const GeometryNode* pGeoNode) const
+{
+	assert(pVisualPass != nullptr);
+	assert(pGeoNode != nullptr);
+
+	if (nullptr == mpGPUCullingPipeline)
+		return UINT32_MAX;
+
+	// the camera frustum is only valid for the passes rendered by the camera, as for the CPU culling
+	const auto passType = pVisualPass->GetPassType();
+	if (((passType != VisualPass::PassType::GE_PT_STANDARD) && (passType != VisualPass::PassType::GE_PT_GBUFFER)) ||
+		pVisualPass->GetIsDebug() || pVisualPass->GetIsFullScreen() ||
+		(pVisualPass->GetTransform() != glm::mat4(1.0f)))
+		return UINT32_MAX;
+
+	auto it = mGPUCullingGroups.find(pGeoNode);
+	if (it == mGPUCullingGroups.end())
+		return UINT32_MAX;
+
+	return it->second;
+}
+#endif // GPU_CULLING
+
+#if defined(SHADOW_CACHING)
+void VulkanRenderer::SetupShadowCache()
+{
+	assert(mpDevice != nullptr);
+
+	auto it = mVisualPassMap.find(VisualPass::PassType::GE_PT_SHADOWS);
+	if ((it == mVisualPassMap.end()) || it->second.passes.empty())
+		return;
+
+	auto* pShadowRT = it->second.passes[0]->GetRenderTarget(RenderTarget::TargetType::GE_TT_DEPTH);
+	assert(pShadowRT != nullptr);
+
+	auto* pShadowTexture = Get(pShadowRT);
+	assert(pShadowTexture != nullptr);
+
+	const auto& extent = pShadowTexture->GetVkImage()->GetData().extent;
+
+	mpShadowCacheRT = GE_ALLOC(RenderTarget)(RenderTarget::TargetType::GE_TT_DEPTH, RenderTarget::TargetOutput::GE_TO_RENDER_SAMPLING, extent.width, extent.height);
+	assert(mpShadowCacheRT != nullptr);
+
+	auto* pCacheTexture = Bind(mpShadowCacheRT);
+	assert(pCacheTexture != nullptr);
+
+	const VkFormat depthFormat = VulkanUtils::TextureFormatToVulkanFormat(mpShadowCacheRT->GetTexture()->GetMetaData().format);
+
+	// the cache is only read by the copies to the shadow map
+	auto createRenderPass = [this, &depthFormat](VkAttachmentLoadOp loadOp, VkImageLayout initialLayout)
+		{
+			VkAttachmentDescription depthStencilAttachment{};
+			depthStencilAttachment.format = depthFormat;
+			depthStencilAttachment.samples = MIN_NUM_SAMPLES; // use at least 1 sample
+			depthStencilAttachment.loadOp = loadOp;
+			depthStencilAttachment.storeOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_STORE;
+			depthStencilAttachment.stencilLoadOp = VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+			depthStencilAttachment.stencilStoreOp = VkAttachmentStoreOp::VK_ATTACHMENT_STORE_OP_DONT_CARE;
+			depthStencilAttachment.initialLayout = initialLayout;
+			depthStencilAttachment.finalLayout = VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+			VkAttachmentReference depthStencilReference;
+			depthStencilReference.attachment = 0;
+			depthStencilReference.layout = VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+			VkSubpassDescription subPass{};
+			subPass.pipelineBindPoint = VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS;
+			subPass.colorAttachmentCount = 0;
+			subPass.pColorAttachments = nullptr;
+			subPass.pDepthStencilAttachment = &depthStencilReference;
+
+			// the previous copies are done reading the cache
+			VkSubpassDependency subPassDep_1;
+			subPassDep_1.srcSubpass = VK_SUBPASS_EXTERNAL;
+			subPassDep_1.dstSubpass = SUBPASS_ID;
+			subPassDep_1.srcStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT;
+			subPassDep_1.dstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VkPipelineStageFlagBits::VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+			subPassDep_1.srcAccessMask = VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT;
+			subPassDep_1.dstAccessMask = VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			subPassDep_1.dependencyFlags = 0;
+
+			// the cache is written before it is copied
+			VkSubpassDependency subPassDep_2;
+			subPassDep_2.srcSubpass = SUBPASS_ID;
+			subPassDep_2.dstSubpass = VK_SUBPASS_EXTERNAL;
+			subPassDep_2.srcStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+			subPassDep_2.dstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT;
+			subPassDep_2.srcAccessMask = VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			subPassDep_2.dstAccessMask = VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT;
+			subPassDep_2.dependencyFlags = 0;
+
+			return GE_ALLOC(VulkanRenderPass)(mpDevice, { depthStencilAttachment }, { subPass }, { subPassDep_1, subPassDep_2 });
+		};
+
+	// same attachment as the shadow pass, its pipelines are compatible with both render passes
+	mpShadowCacheClearRenderPass = createRenderPass(VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_CLEAR, VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED);
+	assert(mpShadowCacheClearRenderPass != nullptr);
+
+	// the cache stays in the layout of the copies between the updates
+	mpShadowCacheLoadRenderPass = createRenderPass(VkAttachmentLoadOp::VK_ATTACHMENT_LOAD_OP_LOAD, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+	assert(mpShadowCacheLoadRenderPass != nullptr);
+
+	mpShadowCacheFrameBuffer = GE_ALLOC(VulkanFrameBuffer)
+		(
+			mpDevice,
+			mpShadowCacheClearRenderPass,
+			{ pCacheTexture->GetVkImageView()->GetHandle() },
+			extent.width,
+			extent.height
+			);
+	assert(mpShadowCacheFrameBuffer != nullptr);
+}
+
+void VulkanRenderer::DrawShadowCache(const VisualPassData& visualPassData, uint32_t currentBufferIdx)
+{
+	if (nullptr == mpShadowCacheFrameBuffer)
+		return;
+
+	assert(visualPassData.passes.empty() == false);
+
+	auto* pVulkanCmdBuff = GetCommandBuffer(currentBufferIdx);
+	assert(pVulkanCmdBuff != nullptr);
+
+	auto* pCacheTexture = Get(mpShadowCacheRT);
+	assert(pCacheTexture != nullptr);
+
+	auto* pShadowTexture = Get(visualPassData.passes[0]->GetRenderTarget(RenderTarget::TargetType::GE_TT_DEPTH));
+	assert(pShadowTexture != nullptr);
+
+	const auto& extent = pCacheTexture->GetVkImage()->GetData().extent;
+
+	if (mShadowCacheFaceMask != 0)
+	{
+		const uint32_t faceCount = mShadowCache.GetFaceCount();
+		const uint32_t allFacesMask = (1 << faceCount) - 1;
+		const bool_t isFullUpdate = ((mShadowCacheFaceMask & allFacesMask) == allFacesMask);
+
+		VkClearValue clearValue;
+		clearValue.depthStencil = { visualPassData.passBeginData.depth, visualPassData.passBeginData.stencil };
+
+		VkRect2D renderArea = { { 0, 0 }, { extent.width, extent.height } };
+
+		auto* pRenderPass = (isFullUpdate ? mpShadowCacheClearRenderPass : mpShadowCacheLoadRenderPass);
+		pRenderPass->Begin(pVulkanCmdBuff->GetHandle(), mpShadowCacheFrameBuffer->GetHandle(), renderArea, 1, &clearValue);
+
+		if (false == isFullUpdate)
+		{
+			// the faces are the tiles of the atlas, tile i at (i % 2, i / 2), see ShadowCascades
+			const uint32_t tileWidth = (faceCount > 1 ? extent.width / 2 : extent.width);
+			const uint32_t tileHeight = (faceCount > 2 ? extent.height / 2 : extent.height);
+
+			StlVector<VkClearRect> clearRects(&mFrameAllocator);
+			for (uint32_t i = 0; i < faceCount; ++i)
+			{
+				if (0 == (mShadowCacheFaceMask & (1 << i)))
+					continue;
+
+				VkClearRect clearRect{};
+				clearRect.rect.offset = { static_cast<int32_t>((i % 2) * tileWidth), static_cast<int32_t>((i / 2) * tileHeight) };
+				clearRect.rect.extent = { tileWidth, tileHeight };
+				clearRect.baseArrayLayer = 0;
+				clearRect.layerCount = 1;
+				clearRects.push_back(clearRect);
+			}
+
+			VkClearAttachment clearAttachment{};
+			clearAttachment.aspectMask = VkImageAspectFlagBits::VK_IMAGE_ASPECT_DEPTH_BIT;
+			clearAttachment.clearValue = clearValue;
+
+			vkCmdClearAttachments(pVulkanCmdBuff->GetHandle(), 1, &clearAttachment, static_cast<uint32_t>(clearRects.size()), clearRects.data());
+		}
+
+		// the static casters only, see DrawNode()
+		mIsDrawingShadowCache = true;
+		for (auto* pPass : visualPassData.passes)
+		{
+			if (pPass && (mShadowCacheCasters.find(pPass->GetNode()) != mShadowCacheCasters.end()))
+			{
+				pPass->RenderNode(currentBufferIdx);
+			}
+		}
+		mIsDrawingShadowCache = false;
+
+		pRenderPass->End(pVulkanCmdBuff->GetHandle());
+	}
+
+	// the shadow map starts as the cache, the dynamic casters are drawn on top of it by the shadow pass
+	VkImageSubresourceRange subresourceRange{};
+	subresourceRange.aspectMask = VkImageAspectFlagBits::VK_IMAGE_ASPECT_DEPTH_BIT;
+	subresourceRange.baseMipLevel = 0;
+	subresourceRange.levelCount = 1;
+	subresourceRange.baseArrayLayer = 0;
+	subresourceRange.layerCount = 1;
+
+	VulkanUtils::SetImageLayout(pVulkanCmdBuff->GetHandle(), pShadowTexture->GetVkImage()->GetHandle(),
+		VkImageLayout::VK_IMAGE_LAYOUT_UNDEFINED, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
+
+	VkImageCopy region{};
+	region.srcSubresource.aspectMask = VkImageAspectFlagBits::VK_IMAGE_ASPECT_DEPTH_BIT;
+	region.srcSubresource.mipLevel = 0;
+	region.srcSubresource.baseArrayLayer = 0;
+	region.srcSubresource.layerCount = 1;
+	region.dstSubresource = region.srcSubresource;
+	region.extent = { extent.width, extent.height, 1 };
+
+	vkCmdCopyImage(pVulkanCmdBuff->GetHandle(),
+		pCacheTexture->GetVkImage()->GetHandle(), VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		pShadowTexture->GetVkImage()->GetHandle(), VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		1, &region);
+}
+
+void VulkanRenderer::TerminateShadowCache()
+{
+	GE_FREE(mpShadowCacheFrameBuffer);
+	GE_FREE(mpShadowCacheLoadRenderPass);
+	GE_FREE(mpShadowCacheClearRenderPass);
+
+	// its texture was released by Renderer::Terminate()
+	GE_FREE(mpShadowCacheRT);
+}
+#endif // SHADOW_CACHING
+
 //////////////////////
 
 VulkanDevice* VulkanRenderer::GetDevice() const
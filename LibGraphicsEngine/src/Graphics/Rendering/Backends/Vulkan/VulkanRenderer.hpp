@@ -7,6 +7,11 @@
 #include "Graphics/Rendering/Backends/Vulkan/Common/VulkanObject.hpp"
 #include "Graphics/Rendering/Renderer.hpp"
 #include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+#include "Graphics/Rendering/RenderGraph.hpp"
+#if defined(GPU_CULLING)
+#include "Graphics/Rendering/GPUCulling.hpp"
+#include <unordered_map>
+#endif // GPU_CULLING
 #include <vector>
 #include <map>
 
@@ -28,6 +33,8 @@ namespace GraphicsEngine
 
 		class VulkanSemaphore;
 		class VulkanFence;
+		class VulkanSubmission;
+		class VulkanBuffer;
 
 		class VulkanShaderModule;
 		class VulkanDescriptorPool;
@@ -36,6 +43,7 @@ namespace GraphicsEngine
 		class VulkanPipelineCache;
 		class VulkanPipelineLayout;
 		class VulkanGraphicsPipeline;
+		class VulkanComputePipeline;
 		class VulkanFrameBuffer;
 		class VulkanRenderPass;
 
@@ -49,13 +57,16 @@ namespace GraphicsEngine
 
 		public:
 			VulkanRenderer();
-			explicit VulkanRenderer(Platform::Window* pWindow);
+			explicit VulkanRenderer(Platform::Window* pWindow, Renderer::RendererType type = Renderer::RendererType::GE_RT_FORWARD);
 			virtual ~VulkanRenderer();
 
 			virtual void RenderFrame(RenderQueue* pRenderQueue) override;
 			virtual void UpdateFrame(Camera* pCamera, float32_t crrTime) override;
 			virtual void SubmitFrame() override;
 
+			// NOTE! Only with USE_HEADLESS, the presented swapchain images can't be read back
+			virtual bool_t ReadFrame(std::vector<uint8_t>& pixelsOut) override;
+
 			virtual void OnWindowResize(uint32_t width = 0, uint32_t height = 0) override;
 
 			/////////////////////////////////
@@ -77,6 +88,9 @@ namespace GraphicsEngine
 
 			VulkanRenderPass* GetRenderPass(VisualPass* pVisualPass);
 
+			// the buffer of a shader storage block, by block name (see GLSLShaderParser::StorageBlock), nullptr if there is none
+			VulkanBuffer* GetStorageBuffer(const std::string& blockName) const;
+
 		private:
 			NO_COPY_NO_MOVE_CLASS(VulkanRenderer)
 
@@ -115,13 +129,19 @@ namespace GraphicsEngine
 			void SetupDrawCommandPool();
 			void SetupDrawCommandBuffers();
 
+			// the attachments and the sampled textures of the pass types, called by Prepare()
+			// the layouts, load ops and external dependencies of the render passes are computed from the compiled graph
+			void SetupFrameGraph();
+			// an attachment of the render pass of a pass type, its dependencies are merged in the subpass dependencies of the render pass
+			void SetupFrameGraphAttachment(VisualPass::PassType passType, uint32_t attachmentIdx, bool_t isDepth, VkAttachmentDescription& attachmentOut,
+				VkAttachmentReference& referenceOut, VkSubpassDependency& srcDependencyInOut, VkSubpassDependency& dstDependencyInOut) const;
+
 			VulkanRenderPass* SetupRenderPass(VisualPass* pVisualPass);
 			void SetupFrameBuffers(VisualPass* pVisualPass, VulkanRenderPass* pRenderPass, std::vector<VulkanFrameBuffer*>& frameBuffersOut,
 				VisualPassBeginData& visualPassBeginDataOut);
 
 			void SetupSynchronizationPrimitives();
 			void SetupPipelineCache();
-			void SetupSubmitInfo();
 
 			void SetupPipelineStats();
 			void GetQueryResults();
@@ -130,6 +150,10 @@ namespace GraphicsEngine
 			void BeginQuery(VisualPass::PassType passType, uint32_t currentBufferIdx);
 			void EndQuery(VisualPass::PassType passType, uint32_t currentBufferIdx);
 
+			void SetupTimestampQueries();
+			void WriteTimestamp(VkPipelineStageFlagBits pipelineStage, uint32_t query, uint32_t currentBufferIdx);
+			void ReadTimestampQueries(uint32_t currentBufferIdx);
+
 			void DrawSceneToCommandBuffer();
 			void DrawNodes(uint32_t currentBufferIdx);
 
@@ -144,8 +168,10 @@ namespace GraphicsEngine
 			void UpdateDynamicStates(VisualPass* pVisualPass, uint32_t currentBufferIdx);
 			void UpdateUniformBuffers(VisualPass* pVisualPass, GeometryNode* pGeoNode, Camera* pCamera, float32_t crrTime);
 
-			void DrawDirect(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t currentBufferIdx, bool_t isIndexedDrawing = false);
-			void DrawIndirect(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t currentBufferIdx, bool_t isIndexedDrawing = false);
+			void DrawDirect(uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t currentBufferIdx, bool_t isIndexedDrawing = false, int32_t vertexOffset = 0, uint32_t firstInstance = 0);
+			// indexed draws of the VkDrawIndexedIndirectCommand(s) in [firstCommand, firstCommand + commandCount)
+			// with a count buffer (see VulkanDevice::IsDrawIndirectCountEnabled()) the draw count is read at countIdx, at most commandCount
+			void DrawIndirect(VulkanBuffer* pCommandBuffer, uint32_t firstCommand, uint32_t commandCount, VulkanBuffer* pCountBuffer, uint32_t countIdx, uint32_t currentBufferIdx);
 
 
 			void BeginRenderPass(const VisualPassData& visualPassData, uint32_t currentBufferIdx);
@@ -153,6 +179,42 @@ namespace GraphicsEngine
 
 			void AddVisualPass(VisualPass* pVisualPass);
 
+			// the light cluster buffers of the lit shaders, called by Prepare()
+			// NOTE! Without CLUSTERED_LIGHTING the buffers are still bound, the shaders don't read them
+			void SetupLightClusters();
+#if defined(CLUSTERED_LIGHTING)
+			// writes the lights binned for the frame, called by UpdateFrame()
+			void UploadLightClusters();
+#endif // CLUSTERED_LIGHTING
+			void TerminateLightClusters();
+
+#if defined(GPU_CULLING)
+			// an object per opaque indexed node and the culling pipeline, called by ComputeGraphicsResources()
+			void SetupGPUCulling();
+			// the draws of the nodes, called before the command buffers are recorded (e.g. the LOD levels changed)
+			void BuildGPUCullingDraws();
+			// the culling pass, recorded before the visual passes
+			void DispatchGPUCulling(uint32_t currentBufferIdx);
+			// the model matrices and the frustum of the frame, called by UpdateFrame()
+			void UpdateGPUCulling(Camera* pCamera);
+			// writes the frame data to the buffers of the command buffer, after its fence is signaled
+			void UploadGPUCulling(uint32_t currentBufferIdx);
+			// compares the counts of the previous submission of the command buffer with the CPU culling, after its fence is signaled
+			void ValidateGPUCulling(uint32_t currentBufferIdx);
+			void TerminateGPUCulling();
+
+			// the group of the node draws, UINT32_MAX if the node is not culled on the GPU in this pass
+			uint32_t GetGPUCullingGroup(VisualPass* pVisualPass, const GeometryNode* pGeoNode) const;
+#endif // GPU_CULLING
+
+#if defined(SHADOW_CACHING)
+			// the cache depth map, its render passes and frame buffer, called by ComputeGraphicsResources()
+			void SetupShadowCache();
+			// draws the static casters to the dirty faces of the cache and copies the cache to the shadow map, recorded before the shadow pass
+			void DrawShadowCache(const VisualPassData& visualPassData, uint32_t currentBufferIdx);
+			void TerminateShadowCache();
+#endif // SHADOW_CACHING
+
 			// VULKAN RESOURCES
 
 			// Device
@@ -179,9 +241,9 @@ namespace GraphicsEngine
 			// Active frame buffer index
 			uint32_t mCurrentBufferIdx;
 
-			// Contains command buffers and semaphores to be presented to the queue
-			VkSubmitInfo mSubmitInfo;
-			VkPipelineStageFlags mSubmitPipelineStages;
+			// The queue submissions of the frames, one per draw command buffer
+			// reused when the wait fence of the command buffer is signaled
+			std::vector<VulkanSubmission*> mFrameSubmissions;
 
 			// Pipeline cache object
 			VulkanPipelineCache* mpPipelineCache;
@@ -189,6 +251,20 @@ namespace GraphicsEngine
 			// map must be ordered as the passes must be processed in the pass type order
 			std::map<VisualPass::PassType, VisualPassData> mVisualPassMap;
 
+			// a render graph pass per pass type, its textures in the order of the render pass attachments
+			struct FrameGraphPass
+			{
+				FrameGraphPass()
+					: pass(RenderGraph::INVALID_HANDLE)
+				{}
+
+				RenderGraph::PassHandle pass;
+				std::vector<RenderGraph::ResourceHandle> attachments;
+			};
+
+			RenderGraph mFrameGraph;
+			std::map<VisualPass::PassType, FrameGraphPass> mFrameGraphPasses;
+
 
 			//  pipeline statistics results
 			struct PipelineStatsData
@@ -204,6 +280,64 @@ namespace GraphicsEngine
 
 			std::map<VisualPass::PassType, PipelineStatsData> mPipelineStatsMap;
 
+			// GPU timestamps, one range of queries per draw command buffer
+			// the range of a command buffer is read back after its fence is signaled, before it is submitted again
+			VulkanQueryPool* mpTimestampQueryPool;
+			uint32_t mTimestampQueryCount; // per command buffer
+			uint64_t mTimestampMask; // valid bits
+			std::vector<VisualPass::PassType> mTimestampPassTypes;
+			std::vector<uint64_t> mTimestampSubmitTimes; // per command buffer, 0 if not submitted since recorded
+			std::vector<uint64_t> mTimestamps;
+
+			// host visible copy of the last frame, see ReadFrame()
+			VulkanBuffer* mpReadBackBuffer;
+
+			// the light clusters, see LightClusterGrid - host visible, written each frame as the uniform buffers
+			VulkanBuffer* mpClusterLightBuffer; // the grid info, then the lights
+			VulkanBuffer* mpClusterBuffer;
+			VulkanBuffer* mpClusterLightIndexBuffer;
+
+#if defined(GPU_CULLING)
+			// a group per node, the group and object indices are the same
+			GPUCulling mGPUCulling;
+			std::vector<GeometryNode*> mGPUCullingNodes;
+			std::unordered_map<const GeometryNode*, uint32_t> mGPUCullingGroups;
+
+			VulkanShaderModule* mpGPUCullingShaderModule;
+			VulkanDescriptorSetLayout* mpGPUCullingDescriptorSetLayout;
+			VulkanDescriptorPool* mpGPUCullingDescriptorPool;
+			VulkanPipelineLayout* mpGPUCullingPipelineLayout;
+			VulkanComputePipeline* mpGPUCullingPipeline;
+
+			// per draw command buffer, host visible, written after its fence is signaled
+			std::vector<VulkanDescriptorSet*> mGPUCullingDescriptorSets;
+			std::vector<VulkanBuffer*> mGPUCullingUniformBuffers;
+			std::vector<VulkanBuffer*> mGPUCullingObjectBuffers;
+
+			// shared by the draw command buffers, the culling pass waits for the indirect draws of the previous submissions
+			VulkanBuffer* mpGPUCullingDrawBuffer; // host visible, written when the command buffers are recorded
+			VulkanBuffer* mpGPUCullingCommandBuffer;
+			VulkanBuffer* mpGPUCullingCountBuffer;
+
+#if defined(GPU_CULLING_VALIDATION)
+			std::vector<VulkanBuffer*> mGPUCullingReadBackBuffers; // per draw command buffer, the counts of its last submission
+			std::vector<std::vector<uint32_t>> mGPUCullingExpectedCounts; // per draw command buffer, empty if not submitted since recorded
+			uint32_t mGPUCullingValidatedFrameCount;
+			uint32_t mGPUCullingMismatchFrameCount;
+#endif // GPU_CULLING_VALIDATION
+#endif // GPU_CULLING
+
+#if defined(SHADOW_CACHING)
+			// the depth of the static casters, the same size and format as the shadow map
+			RenderTarget* mpShadowCacheRT;
+			// compatible render passes: all the faces are dirty / only the dirty faces are cleared, the others are kept
+			VulkanRenderPass* mpShadowCacheClearRenderPass;
+			VulkanRenderPass* mpShadowCacheLoadRenderPass;
+			VulkanFrameBuffer* mpShadowCacheFrameBuffer;
+			// the static casters are drawn to the cache, see DrawNode()
+			bool_t mIsDrawingShadowCache;
+#endif // SHADOW_CACHING
+
 			//////////////////////////////////////////
 		};
 	}
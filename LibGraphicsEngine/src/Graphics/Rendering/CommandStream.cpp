@@ -0,0 +1,346 @@
+#include "Graphics/Rendering/CommandStream.hpp"
+#include <sstream>
+#include <algorithm> // std::min()
+#include <cstring> // memcpy(), memcmp()
+#include <cmath> // std::fabs()
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+namespace
+{
+	static const uint32_t MAGIC = 0x53434547; // "GECS"
+	static const uint32_t VERSION = 1;
+
+	// uniform bytes printed per update
+	static const uint32_t MAX_PRINTED_DATA_SIZE = 16;
+}
+
+CommandStream::CommandStream()
+{}
+
+CommandStream::~CommandStream()
+{}
+
+void CommandStream::Clear()
+{
+	mCommands.clear();
+	mData.clear();
+
+	mStats = Stats();
+}
+
+void CommandStream::Record(CommandType type, uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+	assert(type < CommandType::GE_CT_COUNT);
+
+	Command command;
+	command.type = type;
+	command.padding[0] = command.padding[1] = command.padding[2] = 0;
+	command.args[0] = arg0;
+	command.args[1] = arg1;
+	command.args[2] = arg2;
+	command.args[3] = arg3;
+
+	mCommands.push_back(command);
+
+	UpdateStats(command);
+}
+
+void CommandStream::RecordData(CommandType type, uint32_t id, const void* pData, uint32_t size)
+{
+	assert((pData != nullptr) || (0 == size));
+
+	const uint32_t offset = static_cast<uint32_t>(mData.size());
+	if (size > 0)
+	{
+		mData.resize(offset + size);
+		::memcpy(mData.data() + offset, pData, size);
+	}
+
+	Record(type, id, offset, size);
+}
+
+void CommandStream::UpdateStats(const Command& command)
+{
+	switch (command.type)
+	{
+	case CommandType::GE_CT_BEGIN_PASS:
+		mStats.passCount++;
+		break;
+	case CommandType::GE_CT_BIND_PIPELINE:
+	case CommandType::GE_CT_BIND_VERTEX_BUFFER:
+	case CommandType::GE_CT_BIND_INDEX_BUFFER:
+	case CommandType::GE_CT_BIND_UNIFORM_BUFFER:
+	case CommandType::GE_CT_BIND_TEXTURE:
+		mStats.bindCount++;
+		break;
+	case CommandType::GE_CT_UPDATE_UNIFORM_BUFFER:
+		mStats.uniformUpdateCount++;
+		mStats.uniformByteCount += command.args[2];
+		break;
+	case CommandType::GE_CT_DRAW:
+	case CommandType::GE_CT_DRAW_INDEXED:
+		mStats.drawCount++;
+		mStats.elementCount += command.args[0];
+		break;
+	case CommandType::GE_CT_BEGIN_FRAME:
+	case CommandType::GE_CT_END_FRAME:
+	case CommandType::GE_CT_END_PASS:
+	case CommandType::GE_CT_COUNT:
+	default:
+		break;
+	}
+}
+
+const std::vector<CommandStream::Command>& CommandStream::GetCommands() const
+{
+	return mCommands;
+}
+
+const std::vector<uint8_t>& CommandStream::GetData() const
+{
+	return mData;
+}
+
+const CommandStream::Stats& CommandStream::GetStats() const
+{
+	return mStats;
+}
+
+bool_t CommandStream::WriteHeader(std::FILE* pFile)
+{
+	assert(pFile != nullptr);
+
+	const uint32_t header[2] = { MAGIC, VERSION };
+
+	return (std::fwrite(header, sizeof(header), 1, pFile) == 1);
+}
+
+bool_t CommandStream::ReadHeader(std::FILE* pFile)
+{
+	assert(pFile != nullptr);
+
+	uint32_t header[2] = { 0, 0 };
+	if (std::fread(header, sizeof(header), 1, pFile) != 1)
+		return false;
+
+	return (header[0] == MAGIC) && (header[1] == VERSION);
+}
+
+bool_t CommandStream::Write(std::FILE* pFile) const
+{
+	assert(pFile != nullptr);
+
+	const uint32_t sizes[2] = { static_cast<uint32_t>(mCommands.size()), static_cast<uint32_t>(mData.size()) };
+	if (std::fwrite(sizes, sizeof(sizes), 1, pFile) != 1)
+		return false;
+
+	if ((false == mCommands.empty()) && (std::fwrite(mCommands.data(), sizeof(Command), mCommands.size(), pFile) != mCommands.size()))
+		return false;
+
+	if ((false == mData.empty()) && (std::fwrite(mData.data(), 1, mData.size(), pFile) != mData.size()))
+		return false;
+
+	return true;
+}
+
+bool_t CommandStream::Read(std::FILE* pFile)
+{
+	assert(pFile != nullptr);
+
+	Clear();
+
+	uint32_t sizes[2] = { 0, 0 };
+	if (std::fread(sizes, sizeof(sizes), 1, pFile) != 1)
+		return false;
+
+	mCommands.resize(sizes[0]);
+	mData.resize(sizes[1]);
+
+	if ((false == mCommands.empty()) && (std::fread(mCommands.data(), sizeof(Command), mCommands.size(), pFile) != mCommands.size()))
+		return false;
+
+	if ((false == mData.empty()) && (std::fread(mData.data(), 1, mData.size(), pFile) != mData.size()))
+		return false;
+
+	for (const auto& command : mCommands)
+	{
+		if (command.type >= CommandType::GE_CT_COUNT)
+			return false;
+
+		if ((CommandType::GE_CT_UPDATE_UNIFORM_BUFFER == command.type) && (static_cast<uint64_t>(command.args[1]) + command.args[2] > mData.size()))
+			return false;
+
+		UpdateStats(command);
+	}
+
+	return true;
+}
+
+bool_t CommandStream::IsEqual(uint32_t commandIdx, const CommandStream& other, uint32_t otherCommandIdx, float32_t tolerance) const
+{
+	assert(commandIdx < mCommands.size());
+	assert(otherCommandIdx < other.mCommands.size());
+
+	const auto& lhs = mCommands[commandIdx];
+	const auto& rhs = other.mCommands[otherCommandIdx];
+
+	if (lhs.type != rhs.type)
+		return false;
+
+	if (lhs.type != CommandType::GE_CT_UPDATE_UNIFORM_BUFFER)
+	{
+		return (::memcmp(lhs.args, rhs.args, sizeof(lhs.args)) == 0);
+	}
+
+	// id and size, the offsets differ as soon as an earlier update differs
+	if ((lhs.args[0] != rhs.args[0]) || (lhs.args[2] != rhs.args[2]))
+		return false;
+
+	const uint8_t* pLhsData = mData.data() + lhs.args[1];
+	const uint8_t* pRhsData = other.mData.data() + rhs.args[1];
+	const uint32_t size = lhs.args[2];
+
+	if (tolerance <= 0.0f)
+	{
+		return (::memcmp(pLhsData, pRhsData, size) == 0);
+	}
+
+	for (uint32_t offset = 0; offset < size; offset += sizeof(float32_t))
+	{
+		if (size - offset < sizeof(float32_t))
+		{
+			return (::memcmp(pLhsData + offset, pRhsData + offset, size - offset) == 0);
+		}
+
+		float32_t lhsValue = 0.0f, rhsValue = 0.0f;
+		::memcpy(&lhsValue, pLhsData + offset, sizeof(float32_t));
+		::memcpy(&rhsValue, pRhsData + offset, sizeof(float32_t));
+
+		// also false for NaNs, unless bitwise identical
+		if ((false == (std::fabs(lhsValue - rhsValue) <= tolerance)) && (::memcmp(&lhsValue, &rhsValue, sizeof(float32_t)) != 0))
+			return false;
+	}
+
+	return true;
+}
+
+bool_t CommandStream::Compare(const CommandStream& lhs, const CommandStream& rhs, uint32_t& mismatchIdxOut, float32_t tolerance)
+{
+	const uint32_t count = static_cast<uint32_t>(std::min(lhs.mCommands.size(), rhs.mCommands.size()));
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (false == lhs.IsEqual(i, rhs, i, tolerance))
+		{
+			mismatchIdxOut = i;
+			return false;
+		}
+	}
+
+	mismatchIdxOut = count;
+
+	return (lhs.mCommands.size() == rhs.mCommands.size());
+}
+
+std::string CommandStream::ToString(uint32_t commandIdx) const
+{
+	if (commandIdx >= mCommands.size())
+		return "<none>";
+
+	const auto& command = mCommands[commandIdx];
+
+	std::stringstream ss;
+	ss << CommandTypeToStr(command.type);
+
+	switch (command.type)
+	{
+	case CommandType::GE_CT_BEGIN_FRAME:
+	case CommandType::GE_CT_END_FRAME:
+		ss << " frame: " << command.args[0];
+		break;
+	case CommandType::GE_CT_BEGIN_PASS:
+		ss << " type: " << command.args[0] << " passes: " << command.args[1];
+		break;
+	case CommandType::GE_CT_END_PASS:
+		ss << " type: " << command.args[0];
+		break;
+	case CommandType::GE_CT_BIND_PIPELINE:
+		ss << " id: " << command.args[0] << " pass type: " << command.args[1];
+		break;
+	case CommandType::GE_CT_BIND_VERTEX_BUFFER:
+	case CommandType::GE_CT_BIND_INDEX_BUFFER:
+		ss << " id: " << command.args[0];
+		break;
+	case CommandType::GE_CT_BIND_UNIFORM_BUFFER:
+		ss << " id: " << command.args[0] << " binding: " << command.args[1];
+		break;
+	case CommandType::GE_CT_BIND_TEXTURE:
+		ss << " id: " << command.args[0] << " stage: " << command.args[1] << " slot: " << command.args[2];
+		break;
+	case CommandType::GE_CT_UPDATE_UNIFORM_BUFFER:
+	{
+		ss << " id: " << command.args[0] << " size: " << command.args[2] << " data:";
+
+		const uint32_t size = std::min(command.args[2], MAX_PRINTED_DATA_SIZE);
+		const char_t* pHexDigits = "0123456789abcdef";
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			const uint8_t byte = mData[command.args[1] + i];
+			ss << ((i % 4) == 0 ? " " : "") << pHexDigits[byte >> 4] << pHexDigits[byte & 0xF];
+		}
+
+		if (command.args[2] > size)
+		{
+			ss << " ...";
+		}
+	} break;
+	case CommandType::GE_CT_DRAW:
+		ss << " vertices: " << command.args[0] << " first: " << command.args[1];
+		break;
+	case CommandType::GE_CT_DRAW_INDEXED:
+		ss << " indices: " << command.args[0] << " first: " << command.args[1] << " vertex offset: " << static_cast<int32_t>(command.args[2]);
+		break;
+	case CommandType::GE_CT_COUNT:
+	default:
+		break;
+	}
+
+	return ss.str();
+}
+
+const char_t* CommandStream::CommandTypeToStr(CommandType type)
+{
+	switch (type)
+	{
+	case CommandType::GE_CT_BEGIN_FRAME:
+		return "BeginFrame";
+	case CommandType::GE_CT_END_FRAME:
+		return "EndFrame";
+	case CommandType::GE_CT_BEGIN_PASS:
+		return "BeginPass";
+	case CommandType::GE_CT_END_PASS:
+		return "EndPass";
+	case CommandType::GE_CT_BIND_PIPELINE:
+		return "BindPipeline";
+	case CommandType::GE_CT_BIND_VERTEX_BUFFER:
+		return "BindVertexBuffer";
+	case CommandType::GE_CT_BIND_INDEX_BUFFER:
+		return "BindIndexBuffer";
+	case CommandType::GE_CT_BIND_UNIFORM_BUFFER:
+		return "BindUniformBuffer";
+	case CommandType::GE_CT_BIND_TEXTURE:
+		return "BindTexture";
+	case CommandType::GE_CT_UPDATE_UNIFORM_BUFFER:
+		return "UpdateUniformBuffer";
+	case CommandType::GE_CT_DRAW:
+		return "Draw";
+	case CommandType::GE_CT_DRAW_INDEXED:
+		return "DrawIndexed";
+	case CommandType::GE_CT_COUNT:
+	default:
+		return "Unknown";
+	}
+}
\ No newline at end of file
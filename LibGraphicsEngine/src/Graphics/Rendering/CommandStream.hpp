@@ -0,0 +1,109 @@
+#ifndef GRAPHICS_RENDERING_COMMAND_STREAM_HPP
+#define GRAPHICS_RENDERING_COMMAND_STREAM_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include <string>
+#include <vector>
+#include <cstdio>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/*
+			Compact recording of the commands of one frame: passes, binds, uniform buffer updates and draws.
+			Recorded by the null renderer (see Backends/Null) to test and benchmark the CPU side of the frame without a GPU.
+			The resources are identified by ids given in creation order, so the streams of two runs of the same scene can be compared.
+
+			File layout: header (magic, version), then per frame: command count, data size, the commands, the uniform bytes.
+			NOTE! Written in the host byte order, compare only streams recorded on the same kind of machine.
+		*/
+		class CommandStream
+		{
+		public:
+			enum class CommandType : uint8_t
+			{
+				GE_CT_BEGIN_FRAME = 0, // frame index
+				GE_CT_END_FRAME, // frame index
+				GE_CT_BEGIN_PASS, // pass type, pass count
+				GE_CT_END_PASS, // pass type
+				GE_CT_BIND_PIPELINE, // visual pass id, pass type
+				GE_CT_BIND_VERTEX_BUFFER, // id
+				GE_CT_BIND_INDEX_BUFFER, // id
+				GE_CT_BIND_UNIFORM_BUFFER, // id, binding
+				GE_CT_BIND_TEXTURE, // id, shader stage, slot
+				GE_CT_UPDATE_UNIFORM_BUFFER, // id, data offset, data size
+				GE_CT_DRAW, // vertex count, first vertex
+				GE_CT_DRAW_INDEXED, // index count, first index, vertex offset
+				GE_CT_COUNT
+			};
+
+			static const uint32_t ARG_COUNT = 4;
+
+			struct Command
+			{
+				CommandType type;
+				uint8_t padding[3]; // zeroed, so the written streams are deterministic
+				uint32_t args[ARG_COUNT];
+			};
+
+			struct Stats
+			{
+				Stats()
+					: passCount(0), bindCount(0), drawCount(0), elementCount(0)
+					, uniformUpdateCount(0), uniformByteCount(0)
+				{}
+
+				uint32_t passCount;
+				uint32_t bindCount;
+				uint32_t drawCount;
+				uint64_t elementCount; // vertices or indices drawn
+				uint32_t uniformUpdateCount;
+				uint64_t uniformByteCount;
+			};
+
+			CommandStream();
+			~CommandStream();
+
+			// keeps the memory for the next frame
+			void Clear();
+
+			void Record(CommandType type, uint32_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0, uint32_t arg3 = 0);
+			void RecordData(CommandType type, uint32_t id, const void* pData, uint32_t size);
+
+			const std::vector<Command>& GetCommands() const;
+			const std::vector<uint8_t>& GetData() const;
+			const CommandStream::Stats& GetStats() const;
+
+			// file
+			static bool_t WriteHeader(std::FILE* pFile);
+			static bool_t ReadHeader(std::FILE* pFile);
+
+			// one frame, Read() returns false at the end of the file
+			bool_t Write(std::FILE* pFile) const;
+			bool_t Read(std::FILE* pFile);
+
+			// the data of the uniform updates is compared, not its offset
+			// tolerance - if > 0 the uniform data is compared as float32_t values
+			bool_t IsEqual(uint32_t commandIdx, const CommandStream& other, uint32_t otherCommandIdx, float32_t tolerance = 0.0f) const;
+
+			// returns false on the first different command, mismatchIdxOut is its index
+			// if a stream is a prefix of the other, mismatchIdxOut is the shorter command count
+			static bool_t Compare(const CommandStream& lhs, const CommandStream& rhs, uint32_t& mismatchIdxOut, float32_t tolerance = 0.0f);
+
+			std::string ToString(uint32_t commandIdx) const;
+
+			static const char_t* CommandTypeToStr(CommandType type);
+
+		private:
+			void UpdateStats(const Command& command);
+
+			std::vector<Command> mCommands;
+			std::vector<uint8_t> mData;
+
+			Stats mStats;
+		};
+	}
+}
+
+#endif /* GRAPHICS_RENDERING_COMMAND_STREAM_HPP */
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "Graphics/Rendering/GBuffer.hpp"
+#include "Graphics/Rendering/Resources/RenderTarget.hpp"
+#include "Graphics/Rendering/Resources/Texture.hpp"
+#include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+GBuffer::GBuffer()
+	: mpAlbedoRT(nullptr)
+	, mpNormalRT(nullptr)
+	, mpMaterialRT(nullptr)
+	, mpDepthRT(nullptr)
+{}
+
+GBuffer::~GBuffer()
+{
+	Terminate();
+}
+
+void GBuffer::Init(uint32_t width, uint32_t height)
+{
+	assert(width > 0);
+	assert(height > 0);
+
+	Terminate();
+
+	mpAlbedoRT = GE_ALLOC(RenderTarget)(RenderTarget::TargetType::GE_TT_COLOR, RenderTarget::TargetOutput::GE_TO_RENDER_SAMPLING, width, height);
+	assert(mpAlbedoRT != nullptr);
+
+	// float data, the normals are signed
+	mpNormalRT = GE_ALLOC(RenderTarget)(RenderTarget::TargetType::GE_TT_COLOR_1, RenderTarget::TargetOutput::GE_TO_RENDER_SAMPLING, width, height, true);
+	assert(mpNormalRT != nullptr);
+
+	mpMaterialRT = GE_ALLOC(RenderTarget)(RenderTarget::TargetType::GE_TT_COLOR_2, RenderTarget::TargetOutput::GE_TO_RENDER_SAMPLING, width, height);
+	assert(mpMaterialRT != nullptr);
+
+	mpDepthRT = GE_ALLOC(RenderTarget)(RenderTarget::TargetType::GE_TT_DEPTH, RenderTarget::TargetOutput::GE_TO_RENDER_SAMPLING, width, height);
+	assert(mpDepthRT != nullptr);
+}
+
+void GBuffer::Terminate()
+{
+	GE_FREE(mpAlbedoRT);
+	GE_FREE(mpNormalRT);
+	GE_FREE(mpMaterialRT);
+	GE_FREE(mpDepthRT);
+}
+
+bool_t GBuffer::IsValid() const
+{
+	return (mpAlbedoRT != nullptr) && (mpNormalRT != nullptr) && (mpMaterialRT != nullptr) && (mpDepthRT != nullptr);
+}
+
+RenderTarget* GBuffer::GetAlbedoRT() const
+{
+	return mpAlbedoRT;
+}
+
+RenderTarget* GBuffer::GetNormalRT() const
+{
+	return mpNormalRT;
+}
+
+RenderTarget* GBuffer::GetMaterialRT() const
+{
+	return mpMaterialRT;
+}
+
+RenderTarget* GBuffer::GetDepthRT() const
+{
+	return mpDepthRT;
+}
+
+void GBuffer::AddRenderTargets(VisualPass* pVisualPass) const
+{
+	assert(pVisualPass != nullptr);
+	assert(pVisualPass->GetPassType() == VisualPass::PassType::GE_PT_GBUFFER);
+	assert(IsValid());
+
+	pVisualPass->AddRenderTarget(mpAlbedoRT);
+	pVisualPass->AddRenderTarget(mpNormalRT);
+	pVisualPass->AddRenderTarget(mpMaterialRT);
+	pVisualPass->AddRenderTarget(mpDepthRT);
+}
+
+RenderTarget* GBuffer::FindRenderTarget(const Texture* pTexture) const
+{
+	assert(pTexture != nullptr);
+
+	RenderTarget* renderTargets[] = { mpAlbedoRT, mpNormalRT, mpMaterialRT, mpDepthRT };
+	for (auto* pRT : renderTargets)
+	{
+		if (pRT && (pRT->GetTexture() == pTexture))
+			return pRT;
+	}
+
+	return nullptr;
+}
\ No newline at end of file
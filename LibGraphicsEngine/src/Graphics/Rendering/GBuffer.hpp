@@ -0,0 +1,60 @@
+#ifndef GRAPHICS_RENDERING_GBUFFER_HPP
+#define GRAPHICS_RENDERING_GBUFFER_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class RenderTarget;
+		class Texture;
+		class VisualPass;
+
+		/*
+			Deferred rendering G-buffer, window sized.
+			Written by the GE_PT_GBUFFER passes, then sampled by the full screen lighting passes,
+			one per light (see DeferredLightingVisualEffect), so the lighting cost is pixels x lights
+			and doesn't depend on the scene geometry.
+
+			Layout:
+				albedo - GE_TT_COLOR, RGBA8: base color
+				normal - GE_TT_COLOR_1, RGBA16F: world space normal
+				material - GE_TT_COLOR_2, RGBA8: specular intensity, shininess / 255
+				depth - GE_TT_DEPTH, D32: the lighting passes rebuild the world space position from it
+		*/
+		class GBuffer
+		{
+		public:
+			GBuffer();
+			~GBuffer();
+
+			void Init(uint32_t width, uint32_t height);
+			void Terminate();
+
+			bool_t IsValid() const;
+
+			RenderTarget* GetAlbedoRT() const;
+			RenderTarget* GetNormalRT() const;
+			RenderTarget* GetMaterialRT() const;
+			RenderTarget* GetDepthRT() const;
+
+			// adds the render targets to a G-buffer pass
+			void AddRenderTargets(VisualPass* pVisualPass) const;
+
+			// the render target of a G-buffer texture, nullptr if the texture is not part of the G-buffer
+			RenderTarget* FindRenderTarget(const Texture* pTexture) const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(GBuffer)
+
+			RenderTarget* mpAlbedoRT;
+			RenderTarget* mpNormalRT;
+			RenderTarget* mpMaterialRT;
+			RenderTarget* mpDepthRT;
+		};
+	}
+}
+
+#endif // GRAPHICS_RENDERING_GBUFFER_HPP
\ No newline at end of file
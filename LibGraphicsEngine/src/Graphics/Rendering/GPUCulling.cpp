@@ -0,0 +1,219 @@
+#include "Graphics/Rendering/GPUCulling.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "glm/geometric.hpp" // glm::dot()
+#include "glm/common.hpp" // glm::abs(), glm::max()
+#include "glm/matrix.hpp" // glm::inverse()
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// the buffers are read by the shader as is
+static_assert(sizeof(GPUCulling::Object) == 96, "std430 layout of Object");
+static_assert(sizeof(GPUCulling::Draw) == 80, "std430 layout of Draw");
+static_assert(sizeof(GPUCulling::Command) == 20, "layout of VkDrawIndexedIndirectCommand");
+static_assert(sizeof(GPUCulling::Uniform) == 128, "std140 layout of Uniform");
+
+GPUCulling::GPUCulling()
+	: mUniform{}
+{
+	mUniform.isCompacted = 1;
+}
+
+GPUCulling::~GPUCulling()
+{
+	Clear();
+}
+
+void GPUCulling::Clear()
+{
+	mObjects.clear();
+
+	ClearDraws();
+}
+
+void GPUCulling::ClearDraws()
+{
+	mDraws.clear();
+	mGroups.clear();
+
+	mUniform.drawCount = 0;
+}
+
+uint32_t GPUCulling::AddObject(const glm::vec3& localMin, const glm::vec3& localMax)
+{
+	Object object;
+	object.modelMatrix = glm::mat4(1.0f);
+	object.localMin = glm::vec4(localMin, 0.0f);
+	object.localMax = glm::vec4(localMax, 0.0f);
+
+	mObjects.push_back(object);
+
+	return static_cast<uint32_t>(mObjects.size() - 1);
+}
+
+void GPUCulling::SetModelMatrix(uint32_t objectIdx, const glm::mat4& modelMatrix)
+{
+	assert(objectIdx < mObjects.size());
+
+	mObjects[objectIdx].modelMatrix = modelMatrix;
+}
+
+uint32_t GPUCulling::AddGroup()
+{
+	Group group;
+	group.firstCommand = static_cast<uint32_t>(mDraws.size());
+	group.commandCount = 0;
+
+	mGroups.push_back(group);
+
+	return static_cast<uint32_t>(mGroups.size() - 1);
+}
+
+void GPUCulling::AddDraw(uint32_t objectIdx, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset,
+	const MeshletBuilder::MeshletBounds* pMeshletBounds)
+{
+	assert(objectIdx < mObjects.size());
+	assert(false == mGroups.empty());
+
+	auto& group = mGroups.back();
+
+	Draw draw;
+	draw.objectIdx = objectIdx;
+	draw.groupIdx = static_cast<uint32_t>(mGroups.size() - 1);
+	draw.firstCommand = group.firstCommand;
+	draw.indexCount = indexCount;
+	draw.instanceCount = instanceCount;
+	draw.firstIndex = firstIndex;
+	draw.vertexOffset = vertexOffset;
+	draw.firstInstance = 0;
+
+	if (pMeshletBounds)
+	{
+		draw.sphere = glm::vec4(pMeshletBounds->center, pMeshletBounds->radius);
+		draw.coneApex = glm::vec4(pMeshletBounds->coneApex, 0.0f);
+		draw.cone = glm::vec4(pMeshletBounds->coneAxis, pMeshletBounds->coneCutoff);
+	}
+	else
+	{
+		draw.sphere = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+		draw.coneApex = glm::vec4(0.0f);
+		draw.cone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
+	mDraws.push_back(draw);
+	group.commandCount++;
+
+	mUniform.drawCount = static_cast<uint32_t>(mDraws.size());
+}
+
+void GPUCulling::SetFrustum(const glm::mat4& projectionView)
+{
+	const Frustum frustum(projectionView);
+
+	for (uint8_t i = 0; i < static_cast<uint8_t>(Frustum::Plane::GE_FP_COUNT); ++i)
+	{
+		mUniform.planes[i] = frustum.GetPlane(static_cast<Frustum::Plane>(i));
+	}
+}
+
+void GPUCulling::SetCameraPosition(const glm::vec3& cameraPosition)
+{
+	mUniform.cameraPosition = glm::vec4(cameraPosition, 1.0f);
+}
+
+void GPUCulling::SetIsCompacted(bool_t isCompacted)
+{
+	mUniform.isCompacted = (isCompacted ? 1 : 0);
+}
+
+void GPUCulling::Cull(std::vector<uint32_t>& countsOut) const
+{
+	countsOut.assign(mGroups.size(), 0);
+
+	for (const auto& draw : mDraws)
+	{
+		assert(draw.objectIdx < mObjects.size());
+
+		const auto& object = mObjects[draw.objectIdx];
+		if (IsVisible(object) && IsMeshletVisible(object, draw))
+		{
+			countsOut[draw.groupIdx]++;
+		}
+	}
+}
+
+bool_t GPUCulling::IsVisible(const Object& object) const
+{
+	// world AABB of the transformed local AABB, see Arvo - Transforming Axis-Aligned Bounding Boxes (Graphics Gems)
+	// NOTE! Same operations as the shader, the center/extent form of the positive vertex test of Frustum::IntersectsAABB()
+	const glm::vec3 center = glm::vec3(object.localMin + object.localMax) * 0.5f;
+	const glm::vec3 extent = glm::vec3(object.localMax - object.localMin) * 0.5f;
+
+	const glm::vec3 worldCenter(object.modelMatrix * glm::vec4(center, 1.0f));
+	const glm::vec3 worldExtent = glm::abs(glm::vec3(object.modelMatrix[0])) * extent.x +
+		glm::abs(glm::vec3(object.modelMatrix[1])) * extent.y + glm::abs(glm::vec3(object.modelMatrix[2])) * extent.z;
+
+	for (const auto& plane : mUniform.planes)
+	{
+		const glm::vec3 normal(plane);
+
+		if (glm::dot(normal, worldCenter) + glm::dot(glm::abs(normal), worldExtent) + plane.w < 0.0f)
+			return false;
+	}
+
+	return true;
+}
+
+bool_t GPUCulling::IsMeshletVisible(const Object& object, const Draw& draw) const
+{
+	if (draw.sphere.w < 0.0f)
+		return true;
+
+	// NOTE! Same operations as the shader, see MeshletBuilder::IsMeshletVisible() for the model space version
+
+	// world space bounding sphere, the radius is scaled by the largest axis scale
+	const glm::vec3 worldCenter(object.modelMatrix * glm::vec4(glm::vec3(draw.sphere), 1.0f));
+	const float32_t scale = glm::max(glm::length(glm::vec3(object.modelMatrix[0])),
+		glm::max(glm::length(glm::vec3(object.modelMatrix[1])), glm::length(glm::vec3(object.modelMatrix[2]))));
+	const float32_t worldRadius = draw.sphere.w * scale;
+
+	for (const auto& plane : mUniform.planes)
+	{
+		if (glm::dot(glm::vec3(plane), worldCenter) + plane.w < -worldRadius)
+			return false;
+	}
+
+	// backface cone, in model space
+	if (draw.cone.w < 1.0f)
+	{
+		const glm::vec3 cameraPosition(glm::inverse(object.modelMatrix) * mUniform.cameraPosition);
+		const glm::vec3 toApex = glm::vec3(draw.coneApex) - cameraPosition;
+		const float32_t distance = glm::length(toApex);
+
+		if ((distance > 0.0f) && (glm::dot(toApex, glm::vec3(draw.cone)) >= draw.cone.w * distance))
+			return false;
+	}
+
+	return true;
+}
+
+const std::vector<GPUCulling::Object>& GPUCulling::GetObjects() const
+{
+	return mObjects;
+}
+
+const std::vector<GPUCulling::Draw>& GPUCulling::GetDraws() const
+{
+	return mDraws;
+}
+
+const std::vector<GPUCulling::Group>& GPUCulling::GetGroups() const
+{
+	return mGroups;
+}
+
+const GPUCulling::Uniform& GPUCulling::GetUniform() const
+{
+	return mUniform;
+}
\ No newline at end of file
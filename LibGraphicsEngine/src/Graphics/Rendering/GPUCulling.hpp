@@ -0,0 +1,129 @@
+#ifndef GRAPHICS_RENDERING_GPU_CULLING_HPP
+#define GRAPHICS_RENDERING_GPU_CULLING_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include "Graphics/GeometricPrimitives/MeshletBuilder.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/*
+			GPU driven frustum culling, the CPU side of res/shaders/Compute/drawCulling.comp.
+			The draws of the nodes are recorded once as indirect draws, a compute pass culls them each frame:
+			- objects: model matrix and model space AABB of a node, one per node
+			- draws: the indexed draw arguments of a node (e.g. one per model primitive), each draw belongs to an object and a group
+			  a meshlet draw also has the meshlet bounds, tested after its object - bounding sphere and backface cone, see MeshletBuilder
+			- groups: the draws recorded by a single indirect draw (same pipeline, descriptor sets and buffers), e.g. a node in a pass
+			The shader writes the draws of the visible objects as compacted VkDrawIndexedIndirectCommand(s) in the command range
+			of their group and counts them, the count is the draw count of vkCmdDrawIndexedIndirectCount.
+			Without the indirect count draws the commands are not compacted, the culled draws get 0 instances.
+
+			The buffers must be laid out as the structs below (std430, std140 for the uniform).
+			Cull() is the same test on the CPU, the reference of the GPU counts.
+			The order of the compacted commands in a group is not deterministic, their count is.
+		*/
+		class GPUCulling
+		{
+		public:
+			// local_size_x of the compute shader
+			static const uint32_t GROUP_SIZE = 64;
+
+			struct Object
+			{
+				glm::mat4 modelMatrix;
+				glm::vec4 localMin; // w unused
+				glm::vec4 localMax;
+			};
+
+			struct Draw
+			{
+				uint32_t objectIdx;
+				uint32_t groupIdx;
+				uint32_t firstCommand; // of the group
+				uint32_t indexCount;
+				uint32_t instanceCount;
+				uint32_t firstIndex;
+				int32_t vertexOffset;
+				uint32_t firstInstance;
+
+				// model space meshlet bounds, see MeshletBuilder::MeshletBounds
+				glm::vec4 sphere; // center + radius, radius < 0 if the draw is not a meshlet
+				glm::vec4 coneApex; // w unused
+				glm::vec4 cone; // axis + cutoff
+			};
+
+			// VkDrawIndexedIndirectCommand
+			struct Command
+			{
+				uint32_t indexCount;
+				uint32_t instanceCount;
+				uint32_t firstIndex;
+				int32_t vertexOffset;
+				uint32_t firstInstance;
+			};
+
+			struct Group
+			{
+				uint32_t firstCommand;
+				uint32_t commandCount; // max draw count
+			};
+
+			struct Uniform
+			{
+				glm::vec4 planes[6]; // see Frustum
+				uint32_t drawCount;
+				uint32_t isCompacted;
+				uint32_t padding[2];
+				glm::vec4 cameraPosition; // world space, w = 1 - the meshlet cone test uses inverse(model) * cameraPosition
+			};
+
+			GPUCulling();
+			~GPUCulling();
+
+			// removes the objects, draws and groups
+			void Clear();
+			// removes the draws and groups, e.g. the levels of the LOD nodes changed
+			void ClearDraws();
+
+			uint32_t AddObject(const glm::vec3& localMin, const glm::vec3& localMax);
+			void SetModelMatrix(uint32_t objectIdx, const glm::mat4& modelMatrix);
+
+			// the next draws are added to the new group
+			uint32_t AddGroup();
+			void AddDraw(uint32_t objectIdx, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset,
+				const MeshletBuilder::MeshletBounds* pMeshletBounds = nullptr);
+
+			void SetFrustum(const glm::mat4& projectionView);
+			void SetCameraPosition(const glm::vec3& cameraPosition);
+			void SetIsCompacted(bool_t isCompacted);
+
+			// the visible draws per group, as counted by the shader
+			void Cull(std::vector<uint32_t>& countsOut) const;
+
+			const std::vector<GPUCulling::Object>& GetObjects() const;
+			const std::vector<GPUCulling::Draw>& GetDraws() const;
+			const std::vector<GPUCulling::Group>& GetGroups() const;
+			const GPUCulling::Uniform& GetUniform() const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(GPUCulling)
+
+			bool_t IsVisible(const Object& object) const;
+			bool_t IsMeshletVisible(const Object& object, const Draw& draw) const;
+
+			std::vector<Object> mObjects;
+			std::vector<Draw> mDraws;
+			std::vector<Group> mGroups;
+
+			Uniform mUniform;
+		};
+	}
+}
+
+#endif // GRAPHICS_RENDERING_GPU_CULLING_HPP
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Graphics/Rendering/GPUTimings.hpp"
+#include "Foundation/Profiler.hpp"
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+#ifdef ENABLE_PROFILER
+namespace
+{
+	const char_t* GetPassZoneName(VisualPass::PassType passType)
+	{
+		switch (passType)
+		{
+		case VisualPass::PassType::GE_PT_OFFSCREEN:
+			return "OffscreenPass";
+		case VisualPass::PassType::GE_PT_SHADOWS:
+			return "ShadowsPass";
+		case VisualPass::PassType::GE_PT_GBUFFER:
+			return "GBufferPass";
+		case VisualPass::PassType::GE_PT_STANDARD:
+			return "StandardPass";
+		case VisualPass::PassType::GE_PT_COUNT:
+		default:
+			return "UnknownPass";
+		}
+	}
+}
+#endif // ENABLE_PROFILER
+
+GPUTimings::GPUTimings()
+{
+	Reset();
+}
+
+GPUTimings::~GPUTimings()
+{}
+
+void GPUTimings::Update(const std::vector<uint64_t>& timestamps, const std::vector<VisualPass::PassType>& passTypes, uint64_t cpuSubmitTime)
+{
+	assert(timestamps.size() >= GetQueryCount(static_cast<uint32_t>(passTypes.size())));
+
+#ifndef ENABLE_PROFILER
+	// only used to line up the GPU zones of the profiler
+	(void)cpuSubmitTime;
+#endif // ENABLE_PROFILER
+
+	const uint64_t frameBegin = timestamps[FRAME_BEGIN_QUERY];
+	const uint64_t frameEnd = timestamps[FRAME_END_QUERY];
+
+	// a wrapped around timestamp counter
+	if (frameEnd < frameBegin)
+		return;
+
+	mFrameTime = (frameEnd - frameBegin) * 1e-6;
+
+	for (auto& passTime : mPassTimes)
+	{
+		passTime = 0.0;
+	}
+
+	for (uint32_t passIndex = 0; passIndex < passTypes.size(); ++passIndex)
+	{
+		const uint64_t passBegin = timestamps[GetPassBeginQuery(passIndex)];
+		const uint64_t passEnd = timestamps[GetPassEndQuery(passIndex)];
+		if ((passEnd < passBegin) || (passBegin < frameBegin))
+			continue;
+
+		mPassTimes[static_cast<uint8_t>(passTypes[passIndex])] += (passEnd - passBegin) * 1e-6;
+
+#ifdef ENABLE_PROFILER
+		// the GPU starts right after the submission, close enough to line up the GPU zones with the CPU ones
+		Profiler::AddGPUZone(GetPassZoneName(passTypes[passIndex]), cpuSubmitTime + (passBegin - frameBegin), cpuSubmitTime + (passEnd - frameBegin), 1);
+#endif // ENABLE_PROFILER
+	}
+
+#ifdef ENABLE_PROFILER
+	Profiler::AddGPUZone("GPUFrame", cpuSubmitTime, cpuSubmitTime + (frameEnd - frameBegin), 0);
+#endif // ENABLE_PROFILER
+
+	mIsAvailable = true;
+}
+
+void GPUTimings::Reset()
+{
+	mIsAvailable = false;
+	mFrameTime = 0.0;
+
+	for (auto& passTime : mPassTimes)
+	{
+		passTime = 0.0;
+	}
+}
+
+bool_t GPUTimings::IsAvailable() const
+{
+	return mIsAvailable;
+}
+
+float64_t GPUTimings::GetFrameTime() const
+{
+	return mFrameTime;
+}
+
+float64_t GPUTimings::GetPassTime(VisualPass::PassType passType) const
+{
+	assert(passType < VisualPass::PassType::GE_PT_COUNT);
+
+	return mPassTimes[static_cast<uint8_t>(passType)];
+}
\ No newline at end of file
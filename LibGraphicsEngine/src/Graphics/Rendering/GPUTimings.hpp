@@ -0,0 +1,51 @@
+#ifndef GRAPHICS_RENDERING_GPU_TIMINGS_HPP
+#define GRAPHICS_RENDERING_GPU_TIMINGS_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/*
+			GPU times of the last completed frame, filled by the renderer backends from timestamp queries.
+			The backends keep the timestamps of each frame in flight apart and read them back only once
+			the frame is known to be done, so the CPU never waits for the GPU - the results are a few frames old.
+
+			Timestamps layout of a frame: frame begin, frame end, then begin/end pairs for each recorded pass.
+		*/
+		class GPUTimings
+		{
+		public:
+			static const uint32_t FRAME_BEGIN_QUERY = 0;
+			static const uint32_t FRAME_END_QUERY = 1;
+
+			static uint32_t GetQueryCount(uint32_t passCount) { return 2 + 2 * passCount; }
+			static uint32_t GetPassBeginQuery(uint32_t passIndex) { return 2 + 2 * passIndex; }
+			static uint32_t GetPassEndQuery(uint32_t passIndex) { return 3 + 2 * passIndex; }
+
+			GPUTimings();
+			~GPUTimings();
+
+			// timestamps of a completed frame, in ns
+			// cpuSubmitTime - profiler time of the frame submission, places the GPU zones on the CPU timeline
+			void Update(const std::vector<uint64_t>& timestamps, const std::vector<VisualPass::PassType>& passTypes, uint64_t cpuSubmitTime);
+			void Reset();
+
+			bool_t IsAvailable() const;
+
+			// in ms, 0 if not available
+			float64_t GetFrameTime() const;
+			float64_t GetPassTime(VisualPass::PassType passType) const;
+
+		private:
+			bool_t mIsAvailable;
+			float64_t mFrameTime;
+			float64_t mPassTimes[static_cast<uint8_t>(VisualPass::PassType::GE_PT_COUNT)];
+		};
+	}
+}
+
+#endif /* GRAPHICS_RENDERING_GPU_TIMINGS_HPP */
\ No newline at end of file
@@ -0,0 +1,564 @@
+#include "Graphics/Rendering/OcclusionBuffer.hpp"
+#include "Foundation/TaskScheduler.hpp"
+#include "Foundation/Profiler.hpp"
+#include "Core/AppConfig.hpp" // GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include "glm/vec4.hpp"
+#include <algorithm> // std::min(), std::max(), std::fill()
+#include <cmath> // std::floor(), std::abs()
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define GE_OCCLUSION_BUFFER_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// triangles with a smaller screen area (in pixels) are skipped
+static const float32_t MIN_TRIANGLE_AREA = 1e-6f;
+
+// mip levels built by the tile tasks, the next ones cover more than a tile
+static uint32_t TileLevelCount()
+{
+	uint32_t count = 0;
+	while ((OcclusionBuffer::TILE_SIZE >> count) > 1)
+	{
+		count++;
+	}
+	return count;
+}
+
+// signed distance to the near plane in clip space, >= 0 in front of it
+static float32_t NearDistance(const glm::vec4& clipPos)
+{
+#if defined(GLM_FORCE_DEPTH_ZERO_TO_ONE)
+	// clip space depth in [0, w]
+	return clipPos.z;
+#else
+	// clip space depth in [-w, w]
+	return clipPos.z + clipPos.w;
+#endif // GLM_FORCE_DEPTH_ZERO_TO_ONE
+}
+
+static float64_t ElapsedMs(uint64_t beginTime)
+{
+	return static_cast<float64_t>(Profiler::GetTime() - beginTime) * 1e-6;
+}
+
+OcclusionBuffer::OcclusionBuffer()
+	: mWidth(0)
+	, mHeight(0)
+	, mTileCountX(0)
+	, mTileCountY(0)
+	, mProjectionView(1.0f)
+{
+	Init(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+}
+
+OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height)
+	: mWidth(0)
+	, mHeight(0)
+	, mTileCountX(0)
+	, mTileCountY(0)
+	, mProjectionView(1.0f)
+{
+	Init(width, height);
+}
+
+OcclusionBuffer::~OcclusionBuffer()
+{}
+
+void OcclusionBuffer::Init(uint32_t width, uint32_t height)
+{
+	assert((width > 0) && (width % TILE_SIZE == 0));
+	assert((height > 0) && (height % TILE_SIZE == 0));
+
+	mWidth = width;
+	mHeight = height;
+	mTileCountX = width / TILE_SIZE;
+	mTileCountY = height / TILE_SIZE;
+
+	mTileBins.resize(mTileCountX * mTileCountY);
+
+	// down to a single texel, the odd sizes are rounded up
+	uint32_t levelWidth = width, levelHeight = height;
+	while (true)
+	{
+		mLevelWidths.push_back(levelWidth);
+		mLevelHeights.push_back(levelHeight);
+		mLevels.emplace_back(levelWidth * levelHeight, 0.0f);
+
+		if ((1 == levelWidth) && (1 == levelHeight))
+			break;
+
+		levelWidth = (levelWidth + 1) / 2;
+		levelHeight = (levelHeight + 1) / 2;
+	}
+}
+
+void OcclusionBuffer::Begin(const glm::mat4& projectionView)
+{
+	mProjectionView = projectionView;
+
+	mOccluders.clear();
+	mStats = Stats();
+}
+
+void OcclusionBuffer::AddOccluder(const glm::vec3* pPositions, uint32_t vertexCount, const uint32_t* pIndices, uint32_t indexCount, const glm::mat4& modelMatrix)
+{
+	assert(pPositions != nullptr);
+	assert(pIndices != nullptr);
+	assert(indexCount % 3 == 0);
+
+	Occluder occluder;
+	occluder.pPositions = pPositions;
+	occluder.vertexCount = vertexCount;
+	occluder.pIndices = pIndices;
+	occluder.indexCount = indexCount;
+	occluder.projectionViewModel = mProjectionView * modelMatrix;
+
+	mOccluders.push_back(occluder);
+}
+
+void OcclusionBuffer::Rasterize()
+{
+	GE_PROFILE_FUNCTION();
+
+	mStats.occluderCount = static_cast<uint32_t>(mOccluders.size());
+
+	//// setup ////
+
+	uint64_t beginTime = Profiler::GetTime();
+
+	mTriangles.resize(mOccluders.size());
+	TaskScheduler::ParallelFor(0, static_cast<uint32_t>(mOccluders.size()), 1, [this](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				mTriangles[i].clear();
+				SetupOccluder(mOccluders[i], mTriangles[i]);
+			}
+		});
+
+	for (auto& bin : mTileBins)
+	{
+		bin.clear();
+	}
+
+	for (uint32_t i = 0; i < mOccluders.size(); ++i)
+	{
+		for (const auto& triangle : mTriangles[i])
+		{
+			for (int32_t tileY = triangle.minY / TILE_SIZE; tileY <= triangle.maxY / static_cast<int32_t>(TILE_SIZE); ++tileY)
+			{
+				for (int32_t tileX = triangle.minX / TILE_SIZE; tileX <= triangle.maxX / static_cast<int32_t>(TILE_SIZE); ++tileX)
+				{
+					mTileBins[tileY * mTileCountX + tileX].push_back(&triangle);
+					mStats.binnedTriangleCount++;
+				}
+			}
+		}
+		mStats.triangleCount += static_cast<uint32_t>(mTriangles[i].size());
+	}
+
+	mStats.setupTime = ElapsedMs(beginTime);
+
+	//// raster ////
+
+	beginTime = Profiler::GetTime();
+
+	// each tile writes only its pixels
+	TaskScheduler::ParallelFor(0, mTileCountX * mTileCountY, 1, [this](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t tileIdx = begin; tileIdx < end; ++tileIdx)
+			{
+				RasterizeTile(tileIdx);
+			}
+		});
+
+	mStats.rasterTime = ElapsedMs(beginTime);
+
+	//// hierarchical depth ////
+
+	beginTime = Profiler::GetTime();
+
+	const uint32_t tileLevelCount = std::min(TileLevelCount(), GetLevelCount() - 1);
+
+	// the first mips of a tile depend only on its pixels
+	TaskScheduler::ParallelFor(0, mTileCountX * mTileCountY, 1, [this, tileLevelCount](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t tileIdx = begin; tileIdx < end; ++tileIdx)
+			{
+				const uint32_t tileX = tileIdx % mTileCountX;
+				const uint32_t tileY = tileIdx / mTileCountX;
+
+				for (uint32_t level = 1; level <= tileLevelCount; ++level)
+				{
+					const uint32_t size = TILE_SIZE >> level;
+					BuildHiZ(level, tileX * size, tileY * size, (tileX + 1) * size, (tileY + 1) * size);
+				}
+			}
+		});
+
+	for (uint32_t level = tileLevelCount + 1; level < GetLevelCount(); ++level)
+	{
+		BuildHiZ(level, 0, 0, mLevelWidths[level], mLevelHeights[level]);
+	}
+
+	mStats.hiZTime = ElapsedMs(beginTime);
+}
+
+void OcclusionBuffer::SetupOccluder(const Occluder& occluder, std::vector<Triangle>& trianglesOut) const
+{
+	std::vector<glm::vec4> clipPositions(occluder.vertexCount);
+	for (uint32_t i = 0; i < occluder.vertexCount; ++i)
+	{
+		clipPositions[i] = occluder.projectionViewModel * glm::vec4(occluder.pPositions[i], 1.0f);
+	}
+
+	for (uint32_t i = 0; i + 2 < occluder.indexCount; i += 3)
+	{
+		assert(occluder.pIndices[i] < occluder.vertexCount);
+		assert(occluder.pIndices[i + 1] < occluder.vertexCount);
+		assert(occluder.pIndices[i + 2] < occluder.vertexCount);
+
+		const glm::vec4 vertices[3] = { clipPositions[occluder.pIndices[i]], clipPositions[occluder.pIndices[i + 1]], clipPositions[occluder.pIndices[i + 2]] };
+		const float32_t distances[3] = { NearDistance(vertices[0]), NearDistance(vertices[1]), NearDistance(vertices[2]) };
+
+		if ((distances[0] >= 0.0f) && (distances[1] >= 0.0f) && (distances[2] >= 0.0f))
+		{
+			SetupTriangle(vertices[0], vertices[1], vertices[2], trianglesOut);
+			continue;
+		}
+
+		if ((distances[0] < 0.0f) && (distances[1] < 0.0f) && (distances[2] < 0.0f))
+			continue;
+
+		// clipped to the near plane: a triangle or a quad
+		glm::vec4 polygon[4];
+		uint32_t polygonSize = 0;
+		for (uint32_t j = 0; j < 3; ++j)
+		{
+			const uint32_t k = (j + 1) % 3;
+
+			if (distances[j] >= 0.0f)
+			{
+				polygon[polygonSize++] = vertices[j];
+			}
+			if ((distances[j] >= 0.0f) != (distances[k] >= 0.0f))
+			{
+				const float32_t t = distances[j] / (distances[j] - distances[k]);
+				polygon[polygonSize++] = vertices[j] + (vertices[k] - vertices[j]) * t;
+			}
+		}
+
+		for (uint32_t j = 2; j < polygonSize; ++j)
+		{
+			SetupTriangle(polygon[0], polygon[j - 1], polygon[j], trianglesOut);
+		}
+	}
+}
+
+void OcclusionBuffer::SetupTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2, std::vector<Triangle>& trianglesOut) const
+{
+	// w > 0 in front of the near plane
+	if ((v0.w <= 0.0f) || (v1.w <= 0.0f) || (v2.w <= 0.0f))
+		return;
+
+	// screen positions in pixels and 1 / w
+	const glm::vec4* pVertices[3] = { &v0, &v1, &v2 };
+	float32_t x[3], y[3], z[3];
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		z[i] = 1.0f / pVertices[i]->w;
+		x[i] = (pVertices[i]->x * z[i] * 0.5f + 0.5f) * static_cast<float32_t>(mWidth);
+		y[i] = (pVertices[i]->y * z[i] * 0.5f + 0.5f) * static_cast<float32_t>(mHeight);
+	}
+
+	float32_t area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (std::abs(area) < MIN_TRIANGLE_AREA)
+		return;
+
+	// both sides are drawn, the edges are made counter clockwise
+	if (area < 0.0f)
+	{
+		std::swap(x[1], x[2]);
+		std::swap(y[1], y[2]);
+		std::swap(z[1], z[2]);
+		area = -area;
+	}
+
+	const float32_t minX = std::max(std::min(std::min(x[0], x[1]), x[2]), 0.0f);
+	const float32_t maxX = std::min(std::max(std::max(x[0], x[1]), x[2]), static_cast<float32_t>(mWidth - 1));
+	const float32_t minY = std::max(std::min(std::min(y[0], y[1]), y[2]), 0.0f);
+	const float32_t maxY = std::min(std::max(std::max(y[0], y[1]), y[2]), static_cast<float32_t>(mHeight - 1));
+
+	// outside the screen
+	if ((minX > maxX) || (minY > maxY))
+		return;
+
+	Triangle triangle;
+
+	// a pixel is covered if its center is inside: the floor of the bounds includes all the centers
+	triangle.minX = static_cast<int32_t>(std::floor(minX));
+	triangle.maxX = static_cast<int32_t>(std::floor(maxX));
+	triangle.minY = static_cast<int32_t>(std::floor(minY));
+	triangle.maxY = static_cast<int32_t>(std::floor(maxY));
+
+	// edge j goes from vertex j + 1 to vertex j + 2, the inside is on its left
+	for (uint32_t j = 0; j < 3; ++j)
+	{
+		const uint32_t a = (j + 1) % 3;
+		const uint32_t b = (j + 2) % 3;
+
+		const float32_t edgeA = y[a] - y[b];
+		const float32_t edgeB = x[b] - x[a];
+
+		triangle.edgeA[j] = edgeA;
+		triangle.edgeB[j] = edgeB;
+		triangle.edgeC[j] = -(edgeA * x[a] + edgeB * y[a]) + 0.5f * (edgeA + edgeB);
+	}
+
+	// 1 / w is linear in screen space
+	const float32_t dzdx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+	const float32_t dzdy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+
+	// at the pixel center, moved to the farthest corner of the pixel
+	triangle.depthA = dzdx;
+	triangle.depthB = dzdy;
+	triangle.depthC = z[0] - dzdx * x[0] - dzdy * y[0] + 0.5f * (dzdx + dzdy) - 0.5f * (std::abs(dzdx) + std::abs(dzdy));
+	// the plane is extrapolated at the borders, the farthest vertex is a bound
+	triangle.minDepth = std::min(std::min(z[0], z[1]), z[2]);
+
+	trianglesOut.push_back(triangle);
+}
+
+void OcclusionBuffer::RasterizeTile(uint32_t tileIdx)
+{
+	const int32_t tileMinX = static_cast<int32_t>((tileIdx % mTileCountX) * TILE_SIZE);
+	const int32_t tileMinY = static_cast<int32_t>((tileIdx / mTileCountX) * TILE_SIZE);
+	const int32_t tileMaxX = tileMinX + static_cast<int32_t>(TILE_SIZE) - 1;
+	const int32_t tileMaxY = tileMinY + static_cast<int32_t>(TILE_SIZE) - 1;
+
+	float32_t* pDepth = mLevels[0].data();
+
+	for (int32_t y = tileMinY; y <= tileMaxY; ++y)
+	{
+		std::fill(pDepth + y * mWidth + tileMinX, pDepth + y * mWidth + tileMaxX + 1, 0.0f);
+	}
+
+	for (const auto* pTriangle : mTileBins[tileIdx])
+	{
+		const auto& triangle = *pTriangle;
+
+		// 4 pixels aligned groups, the tile size is a multiple of 4
+		const int32_t minX = std::max(triangle.minX, tileMinX) & ~3;
+		const int32_t maxX = std::min(triangle.maxX, tileMaxX);
+		const int32_t minY = std::max(triangle.minY, tileMinY);
+		const int32_t maxY = std::min(triangle.maxY, tileMaxY);
+
+		// NOTE! Both the SSE2 and scalar paths do the same float operations, so they give the same results
+#if defined(GE_OCCLUSION_BUFFER_SSE2)
+		const __m128 offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 edgeA0 = _mm_set1_ps(triangle.edgeA[0]);
+		const __m128 edgeA1 = _mm_set1_ps(triangle.edgeA[1]);
+		const __m128 edgeA2 = _mm_set1_ps(triangle.edgeA[2]);
+		const __m128 depthA = _mm_set1_ps(triangle.depthA);
+		const __m128 minDepth = _mm_set1_ps(triangle.minDepth);
+
+		for (int32_t y = minY; y <= maxY; ++y)
+		{
+			const float32_t fy = static_cast<float32_t>(y);
+			const __m128 row0 = _mm_set1_ps(triangle.edgeB[0] * fy + triangle.edgeC[0]);
+			const __m128 row1 = _mm_set1_ps(triangle.edgeB[1] * fy + triangle.edgeC[1]);
+			const __m128 row2 = _mm_set1_ps(triangle.edgeB[2] * fy + triangle.edgeC[2]);
+			const __m128 rowDepth = _mm_set1_ps(triangle.depthB * fy + triangle.depthC);
+
+			float32_t* pRow = pDepth + y * mWidth;
+			for (int32_t x = minX; x <= maxX; x += 4)
+			{
+				const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float32_t>(x)), offsets);
+
+				const __m128 e0 = _mm_add_ps(_mm_mul_ps(edgeA0, px), row0);
+				const __m128 e1 = _mm_add_ps(_mm_mul_ps(edgeA1, px), row1);
+				const __m128 e2 = _mm_add_ps(_mm_mul_ps(edgeA2, px), row2);
+				const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				if (0 == _mm_movemask_ps(inside))
+					continue;
+
+				const __m128 depth = _mm_max_ps(_mm_add_ps(_mm_mul_ps(depthA, px), rowDepth), minDepth);
+				const __m128 old = _mm_loadu_ps(pRow + x);
+				const __m128 nearest = _mm_max_ps(old, depth);
+
+				_mm_storeu_ps(pRow + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+			}
+		}
+#else
+		for (int32_t y = minY; y <= maxY; ++y)
+		{
+			const float32_t fy = static_cast<float32_t>(y);
+			const float32_t row0 = triangle.edgeB[0] * fy + triangle.edgeC[0];
+			const float32_t row1 = triangle.edgeB[1] * fy + triangle.edgeC[1];
+			const float32_t row2 = triangle.edgeB[2] * fy + triangle.edgeC[2];
+			const float32_t rowDepth = triangle.depthB * fy + triangle.depthC;
+
+			float32_t* pRow = pDepth + y * mWidth;
+			for (int32_t x = minX; x <= maxX; x += 4)
+			{
+				for (int32_t i = 0; i < 4; ++i)
+				{
+					const float32_t px = static_cast<float32_t>(x) + static_cast<float32_t>(i);
+
+					const float32_t e0 = triangle.edgeA[0] * px + row0;
+					const float32_t e1 = triangle.edgeA[1] * px + row1;
+					const float32_t e2 = triangle.edgeA[2] * px + row2;
+					if ((e0 >= 0.0f) && (e1 >= 0.0f) && (e2 >= 0.0f))
+					{
+						const float32_t depth = std::max(triangle.depthA * px + rowDepth, triangle.minDepth);
+						pRow[x + i] = std::max(pRow[x + i], depth);
+					}
+				}
+			}
+		}
+#endif // GE_OCCLUSION_BUFFER_SSE2
+	}
+}
+
+void OcclusionBuffer::BuildHiZ(uint32_t level, uint32_t beginX, uint32_t beginY, uint32_t endX, uint32_t endY)
+{
+	assert((level > 0) && (level < GetLevelCount()));
+
+	const auto& src = mLevels[level - 1];
+	auto& dst = mLevels[level];
+	const uint32_t srcWidth = mLevelWidths[level - 1];
+	const uint32_t srcHeight = mLevelHeights[level - 1];
+	const uint32_t dstWidth = mLevelWidths[level];
+
+	for (uint32_t y = beginY; y < endY; ++y)
+	{
+		const uint32_t y0 = 2 * y;
+		const uint32_t y1 = std::min(2 * y + 1, srcHeight - 1);
+
+		for (uint32_t x = beginX; x < endX; ++x)
+		{
+			const uint32_t x0 = 2 * x;
+			const uint32_t x1 = std::min(2 * x + 1, srcWidth - 1);
+
+			// the farthest depth
+			dst[y * dstWidth + x] = std::min(std::min(src[y0 * srcWidth + x0], src[y0 * srcWidth + x1]),
+				std::min(src[y1 * srcWidth + x0], src[y1 * srcWidth + x1]));
+		}
+	}
+}
+
+bool_t OcclusionBuffer::IsVisible(const glm::vec3& min, const glm::vec3& max) const
+{
+	float32_t minX = static_cast<float32_t>(mWidth), maxX = -1.0f;
+	float32_t minY = static_cast<float32_t>(mHeight), maxY = -1.0f;
+	float32_t nearestDepth = 0.0f;
+
+	for (uint32_t i = 0; i < 8; ++i)
+	{
+		const glm::vec3 corner((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+		const glm::vec4 clipPos = mProjectionView * glm::vec4(corner, 1.0f);
+
+		if ((NearDistance(clipPos) < 0.0f) || (clipPos.w <= 0.0f))
+			return true;
+
+		const float32_t z = 1.0f / clipPos.w;
+		const float32_t x = (clipPos.x * z * 0.5f + 0.5f) * static_cast<float32_t>(mWidth);
+		const float32_t y = (clipPos.y * z * 0.5f + 0.5f) * static_cast<float32_t>(mHeight);
+
+		minX = std::min(minX, x);
+		maxX = std::max(maxX, x);
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+		nearestDepth = std::max(nearestDepth, z);
+	}
+
+	// outside the screen, not occluded by anything drawn here
+	if ((maxX < 0.0f) || (maxY < 0.0f) || (minX >= static_cast<float32_t>(mWidth)) || (minY >= static_cast<float32_t>(mHeight)))
+		return true;
+
+	// all the pixels the rectangle touches
+	const uint32_t pixelMinX = static_cast<uint32_t>(std::max(minX, 0.0f));
+	const uint32_t pixelMaxX = static_cast<uint32_t>(std::min(maxX, static_cast<float32_t>(mWidth - 1)));
+	const uint32_t pixelMinY = static_cast<uint32_t>(std::max(minY, 0.0f));
+	const uint32_t pixelMaxY = static_cast<uint32_t>(std::min(maxY, static_cast<float32_t>(mHeight - 1)));
+
+	// the mip where the rectangle covers at most 2x2 texels
+	uint32_t level = 0;
+	while ((level + 1 < GetLevelCount()) &&
+		(((pixelMaxX >> level) - (pixelMinX >> level) > 1) || ((pixelMaxY >> level) - (pixelMinY >> level) > 1)))
+	{
+		level++;
+	}
+
+	const auto& texels = mLevels[level];
+	const uint32_t levelWidth = mLevelWidths[level];
+	for (uint32_t y = (pixelMinY >> level); y <= (pixelMaxY >> level); ++y)
+	{
+		for (uint32_t x = (pixelMinX >> level); x <= (pixelMaxX >> level); ++x)
+		{
+			// the farthest occluder of the texel is not in front of the box
+			if (texels[y * levelWidth + x] <= nearestDepth)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+void OcclusionBuffer::TestAABBs(const OcclusionBuffer::AABB* pBoxes, uint32_t boxCount, uint8_t* pVisibleOut)
+{
+	GE_PROFILE_FUNCTION();
+
+	assert((0 == boxCount) || (pBoxes && pVisibleOut));
+
+	const uint64_t beginTime = Profiler::GetTime();
+
+	TaskScheduler::ParallelFor(0, boxCount, 0, [this, pBoxes, pVisibleOut](uint32_t begin, uint32_t end)
+		{
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				pVisibleOut[i] = IsVisible(pBoxes[i].min, pBoxes[i].max) ? 1 : 0;
+			}
+		});
+
+	uint32_t occludedCount = 0;
+	for (uint32_t i = 0; i < boxCount; ++i)
+	{
+		occludedCount += (0 == pVisibleOut[i]) ? 1 : 0;
+	}
+
+	mStats.testedCount += boxCount;
+	mStats.occludedCount += occludedCount;
+	mStats.testTime += ElapsedMs(beginTime);
+}
+
+uint32_t OcclusionBuffer::GetWidth() const
+{
+	return mWidth;
+}
+
+uint32_t OcclusionBuffer::GetHeight() const
+{
+	return mHeight;
+}
+
+const std::vector<float32_t>& OcclusionBuffer::GetDepth() const
+{
+	return mLevels[0];
+}
+
+uint32_t OcclusionBuffer::GetLevelCount() const
+{
+	return static_cast<uint32_t>(mLevels.size());
+}
+
+const OcclusionBuffer::Stats& OcclusionBuffer::GetStats() const
+{
+	return mStats;
+}
\ No newline at end of file
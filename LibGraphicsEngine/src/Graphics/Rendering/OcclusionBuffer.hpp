@@ -0,0 +1,155 @@
+#ifndef GRAPHICS_RENDERING_OCCLUSION_BUFFER_HPP
+#define GRAPHICS_RENDERING_OCCLUSION_BUFFER_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include "glm/vec3.hpp"
+#include "glm/mat4x4.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/*
+			Software occlusion culling.
+			The occluders (simplified meshes of the big nodes, e.g. walls, floors) are rasterized on the CPU
+			in a small depth buffer, then the bounds of the other nodes are tested against it:
+			- setup: the occluder triangles are transformed, clipped to the near plane and binned to the screen tiles,
+			  one task per occluder
+			- raster: one task per tile, 4 pixels per SSE2 test, the depth is the nearest one (the max 1 / w)
+			- hierarchical depth: mips of the depth buffer, each texel keeps the farthest depth of the pixels it covers
+			- test: the screen rectangle of an AABB is tested against the mip where it covers at most 2x2 texels,
+			  the AABB is occluded if its nearest point is behind the farthest depth of all the texels
+
+			The occluders are sampled at the pixel centers and their depth is pushed to the farthest point of each pixel,
+			so an occluder is never nearer than it is. The tests are conservative: an AABB crossing the near plane
+			or outside the screen is visible (the frustum culling handles the last case).
+			The output is the same for any number of threads.
+
+			NOTE! The occluders are triangle lists, drawn on both sides.
+			based on: Hasselgren et al. - Masked Software Occlusion Culling (HPG 2016), Intel; Collin - Software Occlusion Culling (GDC 2011)
+		*/
+		class OcclusionBuffer
+		{
+		public:
+			static const uint32_t DEFAULT_WIDTH = 256;
+			static const uint32_t DEFAULT_HEIGHT = 128;
+			// the tiles rasterized by a task, the buffer size must be a multiple of it
+			static const uint32_t TILE_SIZE = 32;
+
+			struct AABB
+			{
+				glm::vec3 min;
+				glm::vec3 max;
+			};
+
+			// of the last frame, times in ms
+			struct Stats
+			{
+				Stats()
+					: occluderCount(0), triangleCount(0), binnedTriangleCount(0), testedCount(0), occludedCount(0)
+					, setupTime(0.0), rasterTime(0.0), hiZTime(0.0), testTime(0.0)
+				{}
+
+				uint32_t occluderCount;
+				uint32_t triangleCount; // after the near plane clipping, on the screen
+				uint32_t binnedTriangleCount; // triangles * tiles they touch
+				uint32_t testedCount;
+				uint32_t occludedCount;
+
+				float64_t setupTime;
+				float64_t rasterTime;
+				float64_t hiZTime;
+				float64_t testTime;
+			};
+
+			OcclusionBuffer();
+			explicit OcclusionBuffer(uint32_t width, uint32_t height);
+			~OcclusionBuffer();
+
+			// clears the occluders and the stats of the previous frame
+			void Begin(const glm::mat4& projectionView);
+
+			// NOTE! The data must be kept until Rasterize()
+			void AddOccluder(const glm::vec3* pPositions, uint32_t vertexCount, const uint32_t* pIndices, uint32_t indexCount, const glm::mat4& modelMatrix);
+
+			// draws the occluders and builds the hierarchical depth, see TaskScheduler::ParallelFor
+			void Rasterize();
+
+			// world space AABB, to be called after Rasterize()
+			bool_t IsVisible(const glm::vec3& min, const glm::vec3& max) const;
+			// pVisibleOut[i] is set to 1 if the box is visible, 0 if occluded, counted in the stats
+			void TestAABBs(const OcclusionBuffer::AABB* pBoxes, uint32_t boxCount, uint8_t* pVisibleOut);
+
+			uint32_t GetWidth() const;
+			uint32_t GetHeight() const;
+			// 1 / w of the nearest occluder per pixel, 0 where there are none, rows bottom to top
+			const std::vector<float32_t>& GetDepth() const;
+			uint32_t GetLevelCount() const;
+
+			const OcclusionBuffer::Stats& GetStats() const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(OcclusionBuffer)
+
+			struct Occluder
+			{
+				const glm::vec3* pPositions;
+				uint32_t vertexCount;
+				const uint32_t* pIndices;
+				uint32_t indexCount;
+				glm::mat4 projectionViewModel;
+			};
+
+			// a screen triangle, the functions are evaluated at the integer pixel coordinates
+			struct Triangle
+			{
+				// edge(x, y) = a * x + b * y + c, >= 0 inside, the pixel center offset is in c
+				float32_t edgeA[3];
+				float32_t edgeB[3];
+				float32_t edgeC[3];
+
+				// 1 / w at the farthest point of the pixel
+				float32_t depthA;
+				float32_t depthB;
+				float32_t depthC;
+				float32_t minDepth;
+
+				// pixel bounds, inclusive
+				int32_t minX;
+				int32_t minY;
+				int32_t maxX;
+				int32_t maxY;
+			};
+
+			void Init(uint32_t width, uint32_t height);
+
+			void SetupOccluder(const Occluder& occluder, std::vector<Triangle>& trianglesOut) const;
+			void SetupTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2, std::vector<Triangle>& trianglesOut) const;
+
+			void RasterizeTile(uint32_t tileIdx);
+			void BuildHiZ(uint32_t level, uint32_t beginX, uint32_t beginY, uint32_t endX, uint32_t endY);
+
+			uint32_t mWidth;
+			uint32_t mHeight;
+			uint32_t mTileCountX;
+			uint32_t mTileCountY;
+
+			glm::mat4 mProjectionView;
+
+			std::vector<Occluder> mOccluders;
+			std::vector<std::vector<Triangle>> mTriangles; // per occluder
+			std::vector<std::vector<const Triangle*>> mTileBins;
+
+			// level 0 is the depth buffer
+			std::vector<std::vector<float32_t>> mLevels;
+			std::vector<uint32_t> mLevelWidths;
+			std::vector<uint32_t> mLevelHeights;
+
+			Stats mStats;
+		};
+	}
+}
+
+#endif // GRAPHICS_RENDERING_OCCLUSION_BUFFER_HPP
\ No newline at end of file
@@ -0,0 +1,595 @@
+#include "Graphics/Rendering/RenderGraph.hpp"
+#include "Foundation/Logger.hpp"
+#include <algorithm> // std::sort()
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+namespace
+{
+	static const std::vector<RenderGraph::Barrier> EMPTY_BARRIERS;
+
+	static uint32_t GetBytesPerPixel(Texture::TextureFormat format)
+	{
+		const uint32_t value = static_cast<uint32_t>(format);
+
+		// 3 formats (UNORM, UINT, SINT) per channel count for 8 bits, 4 (+ SFLOAT) for 16 and 32 bits
+		if (format <= Texture::TextureFormat::GE_TF_R8G8B8A8_SINT)
+		{
+			return (value - static_cast<uint32_t>(Texture::TextureFormat::GE_TF_R8_UNORM)) / 3 + 1;
+		}
+		if (format <= Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT)
+		{
+			return 2 * ((value - static_cast<uint32_t>(Texture::TextureFormat::GE_TF_R16_UNORM)) / 4 + 1);
+		}
+		if (format <= Texture::TextureFormat::GE_TF_R32G32B32A32_SFLOAT)
+		{
+			return 4 * ((value - static_cast<uint32_t>(Texture::TextureFormat::GE_TF_R32_UNORM)) / 4 + 1);
+		}
+
+		switch (format)
+		{
+		case Texture::TextureFormat::GE_TF_D16:
+			return 2;
+		case Texture::TextureFormat::GE_TF_D24:
+		case Texture::TextureFormat::GE_TF_D32:
+		case Texture::TextureFormat::GE_TF_D16_S8:
+		case Texture::TextureFormat::GE_TF_D24_S8:
+			return 4;
+		case Texture::TextureFormat::GE_TF_D32_S8:
+			return 8;
+		default:
+			LOG_ERROR("Invalid texture format!");
+			return 0;
+		}
+	}
+
+	static bool_t IsOverlapping(uint32_t first1, uint32_t last1, uint32_t first2, uint32_t last2)
+	{
+		return (first1 <= last2) && (first2 <= last1);
+	}
+}
+
+const uint32_t RenderGraph::INVALID_HANDLE;
+const uint64_t RenderGraph::MEMORY_ALIGNMENT;
+
+RenderGraph::RenderGraph()
+	: mIsCompiled(false)
+{}
+
+RenderGraph::~RenderGraph()
+{
+	Reset();
+}
+
+void RenderGraph::Reset()
+{
+	mPasses.clear();
+	mResources.clear();
+
+	mIsCompiled = false;
+	mPassOrder.clear();
+	mFinalBarriers.clear();
+	mMemoryBlocks.clear();
+	mReport = Report();
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateTexture(const std::string& name, const TextureDesc& desc)
+{
+	assert((desc.width > 0) && (desc.height > 0));
+
+	Resource resource;
+	resource.name = name;
+	resource.desc = desc;
+	resource.isImported = false;
+	resource.initialState = ResourceState::GE_RS_UNDEFINED;
+	resource.finalState = ResourceState::GE_RS_UNDEFINED;
+	resource.firstUse = INVALID_HANDLE;
+	resource.lastUse = INVALID_HANDLE;
+	resource.memoryBlock = INVALID_HANDLE;
+
+	mResources.push_back(resource);
+	mIsCompiled = false;
+
+	return static_cast<ResourceHandle>(mResources.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::ImportTexture(const std::string& name, const TextureDesc& desc, ResourceState initialState, ResourceState finalState)
+{
+	const ResourceHandle handle = CreateTexture(name, desc);
+
+	Resource& resource = mResources[handle];
+	resource.isImported = true;
+	resource.initialState = initialState;
+	resource.finalState = finalState;
+
+	return handle;
+}
+
+RenderGraph::PassHandle RenderGraph::AddPass(const std::string& name, const ExecuteFunc& execute)
+{
+	Pass pass;
+	pass.name = name;
+	pass.execute = execute;
+	pass.hasSideEffects = false;
+	pass.isCulled = false;
+
+	mPasses.push_back(pass);
+	mIsCompiled = false;
+
+	return static_cast<PassHandle>(mPasses.size() - 1);
+}
+
+void RenderGraph::Read(PassHandle pass, ResourceHandle texture, ResourceState state)
+{
+	AddAccess(pass, texture, state, false);
+}
+
+void RenderGraph::Write(PassHandle pass, ResourceHandle texture, ResourceState state)
+{
+	assert(IsWriteState(state));
+
+	AddAccess(pass, texture, state, true);
+}
+
+void RenderGraph::AddAccess(PassHandle pass, ResourceHandle texture, ResourceState state, bool_t isWrite)
+{
+	assert(pass < mPasses.size());
+	assert(texture < mResources.size());
+	assert((state > ResourceState::GE_RS_UNDEFINED) && (state < ResourceState::GE_RS_COUNT));
+
+	mIsCompiled = false;
+
+	for (auto& access : mPasses[pass].accesses)
+	{
+		if (access.texture == texture)
+		{
+			// read and write of the same texture, e.g. blending or a depth test with depth writes
+			assert(access.state == state);
+
+			access.isWrite = (access.isWrite || isWrite);
+			access.isRead = (access.isRead || (false == isWrite));
+			return;
+		}
+	}
+
+	Access access;
+	access.texture = texture;
+	access.state = state;
+	access.isWrite = isWrite;
+	access.isRead = (false == isWrite);
+
+	mPasses[pass].accesses.push_back(access);
+}
+
+void RenderGraph::SetHasSideEffects(PassHandle pass)
+{
+	assert(pass < mPasses.size());
+
+	mPasses[pass].hasSideEffects = true;
+	mIsCompiled = false;
+}
+
+bool_t RenderGraph::Compile()
+{
+	if (mIsCompiled)
+		return true;
+
+	mPassOrder.clear();
+	mFinalBarriers.clear();
+	mMemoryBlocks.clear();
+	mReport = Report();
+
+	CullPasses();
+
+	if (false == ComputeLifetimes())
+		return false;
+
+	AliasTransients();
+	ComputeBarriers();
+	ComputeReport();
+
+	mIsCompiled = true;
+
+	return true;
+}
+
+bool_t RenderGraph::IsCompiled() const
+{
+	return mIsCompiled;
+}
+
+void RenderGraph::CullPasses()
+{
+	// backwards: a texture is needed if a later kept pass reads it, the imported textures are the outputs of the graph
+	std::vector<bool_t> isNeeded(mResources.size(), false);
+	for (uint32_t i = 0; i < mResources.size(); ++i)
+	{
+		isNeeded[i] = mResources[i].isImported;
+	}
+
+	for (uint32_t passIdx = static_cast<uint32_t>(mPasses.size()); passIdx-- > 0; )
+	{
+		Pass& pass = mPasses[passIdx];
+		pass.barriers.clear();
+
+		bool_t isKept = pass.hasSideEffects;
+		for (const auto& access : pass.accesses)
+		{
+			isKept = isKept || (access.isWrite && isNeeded[access.texture]);
+		}
+
+		pass.isCulled = (false == isKept);
+		if (pass.isCulled)
+			continue;
+
+		// the contents written here are all the later passes see, unless this pass reads them too
+		for (const auto& access : pass.accesses)
+		{
+			isNeeded[access.texture] = access.isRead;
+		}
+	}
+
+	for (uint32_t passIdx = 0; passIdx < mPasses.size(); ++passIdx)
+	{
+		if (false == mPasses[passIdx].isCulled)
+		{
+			mPassOrder.push_back(passIdx);
+		}
+	}
+}
+
+bool_t RenderGraph::ComputeLifetimes()
+{
+	for (auto& resource : mResources)
+	{
+		resource.firstUse = INVALID_HANDLE;
+		resource.lastUse = INVALID_HANDLE;
+		resource.memoryBlock = INVALID_HANDLE;
+	}
+
+	for (uint32_t orderIdx = 0; orderIdx < mPassOrder.size(); ++orderIdx)
+	{
+		const Pass& pass = mPasses[mPassOrder[orderIdx]];
+
+		for (const auto& access : pass.accesses)
+		{
+			Resource& resource = mResources[access.texture];
+
+			if (INVALID_HANDLE == resource.firstUse)
+			{
+				if ((false == resource.isImported) && access.isRead)
+				{
+					LOG_ERROR("Render graph: pass %s reads the transient texture %s before it is written!", pass.name.c_str(), resource.name.c_str());
+					return false;
+				}
+
+				resource.firstUse = orderIdx;
+			}
+			resource.lastUse = orderIdx;
+		}
+	}
+
+	return true;
+}
+
+void RenderGraph::AliasTransients()
+{
+	std::vector<ResourceHandle> transients;
+	for (uint32_t i = 0; i < mResources.size(); ++i)
+	{
+		if ((false == mResources[i].isImported) && (mResources[i].firstUse != INVALID_HANDLE))
+		{
+			transients.push_back(i);
+		}
+	}
+
+	// largest first, so a block is never smaller than the textures placed in it later
+	std::sort(transients.begin(), transients.end(),
+		[this](ResourceHandle lhs, ResourceHandle rhs)
+		{
+			const uint64_t lhsSize = ComputeMemorySize(mResources[lhs].desc);
+			const uint64_t rhsSize = ComputeMemorySize(mResources[rhs].desc);
+			if (lhsSize != rhsSize)
+				return (lhsSize > rhsSize);
+
+			return (mResources[lhs].firstUse < mResources[rhs].firstUse);
+		});
+
+	for (auto handle : transients)
+	{
+		Resource& resource = mResources[handle];
+		const uint64_t size = ComputeMemorySize(resource.desc);
+
+		for (uint32_t blockIdx = 0; blockIdx < mMemoryBlocks.size(); ++blockIdx)
+		{
+			const MemoryBlock& block = mMemoryBlocks[blockIdx];
+			if (block.size < size)
+				continue;
+
+			bool_t isFree = true;
+			for (auto other : block.resources)
+			{
+				isFree = isFree && (false == IsOverlapping(resource.firstUse, resource.lastUse, mResources[other].firstUse, mResources[other].lastUse));
+			}
+
+			if (isFree)
+			{
+				resource.memoryBlock = blockIdx;
+				break;
+			}
+		}
+
+		if (INVALID_HANDLE == resource.memoryBlock)
+		{
+			MemoryBlock block;
+			block.size = size;
+
+			mMemoryBlocks.push_back(block);
+			resource.memoryBlock = static_cast<uint32_t>(mMemoryBlocks.size() - 1);
+		}
+
+		auto& blockResources = mMemoryBlocks[resource.memoryBlock].resources;
+		blockResources.push_back(handle);
+		std::sort(blockResources.begin(), blockResources.end(),
+			[this](ResourceHandle lhs, ResourceHandle rhs)
+			{
+				return (mResources[lhs].firstUse < mResources[rhs].firstUse);
+			});
+	}
+}
+
+void RenderGraph::ComputeBarriers()
+{
+	std::vector<ResourceState> states(mResources.size());
+	std::vector<bool_t> isWritten(mResources.size(), false);
+	for (uint32_t i = 0; i < mResources.size(); ++i)
+	{
+		states[i] = mResources[i].initialState;
+	}
+
+	for (uint32_t orderIdx = 0; orderIdx < mPassOrder.size(); ++orderIdx)
+	{
+		Pass& pass = mPasses[mPassOrder[orderIdx]];
+
+		for (const auto& access : pass.accesses)
+		{
+			const ResourceHandle handle = access.texture;
+			const Resource& resource = mResources[handle];
+
+			Barrier barrier;
+			barrier.resource = handle;
+			barrier.oldState = states[handle];
+			barrier.newState = access.state;
+			barrier.isDiscard = (false == access.isRead);
+			barrier.aliasedResource = INVALID_HANDLE;
+			barrier.aliasedState = ResourceState::GE_RS_UNDEFINED;
+
+			if ((resource.firstUse == orderIdx) && (resource.memoryBlock != INVALID_HANDLE))
+			{
+				// the texture used the memory before this one
+				for (auto other : mMemoryBlocks[resource.memoryBlock].resources)
+				{
+					if (mResources[other].lastUse < orderIdx)
+					{
+						barrier.aliasedResource = other;
+						barrier.aliasedState = states[other];
+					}
+				}
+			}
+
+			// no hazard: read after read in the same state
+			const bool_t isNeeded = (barrier.oldState != barrier.newState) || isWritten[handle] || access.isWrite ||
+				(barrier.aliasedResource != INVALID_HANDLE);
+			if (isNeeded)
+			{
+				pass.barriers.push_back(barrier);
+			}
+
+			states[handle] = access.state;
+			isWritten[handle] = access.isWrite;
+		}
+	}
+
+	for (uint32_t i = 0; i < mResources.size(); ++i)
+	{
+		const Resource& resource = mResources[i];
+		if ((false == resource.isImported) || (ResourceState::GE_RS_UNDEFINED == resource.finalState) || (states[i] == resource.finalState))
+			continue;
+
+		Barrier barrier;
+		barrier.resource = i;
+		barrier.oldState = states[i];
+		barrier.newState = resource.finalState;
+		barrier.isDiscard = false;
+		barrier.aliasedResource = INVALID_HANDLE;
+		barrier.aliasedState = ResourceState::GE_RS_UNDEFINED;
+
+		mFinalBarriers.push_back(barrier);
+	}
+}
+
+void RenderGraph::ComputeReport()
+{
+	mReport.passCount = static_cast<uint32_t>(mPasses.size());
+	mReport.culledPassCount = static_cast<uint32_t>(mPasses.size() - mPassOrder.size());
+	mReport.textureCount = static_cast<uint32_t>(mResources.size());
+	mReport.memoryBlockCount = static_cast<uint32_t>(mMemoryBlocks.size());
+
+	for (const auto& resource : mResources)
+	{
+		if (resource.memoryBlock != INVALID_HANDLE)
+		{
+			mReport.transientCount++;
+			mReport.transientMemory += ComputeMemorySize(resource.desc);
+		}
+	}
+
+	for (const auto& block : mMemoryBlocks)
+	{
+		mReport.aliasedMemory += block.size;
+	}
+
+	for (auto passIdx : mPassOrder)
+	{
+		for (const auto& barrier : mPasses[passIdx].barriers)
+		{
+			mReport.barrierCount++;
+			mReport.transitionCount += ((barrier.oldState != barrier.newState) ? 1 : 0);
+		}
+	}
+
+	mReport.barrierCount += static_cast<uint32_t>(mFinalBarriers.size());
+	mReport.transitionCount += static_cast<uint32_t>(mFinalBarriers.size());
+}
+
+void RenderGraph::Execute(const BarrierFunc& barrierFunc) const
+{
+	assert(mIsCompiled);
+
+	for (auto passIdx : mPassOrder)
+	{
+		const Pass& pass = mPasses[passIdx];
+
+		if (barrierFunc && (false == pass.barriers.empty()))
+		{
+			barrierFunc(pass.barriers);
+		}
+
+		if (pass.execute)
+		{
+			pass.execute();
+		}
+	}
+
+	if (barrierFunc && (false == mFinalBarriers.empty()))
+	{
+		barrierFunc(mFinalBarriers);
+	}
+}
+
+bool_t RenderGraph::IsPassCulled(PassHandle pass) const
+{
+	assert(mIsCompiled);
+	assert(pass < mPasses.size());
+
+	return mPasses[pass].isCulled;
+}
+
+const std::vector<RenderGraph::PassHandle>& RenderGraph::GetPassOrder() const
+{
+	return mPassOrder;
+}
+
+const std::vector<RenderGraph::Barrier>& RenderGraph::GetBarriers(PassHandle pass) const
+{
+	assert(pass < mPasses.size());
+
+	return (mIsCompiled ? mPasses[pass].barriers : EMPTY_BARRIERS);
+}
+
+const std::vector<RenderGraph::Barrier>& RenderGraph::GetFinalBarriers() const
+{
+	return mFinalBarriers;
+}
+
+uint32_t RenderGraph::GetMemoryBlock(ResourceHandle texture) const
+{
+	assert(texture < mResources.size());
+
+	return mResources[texture].memoryBlock;
+}
+
+uint64_t RenderGraph::GetMemoryBlockSize(uint32_t block) const
+{
+	assert(block < mMemoryBlocks.size());
+
+	return mMemoryBlocks[block].size;
+}
+
+uint32_t RenderGraph::GetMemoryBlockCount() const
+{
+	return static_cast<uint32_t>(mMemoryBlocks.size());
+}
+
+const RenderGraph::Report& RenderGraph::GetReport() const
+{
+	return mReport;
+}
+
+uint32_t RenderGraph::GetPassCount() const
+{
+	return static_cast<uint32_t>(mPasses.size());
+}
+
+uint32_t RenderGraph::GetTextureCount() const
+{
+	return static_cast<uint32_t>(mResources.size());
+}
+
+const std::string& RenderGraph::GetPassName(PassHandle pass) const
+{
+	assert(pass < mPasses.size());
+
+	return mPasses[pass].name;
+}
+
+const std::string& RenderGraph::GetTextureName(ResourceHandle texture) const
+{
+	assert(texture < mResources.size());
+
+	return mResources[texture].name;
+}
+
+const RenderGraph::TextureDesc& RenderGraph::GetTextureDesc(ResourceHandle texture) const
+{
+	assert(texture < mResources.size());
+
+	return mResources[texture].desc;
+}
+
+bool_t RenderGraph::IsImported(ResourceHandle texture) const
+{
+	assert(texture < mResources.size());
+
+	return mResources[texture].isImported;
+}
+
+uint64_t RenderGraph::ComputeMemorySize(const TextureDesc& desc)
+{
+	const uint64_t size = static_cast<uint64_t>(desc.width) * desc.height * GetBytesPerPixel(desc.format);
+
+	return ((size + MEMORY_ALIGNMENT - 1) / MEMORY_ALIGNMENT) * MEMORY_ALIGNMENT;
+}
+
+bool_t RenderGraph::IsWriteState(ResourceState state)
+{
+	return (ResourceState::GE_RS_COLOR_ATTACHMENT == state) || (ResourceState::GE_RS_DEPTH_ATTACHMENT == state) ||
+		(ResourceState::GE_RS_TRANSFER_DST == state);
+}
+
+const char_t* RenderGraph::ResourceStateToStr(ResourceState state)
+{
+	switch (state)
+	{
+	case ResourceState::GE_RS_UNDEFINED:
+		return "Undefined";
+	case ResourceState::GE_RS_COLOR_ATTACHMENT:
+		return "ColorAttachment";
+	case ResourceState::GE_RS_DEPTH_ATTACHMENT:
+		return "DepthAttachment";
+	case ResourceState::GE_RS_DEPTH_READ:
+		return "DepthRead";
+	case ResourceState::GE_RS_SHADER_READ:
+		return "ShaderRead";
+	case ResourceState::GE_RS_TRANSFER_SRC:
+		return "TransferSrc";
+	case ResourceState::GE_RS_TRANSFER_DST:
+		return "TransferDst";
+	case ResourceState::GE_RS_PRESENT:
+		return "Present";
+	default:
+		return "Unknown";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+#ifndef GRAPHICS_RENDERING_RENDER_GRAPH_HPP
+#define GRAPHICS_RENDERING_RENDER_GRAPH_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include "Graphics/Rendering/Resources/Texture.hpp"
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/*
+			Frame graph: the passes of a frame declare which virtual textures they read and write, then Compile():
+			- culls the passes whose outputs are never used: a pass is kept if it writes an imported texture,
+			  a texture read by a later kept pass, or if it is marked with SetHasSideEffects()
+			- computes the barriers: a state (layout) transition when the state of a texture changes,
+			  or a memory dependency when a texture is written then used in the same state, nothing for read after read
+			- aliases the transient textures with disjoint lifetimes onto shared memory blocks
+
+			The passes run in the order they are added, the graph doesn't reorder them.
+			A pass which writes a texture without reading it discards its previous contents.
+			The imported textures (e.g. the swapchain images) are kept alive for the whole frame and are transitioned
+			to their final state after the last pass. The transient textures start undefined.
+
+			API agnostic and CPU only, the backend maps the states to its layouts/access masks (e.g. VulkanUtils).
+			The compiled graph is kept until the graph is changed, so a graph built once can be executed every frame.
+			The Vulkan render passes take their layouts, load ops and external dependencies from a graph of the pass types,
+			see VulkanRenderer::SetupFrameGraph(). No pipeline barriers are recorded from the graph.
+			NOTE! The aliasing is report only: the engine textures are owned by the render targets and the swapchain,
+			they are all imported, no backend allocates the memory blocks. See Tools/RenderGraphReport.
+		*/
+		class RenderGraph
+		{
+		public:
+			typedef uint32_t ResourceHandle;
+			typedef uint32_t PassHandle;
+
+			static const uint32_t INVALID_HANDLE = static_cast<uint32_t>(-1);
+
+			// memory granularity of the transient textures
+			static const uint64_t MEMORY_ALIGNMENT = 64 * 1024;
+
+			enum class ResourceState : uint8_t
+			{
+				GE_RS_UNDEFINED = 0,
+				GE_RS_COLOR_ATTACHMENT,
+				GE_RS_DEPTH_ATTACHMENT,
+				GE_RS_DEPTH_READ, // read only depth attachment, depth test without writes
+				GE_RS_SHADER_READ,
+				GE_RS_TRANSFER_SRC,
+				GE_RS_TRANSFER_DST,
+				GE_RS_PRESENT,
+				GE_RS_COUNT
+			};
+
+			struct TextureDesc
+			{
+				TextureDesc()
+					: width(0), height(0), format(Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM)
+				{}
+
+				TextureDesc(uint32_t width, uint32_t height, Texture::TextureFormat format)
+					: width(width), height(height), format(format)
+				{}
+
+				uint32_t width;
+				uint32_t height;
+				Texture::TextureFormat format;
+			};
+
+			struct Barrier
+			{
+				ResourceHandle resource;
+				ResourceState oldState; // GE_RS_UNDEFINED on the first use of a transient texture
+				ResourceState newState;
+				// the pass writes the texture without reading it, the old contents can be discarded
+				// (e.g. undefined old layout, don't care load op), the old state is still given for the synchronization
+				bool_t isDiscard;
+				// first use of a transient texture placed in the memory of another one, which must be done with it:
+				// the texture which used the memory last and its last state, INVALID_HANDLE if the memory is not aliased
+				ResourceHandle aliasedResource;
+				ResourceState aliasedState;
+			};
+
+			struct Report
+			{
+				Report()
+					: passCount(0), culledPassCount(0), textureCount(0), transientCount(0)
+					, barrierCount(0), transitionCount(0), memoryBlockCount(0)
+					, transientMemory(0), aliasedMemory(0)
+				{}
+
+				uint32_t passCount;
+				uint32_t culledPassCount;
+				uint32_t textureCount;
+				uint32_t transientCount; // of the kept passes
+				uint32_t barrierCount; // including the final transitions of the imported textures
+				uint32_t transitionCount; // barriers which change the state
+				uint32_t memoryBlockCount;
+				uint64_t transientMemory; // bytes, a memory block per transient texture
+				uint64_t aliasedMemory; // bytes, with the aliasing
+			};
+
+			typedef std::function<void()> ExecuteFunc;
+			typedef std::function<void(const std::vector<RenderGraph::Barrier>&)> BarrierFunc;
+
+			RenderGraph();
+			~RenderGraph();
+
+			// removes the passes and the textures
+			void Reset();
+
+			ResourceHandle CreateTexture(const std::string& name, const RenderGraph::TextureDesc& desc);
+			ResourceHandle ImportTexture(const std::string& name, const RenderGraph::TextureDesc& desc,
+				RenderGraph::ResourceState initialState, RenderGraph::ResourceState finalState);
+
+			PassHandle AddPass(const std::string& name, const RenderGraph::ExecuteFunc& execute = nullptr);
+
+			// a pass uses a texture in a single state
+			void Read(PassHandle pass, ResourceHandle texture, RenderGraph::ResourceState state = ResourceState::GE_RS_SHADER_READ);
+			void Write(PassHandle pass, ResourceHandle texture, RenderGraph::ResourceState state = ResourceState::GE_RS_COLOR_ATTACHMENT);
+
+			// the pass is never culled, e.g. it writes buffers or queries not tracked by the graph
+			void SetHasSideEffects(PassHandle pass);
+
+			// returns false if the graph is invalid, e.g. a transient texture read before it is written
+			bool_t Compile();
+			bool_t IsCompiled() const;
+
+			// runs the kept passes, the barrier func is called before each pass with its barriers (if any)
+			// and after the last pass with the final transitions
+			void Execute(const RenderGraph::BarrierFunc& barrierFunc) const;
+
+			//// compiled data ////
+
+			bool_t IsPassCulled(PassHandle pass) const;
+			// kept passes, in execution order
+			const std::vector<PassHandle>& GetPassOrder() const;
+			// barriers to record before a kept pass
+			const std::vector<RenderGraph::Barrier>& GetBarriers(PassHandle pass) const;
+			const std::vector<RenderGraph::Barrier>& GetFinalBarriers() const;
+
+			// memory block of a transient texture, INVALID_HANDLE for imported or unused textures
+			uint32_t GetMemoryBlock(ResourceHandle texture) const;
+			uint64_t GetMemoryBlockSize(uint32_t block) const;
+			uint32_t GetMemoryBlockCount() const;
+
+			const RenderGraph::Report& GetReport() const;
+
+			//// info ////
+
+			uint32_t GetPassCount() const;
+			uint32_t GetTextureCount() const;
+			const std::string& GetPassName(PassHandle pass) const;
+			const std::string& GetTextureName(ResourceHandle texture) const;
+			const RenderGraph::TextureDesc& GetTextureDesc(ResourceHandle texture) const;
+			bool_t IsImported(ResourceHandle texture) const;
+
+			// size of a transient texture, aligned to MEMORY_ALIGNMENT
+			static uint64_t ComputeMemorySize(const RenderGraph::TextureDesc& desc);
+
+			static bool_t IsWriteState(RenderGraph::ResourceState state);
+			static const char_t* ResourceStateToStr(RenderGraph::ResourceState state);
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(RenderGraph)
+
+			struct Access
+			{
+				ResourceHandle texture;
+				ResourceState state;
+				bool_t isWrite;
+				bool_t isRead;
+			};
+
+			struct Pass
+			{
+				std::string name;
+				ExecuteFunc execute;
+				std::vector<Access> accesses;
+				bool_t hasSideEffects;
+
+				// compiled
+				bool_t isCulled;
+				std::vector<Barrier> barriers;
+			};
+
+			struct Resource
+			{
+				std::string name;
+				TextureDesc desc;
+				bool_t isImported;
+				ResourceState initialState;
+				ResourceState finalState;
+
+				// compiled, indices in the pass order
+				uint32_t firstUse;
+				uint32_t lastUse;
+				uint32_t memoryBlock;
+			};
+
+			struct MemoryBlock
+			{
+				uint64_t size;
+				// textures placed in the block, by first use
+				std::vector<ResourceHandle> resources;
+			};
+
+			void AddAccess(PassHandle pass, ResourceHandle texture, ResourceState state, bool_t isWrite);
+
+			void CullPasses();
+			bool_t ComputeLifetimes();
+			void ComputeBarriers();
+			void AliasTransients();
+			void ComputeReport();
+
+			std::vector<Pass> mPasses;
+			std::vector<Resource> mResources;
+
+			// compiled
+			bool_t mIsCompiled;
+			std::vector<PassHandle> mPassOrder;
+			std::vector<Barrier> mFinalBarriers;
+			std::vector<MemoryBlock> mMemoryBlocks;
+			Report mReport;
+		};
+	}
+}
+
+#endif // GRAPHICS_RENDERING_RENDER_GRAPH_HPP
\ No newline at end of file
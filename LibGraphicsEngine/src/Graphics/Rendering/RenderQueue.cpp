@@ -42,6 +42,12 @@ void RenderQueue::Push(GeometryNode* pGeoNode)
 	renderable.pGeometryNode = pGeoNode;
 
 	mRenderables[RenderQueue::RenderableType::GE_RT_OPAQUE].push_back(renderable);
+
+	// also drawn in the occlusion buffer
+	if (pGeoNode->IsOccluder())
+	{
+		mRenderables[RenderQueue::RenderableType::GE_RT_OCCLUDER].push_back(renderable);
+	}
 }
 
 void RenderQueue::Push(LightNode* pLightNode)
@@ -51,7 +57,7 @@ void RenderQueue::Push(LightNode* pLightNode)
 	mLights.push_back(pLightNode);
 }
 
-void RenderQueue::ForEach(const RenderQueue::RenderableCollection& renderables, std::function< void(const RenderQueue::Renderable*) > callback)
+void RenderQueue::ForEach(const RenderQueue::RenderableCollection& renderables, const std::function< void(const RenderQueue::Renderable*) >& callback)
 {
 	assert(renderables.empty() == false);
 
@@ -61,7 +67,7 @@ void RenderQueue::ForEach(const RenderQueue::RenderableCollection& renderables,
 	}
 }
 
-void RenderQueue::ForEach(std::function< void(const LightNode*) > callback)
+void RenderQueue::ForEach(const std::function< void(const LightNode*) >& callback)
 {
 	for (auto* pLightNode : mLights)
 	{
@@ -77,6 +83,13 @@ const RenderQueue::RenderableCollection& RenderQueue::GetRenderables(const Rende
 	return mRenderables.at(type);
 }
 
+bool_t RenderQueue::HasRenderables(const RenderQueue::RenderableType& type) const
+{
+	auto it = mRenderables.find(type);
+
+	return (it != mRenderables.end()) && (it->second.empty() == false);
+}
+
 const std::vector<LightNode*>& RenderQueue::GetLights() const
 {
 	return mLights;
@@ -46,11 +46,12 @@ namespace GraphicsEngine
 			void Push(GeometryNode* pGeoNode);
 			void Push(LightNode* pLightNode);
 
-			void ForEach(const RenderQueue::RenderableCollection& renderables, std::function< void(const RenderQueue::Renderable*) > callback);
-			void ForEach(std::function< void(const LightNode*) > callback);
+			void ForEach(const RenderQueue::RenderableCollection& renderables, const std::function< void(const RenderQueue::Renderable*) >& callback);
+			void ForEach(const std::function< void(const LightNode*) >& callback);
 
 
 			const RenderQueue::RenderableCollection& GetRenderables(const RenderQueue::RenderableType& type) const;
+			bool_t HasRenderables(const RenderQueue::RenderableType& type) const;
 
 			const std::vector<LightNode*>& GetLights() const;
 			bool_t HasLights() const;
@@ -11,6 +11,51 @@
 #include "Graphics/Rendering/Resources/Material.hpp"
 #include "Graphics/Rendering/Resources/Model.hpp"
 #include "Graphics/SceneGraph/GeometryNode.hpp"
+#include "Graphics/SceneGraph/LightNode.hpp"
+#include "Graphics/Cameras/Camera.hpp"
+#if defined(DEFERRED_RENDERING)
+#include "Graphics/Components/VisualComponent.hpp"
+#include "Graphics/Rendering/VisualEffects/LitEffects/DeferredLightingVisualEffect.hpp"
+#include "Graphics/Lights/Light.hpp"
+#endif // DEFERRED_RENDERING
+#if defined(CLUSTERED_LIGHTING)
+#include "Graphics/Lights/Light.hpp"
+#endif // CLUSTERED_LIGHTING
+#if defined(SCENE_CULLING)
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "glm/common.hpp" // glm::min(), glm::max(), glm::abs()
+#include <limits>
+#include <utility> // std::swap()
+#endif // SCENE_CULLING
+#if defined(OCCLUSION_CULLING)
+#include "Foundation/MemoryManagement/StlAllocator.hpp"
+#include <utility> // std::move()
+#endif // OCCLUSION_CULLING
+#if defined(LEVEL_OF_DETAIL)
+#include "Graphics/SceneGraph/LODGeometryNode.hpp"
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include <algorithm> // std::find()
+#endif // LEVEL_OF_DETAIL
+#if defined(GPU_CULLING)
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "glm/common.hpp" // glm::min(), glm::max()
+#include <limits>
+#endif // GPU_CULLING
+#if defined(CASCADED_SHADOWS)
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "Graphics/Lights/Light.hpp"
+#include "glm/common.hpp" // glm::min(), glm::max(), glm::abs()
+#include "glm/trigonometric.hpp" // glm::radians()
+#include <limits>
+#endif // CASCADED_SHADOWS
+#if defined(SHADOW_CACHING)
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "Graphics/Lights/Light.hpp"
+#include "glm/common.hpp" // glm::min(), glm::max()
+#include <algorithm> // std::find()
+#include <limits>
+#endif // SHADOW_CACHING
 
 // Resources
 #if defined(VULKAN_RENDERER)
@@ -33,6 +78,16 @@
 #include "Graphics/Rendering/Backends/OpenGL/Resources/OpenGLShader.hpp"
 #include "Graphics/Rendering/Backends/OpenGL/Resources/OpenGLMaterial.hpp"
 #include "Graphics/Rendering/Backends/OpenGL/Resources/OpenGLModel.hpp"
+#elif defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/VisualPasses/NullVisualPass.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullVertexFormat.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullVertexBuffer.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullIndexBuffer.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullUniformBuffer.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullTexture.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullShader.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullMaterial.hpp"
+#include "Graphics/Rendering/Backends/Null/Resources/NullModel.hpp"
 #endif //
 
 #include "Foundation/Platform/Platform.hpp"
@@ -49,7 +104,20 @@ Renderer::Renderer()
 	, mWindowHeight(0)
 	, mpRenderQueue(nullptr)
 	, mpCamera(nullptr)
-{}
+	, mFrameAllocator(FRAME_ARENA_COUNT)
+#if defined(SCENE_CULLING)
+	, mCullingFrame(0)
+	, mHiddenRecordedCount(0)
+#endif // SCENE_CULLING
+#if defined(OCCLUSION_CULLING)
+	, mOcclusionFrameCount(0)
+#endif // OCCLUSION_CULLING
+#if defined(SHADOW_CACHING)
+	, mShadowCacheFaceMask(0)
+#endif // SHADOW_CACHING
+{
+	mFrameAllocator.Init(FRAME_ARENA_SIZE);
+}
 
 Renderer::Renderer(Platform::Window* pWindow, Renderer::RendererType type)
 	: mRendererType(type)
@@ -58,7 +126,20 @@ Renderer::Renderer(Platform::Window* pWindow, Renderer::RendererType type)
 	, mWindowHeight(0)
 	, mpRenderQueue(nullptr)
 	, mpCamera(nullptr)
+	, mFrameAllocator(FRAME_ARENA_COUNT)
+#if defined(SCENE_CULLING)
+	, mCullingFrame(0)
+	, mHiddenRecordedCount(0)
+#endif // SCENE_CULLING
+#if defined(OCCLUSION_CULLING)
+	, mOcclusionFrameCount(0)
+#endif // OCCLUSION_CULLING
+#if defined(SHADOW_CACHING)
+	, mShadowCacheFaceMask(0)
+#endif // SHADOW_CACHING
 {
+	mFrameAllocator.Init(FRAME_ARENA_SIZE);
+
 	Init(pWindow);
 }
 
@@ -72,6 +153,13 @@ void Renderer::Init(Platform::Window* pWindow)
 	assert(pWindow != nullptr);
 	
 	pWindow->GetWindowSize(&mWindowWidth, &mWindowHeight);
+
+#if defined(DEFERRED_RENDERING)
+	if (mRendererType == RendererType::GE_RT_DEFERRED)
+	{
+		mGBuffer.Init(mWindowWidth, mWindowHeight);
+	}
+#endif // DEFERRED_RENDERING
 }
 
 
@@ -83,7 +171,91 @@ void Renderer::Terminate()
 	mpRenderQueue = nullptr;
 	mpCamera = nullptr;
 
+	if (mFrameAllocator.TotalSize() > 0)
+	{
+		LOG_INFO("Frame arena high-water mark: %llu of %llu bytes", static_cast<unsigned long long>(mFrameAllocator.Peak()), static_cast<unsigned long long>(FRAME_ARENA_SIZE));
+
+		mFrameAllocator.Terminate();
+	}
+
 	CleanUpResources();
+
+#if defined(DEFERRED_RENDERING)
+	DestroyLightingEffects();
+
+	mGBuffer.Terminate();
+#endif // DEFERRED_RENDERING
+
+#if defined(SCENE_CULLING)
+	mSceneTree.Clear();
+	mSceneProxies.clear();
+	mVisibleProxies.clear();
+	mQueryProxies.clear();
+	mRecordedProxies.clear();
+	mHiddenRecordedCount = 0;
+#endif // SCENE_CULLING
+
+#if defined(OCCLUSION_CULLING)
+	if (mOcclusionFrameCount > 0)
+	{
+		const auto& stats = mOcclusionTotalStats;
+		const float64_t frameCount = static_cast<float64_t>(mOcclusionFrameCount);
+
+		LOG_INFO("Occlusion culling: %u of %u tested nodes occluded over %u frames, per frame: %.1f triangles, setup %.3f ms, raster %.3f ms, hi-z %.3f ms, test %.3f ms",
+			stats.occludedCount, stats.testedCount, mOcclusionFrameCount, stats.triangleCount / frameCount,
+			stats.setupTime / frameCount, stats.rasterTime / frameCount, stats.hiZTime / frameCount, stats.testTime / frameCount);
+	}
+	mOcclusionTotalStats = OcclusionBuffer::Stats();
+	mOcclusionFrameCount = 0;
+
+	mOccluderMeshes.clear();
+#endif // OCCLUSION_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+	if (mLODStats.frameCount > 0)
+	{
+		const float64_t frameCount = static_cast<float64_t>(mLODStats.frameCount);
+
+		LOG_INFO("Levels of detail: %.1f triangles per frame, %.1f at full detail (%.1f%%), %u level switches over %u frames",
+			mLODStats.triangleCount / frameCount, mLODStats.fullDetailTriangleCount / frameCount,
+			(mLODStats.fullDetailTriangleCount > 0) ? 100.0 * mLODStats.triangleCount / mLODStats.fullDetailTriangleCount : 100.0,
+			mLODStats.switchCount, mLODStats.frameCount);
+	}
+	mLODStats = LODStats();
+
+	mLODNodes.clear();
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+	if (mShadowStats.frameCount > 0)
+	{
+		const float64_t frameCount = static_cast<float64_t>(mShadowStats.frameCount);
+
+		LOG_INFO("Cascaded shadows: %.1f caster draws per frame for %.1f casters in %u cascades (%.1f%% of the draws without the caster culling)",
+			mShadowStats.cascadeDrawCount / frameCount, mShadowStats.casterCount / frameCount, mShadowCascades.GetCascadeCount(),
+			(mShadowStats.casterCount > 0) ? 100.0 * mShadowStats.cascadeDrawCount / (mShadowStats.casterCount * mShadowCascades.GetCascadeCount()) : 100.0);
+	}
+	mShadowStats = ShadowStats();
+
+	mShadowCasters.clear();
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+	if (mShadowCacheStats.frameCount > 0)
+	{
+		const float64_t frameCount = static_cast<float64_t>(mShadowCacheStats.frameCount);
+
+		LOG_INFO("Shadow cache: %.2f faces and %.1f casters rendered per frame, %u static and %u dynamic casters",
+			mShadowCacheStats.faceCount / frameCount, mShadowCacheStats.casterCount / frameCount,
+			static_cast<uint32_t>(mShadowCacheCasters.size()), static_cast<uint32_t>(mShadowDynamicCasters.size()));
+	}
+	mShadowCacheStats = ShadowCacheStats();
+
+	mShadowCache.Clear();
+	mShadowCacheCasters.clear();
+	mShadowDynamicCasters.clear();
+	mShadowCacheFaceMask = 0;
+#endif // SHADOW_CACHING
 }
 
 void Renderer::CleanUpResources()
@@ -208,6 +380,848 @@ void Renderer::CleanUpGAIR()
 	//TODO - other resources
 }
 
+#if defined(CLUSTERED_LIGHTING)
+void Renderer::UpdateLightClusters(Camera* pCamera)
+{
+	assert(pCamera != nullptr);
+	assert(mpRenderQueue != nullptr);
+
+	mClusterLights.clear();
+	for (auto* pLightNode : mpRenderQueue->GetLights())
+	{
+		assert(pLightNode != nullptr);
+
+		auto* pLight = pLightNode->GetLight();
+		if ((nullptr == pLight) || (pLight->GetLightType() == Light::LightType::GE_LT_DIRECTIONAL))
+			continue;
+
+		if (mClusterLights.size() == LightClusterGrid::MAX_LIGHT_COUNT)
+		{
+			static bool_t isWarned = false;
+			if (false == isWarned)
+			{
+				LOG_WARNING("More than %u point and spot lights, the others are not binned!", LightClusterGrid::MAX_LIGHT_COUNT);
+				isWarned = true;
+			}
+			break;
+		}
+
+		mClusterLights.push_back(pLight);
+	}
+
+	mLightClusterGrid.Update(pCamera->GetViewMatrix(), pCamera->GetProjectionMatrix(), pCamera->GetZNear(), pCamera->GetZFar(), mClusterLights);
+}
+#endif // CLUSTERED_LIGHTING
+
+#if defined(DEFERRED_RENDERING)
+void Renderer::CreateLightingEffects()
+{
+	assert(mpRenderQueue != nullptr);
+	assert(mGBuffer.IsValid());
+
+	DestroyLightingEffects();
+
+	std::vector<const Light*> lights;
+	for (auto* pLightNode : mpRenderQueue->GetLights())
+	{
+		assert(pLightNode != nullptr);
+
+		auto* pLight = pLightNode->GetLight();
+		if (nullptr == pLight)
+			continue;
+
+		// same lights as the forward lit effects, the spot lights are not supported yet
+		if ((pLight->GetLightType() != Light::LightType::GE_LT_DIRECTIONAL) &&
+			(pLight->GetLightType() != Light::LightType::GE_LT_POINT))
+		{
+			LOG_INFO("Light type not supported by the deferred lighting, skipped!");
+			continue;
+		}
+
+		lights.push_back(pLight);
+	}
+
+	// without a light the G-buffer is still composited, with the ambient only, and its depth restored
+	if (lights.empty())
+	{
+		lights.push_back(nullptr);
+	}
+
+	for (auto* pLight : lights)
+	{
+		auto* pNode = GE_ALLOC(GeometryNode)("DeferredLighting");
+		assert(pNode != nullptr);
+
+		// the first light overwrites the screen and adds the ambient, the next ones are added to it
+		auto* pEffect = GE_ALLOC(DeferredLightingVisualEffect)(pLight, (false == mLightingEffects.empty()));
+		assert(pEffect != nullptr);
+
+		pEffect->SetTargetNode(pNode);
+		pNode->GetComponent<VisualComponent>()->SetVisualEffect(pEffect);
+
+		pEffect->Init(this);
+
+		mLightingNodes.push_back(pNode);
+		mLightingEffects.push_back(pEffect);
+	}
+}
+
+void Renderer::DestroyLightingEffects()
+{
+	mLightingEffects.clear();
+
+	for (auto* pNode : mLightingNodes)
+	{
+		GE_FREE(pNode);
+	}
+	mLightingNodes.clear();
+}
+#endif // DEFERRED_RENDERING
+
+#if defined(SCENE_CULLING) || defined(GPU_CULLING) || defined(CASCADED_SHADOWS) || defined(SHADOW_CACHING)
+// model space positions, false if the geometry has no float positions
+static bool_t GetPositions(const GeometricPrimitive* pGeometry, std::vector<glm::vec3>& positionsOut)
+{
+	auto* pVertexBuffer = (pGeometry ? pGeometry->GetVertexBuffer() : nullptr);
+	if ((nullptr == pVertexBuffer) || (nullptr == pVertexBuffer->GetData()) || (0 == pVertexBuffer->GetVertexCount()))
+		return false;
+
+	auto* pFormat = pVertexBuffer->GetFormat();
+	assert(pFormat != nullptr);
+	if ((false == pFormat->HasVertexAttribute(VertexFormat::VertexAttribute::GE_VA_POSITION)) ||
+		(pFormat->GetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_POSITION) != VertexFormat::AttributeType::GE_AT_FLOAT32))
+		return false;
+
+	const uint32_t stride = pFormat->GetVertexTotalStride();
+	const uint32_t offset = pFormat->GetVertexAttributeOffset(VertexFormat::VertexAttribute::GE_VA_POSITION);
+	const uint8_t* pData = static_cast<const uint8_t*>(pVertexBuffer->GetData());
+
+	positionsOut.resize(pVertexBuffer->GetVertexCount());
+	for (uint32_t i = 0; i < pVertexBuffer->GetVertexCount(); ++i)
+	{
+		const float32_t* pPosition = reinterpret_cast<const float32_t*>(pData + i * stride + offset);
+		positionsOut[i] = glm::vec3(pPosition[0], pPosition[1], pPosition[2]);
+	}
+
+	return true;
+}
+#endif // defined(SCENE_CULLING) || defined(GPU_CULLING) || defined(CASCADED_SHADOWS) || defined(SHADOW_CACHING)
+
+#if defined(SCENE_CULLING)
+// the command buffers recorded upfront are recorded again when more than 1 in SCENE_CULLING_MAX_HIDDEN_RATIO of their nodes are hidden
+static const uint32_t SCENE_CULLING_MAX_HIDDEN_RATIO = 4;
+
+// world AABB of the transformed local AABB, see Arvo - Transforming Axis-Aligned Bounding Boxes (Graphics Gems)
+static void ComputeWorldBounds(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& modelMatrix, glm::vec3& worldMinOut, glm::vec3& worldMaxOut)
+{
+	const glm::vec3 center = (localMin + localMax) * 0.5f;
+	const glm::vec3 extent = (localMax - localMin) * 0.5f;
+
+	const glm::vec3 worldCenter(modelMatrix * glm::vec4(center, 1.0f));
+	const glm::vec3 worldExtent = glm::abs(glm::vec3(modelMatrix[0])) * extent.x +
+		glm::abs(glm::vec3(modelMatrix[1])) * extent.y + glm::abs(glm::vec3(modelMatrix[2])) * extent.z;
+
+	worldMinOut = worldCenter - worldExtent;
+	worldMaxOut = worldCenter + worldExtent;
+}
+
+#if defined(OCCLUSION_CULLING)
+// triangle list indices as uint32_t, the vertex order if not indexed
+static void GetTriangleIndices(const GeometricPrimitive* pGeometry, uint32_t vertexCount, std::vector<uint32_t>& indicesOut)
+{
+	assert(pGeometry != nullptr);
+
+	auto* pIndexBuffer = pGeometry->GetIndexBuffer();
+	if ((false == pGeometry->IsIndexed()) || (nullptr == pIndexBuffer) || (nullptr == pIndexBuffer->GetData()))
+	{
+		indicesOut.resize(vertexCount - vertexCount % 3);
+		for (uint32_t i = 0; i < indicesOut.size(); ++i)
+		{
+			indicesOut[i] = i;
+		}
+		return;
+	}
+
+	const uint32_t indexCount = pIndexBuffer->GetIndexCount() - pIndexBuffer->GetIndexCount() % 3;
+	indicesOut.resize(indexCount);
+	for (uint32_t i = 0; i < indexCount; ++i)
+	{
+		switch (pIndexBuffer->GetIndexType())
+		{
+		case IndexBuffer::IndexType::GE_IT_UINT32:
+			indicesOut[i] = static_cast<const uint32_t*>(pIndexBuffer->GetData())[i];
+			break;
+		case IndexBuffer::IndexType::GE_IT_UINT16:
+			indicesOut[i] = static_cast<const uint16_t*>(pIndexBuffer->GetData())[i];
+			break;
+		case IndexBuffer::IndexType::GE_IT_UINT8:
+			indicesOut[i] = static_cast<const uint8_t*>(pIndexBuffer->GetData())[i];
+			break;
+		default:
+			LOG_ERROR("Invalid index type!");
+			indicesOut.clear();
+			return;
+		}
+	}
+
+	// the out of range indices would be read out of the positions
+	for (auto index : indicesOut)
+	{
+		if (index >= vertexCount)
+		{
+			LOG_ERROR("Invalid occluder index %u, the geometry has %u vertices!", index, vertexCount);
+			indicesOut.clear();
+			return;
+		}
+	}
+}
+#endif // OCCLUSION_CULLING
+
+void Renderer::BuildSceneTree()
+{
+	assert(mpRenderQueue != nullptr);
+
+	mSceneTree.Clear();
+	mSceneProxies.clear();
+	mVisibleProxies.clear();
+	mQueryProxies.clear();
+	mRecordedProxies.clear();
+	mHiddenRecordedCount = 0;
+
+	std::vector<glm::vec3> positions;
+
+	// same renderables as the backends
+	for (const auto& renderable : mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OPAQUE))
+	{
+		const auto* pGeoNode = renderable.pGeometryNode;
+		assert(pGeoNode != nullptr);
+
+		if (mSceneProxies.find(pGeoNode) != mSceneProxies.end())
+			continue;
+
+		// the nodes without float positions are never culled
+		if (false == GetPositions(pGeoNode->GetGeometry(), positions))
+			continue;
+
+		SceneProxy proxy;
+		proxy.localMin = glm::vec3(std::numeric_limits<float32_t>::max());
+		proxy.localMax = glm::vec3(-std::numeric_limits<float32_t>::max());
+		proxy.visibleFrame = 0;
+		proxy.isVisible = true; // until the first update
+		proxy.isRecorded = true;
+		proxy.isOccluder = false;
+
+		for (const auto& position : positions)
+		{
+			proxy.localMin = glm::min(proxy.localMin, position);
+			proxy.localMax = glm::max(proxy.localMax, position);
+		}
+
+		glm::vec3 worldMin, worldMax;
+		ComputeWorldBounds(proxy.localMin, proxy.localMax, pGeoNode->GetModelMatrix(), worldMin, worldMax);
+
+		auto& sceneProxy = mSceneProxies[pGeoNode];
+		sceneProxy = proxy;
+		// the map nodes don't move, the user data points to the proxy
+		sceneProxy.proxyId = mSceneTree.CreateProxy(worldMin, worldMax, &sceneProxy);
+
+		// all visible until the first update
+		mVisibleProxies.push_back(&sceneProxy);
+		mRecordedProxies.push_back(&sceneProxy);
+	}
+
+#if defined(OCCLUSION_CULLING)
+	mOccluderMeshes.clear();
+
+	if (false == mpRenderQueue->HasRenderables(RenderQueue::RenderableType::GE_RT_OCCLUDER))
+		return;
+
+	for (const auto& renderable : mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OCCLUDER))
+	{
+		const auto* pGeoNode = renderable.pGeometryNode;
+		assert(pGeoNode != nullptr);
+
+		OccluderMesh mesh;
+		mesh.pGeometryNode = pGeoNode;
+		if (false == GetPositions(pGeoNode->GetOccluderGeometry(), mesh.positions))
+			continue;
+
+		GetTriangleIndices(pGeoNode->GetOccluderGeometry(), static_cast<uint32_t>(mesh.positions.size()), mesh.indices);
+		if (mesh.indices.empty())
+			continue;
+
+		// the occluders are not tested against themselves
+		auto it = mSceneProxies.find(pGeoNode);
+		if (it != mSceneProxies.end())
+		{
+			it->second.isOccluder = true;
+		}
+
+		mOccluderMeshes.push_back(std::move(mesh));
+	}
+#endif // OCCLUSION_CULLING
+}
+
+bool_t Renderer::UpdateSceneCulling(Camera* pCamera)
+{
+	assert(pCamera != nullptr);
+
+	mCullingFrame++;
+
+	// only the moved nodes are refitted
+	for (const auto* pNode : Node::GetTransformChangedNodes())
+	{
+		auto it = mSceneProxies.find(pNode);
+		if (it == mSceneProxies.end())
+			continue;
+
+		const auto& proxy = it->second;
+
+		glm::vec3 worldMin, worldMax;
+		ComputeWorldBounds(proxy.localMin, proxy.localMax, pNode->GetModelMatrix(), worldMin, worldMax);
+
+		mSceneTree.SetProxyBounds(proxy.proxyId, worldMin, worldMax);
+	}
+	Node::ClearTransformChanges();
+	mSceneTree.Refit();
+
+	const Frustum frustum(pCamera->GetProjectionViewMatrix());
+	const uint32_t frame = mCullingFrame;
+
+	mQueryProxies.clear();
+	mSceneTree.QueryFrustum(frustum, [this, frame](uint32_t proxyId)
+		{
+			auto* pProxy = static_cast<SceneProxy*>(mSceneTree.GetUserData(proxyId));
+			pProxy->visibleFrame = frame;
+			mQueryProxies.push_back(pProxy);
+			return true;
+		});
+
+#if defined(OCCLUSION_CULLING)
+	if (false == mOccluderMeshes.empty())
+	{
+		mOcclusionBuffer.Begin(pCamera->GetProjectionViewMatrix());
+		for (const auto& mesh : mOccluderMeshes)
+		{
+			mOcclusionBuffer.AddOccluder(mesh.positions.data(), static_cast<uint32_t>(mesh.positions.size()),
+				mesh.indices.data(), static_cast<uint32_t>(mesh.indices.size()), mesh.pGeometryNode->GetModelMatrix());
+		}
+		mOcclusionBuffer.Rasterize();
+
+		// only the nodes in the frustum are tested, the lists live for this frame only
+		StlVector<SceneProxy*> candidates(&mFrameAllocator);
+		StlVector<OcclusionBuffer::AABB> boxes(&mFrameAllocator);
+		for (auto* pProxy : mQueryProxies)
+		{
+			if (pProxy->isOccluder)
+				continue;
+
+			const auto& fatAABB = mSceneTree.GetFatAABB(pProxy->proxyId);
+
+			OcclusionBuffer::AABB box;
+			box.min = fatAABB.min;
+			box.max = fatAABB.max;
+
+			candidates.push_back(pProxy);
+			boxes.push_back(box);
+		}
+
+		StlVector<uint8_t> results(boxes.size(), 0, &mFrameAllocator);
+		mOcclusionBuffer.TestAABBs(boxes.data(), static_cast<uint32_t>(boxes.size()), results.data());
+
+		for (size_t i = 0; i < candidates.size(); ++i)
+		{
+			if (0 == results[i])
+			{
+				candidates[i]->visibleFrame = 0;
+			}
+		}
+
+		const auto& stats = mOcclusionBuffer.GetStats();
+		mOcclusionTotalStats.occluderCount += stats.occluderCount;
+		mOcclusionTotalStats.triangleCount += stats.triangleCount;
+		mOcclusionTotalStats.binnedTriangleCount += stats.binnedTriangleCount;
+		mOcclusionTotalStats.testedCount += stats.testedCount;
+		mOcclusionTotalStats.occludedCount += stats.occludedCount;
+		mOcclusionTotalStats.setupTime += stats.setupTime;
+		mOcclusionTotalStats.rasterTime += stats.rasterTime;
+		mOcclusionTotalStats.hiZTime += stats.hiZTime;
+		mOcclusionTotalStats.testTime += stats.testTime;
+		mOcclusionFrameCount++;
+	}
+#endif // OCCLUSION_CULLING
+
+	// the changes are found from the visible nodes of this frame and of the last one, not from the whole scene
+	bool_t needsRecording = false;
+
+	size_t visibleCount = 0;
+	for (auto* pProxy : mQueryProxies)
+	{
+		// occluded
+		if (pProxy->visibleFrame != frame)
+			continue;
+
+		mQueryProxies[visibleCount++] = pProxy;
+
+		if (false == pProxy->isVisible)
+		{
+			pProxy->isVisible = true;
+
+			if (pProxy->isRecorded)
+			{
+				mHiddenRecordedCount--;
+			}
+			else
+			{
+				needsRecording = true;
+			}
+		}
+	}
+	mQueryProxies.resize(visibleCount);
+
+	for (auto* pProxy : mVisibleProxies)
+	{
+		if (pProxy->visibleFrame == frame)
+			continue;
+
+		pProxy->isVisible = false;
+
+		if (pProxy->isRecorded)
+		{
+			mHiddenRecordedCount++;
+		}
+	}
+
+	std::swap(mVisibleProxies, mQueryProxies);
+
+	// the hidden nodes are still drawn by the recorded command buffers, they are recorded again only when too many of them are hidden
+	return needsRecording || (mHiddenRecordedCount * SCENE_CULLING_MAX_HIDDEN_RATIO > mRecordedProxies.size());
+}
+
+void Renderer::SetVisibleNodesRecorded()
+{
+	for (auto* pProxy : mRecordedProxies)
+	{
+		pProxy->isRecorded = false;
+	}
+	for (auto* pProxy : mVisibleProxies)
+	{
+		pProxy->isRecorded = true;
+	}
+	mRecordedProxies = mVisibleProxies;
+	mHiddenRecordedCount = 0;
+}
+
+bool_t Renderer::IsNodeCulled(VisualPass* pVisualPass, const GeometryNode* pGeoNode) const
+{
+	assert(pVisualPass != nullptr);
+	assert(pGeoNode != nullptr);
+
+	// the other passes (e.g. shadows) use other views, the mirror passes transform the nodes
+	const auto passType = pVisualPass->GetPassType();
+	if (((passType != VisualPass::PassType::GE_PT_STANDARD) && (passType != VisualPass::PassType::GE_PT_GBUFFER)) ||
+		pVisualPass->GetIsDebug() || pVisualPass->GetIsFullScreen() ||
+		(pVisualPass->GetTransform() != glm::mat4(1.0f)))
+		return false;
+
+	auto it = mSceneProxies.find(pGeoNode);
+	if (it == mSceneProxies.end())
+		return false;
+
+	return (false == it->second.isVisible);
+}
+#endif // SCENE_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+void Renderer::CollectLODNodes()
+{
+	assert(mpRenderQueue != nullptr);
+
+	mLODNodes.clear();
+
+	for (const auto& renderable : mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OPAQUE))
+	{
+		auto* pLODNode = dynamic_cast<LODGeometryNode*>(renderable.pGeometryNode);
+		if ((nullptr == pLODNode) || (std::find(mLODNodes.begin(), mLODNodes.end(), pLODNode) != mLODNodes.end()))
+			continue;
+
+		// the levels are switched between frames, their buffers must exist before
+		for (uint32_t i = 1; i < pLODNode->GetLevelCount(); ++i)
+		{
+			auto* pGeometry = pLODNode->GetLevelGeometry(i);
+			assert(pGeometry != nullptr);
+
+			if (pGeometry->IsIndexed())
+			{
+				Get(pGeometry->GetIndexBuffer());
+			}
+		}
+
+		mLODNodes.push_back(pLODNode);
+	}
+}
+
+bool_t Renderer::UpdateLODs(Camera* pCamera)
+{
+	assert(pCamera != nullptr);
+
+	bool_t hasChanged = false;
+	for (auto* pLODNode : mLODNodes)
+	{
+		if (pLODNode->SelectLevel(pCamera, mWindowHeight))
+		{
+			mLODStats.switchCount++;
+			hasChanged = true;
+		}
+
+#if defined(SCENE_CULLING)
+		// only the drawn nodes are counted
+		auto it = mSceneProxies.find(pLODNode);
+		if ((it != mSceneProxies.end()) && (false == it->second.isVisible))
+			continue;
+#endif // SCENE_CULLING
+
+		mLODStats.triangleCount += pLODNode->GetLevelIndexCount(pLODNode->GetLevel()) / 3;
+		mLODStats.fullDetailTriangleCount += pLODNode->GetLevelIndexCount(0) / 3;
+	}
+	mLODStats.frameCount++;
+
+	return hasChanged;
+}
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+void Renderer::BuildShadowCasters()
+{
+	assert(mpRenderQueue != nullptr);
+
+	mShadowCasters.clear();
+
+	// same renderables as the backends
+	for (const auto& renderable : mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OPAQUE))
+	{
+		const auto* pGeoNode = renderable.pGeometryNode;
+		assert(pGeoNode != nullptr);
+
+		if ((false == pGeoNode->IsPassAllowed(VisualPass::PassType::GE_PT_SHADOWS)) || (mShadowCasters.find(pGeoNode) != mShadowCasters.end()))
+			continue;
+
+		ShadowCaster caster;
+		caster.hasBounds = GetLocalBounds(pGeoNode->GetGeometry(), caster.localMin, caster.localMax);
+		// nothing is drawn until the first update
+		caster.firstCascade = 0;
+		caster.cascadeCount = 0;
+
+		mShadowCasters[pGeoNode] = caster;
+	}
+}
+
+bool_t Renderer::UpdateShadowCascades(Camera* pCamera)
+{
+	assert(pCamera != nullptr);
+	assert(mpRenderQueue != nullptr);
+
+	if (mShadowCasters.empty())
+		return false;
+
+	// the first directional light casts the cascaded shadows
+	const Light* pShadowLight = nullptr;
+	mpRenderQueue->ForEach([&pShadowLight](const LightNode* pLightNode)
+		{
+			assert(pLightNode != nullptr);
+
+			auto* pLight = pLightNode->GetLight();
+			if ((nullptr == pShadowLight) && pLight && (pLight->GetLightType() == Light::LightType::GE_LT_DIRECTIONAL))
+			{
+				pShadowLight = pLight;
+			}
+		});
+
+	if (nullptr == pShadowLight)
+		return false;
+
+	mShadowCascades.Update(pCamera->GetPosition(), pCamera->GetForward(), glm::radians(pCamera->GetFOV()), pCamera->GetAspectRatio(),
+		pCamera->GetZNear(), pCamera->GetZFar(), pShadowLight->GetDirection());
+
+	const uint32_t cascadeCount = mShadowCascades.GetCascadeCount();
+
+	bool_t hasChanged = false;
+	for (auto& it : mShadowCasters)
+	{
+		auto& caster = it.second;
+
+		uint32_t firstCascade = 0, lastCascade = cascadeCount - 1;
+		if (caster.hasBounds)
+		{
+			const auto& modelMatrix = it.first->GetModelMatrix();
+
+			// world AABB of the transformed local AABB, see Arvo - Transforming Axis-Aligned Bounding Boxes (Graphics Gems)
+			const glm::vec3 center = (caster.localMin + caster.localMax) * 0.5f;
+			const glm::vec3 extent = (caster.localMax - caster.localMin) * 0.5f;
+
+			const glm::vec3 worldCenter(modelMatrix * glm::vec4(center, 1.0f));
+			const glm::vec3 worldExtent = glm::abs(glm::vec3(modelMatrix[0])) * extent.x +
+				glm::abs(glm::vec3(modelMatrix[1])) * extent.y + glm::abs(glm::vec3(modelMatrix[2])) * extent.z;
+
+			const uint32_t mask = mShadowCascades.GetCasterMask(worldCenter - worldExtent, worldCenter + worldExtent);
+
+			// the instances are a range, the cascades between the first and the last one are drawn too
+			firstCascade = cascadeCount;
+			lastCascade = 0;
+			for (uint32_t i = 0; i < cascadeCount; ++i)
+			{
+				if (mask & (1 << i))
+				{
+					firstCascade = glm::min(firstCascade, i);
+					lastCascade = i;
+				}
+			}
+		}
+
+		const uint32_t casterCascadeCount = (firstCascade <= lastCascade ? lastCascade - firstCascade + 1 : 0);
+		if (0 == casterCascadeCount)
+		{
+			firstCascade = 0;
+		}
+
+		if ((firstCascade != caster.firstCascade) || (casterCascadeCount != caster.cascadeCount))
+		{
+			caster.firstCascade = firstCascade;
+			caster.cascadeCount = casterCascadeCount;
+			hasChanged = true;
+		}
+
+		mShadowStats.cascadeDrawCount += casterCascadeCount;
+	}
+	mShadowStats.casterCount += mShadowCasters.size();
+	mShadowStats.frameCount++;
+
+	return hasChanged;
+}
+
+bool_t Renderer::GetShadowCascadeRange(VisualPass* pVisualPass, const GeometryNode* pGeoNode, uint32_t& firstCascadeOut, uint32_t& cascadeCountOut) const
+{
+	assert(pVisualPass != nullptr);
+	assert(pGeoNode != nullptr);
+
+	if (pVisualPass->GetPassType() != VisualPass::PassType::GE_PT_SHADOWS)
+		return false;
+
+	// the cascaded shadow passes have the cascade matrices, see litCascadedShadowCompute.vert
+	auto* pUBO = pVisualPass->GetUniformBuffer(Shader::ShaderStage::GE_SS_VERTEX);
+	if ((nullptr == pUBO) || (false == pUBO->HasUniform(GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV0_MATRIX4)))
+		return false;
+
+	auto it = mShadowCasters.find(pGeoNode);
+	if (it == mShadowCasters.end())
+	{
+		firstCascadeOut = 0;
+		cascadeCountOut = mShadowCascades.GetCascadeCount();
+		return true;
+	}
+
+	firstCascadeOut = it->second.firstCascade;
+	cascadeCountOut = it->second.cascadeCount;
+
+	return true;
+}
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+void Renderer::BuildShadowCache()
+{
+	assert(mpRenderQueue != nullptr);
+
+	mShadowCache.Clear();
+	mShadowCacheCasters.clear();
+	mShadowDynamicCasters.clear();
+	mShadowCacheFaceMask = 0;
+
+	// same renderables as the backends
+	for (const auto& renderable : mpRenderQueue->GetRenderables(RenderQueue::RenderableType::GE_RT_OPAQUE))
+	{
+		const auto* pGeoNode = renderable.pGeometryNode;
+		assert(pGeoNode != nullptr);
+
+		if ((false == pGeoNode->IsPassAllowed(VisualPass::PassType::GE_PT_SHADOWS)) || (mShadowCacheCasters.find(pGeoNode) != mShadowCacheCasters.end()) ||
+			(std::find(mShadowDynamicCasters.begin(), mShadowDynamicCasters.end(), pGeoNode) != mShadowDynamicCasters.end()))
+			continue;
+
+		if (pGeoNode->IsStatic())
+		{
+			glm::vec3 localMin, localMax;
+			const bool_t hasBounds = GetLocalBounds(pGeoNode->GetGeometry(), localMin, localMax);
+
+			ShadowCacheCaster caster;
+			caster.casterIdx = mShadowCache.AddCaster(localMin, localMax, hasBounds);
+			caster.faceMask = 0;
+
+			mShadowCacheCasters[pGeoNode] = caster;
+		}
+		else
+		{
+			mShadowDynamicCasters.push_back(pGeoNode);
+		}
+	}
+}
+
+bool_t Renderer::UpdateShadowCache()
+{
+	assert(mpRenderQueue != nullptr);
+
+	if (mShadowCacheCasters.empty() && mShadowDynamicCasters.empty())
+		return false;
+
+	// the faces of the shadow map: the cascades of the first directional light (see UpdateShadowCascades())
+	// or the projection of the last point light, the one bound to the shadow passes (see BindLight())
+	const Light* pDirectionalLight = nullptr;
+	const Light* pPointLight = nullptr;
+	mpRenderQueue->ForEach([&pDirectionalLight, &pPointLight](const LightNode* pLightNode)
+		{
+			assert(pLightNode != nullptr);
+
+			auto* pLight = pLightNode->GetLight();
+			if (nullptr == pLight)
+				return;
+
+			if ((nullptr == pDirectionalLight) && (pLight->GetLightType() == Light::LightType::GE_LT_DIRECTIONAL))
+			{
+				pDirectionalLight = pLight;
+			}
+			else if (pLight->GetLightType() == Light::LightType::GE_LT_POINT)
+			{
+				pPointLight = pLight;
+			}
+		});
+
+	uint32_t faceCount = 0;
+#if defined(CASCADED_SHADOWS)
+	if (pDirectionalLight)
+	{
+		faceCount = mShadowCascades.GetCascadeCount();
+	}
+	else
+#endif // CASCADED_SHADOWS
+	if (pPointLight)
+	{
+		faceCount = 1;
+	}
+
+	if (faceCount != mShadowCache.GetFaceCount())
+	{
+		mShadowCache.SetFaceCount(faceCount);
+	}
+
+	for (uint32_t i = 0; i < faceCount; ++i)
+	{
+#if defined(CASCADED_SHADOWS)
+		if (pDirectionalLight)
+		{
+			mShadowCache.SetFace(i, mShadowCascades.GetCascade(i).projectionView);
+			continue;
+		}
+#endif // CASCADED_SHADOWS
+		mShadowCache.SetFace(i, pPointLight->GetLightPVM());
+	}
+
+	for (const auto& it : mShadowCacheCasters)
+	{
+		mShadowCache.SetCasterTransform(it.second.casterIdx, it.first->GetModelMatrix());
+	}
+
+	// the dirty faces are rendered by this frame, they are clean for the next ones
+	const uint32_t faceMask = mShadowCache.GetDirtyFaceMask();
+	mShadowCache.ClearDirtyFaces();
+
+	bool_t hasChanged = (faceMask != mShadowCacheFaceMask);
+	mShadowCacheFaceMask = faceMask;
+
+	uint32_t casterCount = 0;
+	for (auto& it : mShadowCacheCasters)
+	{
+		auto& caster = it.second;
+
+		const uint32_t casterFaceMask = (faceMask != 0 ? (mShadowCache.GetCasterFaceMask(caster.casterIdx) & faceMask) : 0);
+		if (casterFaceMask != caster.faceMask)
+		{
+			caster.faceMask = casterFaceMask;
+			hasChanged = true;
+		}
+
+		if (casterFaceMask != 0)
+		{
+			casterCount++;
+		}
+	}
+
+	for (const auto* pGeoNode : mShadowDynamicCasters)
+	{
+#if defined(CASCADED_SHADOWS)
+		// out of all the cascades
+		auto it = mShadowCasters.find(pGeoNode);
+		if ((it != mShadowCasters.end()) && (0 == it->second.cascadeCount))
+			continue;
+#endif // CASCADED_SHADOWS
+
+		casterCount++;
+	}
+
+	uint32_t faceCountRendered = 0;
+	for (uint32_t i = 0; i < faceCount; ++i)
+	{
+		if (faceMask & (1 << i))
+		{
+			faceCountRendered++;
+		}
+	}
+
+	mShadowCacheStats.frameFaceCount = faceCountRendered;
+	mShadowCacheStats.frameCasterCount = casterCount;
+	mShadowCacheStats.faceCount += faceCountRendered;
+	mShadowCacheStats.casterCount += casterCount;
+	mShadowCacheStats.frameCount++;
+
+	return hasChanged;
+}
+
+bool_t Renderer::GetShadowCacheFaces(VisualPass* pVisualPass, const GeometryNode* pGeoNode, uint32_t& faceMaskOut) const
+{
+	assert(pVisualPass != nullptr);
+	assert(pGeoNode != nullptr);
+
+	if (pVisualPass->GetPassType() != VisualPass::PassType::GE_PT_SHADOWS)
+		return false;
+
+	auto it = mShadowCacheCasters.find(pGeoNode);
+	if (it == mShadowCacheCasters.end())
+		return false;
+
+	faceMaskOut = it->second.faceMask;
+
+	return true;
+}
+#endif // SHADOW_CACHING
+
+#if defined(GPU_CULLING) || defined(CASCADED_SHADOWS) || defined(SHADOW_CACHING)
+bool_t Renderer::GetLocalBounds(const GeometricPrimitive* pGeometry, glm::vec3& minOut, glm::vec3& maxOut)
+{
+	std::vector<glm::vec3> positions;
+	if (false == GetPositions(pGeometry, positions))
+		return false;
+
+	minOut = glm::vec3(std::numeric_limits<float32_t>::max());
+	maxOut = glm::vec3(-std::numeric_limits<float32_t>::max());
+
+	for (const auto& position : positions)
+	{
+		minOut = glm::min(minOut, position);
+		maxOut = glm::max(maxOut, position);
+	}
+
+	return true;
+}
+#endif // defined(GPU_CULLING) || defined(CASCADED_SHADOWS) || defined(SHADOW_CACHING)
+
 GADVisualPass* Renderer::Get(VisualPass* pVisualPass)
 {
 	assert(pVisualPass != nullptr);
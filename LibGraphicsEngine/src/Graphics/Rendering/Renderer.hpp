@@ -4,8 +4,34 @@
 #include "Core/AppConfig.hpp"
 #include "Foundation/Object.hpp"
 #include "Foundation/HashUtils.hpp"
+#include "Foundation/MemoryManagement/FrameAllocator.hpp"
 #include "Graphics/Rendering/RenderQueue.hpp"
+#include "Graphics/Rendering/GPUTimings.hpp"
+#if defined(CLUSTERED_LIGHTING)
+#include "Graphics/Lights/LightClusterGrid.hpp"
+#endif // CLUSTERED_LIGHTING
+#if defined(DEFERRED_RENDERING)
+#include "Graphics/Rendering/GBuffer.hpp"
+#endif // DEFERRED_RENDERING
+#if defined(SCENE_CULLING)
+#include "Graphics/SceneGraph/AABBTree.hpp"
+#include "glm/vec3.hpp"
+#endif // SCENE_CULLING
+#if defined(OCCLUSION_CULLING)
+#include "Graphics/Rendering/OcclusionBuffer.hpp"
+#endif // OCCLUSION_CULLING
+#if defined(GPU_CULLING)
+#include "glm/vec3.hpp"
+#endif // GPU_CULLING
+#if defined(CASCADED_SHADOWS)
+#include "Graphics/Lights/ShadowCascades.hpp"
+#include "glm/vec3.hpp"
+#endif // CASCADED_SHADOWS
+#if defined(SHADOW_CACHING)
+#include "Graphics/Rendering/ShadowCache.hpp"
+#endif // SHADOW_CACHING
 #include <string>
+#include <vector>
 #include <unordered_map>
 
 
@@ -22,6 +48,7 @@ namespace GraphicsEngine
 		// Graphics API Independent Resources
 		// Visual Pass
 		class VisualPass;
+		class VisualEffect;
 
 		class RenderTarget;
 		class VertexFormat;
@@ -50,8 +77,12 @@ namespace GraphicsEngine
 		class GADRMaterial;
 		class GADRModel;
 
+		class GeometricPrimitive;
+		class Node;
 		class GeometryNode;
+		class LODGeometryNode;
 		class LightNode;
+		class Light;
 
 		/* Rederer is the interface used to access all that is related to rendering
 			base renderer class
@@ -63,11 +94,60 @@ namespace GraphicsEngine
 		public:
 			enum class RendererType : uint8_t
 			{
-				GE_RT_FORWARD = 0, //TODO - for now we support only forward renderer
-				GE_RT_DEFERRED,
+				GE_RT_FORWARD = 0,
+				GE_RT_DEFERRED, // see DEFERRED_RENDERING
 				GE_RT_COUNT
 			};
 
+#if defined(LEVEL_OF_DETAIL)
+			// summed over the frames, the triangles of the LOD nodes drawn by the camera, once per node and frame
+			struct LODStats
+			{
+				LODStats()
+					: triangleCount(0), fullDetailTriangleCount(0), switchCount(0), frameCount(0)
+				{}
+
+				uint64_t triangleCount; // at the selected levels
+				uint64_t fullDetailTriangleCount; // at the level 0
+				uint32_t switchCount;
+				uint32_t frameCount;
+			};
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+			// summed over the frames, the casters of the cascaded shadow passes
+			struct ShadowStats
+			{
+				ShadowStats()
+					: casterCount(0), cascadeDrawCount(0), frameCount(0)
+				{}
+
+				uint64_t casterCount;
+				uint64_t cascadeDrawCount; // the instances drawn, one per caster and cascade
+				uint32_t frameCount;
+			};
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+			// the shadow map faces and the casters rendered, in the last frame and summed over the frames
+			struct ShadowCacheStats
+			{
+				ShadowCacheStats()
+					: frameFaceCount(0), frameCasterCount(0), faceCount(0), casterCount(0), frameCount(0)
+				{}
+
+				uint32_t frameFaceCount; // faces rendered to the cache
+				uint32_t frameCasterCount; // static casters drawn to the cache and dynamic casters drawn on top of it
+				uint64_t faceCount;
+				uint64_t casterCount;
+				uint32_t frameCount;
+			};
+#endif // SHADOW_CACHING
+
+			// transient per frame data, up to 3 frames in flight
+			static const uint32_t FRAME_ARENA_COUNT = 3;
+			static const uint64_t FRAME_ARENA_SIZE = 1 << 20; // 1 MB per frame
+
 			typedef std::unordered_map<VisualPass*, GADVisualPass*> VisualPassMap;
 
 			// Resource Types
@@ -89,6 +169,10 @@ namespace GraphicsEngine
 			virtual void RenderFrame(RenderQueue* pRenderQueue) {};
 			virtual void UpdateFrame(Camera* pCamera, float32_t crrTime) {};
 			virtual void SubmitFrame() {};
+
+			// copies the last submitted frame to the host: RGBA8, tightly packed rows, top row first
+			// returns false if the renderer doesn't support the read back
+			virtual bool_t ReadFrame(std::vector<uint8_t>& /*pixelsOut*/) { return false; }
 	
 			virtual void OnWindowResize(uint32_t width = 0, uint32_t height = 0) {};
 
@@ -109,8 +193,48 @@ namespace GraphicsEngine
 
 			bool_t IsPrepared() { return mIsPrepared; }
 
+			FrameAllocator& GetFrameAllocator() { return mFrameAllocator; }
+
+			// per frame and per pass GPU times, a few frames old
+			const GPUTimings& GetGPUTimings() const { return mGPUTimings; }
+
 			RenderQueue* GetRenderQueue() { return mpRenderQueue; }
 
+#if defined(CLUSTERED_LIGHTING)
+			// the point and spot lights of the current frame, binned in the clusters of the camera frustum
+			// uploaded by the Vulkan renderer for the lit shaders, see VulkanRenderer::UploadLightClusters()
+			const LightClusterGrid& GetLightClusterGrid() const { return mLightClusterGrid; }
+#endif // CLUSTERED_LIGHTING
+
+#if defined(DEFERRED_RENDERING)
+			// written by the GE_PT_GBUFFER passes of the lit effects, window sized
+			const GBuffer& GetGBuffer() const { return mGBuffer; }
+#endif // DEFERRED_RENDERING
+
+#if defined(SCENE_CULLING)
+			// world space bounds of the geometry nodes, the moved ones are refitted each frame, for the visibility and picking queries
+			const AABBTree& GetSceneTree() const { return mSceneTree; }
+#endif // SCENE_CULLING
+
+#if defined(OCCLUSION_CULLING)
+			// the occluders of the last frame, the stats report the occluded nodes and the time per stage
+			const OcclusionBuffer& GetOcclusionBuffer() const { return mOcclusionBuffer; }
+#endif // OCCLUSION_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+			const Renderer::LODStats& GetLODStats() const { return mLODStats; }
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+			// the cascades of the first directional light of the render queue, fitted to the camera each frame
+			const ShadowCascades& GetShadowCascades() const { return mShadowCascades; }
+			const Renderer::ShadowStats& GetShadowStats() const { return mShadowStats; }
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+			const Renderer::ShadowCacheStats& GetShadowCacheStats() const { return mShadowCacheStats; }
+#endif // SHADOW_CACHING
+
 			///////////////////////////
 
 			GADVisualPass* Get(VisualPass* pVisualPass);
@@ -170,6 +294,66 @@ namespace GraphicsEngine
 			virtual void BeginFrame() {};
 			virtual void EndFrame() {};
 
+#if defined(CLUSTERED_LIGHTING)
+			// bins the point and spot lights of the render queue for the camera, at most LightClusterGrid::MAX_LIGHT_COUNT
+			void UpdateLightClusters(Camera* pCamera);
+#endif // CLUSTERED_LIGHTING
+
+#if defined(DEFERRED_RENDERING)
+			// one full screen lighting effect per light of the render queue, on a node owned by the renderer
+			// called by ComputeGraphicsResources(), the backends add the passes first in the standard pass
+			void CreateLightingEffects();
+			void DestroyLightingEffects();
+#endif // DEFERRED_RENDERING
+
+#if defined(SCENE_CULLING)
+			// a proxy per geometry node of the render queue, called by ComputeGraphicsResources()
+			void BuildSceneTree();
+			// refits the nodes moved since the last frame (see Node::GetTransformChangedNodes()) and finds the nodes in the camera frustum, called by UpdateFrame()
+			// with OCCLUSION_CULLING the nodes in the frustum hidden by the occluders are culled too
+			// returns true if the command buffers recorded upfront must be recorded again: a node they don't draw became visible,
+			// or too many of the nodes they draw are hidden, see SCENE_CULLING_MAX_HIDDEN_RATIO
+			// NOTE! The backends drawing each frame ignore it, IsNodeCulled() is up to date
+			bool_t UpdateSceneCulling(Camera* pCamera);
+			// the command buffers are about to be recorded with the visible nodes, called by the backends recording upfront
+			void SetVisibleNodesRecorded();
+			// true if the node is outside the camera frustum, only for the passes rendered by the camera
+			bool_t IsNodeCulled(VisualPass* pVisualPass, const GeometryNode* pGeoNode) const;
+#endif // SCENE_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+			// the LOD nodes of the render queue, their level index buffers are created upfront, called by ComputeGraphicsResources()
+			void CollectLODNodes();
+			// selects the level of each LOD node for the camera, called by UpdateFrame() after the culling
+			// returns true if a level has changed, e.g. the command buffers recorded upfront must be recorded again
+			bool_t UpdateLODs(Camera* pCamera);
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+			// the nodes drawn by the cascaded shadow passes, called by ComputeGraphicsResources()
+			void BuildShadowCasters();
+			// fits the cascades to the camera and finds the cascades of each caster, called by UpdateFrame()
+			// returns true if the cascades of a caster changed, e.g. the command buffers recorded upfront must be recorded again
+			bool_t UpdateShadowCascades(Camera* pCamera);
+			// the cascades the node is drawn to, as instances, false if the pass is not a cascaded shadow pass
+			bool_t GetShadowCascadeRange(VisualPass* pVisualPass, const GeometryNode* pGeoNode, uint32_t& firstCascadeOut, uint32_t& cascadeCountOut) const;
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+			// the static (cached) and dynamic casters of the shadow passes, called by ComputeGraphicsResources()
+			void BuildShadowCache();
+			// updates the faces and the static casters of the cache, the dirty faces are rendered this frame, called by UpdateFrame()
+			// returns true if the cache draws changed, e.g. the command buffers recorded upfront must be recorded again
+			bool_t UpdateShadowCache();
+			// the faces the static caster is drawn to this frame, false if the node is not a static caster of the shadow pass
+			bool_t GetShadowCacheFaces(VisualPass* pVisualPass, const GeometryNode* pGeoNode, uint32_t& faceMaskOut) const;
+#endif // SHADOW_CACHING
+
+#if defined(GPU_CULLING) || defined(CASCADED_SHADOWS) || defined(SHADOW_CACHING)
+			// model space AABB of the geometry, false if the geometry has no float positions
+			static bool_t GetLocalBounds(const GeometricPrimitive* pGeometry, glm::vec3& minOut, glm::vec3& maxOut);
+#endif // defined(GPU_CULLING) || defined(CASCADED_SHADOWS) || defined(SHADOW_CACHING)
+
 			///////////////////////////////
 
 			bool_t mIsPrepared;
@@ -193,6 +377,96 @@ namespace GraphicsEngine
 			RenderQueue* mpRenderQueue;
 			Camera* mpCamera;
 
+			FrameAllocator mFrameAllocator;
+
+			GPUTimings mGPUTimings;
+
+#if defined(CLUSTERED_LIGHTING)
+			LightClusterGrid mLightClusterGrid;
+			std::vector<const Light*> mClusterLights;
+#endif // CLUSTERED_LIGHTING
+
+#if defined(DEFERRED_RENDERING)
+			GBuffer mGBuffer;
+
+			std::vector<GeometryNode*> mLightingNodes; // own their lighting effect
+			std::vector<VisualEffect*> mLightingEffects;
+#endif // DEFERRED_RENDERING
+
+#if defined(SCENE_CULLING)
+			struct SceneProxy
+			{
+				uint32_t proxyId;
+				glm::vec3 localMin; // model space bounds
+				glm::vec3 localMax;
+				uint32_t visibleFrame; // last frame the node was in the camera frustum
+				bool_t isVisible;
+				bool_t isRecorded; // visible when the command buffers were last recorded
+				bool_t isOccluder;
+			};
+
+			AABBTree mSceneTree;
+			std::unordered_map<const Node*, SceneProxy> mSceneProxies;
+			uint32_t mCullingFrame;
+
+			// the visible proxies of the last frame, only they and the query result are visited by the update
+			std::vector<SceneProxy*> mVisibleProxies;
+			std::vector<SceneProxy*> mQueryProxies;
+			std::vector<SceneProxy*> mRecordedProxies;
+			uint32_t mHiddenRecordedCount; // recorded but not visible
+#endif // SCENE_CULLING
+
+#if defined(OCCLUSION_CULLING)
+			// model space triangle lists of the occluder geometries
+			struct OccluderMesh
+			{
+				const GeometryNode* pGeometryNode;
+				std::vector<glm::vec3> positions;
+				std::vector<uint32_t> indices;
+			};
+
+			OcclusionBuffer mOcclusionBuffer;
+			std::vector<OccluderMesh> mOccluderMeshes;
+
+			// summed over the frames, logged by Terminate()
+			OcclusionBuffer::Stats mOcclusionTotalStats;
+			uint32_t mOcclusionFrameCount;
+#endif // OCCLUSION_CULLING
+
+#if defined(LEVEL_OF_DETAIL)
+			std::vector<LODGeometryNode*> mLODNodes;
+			LODStats mLODStats;
+#endif // LEVEL_OF_DETAIL
+
+#if defined(CASCADED_SHADOWS)
+			struct ShadowCaster
+			{
+				glm::vec3 localMin; // model space bounds
+				glm::vec3 localMax;
+				bool_t hasBounds; // the casters without bounds are drawn to all the cascades
+				uint32_t firstCascade;
+				uint32_t cascadeCount;
+			};
+
+			ShadowCascades mShadowCascades;
+			std::unordered_map<const GeometryNode*, ShadowCaster> mShadowCasters;
+			ShadowStats mShadowStats;
+#endif // CASCADED_SHADOWS
+
+#if defined(SHADOW_CACHING)
+			struct ShadowCacheCaster
+			{
+				uint32_t casterIdx; // of the shadow cache
+				uint32_t faceMask; // the faces drawn this frame
+			};
+
+			ShadowCache mShadowCache;
+			std::unordered_map<const GeometryNode*, ShadowCacheCaster> mShadowCacheCasters;
+			std::vector<const GeometryNode*> mShadowDynamicCasters;
+			uint32_t mShadowCacheFaceMask; // the faces rendered this frame
+			ShadowCacheStats mShadowCacheStats;
+#endif // SHADOW_CACHING
+
 		private:
 			NO_COPY_NO_MOVE_CLASS(Renderer)
 
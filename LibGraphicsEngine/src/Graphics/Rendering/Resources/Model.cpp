@@ -3,6 +3,7 @@
 #include "Graphics/Rendering/Resources/VertexBuffer.hpp"
 #include "Graphics/Rendering/Resources/IndexBuffer.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Logger.hpp"
 #include <cassert>
 
 using namespace GraphicsEngine;
@@ -32,24 +33,39 @@ void Model::Create(const std::string& filePath, uint32_t loadingFlags)
 
 	auto& vertexAttribs = mpLoader->GetVertexAttributes();
 
-	auto& vertexBuf = mpLoader->GetVertexBuffer();
-	assert(false == vertexBuf.empty());
+	auto* pVertexData = mpLoader->GetVertexData();
+	assert(pVertexData != nullptr);
+	assert(mpLoader->GetVertexDataSize() > 0);
 
 	auto* pVertexFormat = GE_ALLOC(VertexFormat)(vertexAttribs.pos, vertexAttribs.normal,
 		vertexAttribs.tangent, vertexAttribs.color, vertexAttribs.uv);
 	assert(pVertexFormat != nullptr);
 
-	auto* pVertexBuffer = GE_ALLOC(VertexBuffer)(pVertexFormat, Buffer::BufferUsage::GE_BU_STATIC, (void*)vertexBuf.data(), vertexBuf.size() * sizeof(float32_t));
+	pVertexFormat->SetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_POSITION, vertexAttribs.posType);
+	pVertexFormat->SetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_NORMAL, vertexAttribs.normalType);
+	pVertexFormat->SetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_TANGENT, vertexAttribs.tangentType);
+	pVertexFormat->SetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_COLOR, vertexAttribs.colorType);
+	pVertexFormat->SetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_TEXTURE_COORD, vertexAttribs.uvType);
+	assert(pVertexFormat->GetVertexTotalStride() > 0);
+	assert((mpLoader->GetVertexDataSize() % pVertexFormat->GetVertexTotalStride()) == 0);
+
+	auto* pVertexBuffer = GE_ALLOC(VertexBuffer)(pVertexFormat, Buffer::BufferUsage::GE_BU_STATIC, (void*)pVertexData, mpLoader->GetVertexDataSize());
 	assert(pVertexBuffer != nullptr);
 	SetVertexBuffer(pVertexBuffer);
 
-	auto& indexBuff = mpLoader->GetIndexBuffer();
-	assert(false == indexBuff.empty());
+	auto* pIndexData = mpLoader->GetIndexData();
+	assert(pIndexData != nullptr);
+	assert(mpLoader->GetIndexDataSize() > 0);
 
-	auto* pIndexBuffer = GE_ALLOC(IndexBuffer)(IndexBuffer::BufferUsage::GE_BU_STATIC, IndexBuffer::IndexType::GE_IT_UINT32, (void*)indexBuff.data(), indexBuff.size() * sizeof(uint32_t));
+	auto* pIndexBuffer = GE_ALLOC(IndexBuffer)(IndexBuffer::BufferUsage::GE_BU_STATIC, mpLoader->GetIndexType(), (void*)pIndexData, mpLoader->GetIndexDataSize());
 
 	SetIndexBuffer(pIndexBuffer);
 
+	LOG_INFO("Model memory: %s - vertices: %u x %u bytes = %u bytes, indices: %u bytes (%u bit), total: %u bytes", filePath.c_str(),
+		pVertexBuffer->GetVertexCount(), pVertexFormat->GetVertexTotalStride(), mpLoader->GetVertexDataSize(),
+		mpLoader->GetIndexDataSize(), (mpLoader->GetIndexType() == IndexBuffer::IndexType::GE_IT_UINT16) ? 16 : 32,
+		mpLoader->GetVertexDataSize() + mpLoader->GetIndexDataSize());
+
 	// Default face winding
 	// GL - CCW
 	// Vulkan - CW
@@ -62,9 +78,65 @@ void Model::Destroy()
 	GE_FREE(mpLoader);
 }
 
-void Model::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB)
+void Model::Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
 {
 	assert(mpLoader != nullptr);
 
 	mpLoader->Draw(onDrawCB);
+}
+
+void Model::DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB)
+{
+	assert(mpLoader != nullptr);
+
+	mpLoader->DrawVisible(frustum, cameraPosition, onDrawCB);
+}
+
+void Model::DrawMeshlets(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB)
+{
+	assert(mpLoader != nullptr);
+
+	mpLoader->DrawMeshlets(onDrawCB);
+}
+
+bool_t Model::HasMeshlets() const
+{
+	assert(mpLoader != nullptr);
+
+	return (mpLoader->GetMeshletCount() > 0);
+}
+
+void Model::SetLODLevel(uint32_t level)
+{
+	assert(mpLoader != nullptr);
+
+	mpLoader->SetLODLevel(level);
+}
+
+uint32_t Model::GetLODLevel() const
+{
+	assert(mpLoader != nullptr);
+
+	return mpLoader->GetLODLevel();
+}
+
+uint32_t Model::GetLODLevelCount() const
+{
+	assert(mpLoader != nullptr);
+
+	return mpLoader->GetLODLevelCount();
+}
+
+float32_t Model::GetLODError(uint32_t level) const
+{
+	assert(mpLoader != nullptr);
+
+	return mpLoader->GetLODError(level);
+}
+
+uint32_t Model::GetLODIndexCount(uint32_t level) const
+{
+	assert(mpLoader != nullptr);
+
+	return mpLoader->GetLODIndexCount(level);
 }
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace GraphicsEngine
 {
 	namespace Graphics
 	{
+		class Frustum;
+
 		// Model - used to store model data to pass to a specific Graphics API
 		class Model: public Resource, public GeometricPrimitive
 		{
@@ -21,7 +23,20 @@ namespace GraphicsEngine
 			explicit Model(const std::string& filePath, uint32_t loadingFlags = glTF2Loader::LoadingFlags::GE_LF_DEFAULT);
 			virtual ~Model();
 
-			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex)> onDrawCB);
+			void Draw(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+			// meshlet culled draw, see glTF2Loader::DrawVisible()
+			void DrawVisible(const Frustum& frustum, const glm::vec3& cameraPosition, std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset)> onDrawCB);
+			// one draw per meshlet, see glTF2Loader::DrawMeshlets()
+			void DrawMeshlets(std::function<void(uint32_t indexCount, uint32_t firstIndex, int32_t vertexOffset, const MeshletBuilder::MeshletBounds* pBounds)> onDrawCB);
+
+			bool_t HasMeshlets() const;
+
+			// levels of detail of the models loaded with GE_LF_LODS, see glTF2Loader::SetLODLevel()
+			void SetLODLevel(uint32_t level);
+			uint32_t GetLODLevel() const;
+			uint32_t GetLODLevelCount() const;
+			float32_t GetLODError(uint32_t level) const;
+			uint32_t GetLODIndexCount(uint32_t level) const;
 
 		private:
 			NO_COPY_NO_MOVE_CLASS(Model)
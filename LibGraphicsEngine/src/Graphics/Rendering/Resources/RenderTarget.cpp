@@ -22,7 +22,7 @@ RenderTarget::RenderTarget(RenderTarget::TargetType type, RenderTarget::TargetOu
 	, mpTexture(nullptr) 
 	, mWidth(width)
 	, mHeight(height)
-	, mIsFloatData(isFloatData) //TODO - not currently used
+	, mIsFloatData(isFloatData) // color targets only
 {
 	Create();
 }
@@ -42,7 +42,9 @@ void RenderTarget::Create()
 	switch (mTargetType)
 	{
 	case TargetType::GE_TT_COLOR:
-		format = Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM;
+	case TargetType::GE_TT_COLOR_1:
+	case TargetType::GE_TT_COLOR_2:
+		format = (mIsFloatData ? Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT : Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM);
 		break;
 	case TargetType::GE_TT_DEPTH:
 		format = Texture::TextureFormat::GE_TF_D32;
@@ -19,6 +19,8 @@ namespace GraphicsEngine
 				enum class TargetType : uint8_t
 				{
 					GE_TT_COLOR,
+					GE_TT_COLOR_1, // extra color targets of the multiple render target passes
+					GE_TT_COLOR_2,
 					GE_TT_DEPTH,
 					GE_TT_DEPTH_STENCIL,
 					GE_TT_COUNT
@@ -4,6 +4,7 @@
 #include "Graphics/Loaders/KTX2Loader.hpp"
 #include "Foundation/Logger.hpp"
 #include "glm/common.hpp"
+#include <cstring> // memcpy()
 #include <cassert>
 
 using namespace GraphicsEngine;
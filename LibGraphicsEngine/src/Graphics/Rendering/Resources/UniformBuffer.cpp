@@ -57,10 +57,15 @@ Variant& UniformBuffer::AddUniform(GLSLShaderTypes::UniformType type)
 		case GLSLShaderTypes::UniformType::GE_UT_PVM_MATRIX4:
 		case GLSLShaderTypes::UniformType::GE_UT_PV_CUBEMAP_MATRIX4:
 		case GLSLShaderTypes::UniformType::GE_UT_LIGHT_PVM_MATRIX4:
+		case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV0_MATRIX4:
+		case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV1_MATRIX4:
+		case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV2_MATRIX4:
+		case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV3_MATRIX4:
 		case GLSLShaderTypes::UniformType::GE_UT_PROJECTION_MATRIX4:
 		case GLSLShaderTypes::UniformType::GE_UT_VIEW_MATRIX4:
 		case GLSLShaderTypes::UniformType::GE_UT_MODEL_MATRIX4:
 		case GLSLShaderTypes::UniformType::GE_UT_NORMAL_MATRIX4:
+		case GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4:
 		{
 			ref = Variant(Variant::VariantType::GE_VT_MAT4);
 			mSize += ref.Size(); // 0 padding, alignment wiith multiplier of vec4 (glsl std140 storage)
@@ -71,6 +76,7 @@ Variant& UniformBuffer::AddUniform(GLSLShaderTypes::UniformType type)
 		case GLSLShaderTypes::UniformType::GE_UT_LIGHT_POS:
 		case GLSLShaderTypes::UniformType::GE_UT_LIGHT_COLOR:
 		case GLSLShaderTypes::UniformType::GE_UT_COLOR_VEC4:
+		case GLSLShaderTypes::UniformType::GE_UT_CASCADE_SPLITS:
 		{
 			ref = Variant(Variant::VariantType::GE_VT_VEC4);
 			mSize += ref.Size(); // 0 padding, alignment with vec4 (glsl std140 storage)
@@ -151,10 +157,15 @@ void* UniformBuffer::GetData()
 			case GLSLShaderTypes::UniformType::GE_UT_PVM_MATRIX4:
 			case GLSLShaderTypes::UniformType::GE_UT_PV_CUBEMAP_MATRIX4:
 			case GLSLShaderTypes::UniformType::GE_UT_LIGHT_PVM_MATRIX4:
+			case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV0_MATRIX4:
+			case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV1_MATRIX4:
+			case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV2_MATRIX4:
+			case GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV3_MATRIX4:
 			case GLSLShaderTypes::UniformType::GE_UT_PROJECTION_MATRIX4:
 			case GLSLShaderTypes::UniformType::GE_UT_VIEW_MATRIX4:
 			case GLSLShaderTypes::UniformType::GE_UT_MODEL_MATRIX4:
 			case GLSLShaderTypes::UniformType::GE_UT_NORMAL_MATRIX4:
+			case GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4:
 			{
 				auto& ref = variant.Value<glm::mat4>();
 				::memcpy(mpData + offset, &ref, variant.Size());
@@ -167,6 +178,7 @@ void* UniformBuffer::GetData()
 			case GLSLShaderTypes::UniformType::GE_UT_LIGHT_POS:
 			case GLSLShaderTypes::UniformType::GE_UT_LIGHT_COLOR:
 			case GLSLShaderTypes::UniformType::GE_UT_COLOR_VEC4:
+			case GLSLShaderTypes::UniformType::GE_UT_CASCADE_SPLITS:
 			{
 				auto& ref = variant.Value<Color4f>();
 				::memcpy(mpData + offset, &ref, variant.Size());
@@ -1,5 +1,6 @@
 #include "Graphics/Rendering/Resources/VertexFormat.hpp"
 #include "Foundation/Logger.hpp"
+#include <utility> // std::move()
 #include <cassert>
 
 using namespace GraphicsEngine;
@@ -36,8 +37,10 @@ VertexFormat::VertexFormat(const VertexFormat& format)
 }
 
 VertexFormat::VertexFormat(VertexFormat&& format)
+	: mVertexTotalStride(0)
+	, mVertexInputRate(VertexInputRate::GE_VIR_VERTEX) // default
 {
-	//Move(format); //TODO
+	Move(std::move(format));
 }
 
 VertexFormat& VertexFormat::operator =(const VertexFormat& format)
@@ -49,7 +52,7 @@ VertexFormat& VertexFormat::operator =(const VertexFormat& format)
 
 VertexFormat& VertexFormat::operator =(VertexFormat&& format)
 {
-	//Move(format); //TODO
+	Move(std::move(format));
 
 	return *this;
 }
@@ -94,6 +97,8 @@ void VertexFormat::Copy(const VertexFormat& format)
 	if (this != &format)
 	{
 		mVertexAttributes = format.GetVertexAttributes();
+		mVertexAttributeTypes = format.mVertexAttributeTypes;
+		mVertexTotalStride = format.mVertexTotalStride;
 		mVertexInputRate = format.mVertexInputRate;
 	}
 }
@@ -102,14 +107,21 @@ void VertexFormat::Move(VertexFormat&& format)
 {
 	if (this != &format)
 	{
-		mVertexAttributes = format.GetVertexAttributes();
+		mVertexAttributes = std::move(format.mVertexAttributes);
+		mVertexAttributeTypes = std::move(format.mVertexAttributeTypes);
+		mVertexTotalStride = format.mVertexTotalStride;
 		mVertexInputRate = format.mVertexInputRate;
+
+		// the moved from format has no attributes
+		format.Destroy();
+		format.mVertexTotalStride = 0;
 	}
 }
 
 void VertexFormat::Destroy()
 {
 	mVertexAttributes.clear();
+	mVertexAttributeTypes.clear();
 }
 
 void VertexFormat::ComputeVertexTotalStride()
@@ -120,19 +132,96 @@ void VertexFormat::ComputeVertexTotalStride()
 		GetVertexAttributeStride(VertexAttribute::GE_VA_TANGENT) +
 		GetVertexAttributeStride(VertexAttribute::GE_VA_COLOR) +
 		GetVertexAttributeStride(VertexAttribute::GE_VA_TEXTURE_COORD);
+
+	// keep every vertex 4 byte aligned
+	mVertexTotalStride = (mVertexTotalStride + 3) & ~3u;
 }
 
-// TODO - for now we work with float data as it is the most inclusive attribute type
 uint32_t VertexFormat::GetVertexAttributeStride(const VertexFormat::VertexAttribute& att) const
 {
 	assert((att >= VertexFormat::VertexAttribute::GE_VA_POSITION) && (att < VertexFormat::VertexAttribute::GE_VA_COUNT));
 	assert(mVertexAttributes.empty() == false);
 
-	uint32_t attributeStride = (HasVertexAttribute(att) ? (mVertexAttributes.at(att) * sizeof(float32_t)) : 0);
+	uint32_t attributeStride = (HasVertexAttribute(att) ?
+		(GetVertexAttributeStoredComponentCount(att) * GetAttributeTypeSize(GetVertexAttributeType(att))) : 0);
 
 	return attributeStride;
 }
 
+void VertexFormat::SetVertexAttributeType(const VertexFormat::VertexAttribute& att, VertexFormat::AttributeType type)
+{
+	assert((att >= VertexFormat::VertexAttribute::GE_VA_POSITION) && (att < VertexFormat::VertexAttribute::GE_VA_COUNT));
+	assert(type < VertexFormat::AttributeType::GE_AT_COUNT);
+
+	// types are kept only for existing attributes
+	if ((type == AttributeType::GE_AT_FLOAT32) || (false == HasVertexAttribute(att)))
+	{
+		mVertexAttributeTypes.erase(att);
+	}
+	else
+	{
+		mVertexAttributeTypes[att] = type;
+	}
+
+	ComputeVertexTotalStride();
+}
+
+VertexFormat::AttributeType VertexFormat::GetVertexAttributeType(const VertexFormat::VertexAttribute& att) const
+{
+	auto it = mVertexAttributeTypes.find(att);
+
+	return ((it != mVertexAttributeTypes.end()) ? it->second : AttributeType::GE_AT_FLOAT32);
+}
+
+uint8_t VertexFormat::GetVertexAttributeStoredComponentCount(const VertexFormat::VertexAttribute& att) const
+{
+	if (false == HasVertexAttribute(att))
+	{
+		return 0;
+	}
+
+	uint8_t componentCount = mVertexAttributes.at(att);
+
+	switch (GetVertexAttributeType(att))
+	{
+	case AttributeType::GE_AT_FLOAT32:
+		break;
+	case AttributeType::GE_AT_OCTAHEDRAL_SNORM16:
+		componentCount = 2;
+		break;
+	default:
+		componentCount = ((componentCount == 3) ? 4 : componentCount);
+	}
+
+	return componentCount;
+}
+
+uint32_t VertexFormat::GetAttributeTypeSize(VertexFormat::AttributeType type)
+{
+	uint32_t size = 0;
+
+	switch (type)
+	{
+	case AttributeType::GE_AT_FLOAT32:
+		size = sizeof(float32_t);
+		break;
+	case AttributeType::GE_AT_FLOAT16:
+	case AttributeType::GE_AT_SNORM16:
+	case AttributeType::GE_AT_OCTAHEDRAL_SNORM16:
+		size = sizeof(uint16_t);
+		break;
+	case AttributeType::GE_AT_SNORM8:
+	case AttributeType::GE_AT_UNORM8:
+		size = sizeof(uint8_t);
+		break;
+	case AttributeType::GE_AT_COUNT:
+	default:
+		LOG_ERROR("Invalid vertex attribute type!");
+	}
+
+	return size;
+}
+
 bool_t VertexFormat::HasVertexAttribute(const VertexFormat::VertexAttribute& att) const
 {
 	assert((att >= VertexFormat::VertexAttribute::GE_VA_POSITION) && (att < VertexFormat::VertexAttribute::GE_VA_COUNT));
@@ -9,7 +9,7 @@ namespace GraphicsEngine
 	namespace Graphics
 	{
 		// VertexFormat - used to store vertex format data to pass to a specific Graphics API
-		// TODO - by default we work with float data
+		// NOTE! By default we work with float data, quantized types can be set per attribute
 		class VertexFormat : public Resource
 		{
 			GE_RTTI(GraphicsEngine::Graphics::VertexFormat)
@@ -42,6 +42,23 @@ namespace GraphicsEngine
 			// NOTE! ordered_map as we want to maintain the order of attributes!
 			typedef std::map<VertexFormat::VertexAttribute, uint8_t> VertexAttributeMap;
 
+			// component type of an attribute
+			// NOTE! Normalized types are converted to float by the GPU, so the shaders do not change,
+			// except for octahedral normals which have to be decoded in the vertex shader:
+			// vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y)); if (n.z < 0.0) n.xy = (1.0 - abs(n.yx)) * sign(n.xy); n = normalize(n);
+			enum class AttributeType : uint8_t
+			{
+				GE_AT_FLOAT32 = 0,
+				GE_AT_FLOAT16,
+				GE_AT_SNORM16,
+				GE_AT_SNORM8,
+				GE_AT_UNORM8,
+				GE_AT_OCTAHEDRAL_SNORM16, // 3 component unit vectors stored as 2 x snorm16, decoded by the lit vertex shaders (OCTAHEDRAL_NORMALS constant)
+				GE_AT_COUNT
+			};
+
+			typedef std::map<VertexFormat::VertexAttribute, VertexFormat::AttributeType> VertexAttributeTypeMap;
+
 			enum class VertexInputRate : uint8_t
 			{
 				GE_VIR_VERTEX = 0,
@@ -62,6 +79,14 @@ namespace GraphicsEngine
 			uint32_t GetVertexAttributeStride(const VertexFormat::VertexAttribute& att) const;
 			bool_t HasVertexAttribute(const VertexFormat::VertexAttribute& att) const;
 
+			void SetVertexAttributeType(const VertexFormat::VertexAttribute& att, VertexFormat::AttributeType type);
+			VertexFormat::AttributeType GetVertexAttributeType(const VertexFormat::VertexAttribute& att) const;
+			// number of components stored in memory - 3 component non float32 attributes are padded to 4,
+			// as most GPUs do not support 3 component 8/16 bit vertex formats
+			uint8_t GetVertexAttributeStoredComponentCount(const VertexFormat::VertexAttribute& att) const;
+
+			static uint32_t GetAttributeTypeSize(VertexFormat::AttributeType type); // in bytes, per component
+
 			uint32_t GetVertexAttributeOffset(const VertexFormat::VertexAttribute& att) const;
 			uint32_t GetVertexTotalStride() const;
 
@@ -79,6 +104,7 @@ namespace GraphicsEngine
 			void ComputeVertexTotalStride();
 
 			VertexAttributeMap mVertexAttributes;
+			VertexAttributeTypeMap mVertexAttributeTypes; // only non float32 attributes are stored
 			uint32_t mVertexTotalStride;
 			VertexInputRate mVertexInputRate;
 			
@@ -0,0 +1,150 @@
+#include "Graphics/Rendering/ShadowCache.hpp"
+#include "glm/common.hpp" // glm::abs()
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+ShadowCache::ShadowCache()
+	: mFaceCount(0)
+	, mDirtyFaceMask(0)
+{}
+
+ShadowCache::~ShadowCache()
+{
+	Clear();
+}
+
+void ShadowCache::Clear()
+{
+	mCasters.clear();
+
+	mFaceCount = 0;
+	mDirtyFaceMask = 0;
+}
+
+void ShadowCache::SetFaceCount(uint32_t faceCount)
+{
+	assert(faceCount <= MAX_FACE_COUNT);
+
+	mFaceCount = faceCount;
+
+	for (uint32_t i = 0; i < mFaceCount; ++i)
+	{
+		mFaceMatrices[i] = glm::mat4(0.0f);
+	}
+
+	Invalidate();
+}
+
+uint32_t ShadowCache::GetFaceCount() const
+{
+	return mFaceCount;
+}
+
+uint32_t ShadowCache::AddCaster(const glm::vec3& localMin, const glm::vec3& localMax, bool_t hasBounds)
+{
+	Caster caster;
+	caster.localMin = localMin;
+	caster.localMax = localMax;
+	caster.hasBounds = hasBounds;
+	caster.hasTransform = false;
+	caster.modelMatrix = glm::mat4(1.0f);
+	caster.worldMin = localMin;
+	caster.worldMax = localMax;
+
+	mCasters.push_back(caster);
+
+	// the faces were rendered without it
+	Invalidate();
+
+	return static_cast<uint32_t>(mCasters.size() - 1);
+}
+
+void ShadowCache::SetFace(uint32_t faceIdx, const glm::mat4& projectionView)
+{
+	assert(faceIdx < mFaceCount);
+
+	if (projectionView == mFaceMatrices[faceIdx])
+		return;
+
+	mFaceMatrices[faceIdx] = projectionView;
+	mFaceFrustums[faceIdx].Update(projectionView);
+
+	mDirtyFaceMask |= (1 << faceIdx);
+}
+
+void ShadowCache::SetCasterTransform(uint32_t casterIdx, const glm::mat4& modelMatrix)
+{
+	assert(casterIdx < mCasters.size());
+
+	auto& caster = mCasters[casterIdx];
+
+	if (caster.hasTransform && (modelMatrix == caster.modelMatrix))
+		return;
+
+	// the faces it leaves
+	if (caster.hasTransform)
+	{
+		mDirtyFaceMask |= GetFaceMask(caster);
+	}
+
+	caster.hasTransform = true;
+	caster.modelMatrix = modelMatrix;
+
+	if (caster.hasBounds)
+	{
+		// world AABB of the transformed local AABB, see Arvo - Transforming Axis-Aligned Bounding Boxes (Graphics Gems)
+		const glm::vec3 center = (caster.localMin + caster.localMax) * 0.5f;
+		const glm::vec3 extent = (caster.localMax - caster.localMin) * 0.5f;
+
+		const glm::vec3 worldCenter(modelMatrix * glm::vec4(center, 1.0f));
+		const glm::vec3 worldExtent = glm::abs(glm::vec3(modelMatrix[0])) * extent.x +
+			glm::abs(glm::vec3(modelMatrix[1])) * extent.y + glm::abs(glm::vec3(modelMatrix[2])) * extent.z;
+
+		caster.worldMin = worldCenter - worldExtent;
+		caster.worldMax = worldCenter + worldExtent;
+	}
+
+	// the faces it enters
+	mDirtyFaceMask |= GetFaceMask(caster);
+}
+
+void ShadowCache::Invalidate()
+{
+	mDirtyFaceMask = (1 << mFaceCount) - 1;
+}
+
+uint32_t ShadowCache::GetDirtyFaceMask() const
+{
+	return mDirtyFaceMask;
+}
+
+void ShadowCache::ClearDirtyFaces()
+{
+	mDirtyFaceMask = 0;
+}
+
+uint32_t ShadowCache::GetCasterFaceMask(uint32_t casterIdx) const
+{
+	assert(casterIdx < mCasters.size());
+
+	return GetFaceMask(mCasters[casterIdx]);
+}
+
+uint32_t ShadowCache::GetFaceMask(const Caster& caster) const
+{
+	if (false == caster.hasBounds)
+		return (1 << mFaceCount) - 1;
+
+	uint32_t mask = 0;
+	for (uint32_t i = 0; i < mFaceCount; ++i)
+	{
+		if (mFaceFrustums[i].IntersectsAABB(caster.worldMin, caster.worldMax))
+		{
+			mask |= (1 << i);
+		}
+	}
+
+	return mask;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef GRAPHICS_RENDERING_SHADOW_CACHE_HPP
+#define GRAPHICS_RENDERING_SHADOW_CACHE_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "glm/vec3.hpp"
+#include "glm/mat4x4.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/*
+			Bookkeeping of a cached shadow map, the backends keep the depth of the static casters in a cache map
+			copied to the shadow map each frame, the dynamic casters are drawn on top of it.
+			The faces of a shadow map are the light views rendered to it: one for a single light projection,
+			one per cascade of the atlas (see ShadowCascades), one per cube face.
+			A face is dirty - cleared and its static casters drawn to the cache again - when:
+			- its light projection changed (the light moved, the cascade was fitted to a new camera position)
+			- a static caster moved and was or is in the face (its old or new world bounds intersect the face frustum)
+			The frustum of a face is the one of its projection, so the casters between the light and the face are in it.
+		*/
+		class ShadowCache
+		{
+		public:
+			static const uint32_t MAX_FACE_COUNT = 6;
+
+			ShadowCache();
+			~ShadowCache();
+
+			// removes the casters and the faces
+			void Clear();
+
+			// the faces are dirty until they are rendered
+			void SetFaceCount(uint32_t faceCount);
+			uint32_t GetFaceCount() const;
+
+			// a static caster, model space bounds - the casters without bounds are in all the faces
+			uint32_t AddCaster(const glm::vec3& localMin, const glm::vec3& localMax, bool_t hasBounds);
+
+			// the frame updates, the faces become dirty as described above
+			void SetFace(uint32_t faceIdx, const glm::mat4& projectionView);
+			void SetCasterTransform(uint32_t casterIdx, const glm::mat4& modelMatrix);
+			// all the faces are dirty, e.g. the cache was lost
+			void Invalidate();
+
+			// bit i is set if the face i is dirty
+			uint32_t GetDirtyFaceMask() const;
+			// the dirty faces were rendered to the cache
+			void ClearDirtyFaces();
+
+			// bit i is set if the static caster is in the face i
+			uint32_t GetCasterFaceMask(uint32_t casterIdx) const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(ShadowCache)
+
+			struct Caster
+			{
+				glm::vec3 localMin;
+				glm::vec3 localMax;
+				bool_t hasBounds;
+
+				bool_t hasTransform; // false until the first transform
+				glm::mat4 modelMatrix;
+				glm::vec3 worldMin;
+				glm::vec3 worldMax;
+			};
+
+			uint32_t GetFaceMask(const Caster& caster) const;
+
+			std::vector<Caster> mCasters;
+
+			uint32_t mFaceCount;
+			glm::mat4 mFaceMatrices[MAX_FACE_COUNT];
+			Frustum mFaceFrustums[MAX_FACE_COUNT];
+
+			uint32_t mDirtyFaceMask;
+		};
+	}
+}
+
+#endif // GRAPHICS_RENDERING_SHADOW_CACHE_HPP
\ No newline at end of file
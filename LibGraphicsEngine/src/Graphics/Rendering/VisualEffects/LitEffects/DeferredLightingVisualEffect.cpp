@@ -0,0 +1,184 @@
+#include "Graphics/Rendering/VisualEffects/LitEffects/DeferredLightingVisualEffect.hpp"
+#include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+#include "Graphics/Rendering/Renderer.hpp"
+#include "Graphics/Rendering/Resources/Shader.hpp"
+#include "Graphics/Rendering/Resources/Texture.hpp"
+#include "Graphics/Rendering/Resources/UniformBuffer.hpp"
+#include "Graphics/SceneGraph/GeometryNode.hpp"
+#include "Graphics/Lights/Light.hpp"
+#include "Graphics/ShaderTools/GLSL/GLSLShaderTypes.hpp"
+#include "Graphics/ShaderTools/GLSL/GLSLShaderParser.hpp"
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Logger.hpp"
+#include <string>
+#include <cassert>
+#if defined(VULKAN_RENDERER)
+#define IS_GL_NDK 0
+#else
+#define IS_GL_NDK 1 // OpenGL and the Null renderer
+#endif // VULKAN_RENDERER
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+DeferredLightingVisualEffect::DeferredLightingVisualEffect(const Light* pLight, bool_t isAdditive)
+	: VisualEffect(VisualEffect::EffectType::GE_ET_CUSTOM)
+	, mpLight(pLight)
+	, mIsAdditive(isAdditive)
+{
+	mEffectName = GetClassName_();
+}
+
+DeferredLightingVisualEffect::~DeferredLightingVisualEffect()
+{
+	mpLight = nullptr;
+}
+
+RenderTarget* DeferredLightingVisualEffect::FindRenderTarget(const Texture* pTexture) const
+{
+#if defined(DEFERRED_RENDERING)
+	assert(mpRenderer != nullptr);
+
+	return mpRenderer->GetGBuffer().FindRenderTarget(pTexture);
+#else
+	(void)pTexture;
+
+	return nullptr;
+#endif // DEFERRED_RENDERING
+}
+
+void DeferredLightingVisualEffect::InitCustomEffect()
+{
+#if defined(DEFERRED_RENDERING)
+	assert(mpRenderer != nullptr);
+
+	const auto& gBuffer = mpRenderer->GetGBuffer();
+	assert(gBuffer.IsValid());
+
+	// full screen triangle, drawn first in the standard pass
+	auto* pPass = GE_ALLOC(VisualPass)(VisualPass::PassType::GE_PT_STANDARD);
+	assert(pPass != nullptr);
+
+	pPass->SetIsFullScreen(true);
+
+	auto* pVertexShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/deferredLighting.vert");
+	assert(pVertexShader != nullptr);
+	auto* pFragmentShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/deferredLighting.frag");
+	assert(pFragmentShader != nullptr);
+
+	pPass->AddShader(pVertexShader);
+	pPass->AddShader(pFragmentShader);
+
+	auto* pFragParser = pFragmentShader->GetGLSLParser();
+	assert(pFragParser != nullptr);
+
+	// NOTE! The textures are added in the binding order of the samplers
+	const auto& fragUniforms = pFragParser->GetUniforms();
+	const char_t* samplerNames[] =
+	{
+		GLSLShaderTypes::Constants::UNIFORM_2D_ALBEDO_TEXTURE,
+		GLSLShaderTypes::Constants::UNIFORM_2D_NORMAL_TEXTURE,
+		GLSLShaderTypes::Constants::UNIFORM_2D_MATERIAL_TEXTURE,
+		GLSLShaderTypes::Constants::UNIFORM_2D_DEPTH_TEXTURE
+	};
+	RenderTarget* renderTargets[] = { gBuffer.GetAlbedoRT(), gBuffer.GetNormalRT(), gBuffer.GetMaterialRT(), gBuffer.GetDepthRT() };
+
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		auto it = fragUniforms.find(samplerNames[i]);
+		if (it != fragUniforms.end() && it->second.type == GLSLShaderTypes::Constants::SAMPLER_2D_TYPE)
+		{
+			pPass->AddTexture(Shader::ShaderStage::GE_SS_FRAGMENT, renderTargets[i]->GetTexture());
+		}
+		else
+		{
+			LOG_ERROR("G-buffer texture uniform %s not found in shader: %s! Abort!", samplerNames[i], pFragmentShader->GetSourcePath().c_str());
+		}
+	}
+
+	if (pFragParser->GetUniformBlock().IsValid())
+	{
+		auto& uboMembers = pFragParser->GetUniformBlock().members;
+
+		auto* pUB = GE_ALLOC(UniformBuffer);
+		assert(pUB != nullptr);
+
+		auto it = uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_INVERSE_PV_MATRIX);
+		if (it != uboMembers.end() && it->second.type == GLSLShaderTypes::Constants::MAT4_TYPE)
+		{
+			pUB->AddUniform(GLSLShaderTypes::UniformType::GE_UT_INVERSE_PV_MATRIX4); // no value added as it is gonna be updated per frame!
+		}
+		else
+		{
+			LOG_ERROR("Inverse PV matrix uniform not found in shader: %s! Abort!", pFragmentShader->GetSourcePath().c_str());
+		}
+
+		it = uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_CAMERA_POS);
+		if (it != uboMembers.end() && it->second.type == GLSLShaderTypes::Constants::VEC4_TYPE)
+		{
+			pUB->AddUniform(GLSLShaderTypes::UniformType::GE_UT_CAMERA_POS); // no value added as it is gonna be updated per frame!
+		}
+		else
+		{
+			LOG_ERROR("Camera pos uniform not found in shader: %s! Abort!", pFragmentShader->GetSourcePath().c_str());
+		}
+
+		// the light values are set once, as the forward effects do, see Renderer::BindLight()
+		// lightPos.w - 1 for the point lights, 0 for the directional lights, -1 without a light
+		// lightColor.w - 1 for the first pass which adds the ambient, 0 for the additive passes
+		const bool_t isPointLight = ((mpLight != nullptr) && (mpLight->GetLightType() == Light::LightType::GE_LT_POINT));
+		const float32_t lightType = ((nullptr == mpLight) ? -1.0f : (isPointLight ? 1.0f : 0.0f));
+		const glm::vec3 lightColor = ((nullptr == mpLight) ? glm::vec3(1.0f) : mpLight->GetColor());
+
+		it = uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_LIGHT_DIR);
+		auto posIt = uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_LIGHT_POS);
+		auto colorIt = uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_LIGHT_COLOR);
+		if (it != uboMembers.end() && it->second.type == GLSLShaderTypes::Constants::VEC4_TYPE &&
+			posIt != uboMembers.end() && posIt->second.type == GLSLShaderTypes::Constants::VEC4_TYPE &&
+			colorIt != uboMembers.end() && colorIt->second.type == GLSLShaderTypes::Constants::VEC4_TYPE)
+		{
+			pUB->AddUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_DIR, glm::vec4((0.0f == lightType) ? mpLight->GetDirection() : glm::vec3(0.0f), 0.0f));
+			pUB->AddUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_POS, glm::vec4(isPointLight ? mpLight->GetPosition() : glm::vec3(0.0f), lightType));
+			pUB->AddUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_COLOR, glm::vec4(lightColor, mIsAdditive ? 0.0f : 1.0f));
+		}
+		else
+		{
+			LOG_ERROR("Light uniforms not found in shader: %s! Abort!", pFragmentShader->GetSourcePath().c_str());
+		}
+
+		it = uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_IS_GL_NDK);
+		if (it != uboMembers.end() && it->second.type == GLSLShaderTypes::Constants::INT_TYPE)
+		{
+			// NOTE! Vulkan NDK depth is in [0, 1], OpenGL NDK depth is in [-1, 1]
+			pUB->AddUniform(GLSLShaderTypes::UniformType::GE_UT_IS_GL_NDK, IS_GL_NDK);
+		}
+
+		pPass->AddUniformBuffer(Shader::ShaderStage::GE_SS_FRAGMENT, pUB);
+	}
+
+	// the depth of the G-buffer is written back for the forward passes which follow
+	DepthStencilState depthStencilState = pPass->GetDepthStencilState();
+	depthStencilState.SetIsDepthWritable(true);
+	depthStencilState.SetDepthCompareOp(DepthStencilState::CompareOp::GE_CO_ALWAYS);
+	pPass->SetDepthStencilState(depthStencilState);
+
+	if (mIsAdditive)
+	{
+		ColorBlendState colorBlendState = pPass->GetColorBlendState();
+		colorBlendState.SetIsBlendEnabled(true);
+		colorBlendState.SetSrcColorBlendFactor(ColorBlendState::BlendFactor::GE_BF_ONE);
+		colorBlendState.SetDstColorBlendFactor(ColorBlendState::BlendFactor::GE_BF_ONE);
+		colorBlendState.SetSrcAlphaBlendFactor(ColorBlendState::BlendFactor::GE_BF_ONE);
+		colorBlendState.SetDstAlphaBlendFactor(ColorBlendState::BlendFactor::GE_BF_ZERO);
+		pPass->SetColorBlendState(colorBlendState);
+	}
+
+	assert(mpTargetNode != nullptr);
+	mpTargetNode->AddAllowedPass(VisualPass::PassType::GE_PT_STANDARD);
+	pPass->SetNode(mpTargetNode);
+
+	mPassMap[pPass->GetPassType()].push_back(pPass);
+#else
+	LOG_ERROR("The deferred lighting needs DEFERRED_RENDERING!");
+#endif // DEFERRED_RENDERING
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef GRAPHICS_RENDERING_VISUAL_EFFECTS_LIT_EFFECTS_DEFERRED_LIGHTING_VISUAL_EFFECT_HPP
+#define GRAPHICS_RENDERING_VISUAL_EFFECTS_LIT_EFFECTS_DEFERRED_LIGHTING_VISUAL_EFFECT_HPP
+
+#include "Graphics/Rendering/VisualEffects/VisualEffect.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Light;
+
+		/* Effect which applies a light on the renderer's G-buffer, in a full screen pass
+		   Created by the renderer for each light when DEFERRED_RENDERING is defined, see Renderer::CreateLightingEffects() */
+		class DeferredLightingVisualEffect : public VisualEffect
+		{
+			GE_RTTI(GraphicsEngine::Graphics::DeferredLightingVisualEffect)
+
+		public:
+			// pLight - nullptr for the ambient only pass of a scene without lights
+			// isAdditive - the light is added to the screen, otherwise it overwrites it and adds the ambient
+			explicit DeferredLightingVisualEffect(const Light* pLight, bool_t isAdditive);
+			~DeferredLightingVisualEffect();
+
+			// the sampled G-buffer textures belong to the renderer
+			virtual RenderTarget* FindRenderTarget(const Texture* pTexture) const override;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(DeferredLightingVisualEffect)
+
+			virtual void InitCustomEffect() override;
+
+			const Light* mpLight;
+			bool_t mIsAdditive;
+		};
+	}
+}
+
+#endif // GRAPHICS_RENDERING_VISUAL_EFFECTS_LIT_EFFECTS_DEFERRED_LIGHTING_VISUAL_EFFECT_HPP
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "Graphics/Rendering/VisualEffects/LitEffects/LitCascadedShadowColorAttributeVisualEffect.hpp"
+#include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+#include "Graphics/Rendering/Resources/Shader.hpp"
+#include "Graphics/Rendering/Resources/Texture.hpp"
+#include "Graphics/SceneGraph/GeometryNode.hpp"
+#include "Graphics/Lights/ShadowCascades.hpp"
+#include "Graphics/ShaderTools/GLSL/GLSLShaderTypes.hpp"
+#include "Graphics/ShaderTools/GLSL/GLSLShaderParser.hpp"
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Logger.hpp"
+#include <string>
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+RenderTarget* LitCascadedShadowColorAttributeVisualEffect::mpDepthAtlasRT = nullptr;
+
+LitCascadedShadowColorAttributeVisualEffect::LitCascadedShadowColorAttributeVisualEffect()
+	: VisualEffect(VisualEffect::EffectType::GE_ET_LIT_SHADOWS)
+{
+	mEffectName = GetClassName_();
+}
+
+LitCascadedShadowColorAttributeVisualEffect::~LitCascadedShadowColorAttributeVisualEffect()
+{}
+
+void LitCascadedShadowColorAttributeVisualEffect::InitCustomEffect()
+{
+	// This effect has 2 passes
+	// 1. render the node to the atlas tiles of the cascades it casts shadows in, from the light point of view
+	// 2. apply the cascade of each fragment as shadow to the node effect
+
+	assert(mpTargetNode != nullptr);
+	mpTargetNode->SetIsLit(true); // lit node !
+	mpTargetNode->AddAllowedPass(VisualPass::PassType::GE_PT_STANDARD);
+	mpTargetNode->AddAllowedPass(VisualPass::PassType::GE_PT_SHADOWS);
+
+	//// 1st pass - one instance per cascade, only vertex shader needed for this pass
+
+	if (mpDepthAtlasRT == nullptr)
+	{
+		mpDepthAtlasRT = GE_ALLOC(RenderTarget)(RenderTarget::TargetType::GE_TT_DEPTH, RenderTarget::TargetOutput::GE_TO_RENDER_SAMPLING,
+			ShadowCascades::ATLAS_SIZE, ShadowCascades::ATLAS_SIZE);
+	}
+	assert(mpDepthAtlasRT != nullptr);
+
+	auto* pPass = GE_ALLOC(VisualPass)(VisualPass::PassType::GE_PT_SHADOWS);
+	assert(pPass != nullptr);
+
+	pPass->SetNode(mpTargetNode);
+
+	pPass->AddRenderTarget(mpDepthAtlasRT);
+
+	auto* pVertexShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/litCascadedShadowCompute.vert");
+	assert(pVertexShader != nullptr);
+
+	pPass->AddShader(pVertexShader);
+
+	mPassMap[pPass->GetPassType()].push_back(pPass);
+
+
+	// 2nd pass - apply shadow to the node's effect
+	pPass = GE_ALLOC(VisualPass)(VisualPass::PassType::GE_PT_STANDARD);
+	assert(pPass != nullptr);
+
+	pPass->SetNode(mpTargetNode);
+
+	pVertexShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/litCascadedShadowColorAttribute.vert");
+	assert(pVertexShader != nullptr);
+	auto* pFragmentShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/litCascadedShadowColorAttribute.frag");
+	assert(pFragmentShader != nullptr);
+
+	pPass->AddShader(pVertexShader);
+	pPass->AddShader(pFragmentShader);
+
+	auto* pFragParser = pFragmentShader->GetGLSLParser();
+	assert(pFragParser != nullptr);
+
+	const auto& fragUniforms = pFragParser->GetUniforms();
+
+	auto it = fragUniforms.find(GLSLShaderTypes::Constants::UNIFORM_2D_SHADOW_TEXTURE);
+	if (it != fragUniforms.end() && it->second.type == GLSLShaderTypes::Constants::SAMPLER_2D_TYPE)
+	{
+		pPass->AddTexture(Shader::ShaderStage::GE_SS_FRAGMENT, mpDepthAtlasRT->GetTexture());
+	}
+	else
+	{
+		LOG_ERROR("2D shadow texture uniform not found in shader: %s! Abort!", pFragmentShader->GetSourcePath().c_str());
+	}
+
+	mPassMap[pPass->GetPassType()].push_back(pPass);
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef GRAPHICS_RENDERING_VISUAL_EFFECTS_LIT_EFFECTS_LIT_CASCADED_SHADOW_COLOR_ATTRIBUTE_VISUAL_EFFECT_HPP
+#define GRAPHICS_RENDERING_VISUAL_EFFECTS_LIT_EFFECTS_LIT_CASCADED_SHADOW_COLOR_ATTRIBUTE_VISUAL_EFFECT_HPP
+
+#include "Graphics/Rendering/VisualEffects/VisualEffect.hpp"
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		/* Effect which applies a Lit + cascaded shadows of a directional light + vertex attribute color on geometry
+			The cascades are fitted by the renderer each frame, see CASCADED_SHADOWS and ShadowCascades.
+			NOTE! All the shadow passes render to one depth target, a scene uses either this effect or LitShadowColorAttributeVisualEffect.
+		*/
+		class LitCascadedShadowColorAttributeVisualEffect : public VisualEffect
+		{
+			GE_RTTI(GraphicsEngine::Graphics::LitCascadedShadowColorAttributeVisualEffect)
+
+		public:
+			LitCascadedShadowColorAttributeVisualEffect();
+			~LitCascadedShadowColorAttributeVisualEffect();
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(LitCascadedShadowColorAttributeVisualEffect)
+
+			virtual void InitCustomEffect() override;
+
+			// the cascades are the tiles of one depth atlas
+			static RenderTarget* mpDepthAtlasRT;
+		};
+	}
+}
+
+#endif // GRAPHICS_RENDERING_VISUAL_EFFECTS_LIT_EFFECTS_LIT_CASCADED_SHADOW_COLOR_ATTRIBUTE_VISUAL_EFFECT_HPP
\ No newline at end of file
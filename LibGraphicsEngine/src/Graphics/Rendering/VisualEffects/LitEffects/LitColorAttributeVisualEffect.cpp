@@ -1,5 +1,6 @@
 #include "Graphics/Rendering/VisualEffects/LitEffects/LitColorAttributeVisualEffect.hpp"
 #include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+#include "Graphics/Rendering/Renderer.hpp"
 #include "Graphics/Rendering/Resources/Shader.hpp"
 #include "Graphics/SceneGraph/GeometryNode.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
@@ -21,12 +22,26 @@ LitColorAttributeVisualEffect::~LitColorAttributeVisualEffect()
 
 void LitColorAttributeVisualEffect::InitCustomEffect()
 {
+#if defined(DEFERRED_RENDERING)
+	// the G-buffer is lit later by the renderer, see DeferredLightingVisualEffect
+	assert(mpRenderer != nullptr);
+
+	auto* pPass = GE_ALLOC(VisualPass)(VisualPass::PassType::GE_PT_GBUFFER);
+	assert(pPass != nullptr);
+
+	mpRenderer->GetGBuffer().AddRenderTargets(pPass);
+
+	const char_t* pFragmentShaderName = "gbufferColorAttribute.frag";
+#else
 	auto* pPass = GE_ALLOC(VisualPass)(VisualPass::PassType::GE_PT_STANDARD);
 	assert(pPass != nullptr);
 
+	const char_t* pFragmentShaderName = "litColorAttribute.frag";
+#endif // DEFERRED_RENDERING
+
 	auto* pVertexShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/litColorAttribute.vert");
 	assert(pVertexShader != nullptr);
-	auto* pFragmentShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/litColorAttribute.frag");
+	auto* pFragmentShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/" + pFragmentShaderName);
 	assert(pFragmentShader != nullptr);
 
 	pPass->AddShader(pVertexShader);
@@ -34,7 +49,7 @@ void LitColorAttributeVisualEffect::InitCustomEffect()
 
 	assert(mpTargetNode != nullptr);
 	mpTargetNode->SetIsLit(true); // lit node !
-	mpTargetNode->AddAllowedPass(VisualPass::PassType::GE_PT_STANDARD);
+	mpTargetNode->AddAllowedPass(pPass->GetPassType());
 	pPass->SetNode(mpTargetNode);
 
 	mPassMap[pPass->GetPassType()].push_back(pPass);
@@ -1,5 +1,6 @@
 #include "Graphics/Rendering/VisualEffects/LitEffects/LitColorVisualEffect.hpp"
 #include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
+#include "Graphics/Rendering/Renderer.hpp"
 #include "Graphics/Rendering/Resources/Shader.hpp"
 #include "Graphics/Rendering/Resources/UniformBuffer.hpp"
 #include "Graphics/SceneGraph/GeometryNode.hpp"
@@ -25,12 +26,26 @@ LitColorVisualEffect::~LitColorVisualEffect()
 
 void LitColorVisualEffect::InitCustomEffect()
 {
+#if defined(DEFERRED_RENDERING)
+	// the G-buffer is lit later by the renderer, see DeferredLightingVisualEffect
+	assert(mpRenderer != nullptr);
+
+	auto* pPass = GE_ALLOC(VisualPass)(VisualPass::PassType::GE_PT_GBUFFER);
+	assert(pPass != nullptr);
+
+	mpRenderer->GetGBuffer().AddRenderTargets(pPass);
+
+	const char_t* pFragmentShaderName = "gbufferColor.frag";
+#else
 	auto* pPass = GE_ALLOC(VisualPass)(VisualPass::PassType::GE_PT_STANDARD);
 	assert(pPass != nullptr);
 
+	const char_t* pFragmentShaderName = "litColor.frag";
+#endif // DEFERRED_RENDERING
+
 	auto* pVertexShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/litColor.vert");
 	assert(pVertexShader != nullptr);
-	auto* pFragmentShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/litColor.frag");
+	auto* pFragmentShader = GE_ALLOC(Shader)(std::string() + GE_ASSET_PATH + "shaders/VisualEffects/LitEffects/" + pFragmentShaderName);
 	assert(pFragmentShader != nullptr);
 
 	pPass->AddShader(pVertexShader);
@@ -60,7 +75,7 @@ void LitColorVisualEffect::InitCustomEffect()
 
 	assert(mpTargetNode != nullptr);
 	mpTargetNode->SetIsLit(true); // lit node !
-	mpTargetNode->AddAllowedPass(VisualPass::PassType::GE_PT_STANDARD);
+	mpTargetNode->AddAllowedPass(pPass->GetPassType());
 	pPass->SetNode(mpTargetNode);
 
 	mPassMap[pPass->GetPassType()].push_back(pPass);
@@ -1,6 +1,7 @@
 #include "Graphics/Rendering/VisualEffects/VisualEffect.hpp"
 #include "Graphics/Rendering/Renderer.hpp"
 #include "Graphics/Rendering/Resources/VertexFormat.hpp"
+#include "Graphics/Rendering/Resources/Texture.hpp"
 #include "Graphics/Cameras/Camera.hpp"
 #include "Graphics/SceneGraph/GeometryNode.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
@@ -12,6 +13,7 @@ using namespace GraphicsEngine::Graphics;
 
 VisualEffect::VisualEffect()
 	: mEffectType(EffectType::GE_PT_COUNT)
+	, mpRenderer(nullptr)
 	, mpTargetNode(nullptr)
 	, mPrimitiveTopology(VisualPass::PrimitiveTopology::GE_PT_COUNT)
 	, mFaceWinding(VisualPass::FaceWinding::GE_FW_COUNT)
@@ -36,10 +38,16 @@ VisualEffect::~VisualEffect()
 		}
 	}
 	mPassMap.clear();
+
+	mpRenderer = nullptr;
 }
 
-void VisualEffect::Init()
+void VisualEffect::Init(Renderer* pRenderer)
 {
+	assert(pRenderer != nullptr);
+
+	mpRenderer = pRenderer;
+
 	InitCustomEffect();
 }
 
@@ -76,6 +84,31 @@ const VisualEffect::PassMap& VisualEffect::GetPasses() const
 	return mPassMap;
 }
 
+RenderTarget* VisualEffect::FindRenderTarget(const Texture* pTexture) const
+{
+	assert(pTexture != nullptr);
+
+	for (auto& it : mPassMap)
+	{
+		for (auto* pPass : it.second)
+		{
+			if (pPass)
+			{
+				for (auto& rtIt : pPass->GetRenderTargets())
+				{
+					auto* pRT = rtIt.second;
+					assert(pRT != nullptr);
+
+					if (pRT->GetTexture() == pTexture)
+						return pRT;
+				}
+			}
+		}
+	}
+
+	return nullptr;
+}
+
 void VisualEffect::SetPrimitiveTopology(VisualPass::PrimitiveTopology topology)
 {
 	mPrimitiveTopology = topology;
@@ -15,6 +15,7 @@ namespace GraphicsEngine
 		class Camera;
 
 		class Texture;
+		class RenderTarget;
 		class UniformBuffer;
 
 		class GeometryNode;
@@ -41,7 +42,7 @@ namespace GraphicsEngine
 			explicit VisualEffect(VisualEffect::EffectType effectType);
 			~VisualEffect();
 
-			virtual void Init();
+			virtual void Init(Renderer* pRenderer);
 			virtual void Reset(); // screen resize
 
 
@@ -49,6 +50,9 @@ namespace GraphicsEngine
 
 			const VisualEffect::PassMap& GetPasses() const;
 
+			// the render target of a texture sampled by the passes, searched in the render targets of the passes by default
+			virtual RenderTarget* FindRenderTarget(const Texture* pTexture) const;
+
 			void SetTargetNode(GeometryNode* pGeoNode);
 			GeometryNode* GetTargetNode();
 
@@ -71,6 +75,8 @@ namespace GraphicsEngine
 
 			PassMap mPassMap;
 
+			Renderer* mpRenderer; // the renderer the effect is initialized for
+
 			GeometryNode* mpTargetNode; // node the effect shall be applied on
 			std::vector<GeometryNode*> mDependencyNodes; // nodes the effect may depend upon (offscreen effects, etc.)
 
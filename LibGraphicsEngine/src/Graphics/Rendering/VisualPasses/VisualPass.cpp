@@ -6,6 +6,7 @@
 #include "Graphics/ShaderTools/GLSL/GLSLShaderParser.hpp"
 #include "Graphics/SceneGraph/GeometryNode.hpp"
 #include "Graphics/SceneGraph/LightNode.hpp"
+#include "Graphics/Lights/ShadowCascades.hpp"
 #include "Foundation/Logger.hpp"
 #include <string>
 #include <cassert>
@@ -15,6 +16,9 @@
 #elif defined(OPENGL_RENDERER)
 #include "Graphics/Rendering/Backends/OpenGL/VisualPasses/OpenGLVisualPass.hpp"
 #define IS_GL_NDK 1
+#elif defined(NULL_RENDERER)
+#include "Graphics/Rendering/Backends/Null/VisualPasses/NullVisualPass.hpp"
+#define IS_GL_NDK 1 // GL clip space, as the camera doesn't flip the projection
 #endif //
 
 using namespace GraphicsEngine;
@@ -32,6 +36,7 @@ VisualPass::VisualPass()
 	, mpRenderer(nullptr)
 	, mSkipUniformsSetup(false)
 	, mIsDebug(false)
+	, mIsFullScreen(false)
 {}
 
 VisualPass::VisualPass(VisualPass::PassType type)
@@ -110,6 +115,16 @@ void VisualPass::SetupRenderData()
 		mRenderData.depth = 1.0f;
 		mRenderData.stencil = 0.0f;
 	} break;
+	case PassType::GE_PT_GBUFFER:
+	{
+		auto* pAlbedoRT = GetRenderTarget(RenderTarget::TargetType::GE_TT_COLOR);
+		assert(pAlbedoRT != nullptr);
+
+		mRenderData.width = pAlbedoRT->GetWidth();
+		mRenderData.height = pAlbedoRT->GetHeight();
+		mRenderData.depth = 1.0f;
+		mRenderData.stencil = 0.0f;
+	} break;
 	case PassType::GE_PT_SHADOWS:
 	{
 		assert(mRenderTargetMap.size() == 1);
@@ -235,8 +250,8 @@ void VisualPass::SetupUniforms()
 	}
 	else
 	{
-		// NOTE! In debug mode we can have shaders like debugShadowRT.vert which don't have a UBO
-		if (false == GetIsDebug())
+		// NOTE! In debug mode we can have shaders like debugShadowRT.vert which don't have a UBO, same for the full screen passes
+		if ((false == GetIsDebug()) && (false == GetIsFullScreen()))
 		{
 			LOG_ERROR("Vertex shader UniformBlock is invalid!");
 		}
@@ -303,6 +318,10 @@ void VisualPass::SetupUniforms()
 		}
 	}
 
+	// the G-buffer passes only store the surface attributes, the lights are applied by the lighting passes
+	if (mPassType == VisualPass::PassType::GE_PT_GBUFFER)
+		return;
+
 	it = mShaderMap.find(Shader::ShaderStage::GE_SS_FRAGMENT);
 	assert(it != mShaderMap.end());
 
@@ -431,6 +450,21 @@ void VisualPass::SetupShadowUniforms()
 		{
 			pUB->AddUniform(GLSLShaderTypes::UniformType::GE_UT_LIGHT_PVM_MATRIX4); // no value added as it is gonna be updated per frame!
 		}
+		else if (uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_CASCADE_PV_MATRIX[0]) != uboMembers.end())
+		{
+			// cascaded shadows of a directional light, a matrix per cascade, see ShadowCascades
+			for (uint8_t i = 0; i < ShadowCascades::MAX_CASCADE_COUNT; ++i)
+			{
+				it = uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_CASCADE_PV_MATRIX[i]);
+				if (it == uboMembers.end() || it->second.type != GLSLShaderTypes::Constants::MAT4_TYPE)
+				{
+					LOG_ERROR("Cascade PV matrix uniform %u not found in shader: %s! Abort!", i, pVertexShader->GetSourcePath().c_str());
+					return;
+				}
+
+				pUB->AddUniform(static_cast<GLSLShaderTypes::UniformType>(static_cast<uint8_t>(GLSLShaderTypes::UniformType::GE_UT_CASCADE_PV0_MATRIX4) + i)); // no value added as it is gonna be updated per frame!
+			}
+		}
 		else
 		{
 			LOG_ERROR("Light PVM matrix uniform not found in shader: %s! Abort!", pVertexShader->GetSourcePath().c_str());
@@ -453,6 +487,49 @@ void VisualPass::SetupShadowUniforms()
 			AddUniformBuffer(Shader::ShaderStage::GE_SS_VERTEX, pUB);
 		}
 	}
+
+	///////// SETUP CASCADE SPLITS
+	// the fragment shaders of the cascaded shadows select the cascade by depth
+	it = mShaderMap.find(Shader::ShaderStage::GE_SS_FRAGMENT);
+	if (it == mShaderMap.end())
+		return;
+
+	auto* pFragmentShader = it->second;
+	assert(pFragmentShader != nullptr);
+
+	auto* pFragParser = pFragmentShader->GetGLSLParser();
+	assert(pFragParser != nullptr);
+
+	if (pFragParser->GetUniformBlock().IsValid())
+	{
+		auto& uboMembers = pFragParser->GetUniformBlock().members;
+
+		auto splitsIt = uboMembers.find(GLSLShaderTypes::Constants::UNIFORM_CASCADE_SPLITS);
+		if (splitsIt == uboMembers.end())
+			return;
+
+		if (splitsIt->second.type != GLSLShaderTypes::Constants::VEC4_TYPE)
+		{
+			LOG_ERROR("Cascade splits uniform is not a vec4 in shader: %s! Abort!", pFragmentShader->GetSourcePath().c_str());
+			return;
+		}
+
+		auto* pUB = GetUniformBuffer(Shader::ShaderStage::GE_SS_FRAGMENT);
+		bool_t shouldAddUb = false;
+		if (nullptr == pUB)
+		{
+			pUB = GE_ALLOC(UniformBuffer);
+			shouldAddUb = true;
+		}
+		assert(pUB != nullptr);
+
+		pUB->AddUniform(GLSLShaderTypes::UniformType::GE_UT_CASCADE_SPLITS); // no value added as it is gonna be updated per frame!
+
+		if (shouldAddUb)
+		{
+			AddUniformBuffer(Shader::ShaderStage::GE_SS_FRAGMENT, pUB);
+		}
+	}
 }
 
 void VisualPass::BindLights()
@@ -463,6 +540,9 @@ void VisualPass::BindLights()
 		mpVisualEffect->GetEffectType() != VisualEffect::EffectType::GE_ET_LIT_SHADOWS)
 		return;
 
+	if (mPassType == VisualPass::PassType::GE_PT_GBUFFER)
+		return;
+
 	assert(mpRenderer != nullptr);
 
 	auto* pRenderQueue = mpRenderer->GetRenderQueue();
@@ -746,6 +826,9 @@ std::string VisualPass::PassTypeToStr(VisualPass::PassType type)
 	case PassType::GE_PT_SHADOWS:
 		str = "Shadows";
 		break;
+	case PassType::GE_PT_GBUFFER:
+		str = "GBuffer";
+		break;
 	case PassType::GE_PT_STANDARD:
 		str = "Standard";
 		break;
@@ -770,4 +853,14 @@ void VisualPass::SetIsDebug(bool_t val)
 bool_t VisualPass::GetIsDebug() const
 {
 	return mIsDebug;
+}
+
+void VisualPass::SetIsFullScreen(bool_t val)
+{
+	mIsFullScreen = val;
+}
+
+bool_t VisualPass::GetIsFullScreen() const
+{
+	return mIsFullScreen;
 }
\ No newline at end of file
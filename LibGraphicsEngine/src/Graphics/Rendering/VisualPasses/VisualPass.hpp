@@ -10,6 +10,7 @@
 #include "Graphics/Rendering/PipelineStates/ColorBlendState.hpp"
 #include "Graphics/Rendering/PipelineStates/DynamicState.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/MemoryManagement/ObjectPool.hpp"
 #include "glm/mat4x4.hpp"
 #include <vector>
 #include <unordered_map>
@@ -34,6 +35,7 @@ namespace GraphicsEngine
 		class VisualPass : public Object
 		{
 			GE_RTTI(GraphicsEngine::Graphics::VisualPass)
+			GE_POOLED_OBJECT(VisualPass)
 
 		public:
 			enum class PassType : uint8_t
@@ -41,7 +43,8 @@ namespace GraphicsEngine
 				// ordered by the render order
 				GE_PT_OFFSCREEN = 1, // render to an offscreen framebuffer
 				GE_PT_SHADOWS = 2, // shadows, a variant of offscreen rendering
-				GE_PT_STANDARD = 3, // render to screen - last pass, rename to GE_PT_PRESENT ???
+				GE_PT_GBUFFER = 3, // deferred rendering - render the surface attributes to the renderer's G-buffer
+				GE_PT_STANDARD = 4, // render to screen - last pass, rename to GE_PT_PRESENT ???
 				GE_PT_COUNT
 			};
 
@@ -171,6 +174,10 @@ namespace GraphicsEngine
 			void SetIsDebug(bool_t val);
 			bool_t GetIsDebug() const;
 
+			// full screen triangle generated in the vertex shader, the node has no geometry
+			void SetIsFullScreen(bool_t val);
+			bool_t GetIsFullScreen() const;
+
 		protected:
 			void SetupRenderData();
 			void SetupUniforms();
@@ -213,6 +220,7 @@ namespace GraphicsEngine
 			bool_t mSkipUniformsSetup;
 
 			bool_t mIsDebug;
+			bool_t mIsFullScreen;
 
 		private:
 			NO_COPY_NO_MOVE_CLASS(VisualPass)
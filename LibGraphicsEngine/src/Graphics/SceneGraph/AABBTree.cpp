@@ -0,0 +1,816 @@
+#include "Graphics/SceneGraph/AABBTree.hpp"
+#include "Graphics/Cameras/Frustum.hpp"
+#include "glm/common.hpp" // glm::min(), glm::max(), glm::abs()
+#include "glm/geometric.hpp" // glm::dot()
+#include <algorithm> // std::max()
+#include <limits>
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+namespace
+{
+	// traversal stack, grows if needed
+	static const uint32_t STACK_SIZE = 64;
+
+	static const uint32_t FRUSTUM_PLANE_COUNT = static_cast<uint32_t>(Frustum::Plane::GE_FP_COUNT);
+	static const uint8_t ALL_PLANES_MASK = (1 << FRUSTUM_PLANE_COUNT) - 1;
+
+	static AABBTree::AABB Union(const AABBTree::AABB& a, const AABBTree::AABB& b)
+	{
+		AABBTree::AABB result;
+		result.min = glm::min(a.min, b.min);
+		result.max = glm::max(a.max, b.max);
+
+		return result;
+	}
+
+	// half of the surface area, enough to compare the costs
+	static float32_t Area(const AABBTree::AABB& aabb)
+	{
+		const glm::vec3 d = aabb.max - aabb.min;
+
+		return d.x * d.y + d.y * d.z + d.z * d.x;
+	}
+
+	static bool_t Contains(const AABBTree::AABB& outer, const glm::vec3& min, const glm::vec3& max)
+	{
+		return (outer.min.x <= min.x) && (outer.min.y <= min.y) && (outer.min.z <= min.z) &&
+			(max.x <= outer.max.x) && (max.y <= outer.max.y) && (max.z <= outer.max.z);
+	}
+
+	static bool_t Contains(const AABBTree::AABB& outer, const AABBTree::AABB& inner)
+	{
+		return Contains(outer, inner.min, inner.max);
+	}
+
+	static bool_t Overlaps(const AABBTree::AABB& aabb, const glm::vec3& min, const glm::vec3& max)
+	{
+		return (aabb.min.x <= max.x) && (aabb.min.y <= max.y) && (aabb.min.z <= max.z) &&
+			(min.x <= aabb.max.x) && (min.y <= aabb.max.y) && (min.z <= aabb.max.z);
+	}
+
+	// collects the proxies in the output array
+	struct CollectVisitor
+	{
+		explicit CollectVisitor(std::vector<uint32_t>& proxies)
+			: proxies(proxies)
+		{}
+
+		bool_t operator()(uint32_t proxyId)
+		{
+			proxies.push_back(proxyId);
+			return true;
+		}
+
+		std::vector<uint32_t>& proxies;
+	};
+
+	struct CallbackVisitor
+	{
+		explicit CallbackVisitor(const AABBTree::QueryCallback& callback)
+			: callback(callback)
+		{}
+
+		bool_t operator()(uint32_t proxyId)
+		{
+			return callback(proxyId);
+		}
+
+		const AABBTree::QueryCallback& callback;
+	};
+
+	struct SphereTest
+	{
+		bool_t operator()(const AABBTree::AABB& aabb) const
+		{
+			const glm::vec3 d = glm::max(glm::max(aabb.min - center, center - aabb.max), glm::vec3(0.0f));
+			return (glm::dot(d, d) <= radius2);
+		}
+
+		glm::vec3 center;
+		float32_t radius2;
+	};
+
+	struct AABBTest
+	{
+		bool_t operator()(const AABBTree::AABB& aabb) const
+		{
+			return Overlaps(aabb, min, max);
+		}
+
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
+	// slab test
+	struct RayTest
+	{
+		bool_t operator()(const AABBTree::AABB& aabb) const
+		{
+			const glm::vec3 t1 = (aabb.min - origin) * invDirection;
+			const glm::vec3 t2 = (aabb.max - origin) * invDirection;
+			const glm::vec3 tNear = glm::min(t1, t2);
+			const glm::vec3 tFar = glm::max(t1, t2);
+
+			const float32_t tEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+			const float32_t tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+
+			return (tEnter <= tExit);
+		}
+
+		glm::vec3 origin;
+		glm::vec3 invDirection;
+		float32_t maxT;
+	};
+
+	// frustum test of an AABB against the planes of the mask, the planes the AABB is fully inside are removed from the mask
+	// returns false if the AABB is outside
+	static bool_t TestFrustum(const Frustum& frustum, const AABBTree::AABB& aabb, uint8_t& mask)
+	{
+		const glm::vec3 center = (aabb.min + aabb.max) * 0.5f;
+		const glm::vec3 extent = (aabb.max - aabb.min) * 0.5f;
+
+		for (uint32_t i = 0; i < FRUSTUM_PLANE_COUNT; ++i)
+		{
+			if (0 == (mask & (1 << i)))
+				continue;
+
+			const glm::vec4& plane = frustum.GetPlane(static_cast<Frustum::Plane>(i));
+			const glm::vec3 normal(plane);
+
+			const float32_t distance = glm::dot(normal, center) + plane.w;
+			const float32_t radius = glm::dot(glm::abs(normal), extent);
+
+			if (distance < -radius)
+				return false;
+
+			if (distance >= radius)
+			{
+				mask &= ~(1 << i);
+			}
+		}
+
+		return true;
+	}
+}
+
+const float32_t AABBTree::DEFAULT_MARGIN = 0.1f;
+const uint32_t AABBTree::NULL_NODE;
+
+AABBTree::AABBTree(float32_t margin)
+	: mMargin(margin)
+	, mRoot(NULL_NODE)
+	, mFreeList(NULL_NODE)
+	, mProxyCount(0)
+{
+	assert(mMargin >= 0.0f);
+}
+
+AABBTree::~AABBTree()
+{
+	Clear();
+}
+
+void AABBTree::Clear()
+{
+	mNodes.clear();
+	mRoot = NULL_NODE;
+	mFreeList = NULL_NODE;
+	mProxyCount = 0;
+}
+
+uint32_t AABBTree::AllocateNode()
+{
+	if (NULL_NODE == mFreeList)
+	{
+		Node node;
+		node.parent = NULL_NODE;
+		mNodes.push_back(node);
+
+		mFreeList = static_cast<uint32_t>(mNodes.size() - 1);
+	}
+
+	const uint32_t nodeId = mFreeList;
+	Node& node = mNodes[nodeId];
+	mFreeList = node.parent;
+
+	node.pUserData = nullptr;
+	node.parent = NULL_NODE;
+	node.child1 = NULL_NODE;
+	node.child2 = NULL_NODE;
+	node.height = 0;
+	node.isDirty = false;
+
+	return nodeId;
+}
+
+void AABBTree::FreeNode(uint32_t nodeId)
+{
+	assert(nodeId < mNodes.size());
+
+	Node& node = mNodes[nodeId];
+	node.parent = mFreeList;
+	node.height = -1;
+
+	mFreeList = nodeId;
+}
+
+uint32_t AABBTree::CreateProxy(const glm::vec3& min, const glm::vec3& max, void* pUserData)
+{
+	const uint32_t proxyId = AllocateNode();
+
+	SetFatAABB(proxyId, min, max);
+	mNodes[proxyId].pUserData = pUserData;
+
+	InsertLeaf(proxyId);
+	mProxyCount++;
+
+	return proxyId;
+}
+
+void AABBTree::DestroyProxy(uint32_t proxyId)
+{
+	assert(proxyId < mNodes.size());
+	assert(mNodes[proxyId].IsLeaf());
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+	mProxyCount--;
+}
+
+bool_t AABBTree::MoveProxy(uint32_t proxyId, const glm::vec3& min, const glm::vec3& max)
+{
+	assert(proxyId < mNodes.size());
+	assert(mNodes[proxyId].IsLeaf());
+
+	if (Contains(mNodes[proxyId].aabb, min, max))
+		return false;
+
+	RemoveLeaf(proxyId);
+	SetFatAABB(proxyId, min, max);
+	InsertLeaf(proxyId);
+
+	return true;
+}
+
+bool_t AABBTree::SetProxyBounds(uint32_t proxyId, const glm::vec3& min, const glm::vec3& max)
+{
+	assert(proxyId < mNodes.size());
+	assert(mNodes[proxyId].IsLeaf());
+
+	if (Contains(mNodes[proxyId].aabb, min, max))
+		return false;
+
+	SetFatAABB(proxyId, min, max);
+
+	// mark the path to the root, up to the first node already marked
+	uint32_t nodeId = mNodes[proxyId].parent;
+	while ((nodeId != NULL_NODE) && (false == mNodes[nodeId].isDirty))
+	{
+		mNodes[nodeId].isDirty = true;
+		nodeId = mNodes[nodeId].parent;
+	}
+
+	return true;
+}
+
+void AABBTree::Refit()
+{
+	if ((NULL_NODE == mRoot) || (false == mNodes[mRoot].isDirty))
+		return;
+
+	// post order: the children are refitted before their parent
+	std::vector<uint32_t> stack;
+	stack.reserve(STACK_SIZE);
+	stack.push_back(mRoot);
+
+	while (false == stack.empty())
+	{
+		const uint32_t nodeId = stack.back();
+		Node& node = mNodes[nodeId];
+
+		const bool_t isChild1Dirty = mNodes[node.child1].isDirty;
+		const bool_t isChild2Dirty = mNodes[node.child2].isDirty;
+		if (isChild1Dirty || isChild2Dirty)
+		{
+			if (isChild1Dirty)
+			{
+				stack.push_back(node.child1);
+			}
+			if (isChild2Dirty)
+			{
+				stack.push_back(node.child2);
+			}
+			continue;
+		}
+
+		stack.pop_back();
+
+		node.aabb = Union(mNodes[node.child1].aabb, mNodes[node.child2].aabb);
+		node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+		node.isDirty = false;
+
+		Rotate(nodeId);
+	}
+}
+
+void* AABBTree::GetUserData(uint32_t proxyId) const
+{
+	assert(proxyId < mNodes.size());
+
+	return mNodes[proxyId].pUserData;
+}
+
+const AABBTree::AABB& AABBTree::GetFatAABB(uint32_t proxyId) const
+{
+	assert(proxyId < mNodes.size());
+
+	return mNodes[proxyId].aabb;
+}
+
+void AABBTree::SetFatAABB(uint32_t leaf, const glm::vec3& min, const glm::vec3& max)
+{
+	const glm::vec3 margin(mMargin);
+
+	mNodes[leaf].aabb.min = min - margin;
+	mNodes[leaf].aabb.max = max + margin;
+}
+
+void AABBTree::InsertLeaf(uint32_t leaf)
+{
+	if (NULL_NODE == mRoot)
+	{
+		mRoot = leaf;
+		mNodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// find the best sibling: the cost of a node is the area of the new parent
+	// plus the area added to the ancestors (inherited cost)
+	const AABB leafAABB = mNodes[leaf].aabb;
+
+	uint32_t index = mRoot;
+	while (false == mNodes[index].IsLeaf())
+	{
+		const Node& node = mNodes[index];
+
+		const float32_t area = Area(node.aabb);
+		const float32_t combinedArea = Area(Union(node.aabb, leafAABB));
+
+		// sibling of this node
+		const float32_t cost = 2.0f * combinedArea;
+		// descending further adds at least this much to this node
+		const float32_t inheritedCost = 2.0f * (combinedArea - area);
+
+		auto childCost = [this, &leafAABB, inheritedCost](uint32_t childId)
+		{
+			const Node& child = mNodes[childId];
+			const float32_t newArea = Area(Union(leafAABB, child.aabb));
+
+			return child.IsLeaf() ? (newArea + inheritedCost) : (newArea - Area(child.aabb) + inheritedCost);
+		};
+
+		const float32_t cost1 = childCost(node.child1);
+		const float32_t cost2 = childCost(node.child2);
+
+		if ((cost < cost1) && (cost < cost2))
+			break;
+
+		index = (cost1 < cost2) ? node.child1 : node.child2;
+	}
+
+	const uint32_t sibling = index;
+
+	// new parent of the sibling and the leaf
+	const uint32_t oldParent = mNodes[sibling].parent;
+	const uint32_t newParent = AllocateNode();
+
+	Node& parentNode = mNodes[newParent];
+	parentNode.parent = oldParent;
+	parentNode.aabb = Union(leafAABB, mNodes[sibling].aabb);
+	parentNode.height = mNodes[sibling].height + 1;
+	parentNode.child1 = sibling;
+	parentNode.child2 = leaf;
+
+	if (oldParent != NULL_NODE)
+	{
+		if (mNodes[oldParent].child1 == sibling)
+		{
+			mNodes[oldParent].child1 = newParent;
+		}
+		else
+		{
+			mNodes[oldParent].child2 = newParent;
+		}
+	}
+	else
+	{
+		mRoot = newParent;
+	}
+
+	mNodes[sibling].parent = newParent;
+	mNodes[leaf].parent = newParent;
+
+	RefitAncestors(mNodes[leaf].parent);
+}
+
+void AABBTree::RemoveLeaf(uint32_t leaf)
+{
+	if (leaf == mRoot)
+	{
+		mRoot = NULL_NODE;
+		return;
+	}
+
+	const uint32_t parent = mNodes[leaf].parent;
+	const uint32_t grandParent = mNodes[parent].parent;
+	const uint32_t sibling = (mNodes[parent].child1 == leaf) ? mNodes[parent].child2 : mNodes[parent].child1;
+
+	if (grandParent != NULL_NODE)
+	{
+		// the sibling takes the place of the parent
+		if (mNodes[grandParent].child1 == parent)
+		{
+			mNodes[grandParent].child1 = sibling;
+		}
+		else
+		{
+			mNodes[grandParent].child2 = sibling;
+		}
+		mNodes[sibling].parent = grandParent;
+
+		// a pending refit is kept for the ancestors
+		mNodes[grandParent].isDirty = (mNodes[grandParent].isDirty || mNodes[parent].isDirty);
+
+		FreeNode(parent);
+
+		RefitAncestors(grandParent);
+	}
+	else
+	{
+		mRoot = sibling;
+		mNodes[sibling].parent = NULL_NODE;
+
+		FreeNode(parent);
+	}
+
+	mNodes[leaf].parent = NULL_NODE;
+}
+
+void AABBTree::RefitAncestors(uint32_t nodeId)
+{
+	while (nodeId != NULL_NODE)
+	{
+		Node& node = mNodes[nodeId];
+		assert(node.child1 != NULL_NODE);
+		assert(node.child2 != NULL_NODE);
+
+		node.aabb = Union(mNodes[node.child1].aabb, mNodes[node.child2].aabb);
+		node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+
+		Rotate(nodeId);
+
+		nodeId = node.parent;
+	}
+}
+
+void AABBTree::Rotate(uint32_t nodeId)
+{
+	// A = (B, C), B = (D, E), C = (F, G)
+	// a child is swapped with a grandchild on the other side, e.g. B <-> F: A = (F, C), C = (B, G)
+	// the bounds of A don't change, only the bounds of the internal node which loses the grandchild
+	Node& a = mNodes[nodeId];
+	const uint32_t bId = a.child1;
+	const uint32_t cId = a.child2;
+	Node& b = mNodes[bId];
+	Node& c = mNodes[cId];
+
+	enum class Rotation : uint8_t { NONE, BF, BG, CD, CE };
+	Rotation bestRotation = Rotation::NONE;
+	float32_t bestGain = 0.0f;
+
+	if (false == c.IsLeaf())
+	{
+		const float32_t areaC = Area(c.aabb);
+
+		// B <-> F: C = (B, G)
+		const float32_t gainBF = areaC - Area(Union(b.aabb, mNodes[c.child2].aabb));
+		if (gainBF > bestGain)
+		{
+			bestRotation = Rotation::BF;
+			bestGain = gainBF;
+		}
+
+		// B <-> G: C = (F, B)
+		const float32_t gainBG = areaC - Area(Union(b.aabb, mNodes[c.child1].aabb));
+		if (gainBG > bestGain)
+		{
+			bestRotation = Rotation::BG;
+			bestGain = gainBG;
+		}
+	}
+
+	if (false == b.IsLeaf())
+	{
+		const float32_t areaB = Area(b.aabb);
+
+		// C <-> D: B = (C, E)
+		const float32_t gainCD = areaB - Area(Union(c.aabb, mNodes[b.child2].aabb));
+		if (gainCD > bestGain)
+		{
+			bestRotation = Rotation::CD;
+			bestGain = gainCD;
+		}
+
+		// C <-> E: B = (D, C)
+		const float32_t gainCE = areaB - Area(Union(c.aabb, mNodes[b.child1].aabb));
+		if (gainCE > bestGain)
+		{
+			bestRotation = Rotation::CE;
+			bestGain = gainCE;
+		}
+	}
+
+	// child of A swapped, the other child of A which receives it, and the grandchild slot
+	uint32_t childId = NULL_NODE, otherId = NULL_NODE;
+	uint32_t* pGrandChildSlot = nullptr;
+	uint32_t* pChildSlot = nullptr;
+
+	switch (bestRotation)
+	{
+	case Rotation::BF:
+		childId = bId; otherId = cId; pChildSlot = &a.child1; pGrandChildSlot = &c.child1;
+		break;
+	case Rotation::BG:
+		childId = bId; otherId = cId; pChildSlot = &a.child1; pGrandChildSlot = &c.child2;
+		break;
+	case Rotation::CD:
+		childId = cId; otherId = bId; pChildSlot = &a.child2; pGrandChildSlot = &b.child1;
+		break;
+	case Rotation::CE:
+		childId = cId; otherId = bId; pChildSlot = &a.child2; pGrandChildSlot = &b.child2;
+		break;
+	case Rotation::NONE:
+	default:
+		return;
+	}
+
+	const uint32_t grandChildId = *pGrandChildSlot;
+
+	*pChildSlot = grandChildId;
+	mNodes[grandChildId].parent = nodeId;
+
+	*pGrandChildSlot = childId;
+	mNodes[childId].parent = otherId;
+
+	Node& other = mNodes[otherId];
+	other.aabb = Union(mNodes[other.child1].aabb, mNodes[other.child2].aabb);
+	other.height = 1 + std::max(mNodes[other.child1].height, mNodes[other.child2].height);
+
+	a.height = 1 + std::max(mNodes[a.child1].height, mNodes[a.child2].height);
+}
+
+template <typename NodeTest, typename LeafVisitor>
+void AABBTree::Query(const NodeTest& test, LeafVisitor& visitor) const
+{
+	if (NULL_NODE == mRoot)
+		return;
+
+	std::vector<uint32_t> stack;
+	stack.reserve(STACK_SIZE);
+	stack.push_back(mRoot);
+
+	while (false == stack.empty())
+	{
+		const uint32_t nodeId = stack.back();
+		stack.pop_back();
+
+		const Node& node = mNodes[nodeId];
+		if (false == test(node.aabb))
+			continue;
+
+		if (node.IsLeaf())
+		{
+			if (false == visitor(nodeId))
+				return;
+		}
+		else
+		{
+			stack.push_back(node.child2);
+			stack.push_back(node.child1);
+		}
+	}
+}
+
+void AABBTree::QueryFrustum(const Frustum& frustum, const QueryCallback& callback) const
+{
+	if (NULL_NODE == mRoot)
+		return;
+
+	// a node fully inside some planes is not tested against them again in its subtree
+	std::vector<std::pair<uint32_t, uint8_t>> stack;
+	stack.reserve(STACK_SIZE);
+	stack.push_back(std::make_pair(mRoot, ALL_PLANES_MASK));
+
+	while (false == stack.empty())
+	{
+		const uint32_t nodeId = stack.back().first;
+		uint8_t mask = stack.back().second;
+		stack.pop_back();
+
+		const Node& node = mNodes[nodeId];
+		if ((mask != 0) && (false == TestFrustum(frustum, node.aabb, mask)))
+			continue;
+
+		if (node.IsLeaf())
+		{
+			if (false == callback(nodeId))
+				return;
+		}
+		else
+		{
+			stack.push_back(std::make_pair(node.child2, mask));
+			stack.push_back(std::make_pair(node.child1, mask));
+		}
+	}
+}
+
+void AABBTree::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& proxiesOut) const
+{
+	if (NULL_NODE == mRoot)
+		return;
+
+	std::vector<std::pair<uint32_t, uint8_t>> stack;
+	stack.reserve(STACK_SIZE);
+	stack.push_back(std::make_pair(mRoot, ALL_PLANES_MASK));
+
+	while (false == stack.empty())
+	{
+		const uint32_t nodeId = stack.back().first;
+		uint8_t mask = stack.back().second;
+		stack.pop_back();
+
+		const Node& node = mNodes[nodeId];
+		if ((mask != 0) && (false == TestFrustum(frustum, node.aabb, mask)))
+			continue;
+
+		if (node.IsLeaf())
+		{
+			proxiesOut.push_back(nodeId);
+		}
+		else
+		{
+			stack.push_back(std::make_pair(node.child2, mask));
+			stack.push_back(std::make_pair(node.child1, mask));
+		}
+	}
+}
+
+void AABBTree::QuerySphere(const glm::vec3& center, float32_t radius, const QueryCallback& callback) const
+{
+	SphereTest test;
+	test.center = center;
+	test.radius2 = radius * radius;
+
+	CallbackVisitor visitor(callback);
+	Query(test, visitor);
+}
+
+void AABBTree::QuerySphere(const glm::vec3& center, float32_t radius, std::vector<uint32_t>& proxiesOut) const
+{
+	SphereTest test;
+	test.center = center;
+	test.radius2 = radius * radius;
+
+	CollectVisitor visitor(proxiesOut);
+	Query(test, visitor);
+}
+
+void AABBTree::QueryAABB(const glm::vec3& min, const glm::vec3& max, const QueryCallback& callback) const
+{
+	AABBTest test;
+	test.min = min;
+	test.max = max;
+
+	CallbackVisitor visitor(callback);
+	Query(test, visitor);
+}
+
+void AABBTree::QueryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& proxiesOut) const
+{
+	AABBTest test;
+	test.min = min;
+	test.max = max;
+
+	CollectVisitor visitor(proxiesOut);
+	Query(test, visitor);
+}
+
+void AABBTree::RayCast(const glm::vec3& origin, const glm::vec3& direction, float32_t maxT, const QueryCallback& callback) const
+{
+	// a zero component gives +-inf, which the slab test handles
+	RayTest test;
+	test.origin = origin;
+	test.invDirection = glm::vec3(1.0f) / direction;
+	test.maxT = maxT;
+
+	CallbackVisitor visitor(callback);
+	Query(test, visitor);
+}
+
+void AABBTree::RayCast(const glm::vec3& origin, const glm::vec3& direction, float32_t maxT, std::vector<uint32_t>& proxiesOut) const
+{
+	RayTest test;
+	test.origin = origin;
+	test.invDirection = glm::vec3(1.0f) / direction;
+	test.maxT = maxT;
+
+	CollectVisitor visitor(proxiesOut);
+	Query(test, visitor);
+}
+
+uint32_t AABBTree::GetProxyCount() const
+{
+	return mProxyCount;
+}
+
+uint32_t AABBTree::GetNodeCount() const
+{
+	return (mProxyCount > 0) ? (2 * mProxyCount - 1) : 0;
+}
+
+int32_t AABBTree::GetHeight() const
+{
+	return (NULL_NODE == mRoot) ? 0 : mNodes[mRoot].height;
+}
+
+float32_t AABBTree::ComputeSAHCost() const
+{
+	if ((NULL_NODE == mRoot) || mNodes[mRoot].IsLeaf())
+		return 0.0f;
+
+	const float32_t rootArea = Area(mNodes[mRoot].aabb);
+	if (rootArea <= 0.0f)
+		return 0.0f;
+
+	float32_t totalArea = 0.0f;
+	for (const auto& node : mNodes)
+	{
+		if ((node.height > 0) && (false == node.IsLeaf()))
+		{
+			totalArea += Area(node.aabb);
+		}
+	}
+
+	return totalArea / rootArea;
+}
+
+bool_t AABBTree::Validate() const
+{
+	if (NULL_NODE == mRoot)
+		return (0 == mProxyCount);
+
+	if (mNodes[mRoot].parent != NULL_NODE)
+		return false;
+
+	uint32_t leafCount = 0;
+
+	std::vector<uint32_t> stack;
+	stack.push_back(mRoot);
+
+	while (false == stack.empty())
+	{
+		const uint32_t nodeId = stack.back();
+		stack.pop_back();
+
+		const Node& node = mNodes[nodeId];
+		if (node.IsLeaf())
+		{
+			if ((node.child2 != NULL_NODE) || (node.height != 0))
+				return false;
+
+			leafCount++;
+			continue;
+		}
+
+		const Node& child1 = mNodes[node.child1];
+		const Node& child2 = mNodes[node.child2];
+
+		if ((child1.parent != nodeId) || (child2.parent != nodeId))
+			return false;
+
+		if (node.height != 1 + std::max(child1.height, child2.height))
+			return false;
+
+		// a pending refit is allowed to leave the bounds stale
+		if ((false == node.isDirty) && ((false == Contains(node.aabb, child1.aabb)) || (false == Contains(node.aabb, child2.aabb))))
+			return false;
+
+		stack.push_back(node.child1);
+		stack.push_back(node.child2);
+	}
+
+	return (leafCount == mProxyCount);
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef GRAPHICS_SCENE_GRAPH_AABB_TREE_HPP
+#define GRAPHICS_SCENE_GRAPH_AABB_TREE_HPP
+
+#include "Foundation/TypeDefines.hpp"
+#include "Foundation/NoCopyNoMoveClass.hpp"
+#include "glm/vec3.hpp"
+#include <vector>
+#include <functional>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Frustum;
+
+		/*
+			Dynamic AABB tree (BVH), for the spatial queries of the scene: culling, picking, proximity.
+			Each proxy is a leaf with a fat AABB - its bounds grown by a margin - so the small moves don't change the tree.
+
+			- insert: the sibling is found by a descent minimizing the surface area heuristic (SAH) cost of the new parent
+			  and of the enlarged ancestors
+			- remove: the parent of the leaf is removed, its sibling takes its place
+			- refit: the moved proxies are refitted all at once, bottom up, only the subtrees with moved proxies are visited
+			- after each change the ancestors are rotated: a child is swapped with a grandchild when it reduces the area
+			  (SAH cost) of the node below, this keeps the tree quality while the proxies move
+
+			The queries test the fat AABBs, they are conservative: the caller tests the exact bounds if needed.
+			NOTE! Not thread safe, the queries can run in parallel only while the tree doesn't change.
+			based on: Catto - Dynamic Bounding Volume Hierarchies (GDC 2019), Kopta et al. - Fast, Effective BVH Updates for Animated Scenes
+		*/
+		class AABBTree
+		{
+		public:
+			static const uint32_t NULL_NODE = static_cast<uint32_t>(-1);
+			static const float32_t DEFAULT_MARGIN;
+
+			struct AABB
+			{
+				glm::vec3 min;
+				glm::vec3 max;
+			};
+
+			// return false to stop the query
+			typedef std::function<bool_t(uint32_t proxyId)> QueryCallback;
+
+			explicit AABBTree(float32_t margin = DEFAULT_MARGIN);
+			~AABBTree();
+
+			void Clear();
+
+			// returns the proxy id
+			uint32_t CreateProxy(const glm::vec3& min, const glm::vec3& max, void* pUserData);
+			void DestroyProxy(uint32_t proxyId);
+
+			// moves a proxy now, it is reinserted if its bounds left its fat bounds
+			// returns true if the proxy was reinserted
+			bool_t MoveProxy(uint32_t proxyId, const glm::vec3& min, const glm::vec3& max);
+
+			// batch move: the fat bounds of the leaf are updated if needed, the tree is refitted by Refit()
+			// returns true if the fat bounds changed
+			bool_t SetProxyBounds(uint32_t proxyId, const glm::vec3& min, const glm::vec3& max);
+			void Refit();
+
+			void* GetUserData(uint32_t proxyId) const;
+			const AABBTree::AABB& GetFatAABB(uint32_t proxyId) const;
+
+			//// queries ////
+
+			void QueryFrustum(const Frustum& frustum, const AABBTree::QueryCallback& callback) const;
+			void QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& proxiesOut) const;
+
+			void QuerySphere(const glm::vec3& center, float32_t radius, const AABBTree::QueryCallback& callback) const;
+			void QuerySphere(const glm::vec3& center, float32_t radius, std::vector<uint32_t>& proxiesOut) const;
+
+			void QueryAABB(const glm::vec3& min, const glm::vec3& max, const AABBTree::QueryCallback& callback) const;
+			void QueryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& proxiesOut) const;
+
+			// the proxies hit by the segment origin + t * direction, t in [0, maxT], in no particular order
+			void RayCast(const glm::vec3& origin, const glm::vec3& direction, float32_t maxT, const AABBTree::QueryCallback& callback) const;
+			void RayCast(const glm::vec3& origin, const glm::vec3& direction, float32_t maxT, std::vector<uint32_t>& proxiesOut) const;
+
+			//// stats ////
+
+			uint32_t GetProxyCount() const;
+			uint32_t GetNodeCount() const;
+			// 0 for an empty tree or a single leaf
+			int32_t GetHeight() const;
+			// sum of the areas of the internal nodes / area of the root, lower is better
+			float32_t ComputeSAHCost() const;
+			// checks the links, the heights and that each node contains its children
+			bool_t Validate() const;
+
+		private:
+			NO_COPY_NO_MOVE_CLASS(AABBTree)
+
+			struct Node
+			{
+				AABB aabb;
+				void* pUserData;
+
+				uint32_t parent; // next free node, if free
+				uint32_t child1;
+				uint32_t child2;
+
+				int32_t height; // 0 for the leaves, -1 if free
+				bool_t isDirty; // has moved leaves below, see Refit()
+
+				bool_t IsLeaf() const { return (NULL_NODE == child1); }
+			};
+
+			uint32_t AllocateNode();
+			void FreeNode(uint32_t nodeId);
+
+			void InsertLeaf(uint32_t leaf);
+			void RemoveLeaf(uint32_t leaf);
+
+			// recomputes the bounds and the height of the ancestors, with rotations
+			void RefitAncestors(uint32_t nodeId);
+			void Rotate(uint32_t nodeId);
+
+			void SetFatAABB(uint32_t leaf, const glm::vec3& min, const glm::vec3& max);
+
+			// the node test returns false to skip the subtree, the leaf visitor returns false to stop the query
+			template <typename NodeTest, typename LeafVisitor>
+			void Query(const NodeTest& test, LeafVisitor& visitor) const;
+
+			float32_t mMargin;
+
+			std::vector<Node> mNodes;
+			uint32_t mRoot;
+			uint32_t mFreeList;
+			uint32_t mProxyCount;
+		};
+	}
+}
+
+#endif // GRAPHICS_SCENE_GRAPH_AABB_TREE_HPP
\ No newline at end of file
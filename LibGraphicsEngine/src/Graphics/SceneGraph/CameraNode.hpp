@@ -15,6 +15,7 @@ namespace GraphicsEngine
 		class CameraNode : public Node
 		{
 			GE_RTTI(GraphicsEngine::Graphics::CameraNode)
+			GE_POOLED_OBJECT(CameraNode)
 
 		public:
 			CameraNode();
@@ -13,7 +13,10 @@ using namespace GraphicsEngine::Graphics;
 GeometryNode::GeometryNode()
 	: Node()
 	, mpGeometry(nullptr)
+	, mpOccluderGeometry(nullptr)
 	, mIsLit(false)
+	, mIsOccluder(false)
+	, mIsStatic(false)
 {
 	Create();
 }
@@ -21,7 +24,10 @@ GeometryNode::GeometryNode()
 GeometryNode::GeometryNode(const std::string& name)
 	: Node(name)
 	, mpGeometry(nullptr)
+	, mpOccluderGeometry(nullptr)
 	, mIsLit(false)
+	, mIsOccluder(false)
+	, mIsStatic(false)
 {
 	Create();
 }
@@ -40,6 +46,15 @@ void GeometryNode::Create()
 void GeometryNode::Destroy()
 {
 	//TODO - improve cleanup
+	if (mpOccluderGeometry)
+	{
+		if (mpOccluderGeometry != mpGeometry)
+		{
+			GE_FREE(mpOccluderGeometry);
+		}
+		mpOccluderGeometry = nullptr;
+	}
+
 	if (mpGeometry)
 	{
 		if (mpGeometry->IsModel())
@@ -77,6 +92,36 @@ void GeometryNode::SetIsLit(bool_t value)
 	mIsLit = value;
 }
 
+bool_t GeometryNode::IsOccluder() const
+{
+	return mIsOccluder;
+}
+
+void GeometryNode::SetIsOccluder(bool_t value)
+{
+	mIsOccluder = value;
+}
+
+GeometricPrimitive* GeometryNode::GetOccluderGeometry() const
+{
+	return mpOccluderGeometry ? mpOccluderGeometry : mpGeometry;
+}
+
+void GeometryNode::SetOccluderGeometry(GeometricPrimitive* pGeometry)
+{
+	mpOccluderGeometry = pGeometry;
+}
+
+bool_t GeometryNode::IsStatic() const
+{
+	return mIsStatic;
+}
+
+void GeometryNode::SetIsStatic(bool_t value)
+{
+	mIsStatic = value;
+}
+
 void GeometryNode::Accept(NodeVisitor& visitor)
 {
 	visitor.Visit(this);
@@ -17,6 +17,7 @@ namespace GraphicsEngine
 		class GeometryNode : public Node
 		{
 			GE_RTTI(GraphicsEngine::Graphics::GeometryNode)
+			GE_POOLED_OBJECT(GeometryNode)
 
 		public:
 			GeometryNode();
@@ -29,6 +30,19 @@ namespace GraphicsEngine
 			bool_t IsLit() const;
 			void SetIsLit(bool_t value);
 
+			// big nodes hiding the others (walls, floors), drawn in the occlusion buffer, see OcclusionBuffer
+			bool_t IsOccluder() const;
+			void SetIsOccluder(bool_t value);
+
+			// simplified geometry drawn in the occlusion buffer, the node geometry is used if not set
+			// NOTE! Owned by the node, a triangle list in the same space as the node geometry
+			GeometricPrimitive* GetOccluderGeometry() const;
+			void SetOccluderGeometry(GeometricPrimitive* pPrimitive);
+
+			// nodes which rarely move, their shadows are cached, see ShadowCache
+			bool_t IsStatic() const;
+			void SetIsStatic(bool_t value);
+
 			///////// Visitor Pattern ///////
 			virtual void Accept(NodeVisitor& visitor) override;
 
@@ -37,8 +51,11 @@ namespace GraphicsEngine
 			void Destroy();
 
 			GeometricPrimitive* mpGeometry;
+			GeometricPrimitive* mpOccluderGeometry;
 
 			bool_t mIsLit;
+			bool_t mIsOccluder;
+			bool_t mIsStatic;
 		};
 	}
 }
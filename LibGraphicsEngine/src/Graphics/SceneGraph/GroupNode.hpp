@@ -11,6 +11,7 @@ namespace GraphicsEngine
 		class GroupNode : public Node
 		{
 			GE_RTTI(GraphicsEngine::Graphics::GroupNode)
+			GE_POOLED_OBJECT(GroupNode)
 
 		public:
 			GroupNode();
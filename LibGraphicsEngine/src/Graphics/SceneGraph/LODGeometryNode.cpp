@@ -0,0 +1,283 @@
+#include "Graphics/SceneGraph/LODGeometryNode.hpp"
+#include "Graphics/GeometricPrimitives/GeometricPrimitive.hpp"
+#include "Graphics/Rendering/Resources/VertexFormat.hpp"
+#include "Graphics/Rendering/Resources/VertexBuffer.hpp"
+#include "Graphics/Rendering/Resources/IndexBuffer.hpp"
+#include "Graphics/Rendering/Resources/Model.hpp"
+#include "Graphics/Cameras/Camera.hpp"
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "glm/common.hpp" // glm::min(), glm::max()
+#include "glm/geometric.hpp" // glm::length()
+#include <limits>
+#include <cassert>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+LODGeometryNode::LODGeometryNode()
+	: GeometryNode()
+	, mLevel(0)
+	, mMaxScreenError(1.0f)
+	, mHysteresis(0.25f)
+	, mBoundsCenter(0.0f)
+	, mBoundsRadius(0.0f)
+	, mHasBounds(false)
+{}
+
+LODGeometryNode::LODGeometryNode(const std::string& name)
+	: GeometryNode(name)
+	, mLevel(0)
+	, mMaxScreenError(1.0f)
+	, mHysteresis(0.25f)
+	, mBoundsCenter(0.0f)
+	, mBoundsRadius(0.0f)
+	, mHasBounds(false)
+{}
+
+LODGeometryNode::~LODGeometryNode()
+{
+	// the level 0 is freed by the GeometryNode
+	if (false == mLevels.empty())
+	{
+		SetLevel(0);
+
+		for (size_t i = 1; i < mLevels.size(); ++i)
+		{
+			if (mLevels[i].pGeometry)
+			{
+				GE_FREE(mLevels[i].pGeometry);
+			}
+		}
+		mLevels.clear();
+	}
+}
+
+void LODGeometryNode::InitLevels()
+{
+	if (false == mLevels.empty())
+		return;
+
+	auto* pGeometry = GetGeometry();
+	assert(pGeometry != nullptr);
+
+	if (pGeometry->IsModel())
+	{
+		Model* pModel = dynamic_cast<Model*>(pGeometry);
+		assert(pModel != nullptr);
+
+		// the levels are drawn by the model, see Model::SetLODLevel()
+		for (uint32_t i = 0; i < pModel->GetLODLevelCount(); ++i)
+		{
+			Level level;
+			level.pGeometry = nullptr;
+			level.error = pModel->GetLODError(i);
+			level.indexCount = pModel->GetLODIndexCount(i);
+
+			mLevels.push_back(level);
+		}
+		mLevels[0].pGeometry = pGeometry;
+	}
+	else
+	{
+		Level level;
+		level.pGeometry = pGeometry;
+		level.error = 0.0f;
+		level.indexCount = pGeometry->IsIndexed() ? pGeometry->GetIndexBuffer()->GetIndexCount() : pGeometry->GetVertexBuffer()->GetVertexCount();
+
+		mLevels.push_back(level);
+	}
+}
+
+void LODGeometryNode::ComputeBounds()
+{
+	mHasBounds = true;
+	mBoundsCenter = glm::vec3(0.0f);
+	mBoundsRadius = 0.0f;
+
+	// the level 0 positions, the nodes without float positions use their origin
+	auto* pVertexBuffer = mLevels[0].pGeometry->GetVertexBuffer();
+	if ((nullptr == pVertexBuffer) || (nullptr == pVertexBuffer->GetData()) || (0 == pVertexBuffer->GetVertexCount()))
+		return;
+
+	auto* pFormat = pVertexBuffer->GetFormat();
+	assert(pFormat != nullptr);
+	if ((false == pFormat->HasVertexAttribute(VertexFormat::VertexAttribute::GE_VA_POSITION)) ||
+		(pFormat->GetVertexAttributeType(VertexFormat::VertexAttribute::GE_VA_POSITION) != VertexFormat::AttributeType::GE_AT_FLOAT32))
+		return;
+
+	const uint32_t stride = pFormat->GetVertexTotalStride();
+	const uint32_t offset = pFormat->GetVertexAttributeOffset(VertexFormat::VertexAttribute::GE_VA_POSITION);
+	const uint8_t* pData = static_cast<const uint8_t*>(pVertexBuffer->GetData());
+
+	glm::vec3 min(std::numeric_limits<float32_t>::max()), max(-std::numeric_limits<float32_t>::max());
+	for (uint32_t i = 0; i < pVertexBuffer->GetVertexCount(); ++i)
+	{
+		const float32_t* pPosition = reinterpret_cast<const float32_t*>(pData + i * stride + offset);
+		const glm::vec3 position(pPosition[0], pPosition[1], pPosition[2]);
+
+		min = glm::min(min, position);
+		max = glm::max(max, position);
+	}
+
+	mBoundsCenter = (min + max) * 0.5f;
+	for (uint32_t i = 0; i < pVertexBuffer->GetVertexCount(); ++i)
+	{
+		const float32_t* pPosition = reinterpret_cast<const float32_t*>(pData + i * stride + offset);
+
+		mBoundsRadius = glm::max(mBoundsRadius, glm::length(glm::vec3(pPosition[0], pPosition[1], pPosition[2]) - mBoundsCenter));
+	}
+}
+
+void LODGeometryNode::AddLevel(GeometricPrimitive* pGeometry, float32_t error)
+{
+	assert(pGeometry != nullptr);
+	assert(GetGeometry() != nullptr);
+	assert(false == GetGeometry()->IsModel());
+
+	InitLevels();
+	assert(error >= mLevels.back().error);
+
+	Level level;
+	level.pGeometry = pGeometry;
+	level.error = error;
+	level.indexCount = pGeometry->IsIndexed() ? pGeometry->GetIndexBuffer()->GetIndexCount() : pGeometry->GetVertexBuffer()->GetVertexCount();
+
+	mLevels.push_back(level);
+}
+
+uint32_t LODGeometryNode::GetLevelCount()
+{
+	InitLevels();
+
+	return static_cast<uint32_t>(mLevels.size());
+}
+
+float32_t LODGeometryNode::GetLevelError(uint32_t level)
+{
+	InitLevels();
+	assert(level < mLevels.size());
+
+	return mLevels[level].error;
+}
+
+uint32_t LODGeometryNode::GetLevelIndexCount(uint32_t level)
+{
+	InitLevels();
+	assert(level < mLevels.size());
+
+	return mLevels[level].indexCount;
+}
+
+GeometricPrimitive* LODGeometryNode::GetLevelGeometry(uint32_t level)
+{
+	InitLevels();
+	assert(level < mLevels.size());
+
+	return mLevels[level].pGeometry ? mLevels[level].pGeometry : mLevels[0].pGeometry;
+}
+
+uint32_t LODGeometryNode::GetLevel() const
+{
+	return mLevel;
+}
+
+void LODGeometryNode::SetLevel(uint32_t level)
+{
+	InitLevels();
+	assert(level < mLevels.size());
+
+	if (mLevels[0].pGeometry->IsModel())
+	{
+		dynamic_cast<Model*>(mLevels[0].pGeometry)->SetLODLevel(level);
+	}
+	else
+	{
+		SetGeometry(mLevels[level].pGeometry);
+	}
+
+	mLevel = level;
+}
+
+float32_t LODGeometryNode::GetMaxScreenError() const
+{
+	return mMaxScreenError;
+}
+
+void LODGeometryNode::SetMaxScreenError(float32_t pixels)
+{
+	assert(pixels >= 0.0f);
+
+	mMaxScreenError = pixels;
+}
+
+float32_t LODGeometryNode::GetHysteresis() const
+{
+	return mHysteresis;
+}
+
+void LODGeometryNode::SetHysteresis(float32_t value)
+{
+	assert((value >= 0.0f) && (value < 1.0f));
+
+	mHysteresis = value;
+}
+
+bool_t LODGeometryNode::SelectLevel(const Camera* pCamera, uint32_t viewportHeight)
+{
+	assert(pCamera != nullptr);
+
+	InitLevels();
+	if (mLevels.size() < 2)
+		return false;
+
+	if (false == mHasBounds)
+	{
+		ComputeBounds();
+	}
+
+	// the errors scale with the largest axis of the model matrix
+	const glm::mat4& modelMatrix = GetModelMatrix();
+	const float32_t scale = glm::max(glm::length(glm::vec3(modelMatrix[0])), glm::max(glm::length(glm::vec3(modelMatrix[1])), glm::length(glm::vec3(modelMatrix[2]))));
+
+	// pixels per world unit at the nearest point of the bounding sphere, projection[1][1] = 1 / tan(fovy / 2)
+	const glm::mat4& projection = pCamera->GetProjectionMatrix();
+	float32_t pixelsPerUnit = glm::abs(projection[1][1]) * 0.5f * viewportHeight;
+	if (projection[3][3] == 0.0f)
+	{
+		const glm::vec3 center(modelMatrix * glm::vec4(mBoundsCenter, 1.0f));
+		const float32_t distance = glm::max(glm::length(center - pCamera->GetPosition()) - mBoundsRadius * scale, pCamera->GetZNear());
+
+		pixelsPerUnit /= distance;
+	}
+
+	const float32_t errorToPixels = scale * pixelsPerUnit;
+
+	// the errors grow with the level
+	uint32_t level = 0, stableLevel = 0;
+	for (uint32_t i = 1; i < mLevels.size(); ++i)
+	{
+		const float32_t screenError = mLevels[i].error * errorToPixels;
+
+		if (screenError <= mMaxScreenError)
+		{
+			level = i;
+		}
+		if (screenError <= mMaxScreenError * (1.0f - mHysteresis))
+		{
+			stableLevel = i;
+		}
+	}
+
+	// finer levels are selected right away, the coarser ones only when well below the max error
+	if (level > mLevel)
+	{
+		level = glm::max(mLevel, stableLevel);
+	}
+
+	if (level == mLevel)
+		return false;
+
+	SetLevel(level);
+
+	return true;
+}
\ No newline at end of file
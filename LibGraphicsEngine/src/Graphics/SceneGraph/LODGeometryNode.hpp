@@ -0,0 +1,81 @@
+#ifndef GRAPHICS_SCENE_GRAPH_LOD_GEOMETRY_NODE_HPP
+#define GRAPHICS_SCENE_GRAPH_LOD_GEOMETRY_NODE_HPP
+
+#include "Graphics/SceneGraph/GeometryNode.hpp"
+#include "glm/vec3.hpp"
+#include <vector>
+
+namespace GraphicsEngine
+{
+	namespace Graphics
+	{
+		class Camera;
+
+		/* Geometry node with discrete levels of detail.
+		   Level 0 is the node geometry, the other levels are simplified versions of it (see MeshSimplifier),
+		   each with its max distance to the level 0 surface (model units).
+		   A model loaded with GE_LF_LODS brings its own levels, see glTF2Loader::SetLODLevel().
+		   Each frame the coarsest level whose error projected on the screen is below the max screen error is selected.
+		   A coarser level must be below the error reduced by the hysteresis, so the nodes around a switch distance don't pop. */
+		class LODGeometryNode : public GeometryNode
+		{
+			GE_RTTI(GraphicsEngine::Graphics::LODGeometryNode)
+			GE_POOLED_OBJECT(LODGeometryNode)
+
+		public:
+			LODGeometryNode();
+			explicit LODGeometryNode(const std::string& name);
+			virtual ~LODGeometryNode();
+
+			// the error of a level must not be below the one of the previous level
+			// NOTE! Owned by the node, the node geometry must be set first, shares its vertex buffer
+			void AddLevel(GeometricPrimitive* pGeometry, float32_t error);
+
+			uint32_t GetLevelCount();
+			float32_t GetLevelError(uint32_t level);
+			// indices drawn at the level, the vertices if not indexed
+			uint32_t GetLevelIndexCount(uint32_t level);
+			GeometricPrimitive* GetLevelGeometry(uint32_t level);
+
+			uint32_t GetLevel() const;
+			// the node geometry becomes the one of the level
+			void SetLevel(uint32_t level);
+
+			// in pixels, 1 by default
+			float32_t GetMaxScreenError() const;
+			void SetMaxScreenError(float32_t pixels);
+
+			// fraction of the max screen error, 0.25 by default
+			float32_t GetHysteresis() const;
+			void SetHysteresis(float32_t value);
+
+			// selects the level for the camera, the viewport height is in pixels
+			// returns true if the level has changed, e.g. the command buffers recorded upfront must be recorded again
+			bool_t SelectLevel(const Camera* pCamera, uint32_t viewportHeight);
+
+		private:
+			struct Level
+			{
+				GeometricPrimitive* pGeometry;
+				float32_t error;
+				uint32_t indexCount;
+			};
+
+			void InitLevels();
+			void ComputeBounds();
+
+			std::vector<Level> mLevels;
+			uint32_t mLevel;
+
+			float32_t mMaxScreenError;
+			float32_t mHysteresis;
+
+			// bounding sphere of the level 0, in model space
+			glm::vec3 mBoundsCenter;
+			float32_t mBoundsRadius;
+			bool_t mHasBounds;
+		};
+	}
+}
+
+#endif // GRAPHICS_SCENE_GRAPH_LOD_GEOMETRY_NODE_HPP
\ No newline at end of file
@@ -12,6 +12,7 @@ namespace GraphicsEngine
 		class LightNode : public Node
 		{
 			GE_RTTI(GraphicsEngine::Graphics::LightNode)
+			GE_POOLED_OBJECT(LightNode)
 
 		public:
 			LightNode();
@@ -3,15 +3,19 @@
 #include "Graphics/Components/NodeComponent.hpp"
 #include "Foundation/MemoryManagement/MemoryOperations.hpp"
 #include "glm/matrix.hpp"
+#include <algorithm> // std::find()
 #include <cassert>
 
 using namespace GraphicsEngine;
 using namespace GraphicsEngine::Graphics;
 
+std::vector<Node*> Node::msTransformChangedNodes;
+
 Node::Node()
 	: mName()
 	, mpParent(nullptr)
 	, mIsEnabled(false)
+	, mIsTransformChanged(false)
 	, mModelMatrix(glm::mat4(1.0f)) //identity matrix
 	, mNormalMatrix(glm::mat3(1.0f))
 {
@@ -22,6 +26,7 @@ Node::Node(const std::string& name)
 	: mName(name)
 	, mpParent(nullptr)
 	, mIsEnabled(false)
+	, mIsTransformChanged(false)
 	, mModelMatrix(glm::mat4(1.0f)) //identity matrix
 	, mNormalMatrix(glm::mat3(1.0f))
 {
@@ -45,6 +50,16 @@ void Node::Destroy()
 	mName = "";
 	mIsEnabled = false;
 
+	if (mIsTransformChanged)
+	{
+		auto it = std::find(msTransformChangedNodes.begin(), msTransformChangedNodes.end(), this);
+		if (it != msTransformChangedNodes.end())
+		{
+			msTransformChangedNodes.erase(it);
+		}
+		mIsTransformChanged = false;
+	}
+
 	if (mpParent)
 	{
 		mpParent = nullptr;
@@ -245,6 +260,12 @@ void Node::SetModelMatrix(const glm::mat4& transform)
 	// every time we set the model matrix we also compute the normal matrix as it depends on the model one!
 	// NOTE! Normal matrix will bring the normals in World Space
 	ComputeNormalMatrix();
+
+	if (false == mIsTransformChanged)
+	{
+		mIsTransformChanged = true;
+		msTransformChangedNodes.push_back(this);
+	}
 }
 
 const glm::mat4& Node::GetNormalMatrix() const
@@ -260,6 +281,25 @@ void Node::ComputeNormalMatrix()
 	}
 }
 
+bool_t Node::IsTransformChanged() const
+{
+	return mIsTransformChanged;
+}
+
+const std::vector<Node*>& Node::GetTransformChangedNodes()
+{
+	return msTransformChangedNodes;
+}
+
+void Node::ClearTransformChanges()
+{
+	for (auto* pNode : msTransformChangedNodes)
+	{
+		pNode->mIsTransformChanged = false;
+	}
+	msTransformChangedNodes.clear();
+}
+
 void Node::Traverse(NodeVisitor& visitor)
 {
 	visitor.Traverse(this);
@@ -2,6 +2,7 @@
 #define GRAPHICS_SCENE_GRAPH_NODE_HPP
 
 #include "Foundation/Object.hpp"
+#include "Foundation/MemoryManagement/ObjectPool.hpp"
 #include "Graphics/SceneGraph/Visitors/NodeVisitor.hpp"
 //#include "Graphics/Rendering/ScenePasses/ScenePass.hpp"
 #include "Graphics/Rendering/VisualPasses/VisualPass.hpp"
@@ -29,6 +30,7 @@ namespace GraphicsEngine
 		class Node: public Object
 		{
 			GE_RTTI(GraphicsEngine::Graphics::Node)
+			GE_POOLED_OBJECT(Node)
 
 		public:
 			Node();
@@ -81,6 +83,13 @@ namespace GraphicsEngine
 			const glm::mat4& GetNormalMatrix() const;
 			void ComputeNormalMatrix();
 
+			// true if the model matrix was set since the last ClearTransformChanges()
+			bool_t IsTransformChanged() const;
+			// the nodes whose model matrix was set, in no particular order, e.g. the renderer refits only their bounds
+			// NOTE! Cleared by the renderer each frame, see Renderer::UpdateSceneCulling()
+			static const std::vector<Node*>& GetTransformChangedNodes();
+			static void ClearTransformChanges();
+
 			///////// Visitor Pattern ///////
 			virtual void Traverse(NodeVisitor& visitor);
 			virtual void Accept(NodeVisitor& visitor);
@@ -96,12 +105,15 @@ namespace GraphicsEngine
 			std::string mName;
 			Node* mpParent;
 			bool_t mIsEnabled;
+			bool_t mIsTransformChanged;
 
 			std::unordered_map<std::string, NodeComponent*, std::hash<std::string>> mComponentMap;
 
 			//TODO - to improve when we add our own Math lib
 			glm::mat4 mModelMatrix; //local -> world transform of the position per vertex
 			glm::mat4 mNormalMatrix; //local -> world transform of the normal per vertex
+
+			static std::vector<Node*> msTransformChangedNodes;
 		};
 	}
 }
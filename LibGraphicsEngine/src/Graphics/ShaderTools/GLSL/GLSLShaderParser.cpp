@@ -2,6 +2,7 @@
 #include "Graphics/ShaderTools/GLSL/GLSLShaderTypes.hpp"
 #include "Foundation/FileUtils.hpp"
 #include "Foundation/Logger.hpp"
+#include <algorithm> // std::remove(), std::sort()
 
 using namespace GraphicsEngine;
 using namespace GraphicsEngine::Graphics;
@@ -25,11 +26,14 @@ constexpr const char_t* LOCATION_NAME = "location";
 constexpr const char_t* SET_NAME = "set";
 constexpr const char_t* BINDING_NAME = "binding";
 constexpr const char_t* VERSION_NAME = "#version";
+constexpr const char_t* INCLUDE_NAME = "#include";
+constexpr const char_t* BUFFER_NAME = "buffer";
 
 // data storage layout
 constexpr const char_t* STORAGE_SHARED_NAME = "shared"; //default storage in GLSL
 constexpr const char_t* STORAGE_PACKED_NAME = "packed";
 constexpr const char_t* STORAGE_STD140_NAME = "std140";
+constexpr const char_t* STORAGE_STD430_NAME = "std430";
 
 // chars to remove
 constexpr const char_t LAYOUT_START_NAME = '(';
@@ -62,6 +66,8 @@ constexpr const char_t* IMAGE_NAME = "image";
 constexpr const char_t* SINGLE_COMMENT_NAME = "//";
 
 constexpr const char_t DELIMITER_EXTENSION_NAME = '.';
+constexpr const char_t* DELIMITER_PATH_NAME = "/\\";
+constexpr const char_t DELIMITER_INCLUDE_NAME = '"';
 constexpr const char_t* DELIMITER_LINE_NAME = "\r\n";
 constexpr const char_t DELIMITER_TOKEN_NAME = ' ';
 constexpr const char_t DELIMITER_EXP_NAME = ';';
@@ -90,6 +96,7 @@ GLSLShaderParser::~GLSLShaderParser()
 	mVersion = {};
 
 	mUniformBlock = {};
+	mStorageBlocks.clear();
 
 	mInputMap.clear();
 	mVertexAttributeMap.clear();
@@ -118,6 +125,12 @@ bool_t GLSLShaderParser::Parse(const std::string& shaderSourcePath)
 		return false;
 	}
 
+	if (ResolveIncludes(shaderSourcePath, shaderSourceCode) == false)
+	{
+		LOG_ERROR("Error in shader: %s", shaderSourcePath.c_str());
+		return false;
+	}
+
 	// NOTE! First we extract the shader glsl version
 	// then we pasrse by the 'layout' keyword instead of new line to get the layout info
 	// this approach helps us we can have uniform blocks defined on multiple lines
@@ -173,6 +186,49 @@ bool_t GLSLShaderParser::ParseExtension(const std::string& shaderSourcePath)
 	return true;
 }
 
+bool_t GLSLShaderParser::ResolveIncludes(const std::string& shaderSourcePath, std::string& shaderCodeInOut)
+{
+	const size_t pathIter = shaderSourcePath.find_last_of(DELIMITER_PATH_NAME);
+	const std::string shaderDir = ((pathIter != std::string::npos) ? shaderSourcePath.substr(0, pathIter + 1) : std::string());
+
+	// the included files may include other files, they are resolved in place
+	size_t includeIter = 0;
+	while (true)
+	{
+		includeIter = shaderCodeInOut.find(INCLUDE_NAME, includeIter);
+		if (includeIter == std::string::npos)
+			break;
+
+		size_t lineEndIter = shaderCodeInOut.find(DELIMITER_LINE_NAME, includeIter);
+		if (lineEndIter == std::string::npos)
+		{
+			lineEndIter = shaderCodeInOut.size();
+		}
+
+		size_t nameStartIter = shaderCodeInOut.find(DELIMITER_INCLUDE_NAME, includeIter);
+		size_t nameEndIter = ((nameStartIter < lineEndIter) ? shaderCodeInOut.find(DELIMITER_INCLUDE_NAME, nameStartIter + 1) : std::string::npos);
+		if ((nameEndIter == std::string::npos) || (nameEndIter > lineEndIter))
+		{
+			LOG_ERROR("Invalid #include, the file name is expected in quotes!");
+			return false;
+		}
+
+		const std::string includePath = shaderDir + shaderCodeInOut.substr(nameStartIter + 1, nameEndIter - nameStartIter - 1);
+
+		std::string includeCode;
+		FileUtils::ReadTextFile(includePath, includeCode);
+		if (includeCode.empty())
+		{
+			LOG_ERROR("Failed to read the included file: %s", includePath.c_str());
+			return false;
+		}
+
+		shaderCodeInOut.replace(includeIter, lineEndIter - includeIter, includeCode);
+	}
+
+	return true;
+}
+
 bool_t GLSLShaderParser::ParseSource(const std::string& shaderCode)
 {
 	if (shaderCode.empty())
@@ -338,7 +394,8 @@ bool_t GLSLShaderParser::ParseLayoutInfo(const std::string& crrLayoutInfo)
 
 	if ((qualifierName_1 == STORAGE_SHARED_NAME) ||
 		(qualifierName_1 == STORAGE_PACKED_NAME) ||
-		(qualifierName_1 == STORAGE_STD140_NAME))
+		(qualifierName_1 == STORAGE_STD140_NAME) ||
+		(qualifierName_1 == STORAGE_STD430_NAME))
 	{
 		dataStorageLayout = qualifierName_1;
 
@@ -383,6 +440,32 @@ bool_t GLSLShaderParser::ParseLayoutInfo(const std::string& crrLayoutInfo)
 	if (varType.empty())
 		return false;
 
+	// Storage Buffer - the memory qualifier is optional: [readonly] buffer BlockName { ... } instanceName;
+	if ((varDefinition == BUFFER_NAME || varType == BUFFER_NAME) &&
+		qualifierName_1 == SET_NAME && qualifierName_2 == BINDING_NAME)
+	{
+		std::string blockName = varType;
+		if (varType == BUFFER_NAME)
+		{
+			nextTokenIter = layoutInfo.find_first_of(DELIMITER_UBO_START_NAME, crrTokenIter);
+			blockName = layoutInfo.substr(crrTokenIter, nextTokenIter - crrTokenIter);
+		}
+
+		blockName = blockName.substr(0, blockName.find(DELIMITER_UBO_START_NAME));
+		blockName.erase(std::remove(blockName.begin(), blockName.end(), DELIMITER_TOKEN_NAME), blockName.end());
+		if (blockName.empty())
+			return false;
+
+		StorageBlock storageBlock{};
+		storageBlock.name = blockName;
+		storageBlock.setId = StrToInt(qualifierValue_1);
+		storageBlock.binding = StrToInt(qualifierValue_2);
+
+		mStorageBlocks.push_back(storageBlock);
+
+		return true;
+	}
+
 	// Uniform Buffer
 	if (varType == UBO_NAME && 
 		qualifierName_1 == SET_NAME && qualifierName_2 == BINDING_NAME && varDefinition == UNIFORM_NAME)
@@ -606,7 +689,31 @@ const GLSLShaderParser::UniformMap& GLSLShaderParser::GetUniforms() const
 	return mUniformMap;
 }
 
+std::vector<GLSLShaderParser::UniformMap::const_iterator> GLSLShaderParser::GetUniformsByBinding() const
+{
+	std::vector<UniformMap::const_iterator> uniforms;
+	uniforms.reserve(mUniformMap.size());
+
+	for (auto it = mUniformMap.begin(); it != mUniformMap.end(); ++it)
+	{
+		uniforms.push_back(it);
+	}
+
+	std::sort(uniforms.begin(), uniforms.end(),
+		[](const UniformMap::const_iterator& a, const UniformMap::const_iterator& b)
+		{
+			return (a->second.setId < b->second.setId) || ((a->second.setId == b->second.setId) && (a->second.binding < b->second.binding));
+		});
+
+	return uniforms;
+}
+
 const GLSLShaderParser::UniformBlock& GLSLShaderParser::GetUniformBlock() const
 {
 	return mUniformBlock;
+}
+
+const std::vector<GLSLShaderParser::StorageBlock>& GLSLShaderParser::GetStorageBlocks() const
+{
+	return mStorageBlocks;
 }
\ No newline at end of file
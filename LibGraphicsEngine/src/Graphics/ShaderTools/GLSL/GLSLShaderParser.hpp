@@ -14,7 +14,8 @@ namespace GraphicsEngine
 	namespace Graphics
 	{
 		/*
-			A simple GLSL shader parser, for now limited to only retrieve input, outputs, uniform and uniform block info per shader.
+			A simple GLSL shader parser, for now limited to only retrieve input, outputs, uniform, uniform block and storage block info per shader.
+			The #include "file" lines are resolved relative to the shader, as glslc does with GL_GOOGLE_include_directive.
 		*/
 		class GLSLShaderParser: public Object
 		{
@@ -96,6 +97,20 @@ namespace GraphicsEngine
 				}
 			};
 
+			// std430 buffer block, the data is owned by the renderer, see VulkanRenderer::GetStorageBuffer()
+			struct StorageBlock
+			{
+				std::string name; // block name, not the instance name
+				uint32_t setId;
+				int32_t binding;
+
+				bool_t IsValid() const
+				{
+					bool_t res = (name.empty() != true) && (setId != -1) && (binding != -1);
+					return res;
+				}
+			};
+
 			typedef std::unordered_map<std::string, Input> InputMap;
 			typedef std::unordered_map<std::string, Output> OutputMap;
 			typedef std::unordered_map<std::string, Uniform> UniformMap;
@@ -115,12 +130,16 @@ namespace GraphicsEngine
 			const GLSLShaderParser::VertexAttributeMap& GetVertexAttributes() const;
 			const GLSLShaderParser::OutputMap& GetOutputs() const;
 			const GLSLShaderParser::UniformMap& GetUniforms() const;
+			// the uniforms sorted by set and binding, the order in which the textures are added to the passes
+			std::vector<GLSLShaderParser::UniformMap::const_iterator> GetUniformsByBinding() const;
 			const GLSLShaderParser::UniformBlock& GetUniformBlock() const;
+			const std::vector<GLSLShaderParser::StorageBlock>& GetStorageBlocks() const;
 
 		private:
 			NO_COPY_NO_MOVE_CLASS(GLSLShaderParser)
 
 			bool_t ParseExtension(const std::string& shaderSourcePath);
+			bool_t ResolveIncludes(const std::string& shaderSourcePath, std::string& shaderCodeInOut);
 			bool_t ParseSource(const std::string& shaderCode);
 			bool_t ParseLayoutInfo(const std::string& crrLayoutInfo);
 			bool_t ParseUboData(const std::string& crrUboData);
@@ -138,6 +157,7 @@ namespace GraphicsEngine
 			UniformMap mUniformMap;
 
 			UniformBlock mUniformBlock; // NOTE! For nwo we consider to have only one UBO per shader
+			std::vector<StorageBlock> mStorageBlocks;
 		};
 	}
 }
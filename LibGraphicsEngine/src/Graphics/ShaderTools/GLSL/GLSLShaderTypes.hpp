@@ -32,14 +32,26 @@ namespace GraphicsEngine
 				constexpr const char_t* VERTEX_COLOR = "a_color";
 				constexpr const char_t* VERTEX_TEX_COORDS = "a_uv";
 
+				// specialization constants (constant_id)
+				constexpr uint32_t CONSTANT_ID_OCTAHEDRAL_NORMALS = 0; // bool, the vertex shader decodes the octahedral normals
+				constexpr uint32_t CONSTANT_ID_CLUSTERED_LIGHTING = 1; // bool, the fragment shader adds the lights of its cluster
+
+				// storage blocks, by block name - the light clusters, see LightClusterGrid
+				constexpr const char_t* STORAGE_CLUSTER_LIGHTS = "ClusterLights";
+				constexpr const char_t* STORAGE_CLUSTERS = "Clusters";
+				constexpr const char_t* STORAGE_CLUSTER_LIGHT_INDICES = "ClusterLightIndices";
+
 				// UBO
 				constexpr const char_t* UBO = "uUBO";
 
 				// Uniforms
 				constexpr const char_t* UNIFORM_PVM_MATRIX = "PVM"; // no 'u' in front of the name as it is part of UBO
 				constexpr const char_t* UNIFORM_LIGHT_PVM_MATRIX = "LightPVM"; // no 'u' in front of the name as it is part of UBO
+				// one matrix per shadow cascade, see ShadowCascades - no 'u' in front of the names as they are part of UBO
+				constexpr const char_t* UNIFORM_CASCADE_PV_MATRIX[] = { "CascadePV0", "CascadePV1", "CascadePV2", "CascadePV3" };
 				constexpr const char_t* UNIFORM_MODEL_MATRIX = "Model"; // no 'u' in front of the name as it is part of UBO
 				constexpr const char_t* UNIFORM_NORMAL_MATRIX = "Normal"; // no 'u' in front of the name as it is part of UBO
+				constexpr const char_t* UNIFORM_INVERSE_PV_MATRIX = "InvPV"; // no 'u' in front of the name as it is part of UBO
 				constexpr const char_t* UNIFORM_CAMERA_POS = "cameraPos"; // no 'u' in front of the name as it is part of UBO
 				constexpr const char_t* UNIFORM_COLOR = "color"; // no 'u' in front of the name as it is part of UBO
 				constexpr const char_t* UNIFORM_ROUGHNESS = "roughness"; // no 'u' in front of the name as it is part of UBO
@@ -47,10 +59,14 @@ namespace GraphicsEngine
 				constexpr const char_t* UNIFORM_LIGHT_POS = "lightPos"; // no 'u' in front of the name as it is part of UBO
 				constexpr const char_t* UNIFORM_LIGHT_COLOR = "lightColor"; // no 'u' in front of the name as it is part of UBO
 				constexpr const char_t* UNIFORM_IS_GL_NDK = "isGLNDK"; // no 'u' in front of the name as it is part of UBO
+				constexpr const char_t* UNIFORM_CASCADE_SPLITS = "cascadeSplits"; // no 'u' in front of the name as it is part of UBO
 
 				constexpr const char_t* UNIFORM_2D_TEXTURE = "u2DTexture";
 				constexpr const char_t* UNIFORM_2D_COLOR_TEXTURE = "u2DColorTexture";
 				constexpr const char_t* UNIFORM_2D_NORMAL_TEXTURE = "u2DNormalTexture";
+				constexpr const char_t* UNIFORM_2D_ALBEDO_TEXTURE = "u2DAlbedoTexture";
+				constexpr const char_t* UNIFORM_2D_MATERIAL_TEXTURE = "u2DMaterialTexture";
+				constexpr const char_t* UNIFORM_2D_DEPTH_TEXTURE = "u2DDepthTexture";
 				constexpr const char_t* UNIFORM_2D_TEXTURE_ARRAY = "u2DTextureArray";
 				constexpr const char_t* UNIFORM_2D_SHADOW_TEXTURE = "u2DShadowTexture";
 				constexpr const char_t* UNIFORM_CUBEMAP_TEXTURE = "uCubemapTexture";
@@ -65,10 +81,15 @@ namespace GraphicsEngine
 				GE_UT_PVM_MATRIX4 = 0,
 				GE_UT_PV_CUBEMAP_MATRIX4, // special case for cubemaps, translation is removed
 				GE_UT_LIGHT_PVM_MATRIX4,
+				GE_UT_CASCADE_PV0_MATRIX4, // shadow cascades, consecutive
+				GE_UT_CASCADE_PV1_MATRIX4,
+				GE_UT_CASCADE_PV2_MATRIX4,
+				GE_UT_CASCADE_PV3_MATRIX4,
 				GE_UT_PROJECTION_MATRIX4,
 				GE_UT_VIEW_MATRIX4,
 				GE_UT_MODEL_MATRIX4,
 				GE_UT_NORMAL_MATRIX4,
+				GE_UT_INVERSE_PV_MATRIX4, // screen to world space
 
 				// vec4 
 				GE_UT_CAMERA_POS,  //viewPos
@@ -76,6 +97,7 @@ namespace GraphicsEngine
 				GE_UT_LIGHT_POS,
 				GE_UT_LIGHT_COLOR,
 				GE_UT_COLOR_VEC4,
+				GE_UT_CASCADE_SPLITS, // far depths of the shadow cascades
 
 				// floats
 				GE_UT_CRR_TIME, // timer crr time
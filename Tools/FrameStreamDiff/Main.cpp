@@ -0,0 +1,183 @@
+#include "Graphics/Rendering/CommandStream.hpp"
+#include "Foundation/Logger.hpp"
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// commands printed before and after a mismatch
+static const uint32_t CONTEXT_SIZE = 3;
+
+struct Totals
+{
+	Totals()
+		: frameCount(0), commandCount(0)
+	{}
+
+	uint32_t frameCount;
+	uint64_t commandCount;
+	CommandStream::Stats stats;
+};
+
+static void Accumulate(const CommandStream& stream, Totals& totals)
+{
+	const auto& stats = stream.GetStats();
+
+	totals.frameCount++;
+	totals.commandCount += stream.GetCommands().size();
+	totals.stats.passCount += stats.passCount;
+	totals.stats.bindCount += stats.bindCount;
+	totals.stats.drawCount += stats.drawCount;
+	totals.stats.elementCount += stats.elementCount;
+	totals.stats.uniformUpdateCount += stats.uniformUpdateCount;
+	totals.stats.uniformByteCount += stats.uniformByteCount;
+}
+
+static void PrintMismatch(uint32_t frameIdx, const CommandStream& expected, const CommandStream& actual, uint32_t mismatchIdx, std::ostream& out)
+{
+	out << "Frame " << frameIdx << ": first difference at command " << mismatchIdx << std::endl;
+
+	const uint32_t begin = (mismatchIdx > CONTEXT_SIZE) ? (mismatchIdx - CONTEXT_SIZE) : 0;
+	const uint32_t end = mismatchIdx + CONTEXT_SIZE + 1;
+
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const bool_t hasExpected = (i < expected.GetCommands().size());
+		const bool_t hasActual = (i < actual.GetCommands().size());
+		if ((false == hasExpected) && (false == hasActual))
+			break;
+
+		const bool_t isEqual = hasExpected && hasActual && expected.IsEqual(i, actual, i);
+		if (isEqual)
+		{
+			out << "    " << i << "  " << expected.ToString(i) << std::endl;
+		}
+		else
+		{
+			out << "  - " << i << "  " << expected.ToString(i) << std::endl;
+			out << "  + " << i << "  " << actual.ToString(i) << std::endl;
+		}
+	}
+}
+
+static void PrintTotals(const char_t* pName, const Totals& totals, std::ostream& out)
+{
+	out << "{\"stream\":\"" << pName << "\""
+		<< ",\"frames\":" << totals.frameCount
+		<< ",\"commands\":" << totals.commandCount
+		<< ",\"passes\":" << totals.stats.passCount
+		<< ",\"binds\":" << totals.stats.bindCount
+		<< ",\"draws\":" << totals.stats.drawCount
+		<< ",\"elements\":" << totals.stats.elementCount
+		<< ",\"uniform_updates\":" << totals.stats.uniformUpdateCount
+		<< ",\"uniform_bytes\":" << totals.stats.uniformByteCount
+		<< "}" << std::endl;
+}
+
+static std::FILE* OpenStream(const char_t* pFilePath)
+{
+	std::FILE* pFile = std::fopen(pFilePath, "rb");
+	if (nullptr == pFile)
+	{
+		LOG_ERROR("Failed to open the command stream file: %s", pFilePath);
+		return nullptr;
+	}
+
+	if (false == CommandStream::ReadHeader(pFile))
+	{
+		LOG_ERROR("Invalid command stream file: %s", pFilePath);
+
+		std::fclose(pFile);
+		return nullptr;
+	}
+
+	return pFile;
+}
+
+// usage: FrameStreamDiff <expected stream> <actual stream> [uniform tolerance] [max reported frames]
+// compares two command stream files recorded by the null renderer (see NULL_RENDERER_STREAM_FILE), frame by frame
+// uniform tolerance - if > 0 the uniform data is compared as floats with this absolute tolerance
+// the first difference of each frame is printed with its context, then the totals of both streams as one JSON object per line
+// returns 0 if the streams are equal, 1 if they differ, 2 on error
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cerr << "usage: FrameStreamDiff <expected stream> <actual stream> [uniform tolerance] [max reported frames]" << std::endl;
+		return 2;
+	}
+
+	const float32_t tolerance = (argc > 3) ? static_cast<float32_t>(std::strtod(argv[3], nullptr)) : 0.0f;
+	const uint32_t maxReportedFrames = (argc > 4) ? static_cast<uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 10;
+
+	std::FILE* pExpectedFile = OpenStream(argv[1]);
+	if (nullptr == pExpectedFile)
+		return 2;
+
+	std::FILE* pActualFile = OpenStream(argv[2]);
+	if (nullptr == pActualFile)
+	{
+		std::fclose(pExpectedFile);
+		return 2;
+	}
+
+	CommandStream expected, actual;
+	Totals expectedTotals, actualTotals;
+
+	uint32_t differentFrameCount = 0;
+	uint32_t frameIdx = 0;
+	while (true)
+	{
+		const bool_t hasExpected = expected.Read(pExpectedFile);
+		const bool_t hasActual = actual.Read(pActualFile);
+
+		if ((false == hasExpected) && (false == hasActual))
+			break;
+
+		if (hasExpected != hasActual)
+		{
+			std::cout << "Frame " << frameIdx << ": only in the " << (hasExpected ? "expected" : "actual") << " stream" << std::endl;
+			differentFrameCount++;
+
+			// the totals of the remaining frames
+			auto& stream = hasExpected ? expected : actual;
+			auto* pFile = hasExpected ? pExpectedFile : pActualFile;
+			auto& totals = hasExpected ? expectedTotals : actualTotals;
+			do
+			{
+				Accumulate(stream, totals);
+			} while (stream.Read(pFile));
+
+			break;
+		}
+
+		Accumulate(expected, expectedTotals);
+		Accumulate(actual, actualTotals);
+
+		uint32_t mismatchIdx = 0;
+		if (false == CommandStream::Compare(expected, actual, mismatchIdx, tolerance))
+		{
+			if (differentFrameCount < maxReportedFrames)
+			{
+				PrintMismatch(frameIdx, expected, actual, mismatchIdx, std::cout);
+			}
+
+			differentFrameCount++;
+		}
+
+		frameIdx++;
+	}
+
+	std::fclose(pExpectedFile);
+	std::fclose(pActualFile);
+
+	std::cout << differentFrameCount << " different frame(s)" << std::endl;
+
+	PrintTotals("expected", expectedTotals, std::cout);
+	PrintTotals("actual", actualTotals, std::cout);
+
+	return (differentFrameCount > 0) ? 1 : 0;
+}
\ No newline at end of file
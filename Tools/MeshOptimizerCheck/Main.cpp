@@ -0,0 +1,313 @@
+#include "Graphics/GeometricPrimitives/MeshOptimizer.hpp"
+#include "Foundation/HashUtils.hpp"
+#include "Foundation/Logger.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <algorithm> // std::sort(), std::rotate()
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// the optimization runs per mesh, their results must be identical
+static const uint32_t RUN_COUNT = 3;
+
+static const float32_t PI = 3.14159265358979f;
+
+// same layout as the loaded meshes: position, normal, uv
+struct Vertex
+{
+	float32_t position[3];
+	float32_t normal[3];
+	float32_t uv[2];
+};
+
+struct Mesh
+{
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+};
+
+struct OptimizedMesh
+{
+	MeshOptimizer::CacheStatistics before;
+	// the ATVR of a mesh with duplicates is per duplicate, e.g. 1.0 for a triangle soup, it is compared after the deduplication
+	MeshOptimizer::CacheStatistics deduplicated;
+	MeshOptimizer::CacheStatistics after;
+	uint32_t usedVertexCount;
+
+	Mesh mesh;
+	// the first input vertex with the same data, per output vertex
+	std::vector<uint32_t> vertexRemap;
+};
+
+static Vertex MakeVertex(float32_t x, float32_t y, float32_t z, float32_t nx, float32_t ny, float32_t nz, float32_t u, float32_t v)
+{
+	Vertex vertex;
+	vertex.position[0] = x;
+	vertex.position[1] = y;
+	vertex.position[2] = z;
+	vertex.normal[0] = nx;
+	vertex.normal[1] = ny;
+	vertex.normal[2] = nz;
+	vertex.uv[0] = u;
+	vertex.uv[1] = v;
+
+	return vertex;
+}
+
+// std::shuffle() is implementation defined, the same order is wanted on every platform
+static void ShuffleTriangles(std::vector<uint32_t>& indices, uint32_t seed)
+{
+	std::mt19937 generator(seed);
+
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	for (uint32_t i = triangleCount - 1; i > 0; --i)
+	{
+		const uint32_t j = generator() % (i + 1);
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			std::swap(indices[i * 3 + k], indices[j * 3 + k]);
+		}
+	}
+}
+
+// height field, the triangles in a random order
+static Mesh BuildShuffledGrid(uint32_t size)
+{
+	Mesh mesh;
+
+	for (uint32_t z = 0; z <= size; ++z)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+		{
+			const float32_t u = static_cast<float32_t>(x) / size;
+			const float32_t v = static_cast<float32_t>(z) / size;
+			mesh.vertices.push_back(MakeVertex(u, 0.1f * std::sin(8.0f * u) * std::cos(8.0f * v), v, 0.0f, 1.0f, 0.0f, u, v));
+		}
+	}
+
+	for (uint32_t z = 0; z < size; ++z)
+	{
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			const uint32_t i0 = z * (size + 1) + x;
+			const uint32_t i1 = i0 + 1;
+			const uint32_t i2 = i0 + size + 1;
+			const uint32_t i3 = i2 + 1;
+
+			mesh.indices.insert(mesh.indices.end(), { i0, i2, i1, i1, i2, i3 });
+		}
+	}
+
+	ShuffleTriangles(mesh.indices, 1);
+
+	return mesh;
+}
+
+// the shuffled grid as a triangle soup, 3 vertices per triangle, the duplicates are merged by the deduplication
+static Mesh BuildTriangleSoup(uint32_t size)
+{
+	const Mesh grid = BuildShuffledGrid(size);
+
+	Mesh mesh;
+	for (auto index : grid.indices)
+	{
+		mesh.indices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+		mesh.vertices.push_back(grid.vertices[index]);
+	}
+
+	return mesh;
+}
+
+// uv sphere in ring order, already cache friendly - the optimization must not make it worse
+// the seam and the poles have vertices with the same position but other uvs, they are not duplicates
+static Mesh BuildSphere(uint32_t ringCount, uint32_t segmentCount)
+{
+	Mesh mesh;
+
+	for (uint32_t ring = 0; ring <= ringCount; ++ring)
+	{
+		const float32_t v = static_cast<float32_t>(ring) / ringCount;
+		const float32_t theta = v * PI;
+
+		for (uint32_t segment = 0; segment <= segmentCount; ++segment)
+		{
+			const float32_t u = static_cast<float32_t>(segment) / segmentCount;
+			const float32_t phi = u * 2.0f * PI;
+
+			const float32_t x = std::sin(theta) * std::cos(phi);
+			const float32_t y = std::cos(theta);
+			const float32_t z = std::sin(theta) * std::sin(phi);
+			mesh.vertices.push_back(MakeVertex(x, y, z, x, y, z, u, v));
+		}
+	}
+
+	for (uint32_t ring = 0; ring < ringCount; ++ring)
+	{
+		for (uint32_t segment = 0; segment < segmentCount; ++segment)
+		{
+			const uint32_t i0 = ring * (segmentCount + 1) + segment;
+			const uint32_t i1 = i0 + 1;
+			const uint32_t i2 = i0 + segmentCount + 1;
+			const uint32_t i3 = i2 + 1;
+
+			if (ring > 0)
+			{
+				mesh.indices.insert(mesh.indices.end(), { i0, i1, i2 });
+			}
+			if (ring + 1 < ringCount)
+			{
+				mesh.indices.insert(mesh.indices.end(), { i1, i3, i2 });
+			}
+		}
+	}
+
+	return mesh;
+}
+
+// the stage as run by the loader, see glTF2Loader
+static void Optimize(const Mesh& mesh, OptimizedMesh& out)
+{
+	out.mesh = mesh;
+
+	Vertex* pVertices = out.mesh.vertices.data();
+	uint32_t* pIndices = out.mesh.indices.data();
+	const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+	const uint32_t indexCount = static_cast<uint32_t>(mesh.indices.size());
+
+	out.before = MeshOptimizer::AnalyzeVertexCache(pIndices, indexCount);
+
+	MeshOptimizer::DeduplicateVertices(pVertices, vertexCount, sizeof(Vertex), pIndices, indexCount);
+	out.deduplicated = MeshOptimizer::AnalyzeVertexCache(pIndices, indexCount);
+	MeshOptimizer::OptimizeVertexCache(pIndices, indexCount);
+	MeshOptimizer::OptimizeOverdraw(pIndices, indexCount, pVertices, sizeof(Vertex), 0);
+	out.usedVertexCount = MeshOptimizer::OptimizeVertexFetch(pVertices, vertexCount, sizeof(Vertex), pIndices, indexCount);
+
+	out.after = MeshOptimizer::AnalyzeVertexCache(pIndices, indexCount);
+
+	std::map<std::string, uint32_t> firstVertices;
+	for (uint32_t i = 0; i < vertexCount; ++i)
+	{
+		firstVertices.insert(std::make_pair(std::string(reinterpret_cast<const char_t*>(&mesh.vertices[i]), sizeof(Vertex)), i));
+	}
+
+	out.vertexRemap.clear();
+	for (const auto& vertex : out.mesh.vertices)
+	{
+		auto it = firstVertices.find(std::string(reinterpret_cast<const char_t*>(&vertex), sizeof(Vertex)));
+		out.vertexRemap.push_back((it != firstVertices.end()) ? it->second : static_cast<uint32_t>(-1));
+	}
+}
+
+// the triangles by vertex data, each rotated to start with its smallest vertex so the winding is kept, sorted
+static std::vector<std::string> GetTriangleKeys(const Mesh& mesh)
+{
+	std::vector<std::string> keys;
+
+	for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+	{
+		std::string vertices[3];
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			vertices[k].assign(reinterpret_cast<const char_t*>(&mesh.vertices[mesh.indices[i + k]]), sizeof(Vertex));
+		}
+
+		std::rotate(vertices, std::min_element(vertices, vertices + 3), vertices + 3);
+		keys.push_back(vertices[0] + vertices[1] + vertices[2]);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	return keys;
+}
+
+static bool_t IsTrianglePermutation(const Mesh& input, const OptimizedMesh& output)
+{
+	if (input.indices.size() != output.mesh.indices.size())
+		return false;
+
+	for (auto index : output.mesh.indices)
+	{
+		if (index >= output.usedVertexCount)
+			return false;
+	}
+
+	return (GetTriangleKeys(input) == GetTriangleKeys(output.mesh));
+}
+
+static bool_t IsEqual(const OptimizedMesh& first, const OptimizedMesh& second)
+{
+	return (first.usedVertexCount == second.usedVertexCount) &&
+		(first.mesh.indices == second.mesh.indices) &&
+		(first.vertexRemap == second.vertexRemap) &&
+		(0 == std::memcmp(first.mesh.vertices.data(), second.mesh.vertices.data(), first.mesh.vertices.size() * sizeof(Vertex)));
+}
+
+static bool_t Check(const char_t* pName, const Mesh& mesh, std::ostream& out)
+{
+	OptimizedMesh result;
+	Optimize(mesh, result);
+
+	bool_t isStable = true;
+	for (uint32_t i = 1; i < RUN_COUNT; ++i)
+	{
+		OptimizedMesh otherResult;
+		Optimize(mesh, otherResult);
+
+		isStable = isStable && IsEqual(result, otherResult);
+	}
+
+	const bool_t isPermutation = IsTrianglePermutation(mesh, result);
+	const bool_t isAcmrKept = (result.after.acmr <= result.before.acmr);
+	const bool_t isAtvrKept = (result.after.atvr <= result.deduplicated.atvr);
+	const bool_t isValid = isStable && isPermutation && isAcmrKept && isAtvrKept;
+
+	// compared between platforms, the results must be the same
+	uint64_t hash = HashUtils::HashBytes(result.mesh.indices.data(), result.mesh.indices.size() * sizeof(uint32_t));
+	hash = HashUtils::HashBytes(result.vertexRemap.data(), result.vertexRemap.size() * sizeof(uint32_t), hash);
+
+	out << "{\"mesh\":\"" << pName << "\""
+		<< ",\"triangles\":" << mesh.indices.size() / 3
+		<< ",\"vertices\":" << mesh.vertices.size()
+		<< ",\"used_vertices\":" << result.usedVertexCount
+		<< ",\"acmr_before\":" << result.before.acmr
+		<< ",\"acmr_after\":" << result.after.acmr
+		<< ",\"atvr_before\":" << result.before.atvr
+		<< ",\"atvr_deduplicated\":" << result.deduplicated.atvr
+		<< ",\"atvr_after\":" << result.after.atvr
+		<< ",\"permutation\":" << (isPermutation ? "true" : "false")
+		<< ",\"stable\":" << (isStable ? "true" : "false")
+		<< ",\"hash\":\"" << std::hex << hash << std::dec << "\""
+		<< ",\"valid\":" << (isValid ? "true" : "false")
+		<< "}" << std::endl;
+
+	return isValid;
+}
+
+// usage: MeshOptimizerCheck [grid size]
+// runs the MeshOptimizer stage on generated meshes and checks that the output triangles are a permutation of the input ones
+// (same vertex data and winding), that the ACMR and the ATVR (after the deduplication) do not increase and that the results
+// are the same on every run
+// the results are printed as one JSON object per line, the hash of the output indices and vertex remap can be compared between platforms
+// returns 0 if all the meshes are valid
+int main(int argc, char* argv[])
+{
+	const uint32_t gridSize = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 64;
+
+	if (gridSize < 2)
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	bool_t isValid = Check("shuffled_grid", BuildShuffledGrid(gridSize), std::cout);
+	isValid = Check("triangle_soup", BuildTriangleSoup(gridSize), std::cout) && isValid;
+	isValid = Check("sphere", BuildSphere(gridSize / 2, gridSize), std::cout) && isValid;
+
+	return isValid ? 0 : 1;
+}
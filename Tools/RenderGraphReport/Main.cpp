@@ -0,0 +1,403 @@
+#include "Graphics/Rendering/RenderGraph.hpp"
+#include "Foundation/Logger.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm> // std::sort()
+#include <cstdlib>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+// builds + compiles per measure, the median is reported
+static const uint32_t RUN_COUNT = 101;
+
+static const uint32_t SHADOW_MAP_SIZE = 2048;
+
+// the declarations of a frame, kept to check the compiled graph against them
+struct FrameDesc
+{
+	struct Access
+	{
+		RenderGraph::ResourceHandle texture;
+		RenderGraph::ResourceState state;
+	};
+
+	struct PassDesc
+	{
+		RenderGraph::PassHandle handle;
+		std::vector<Access> accesses;
+		bool_t isCulledExpected;
+	};
+
+	std::vector<PassDesc> passes;
+	// by texture handle
+	std::vector<RenderGraph::ResourceState> initialStates;
+	std::vector<RenderGraph::ResourceState> finalStates;
+};
+
+class FrameBuilder
+{
+public:
+	FrameBuilder(RenderGraph& graph, FrameDesc& desc)
+		: mGraph(graph), mDesc(desc)
+	{
+		mGraph.Reset();
+		mDesc = FrameDesc();
+	}
+
+	RenderGraph::ResourceHandle CreateTexture(const std::string& name, uint32_t width, uint32_t height, Texture::TextureFormat format)
+	{
+		mDesc.initialStates.push_back(RenderGraph::ResourceState::GE_RS_UNDEFINED);
+		mDesc.finalStates.push_back(RenderGraph::ResourceState::GE_RS_UNDEFINED);
+
+		return mGraph.CreateTexture(name, RenderGraph::TextureDesc(width, height, format));
+	}
+
+	RenderGraph::ResourceHandle ImportTexture(const std::string& name, uint32_t width, uint32_t height, Texture::TextureFormat format,
+		RenderGraph::ResourceState initialState, RenderGraph::ResourceState finalState)
+	{
+		mDesc.initialStates.push_back(initialState);
+		mDesc.finalStates.push_back(finalState);
+
+		return mGraph.ImportTexture(name, RenderGraph::TextureDesc(width, height, format), initialState, finalState);
+	}
+
+	void AddPass(const std::string& name, bool_t isCulledExpected = false)
+	{
+		FrameDesc::PassDesc pass;
+		pass.handle = mGraph.AddPass(name);
+		pass.isCulledExpected = isCulledExpected;
+
+		mDesc.passes.push_back(pass);
+	}
+
+	// to the last added pass
+	void Read(RenderGraph::ResourceHandle texture, RenderGraph::ResourceState state = RenderGraph::ResourceState::GE_RS_SHADER_READ)
+	{
+		mGraph.Read(mDesc.passes.back().handle, texture, state);
+		AddAccess(texture, state);
+	}
+
+	void Write(RenderGraph::ResourceHandle texture, RenderGraph::ResourceState state = RenderGraph::ResourceState::GE_RS_COLOR_ATTACHMENT)
+	{
+		mGraph.Write(mDesc.passes.back().handle, texture, state);
+		AddAccess(texture, state);
+	}
+
+	void ReadWrite(RenderGraph::ResourceHandle texture, RenderGraph::ResourceState state)
+	{
+		Read(texture, state);
+		Write(texture, state);
+	}
+
+private:
+	void AddAccess(RenderGraph::ResourceHandle texture, RenderGraph::ResourceState state)
+	{
+		for (const auto& access : mDesc.passes.back().accesses)
+		{
+			if (access.texture == texture)
+				return;
+		}
+
+		FrameDesc::Access access;
+		access.texture = texture;
+		access.state = state;
+
+		mDesc.passes.back().accesses.push_back(access);
+	}
+
+	RenderGraph& mGraph;
+	FrameDesc& mDesc;
+};
+
+// the current forward frame: shadow map, then the standard pass to the swapchain
+static void BuildForwardFrame(RenderGraph& graph, FrameDesc& desc, uint32_t width, uint32_t height)
+{
+	FrameBuilder builder(graph, desc);
+
+	const auto swapchain = builder.ImportTexture("Swapchain", width, height, Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM,
+		RenderGraph::ResourceState::GE_RS_UNDEFINED, RenderGraph::ResourceState::GE_RS_PRESENT);
+	const auto shadowMap = builder.CreateTexture("ShadowMap", SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, Texture::TextureFormat::GE_TF_D32);
+	const auto depth = builder.CreateTexture("Depth", width, height, Texture::TextureFormat::GE_TF_D32);
+
+	builder.AddPass("Shadows");
+	builder.Write(shadowMap, RenderGraph::ResourceState::GE_RS_DEPTH_ATTACHMENT);
+
+	builder.AddPass("Standard");
+	builder.Read(shadowMap);
+	builder.Write(depth, RenderGraph::ResourceState::GE_RS_DEPTH_ATTACHMENT);
+	builder.Write(swapchain);
+}
+
+// the deferred frame (see GBuffer) with an HDR post chain:
+// shadows, G-buffer, lighting, translucents, bloom, tone mapping to the swapchain and a debug view nobody reads
+static void BuildDeferredFrame(RenderGraph& graph, FrameDesc& desc, uint32_t width, uint32_t height)
+{
+	FrameBuilder builder(graph, desc);
+
+	const auto swapchain = builder.ImportTexture("Swapchain", width, height, Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM,
+		RenderGraph::ResourceState::GE_RS_UNDEFINED, RenderGraph::ResourceState::GE_RS_PRESENT);
+	const auto shadowMap = builder.CreateTexture("ShadowMap", SHADOW_MAP_SIZE, SHADOW_MAP_SIZE, Texture::TextureFormat::GE_TF_D32);
+	const auto albedo = builder.CreateTexture("GBufferAlbedo", width, height, Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM);
+	const auto normal = builder.CreateTexture("GBufferNormal", width, height, Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT);
+	const auto material = builder.CreateTexture("GBufferMaterial", width, height, Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM);
+	const auto depth = builder.CreateTexture("GBufferDepth", width, height, Texture::TextureFormat::GE_TF_D32);
+	const auto hdr = builder.CreateTexture("HDRColor", width, height, Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT);
+	const auto bloomDown = builder.CreateTexture("BloomDown", width / 2, height / 2, Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT);
+	const auto bloomBlurH = builder.CreateTexture("BloomBlurH", width / 2, height / 2, Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT);
+	const auto bloomBlurV = builder.CreateTexture("BloomBlurV", width / 2, height / 2, Texture::TextureFormat::GE_TF_R16G16B16A16_SFLOAT);
+	const auto debugView = builder.CreateTexture("DebugView", width, height, Texture::TextureFormat::GE_TF_R8G8B8A8_UNORM);
+
+	builder.AddPass("Shadows");
+	builder.Write(shadowMap, RenderGraph::ResourceState::GE_RS_DEPTH_ATTACHMENT);
+
+	builder.AddPass("GBuffer");
+	builder.Write(albedo);
+	builder.Write(normal);
+	builder.Write(material);
+	builder.Write(depth, RenderGraph::ResourceState::GE_RS_DEPTH_ATTACHMENT);
+
+	builder.AddPass("DebugNormals", true);
+	builder.Read(normal);
+	builder.Write(debugView);
+
+	builder.AddPass("Lighting");
+	builder.Read(albedo);
+	builder.Read(normal);
+	builder.Read(material);
+	builder.Read(depth);
+	builder.Read(shadowMap);
+	builder.Write(hdr);
+
+	builder.AddPass("Translucents");
+	builder.ReadWrite(hdr, RenderGraph::ResourceState::GE_RS_COLOR_ATTACHMENT);
+	builder.Read(depth, RenderGraph::ResourceState::GE_RS_DEPTH_READ);
+
+	builder.AddPass("BloomDownsample");
+	builder.Read(hdr);
+	builder.Write(bloomDown);
+
+	builder.AddPass("BloomBlurH");
+	builder.Read(bloomDown);
+	builder.Write(bloomBlurH);
+
+	builder.AddPass("BloomBlurV");
+	builder.Read(bloomBlurH);
+	builder.Write(bloomBlurV);
+
+	builder.AddPass("ToneMapping");
+	builder.Read(hdr);
+	builder.Read(bloomBlurV);
+	builder.Write(swapchain);
+}
+
+// checks the compiled graph against the declarations:
+// the culled passes, the state of each texture at each use and at the end, and that the textures sharing memory are never alive together
+static bool_t Validate(const RenderGraph& graph, const FrameDesc& desc)
+{
+	std::vector<RenderGraph::ResourceState> states = desc.initialStates;
+	std::vector<uint32_t> firstUses(states.size(), RenderGraph::INVALID_HANDLE), lastUses(states.size(), RenderGraph::INVALID_HANDLE);
+
+	auto applyBarriers = [&states](const std::vector<RenderGraph::Barrier>& barriers) -> bool_t
+	{
+		for (const auto& barrier : barriers)
+		{
+			if (barrier.oldState != states[barrier.resource])
+				return false;
+
+			states[barrier.resource] = barrier.newState;
+		}
+		return true;
+	};
+
+	uint32_t orderIdx = 0;
+	for (const auto& pass : desc.passes)
+	{
+		if (graph.IsPassCulled(pass.handle) != pass.isCulledExpected)
+		{
+			LOG_ERROR("Pass %s: unexpected culling!", graph.GetPassName(pass.handle).c_str());
+			return false;
+		}
+
+		if (graph.IsPassCulled(pass.handle))
+			continue;
+
+		if (false == applyBarriers(graph.GetBarriers(pass.handle)))
+		{
+			LOG_ERROR("Pass %s: barrier from a wrong state!", graph.GetPassName(pass.handle).c_str());
+			return false;
+		}
+
+		for (const auto& access : pass.accesses)
+		{
+			if (states[access.texture] != access.state)
+			{
+				LOG_ERROR("Pass %s: texture %s in a wrong state!", graph.GetPassName(pass.handle).c_str(), graph.GetTextureName(access.texture).c_str());
+				return false;
+			}
+
+			if (RenderGraph::INVALID_HANDLE == firstUses[access.texture])
+			{
+				firstUses[access.texture] = orderIdx;
+			}
+			lastUses[access.texture] = orderIdx;
+		}
+
+		orderIdx++;
+	}
+
+	if (false == applyBarriers(graph.GetFinalBarriers()))
+	{
+		LOG_ERROR("Final barrier from a wrong state!");
+		return false;
+	}
+
+	for (uint32_t i = 0; i < graph.GetTextureCount(); ++i)
+	{
+		if (graph.IsImported(i) && (desc.finalStates[i] != RenderGraph::ResourceState::GE_RS_UNDEFINED) && (states[i] != desc.finalStates[i]))
+		{
+			LOG_ERROR("Texture %s not in its final state!", graph.GetTextureName(i).c_str());
+			return false;
+		}
+
+		const uint32_t block = graph.GetMemoryBlock(i);
+		if (block == RenderGraph::INVALID_HANDLE)
+			continue;
+
+		if (graph.GetMemoryBlockSize(block) < RenderGraph::ComputeMemorySize(graph.GetTextureDesc(i)))
+		{
+			LOG_ERROR("Texture %s doesn't fit its memory block!", graph.GetTextureName(i).c_str());
+			return false;
+		}
+
+		for (uint32_t j = i + 1; j < graph.GetTextureCount(); ++j)
+		{
+			if ((graph.GetMemoryBlock(j) == block) && (firstUses[i] <= lastUses[j]) && (firstUses[j] <= lastUses[i]))
+			{
+				LOG_ERROR("Textures %s and %s share memory while alive!", graph.GetTextureName(i).c_str(), graph.GetTextureName(j).c_str());
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static void PrintPasses(const RenderGraph& graph, std::ostream& out)
+{
+	auto printBarriers = [&graph, &out](const std::vector<RenderGraph::Barrier>& barriers)
+	{
+		for (const auto& barrier : barriers)
+		{
+			out << "    " << graph.GetTextureName(barrier.resource) << ": "
+				<< RenderGraph::ResourceStateToStr(barrier.oldState) << " -> " << RenderGraph::ResourceStateToStr(barrier.newState)
+				<< (barrier.isDiscard ? " (discard)" : "");
+			if (barrier.aliasedResource != RenderGraph::INVALID_HANDLE)
+			{
+				out << " (aliases " << graph.GetTextureName(barrier.aliasedResource) << ")";
+			}
+			out << std::endl;
+		}
+	};
+
+	for (uint32_t pass = 0; pass < graph.GetPassCount(); ++pass)
+	{
+		out << "  " << graph.GetPassName(pass) << (graph.IsPassCulled(pass) ? " (culled)" : "") << std::endl;
+		if (false == graph.IsPassCulled(pass))
+		{
+			printBarriers(graph.GetBarriers(pass));
+		}
+	}
+	out << "  End" << std::endl;
+	printBarriers(graph.GetFinalBarriers());
+
+	for (uint32_t i = 0; i < graph.GetTextureCount(); ++i)
+	{
+		const uint32_t block = graph.GetMemoryBlock(i);
+		if (block != RenderGraph::INVALID_HANDLE)
+		{
+			out << "  " << graph.GetTextureName(i) << ": block " << block << ", " << RenderGraph::ComputeMemorySize(graph.GetTextureDesc(i)) << " bytes" << std::endl;
+		}
+	}
+}
+
+static float64_t GetTime()
+{
+	return std::chrono::duration<float64_t, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+typedef void (*BuildFunc)(RenderGraph&, FrameDesc&, uint32_t, uint32_t);
+
+static bool_t Report(const std::string& name, BuildFunc build, uint32_t width, uint32_t height, bool_t isVerbose, std::ostream& out)
+{
+	RenderGraph graph;
+	FrameDesc desc;
+
+	// rebuilt and compiled every frame
+	std::vector<float64_t> times;
+	bool_t isCompiled = true;
+	for (uint32_t i = 0; i < RUN_COUNT; ++i)
+	{
+		const float64_t begin = GetTime();
+		build(graph, desc, width, height);
+		isCompiled = graph.Compile() && isCompiled;
+		times.push_back(GetTime() - begin);
+	}
+	std::sort(times.begin(), times.end());
+
+	const bool_t isValid = isCompiled && Validate(graph, desc);
+
+	if (isVerbose)
+	{
+		out << name << ":" << std::endl;
+		PrintPasses(graph, out);
+	}
+
+	const auto& report = graph.GetReport();
+	const uint64_t savedMemory = report.transientMemory - report.aliasedMemory;
+
+	out << "{\"graph\":\"" << name << "\""
+		<< ",\"width\":" << width
+		<< ",\"height\":" << height
+		<< ",\"passes\":" << report.passCount
+		<< ",\"culled_passes\":" << report.culledPassCount
+		<< ",\"textures\":" << report.textureCount
+		<< ",\"transients\":" << report.transientCount
+		<< ",\"barriers\":" << report.barrierCount
+		<< ",\"transitions\":" << report.transitionCount
+		<< ",\"memory_blocks\":" << report.memoryBlockCount
+		<< ",\"transient_bytes\":" << report.transientMemory
+		<< ",\"aliased_bytes\":" << report.aliasedMemory
+		<< ",\"saved_bytes\":" << savedMemory
+		<< ",\"saved_percent\":" << ((report.transientMemory > 0) ? (100.0 * savedMemory / report.transientMemory) : 0.0)
+		<< ",\"build_compile_us\":" << times[times.size() / 2]
+		<< ",\"valid\":" << (isValid ? "true" : "false")
+		<< "}" << std::endl;
+
+	return isValid;
+}
+
+// usage: RenderGraphReport [width] [height] [verbose]
+// builds the forward and the deferred frames in a render graph, compiles them and checks the result against the declarations
+// the results are printed as one JSON object per line, with the memory saved by aliasing the transient textures
+// verbose - 1 to print the barriers of each pass and the memory blocks
+// returns 0 if the compiled graphs are valid
+int main(int argc, char* argv[])
+{
+	const uint32_t width = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1920;
+	const uint32_t height = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 1080;
+	const bool_t isVerbose = (argc > 3) && (std::strtoul(argv[3], nullptr, 10) != 0);
+
+	if ((width < 2) || (height < 2))
+	{
+		LOG_ERROR("Invalid arguments!");
+		return 1;
+	}
+
+	bool_t isValid = Report("forward", BuildForwardFrame, width, height, isVerbose, std::cout);
+	isValid = Report("deferred", BuildDeferredFrame, width, height, isVerbose, std::cout) && isValid;
+
+	return isValid ? 0 : 1;
+}
\ No newline at end of file
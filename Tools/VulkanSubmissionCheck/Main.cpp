@@ -0,0 +1,214 @@
+#include "Foundation/Platform/Headless/HeadlessPlatform.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanDevice.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanQueue.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanCommandPool.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanCommandBuffer.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanFence.hpp"
+#include "Graphics/Rendering/Backends/Vulkan/Internal/VulkanSubmission.hpp"
+#include "Foundation/MemoryManagement/MemoryOperations.hpp"
+#include "Foundation/Logger.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace GraphicsEngine;
+using namespace GraphicsEngine::Graphics;
+
+typedef VulkanLogicalDevice::QueueType QueueType;
+
+// each submission is run twice, the second one reuses the semaphores of the first, see VulkanSubmission::Reset()
+static const uint32_t RUN_COUNT = 2;
+
+static const uint64_t FENCE_TIMEOUT = 1000000000; // ns
+
+// batches of empty command buffers, the check is about the queue submits and the semaphores between them
+struct SubmissionDesc
+{
+	struct Dependency
+	{
+		uint32_t batchIdx;
+		uint32_t producerBatchIdx;
+	};
+
+	std::string name;
+	std::vector<QueueType> batchQueueTypes;
+	std::vector<Dependency> dependencies;
+	std::vector<uint32_t> fencedBatches;
+
+	// with the queues of the device
+	uint32_t expectedQueueSubmitCount;
+	uint32_t expectedCrossQueueDependencyCount;
+};
+
+static std::vector<SubmissionDesc> BuildSubmissions(VulkanDevice* pDevice)
+{
+	// the queue types share the graphics queue if the device has no dedicated family for them, e.g. lavapipe
+	const bool_t isComputeDedicated = (pDevice->GetComputeQueue() != pDevice->GetGraphicsQueue());
+	const bool_t isTransferDedicated = (pDevice->GetTransferQueue() != pDevice->GetGraphicsQueue());
+
+	std::vector<SubmissionDesc> submissions;
+
+	// the consecutive batches of a queue are a single queue submit
+	SubmissionDesc sameQueue;
+	sameQueue.name = "same_queue";
+	sameQueue.batchQueueTypes = { QueueType::GE_QT_GRAPHICS, QueueType::GE_QT_GRAPHICS, QueueType::GE_QT_GRAPHICS };
+	sameQueue.dependencies = { { 1, 0 }, { 2, 1 } };
+	sameQueue.fencedBatches = { 2 };
+	sameQueue.expectedQueueSubmitCount = 1;
+	sameQueue.expectedCrossQueueDependencyCount = 0;
+	submissions.push_back(sameQueue);
+
+	// a fence ends the queue submit
+	SubmissionDesc fenceSplit;
+	fenceSplit.name = "fence_split";
+	fenceSplit.batchQueueTypes = { QueueType::GE_QT_GRAPHICS, QueueType::GE_QT_GRAPHICS };
+	fenceSplit.fencedBatches = { 0, 1 };
+	fenceSplit.expectedQueueSubmitCount = 2;
+	fenceSplit.expectedCrossQueueDependencyCount = 0;
+	submissions.push_back(fenceSplit);
+
+	// the buffer uploads, see VulkanBuffer::CopyTo()
+	SubmissionDesc upload;
+	upload.name = "transfer_upload";
+	upload.batchQueueTypes = { QueueType::GE_QT_TRANSFER, QueueType::GE_QT_GRAPHICS };
+	upload.dependencies = { { 1, 0 } };
+	upload.fencedBatches = { 1 };
+	upload.expectedQueueSubmitCount = isTransferDedicated ? 2 : 1;
+	upload.expectedCrossQueueDependencyCount = isTransferDedicated ? 1 : 0;
+	submissions.push_back(upload);
+
+	// graphics -> compute -> graphics, e.g. culling between two passes
+	SubmissionDesc asyncCompute;
+	asyncCompute.name = "async_compute";
+	asyncCompute.batchQueueTypes = { QueueType::GE_QT_GRAPHICS, QueueType::GE_QT_COMPUTE, QueueType::GE_QT_GRAPHICS };
+	asyncCompute.dependencies = { { 1, 0 }, { 2, 1 } };
+	asyncCompute.fencedBatches = { 2 };
+	asyncCompute.expectedQueueSubmitCount = isComputeDedicated ? 3 : 1;
+	asyncCompute.expectedCrossQueueDependencyCount = isComputeDedicated ? 2 : 0;
+	submissions.push_back(asyncCompute);
+
+	return submissions;
+}
+
+static bool_t Check(VulkanDevice* pDevice, const SubmissionDesc& desc, std::ostream& out)
+{
+	// a command pool per queue family
+	std::map<uint32_t, VulkanCommandPool*> commandPools;
+	std::vector<VulkanCommandBuffer*> commandBuffers;
+
+	for (auto queueType : desc.batchQueueTypes)
+	{
+		const uint32_t familyIndex = pDevice->GetQueue(queueType)->GetFamilyIndex();
+
+		auto& pCommandPool = commandPools[familyIndex];
+		if (nullptr == pCommandPool)
+		{
+			pCommandPool = GE_ALLOC(VulkanCommandPool)(pDevice, familyIndex);
+		}
+
+		auto* pCommandBuffer = GE_ALLOC(VulkanCommandBuffer)(pDevice, pCommandPool->GetHandle(), VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+		pCommandBuffer->End();
+		commandBuffers.push_back(pCommandBuffer);
+	}
+
+	std::vector<VulkanFence*> fences;
+	for (uint32_t i = 0; i < desc.fencedBatches.size(); ++i)
+	{
+		fences.push_back(GE_ALLOC(VulkanFence)(pDevice));
+	}
+
+	VulkanSubmission submission(pDevice);
+
+	bool_t isValid = true;
+	for (uint32_t runIdx = 0; runIdx < RUN_COUNT; ++runIdx)
+	{
+		submission.Reset();
+
+		for (uint32_t i = 0; i < desc.batchQueueTypes.size(); ++i)
+		{
+			submission.AddBatch(desc.batchQueueTypes[i], { commandBuffers[i]->GetHandle() });
+		}
+		for (const auto& dependency : desc.dependencies)
+		{
+			submission.AddDependency(dependency.batchIdx, dependency.producerBatchIdx, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+		}
+		for (uint32_t i = 0; i < desc.fencedBatches.size(); ++i)
+		{
+			fences[i]->Reset();
+			submission.SetFence(desc.fencedBatches[i], fences[i]->GetHandle());
+		}
+
+		const VkResult res = submission.Submit();
+
+		// the waits of the dependencies are satisfied, so every fence is signaled
+		bool_t areFencesSignaled = (VkResult::VK_SUCCESS == res);
+		for (auto* pFence : fences)
+		{
+			areFencesSignaled = areFencesSignaled && (VkResult::VK_SUCCESS == pFence->WaitIdle(VK_TRUE, FENCE_TIMEOUT));
+		}
+		pDevice->WaitIdle();
+
+		const bool_t isRunValid = areFencesSignaled &&
+			(submission.GetQueueSubmitCount() == desc.expectedQueueSubmitCount) &&
+			(submission.GetCrossQueueDependencyCount() == desc.expectedCrossQueueDependencyCount);
+
+		out << "{\"submission\":\"" << desc.name << "\""
+			<< ",\"run\":" << runIdx
+			<< ",\"batches\":" << desc.batchQueueTypes.size()
+			<< ",\"queue_submits\":" << submission.GetQueueSubmitCount()
+			<< ",\"expected_queue_submits\":" << desc.expectedQueueSubmitCount
+			<< ",\"cross_queue_dependencies\":" << submission.GetCrossQueueDependencyCount()
+			<< ",\"expected_cross_queue_dependencies\":" << desc.expectedCrossQueueDependencyCount
+			<< ",\"valid\":" << (isRunValid ? "true" : "false")
+			<< "}" << std::endl;
+
+		isValid = isValid && isRunValid;
+	}
+
+	for (auto* pFence : fences)
+	{
+		GE_FREE(pFence);
+	}
+	for (auto* pCommandBuffer : commandBuffers)
+	{
+		GE_FREE(pCommandBuffer);
+	}
+	for (auto& it : commandPools)
+	{
+		GE_FREE(it.second);
+	}
+
+	return isValid;
+}
+
+// usage: VulkanSubmissionCheck
+// submits empty command buffers as batches of VulkanSubmission(s) to the queues of the device and checks
+// how they are grouped in queue submits and the cross queue dependencies, with and without dedicated compute/transfer queues
+// the results are printed as one JSON object per line
+// returns 0 if all the submissions are valid
+int main(int, char*[])
+{
+	Platform::WindowHeadless window("VulkanSubmissionCheck", 64, 64);
+
+	VulkanDevice* pDevice = GE_ALLOC(VulkanDevice)(&window);
+	if ((nullptr == pDevice) || (nullptr == pDevice->GetGraphicsQueue()))
+	{
+		LOG_ERROR("No Vulkan device!");
+		return 1;
+	}
+
+	LOG_INFO("Dedicated compute queue: %s, dedicated transfer queue: %s",
+		(pDevice->GetComputeQueue() != pDevice->GetGraphicsQueue()) ? "yes" : "no",
+		(pDevice->GetTransferQueue() != pDevice->GetGraphicsQueue()) ? "yes" : "no");
+
+	bool_t isValid = true;
+	for (const auto& desc : BuildSubmissions(pDevice))
+	{
+		isValid = Check(pDevice, desc, std::cout) && isValid;
+	}
+
+	GE_FREE(pDevice);
+
+	return isValid ? 0 : 1;
+}
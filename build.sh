@@ -25,9 +25,9 @@ then
     exit 1
 fi
 
-if [ "$4" != "Vulkan" ] && [ "$4" != "OpenGL" ]
+if [ "$4" != "Vulkan" ] && [ "$4" != "OpenGL" ] && [ "$4" != "Null" ]
 then
-    echo "Please specify renderer type: Vulkan or OpenGL"
+    echo "Please specify renderer type: Vulkan, OpenGL or Null"
     echo "Example: ./build.sh Win 64bit Release Vulkan"
     exit 1
 fi
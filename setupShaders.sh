@@ -11,7 +11,7 @@ then
 fi
 
 export GLSL_COMPILER=./glslc
-export SHADER_EXT=".vert .frag"
+export SHADER_EXT=".vert .frag .comp"
 export SPIRV_EXT=".spv"
 
 echo "Supported shder ext: " $SHADER_EXT